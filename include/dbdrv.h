@@ -29,7 +29,7 @@
 /**
  * API version
  */
-#define DBDRV_API_VERSION           31
+#define DBDRV_API_VERSION           32
 
 /**
  * Database driver entry point declaration
@@ -54,6 +54,7 @@ typedef void* DBDRV_CONNECTION;
 typedef void* DBDRV_STATEMENT;
 typedef void* DBDRV_RESULT;
 typedef void* DBDRV_UNBUFFERED_RESULT;
+typedef void* DBDRV_BULK_LOAD;
 
 /**
  * Driver call table
@@ -95,6 +96,10 @@ struct DBDriverCallTable
    const char* (*GetColumnNameUnbuffered)(DBDRV_UNBUFFERED_RESULT, int);
    StringBuffer (*PrepareString)(const TCHAR*, size_t);
    int (*IsTableExist)(DBDRV_CONNECTION, const WCHAR*);
+   DBDRV_BULK_LOAD (*BulkLoadBegin)(DBDRV_CONNECTION, const WCHAR*, const WCHAR*, uint32_t*, WCHAR*);
+   void (*BulkLoadBind)(DBDRV_BULK_LOAD, int, int, void*, int);
+   uint32_t (*BulkLoadAddRow)(DBDRV_BULK_LOAD, WCHAR*);
+   uint32_t (*BulkLoadEnd)(DBDRV_BULK_LOAD, bool, WCHAR*);
 };
 
 //
@@ -25,7 +25,7 @@
 
 #define DB_LEGACY_SCHEMA_VERSION       700
 #define DB_SCHEMA_VERSION_MAJOR        70
-#define DB_SCHEMA_VERSION_MINOR        26
+#define DB_SCHEMA_VERSION_MINOR        35
 
 #define DB_SCHEMA_VERSION_V70_MINOR    DB_SCHEMA_VERSION_MINOR
 
@@ -758,6 +758,7 @@ __PACK_END__
 #define CMD_DELETE_CHAT_BOT               0x0228
 #define CMD_RENAME_CHAT_BOT               0x0229
 #define CMD_GET_CHAT_BOT_DRIVERS          0x022A
+#define CMD_DCI_DATA_BATCH                0x022B
 
 #define CMD_RS_LIST_REPORTS               0x1100
 #define CMD_RS_GET_REPORT_DEFINITION      0x1101
@@ -1802,6 +1803,7 @@ __PACK_END__
 #define VID_MAINTENANCE_SCHEDULED   ((uint32_t)1027)
 #define VID_SNMP_AGENT_COUNT        ((uint32_t)1028)
 #define VID_SNMP_AGENT_NAME         ((uint32_t)1029)
+#define VID_DATA_BATCHING           ((uint32_t)1030)
 
 // Base value for additional SNMP agent list (10 fields per entry)
 #define VID_SNMP_AGENT_LIST_BASE    ((uint32_t)0x79000000)
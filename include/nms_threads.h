@@ -733,13 +733,18 @@ struct ThreadPoolInfo
    uint32_t queueSizeSD;       // Task queue size standard deviation
 };
 
+/**
+ * Thread pool creation flags
+ */
+#define THREAD_POOL_WORK_STEALING   0x0001   /* Use per-worker request queues with work stealing instead of single shared queue */
+
 /**
  * Worker function for thread pool
  */
 typedef void (*ThreadPoolWorkerFunction)(void *);
 
 /* Thread pool functions */
-ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThreads, int maxThreads, int stackSize = 0);
+ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThreads, int maxThreads, int stackSize = 0, uint32_t flags = 0);
 void LIBNETXMS_EXPORTABLE ThreadPoolDestroy(ThreadPool *p);
 void LIBNETXMS_EXPORTABLE ThreadPoolExecute(ThreadPool *p, ThreadPoolWorkerFunction f, void *arg);
 void LIBNETXMS_EXPORTABLE ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, ThreadPoolWorkerFunction f, void *arg);
@@ -268,6 +268,7 @@
 /**
  * Node flags
  */
+#define NF_DISABLE_SNMP_GETBULK        0x00002000
 #define NF_DISABLE_SMCLP_PROPERTIES    0x00004000
 #define NF_DISABLE_VNC                 0x00008000
 #define NF_EXTERNAL_GATEWAY            0x00010000
@@ -81,6 +81,14 @@ typedef db_result_t * DB_RESULT;
 struct db_unbuffered_result_t;
 typedef db_unbuffered_result_t * DB_UNBUFFERED_RESULT;
 
+struct db_bulk_load_t;
+typedef db_bulk_load_t * DB_BULK_LOAD;
+
+/**
+ * Number of buckets in connection pool wait time histogram (<1ms, <10ms, <100ms, <1s, <10s, >=10s)
+ */
+#define DB_POOL_WAIT_HISTOGRAM_SIZE 6
+
 /**
  * Pool connection information
  */
@@ -94,6 +102,8 @@ struct PoolConnectionInfo
    uint32_t usageCount;
    char srcFile[128];
    int srcLine;
+   uint32_t waitTime;   // Time (in milliseconds) current holder waited for this connection
+   uint32_t waitHistogram[DB_POOL_WAIT_HISTOGRAM_SIZE];  // Acquire wait time distribution for current holder's call location
 };
 
 /**
@@ -158,6 +168,22 @@ DB_RESULT LIBNXDB_EXPORTABLE DBSelectPreparedEx(DB_STATEMENT hStmt, TCHAR *error
 DB_UNBUFFERED_RESULT LIBNXDB_EXPORTABLE DBSelectPreparedUnbuffered(DB_STATEMENT hStmt);
 DB_UNBUFFERED_RESULT LIBNXDB_EXPORTABLE DBSelectPreparedUnbufferedEx(DB_STATEMENT hStmt, TCHAR *errorText);
 
+bool LIBNXDB_EXPORTABLE DBIsBulkLoadSupported(DB_DRIVER driver);
+DB_BULK_LOAD LIBNXDB_EXPORTABLE DBBulkLoadBegin(DB_HANDLE hConn, const TCHAR *table, const TCHAR *columns);
+DB_BULK_LOAD LIBNXDB_EXPORTABLE DBBulkLoadBeginEx(DB_HANDLE hConn, const TCHAR *table, const TCHAR *columns, TCHAR *errorText);
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, int cType, const void *buffer, int allocType);
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, const TCHAR *value, int allocType);
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, int32_t value);
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, uint32_t value);
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, int64_t value);
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, uint64_t value);
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, double value);
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, Timestamp value);
+bool LIBNXDB_EXPORTABLE DBBulkLoadAddRow(DB_BULK_LOAD hBulkLoad);
+bool LIBNXDB_EXPORTABLE DBBulkLoadEnd(DB_BULK_LOAD hBulkLoad);
+bool LIBNXDB_EXPORTABLE DBBulkLoadEndEx(DB_BULK_LOAD hBulkLoad, TCHAR *errorText);
+void LIBNXDB_EXPORTABLE DBBulkLoadCancel(DB_BULK_LOAD hBulkLoad);
+
 bool LIBNXDB_EXPORTABLE DBQuery(DB_HANDLE hConn, const TCHAR *szQuery);
 bool LIBNXDB_EXPORTABLE DBQueryEx(DB_HANDLE hConn, const TCHAR *szQuery, TCHAR *errorText);
 
@@ -269,6 +295,7 @@ DB_HANDLE LIBNXDB_EXPORTABLE __DBConnectionPoolAcquireConnection(const char *src
 void LIBNXDB_EXPORTABLE DBConnectionPoolReleaseConnection(DB_HANDLE connection);
 int LIBNXDB_EXPORTABLE DBConnectionPoolGetSize();
 int LIBNXDB_EXPORTABLE DBConnectionPoolGetAcquiredCount();
+void LIBNXDB_EXPORTABLE DBConnectionPoolGetWaitTimeHistogram(uint32_t *histogram);
 
 void LIBNXDB_EXPORTABLE DBSetLongRunningThreshold(uint32_t threshold);
 void LIBNXDB_EXPORTABLE DBSetLongRunningThreshold(DB_HANDLE conn, uint32_t threshold);
@@ -164,6 +164,8 @@ typedef std::function<bool (const TCHAR* parameter, const TCHAR *value)> LogPars
 typedef std::function<void (const TCHAR*, const TCHAR*, uint32_t, uint32_t, void*)> LogParserCopyCallback;
 
 class LIBNXLP_EXPORTABLE LogParser;
+class LogParserPrefilter;
+struct FileChangeWatch;
 
 #ifdef _WIN32
 
@@ -355,6 +357,7 @@ class LIBNXLP_EXPORTABLE LogParserRule
    bool isRepeatReset() const { return m_resetRepeat; }
 
 	const TCHAR *getRegexpSource() const { return CHECK_NULL(m_regexp); }
+   bool isIgnoreCase() const { return m_ignoreCase; }
 
    int getCheckCount(uint32_t objectId = 0) const;
    int getMatchCount(uint32_t objectId = 0) const;
@@ -369,6 +372,7 @@ class LIBNXLP_EXPORTABLE LogParser
 {
 private:
 	ObjectArray<LogParserRule> m_rules;
+   LogParserPrefilter *m_prefilter;
 	StringMap m_contexts;
 	StringMap m_macros;
 	LogParserCallback m_cb;
@@ -386,6 +390,8 @@ class LIBNXLP_EXPORTABLE LogParser
 	bool (*m_eventResolver)(const TCHAR *, uint32_t *);
 	THREAD m_thread;	// Associated thread
    Condition m_stopCondition;
+   Condition m_fileChangeCondition;
+   FileChangeWatch *m_fileChangeWatch;
    int m_recordsProcessed;
 	int m_recordsMatched;
 	bool m_preallocatedFile;
@@ -422,6 +428,8 @@ class LIBNXLP_EXPORTABLE LogParser
    off_t processNewRecords(int fh, const TCHAR *fileName, bool processIncompleteRecord = false);
    void processRecord(char *record, const TCHAR *fileName);
    bool monitorFile2(off_t startOffset);
+   bool waitForFileChange(uint32_t timeout);
+   uint32_t getIdleCheckInterval() const;
 
 #ifdef _WIN32
    bool monitorFileWithSnapshot(off_t startOffset);
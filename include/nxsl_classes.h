@@ -1156,6 +1156,7 @@ class LIBNXSL_EXPORTABLE NXSL_VariableSystem : public NXSL_RuntimeObject
    NXSL_VariableSystemType m_type;
    int m_restorePointCount;
    VREF_RESTORE_POINT m_restorePoints[MAX_VREF_RESTORE_POINTS];
+   uint64_t m_frameId;   // Unique ID used to validate variables cached in VM slot table
 
 public:
    NXSL_VariableSystem(NXSL_VM *vm, NXSL_VariableSystemType type);
@@ -1169,6 +1170,8 @@ class LIBNXSL_EXPORTABLE NXSL_VariableSystem : public NXSL_RuntimeObject
    void remove(const NXSL_Identifier& name);
    void clear();
    bool isConstant() const { return m_type == NXSL_VariableSystemType::CONSTANT; }
+   NXSL_VariableSystemType getType() const { return m_type; }
+   uint64_t getFrameId() const { return m_frameId; }
 
    bool createVariableReferenceRestorePoint(uint32_t addr, NXSL_Identifier *identifier);
    void restoreVariableReferences(StructArray<NXSL_Instruction> *instructions);
@@ -1369,6 +1372,18 @@ class LIBNXSL_EXPORTABLE NXSL_LocalStorage : public NXSL_Storage
 
    virtual void write(const TCHAR *name, NXSL_Value *value) override;
    virtual NXSL_Value *read(const TCHAR *name, NXSL_ValueManager *vm) override;
+
+   void clear() { m_values->clear(); }
+};
+
+/**
+ * Variable resolved by slot index. Cached variable is valid only within local variable system
+ * (call frame) with matching frame ID.
+ */
+struct NXSL_VariableSlot
+{
+   NXSL_Variable *variable;
+   uint64_t frameId;
 };
 
 /**
@@ -1388,6 +1403,9 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
 	void *m_userData;
 
    StructArray<NXSL_Instruction> m_instructionSet;
+   NXSL_VariableSlot *m_variableSlots;
+   uint32_t m_variableSlotCount;
+   uint64_t m_frameIdSequence;
    uint32_t m_cp;
    bool m_stopFlag;
    Condition m_stopCondition;
@@ -1449,10 +1467,12 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
    NXSL_Variable *findVariable(const NXSL_Identifier& name, NXSL_VariableSystem **vs = nullptr);
    NXSL_Variable *findOrCreateVariable(const NXSL_Identifier& name, NXSL_VariableSystem **vs = nullptr);
    NXSL_Variable *findOrCreateLocalVariable(const NXSL_Identifier& name);
+   NXSL_Variable *findOrCreateSlotVariable(const NXSL_Instruction *instruction, NXSL_VariableSystem **vs);
 	NXSL_Variable *createVariable(const NXSL_Identifier& name);
 	bool isDefinedConstant(const NXSL_Identifier& name);
 
    void relocateCode(uint32_t startOffset, uint32_t len, uint32_t shift);
+   void assignVariableSlots();
    uint32_t getFunctionAddress(const NXSL_Identifier& name);
    const NXSL_ExtFunction *findExternalFunction(const NXSL_Identifier& name);
 
@@ -1492,6 +1512,8 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
    NXSL_VM(NXSL_Environment *env = nullptr, NXSL_Storage *storage = nullptr);
    virtual ~NXSL_VM();
 
+   uint64_t createFrameId() { return ++m_frameIdSequence; }
+
    bool loadModule(NXSL_Program *module, const NXSL_ModuleImport *importInfo);
    bool loadExternalModule(const NXSL_ExtModule *module, const NXSL_ModuleImport *importInfo);
 
@@ -1508,6 +1530,7 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
 	void setContextObject(NXSL_Value *value);
 
    bool load(const NXSL_Program *program);
+   void reset();
    void setInstructionTraceFile(FILE *fp) { m_instructionTraceFile = fp; }
    bool run(const ObjectRefArray<NXSL_Value>& args, NXSL_VariableSystem **globals = nullptr,
             NXSL_VariableSystem **expressionVariables = nullptr,
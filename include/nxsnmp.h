@@ -63,6 +63,11 @@
  */
 #define SNMP_DEFAULT_MSG_MAX_SIZE   ((size_t)65507)
 
+/**
+ * Initial max-repetitions value for GETBULK based walk (adjusted at runtime within each walk)
+ */
+#define SNMP_BULK_WALK_INITIAL_REPETITIONS   10
+
 //
 // OID comparision results
 //
@@ -1050,6 +1055,17 @@ class LIBNXSNMP_EXPORTABLE SNMP_PDU
    SNMP_Version getVersion() const { return m_version; }
    SNMP_ErrorCode getErrorCode() const { return static_cast<SNMP_ErrorCode>(m_errorCode); }
 
+   /**
+    * Set GETBULK request parameters (encoded in place of error status and error index)
+    */
+   void setBulkParameters(uint32_t nonRepeaters, uint32_t maxRepetitions)
+   {
+      m_errorCode = nonRepeaters;
+      m_errorIndex = maxRepetitions;
+   }
+   uint32_t getNonRepeaters() const { return m_errorCode; }
+   uint32_t getMaxRepetitions() const { return m_errorIndex; }
+
    void setTrapId(const SNMP_ObjectId& id) { setTrapId(id.value(), id.length()); }
    void setTrapId(const uint32_t *value, size_t length);
    const SNMP_ObjectId& getTrapId() const { return m_trapId; }
@@ -1102,6 +1118,7 @@ class LIBNXSNMP_EXPORTABLE SNMP_Transport
 	bool m_reliable;
 	SNMP_Version m_snmpVersion;
 	SNMP_Codepage m_codepage;
+	uint32_t m_bulkWalkMaxRepetitions;   // 0 if GETBULK should not be used for walks
 
 	uint32_t doEngineIdDiscovery(SNMP_PDU *originalRequest, uint32_t timeout, int numRetries);
 
@@ -1115,6 +1132,7 @@ class LIBNXSNMP_EXPORTABLE SNMP_Transport
 	   m_updatePeerOnRecv = false;
 	   m_reliable = false;
 	   m_snmpVersion = SNMP_VERSION_2C;
+	   m_bulkWalkMaxRepetitions = 0;
 	}
    virtual ~SNMP_Transport();
 
@@ -1145,6 +1163,17 @@ class LIBNXSNMP_EXPORTABLE SNMP_Transport
 	SNMP_Version getSnmpVersion() const { return m_snmpVersion; }
 
    void setCodepage(const char* codepage) { strlcpy(m_codepage.codepage, codepage, 16); }
+   const char *getCodepage() const { return m_codepage.codepage; }
+
+   /**
+    * Enable use of GETBULK requests by SnmpWalk (only effective for SNMP version 2c and 3). Transport keeps only
+    * configured limit; adaptive max-repetitions value is maintained by each walk, so transports reused from pool
+    * do not carry state from previous walks.
+    */
+   void enableBulkWalk(uint32_t maxRepetitions) { m_bulkWalkMaxRepetitions = maxRepetitions; }
+   void disableBulkWalk() { m_bulkWalkMaxRepetitions = 0; }
+   bool isBulkWalkEnabled() const { return m_bulkWalkMaxRepetitions > 0; }
+   uint32_t getBulkWalkMaxRepetitions() const { return m_bulkWalkMaxRepetitions; }
 };
 
 /**
@@ -1205,6 +1234,61 @@ class LIBNXSNMP_EXPORTABLE SNMP_UDPTransport : public SNMP_Transport
    }
 };
 
+/**
+ * Callback for asynchronous SNMP request completion. Callback receives request completion code and
+ * response PDU (nullptr if request failed). Callback takes ownership of response PDU.
+ */
+typedef std::function<void (uint32_t, SNMP_PDU*)> SNMP_AsyncCallback;
+
+struct SNMP_AsyncRequest;
+
+/**
+ * Number of slots in asynchronous SNMP engine timer wheel
+ */
+#define SNMP_ASYNC_TIMER_WHEEL_SIZE 1024
+
+/**
+ * Asynchronous SNMP engine. Multiplexes requests to many agents over small set of shared UDP sockets,
+ * matching responses by request ID. Only SNMPv1 and SNMPv2c requests are supported.
+ */
+class LIBNXSNMP_EXPORTABLE SNMP_AsyncEngine
+{
+private:
+   int m_numSockets;
+   SOCKET *m_sockets;
+   SOCKET *m_socketsV6;
+   VolatileCounter m_nextSocket;
+   ThreadPool *m_callbackPool;
+   Mutex m_mutex;
+   HashMap<uint32_t, SNMP_AsyncRequest> m_requests;
+   SNMP_AsyncRequest *m_timerWheel[SNMP_ASYNC_TIMER_WHEEL_SIZE];
+   uint64_t m_currentTick;
+   int64_t m_startTime;
+   uint32_t m_nextRequestId;
+   THREAD m_ioThread;
+   bool m_shutdown;
+
+   void ioThread();
+   void processIncomingPacket(SOCKET s, BYTE *buffer, size_t bufferSize);
+   void processTimers();
+   void scheduleTimer(SNMP_AsyncRequest *request);
+   void cancelTimer(SNMP_AsyncRequest *request);
+   void completeRequest(SNMP_AsyncRequest *request, uint32_t rcc, SNMP_PDU *response);
+   uint64_t getTick() const;
+
+public:
+   SNMP_AsyncEngine(int numSockets = 4, ThreadPool *callbackPool = nullptr);
+   ~SNMP_AsyncEngine();
+
+   bool start();
+   void stop();
+
+   uint32_t sendRequest(SNMP_PDU *request, const InetAddress& addr, uint16_t port, SNMP_SecurityContext *securityContext,
+            uint32_t timeout, int numRetries, SNMP_AsyncCallback callback, const char *codepage = nullptr);
+
+   int getPendingRequestCount();
+};
+
 struct SNMP_SnapshotIndexEntry;
 
 /**
@@ -21,6 +21,7 @@
 **/
 
 #include "nxagentd.h"
+#include "datasender.h"
 
 #define DEBUG_TAG _T("dc")
 
@@ -49,6 +50,8 @@ extern Mutex g_proxyListLock;
 
 extern uint32_t g_dcReconciliationBlockSize;
 extern uint32_t g_dcReconciliationTimeout;
+extern uint32_t g_dcSenderBatchSize;
+extern uint32_t g_dcSenderWindowSize;
 extern uint32_t g_dcWriterFlushInterval;
 extern uint32_t g_dcWriterMaxTransactionSize;
 extern uint32_t g_dcMinCollectorPoolSize;
@@ -858,7 +861,7 @@ bool DataElement::sendToServer(bool reconciliation) const
 }
 
 /**
- * Fill bulk reconciliation message with DCI data
+ * Fill bulk reconciliation or data batch message with DCI data
  */
 void DataElement::fillReconciliationMessage(NXCPMessage *msg, uint32_t baseId) const
 {
@@ -1203,44 +1206,281 @@ static void ReconciliationThread()
 static Queue s_dataSenderQueue;
 
 /**
- * Data sender
+ * Timeout for data batch acknowledgement (milliseconds)
  */
-static void DataSender()
+#define DATA_BATCH_TIMEOUT    10000
+
+/**
+ * Data batch sent to server and waiting for acknowledgement
+ */
+struct DataSenderBatch
 {
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("Data sender thread started"));
-   while(true)
+   shared_ptr<CommSession> session;
+   uint64_t serverId;
+   uint32_t requestId;
+   int64_t sendTime;
+   ObjectArray<DataElement> elements;
+
+   DataSenderBatch(const shared_ptr<CommSession>& _session, uint64_t _serverId, uint32_t _requestId) : session(_session), elements(64, 64, Ownership::True)
    {
-      DataElement *e = static_cast<DataElement*>(s_dataSenderQueue.getOrBlock());
-      if (e == INVALID_POINTER_VALUE)
-         break;
+      serverId = _serverId;
+      requestId = _requestId;
+      sendTime = 0;
+   }
+};
 
-      s_serverSyncStatusLock.lock();
-      ServerSyncStatus *status = s_serverSyncStatus.get(e->getServerId());
-      if (status == nullptr)
+/**
+ * Put data elements into local database queue for later reconciliation. Server sync status lock must be held by caller.
+ */
+static void DeferDataElements(ServerSyncStatus *status, ObjectArray<DataElement> *elements)
+{
+   for(int i = 0; i < elements->size(); i++)
+      s_databaseWriterQueue.put(elements->get(i));
+   if (status != nullptr)
+      status->queueSize += elements->size();
+   elements->setOwner(Ownership::False);
+   elements->clear();
+   elements->setOwner(Ownership::True);
+}
+
+/**
+ * Wait for acknowledgement of data batch and update server sync status. Elements not accepted by server are put into
+ * local database queue. Returns true if server accepted (or rejected permanently) all elements in batch.
+ */
+static bool CompleteDataBatch(DataSenderBatch *batch, uint32_t timeout)
+{
+   NXCPMessage *response = batch->session->waitForMessage(CMD_REQUEST_COMPLETED, batch->requestId, timeout);
+   uint32_t rcc = (response != nullptr) ? response->getFieldAsUInt32(VID_RCC) : ERR_REQUEST_TIMEOUT;
+
+   BYTE status[MAX_BULK_DATA_BLOCK_SIZE];
+   if (rcc == ERR_SUCCESS)
+   {
+      memset(status, BULK_DATA_REC_RETRY, batch->elements.size());
+      response->getFieldAsBinary(VID_STATUS, status, batch->elements.size());
+   }
+   else
+   {
+      // Consider internal error as success because it means that server
+      // cannot accept data for some reason and retry is not feasible
+      nxlog_debug_tag(DEBUG_TAG, 6, _T("DataSender: batch %u (%d elements) failed (%u)"), batch->requestId, batch->elements.size(), rcc);
+      memset(status, (rcc == ERR_INTERNAL_ERROR) ? BULK_DATA_REC_FAILURE : BULK_DATA_REC_RETRY, batch->elements.size());
+   }
+   delete response;
+
+   ObjectArray<DataElement> retryList(0, 64, Ownership::False);
+   for(int i = 0; i < batch->elements.size(); i++)
+   {
+      if (status[i] == BULK_DATA_REC_RETRY)
+         retryList.add(batch->elements.get(i));
+   }
+   if (retryList.isEmpty())
+      return true;
+
+   s_serverSyncStatusLock.lock();
+   ServerSyncStatus *serverSyncStatus = s_serverSyncStatus.get(batch->serverId);
+   for(int i = 0; i < retryList.size(); i++)
+   {
+      s_databaseWriterQueue.put(retryList.get(i));
+      batch->elements.unlink(retryList.get(i));
+   }
+   if (serverSyncStatus != nullptr)
+      serverSyncStatus->queueSize += retryList.size();
+   s_serverSyncStatusLock.unlock();
+   return false;
+}
+
+/**
+ * Wait for acknowledgement of oldest batch in the window. If that batch was not fully accepted, all later batches
+ * for same server are completed immediately in send order (each waiting for its own acknowledgement), so that
+ * elements not accepted from them are put into local database queue after those deferred from oldest batch and
+ * newer values will not overtake deferred ones. Elements already accepted by server are not re-sent. New values
+ * for that server will go to local database queue as well until reconciliation catches up.
+ */
+static void CompleteOldestDataBatch(DataSenderWindow<DataSenderBatch> *window)
+{
+   DataSenderBatch *batch = window->takeOldest();
+   if (!CompleteDataBatch(batch, window->getWaitTime(batch, GetCurrentTimeMs())))
+   {
+      ObjectArray<DataSenderBatch> laterBatches(16, 16, Ownership::True);
+      window->takeServerBatches(batch->serverId, &laterBatches);
+      if (!laterBatches.isEmpty())
       {
-         status = new ServerSyncStatus(e->getServerId());
-         s_serverSyncStatus.set(e->getServerId(), status);
+         nxlog_debug_tag(DEBUG_TAG, 6, _T("DataSender: batch %u not fully accepted, completing %d later batches for server ") UINT64X_FMT(_T("016")),
+                  batch->requestId, laterBatches.size(), batch->serverId);
+         for(int i = 0; i < laterBatches.size(); i++)
+         {
+            DataSenderBatch *laterBatch = laterBatches.get(i);
+            CompleteDataBatch(laterBatch, window->getWaitTime(laterBatch, GetCurrentTimeMs()));
+         }
       }
+   }
+   delete batch;
+}
+
+/**
+ * Send collected data elements for one server. Item values are sent as single batch message if supported by server,
+ * without waiting for acknowledgement (up to configured number of batches can be in flight).
+ */
+static void SendDataElements(uint64_t serverId, ObjectArray<DataElement> *elements, DataSenderWindow<DataSenderBatch> *window)
+{
+   shared_ptr<CommSession> session = static_pointer_cast<CommSession>(FindServerSession(SessionComparator_Sender, &serverId));
+   if ((session != nullptr) && session->isDataBatchingSupported())
+   {
+      // Acknowledgement of earlier batch can cause deferral of values for this server, so window slot
+      // should be available before new batch is built
+      while(window->size() >= static_cast<int>(g_dcSenderWindowSize))
+         CompleteOldestDataBatch(window);
 
-      if (status->queueSize == 0)
+      s_serverSyncStatusLock.lock();
+      ServerSyncStatus *status = s_serverSyncStatus.get(serverId);
+      bool deferred = (status != nullptr) && (status->queueSize > 0);
+      s_serverSyncStatusLock.unlock();
+
+      if (!deferred)
       {
-         if (!e->sendToServer(false))
+         DataSenderBatch *batch = new DataSenderBatch(session, serverId, session->generateRequestId());
+         NXCPMessage msg(CMD_DCI_DATA_BATCH, batch->requestId, session->getProtocolVersion());
+         uint32_t fieldId = VID_ELEMENT_LIST_BASE;
+         for(int i = 0; i < elements->size(); i++)
          {
-            status->queueSize++;
-            s_databaseWriterQueue.put(e);
-            e = nullptr;
+            DataElement *e = elements->get(i);
+            if (e->getType() != DCO_TYPE_ITEM)
+               continue;   // Tables are sent individually
+            e->fillReconciliationMessage(&msg, fieldId);
+            fieldId += 10;
+            batch->elements.add(e);
+            elements->unlink(i--);
          }
+
+         if (!batch->elements.isEmpty())
+         {
+            msg.setField(VID_NUM_ELEMENTS, static_cast<uint32_t>(batch->elements.size()));
+            batch->sendTime = GetCurrentTimeMs();
+            if (session->sendMessage(&msg))
+            {
+               nxlog_debug_tag(DEBUG_TAG, 7, _T("DataSender: batch %u with %d elements sent to server ") UINT64X_FMT(_T("016")), batch->requestId, batch->elements.size(), serverId);
+               window->add(batch);
+            }
+            else
+            {
+               s_serverSyncStatusLock.lock();
+               DeferDataElements(s_serverSyncStatus.get(serverId), &batch->elements);
+               s_serverSyncStatusLock.unlock();
+               delete batch;
+            }
+         }
+         else
+         {
+            delete batch;
+         }
+      }
+   }
+
+   // Send remaining elements one by one
+   s_serverSyncStatusLock.lock();
+   ServerSyncStatus *status = s_serverSyncStatus.get(serverId);
+   if (session == nullptr)
+   {
+      DeferDataElements(status, elements);
+   }
+   while(!elements->isEmpty())
+   {
+      DataElement *e = elements->get(0);
+      if (((status == nullptr) || (status->queueSize == 0)) && e->sendToServer(false))
+      {
+         elements->remove(0);
+      }
+      else
+      {
+         DeferDataElements(status, elements);
+      }
+   }
+   s_serverSyncStatusLock.unlock();
+}
+
+/**
+ * Data sender
+ */
+static void DataSender()
+{
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Data sender thread started (batch size %u, window size %u)"), g_dcSenderBatchSize, g_dcSenderWindowSize);
+
+   DataSenderWindow<DataSenderBatch> window(DATA_BATCH_TIMEOUT);
+   HashMap<uint64_t, ObjectArray<DataElement>> pendingElements(Ownership::True);
+   bool shutdown = false;
+   while(!shutdown)
+   {
+      DataElement *e;
+      if (window.isEmpty())
+      {
+         e = static_cast<DataElement*>(s_dataSenderQueue.getOrBlock());
       }
       else
       {
-         status->queueSize++;
-         s_databaseWriterQueue.put(e);
-         e = nullptr;
+         e = static_cast<DataElement*>(s_dataSenderQueue.get());
+         if (e == nullptr)
+         {
+            // Nothing new to send, wait for oldest batch acknowledgement
+            CompleteOldestDataBatch(&window);
+            continue;
+         }
+      }
+
+      // Take all available elements up to batch size and group them by server
+      uint32_t count = 0;
+      s_serverSyncStatusLock.lock();
+      while(e != nullptr)
+      {
+         if (e == INVALID_POINTER_VALUE)
+         {
+            shutdown = true;
+            break;
+         }
+
+         ServerSyncStatus *status = s_serverSyncStatus.get(e->getServerId());
+         if (status == nullptr)
+         {
+            status = new ServerSyncStatus(e->getServerId());
+            s_serverSyncStatus.set(e->getServerId(), status);
+         }
+
+         if (status->queueSize == 0)
+         {
+            ObjectArray<DataElement> *elements = pendingElements.get(e->getServerId());
+            if (elements == nullptr)
+            {
+               elements = new ObjectArray<DataElement>(64, 64, Ownership::True);
+               pendingElements.set(e->getServerId(), elements);
+            }
+            elements->add(e);
+         }
+         else
+         {
+            // Keep order of values - send via reconciliation while there are cached values for this server
+            status->queueSize++;
+            s_databaseWriterQueue.put(e);
+         }
+
+         if (++count >= g_dcSenderBatchSize)
+            break;
+         e = static_cast<DataElement*>(s_dataSenderQueue.get());
       }
       s_serverSyncStatusLock.unlock();
 
-      delete e;
+      pendingElements.forEach(
+         [&window] (const uint64_t& serverId, ObjectArray<DataElement> *elements) -> EnumerationCallbackResult
+         {
+            SendDataElements(serverId, elements, &window);
+            return _CONTINUE;
+         });
+      pendingElements.clear();
    }
+
+   // Wait for acknowledgement of all outstanding batches (timeout is counted from send time, so
+   // total wait time is limited by single batch timeout)
+   while(!window.isEmpty())
+      CompleteOldestDataBatch(&window);
+
    nxlog_debug_tag(DEBUG_TAG, 1, _T("Data sender thread stopped"));
 }
 
@@ -1735,6 +1975,28 @@ void StartLocalDataCollector()
       g_dcReconciliationBlockSize = MAX_BULK_DATA_BLOCK_SIZE;
    }
 
+   if (g_dcSenderBatchSize < 1)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data sender batch size %d, resetting to 1"), g_dcSenderBatchSize);
+      g_dcSenderBatchSize = 1;
+   }
+   else if (g_dcSenderBatchSize > MAX_BULK_DATA_BLOCK_SIZE)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data sender batch size %d, resetting to %d"), g_dcSenderBatchSize, MAX_BULK_DATA_BLOCK_SIZE);
+      g_dcSenderBatchSize = MAX_BULK_DATA_BLOCK_SIZE;
+   }
+
+   if (g_dcSenderWindowSize < 1)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data sender window size %d, resetting to 1"), g_dcSenderWindowSize);
+      g_dcSenderWindowSize = 1;
+   }
+   else if (g_dcSenderWindowSize > 64)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data sender window size %d, resetting to 64"), g_dcSenderWindowSize);
+      g_dcSenderWindowSize = 64;
+   }
+
    if (g_dcReconciliationTimeout < 1000)
    {
       nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data reconciliation timeout %d, resetting to 1000"), g_dcReconciliationTimeout);
@@ -0,0 +1,94 @@
+/*
+** NetXMS multiplatform core agent
+** Copyright (C) 2026 Raden Solutions
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: datasender.h
+**
+**/
+
+#ifndef _datasender_h_
+#define _datasender_h_
+
+/**
+ * Window of data batches sent to servers and waiting for acknowledgement. Batches are kept in send order.
+ * Batch type should have public members serverId (uint64_t) and sendTime (int64_t, milliseconds).
+ */
+template<typename B> class DataSenderWindow
+{
+private:
+   ObjectArray<B> m_batches;
+   uint32_t m_timeout;
+
+public:
+   DataSenderWindow(uint32_t timeout) : m_batches(64, 64, Ownership::True)
+   {
+      m_timeout = timeout;
+   }
+
+   int size() const { return m_batches.size(); }
+   bool isEmpty() const { return m_batches.isEmpty(); }
+
+   void add(B *batch) { m_batches.add(batch); }
+
+   /**
+    * Get oldest batch (or nullptr if window is empty)
+    */
+   B *oldest() { return m_batches.isEmpty() ? nullptr : m_batches.get(0); }
+
+   /**
+    * Remove oldest batch from window. Caller becomes owner of returned batch.
+    */
+   B *takeOldest()
+   {
+      if (m_batches.isEmpty())
+         return nullptr;
+      B *batch = m_batches.get(0);
+      m_batches.unlink(0);
+      return batch;
+   }
+
+   /**
+    * Get remaining time for waiting for acknowledgement of given batch. Timeout is counted from send time,
+    * so draining several batches sent at about same time takes at most one timeout in total.
+    */
+   uint32_t getWaitTime(const B *batch, int64_t now) const
+   {
+      int64_t elapsed = now - batch->sendTime;
+      if (elapsed >= static_cast<int64_t>(m_timeout))
+         return 0;
+      return (elapsed > 0) ? m_timeout - static_cast<uint32_t>(elapsed) : m_timeout;
+   }
+
+   /**
+    * Remove all batches for given server from window, keeping send order. Used when earlier batch for same server
+    * was not fully accepted, so that later values will not overtake deferred ones. Caller becomes owner of removed batches.
+    */
+   void takeServerBatches(uint64_t serverId, ObjectArray<B> *batches)
+   {
+      for(int i = 0; i < m_batches.size(); i++)
+      {
+         B *batch = m_batches.get(i);
+         if (batch->serverId == serverId)
+         {
+            batches->add(batch);
+            m_batches.unlink(i--);
+         }
+      }
+   }
+};
+
+#endif
@@ -62,7 +62,8 @@ static Mutex s_componentTokensLock(MutexType::FAST);
 /**
  * Constructor
  */
-ExternalSubagent::ExternalSubagent(const TCHAR *name, const TCHAR *user)
+ExternalSubagent::ExternalSubagent(const TCHAR *name, const TCHAR *user) : m_parameters(0, 64), m_lists(0, 16), m_tables(0, 16),
+         m_parameterIndex(m_parameters), m_listIndex(m_lists), m_tableIndex(m_tables)
 {
    _tcslcpy(m_name, name, MAX_SUBAGENT_NAME);
    _tcslcpy(m_user, user, MAX_ESA_USER_NAME);
@@ -73,6 +74,8 @@ ExternalSubagent::ExternalSubagent(const TCHAR *name, const TCHAR *user)
    m_requestId = 1;
    m_listenerStartDelay = 10000;
    m_connectedPid = 0;
+   m_connectionId = 0;
+   m_registrationsLoaded = false;
 }
 
 /**
@@ -159,6 +162,10 @@ static void ForwardSessionMessage(NXCPMessage *msg)
  */
 void ExternalSubagent::connect(NamedPipe *pipe)
 {
+   m_registrationLock.writeLock();
+   m_connectionId++;
+   m_registrationLock.unlock();
+
    m_pipe = pipe;
    m_connected = true;
    nxlog_debug_tag(DEBUG_TAG, 2, _T("ExternalSubagent(%s): connection established"), m_name);
@@ -166,6 +173,9 @@ void ExternalSubagent::connect(NamedPipe *pipe)
    syncPolicies();
    sendCachedComponentTokens();
 
+   // Registrations are requested from separate thread because responses are delivered by receiver loop below
+   ThreadPoolExecute(g_commThreadPool, this, &ExternalSubagent::loadRegistrations);
+
    PipeMessageReceiver receiver(pipe->handle(), 8192, 1048576);  // 8K initial, 1M max
 	while(!(g_dwFlags & AF_SHUTDOWN))
 	{
@@ -214,6 +224,7 @@ void ExternalSubagent::connect(NamedPipe *pipe)
 	nxlog_debug_tag(DEBUG_TAG, 2, _T("ExternalSubagent(%s): connection closed"), m_name);
 	m_connected = false;
 	m_connectedPid = 0;
+	clearRegistrations();
 	m_msgQueue->clear();
 	m_pipe = nullptr;
 }
@@ -377,6 +388,98 @@ ActionList *ExternalSubagent::getSupportedActions()
 	return result;
 }
 
+/**
+ * Load metrics, lists, and tables registered by connected subagent into dispatch indexes
+ */
+void ExternalSubagent::loadRegistrations()
+{
+   m_registrationLock.readLock();
+   uint32_t connectionId = m_connectionId;
+   m_registrationLock.unlock();
+
+   UINT32 paramCount = 0, listCount = 0, tableCount = 0;
+   NETXMS_SUBAGENT_PARAM *parameters = getSupportedParameters(&paramCount);
+   NETXMS_SUBAGENT_LIST *lists = (parameters != nullptr) ? getSupportedLists(&listCount) : nullptr;
+   NETXMS_SUBAGENT_TABLE *tables = (lists != nullptr) ? getSupportedTables(&tableCount) : nullptr;
+
+   m_registrationLock.writeLock();
+   if ((tables != nullptr) && m_connected && (connectionId == m_connectionId))
+   {
+      m_parameters.clear();
+      for(UINT32 i = 0; i < paramCount; i++)
+         m_parameters.add(&parameters[i]);
+      m_lists.clear();
+      for(UINT32 i = 0; i < listCount; i++)
+         m_lists.add(&lists[i]);
+      m_tables.clear();
+      for(UINT32 i = 0; i < tableCount; i++)
+         m_tables.add(&tables[i]);
+      m_parameterIndex.rebuild();
+      m_listIndex.rebuild();
+      m_tableIndex.rebuild();
+      m_registrationsLoaded = true;
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("ExternalSubagent(%s): %u metrics, %u lists, and %u tables registered"), m_name, paramCount, listCount, tableCount);
+   }
+   else
+   {
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("ExternalSubagent(%s): cannot load registrations, all requests will be forwarded"), m_name);
+   }
+   m_registrationLock.unlock();
+
+   MemFree(parameters);
+   MemFree(lists);
+   MemFree(tables);
+}
+
+/**
+ * Drop registrations loaded from disconnected subagent
+ */
+void ExternalSubagent::clearRegistrations()
+{
+   m_registrationLock.writeLock();
+   m_registrationsLoaded = false;
+   m_parameterIndex.clear();
+   m_listIndex.clear();
+   m_tableIndex.clear();
+   m_parameters.clear();
+   m_lists.clear();
+   m_tables.clear();
+   m_registrationLock.unlock();
+}
+
+/**
+ * Check if subagent may provide given metric. If registrations are not loaded yet, any metric is assumed to be possible.
+ */
+bool ExternalSubagent::mayProvideParameter(const TCHAR *name)
+{
+   m_registrationLock.readLock();
+   bool result = !m_registrationsLoaded || (m_parameterIndex.find(name) != nullptr);
+   m_registrationLock.unlock();
+   return result;
+}
+
+/**
+ * Check if subagent may provide given list. If registrations are not loaded yet, any list is assumed to be possible.
+ */
+bool ExternalSubagent::mayProvideList(const TCHAR *name)
+{
+   m_registrationLock.readLock();
+   bool result = !m_registrationsLoaded || (m_listIndex.find(name) != nullptr);
+   m_registrationLock.unlock();
+   return result;
+}
+
+/**
+ * Check if subagent may provide given table. If registrations are not loaded yet, any table is assumed to be possible.
+ */
+bool ExternalSubagent::mayProvideTable(const TCHAR *name)
+{
+   m_registrationLock.readLock();
+   bool result = !m_registrationsLoaded || (m_tableIndex.find(name) != nullptr);
+   m_registrationLock.unlock();
+   return result;
+}
+
 /**
  * List supported parameters
  */
@@ -932,9 +1035,10 @@ uint32_t GetParameterValueFromExtSubagent(const TCHAR *name, TCHAR *buffer)
    uint32_t rc = ERR_UNKNOWN_METRIC;
 	for(int i = 0; i < s_subagents.size(); i++)
 	{
-		if (s_subagents.get(i)->isConnected())
+		ExternalSubagent *subagent = s_subagents.get(i);
+		if (subagent->isConnected() && subagent->mayProvideParameter(name))
 		{
-			rc = s_subagents.get(i)->getParameter(name, buffer);
+			rc = subagent->getParameter(name, buffer);
 			if (rc != ERR_UNKNOWN_METRIC)
 				break;
 		}
@@ -952,9 +1056,10 @@ uint32_t GetTableValueFromExtSubagent(const TCHAR *name, Table *value)
    uint32_t rc = ERR_UNKNOWN_METRIC;
 	for(int i = 0; i < s_subagents.size(); i++)
 	{
-		if (s_subagents.get(i)->isConnected())
+		ExternalSubagent *subagent = s_subagents.get(i);
+		if (subagent->isConnected() && subagent->mayProvideTable(name))
 		{
-			rc = s_subagents.get(i)->getTable(name, value);
+			rc = subagent->getTable(name, value);
 			if (rc != ERR_UNKNOWN_METRIC)
 				break;
 		}
@@ -972,9 +1077,10 @@ uint32_t GetListValueFromExtSubagent(const TCHAR *name, StringList *value)
    uint32_t rc = ERR_UNKNOWN_METRIC;
 	for(int i = 0; i < s_subagents.size(); i++)
 	{
-		if (s_subagents.get(i)->isConnected())
+		ExternalSubagent *subagent = s_subagents.get(i);
+		if (subagent->isConnected() && subagent->mayProvideList(name))
 		{
-			rc = s_subagents.get(i)->getList(name, value);
+			rc = subagent->getList(name, value);
 			if (rc != ERR_UNKNOWN_METRIC)
 				break;
 		}
@@ -0,0 +1,144 @@
+/*
+** NetXMS multiplatform core agent
+** Copyright (C) 2026 Raden Solutions
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: metricindex.h
+**
+**/
+
+#ifndef _metricindex_h_
+#define _metricindex_h_
+
+/**
+ * Dispatch index for registered metrics, lists, or tables. Registrations are grouped by name part before opening
+ * bracket (case insensitive), so request is matched only against registrations with same base name. Registrations
+ * with wildcard characters in base name are kept in separate list and checked for every request. Elements are
+ * referenced by position in registration array, so that first matching registration wins as with linear scan.
+ * Registration type should have public member name (TCHAR array).
+ */
+template<typename T> class MetricDispatchIndex
+{
+private:
+   const StructArray<T>& m_elements;
+   StringObjectMap<IntegerArray<int>> m_named;
+   IntegerArray<int> m_wildcards;
+
+   /**
+    * Build lookup key from name. Returns false if key part contains wildcard characters.
+    */
+   static bool buildKey(const TCHAR *name, TCHAR *key)
+   {
+      bool wildcard = false;
+      int i;
+      for(i = 0; (name[i] != 0) && (name[i] != _T('(')) && (i < MAX_PARAM_NAME - 1); i++)
+      {
+         if ((name[i] == _T('*')) || (name[i] == _T('?')))
+            wildcard = true;
+         key[i] = _totupper(name[i]);
+      }
+      key[i] = 0;
+      return !wildcard;
+   }
+
+public:
+   MetricDispatchIndex(const StructArray<T>& elements) : m_elements(elements), m_named(Ownership::True), m_wildcards(0, 16)
+   {
+      rebuild();
+   }
+
+   /**
+    * Add element at given position in registration array to index
+    */
+   void add(int index)
+   {
+      TCHAR key[MAX_PARAM_NAME];
+      if (buildKey(m_elements.get(index)->name, key))
+      {
+         IntegerArray<int> *list = m_named.get(key);
+         if (list == nullptr)
+         {
+            list = new IntegerArray<int>(1, 4);
+            m_named.set(key, list);
+         }
+         list->add(index);
+      }
+      else
+      {
+         m_wildcards.add(index);
+      }
+   }
+
+   /**
+    * Remove all elements from index
+    */
+   void clear()
+   {
+      m_named.clear();
+      m_wildcards.clear();
+   }
+
+   /**
+    * Rebuild index from current content of registration array
+    */
+   void rebuild()
+   {
+      clear();
+      for(int i = 0; i < m_elements.size(); i++)
+         add(i);
+   }
+
+   /**
+    * Find first registration matching given name
+    */
+   T *find(const TCHAR *name) const
+   {
+      int found = INT_MAX;
+
+      TCHAR key[MAX_PARAM_NAME];
+      buildKey(name, key);
+      IntegerArray<int> *list = m_named.get(key);
+      if (list != nullptr)
+      {
+         for(int i = 0; i < list->size(); i++)
+         {
+            int index = list->get(i);
+            if (MatchString(m_elements.get(index)->name, name, false))
+            {
+               found = index;
+               break;
+            }
+         }
+      }
+
+      // Wildcard registrations made before found one take precedence
+      for(int i = 0; i < m_wildcards.size(); i++)
+      {
+         int index = m_wildcards.get(i);
+         if (index >= found)
+            break;
+         if (MatchString(m_elements.get(index)->name, name, false))
+         {
+            found = index;
+            break;
+         }
+      }
+
+      return (found != INT_MAX) ? m_elements.get(found) : nullptr;
+   }
+};
+
+#endif
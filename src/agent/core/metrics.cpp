@@ -711,6 +711,13 @@ static StructArray<NETXMS_SUBAGENT_PUSHPARAM> s_pushMetrics(0, 64);
 static StructArray<NETXMS_SUBAGENT_LIST> s_lists(s_standardLists, sizeof(s_standardLists) / sizeof(NETXMS_SUBAGENT_LIST), 16);
 static StructArray<NETXMS_SUBAGENT_TABLE> s_tables(s_standardTables, sizeof(s_standardTables) / sizeof(NETXMS_SUBAGENT_TABLE), 16);
 
+/**
+ * Dispatch indexes
+ */
+static MetricDispatchIndex<NETXMS_SUBAGENT_PARAM> s_metricIndex(s_metrics);
+static MetricDispatchIndex<NETXMS_SUBAGENT_LIST> s_listIndex(s_lists);
+static MetricDispatchIndex<NETXMS_SUBAGENT_TABLE> s_tableIndex(s_tables);
+
 /**
  * Handler for metrics list
  */
@@ -837,6 +844,7 @@ void AddMetric(const TCHAR *name, LONG (*handler)(const TCHAR*, const TCHAR*, TC
       _tcslcpy(np.description, description, MAX_DB_STRING);
       np.filter = filter;
       s_metrics.add(np);
+      s_metricIndex.add(s_metrics.size() - 1);
    }
 }
 
@@ -872,6 +880,7 @@ void AddList(const TCHAR *name, LONG (*handler)(const TCHAR*, const TCHAR*, Stri
       _tcslcpy(np.description, CHECK_NULL_EX(description), MAX_DB_STRING);
       np.filter = filter;
       s_lists.add(np);
+      s_listIndex.add(s_lists.size() - 1);
    }
 }
 
@@ -914,6 +923,7 @@ void AddTable(const TCHAR *name, LONG (* handler)(const TCHAR *, const TCHAR *,
       np.columns = columns;
       np.filter = filter;
       s_tables.add(np);
+      s_tableIndex.add(s_tables.size() - 1);
       nxlog_debug(7, _T("Table %s added (%d predefined columns, instance columns \"%s\")"), name, numColumns, instanceColumns);
    }
 }
@@ -1199,50 +1209,46 @@ uint32_t GetMetricValue(const TCHAR *param, TCHAR *value, AbstractCommSession *s
    uint32_t errorCode = ERR_UNKNOWN_METRIC;
 
    session->debugPrintf(5, _T("Requesting metric \"%s\""), param);
-   for(int i = 0; i < s_metrics.size(); i++)
-	{
-      NETXMS_SUBAGENT_PARAM *p = s_metrics.get(i);
-      if (MatchString(p->name, param, FALSE))
+   NETXMS_SUBAGENT_PARAM *p = s_metricIndex.find(param);
+   if (p != nullptr)
+   {
+      LONG rc = ((p->filter == nullptr) || p->filter(param, p->arg, session)) ? p->handler(param, p->arg, value, session) : SYSINFO_RC_ACCESS_DENIED;
+      switch(rc)
       {
-         LONG rc = ((p->filter == nullptr) || p->filter(param, p->arg, session)) ? p->handler(param, p->arg, value, session) : SYSINFO_RC_ACCESS_DENIED;
-         switch(rc)
-         {
-            case SYSINFO_RC_SUCCESS:
-               errorCode = ERR_SUCCESS;
-               InterlockedIncrement(&s_processedRequests);
-               break;
-            case SYSINFO_RC_ACCESS_DENIED:
-               errorCode = ERR_ACCESS_DENIED;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_TCP_PROXY_DISABLED:
-               errorCode = ERR_TCP_PROXY_DISABLED;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_ERROR:
-               errorCode = ERR_INTERNAL_ERROR;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_NO_SUCH_INSTANCE:
-               errorCode = ERR_NO_SUCH_INSTANCE;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_UNSUPPORTED:
-               errorCode = ERR_UNSUPPORTED_METRIC;
-               InterlockedIncrement(&s_unsupportedRequests);
-               break;
-            case SYSINFO_RC_UNKNOWN:
-               errorCode = ERR_UNKNOWN_METRIC;
-               break;
-            default:
-               nxlog_write(NXLOG_ERROR, _T("Internal error: unexpected return code %d in GetMetricValue(\"%s\")"), rc, param);
-               errorCode = ERR_INTERNAL_ERROR;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-         }
-         break;
+         case SYSINFO_RC_SUCCESS:
+            errorCode = ERR_SUCCESS;
+            InterlockedIncrement(&s_processedRequests);
+            break;
+         case SYSINFO_RC_ACCESS_DENIED:
+            errorCode = ERR_ACCESS_DENIED;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_TCP_PROXY_DISABLED:
+            errorCode = ERR_TCP_PROXY_DISABLED;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_ERROR:
+            errorCode = ERR_INTERNAL_ERROR;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_NO_SUCH_INSTANCE:
+            errorCode = ERR_NO_SUCH_INSTANCE;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_UNSUPPORTED:
+            errorCode = ERR_UNSUPPORTED_METRIC;
+            InterlockedIncrement(&s_unsupportedRequests);
+            break;
+         case SYSINFO_RC_UNKNOWN:
+            errorCode = ERR_UNKNOWN_METRIC;
+            break;
+         default:
+            nxlog_write(NXLOG_ERROR, _T("Internal error: unexpected return code %d in GetMetricValue(\"%s\")"), rc, param);
+            errorCode = ERR_INTERNAL_ERROR;
+            InterlockedIncrement(&s_failedRequests);
+            break;
       }
-	}
+   }
 
    if (errorCode == ERR_UNKNOWN_METRIC)
    {
@@ -1324,47 +1330,43 @@ uint32_t GetListValue(const TCHAR *param, StringList *value, AbstractCommSession
 {
    uint32_t errorCode = ERR_UNKNOWN_METRIC;
    session->debugPrintf(5, _T("Requesting list \"%s\""), param);
-   for(int i = 0; i < s_lists.size(); i++)
-	{
-      NETXMS_SUBAGENT_LIST *list = s_lists.get(i);
-      if (MatchString(list->name, param, false))
+   NETXMS_SUBAGENT_LIST *list = s_listIndex.find(param);
+   if (list != nullptr)
+   {
+      LONG rc = ((list->filter == nullptr) || list->filter(param, list->arg, session)) ? list->handler(param, list->arg, value, session) : SYSINFO_RC_ACCESS_DENIED;
+      switch(rc)
       {
-         LONG rc = ((list->filter == nullptr) || list->filter(param, list->arg, session)) ? list->handler(param, list->arg, value, session) : SYSINFO_RC_ACCESS_DENIED;
-         switch(rc)
-         {
-            case SYSINFO_RC_SUCCESS:
-               errorCode = ERR_SUCCESS;
-               InterlockedIncrement(&s_processedRequests);
-               break;
-            case SYSINFO_RC_ACCESS_DENIED:
-               errorCode = ERR_ACCESS_DENIED;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_TCP_PROXY_DISABLED:
-               errorCode = ERR_TCP_PROXY_DISABLED;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_ERROR:
-               errorCode = ERR_INTERNAL_ERROR;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_NO_SUCH_INSTANCE:
-               errorCode = ERR_NO_SUCH_INSTANCE;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_UNSUPPORTED:
-               errorCode = ERR_UNSUPPORTED_METRIC;
-               InterlockedIncrement(&s_unsupportedRequests);
-               break;
-            default:
-               nxlog_write(NXLOG_ERROR, _T("Internal error: unexpected return code %d in GetListValue(\"%s\")"), rc, param);
-               errorCode = ERR_INTERNAL_ERROR;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-         }
-         break;
+         case SYSINFO_RC_SUCCESS:
+            errorCode = ERR_SUCCESS;
+            InterlockedIncrement(&s_processedRequests);
+            break;
+         case SYSINFO_RC_ACCESS_DENIED:
+            errorCode = ERR_ACCESS_DENIED;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_TCP_PROXY_DISABLED:
+            errorCode = ERR_TCP_PROXY_DISABLED;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_ERROR:
+            errorCode = ERR_INTERNAL_ERROR;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_NO_SUCH_INSTANCE:
+            errorCode = ERR_NO_SUCH_INSTANCE;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_UNSUPPORTED:
+            errorCode = ERR_UNSUPPORTED_METRIC;
+            InterlockedIncrement(&s_unsupportedRequests);
+            break;
+         default:
+            nxlog_write(NXLOG_ERROR, _T("Internal error: unexpected return code %d in GetListValue(\"%s\")"), rc, param);
+            errorCode = ERR_INTERNAL_ERROR;
+            InterlockedIncrement(&s_failedRequests);
+            break;
       }
-	}
+   }
 
    if (errorCode == ERR_UNKNOWN_METRIC)
    {
@@ -1446,57 +1448,53 @@ uint32_t GetTableValue(const TCHAR *param, Table *value, AbstractCommSession *se
 {
    uint32_t errorCode = ERR_UNKNOWN_METRIC;
    session->debugPrintf(5, _T("Requesting table \"%s\""), param);
-   for(int i = 0; i < s_tables.size(); i++)
-	{
-      NETXMS_SUBAGENT_TABLE *t = s_tables.get(i);
-      if (MatchString(t->name, param, FALSE))
+   NETXMS_SUBAGENT_TABLE *t = s_tableIndex.find(param);
+   if (t != nullptr)
+   {
+      // pre-fill table columns if specified in table definition
+      if (t->numColumns > 0)
       {
-         // pre-fill table columns if specified in table definition
-         if (t->numColumns > 0)
+         for(int c = 0; c < t->numColumns; c++)
          {
-            for(int c = 0; c < t->numColumns; c++)
-            {
-               NETXMS_SUBAGENT_TABLE_COLUMN *col = &t->columns[c];
-               value->addColumn(col->name, col->dataType, col->displayName, col->isInstance);
-            }
+            NETXMS_SUBAGENT_TABLE_COLUMN *col = &t->columns[c];
+            value->addColumn(col->name, col->dataType, col->displayName, col->isInstance);
          }
+      }
 
-         LONG rc = ((t->filter == nullptr) || t->filter(param, t->arg, session)) ? t->handler(param, t->arg, value, session) : SYSINFO_RC_ACCESS_DENIED;
-         switch(rc)
-         {
-            case SYSINFO_RC_SUCCESS:
-               errorCode = ERR_SUCCESS;
-               InterlockedIncrement(&s_processedRequests);
-               break;
-            case SYSINFO_RC_ACCESS_DENIED:
-               errorCode = ERR_ACCESS_DENIED;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_TCP_PROXY_DISABLED:
-               errorCode = ERR_TCP_PROXY_DISABLED;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_ERROR:
-               errorCode = ERR_INTERNAL_ERROR;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_NO_SUCH_INSTANCE:
-               errorCode = ERR_NO_SUCH_INSTANCE;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-            case SYSINFO_RC_UNSUPPORTED:
-               errorCode = ERR_UNSUPPORTED_METRIC;
-               InterlockedIncrement(&s_unsupportedRequests);
-               break;
-            default:
-               nxlog_write(NXLOG_ERROR, _T("Internal error: unexpected return code %d in GetTableValue(\"%s\")"), rc, param);
-               errorCode = ERR_INTERNAL_ERROR;
-               InterlockedIncrement(&s_failedRequests);
-               break;
-         }
-         break;
+      LONG rc = ((t->filter == nullptr) || t->filter(param, t->arg, session)) ? t->handler(param, t->arg, value, session) : SYSINFO_RC_ACCESS_DENIED;
+      switch(rc)
+      {
+         case SYSINFO_RC_SUCCESS:
+            errorCode = ERR_SUCCESS;
+            InterlockedIncrement(&s_processedRequests);
+            break;
+         case SYSINFO_RC_ACCESS_DENIED:
+            errorCode = ERR_ACCESS_DENIED;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_TCP_PROXY_DISABLED:
+            errorCode = ERR_TCP_PROXY_DISABLED;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_ERROR:
+            errorCode = ERR_INTERNAL_ERROR;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_NO_SUCH_INSTANCE:
+            errorCode = ERR_NO_SUCH_INSTANCE;
+            InterlockedIncrement(&s_failedRequests);
+            break;
+         case SYSINFO_RC_UNSUPPORTED:
+            errorCode = ERR_UNSUPPORTED_METRIC;
+            InterlockedIncrement(&s_unsupportedRequests);
+            break;
+         default:
+            nxlog_write(NXLOG_ERROR, _T("Internal error: unexpected return code %d in GetTableValue(\"%s\")"), rc, param);
+            errorCode = ERR_INTERNAL_ERROR;
+            InterlockedIncrement(&s_failedRequests);
+            break;
       }
-	}
+   }
 
    if (errorCode == ERR_UNKNOWN_METRIC)
    {
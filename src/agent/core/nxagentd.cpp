@@ -231,6 +231,8 @@ uint32_t g_maxCommSessions = 0;
 uint32_t g_longRunningQueryThreshold = 250;
 uint32_t g_dcReconciliationBlockSize = 1024;
 uint32_t g_dcReconciliationTimeout = 60000;
+uint32_t g_dcSenderBatchSize = 256;
+uint32_t g_dcSenderWindowSize = 8;
 uint32_t g_dcWriterFlushInterval = 5000;
 uint32_t g_dcWriterMaxTransactionSize = 10000;
 uint32_t g_dcMinCollectorPoolSize = 4;
@@ -330,6 +332,8 @@ static NX_CFG_TEMPLATE m_cfgTemplate[] =
    { _T("DataCollectionMinThreadPoolSize"), CT_LONG, 0, 0, 0, 0, &g_dcMinCollectorPoolSize, nullptr },
    { _T("DataReconciliationBlockSize"), CT_LONG, 0, 0, 0, 0, &g_dcReconciliationBlockSize, nullptr },
    { _T("DataReconciliationTimeout"), CT_LONG, 0, 0, 0, 0, &g_dcReconciliationTimeout, nullptr },
+   { _T("DataSenderBatchSize"), CT_LONG, 0, 0, 0, 0, &g_dcSenderBatchSize, nullptr },
+   { _T("DataSenderWindowSize"), CT_LONG, 0, 0, 0, 0, &g_dcSenderWindowSize, nullptr },
    { _T("DataWriterFlushInterval"), CT_LONG, 0, 0, 0, 0, &g_dcWriterFlushInterval, nullptr },
    { _T("DataWriterMaxTransactionSize"), CT_LONG, 0, 0, 0, 0, &g_dcWriterMaxTransactionSize, nullptr },
    { _T("DailyLogFileSuffix"), CT_STRING, 0, 0, 64, 0, s_dailyLogFileSuffix, nullptr },
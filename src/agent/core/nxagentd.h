@@ -34,6 +34,7 @@
 #include <nxdbapi.h>
 #include <nxsnmp.h>
 #include "localdb.h"
+#include "metricindex.h"
 
 #ifdef _WIN32
 #include <aclapi.h>
@@ -282,6 +283,15 @@ class ExternalSubagent
 	VolatileCounter m_requestId;   // incremented concurrently from multiple threads
    uint32_t m_listenerStartDelay;
    uint32_t m_connectedPid;
+   uint32_t m_connectionId;
+   RWLock m_registrationLock;
+   bool m_registrationsLoaded;
+   StructArray<NETXMS_SUBAGENT_PARAM> m_parameters;
+   StructArray<NETXMS_SUBAGENT_LIST> m_lists;
+   StructArray<NETXMS_SUBAGENT_TABLE> m_tables;
+   MetricDispatchIndex<NETXMS_SUBAGENT_PARAM> m_parameterIndex;
+   MetricDispatchIndex<NETXMS_SUBAGENT_LIST> m_listIndex;
+   MetricDispatchIndex<NETXMS_SUBAGENT_TABLE> m_tableIndex;
 
 	bool sendMessage(const NXCPMessage *msg);
 	NXCPMessage *waitForMessage(uint16_t code, uint32_t id);
@@ -289,6 +299,8 @@ class ExternalSubagent
 	NETXMS_SUBAGENT_LIST *getSupportedLists(UINT32 *count);
 	NETXMS_SUBAGENT_TABLE *getSupportedTables(UINT32 *count);
 	ActionList *getSupportedActions();
+   void loadRegistrations();
+   void clearRegistrations();
 
 public:
 	ExternalSubagent(const TCHAR *name, const TCHAR *user);
@@ -303,6 +315,10 @@ class ExternalSubagent
 	const TCHAR *getUserName() { return m_user; }
 	uint32_t getConnectedPid() { return m_connectedPid; }
 
+   bool mayProvideParameter(const TCHAR *name);
+   bool mayProvideList(const TCHAR *name);
+   bool mayProvideTable(const TCHAR *name);
+
    uint32_t getParameter(const TCHAR *name, TCHAR *buffer);
    uint32_t getTable(const TCHAR *name, Table *value);
    uint32_t getList(const TCHAR *name, StringList *value);
@@ -398,6 +414,7 @@ class CommSession : public AbstractCommSession
    bool m_acceptFileUpdates;
    bool m_ipv6Aware;
    bool m_bulkReconciliationSupported;
+   bool m_dataBatchingSupported;    // server accepts batched DCI data messages
    bool m_allowCompression;   // allow compression for structured messages
    bool m_acceptKeepalive;    // true if server will respond to keepalive messages
    bool m_stopCommandProcessing;
@@ -481,6 +498,7 @@ class CommSession : public AbstractCommSession
    bool serverAcksTraps() const { return m_serverAcksTraps; }
    virtual bool canAcceptFileUpdates() override { return m_acceptFileUpdates; }
    virtual bool isBulkReconciliationSupported() override { return m_bulkReconciliationSupported; }
+   bool isDataBatchingSupported() const { return m_dataBatchingSupported; }
    virtual bool isIPv6Aware() override { return m_ipv6Aware; }
 
    virtual const TCHAR *getDebugTag() const override { return m_debugTag; }
@@ -125,6 +125,7 @@ CommSession::CommSession(const shared_ptr<AbstractCommChannel>& channel, const I
    m_pendingRequests = 0;
    m_ipv6Aware = false;
    m_bulkReconciliationSupported = false;
+   m_dataBatchingSupported = false;
    m_disconnected = false;
    m_allowCompression = false;
    m_acceptKeepalive = false;
@@ -780,13 +781,15 @@ void CommSession::processCommand(NXCPMessage *request)
             // Servers before 2.0 use VID_ENABLED
             m_ipv6Aware = request->isFieldExist(VID_IPV6_SUPPORT) ? request->getFieldAsBoolean(VID_IPV6_SUPPORT) : request->getFieldAsBoolean(VID_ENABLED);
             m_bulkReconciliationSupported = request->getFieldAsBoolean(VID_BULK_RECONCILIATION);
+            m_dataBatchingSupported = request->getFieldAsBoolean(VID_DATA_BATCHING);
             m_allowCompression = request->getFieldAsBoolean(VID_ENABLE_COMPRESSION);
             m_acceptKeepalive = request->getFieldAsBoolean(VID_ACCEPT_KEEPALIVE);
             response.setField(VID_RCC, ERR_SUCCESS);
             response.setField(VID_FLAGS, static_cast<uint16_t>((m_controlServer ? 0x01 : 0x00) | (m_masterServer ? 0x02 : 0x00) | ((m_masterServer || m_upgradeServer) ? 0x04 : 0x00)));
-            debugPrintf(4, _T("Server capabilities: IPv6: %s; bulk reconciliation: %s; compression: %s"),
+            debugPrintf(4, _T("Server capabilities: IPv6: %s; bulk reconciliation: %s; data batching: %s; compression: %s"),
                         m_ipv6Aware ? _T("yes") : _T("no"),
                         m_bulkReconciliationSupported ? _T("yes") : _T("no"),
+                        m_dataBatchingSupported ? _T("yes") : _T("no"),
                         m_allowCompression ? _T("yes") : _T("no"));
             break;
          case CMD_SET_SERVER_ID:
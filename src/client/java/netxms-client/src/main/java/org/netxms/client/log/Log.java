@@ -39,7 +39,7 @@
    private LinkedHashMap<String, LogColumn> columns;
    private String recordIdColumn;
    private String objectIdColumn;
-   private long numRecords;   // Number of records ready after successful query()
+   private long numRecords;   // Estimated number of records after successful query()
    private boolean hasDetailFields;
 
    /**
@@ -233,9 +233,10 @@ public Table retrieveData(long startRow, long rowCount, boolean refresh) throws
    }
 
    /**
-    * Get number of records available on server after successful query() call.
+    * Get estimated number of records matching query after successful query() call. Estimate is provided by database and
+    * may differ from actual number of records.
     *
-    * @return Number of log records available
+    * @return estimated number of matching log records or -1 if estimate is not available
     */
    public long getNumRecords()
    {
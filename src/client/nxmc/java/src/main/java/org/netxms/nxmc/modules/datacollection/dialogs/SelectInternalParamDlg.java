@@ -189,6 +189,7 @@ private void fillMetricList()
          list.add(new AgentParameter("Server.ClientSessions.Web", "Client sessions: web clients", DataType.UINT32));
          list.add(new AgentParameter("Server.ClientSessions.Web(*)", "Client sessions for user {instance}: web clients", DataType.UINT32));
          list.add(new AgentParameter("Server.DataCollectionItems", "Number of data collection items in the system", DataType.UINT32));
+         list.add(new AgentParameter("Server.DB.ConnectionPool.AcquireWaits(*)", "DB connection pool acquire waits in wait time bucket {instance} (0: <1ms, 1: <10ms, 2: <100ms, 3: <1s, 4: <10s, 5: >=10s)", DataType.COUNTER32));
          list.add(new AgentParameter("Server.DB.Queries.Failed", "Failed DB queries", DataType.COUNTER64));
          list.add(new AgentParameter("Server.DB.Queries.LongRunning", "Long running DB queries", DataType.COUNTER64));
          list.add(new AgentParameter("Server.DB.Queries.NonSelect", "Non-SELECT DB queries", DataType.COUNTER64));
@@ -221,6 +222,7 @@ private void fillMetricList()
          list.add(new AgentParameter("Server.ObjectCount.Sensors", "Objects: sensors", DataType.UINT32));
          list.add(new AgentParameter("Server.ObjectCount.Total", "Objects: total", DataType.UINT32));
          list.add(new AgentParameter("Server.PDS.DriverStat(*)", "PDS driver metric", DataType.UINT32));
+         list.add(new AgentParameter("Server.PDS.DroppedRequests", "PDS: dropped requests", DataType.UINT64));
          list.add(new AgentParameter("Server.Pollers.Autobind", "Pollers: auto bind", DataType.UINT32));
          list.add(new AgentParameter("Server.Pollers.Configuration", "Pollers: configuration", DataType.UINT32));
          list.add(new AgentParameter("Server.Pollers.Discovery", "Pollers: discovery", DataType.UINT32));
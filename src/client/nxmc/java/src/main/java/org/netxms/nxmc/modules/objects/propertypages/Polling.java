@@ -181,6 +181,7 @@ protected Control createContents(Composite parent)
       if (pollingTarget.canHaveInterfaces())
 		{
    		addFlag(optionsGroup, AbstractNode.NF_DISABLE_SNMP, i18n.tr("Disable usage of &SNMP for all polls"));
+         addFlag(optionsGroup, AbstractNode.NF_DISABLE_SNMP_GETBULK, i18n.tr("Disable usage of SNMP GETBULK requests (use GETNEXT for walks)"));
    		addFlag(optionsGroup, AbstractNode.NF_DISABLE_ICMP, i18n.tr("Disable usage of &ICMP pings for status polling"));
          addFlag(optionsGroup, AbstractNode.NF_DISABLE_SSH, i18n.tr("Disable SS&H usage for all polls"));
          addFlag(optionsGroup, AbstractNode.NF_DISABLE_VNC, i18n.tr("Disable &VNC detection"));
@@ -58,6 +58,8 @@ public class AgentConfigEditor extends Composite
       "DataDirectory",
       "DataReconciliationBlockSize",
       "DataReconciliationTimeout",
+      "DataSenderBatchSize",
+      "DataSenderWindowSize",
       "DataWriterFlushInterval",
       "DataWriterMaxTransactionSize",
       "DailyLogFileSuffix",
@@ -1143,7 +1143,11 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr, // BulkLoadBegin
+   nullptr, // BulkLoadBind
+   nullptr, // BulkLoadAddRow
+   nullptr  // BulkLoadEnd
 };
 
 DB_DRIVER_ENTRY_POINT("DB2", s_callTable)
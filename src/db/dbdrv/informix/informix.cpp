@@ -968,7 +968,11 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr, // BulkLoadBegin
+   nullptr, // BulkLoadBind
+   nullptr, // BulkLoadAddRow
+   nullptr  // BulkLoadEnd
 };
 
 DB_DRIVER_ENTRY_POINT("INFORMIX", s_callTable)
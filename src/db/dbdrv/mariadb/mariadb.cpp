@@ -1256,7 +1256,11 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr, // BulkLoadBegin
+   nullptr, // BulkLoadBind
+   nullptr, // BulkLoadAddRow
+   nullptr  // BulkLoadEnd
 };
 
 DB_DRIVER_ENTRY_POINT("MARIADB", s_callTable)
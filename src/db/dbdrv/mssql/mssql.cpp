@@ -1019,7 +1019,11 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr, // BulkLoadBegin
+   nullptr, // BulkLoadBind
+   nullptr, // BulkLoadAddRow
+   nullptr  // BulkLoadEnd
 };
 
 DB_DRIVER_ENTRY_POINT("MSSQL", s_callTable)
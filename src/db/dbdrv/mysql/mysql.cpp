@@ -1175,7 +1175,11 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr, // BulkLoadBegin
+   nullptr, // BulkLoadBind
+   nullptr, // BulkLoadAddRow
+   nullptr  // BulkLoadEnd
 };
 
 DB_DRIVER_ENTRY_POINT("MYSQL", s_callTable)
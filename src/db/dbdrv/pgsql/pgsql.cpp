@@ -1165,6 +1165,415 @@ static int IsTableExist(DBDRV_CONNECTION connection, const WCHAR *name)
    return rc;
 }
 
+/**
+ * PostgreSQL type OIDs supported by bulk load
+ */
+#define PG_TYPE_BOOL          16
+#define PG_TYPE_INT8          20
+#define PG_TYPE_INT2          21
+#define PG_TYPE_INT4          23
+#define PG_TYPE_TEXT          25
+#define PG_TYPE_FLOAT4        700
+#define PG_TYPE_FLOAT8        701
+#define PG_TYPE_BPCHAR        1042
+#define PG_TYPE_VARCHAR       1043
+#define PG_TYPE_TIMESTAMP     1114
+#define PG_TYPE_TIMESTAMPTZ   1184
+
+/**
+ * Difference between UNIX epoch and PostgreSQL epoch (2000-01-01) in milliseconds
+ */
+#define PG_EPOCH_OFFSET_MS    INT64_C(946684800000)
+
+/**
+ * Size of buffered COPY data that triggers sending it to server
+ */
+#define BULK_LOAD_FLUSH_THRESHOLD   65536
+
+/**
+ * Get error text from failed operation on connection
+ */
+static void GetErrorText(PG_CONN *conn, PGresult *result, WCHAR *errorText)
+{
+   if (errorText == nullptr)
+      return;
+
+   const char *sqlState = (result != nullptr) ? PQresultErrorField(result, PG_DIAG_SQLSTATE) : nullptr;
+   utf8_to_wchar(CHECK_NULL_EX_A(sqlState), -1, errorText, DBDRV_MAX_ERROR_TEXT);
+   int len = (int)wcslen(errorText);
+   if (len > 0)
+   {
+      errorText[len] = L' ';
+      len++;
+   }
+   utf8_to_wchar(PQerrorMessage(conn->handle), -1, &errorText[len], DBDRV_MAX_ERROR_TEXT - len);
+   errorText[DBDRV_MAX_ERROR_TEXT - 1] = 0;
+   RemoveTrailingCRLFW(errorText);
+}
+
+/**
+ * Check if given column type is supported by bulk load
+ */
+static inline bool IsBulkLoadTypeSupported(Oid type)
+{
+   switch(type)
+   {
+      case PG_TYPE_BOOL:
+      case PG_TYPE_INT2:
+      case PG_TYPE_INT4:
+      case PG_TYPE_INT8:
+      case PG_TYPE_TEXT:
+      case PG_TYPE_FLOAT4:
+      case PG_TYPE_FLOAT8:
+      case PG_TYPE_BPCHAR:
+      case PG_TYPE_VARCHAR:
+      case PG_TYPE_TIMESTAMP:
+      case PG_TYPE_TIMESTAMPTZ:
+         return true;
+      default:
+         return false;
+   }
+}
+
+/**
+ * Read actual types of given columns from server. Connection must be locked by caller.
+ */
+static IntegerArray<Oid> *ReadBulkLoadColumnTypes(PG_CONN *conn, const char *table, const char *columns, uint32_t *errorCode, WCHAR *errorText)
+{
+   size_t len = strlen(table) + strlen(columns) + 32;
+   QueryString query(len);
+   snprintf(query, len, "SELECT %s FROM %s LIMIT 0", columns, table);
+   PGresult *result = PQexec(conn->handle, query);
+   if (PQresultStatus(result) != PGRES_TUPLES_OK)
+   {
+      GetErrorText(conn, result, errorText);
+      *errorCode = (PQstatus(conn->handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+      PQclear(result);
+      return nullptr;
+   }
+
+   int numColumns = PQnfields(result);
+   auto types = new IntegerArray<Oid>(numColumns);
+   for(int i = 0; i < numColumns; i++)
+   {
+      Oid type = PQftype(result, i);
+      if (!IsBulkLoadTypeSupported(type))
+      {
+         if (errorText != nullptr)
+         {
+            WCHAR name[256];
+            utf8_to_wchar(PQfname(result, i), -1, name, 256);
+            name[255] = 0;
+            swprintf(errorText, DBDRV_MAX_ERROR_TEXT, L"Column %ls has type (OID %u) not supported by bulk load", name, static_cast<unsigned int>(type));
+         }
+         *errorCode = DBERR_OTHER_ERROR;
+         PQclear(result);
+         delete types;
+         return nullptr;
+      }
+      types->add(type);
+   }
+   PQclear(result);
+   return types;
+}
+
+/**
+ * Start bulk load into given table. Column types are read from server, so caller can bind values
+ * of any C type and they will be converted to binary representation of the actual column type.
+ * Integer values bound to timestamp columns are interpreted as milliseconds since UNIX epoch.
+ * Column types are cached per connection and dropped from cache if bulk load fails, so that
+ * changed table structure will be picked up by next bulk load.
+ */
+static DBDRV_BULK_LOAD BulkLoadBegin(DBDRV_CONNECTION connection, const WCHAR *table, const WCHAR *columns, uint32_t *errorCode, WCHAR *errorText)
+{
+   auto conn = static_cast<PG_CONN*>(connection);
+
+   QueryString tableUTF8 = QueryToUTF8(table);
+   QueryString columnsUTF8 = QueryToUTF8(columns);
+
+   StringBuffer cacheKey(table);
+   cacheKey.append(L'|');
+   cacheKey.append(columns);
+
+   conn->mutexQueryLock.lock();
+
+   IntegerArray<Oid> *columnTypes = conn->bulkLoadColumnTypes.get(cacheKey);
+   if (columnTypes == nullptr)
+   {
+      columnTypes = ReadBulkLoadColumnTypes(conn, tableUTF8, columnsUTF8, errorCode, errorText);
+      if (columnTypes == nullptr)
+      {
+         conn->mutexQueryLock.unlock();
+         return nullptr;
+      }
+      conn->bulkLoadColumnTypes.set(cacheKey, columnTypes);
+   }
+
+   size_t len = strlen(tableUTF8) + strlen(columnsUTF8) + 64;
+   QueryString query(len);
+   snprintf(query, len, "COPY %s (%s) FROM STDIN (FORMAT binary)", tableUTF8.buffer(), columnsUTF8.buffer());
+   PGresult *result = PQexec(conn->handle, query);
+   if (PQresultStatus(result) != PGRES_COPY_IN)
+   {
+      GetErrorText(conn, result, errorText);
+      *errorCode = (PQstatus(conn->handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+      PQclear(result);
+      conn->bulkLoadColumnTypes.remove(cacheKey);
+      conn->mutexQueryLock.unlock();
+      return nullptr;
+   }
+   PQclear(result);
+
+   auto bulkLoad = new PG_BULK_LOAD(conn, cacheKey, *columnTypes);
+
+   // Binary COPY header: signature, flags, header extension length
+   static const char signature[] = "PGCOPY\n\377\r\n";
+   bulkLoad->data.write(signature, 11);   // Include terminating zero byte
+   bulkLoad->data.writeB(static_cast<int32_t>(0));
+   bulkLoad->data.writeB(static_cast<int32_t>(0));
+
+   // Connection remains locked until bulk load is completed
+   *errorCode = DBERR_SUCCESS;
+   return bulkLoad;
+}
+
+/**
+ * Get bound value as 64 bit integer
+ */
+static int64_t BulkLoadValueAsInt64(int cType, void *buffer)
+{
+   switch(cType)
+   {
+      case DB_CTYPE_STRING:
+         return wcstoll(static_cast<WCHAR*>(buffer), nullptr, 10);
+      case DB_CTYPE_UTF8_STRING:
+         return strtoll(static_cast<char*>(buffer), nullptr, 10);
+      case DB_CTYPE_INT32:
+         return *static_cast<int32_t*>(buffer);
+      case DB_CTYPE_UINT32:
+         return *static_cast<uint32_t*>(buffer);
+      case DB_CTYPE_INT64:
+         return *static_cast<int64_t*>(buffer);
+      case DB_CTYPE_UINT64:
+         return static_cast<int64_t>(*static_cast<uint64_t*>(buffer));
+      case DB_CTYPE_DOUBLE:
+         return static_cast<int64_t>(*static_cast<double*>(buffer));
+      default:
+         return 0;
+   }
+}
+
+/**
+ * Get bound value as double
+ */
+static double BulkLoadValueAsDouble(int cType, void *buffer)
+{
+   switch(cType)
+   {
+      case DB_CTYPE_STRING:
+         return wcstod(static_cast<WCHAR*>(buffer), nullptr);
+      case DB_CTYPE_UTF8_STRING:
+         return strtod(static_cast<char*>(buffer), nullptr);
+      case DB_CTYPE_DOUBLE:
+         return *static_cast<double*>(buffer);
+      default:
+         return static_cast<double>(BulkLoadValueAsInt64(cType, buffer));
+   }
+}
+
+/**
+ * Bind value to column of current bulk load row. Value is immediately converted to binary representation of column type.
+ */
+static void BulkLoadBind(DBDRV_BULK_LOAD hBulkLoad, int pos, int cType, void *buffer, int allocType)
+{
+   auto bulkLoad = static_cast<PG_BULK_LOAD*>(hBulkLoad);
+   if ((pos <= 0) || (pos > bulkLoad->numColumns))
+   {
+      if (allocType == DB_BIND_DYNAMIC)
+         MemFree(buffer);
+      return;
+   }
+
+   int index = pos - 1;
+   Buffer<char>& value = bulkLoad->values[index];
+   if (buffer == nullptr)
+   {
+      bulkLoad->lengths[index] = -1;
+      return;
+   }
+
+   switch(bulkLoad->columnTypes[index])
+   {
+      case PG_TYPE_BOOL:
+         value.realloc(1);
+         if (cType == DB_CTYPE_STRING)
+            value[0] = ((*static_cast<WCHAR*>(buffer) == L'1') || (*static_cast<WCHAR*>(buffer) == L'Y') || (*static_cast<WCHAR*>(buffer) == L't')) ? 1 : 0;
+         else if (cType == DB_CTYPE_UTF8_STRING)
+            value[0] = ((*static_cast<char*>(buffer) == '1') || (*static_cast<char*>(buffer) == 'Y') || (*static_cast<char*>(buffer) == 't')) ? 1 : 0;
+         else
+            value[0] = (BulkLoadValueAsInt64(cType, buffer) != 0) ? 1 : 0;
+         bulkLoad->lengths[index] = 1;
+         break;
+      case PG_TYPE_INT2:
+         value.realloc(2);
+         *reinterpret_cast<uint16_t*>(value.buffer()) = HostToBigEndian16(static_cast<uint16_t>(BulkLoadValueAsInt64(cType, buffer)));
+         bulkLoad->lengths[index] = 2;
+         break;
+      case PG_TYPE_INT4:
+         value.realloc(4);
+         *reinterpret_cast<uint32_t*>(value.buffer()) = HostToBigEndian32(static_cast<uint32_t>(BulkLoadValueAsInt64(cType, buffer)));
+         bulkLoad->lengths[index] = 4;
+         break;
+      case PG_TYPE_INT8:
+         value.realloc(8);
+         *reinterpret_cast<uint64_t*>(value.buffer()) = HostToBigEndian64(static_cast<uint64_t>(BulkLoadValueAsInt64(cType, buffer)));
+         bulkLoad->lengths[index] = 8;
+         break;
+      case PG_TYPE_TIMESTAMP:
+      case PG_TYPE_TIMESTAMPTZ:
+         // Microseconds since 2000-01-01
+         value.realloc(8);
+         *reinterpret_cast<uint64_t*>(value.buffer()) = HostToBigEndian64(static_cast<uint64_t>((BulkLoadValueAsInt64(cType, buffer) - PG_EPOCH_OFFSET_MS) * 1000));
+         bulkLoad->lengths[index] = 8;
+         break;
+      case PG_TYPE_FLOAT4:
+         value.realloc(4);
+         *reinterpret_cast<float*>(value.buffer()) = HostToBigEndianF(static_cast<float>(BulkLoadValueAsDouble(cType, buffer)));
+         bulkLoad->lengths[index] = 4;
+         break;
+      case PG_TYPE_FLOAT8:
+         value.realloc(8);
+         *reinterpret_cast<double*>(value.buffer()) = HostToBigEndianD(BulkLoadValueAsDouble(cType, buffer));
+         bulkLoad->lengths[index] = 8;
+         break;
+      default: // Text types
+         switch(cType)
+         {
+            case DB_CTYPE_STRING:
+            {
+               size_t utf8len = wchar_utf8len(static_cast<WCHAR*>(buffer), -1);
+               value.realloc(utf8len);
+               wchar_to_utf8(static_cast<WCHAR*>(buffer), -1, value, utf8len);
+               bulkLoad->lengths[index] = static_cast<int32_t>(strlen(value));
+               break;
+            }
+            case DB_CTYPE_UTF8_STRING:
+               bulkLoad->lengths[index] = static_cast<int32_t>(strlen(static_cast<char*>(buffer)));
+               value.set(static_cast<char*>(buffer), bulkLoad->lengths[index]);
+               break;
+            case DB_CTYPE_DOUBLE:
+               value.realloc(32);
+               bulkLoad->lengths[index] = snprintf(value, 32, "%f", *static_cast<double*>(buffer));
+               break;
+            case DB_CTYPE_UINT64:
+               value.realloc(32);
+               IntegerToString(*static_cast<uint64_t*>(buffer), value.buffer());
+               bulkLoad->lengths[index] = static_cast<int32_t>(strlen(value));
+               break;
+            default:
+               value.realloc(32);
+               IntegerToString(BulkLoadValueAsInt64(cType, buffer), value.buffer());
+               bulkLoad->lengths[index] = static_cast<int32_t>(strlen(value));
+               break;
+         }
+         break;
+   }
+
+   if (allocType == DB_BIND_DYNAMIC)
+      MemFree(buffer);
+}
+
+/**
+ * Send buffered COPY data to server
+ */
+static uint32_t BulkLoadFlush(PG_BULK_LOAD *bulkLoad, WCHAR *errorText)
+{
+   if (bulkLoad->data.size() == 0)
+      return DBERR_SUCCESS;
+
+   if (PQputCopyData(bulkLoad->connection->handle, reinterpret_cast<const char*>(bulkLoad->data.buffer()), static_cast<int>(bulkLoad->data.size())) != 1)
+   {
+      GetErrorText(bulkLoad->connection, nullptr, errorText);
+      return (PQstatus(bulkLoad->connection->handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+   }
+   bulkLoad->data.clear();
+   return DBERR_SUCCESS;
+}
+
+/**
+ * Add current row to bulk load
+ */
+static uint32_t BulkLoadAddRow(DBDRV_BULK_LOAD hBulkLoad, WCHAR *errorText)
+{
+   auto bulkLoad = static_cast<PG_BULK_LOAD*>(hBulkLoad);
+   bulkLoad->data.writeB(static_cast<int16_t>(bulkLoad->numColumns));
+   for(int i = 0; i < bulkLoad->numColumns; i++)
+   {
+      bulkLoad->data.writeB(bulkLoad->lengths[i]);
+      if (bulkLoad->lengths[i] > 0)
+         bulkLoad->data.write(bulkLoad->values[i].buffer(), bulkLoad->lengths[i]);
+   }
+   return (bulkLoad->data.size() >= BULK_LOAD_FLUSH_THRESHOLD) ? BulkLoadFlush(bulkLoad, errorText) : DBERR_SUCCESS;
+}
+
+/**
+ * Complete bulk load. If commit is false, COPY operation is aborted and no rows are loaded.
+ * Bulk load handle is destroyed in any case.
+ */
+static uint32_t BulkLoadEnd(DBDRV_BULK_LOAD hBulkLoad, bool commit, WCHAR *errorText)
+{
+   auto bulkLoad = static_cast<PG_BULK_LOAD*>(hBulkLoad);
+   PG_CONN *conn = bulkLoad->connection;
+
+   uint32_t rc = DBERR_SUCCESS;
+   if (commit)
+   {
+      bulkLoad->data.writeB(static_cast<int16_t>(-1));   // File trailer
+      rc = BulkLoadFlush(bulkLoad, errorText);
+   }
+
+   if (PQputCopyEnd(conn->handle, ((rc == DBERR_SUCCESS) && commit) ? nullptr : "bulk load cancelled") != 1)
+   {
+      if (rc == DBERR_SUCCESS)
+      {
+         GetErrorText(conn, nullptr, errorText);
+         rc = (PQstatus(conn->handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+      }
+   }
+
+   // Collect final COPY status
+   PGresult *result;
+   while((result = PQgetResult(conn->handle)) != nullptr)
+   {
+      if ((PQresultStatus(result) != PGRES_COMMAND_OK) && (rc == DBERR_SUCCESS))
+      {
+         GetErrorText(conn, result, errorText);
+         rc = (PQstatus(conn->handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+      }
+      PQclear(result);
+   }
+
+   if ((rc == DBERR_SUCCESS) && !commit)
+   {
+      if (errorText != nullptr)
+         wcscpy(errorText, L"Bulk load cancelled");
+      rc = DBERR_OTHER_ERROR;
+   }
+   else if ((rc == DBERR_SUCCESS) && (errorText != nullptr))
+   {
+      *errorText = 0;
+   }
+   else if (commit)
+   {
+      // Failure could be caused by table structure change, so column types will be re-read next time
+      conn->bulkLoadColumnTypes.remove(bulkLoad->cacheKey);
+   }
+
+   delete bulkLoad;
+   conn->mutexQueryLock.unlock();
+   return rc;
+}
+
 /**
  * Driver call table
  */
@@ -1204,7 +1613,11 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   BulkLoadBegin,
+   BulkLoadBind,
+   BulkLoadAddRow,
+   BulkLoadEnd
 };
 
 DB_DRIVER_ENTRY_POINT("PGSQL", s_callTable)
@@ -53,8 +53,9 @@ struct PG_CONN
 {
 	PGconn *handle;
 	Mutex mutexQueryLock;
+	StringObjectMap<IntegerArray<Oid>> bulkLoadColumnTypes;  // Column types for bulk load, keyed by table and column list
 
-	PG_CONN(PGconn *_handle)
+	PG_CONN(PGconn *_handle) : bulkLoadColumnTypes(Ownership::True)
 	{
 	   handle = _handle;
 	}
@@ -94,4 +95,25 @@ struct PG_UNBUFFERED_RESULT
    int currRow;
 };
 
+/**
+ * Bulk load session (COPY ... FROM STDIN in binary format)
+ */
+struct PG_BULK_LOAD
+{
+   PG_CONN *connection;
+   StringBuffer cacheKey;  // Key in connection's column type cache
+   int numColumns;
+   const Oid *columnTypes;
+   std::vector<Buffer<char>> values;
+   std::vector<int32_t> lengths;   // -1 indicates NULL value
+   ByteStream data;  // Encoded rows not yet sent to server
+
+   PG_BULK_LOAD(PG_CONN *c, const StringBuffer& key, const IntegerArray<Oid>& types) : cacheKey(key), values(types.size()), lengths(types.size(), -1), data(65536)
+   {
+      connection = c;
+      numColumns = types.size();
+      columnTypes = types.getBuffer();
+   }
+};
+
 #endif   /* _pgsqldrv_h_ */
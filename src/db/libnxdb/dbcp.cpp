@@ -31,52 +31,243 @@ static TCHAR m_password[256];
 static TCHAR m_dbName[256];
 static TCHAR m_schema[256];
 
+
 static int m_basePoolSize;
 static int m_maxPoolSize;
 static int m_cooldownTime;
 static int m_connectionTTL;
 
-static Mutex m_poolAccessMutex;
-static ObjectArray<PoolConnectionInfo> m_connections;
+#define DEBUG_TAG _T("db.cpool")
+
+/**
+ * Pooled connection. Connection is either acquired by some thread or linked into free list.
+ */
+struct PoolConnection : public PoolConnectionInfo
+{
+   PoolConnection *nextFree;
+   const char *srcFileRef;    // Source file name pointer of current holder (key for wait statistics)
+
+   PoolConnection(DB_HANDLE _handle)
+   {
+      handle = _handle;
+      handle->m_poolConnection = this;
+      inUse = false;
+      resetOnRelease = false;
+      connectTime = time(nullptr);
+      lastAccessTime = connectTime;
+      usageCount = 0;
+      srcFile[0] = 0;
+      srcLine = 0;
+      waitTime = 0;
+      memset(waitHistogram, 0, sizeof(waitHistogram));
+      nextFree = nullptr;
+      srcFileRef = nullptr;
+   }
+};
+
+/**
+ * Thread waiting for connection. Waiters are served in FIFO order - released or newly created
+ * connection is handed over directly to the oldest waiter.
+ */
+struct PoolWaiter
+{
+   PoolWaiter *next;
+   PoolConnection *connection;
+   const char *srcFile;
+   int srcLine;
+   Condition wakeup;
+
+   PoolWaiter(const char *_srcFile, int _srcLine) : wakeup(false)
+   {
+      next = nullptr;
+      connection = nullptr;
+      srcFile = _srcFile;
+      srcLine = _srcLine;
+   }
+};
+
+/**
+ * Key for acquire wait statistics (call location)
+ */
+struct WaitStatsKey
+{
+   const char *srcFile;
+   int64_t srcLine;
+
+   WaitStatsKey(const char *file, int line)
+   {
+      memset(this, 0, sizeof(WaitStatsKey));  // clear padding bytes as key is hashed as raw memory
+      srcFile = file;
+      srcLine = line;
+   }
+};
+
+/**
+ * Acquire wait statistics for call location
+ */
+struct WaitStats
+{
+   uint32_t histogram[DB_POOL_WAIT_HISTOGRAM_SIZE];
+
+   WaitStats()
+   {
+      memset(histogram, 0, sizeof(histogram));
+   }
+};
+
+static Mutex m_poolAccessMutex(MutexType::FAST);
+static ObjectArray<PoolConnection> m_connections(32, 32, Ownership::True);
+static PoolConnection *s_freeList = nullptr;
+static PoolWaiter *s_waitersHead = nullptr;
+static PoolWaiter *s_waitersTail = nullptr;
+static int s_waiterCount = 0;
+static int s_pendingConnections = 0;   // Connections requested from grower thread but not created yet
+static HashMap<WaitStatsKey, WaitStats> s_waitStats(Ownership::True);
+static WaitStats s_totalWaitStats;  // Acquire wait statistics for all call locations
 static THREAD m_maintThread = INVALID_THREAD_HANDLE;
+static THREAD s_growerThread = INVALID_THREAD_HANDLE;
 static Condition m_condShutdown(true);
-static Condition m_condRelease(false);
+static Condition s_condGrow(false);
+static bool s_shutdown = false;
 
-#define DEBUG_TAG _T("db.cpool")
+/**
+ * Create new pooled connection
+ */
+static PoolConnection *CreateConnection()
+{
+   TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+   DB_HANDLE handle = DBConnect(m_driver, m_server, m_dbName, m_login, m_password, m_schema, errorText);
+   if (handle == nullptr)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot create DB connection (%s)"), errorText);
+      return nullptr;
+   }
+   PoolConnection *conn = new PoolConnection(handle);
+   nxlog_debug_tag(DEBUG_TAG, 3, _T("Connection %p created"), conn);
+   return conn;
+}
+
+/**
+ * Unlink connection from free list. Pool lock must be held by caller.
+ */
+static void UnlinkFreeConnection(PoolConnection *conn)
+{
+   for(PoolConnection **p = &s_freeList; *p != nullptr; p = &(*p)->nextFree)
+   {
+      if (*p == conn)
+      {
+         *p = conn->nextFree;
+         conn->nextFree = nullptr;
+         break;
+      }
+   }
+}
+
+/**
+ * Register acquire wait time for call location. Pool lock must be held by caller.
+ */
+static void RegisterWaitTime(PoolConnection *conn, uint32_t waitTime)
+{
+   conn->waitTime = waitTime;
+
+   int bucket = 0;
+   for(uint32_t limit = 1; (bucket < DB_POOL_WAIT_HISTOGRAM_SIZE - 1) && (waitTime >= limit); limit *= 10)
+      bucket++;
+
+   WaitStatsKey key(conn->srcFileRef, conn->srcLine);
+   WaitStats *stats = s_waitStats.get(key);
+   if (stats == nullptr)
+   {
+      stats = new WaitStats();
+      s_waitStats.set(key, stats);
+   }
+   stats->histogram[bucket]++;
+   s_totalWaitStats.histogram[bucket]++;
+}
+
+/**
+ * Mark connection as acquired by given call location. Pool lock must be held by caller.
+ */
+static void AssignConnection(PoolConnection *conn, const char *srcFile, int srcLine)
+{
+   conn->inUse = true;
+   conn->lastAccessTime = time(nullptr);
+   conn->usageCount++;
+   strlcpy(conn->srcFile, srcFile, 128);
+   conn->srcLine = srcLine;
+   conn->srcFileRef = srcFile;
+}
+
+/**
+ * Put connection back into pool. If there are waiting threads, connection is handed over
+ * directly to the oldest waiter. Waiter is signalled while pool lock is still held, so it
+ * cannot leave wait loop (and destroy its condition) before signalling is complete.
+ * Pool lock must be held by caller.
+ */
+static void ReturnConnection(PoolConnection *conn)
+{
+   PoolWaiter *waiter = s_waitersHead;
+   if (waiter != nullptr)
+   {
+      s_waitersHead = waiter->next;
+      if (s_waitersHead == nullptr)
+         s_waitersTail = nullptr;
+      s_waiterCount--;
+      AssignConnection(conn, waiter->srcFile, waiter->srcLine);
+      waiter->connection = conn;
+      waiter->wakeup.set();
+      return;
+   }
+
+   conn->inUse = false;
+   conn->srcFile[0] = 0;
+   conn->srcLine = 0;
+   conn->srcFileRef = nullptr;
+   conn->lastAccessTime = time(nullptr);
+   conn->nextFree = s_freeList;
+   s_freeList = conn;
+}
+
+/**
+ * Request creation of additional connection by grower thread if pool is below maximum size
+ * and there are more waiting threads than connections already being created.
+ * Pool lock must be held by caller.
+ */
+static void RequestPoolGrowth()
+{
+   if (s_shutdown || (s_waiterCount <= s_pendingConnections) || (m_connections.size() + s_pendingConnections >= m_maxPoolSize))
+      return;
+   s_pendingConnections++;
+   s_condGrow.set();
+}
+
+/**
+ * Remove connection which cannot be re-established from pool. Pool lock must be held by caller.
+ */
+static void RemoveFailedConnection(PoolConnection *conn)
+{
+   m_connections.remove(conn);
+   RequestPoolGrowth();
+}
 
 /**
  * Create connections on pool initialization
  */
 static bool DBConnectionPoolPopulate()
 {
-	TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
 	bool success = false;
-
-	m_poolAccessMutex.lock();
 	for(int i = 0; i < m_basePoolSize; i++)
 	{
-      PoolConnectionInfo *conn = new PoolConnectionInfo;
-      conn->handle = DBConnect(m_driver, m_server, m_dbName, m_login, m_password, m_schema, errorText);
-      if (conn->handle != NULL)
+      PoolConnection *conn = CreateConnection();
+      if (conn != nullptr)
       {
-         conn->inUse = false;
-         conn->resetOnRelease = false;
-         conn->connectTime = time(NULL);
-         conn->lastAccessTime = conn->connectTime;
-         conn->usageCount = 0;
-         conn->srcFile[0] = 0;
-         conn->srcLine = 0;
+         m_poolAccessMutex.lock();
          m_connections.add(conn);
-         nxlog_debug_tag(DEBUG_TAG, 3, _T("Connection %p created"), conn);
+         ReturnConnection(conn);
+         m_poolAccessMutex.unlock();
          success = true;
-      }
-      else
-      {
-         nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot create DB connection %d (%s)"), i, errorText);
-         delete conn;
       }
 	}
-	m_poolAccessMutex.unlock();
 	return success;
 }
 
@@ -85,36 +276,49 @@ static bool DBConnectionPoolPopulate()
  */
 static void DBConnectionPoolShrink()
 {
-	m_poolAccessMutex.lock();
+   ObjectArray<PoolConnection> closeList(16, 16, Ownership::True);
 
+	m_poolAccessMutex.lock();
    time_t now = time(nullptr);
-   for(int i = m_basePoolSize; i < m_connections.size(); i++)
+   int excess = m_connections.size() - m_basePoolSize;
+   for(PoolConnection **p = &s_freeList; (*p != nullptr) && (excess > 0);)
 	{
-      PoolConnectionInfo *conn = m_connections.get(i);
-		if (!conn->inUse && (now - conn->lastAccessTime > m_cooldownTime))
+      PoolConnection *conn = *p;
+		if (now - conn->lastAccessTime > m_cooldownTime)
 		{
-			DBDisconnect(conn->handle);
-	      nxlog_debug_tag(DEBUG_TAG, 3, _T("Connection %p terminated"), conn);
-         m_connections.remove(i);
-         i--;
+		   *p = conn->nextFree;
+         m_connections.unlink(conn);
+         closeList.add(conn);
+         excess--;
+		}
+		else
+		{
+		   p = &conn->nextFree;
 		}
 	}
-
 	m_poolAccessMutex.unlock();
+
+   for(int i = 0; i < closeList.size(); i++)
+   {
+      PoolConnection *conn = closeList.get(i);
+      DBDisconnect(conn->handle);
+      nxlog_debug_tag(DEBUG_TAG, 3, _T("Connection %p terminated"), conn);
+   }
 }
 
 /*
  * Reset connection
  */
-static bool ResetConnection(PoolConnectionInfo *conn)
+static bool ResetConnection(PoolConnection *conn)
 {
-	time_t now = time(NULL);
+	time_t now = time(nullptr);
 	DBDisconnect(conn->handle);
 
 	TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
 	conn->handle = DBConnect(m_driver, m_server, m_dbName, m_login, m_password, m_schema, errorText);
-	if (conn->handle != NULL)
+	if (conn->handle != nullptr)
    {
+	   conn->handle->m_poolConnection = conn;
 		conn->connectTime = now;
 		conn->lastAccessTime = now;
 		conn->usageCount = 0;
@@ -129,10 +333,28 @@ static bool ResetConnection(PoolConnectionInfo *conn)
    return conn->handle != nullptr;
 }
 
+/**
+ * Reset given connections and put them back into pool
+ */
+static void ResetConnections(const ObjectArray<PoolConnection>& connections)
+{
+   for(int i = 0; i < connections.size(); i++)
+   {
+      PoolConnection *conn = connections.get(i);
+      bool success = ResetConnection(conn);
+      m_poolAccessMutex.lock();
+      if (success)
+         ReturnConnection(conn);
+      else
+         RemoveFailedConnection(conn);
+      m_poolAccessMutex.unlock();
+   }
+}
+
 /**
  * Callback for sorting reset list
  */
-static int ResetListSortCallback(const PoolConnectionInfo **e1, const PoolConnectionInfo **e2)
+static int ResetListSortCallback(const PoolConnection **e1, const PoolConnection **e2)
 {
    return (*e1)->usageCount > (*e2)->usageCount ? -1 : ((*e1)->usageCount == (*e2)->usageCount ? 0 : 1);
 }
@@ -146,18 +368,14 @@ static void ResetExpiredConnections()
 
    m_poolAccessMutex.lock();
 
-	int i, availCount = 0;
-   ObjectArray<PoolConnectionInfo> reconnList(m_connections.size(), 16, Ownership::False);
-	for(i = 0; i < m_connections.size(); i++)
+	int availCount = 0;
+   ObjectArray<PoolConnection> reconnList(16, 16, Ownership::False);
+   for(PoolConnection *conn = s_freeList; conn != nullptr; conn = conn->nextFree)
 	{
-		PoolConnectionInfo *conn = m_connections.get(i);
-		if (!conn->inUse)
+      availCount++;
+      if (now - conn->connectTime > m_connectionTTL)
       {
-         availCount++;
-         if (now - conn->connectTime > m_connectionTTL)
-         {
-            reconnList.add(conn);
-         }
+         reconnList.add(conn);
       }
 	}
 	
@@ -169,26 +387,15 @@ static void ResetExpiredConnections()
          reconnList.remove(count);
    }
 
-   for(i = 0; i < count; i++)
-      reconnList.get(i)->inUse = true;
+   for(int i = 0; i < count; i++)
+   {
+      PoolConnection *conn = reconnList.get(i);
+      UnlinkFreeConnection(conn);
+      conn->inUse = true;
+   }
    m_poolAccessMutex.unlock();
 
-   // do reconnects
-   for(i = 0; i < count; i++)
-	{
-   	PoolConnectionInfo *conn = reconnList.get(i);
-   	bool success = ResetConnection(conn);
-   	m_poolAccessMutex.lock();
-		if (success)
-		{
-			conn->inUse = false;
-		}
-		else
-		{
-			m_connections.remove(conn);
-		}
-		m_poolAccessMutex.unlock();
-	}
+   ResetConnections(reconnList);
 }
 
 /**
@@ -212,6 +419,48 @@ static THREAD_RESULT THREAD_CALL MaintenanceThread(void *arg)
    return THREAD_OK;
 }
 
+/**
+ * Pool grower thread. Creates additional connections requested by waiting threads
+ * so that connection establishment does not happen while holding pool lock.
+ */
+static THREAD_RESULT THREAD_CALL GrowerThread(void *arg)
+{
+   ThreadSetName("DBPoolGrow");
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Database Connection Pool grower thread started"));
+
+   while(true)
+   {
+      s_condGrow.wait(INFINITE);
+
+      m_poolAccessMutex.lock();
+      while(!s_shutdown && (s_pendingConnections > 0))
+      {
+         m_poolAccessMutex.unlock();
+         PoolConnection *conn = CreateConnection();
+         m_poolAccessMutex.lock();
+         if (conn != nullptr)
+         {
+            s_pendingConnections--;
+            m_connections.add(conn);
+            ReturnConnection(conn);
+         }
+         else
+         {
+            // Drop all outstanding requests - waiting threads will request new connection again on wait timeout
+            s_pendingConnections = 0;
+         }
+      }
+      bool shutdown = s_shutdown;
+      m_poolAccessMutex.unlock();
+
+      if (shutdown)
+         break;
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Database Connection Pool grower thread stopped"));
+   return THREAD_OK;
+}
+
 /**
  * Start connection pool
  */
@@ -234,8 +483,7 @@ bool LIBNXDB_EXPORTABLE DBConnectionPoolStartup(DB_DRIVER driver, const TCHAR *s
 	m_maxPoolSize = maxPoolSize;
 	m_cooldownTime = cooldownTime;
    m_connectionTTL = connTTL;
-
-   m_connections.setOwner(Ownership::True);
+   s_shutdown = false;
 
 	if (!DBConnectionPoolPopulate())
 	{
@@ -243,7 +491,8 @@ bool LIBNXDB_EXPORTABLE DBConnectionPoolStartup(DB_DRIVER driver, const TCHAR *s
 	   return false;
 	}
 
-   m_maintThread = ThreadCreateEx(MaintenanceThread, 0, NULL);
+   m_maintThread = ThreadCreateEx(MaintenanceThread, 0, nullptr);
+   s_growerThread = ThreadCreateEx(GrowerThread, 0, nullptr);
 
    s_initialized = true;
 	nxlog_debug_tag(DEBUG_TAG, 1, _T("Database Connection Pool initialized"));
@@ -259,8 +508,14 @@ void LIBNXDB_EXPORTABLE DBConnectionPoolShutdown()
    if (!s_initialized)
       return;
 
+   m_poolAccessMutex.lock();
+   s_shutdown = true;
+   m_poolAccessMutex.unlock();
+
    m_condShutdown.set();
+   s_condGrow.set();
    ThreadJoin(m_maintThread);
+   ThreadJoin(s_growerThread);
 
    for(int i = 0; i < m_connections.size(); i++)
 	{
@@ -268,6 +523,10 @@ void LIBNXDB_EXPORTABLE DBConnectionPoolShutdown()
 	}
 
    m_connections.clear();
+   s_freeList = nullptr;
+   s_pendingConnections = 0;
+   s_waitStats.clear();
+   memset(s_totalWaitStats.histogram, 0, sizeof(s_totalWaitStats.histogram));
 
    s_initialized = false;
 	nxlog_debug_tag(DEBUG_TAG, 1, _T("Database Connection Pool terminated"));
@@ -278,32 +537,43 @@ void LIBNXDB_EXPORTABLE DBConnectionPoolShutdown()
  */
 void LIBNXDB_EXPORTABLE DBConnectionPoolReset()
 {
+   ObjectArray<PoolConnection> closeList(16, 16, Ownership::True);
+   ObjectArray<PoolConnection> resetList(16, 16, Ownership::False);
+
    m_poolAccessMutex.lock();
 
    for(int i = 0; i < m_connections.size(); i++)
    {
-      PoolConnectionInfo *conn = m_connections.get(i);
+      PoolConnection *conn = m_connections.get(i);
       if (conn->inUse)
-      {
          conn->resetOnRelease = true;
-      }
-      else if (m_connections.size() > m_basePoolSize)
+   }
+
+   int excess = m_connections.size() - m_basePoolSize;
+   while(s_freeList != nullptr)
+   {
+      PoolConnection *conn = s_freeList;
+      s_freeList = conn->nextFree;
+      conn->nextFree = nullptr;
+      conn->inUse = true;
+      if (excess > 0)
       {
-         DBDisconnect(conn->handle);
-         m_connections.remove(i);
-         i--;
+         m_connections.unlink(conn);
+         closeList.add(conn);
+         excess--;
       }
       else
       {
-         if (!ResetConnection(conn))
-         {
-            m_connections.remove(i);
-            i--;
-         }
+         resetList.add(conn);
       }
    }
 
    m_poolAccessMutex.unlock();
+
+   for(int i = 0; i < closeList.size(); i++)
+      DBDisconnect(closeList.get(i)->handle);
+
+   ResetConnections(resetList);
 }
 
 /**
@@ -312,71 +582,54 @@ void LIBNXDB_EXPORTABLE DBConnectionPoolReset()
  */
 DB_HANDLE LIBNXDB_EXPORTABLE __DBConnectionPoolAcquireConnection(const char *srcFile, int srcLine)
 {
-retry:
 	m_poolAccessMutex.lock();
 
-	DB_HANDLE handle = nullptr;
-
-	// find less used connection
-   uint32_t count = 0xFFFFFFFF;
-	int index = -1;
-   for(int i = 0; (i < m_connections.size()) && (count > 0); i++)
+	PoolConnection *conn = s_freeList;
+	if (conn != nullptr)
 	{
-      PoolConnectionInfo *conn = m_connections.get(i);
-      if (!conn->inUse && (conn->usageCount < count))
-      {
-         count = conn->usageCount;
-         index = i;
-		}
+	   s_freeList = conn->nextFree;
+	   conn->nextFree = nullptr;
+	   AssignConnection(conn, srcFile, srcLine);
+	   RegisterWaitTime(conn, 0);
+	   m_poolAccessMutex.unlock();
+	   nxlog_debug_tag(DEBUG_TAG, 7, _T("Handle %p acquired (call from %hs:%d)"), conn->handle, srcFile, srcLine);
+	   return conn->handle;
 	}
 
-	if (index > -1)
-	{
-		PoolConnectionInfo *conn = m_connections.get(index);
-		handle = conn->handle;
-		conn->inUse = true;
-		conn->lastAccessTime = time(nullptr);
-		conn->usageCount++;
-		strlcpy(conn->srcFile, srcFile, 128);
-		conn->srcLine = srcLine;
-	}
-   else if (m_connections.size() < m_maxPoolSize)
-	{
-	   TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
-      PoolConnectionInfo *conn = new PoolConnectionInfo;
-      conn->handle = DBConnect(m_driver, m_server, m_dbName, m_login, m_password, m_schema, errorText);
-      if (conn->handle != nullptr)
-      {
-         conn->inUse = true;
-         conn->resetOnRelease = false;
-         conn->connectTime = time(nullptr);
-         conn->lastAccessTime = conn->connectTime;
-         conn->usageCount = 0;
-         strlcpy(conn->srcFile, srcFile, 128);
-         conn->srcLine = srcLine;
-         m_connections.add(conn);
-         handle = conn->handle;
-         nxlog_debug_tag(DEBUG_TAG, 3, _T("Connection %p created"), conn);
-      }
-      else
-      {
-         nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot create additional DB connection (%s)"), errorText);
-         delete conn;
-      }
-	}
+	// No idle connections - join waiters queue and request new connection if pool can grow
+	int64_t startTime = GetMonotonicClockTime();
+	PoolWaiter waiter(srcFile, srcLine);
+	if (s_waitersTail != nullptr)
+	   s_waitersTail->next = &waiter;
+	else
+	   s_waitersHead = &waiter;
+	s_waitersTail = &waiter;
+	s_waiterCount++;
+	RequestPoolGrowth();
 
 	m_poolAccessMutex.unlock();
 
-	if (handle == nullptr)
+	nxlog_debug_tag(DEBUG_TAG, 6, _T("Waiting for database connection (call from %hs:%d)"), srcFile, srcLine);
+	while(true)
 	{
-   	nxlog_debug_tag(DEBUG_TAG, 1, _T("Database connection pool exhausted (call from %hs:%d)"), srcFile, srcLine);
-      m_condRelease.wait(10000);
-      nxlog_debug_tag(DEBUG_TAG, 5, _T("Retry acquire connection (call from %hs:%d)"), srcFile, srcLine);
-      goto retry;
+	   waiter.wakeup.wait(10000);
+
+	   m_poolAccessMutex.lock();
+	   conn = waiter.connection;
+	   if (conn != nullptr)
+	   {
+	      RegisterWaitTime(conn, static_cast<uint32_t>(GetMonotonicClockTime() - startTime));
+	      m_poolAccessMutex.unlock();
+	      break;
+	   }
+	   RequestPoolGrowth();
+	   m_poolAccessMutex.unlock();
+
+	   nxlog_debug_tag(DEBUG_TAG, 1, _T("Database connection pool exhausted (call from %hs:%d)"), srcFile, srcLine);
 	}
 
-   nxlog_debug_tag(DEBUG_TAG, 7, _T("Handle %p acquired (call from %hs:%d)"), handle, srcFile, srcLine);
-	return handle;
+   nxlog_debug_tag(DEBUG_TAG, 7, _T("Handle %p acquired after %u milliseconds wait (call from %hs:%d)"), conn->handle, conn->waitTime, srcFile, srcLine);
+	return conn->handle;
 }
 
 /**
@@ -384,42 +637,31 @@ DB_HANDLE LIBNXDB_EXPORTABLE __DBConnectionPoolAcquireConnection(const char *src
  */
 void LIBNXDB_EXPORTABLE DBConnectionPoolReleaseConnection(DB_HANDLE handle)
 {
-	m_poolAccessMutex.lock();
-
-   for(int i = 0; i < m_connections.size(); i++)
-	{
-      PoolConnectionInfo *conn = m_connections.get(i);
-      if (conn->handle == handle)
-		{
-         conn->srcFile[0] = 0;
-         conn->srcLine = 0;
-         if (conn->resetOnRelease)
-         {
-            m_poolAccessMutex.unlock();
-            bool success = ResetConnection(conn);
-            m_poolAccessMutex.lock();
-            if (success)
-            {
-               conn->inUse = false;
-            }
-            else
-            {
-               m_connections.remove(i);
-            }
-         }
-         else
-         {
-            conn->inUse = false;
-            conn->lastAccessTime = time(NULL);
-         }
-			break;
-		}
-	}
+   PoolConnection *conn = handle->m_poolConnection;
+   if (conn == nullptr)
+      return;  // Not a pooled connection
 
+	m_poolAccessMutex.lock();
+   if (conn->resetOnRelease)
+   {
+      conn->srcFile[0] = 0;
+      conn->srcLine = 0;
+      conn->srcFileRef = nullptr;
+      m_poolAccessMutex.unlock();
+      bool success = ResetConnection(conn);
+      m_poolAccessMutex.lock();
+      if (success)
+         ReturnConnection(conn);
+      else
+         RemoveFailedConnection(conn);
+   }
+   else
+   {
+      ReturnConnection(conn);
+   }
 	m_poolAccessMutex.unlock();
 
    nxlog_debug_tag(DEBUG_TAG, 7, _T("Handle %p released"), handle);
-   m_condRelease.pulse();
 }
 
 /**
@@ -448,7 +690,18 @@ int LIBNXDB_EXPORTABLE DBConnectionPoolGetAcquiredCount()
 }
 
 /**
- * Get copy of active DB connections.
+ * Get acquire wait time histogram for all call locations since pool startup. Provided buffer
+ * should have space for DB_POOL_WAIT_HISTOGRAM_SIZE elements.
+ */
+void LIBNXDB_EXPORTABLE DBConnectionPoolGetWaitTimeHistogram(uint32_t *histogram)
+{
+   m_poolAccessMutex.lock();
+   memcpy(histogram, s_totalWaitStats.histogram, sizeof(s_totalWaitStats.histogram));
+   m_poolAccessMutex.unlock();
+}
+
+/**
+ * Get copy of active DB connections. Each entry includes acquire wait time histogram for call location of current holder.
  * Returned list must be deleted by the caller.
  */
 ObjectArray<PoolConnectionInfo> LIBNXDB_EXPORTABLE *DBConnectionPoolGetConnectionList()
@@ -457,11 +710,13 @@ ObjectArray<PoolConnectionInfo> LIBNXDB_EXPORTABLE *DBConnectionPoolGetConnectio
    m_poolAccessMutex.lock();
    for(int i = 0; i < m_connections.size(); i++)
    {
-      PoolConnectionInfo *curr = m_connections.get(i);
+      PoolConnection *curr = m_connections.get(i);
       if (curr->inUse)
       {
-         PoolConnectionInfo *ci = new PoolConnectionInfo;
-         memcpy(ci, curr, sizeof(PoolConnectionInfo));
+         PoolConnectionInfo *ci = new PoolConnectionInfo(*curr);
+         WaitStats *stats = (curr->srcFileRef != nullptr) ? s_waitStats.get(WaitStatsKey(curr->srcFileRef, curr->srcLine)) : nullptr;
+         if (stats != nullptr)
+            memcpy(ci->waitHistogram, stats->histogram, sizeof(ci->waitHistogram));
          list->add(ci);
       }
    }
@@ -69,6 +69,8 @@ struct db_statement_t
 	TCHAR *m_query;
 };
 
+struct PoolConnection;
+
 /**
  * Database connection structure
  */
@@ -87,6 +89,7 @@ struct db_handle_t
    char *m_schema;
    ObjectArray<db_statement_t> m_preparedStatements;
    Mutex m_preparedStatementsLock;
+   PoolConnection *m_poolConnection;   // Owning connection pool entry (only for pooled connections)
 
    db_handle_t(DB_DRIVER driver, DBDRV_CONNECTION connection, char *dbName, char *login, char *password, char *server, char *schema) :
          m_mutexTransLock(MutexType::RECURSIVE), m_preparedStatements(4, 4, Ownership::False), m_preparedStatementsLock(MutexType::FAST)
@@ -101,6 +104,7 @@ struct db_handle_t
       m_password = password;
       m_server = server;
       m_schema = schema;
+      m_poolConnection = nullptr;
    }
 
    ~db_handle_t()
@@ -138,4 +142,18 @@ struct db_unbuffered_result_t
 	DBDRV_UNBUFFERED_RESULT m_data;
 };
 
+/**
+ * Bulk load session
+ */
+struct db_bulk_load_t
+{
+   DB_DRIVER m_driver;
+   DB_HANDLE m_connection;
+   DBDRV_BULK_LOAD m_data;
+   TCHAR *m_table;
+   int64_t m_startTime;
+   uint32_t m_rowCount;
+   bool m_failed;
+};
+
 #endif   /* _libnxsrv_h_ */
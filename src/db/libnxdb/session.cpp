@@ -1768,6 +1768,291 @@ bool LIBNXDB_EXPORTABLE DBExecute(DB_STATEMENT hStmt)
 	return DBExecuteEx(hStmt, errorText);
 }
 
+/**
+ * Check if bulk load is supported by database driver
+ */
+bool LIBNXDB_EXPORTABLE DBIsBulkLoadSupported(DB_DRIVER driver)
+{
+   return driver->m_callTable.BulkLoadBegin != nullptr;
+}
+
+/**
+ * Start bulk load into given table. Columns should be given as comma separated list.
+ * Connection is locked for exclusive use by calling thread until DBBulkLoadEnd or DBBulkLoadCancel is called.
+ */
+DB_BULK_LOAD LIBNXDB_EXPORTABLE DBBulkLoadBeginEx(DB_HANDLE hConn, const TCHAR *table, const TCHAR *columns, TCHAR *errorText)
+{
+   if (hConn->m_driver->m_callTable.BulkLoadBegin == nullptr)
+   {
+      _tcslcpy(errorText, _T("Bulk load is not supported by database driver"), DBDRV_MAX_ERROR_TEXT);
+      return nullptr;
+   }
+
+#ifdef UNICODE
+#define wcTable table
+#define wcColumns columns
+#define wcErrorText errorText
+#else
+   WCHAR *wcTable = WideStringFromMBString(table);
+   WCHAR *wcColumns = WideStringFromMBString(columns);
+   WCHAR wcErrorText[DBDRV_MAX_ERROR_TEXT] = L"";
+#endif
+
+   hConn->m_mutexTransLock.lock();
+
+   int64_t startTime = GetMonotonicClockTime();
+   uint32_t errorCode;
+   DBDRV_BULK_LOAD data = hConn->m_driver->m_callTable.BulkLoadBegin(hConn->m_connection, wcTable, wcColumns, &errorCode, wcErrorText);
+   if ((data == nullptr) && (errorCode == DBERR_CONNECTION_LOST) && hConn->m_reconnectEnabled)
+   {
+      DBReconnect(hConn);
+      data = hConn->m_driver->m_callTable.BulkLoadBegin(hConn->m_connection, wcTable, wcColumns, &errorCode, wcErrorText);
+   }
+
+   DB_BULK_LOAD result;
+   if (data != nullptr)
+   {
+      result = MemAllocStruct<db_bulk_load_t>();
+      result->m_driver = hConn->m_driver;
+      result->m_connection = hConn;
+      result->m_data = data;
+      result->m_table = MemCopyString(table);
+      result->m_startTime = startTime;
+      result->m_rowCount = 0;
+      result->m_failed = false;
+      // Transaction lock remains held until bulk load is completed
+   }
+   else
+   {
+      hConn->m_mutexTransLock.unlock();
+      result = nullptr;
+
+#ifndef UNICODE
+      wchar_to_mb(wcErrorText, -1, errorText, DBDRV_MAX_ERROR_TEXT);
+      errorText[DBDRV_MAX_ERROR_TEXT - 1] = 0;
+#endif
+
+      nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG_DRIVER, _T("Bulk load into table %s failed: %s"), table, errorText);
+      if (hConn->m_driver->m_fpEventHandler != nullptr)
+         hConn->m_driver->m_fpEventHandler(DBEVENT_QUERY_FAILED, wcTable, wcErrorText, errorCode == DBERR_CONNECTION_LOST, hConn->m_driver->m_context);
+
+      InterlockedIncrement64(&s_perfFailedQueries);
+      InterlockedIncrement64(&s_perfTotalQueries);
+   }
+
+   if (s_queryTrace)
+      nxlog_debug_tag(DEBUG_TAG_QUERY, 9, _T("{%p} %s bulk load start: table=%s columns=%s"), result, (result != nullptr) ? _T("Successful") : _T("Failed"), table, columns);
+
+#ifndef UNICODE
+   MemFree(wcTable);
+   MemFree(wcColumns);
+#endif
+
+   return result;
+#undef wcTable
+#undef wcColumns
+#undef wcErrorText
+}
+
+/**
+ * Start bulk load into given table
+ */
+DB_BULK_LOAD LIBNXDB_EXPORTABLE DBBulkLoadBegin(DB_HANDLE hConn, const TCHAR *table, const TCHAR *columns)
+{
+   TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+   return DBBulkLoadBeginEx(hConn, table, columns, errorText);
+}
+
+/**
+ * Bind value to column of current bulk load row (generic). Null buffer indicates NULL value.
+ */
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, int cType, const void *buffer, int allocType)
+{
+   if ((hBulkLoad == nullptr) || (pos <= 0))
+      return;
+
+#ifdef UNICODE
+   hBulkLoad->m_driver->m_callTable.BulkLoadBind(hBulkLoad->m_data, pos, cType, const_cast<void*>(buffer), allocType);
+#else
+   if ((cType == DB_CTYPE_STRING) && (buffer != nullptr))
+   {
+      WCHAR *wBuffer = WideStringFromMBString(static_cast<const char*>(buffer));
+      if (allocType == DB_BIND_DYNAMIC)
+         MemFree(const_cast<void*>(buffer));
+      hBulkLoad->m_driver->m_callTable.BulkLoadBind(hBulkLoad->m_data, pos, cType, wBuffer, DB_BIND_DYNAMIC);
+   }
+   else
+   {
+      hBulkLoad->m_driver->m_callTable.BulkLoadBind(hBulkLoad->m_data, pos, cType, const_cast<void*>(buffer), allocType);
+   }
+#endif
+}
+
+/**
+ * Bind string value to column of current bulk load row
+ */
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, const TCHAR *value, int allocType)
+{
+   if (value != nullptr)
+      DBBulkLoadBind(hBulkLoad, pos, DB_CTYPE_STRING, value, allocType);
+   else
+      DBBulkLoadBind(hBulkLoad, pos, DB_CTYPE_STRING, _T(""), DB_BIND_STATIC);
+}
+
+/**
+ * Bind 32 bit integer value to column of current bulk load row
+ */
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, int32_t value)
+{
+   DBBulkLoadBind(hBulkLoad, pos, DB_CTYPE_INT32, &value, DB_BIND_TRANSIENT);
+}
+
+/**
+ * Bind 32 bit unsigned integer value to column of current bulk load row
+ */
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, uint32_t value)
+{
+   DBBulkLoadBind(hBulkLoad, pos, DB_CTYPE_UINT32, &value, DB_BIND_TRANSIENT);
+}
+
+/**
+ * Bind 64 bit integer value to column of current bulk load row
+ */
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, int64_t value)
+{
+   DBBulkLoadBind(hBulkLoad, pos, DB_CTYPE_INT64, &value, DB_BIND_TRANSIENT);
+}
+
+/**
+ * Bind 64 bit unsigned integer value to column of current bulk load row
+ */
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, uint64_t value)
+{
+   DBBulkLoadBind(hBulkLoad, pos, DB_CTYPE_UINT64, &value, DB_BIND_TRANSIENT);
+}
+
+/**
+ * Bind floating point value to column of current bulk load row
+ */
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, double value)
+{
+   DBBulkLoadBind(hBulkLoad, pos, DB_CTYPE_DOUBLE, &value, DB_BIND_TRANSIENT);
+}
+
+/**
+ * Bind timestamp to column of current bulk load row (as milliseconds since epoch)
+ */
+void LIBNXDB_EXPORTABLE DBBulkLoadBind(DB_BULK_LOAD hBulkLoad, int pos, Timestamp value)
+{
+   DBBulkLoadBind(hBulkLoad, pos, value.asMilliseconds());
+}
+
+/**
+ * Add current row to bulk load
+ */
+bool LIBNXDB_EXPORTABLE DBBulkLoadAddRow(DB_BULK_LOAD hBulkLoad)
+{
+   if ((hBulkLoad == nullptr) || hBulkLoad->m_failed)
+      return false;
+
+   WCHAR errorText[DBDRV_MAX_ERROR_TEXT] = L"";
+   uint32_t rc = hBulkLoad->m_driver->m_callTable.BulkLoadAddRow(hBulkLoad->m_data, errorText);
+   if (rc != DBERR_SUCCESS)
+   {
+      hBulkLoad->m_failed = true;
+      nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG_DRIVER, _T("Bulk load into table %s failed: %ls"), hBulkLoad->m_table, errorText);
+      return false;
+   }
+   hBulkLoad->m_rowCount++;
+   return true;
+}
+
+/**
+ * Complete bulk load and destroy bulk load handle
+ */
+static bool CompleteBulkLoad(DB_BULK_LOAD hBulkLoad, bool commit, TCHAR *errorText)
+{
+#ifdef UNICODE
+#define wcErrorText errorText
+#else
+   WCHAR wcErrorText[DBDRV_MAX_ERROR_TEXT] = L"";
+#endif
+
+   DB_HANDLE hConn = hBulkLoad->m_connection;
+   uint32_t rc = hBulkLoad->m_driver->m_callTable.BulkLoadEnd(hBulkLoad->m_data, commit && !hBulkLoad->m_failed, wcErrorText);
+
+   InterlockedIncrement64(&s_perfNonSelectQueries);
+   InterlockedIncrement64(&s_perfTotalQueries);
+
+   int64_t ms = GetMonotonicClockTime() - hBulkLoad->m_startTime;
+   if (s_queryTrace)
+   {
+      nxlog_debug_tag(DEBUG_TAG_QUERY, 9, _T("{%p} %s bulk load into %s: %u rows [%d ms]"), hBulkLoad,
+         (rc == DBERR_SUCCESS) ? _T("Successful") : (commit ? _T("Failed") : _T("Cancelled")), hBulkLoad->m_table, hBulkLoad->m_rowCount, static_cast<int>(ms));
+   }
+   if ((rc == DBERR_SUCCESS) && (static_cast<uint32_t>(ms) > hConn->getQueryExecTimeThreshold()))
+   {
+      nxlog_debug_tag(DEBUG_TAG_QUERY, 3, _T("Long running bulk load into %s: %u rows [%d ms]"), hBulkLoad->m_table, hBulkLoad->m_rowCount, static_cast<int>(ms));
+      InterlockedIncrement64(&s_perfLongRunningQueries);
+   }
+
+   // Reconnect if needed, but data is lost anyway
+   if ((rc == DBERR_CONNECTION_LOST) && hConn->m_reconnectEnabled)
+      DBReconnect(hConn);
+
+   hConn->m_mutexTransLock.unlock();
+
+#ifndef UNICODE
+   wchar_to_mb(wcErrorText, -1, errorText, DBDRV_MAX_ERROR_TEXT);
+   errorText[DBDRV_MAX_ERROR_TEXT - 1] = 0;
+#endif
+
+   if ((rc != DBERR_SUCCESS) && commit)
+   {
+      nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG_DRIVER, _T("Bulk load into table %s failed: %s"), hBulkLoad->m_table, errorText);
+      InterlockedIncrement64(&s_perfFailedQueries);
+   }
+
+   MemFree(hBulkLoad->m_table);
+   MemFree(hBulkLoad);
+   return rc == DBERR_SUCCESS;
+#undef wcErrorText
+}
+
+/**
+ * Complete bulk load. All added rows are stored in database if this call succeeds.
+ * Bulk load handle is destroyed in any case.
+ */
+bool LIBNXDB_EXPORTABLE DBBulkLoadEndEx(DB_BULK_LOAD hBulkLoad, TCHAR *errorText)
+{
+   if (hBulkLoad == nullptr)
+   {
+      _tcscpy(errorText, _T("Invalid bulk load handle"));
+      return false;
+   }
+   return CompleteBulkLoad(hBulkLoad, true, errorText);
+}
+
+/**
+ * Complete bulk load
+ */
+bool LIBNXDB_EXPORTABLE DBBulkLoadEnd(DB_BULK_LOAD hBulkLoad)
+{
+   TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+   return DBBulkLoadEndEx(hBulkLoad, errorText);
+}
+
+/**
+ * Cancel bulk load. None of added rows will be stored in database. Bulk load handle is destroyed.
+ */
+void LIBNXDB_EXPORTABLE DBBulkLoadCancel(DB_BULK_LOAD hBulkLoad)
+{
+   if (hBulkLoad == nullptr)
+      return;
+   TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+   CompleteBulkLoad(hBulkLoad, false, errorText);
+}
+
 /**
  * Execute prepared SELECT statement
  */
@@ -569,6 +569,7 @@
    public static final int CMD_DELETE_CHAT_BOT = 0x0228;
    public static final int CMD_RENAME_CHAT_BOT = 0x0229;
    public static final int CMD_GET_CHAT_BOT_DRIVERS = 0x022A;
+   public static final int CMD_DCI_DATA_BATCH = 0x022B;
 
 	// CMD_RS_ - Reporting Server related codes
 	public static final int CMD_RS_LIST_REPORTS = 0x1100;
@@ -1605,6 +1606,7 @@
    public static final long VID_MAINTENANCE_SCHEDULED = 1027;
    public static final long VID_SNMP_AGENT_COUNT = 1028;
    public static final long VID_SNMP_AGENT_NAME = 1029;
+   public static final long VID_DATA_BATCHING = 1030;
 
    public static final long VID_SKILL_LIST_BASE = 0x50000000L;
    public static final long VID_SNMP_AGENT_LIST_BASE = 0x79000000L;
@@ -25,6 +25,7 @@
 #include <nxqueue.h>
 #include <welford.h>
 #include <queue>
+#include <deque>
 
 #define DEBUG_TAG _T("threads.pool")
 
@@ -50,18 +51,22 @@ static int s_maintThreadResponsiveness = 12;
 static int s_stalledCyclesThreshold = 2;
 
 /**
- * Indicator for stop with deregistration
+ * Number of wait time samples collected by worker thread in work stealing mode before
+ * they are merged into pool statistics by worker itself
  */
-static char s_stopAndUnregister[] = "UNREGISTER";
+#define LOCAL_WAIT_TIME_SAMPLES  64
 
 /**
- * Worker thread data
+ * Interval (in executed tasks) at which worker thread in work stealing mode tries to steal
+ * from other queues before checking own queue. This prevents starvation of requests left
+ * in queues without bound worker.
  */
-struct WorkerThreadInfo
-{
-   ThreadPool *pool;
-   THREAD handle;
-};
+#define STEAL_CHECK_INTERVAL     16
+
+/**
+ * Indicator for stop with deregistration
+ */
+static char s_stopAndUnregister[] = "UNREGISTER";
 
 /**
  * Thread work request
@@ -74,6 +79,84 @@ struct WorkRequest
    int64_t runTime;
 };
 
+/**
+ * Local request queue for work stealing mode. Queue is bound to worker thread while it is running,
+ * but outlives it and can be bound to another worker later. Wait time statistics for requests
+ * executed by bound worker are accumulated here and merged into pool statistics lazily.
+ */
+struct LocalRequestQueue
+{
+   Mutex lock;
+   std::deque<WorkRequest> requests;
+   VolatileCounter size;
+   bool bound;    // Protected by pool mutex
+   int sampleCount;
+   int64_t waitTimeSamples[LOCAL_WAIT_TIME_SAMPLES];
+   int64_t lastDequeueTime;
+
+   LocalRequestQueue() : lock(MutexType::FAST)
+   {
+      size = 0;
+      bound = false;
+      sampleCount = 0;
+      lastDequeueTime = 0;
+   }
+};
+
+/**
+ * Worker thread data
+ */
+struct WorkerThreadInfo
+{
+   ThreadPool *pool;
+   THREAD handle;
+   int queueIndex;               // Local queue index (work stealing mode only)
+   uint32_t randomState;         // State of pseudo-random generator for victim selection
+   uint32_t taskCount;
+   Condition wakeup;
+   WorkerThreadInfo *nextIdle;   // Next worker in idle list
+
+   WorkerThreadInfo(ThreadPool *_pool) : wakeup(false)
+   {
+      pool = _pool;
+      handle = INVALID_THREAD_HANDLE;
+      queueIndex = -1;
+      randomState = static_cast<uint32_t>(CAST_FROM_POINTER(this, uint64_t) >> 4) ^ static_cast<uint32_t>(GetCurrentTimeMs());
+      if (randomState == 0)
+         randomState = 1;
+      taskCount = 0;
+      nextIdle = nullptr;
+   }
+
+   /**
+    * Get next pseudo-random number (xorshift32)
+    */
+   uint32_t nextRandom()
+   {
+      randomState ^= randomState << 13;
+      randomState ^= randomState >> 17;
+      randomState ^= randomState << 5;
+      return randomState;
+   }
+};
+
+#if HAVE_THREAD_LOCAL_STORAGE
+
+/**
+ * Worker thread of work stealing pool running in current thread
+ */
+static thread_local WorkerThreadInfo *s_currentWorker = nullptr;
+
+#define SetCurrentWorker(w) do { s_currentWorker = (w); } while(0)
+#define GetCurrentWorker() s_currentWorker
+
+#else
+
+#define SetCurrentWorker(w)
+#define GetCurrentWorker() static_cast<WorkerThreadInfo*>(nullptr)
+
+#endif
+
 /**
  * Request queue for serialized execution
  */
@@ -133,10 +216,20 @@ struct ThreadPool
    uint64_t threadStartCount;
    uint64_t threadStopCount;
    VolatileCounter64 taskExecutionCount;
-
-   ThreadPool(const TCHAR *name, int minThreads, int maxThreads, int stackSize) :
+   bool workStealing;
+   LocalRequestQueue *localQueues;
+   int numLocalQueues;
+   int *boundQueues;                   // Indexes of local queues bound to running workers (protected by pool mutex for writing)
+   VolatileCounter boundQueueCount;
+   VolatileCounter nextQueue;          // Round robin counter for external submissions
+   VolatileCounter queuedRequests;     // Total number of requests in local queues
+   Mutex idleLock;
+   WorkerThreadInfo *idleWorkers;
+   VolatileCounter idleWorkerCount;
+
+   ThreadPool(const TCHAR *name, int minThreads, int maxThreads, int stackSize, uint32_t flags) :
          mutex(MutexType::FAST), maintThreadWakeup(false), queue(512), serializationQueues(Ownership::True),
-         serializationLock(MutexType::FAST), schedulerLock(MutexType::FAST)
+         serializationLock(MutexType::FAST), schedulerLock(MutexType::FAST), idleLock(MutexType::FAST)
    {
       this->name = (name != nullptr) ? MemCopyString(name) : MemCopyString(_T("NONAME"));
       this->minThreads = std::max(minThreads, 1);
@@ -153,13 +246,41 @@ struct ThreadPool
       threadStartCount = 0;
       threadStopCount = 0;
       taskExecutionCount = 0;
+      workStealing = ((flags & THREAD_POOL_WORK_STEALING) != 0);
+      if (workStealing)
+      {
+         numLocalQueues = this->maxThreads;
+         localQueues = new LocalRequestQueue[numLocalQueues];
+         boundQueues = MemAllocArray<int>(numLocalQueues);
+      }
+      else
+      {
+         numLocalQueues = 0;
+         localQueues = nullptr;
+         boundQueues = nullptr;
+      }
+      boundQueueCount = 0;
+      nextQueue = 0;
+      queuedRequests = 0;
+      idleWorkers = nullptr;
+      idleWorkerCount = 0;
    }
 
    ~ThreadPool()
    {
       threads.setOwner(Ownership::True);
+      delete[] localQueues;
+      MemFree(boundQueues);
       MemFree(name);
    }
+
+   /**
+    * Get number of requests waiting in queue(s)
+    */
+   int getQueueSize()
+   {
+      return workStealing ? static_cast<int>(queuedRequests) : static_cast<int>(queue.size());
+   }
 };
 
 /**
@@ -178,23 +299,300 @@ static void JoinWorkerThread(void *arg)
 }
 
 /**
- * Worker thread function
+ * Bind free local queue to new worker. Caller must hold pool mutex.
+ * Returns queue index or -1 if there are no free queues.
  */
-static void WorkerThread(WorkerThreadInfo *threadInfo)
+static int BindLocalQueue(ThreadPool *p)
+{
+   for(int i = 0; i < p->numLocalQueues; i++)
+   {
+      if (!p->localQueues[i].bound)
+      {
+         p->localQueues[i].bound = true;
+         p->boundQueues[p->boundQueueCount] = i;
+         InterlockedIncrement(&p->boundQueueCount);
+         return i;
+      }
+   }
+   return -1;
+}
+
+/**
+ * Unbind local queue from stopped worker. Caller must hold pool mutex.
+ */
+static void UnbindLocalQueue(ThreadPool *p, int index)
+{
+   p->localQueues[index].bound = false;
+   for(int i = 0; i < p->boundQueueCount; i++)
+   {
+      if (p->boundQueues[i] == index)
+      {
+         p->boundQueues[i] = p->boundQueues[p->boundQueueCount - 1];
+         InterlockedDecrement(&p->boundQueueCount);
+         break;
+      }
+   }
+}
+
+/**
+ * Wake up one idle worker (work stealing mode)
+ */
+static void WakeIdleWorker(ThreadPool *p)
+{
+   p->idleLock.lock();
+   WorkerThreadInfo *wt = p->idleWorkers;
+   if (wt != nullptr)
+   {
+      p->idleWorkers = wt->nextIdle;
+      InterlockedDecrement(&p->idleWorkerCount);
+      wt->wakeup.set();
+   }
+   p->idleLock.unlock();
+}
+
+/**
+ * Put request into pool's queue. In work stealing mode request submitted from pool's own worker
+ * is placed into that worker's local queue, and requests from other threads are distributed
+ * between local queues of running workers in round robin manner.
+ */
+static void EnqueueRequest(ThreadPool *p, const WorkRequest& rq)
+{
+   if (!p->workStealing)
+   {
+      p->queue.put(rq);
+      return;
+   }
+
+   int index;
+   WorkerThreadInfo *self = GetCurrentWorker();
+   if ((self != nullptr) && (self->pool == p))
+   {
+      index = self->queueIndex;
+   }
+   else
+   {
+      int count = p->boundQueueCount;
+      index = (count > 0) ? p->boundQueues[static_cast<uint32_t>(InterlockedIncrement(&p->nextQueue)) % count] : 0;
+   }
+
+   LocalRequestQueue *q = &p->localQueues[index];
+   q->lock.lock();
+   q->requests.push_back(rq);
+   q->size++;
+   q->lock.unlock();
+
+   // Queued request counter should be updated before idle worker count is checked, and
+   // worker going idle does it in opposite order, so wakeup cannot be lost
+   InterlockedIncrement(&p->queuedRequests);
+   if (p->idleWorkerCount > 0)
+      WakeIdleWorker(p);
+}
+
+/**
+ * Take request from given local queue
+ */
+static bool TakeLocalRequest(ThreadPool *p, LocalRequestQueue *q, WorkRequest *rq)
+{
+   if (q->size == 0)
+      return false;
+
+   q->lock.lock();
+   bool success = !q->requests.empty();
+   if (success)
+   {
+      *rq = q->requests.front();
+      q->requests.pop_front();
+      q->size--;
+   }
+   q->lock.unlock();
+
+   if (success)
+      InterlockedDecrement(&p->queuedRequests);
+   return success;
+}
+
+/**
+ * Get next request for worker in work stealing mode. Worker checks own queue first and
+ * then tries other queues starting from random one.
+ */
+static bool DequeueLocalRequest(ThreadPool *p, WorkerThreadInfo *wt, WorkRequest *rq)
+{
+   LocalRequestQueue *own = &p->localQueues[wt->queueIndex];
+   bool stealFirst = ((++wt->taskCount % STEAL_CHECK_INTERVAL) == 0);
+   if (!stealFirst && TakeLocalRequest(p, own, rq))
+      return true;
+
+   int start = static_cast<int>(wt->nextRandom() % static_cast<uint32_t>(p->numLocalQueues));
+   for(int i = 0; i < p->numLocalQueues; i++)
+   {
+      int index = (start + i) % p->numLocalQueues;
+      if ((index != wt->queueIndex) && TakeLocalRequest(p, &p->localQueues[index], rq))
+         return true;
+   }
+
+   return stealFirst && TakeLocalRequest(p, own, rq);
+}
+
+/**
+ * Merge wait time samples into pool statistics. Caller must hold pool mutex.
+ */
+static void MergeWaitTimeSamples(ThreadPool *p, const int64_t *samples, int count, int64_t lastDequeueTime)
+{
+   for(int i = 0; i < count; i++)
+   {
+      UpdateExpMovingAverage(p->waitTimeEMA, EMA_EXP(1, 1000), samples[i]); // Use last 1000 executions
+      p->waitTimeVariance.update(samples[i]);
+   }
+   if (lastDequeueTime > p->lastDequeueTime)
+      p->lastDequeueTime = lastDequeueTime;
+}
+
+/**
+ * Record request wait time in local queue statistics (work stealing mode). Samples are
+ * merged into pool statistics when local buffer is full or by maintenance thread.
+ */
+static void RecordWaitTime(ThreadPool *p, LocalRequestQueue *q, int64_t now, int64_t waitTime)
+{
+   int64_t samples[LOCAL_WAIT_TIME_SAMPLES];
+   int count = 0;
+
+   q->lock.lock();
+   q->waitTimeSamples[q->sampleCount++] = waitTime;
+   q->lastDequeueTime = now;
+   if (q->sampleCount == LOCAL_WAIT_TIME_SAMPLES)
+   {
+      memcpy(samples, q->waitTimeSamples, sizeof(samples));
+      count = LOCAL_WAIT_TIME_SAMPLES;
+      q->sampleCount = 0;
+   }
+   q->lock.unlock();
+
+   if (count > 0)
+   {
+      p->mutex.lock();
+      MergeWaitTimeSamples(p, samples, count, now);
+      p->mutex.unlock();
+   }
+}
+
+/**
+ * Merge statistics accumulated in local queues into pool statistics (work stealing mode).
+ * Caller must not hold pool mutex.
+ */
+static void MergeLocalStatistics(ThreadPool *p)
+{
+   if (!p->workStealing)
+      return;
+
+   int64_t samples[LOCAL_WAIT_TIME_SAMPLES];
+   for(int i = 0; i < p->numLocalQueues; i++)
+   {
+      LocalRequestQueue *q = &p->localQueues[i];
+      q->lock.lock();
+      int count = q->sampleCount;
+      memcpy(samples, q->waitTimeSamples, count * sizeof(int64_t));
+      q->sampleCount = 0;
+      int64_t lastDequeueTime = q->lastDequeueTime;
+      q->lock.unlock();
+
+      p->mutex.lock();
+      MergeWaitTimeSamples(p, samples, count, lastDequeueTime);
+      p->mutex.unlock();
+   }
+}
+
+/**
+ * Move requests from local queue of stopped worker to queues of running workers
+ */
+static void RedistributeLocalQueue(ThreadPool *p, int index)
+{
+   std::deque<WorkRequest> requests;
+   LocalRequestQueue *q = &p->localQueues[index];
+   q->lock.lock();
+   requests.swap(q->requests);
+   q->size = 0;
+   q->lock.unlock();
+
+   for(const WorkRequest& rq : requests)
+   {
+      InterlockedDecrement(&p->queuedRequests);
+      EnqueueRequest(p, rq);
+   }
+}
+
+/**
+ * Worker loop for pool with work stealing
+ */
+static void ProcessLocalQueues(WorkerThreadInfo *threadInfo)
 {
    ThreadPool *p = threadInfo->pool;
+   SetCurrentWorker(threadInfo);
 
-   char threadName[16];
-   threadName[0] = '$';
-#ifdef UNICODE
-   wchar_to_ASCII(p->name, -1, &threadName[1], 11);
-   threadName[11] = 0;
-#else
-   strlcpy(&threadName[1], p->name, 11);
-#endif
-   strlcat(threadName, "/WRK", 16);
-   ThreadSetName(threadName);
+   while(true)
+   {
+      WorkRequest rq;
+      if (!DequeueLocalRequest(p, threadInfo, &rq))
+      {
+         if (p->shutdownMode)
+            break;   // All queues are drained
+
+         // Register as idle worker and re-check number of queued requests after that,
+         // so request submitted concurrently will either be seen here or will wake up this worker
+         p->idleLock.lock();
+         threadInfo->nextIdle = p->idleWorkers;
+         p->idleWorkers = threadInfo;
+         InterlockedIncrement(&p->idleWorkerCount);
+         bool hasWork = (p->queuedRequests > 0) || p->shutdownMode;
+         if (hasWork)
+         {
+            p->idleWorkers = threadInfo->nextIdle;
+            InterlockedDecrement(&p->idleWorkerCount);
+         }
+         p->idleLock.unlock();
+
+         if (!hasWork)
+            threadInfo->wakeup.wait(INFINITE);
+         continue;
+      }
+
+      if (rq.func == nullptr) // stop indicator
+      {
+         if (rq.arg == s_stopAndUnregister)
+         {
+            p->mutex.lock();
+            p->threads.remove(CAST_FROM_POINTER(threadInfo, uint64_t));
+            p->threadStopCount++;
+            UnbindLocalQueue(p, threadInfo->queueIndex);
+            p->mutex.unlock();
+
+            SetCurrentWorker(nullptr);
+            RedistributeLocalQueue(p, threadInfo->queueIndex);
+
+            rq.func = JoinWorkerThread;
+            rq.arg = threadInfo;
+            rq.queueTime = GetCurrentTimeMs();
+            InterlockedIncrement(&p->activeRequests);
+            EnqueueRequest(p, rq);
+         }
+         break;
+      }
+
+      int64_t now = GetCurrentTimeMs();
+      RecordWaitTime(p, &p->localQueues[threadInfo->queueIndex], now, now - rq.queueTime);
 
+      rq.func(rq.arg);
+      InterlockedDecrement(&p->activeRequests);
+   }
+
+   SetCurrentWorker(nullptr);
+}
+
+/**
+ * Worker loop for pool with shared queue
+ */
+static void ProcessSharedQueue(WorkerThreadInfo *threadInfo)
+{
+   ThreadPool *p = threadInfo->pool;
    while(true)
    {
       WorkRequest rq;
@@ -228,6 +626,30 @@ static void WorkerThread(WorkerThreadInfo *threadInfo)
       rq.func(rq.arg);
       InterlockedDecrement(&p->activeRequests);
    }
+}
+
+/**
+ * Worker thread function
+ */
+static void WorkerThread(WorkerThreadInfo *threadInfo)
+{
+   ThreadPool *p = threadInfo->pool;
+
+   char threadName[16];
+   threadName[0] = '$';
+#ifdef UNICODE
+   wchar_to_ASCII(p->name, -1, &threadName[1], 11);
+   threadName[11] = 0;
+#else
+   strlcpy(&threadName[1], p->name, 11);
+#endif
+   strlcat(threadName, "/WRK", 16);
+   ThreadSetName(threadName);
+
+   if (p->workStealing)
+      ProcessLocalQueues(threadInfo);
+   else
+      ProcessSharedQueue(threadInfo);
 
    nxlog_debug_tag(DEBUG_TAG, 8, _T("Worker thread in thread pool %s stopped"), p->name);
 }
@@ -242,8 +664,16 @@ static int StartWorkerThreads(ThreadPool *p, int count, bool *failure)
    int started = 0;
    for(int i = 0; i < count; i++)
    {
-      WorkerThreadInfo *wt = new WorkerThreadInfo;
-      wt->pool = p;
+      WorkerThreadInfo *wt = new WorkerThreadInfo(p);
+      if (p->workStealing)
+      {
+         wt->queueIndex = BindLocalQueue(p);
+         if (wt->queueIndex == -1)
+         {
+            delete wt;
+            break;
+         }
+      }
       wt->handle = ThreadCreateEx(WorkerThread, wt, p->stackSize);
       if (wt->handle != INVALID_THREAD_HANDLE)
       {
@@ -253,6 +683,8 @@ static int StartWorkerThreads(ThreadPool *p, int count, bool *failure)
       }
       else
       {
+         if (p->workStealing)
+            UnbindLocalQueue(p, wt->queueIndex);
          delete wt;
          *failure = true;
          break;
@@ -293,12 +725,14 @@ static void MaintenanceThread(ThreadPool *p)
       {
          cycleTime = 0;
 
+         MergeLocalStatistics(p);
+
          int64_t requestCount = static_cast<int64_t>(p->activeRequests);
          UpdateExpMovingAverage(p->loadAverage[0], EMA_EXP_12, requestCount);
          UpdateExpMovingAverage(p->loadAverage[1], EMA_EXP_60, requestCount);
          UpdateExpMovingAverage(p->loadAverage[2], EMA_EXP_180, requestCount);
 
-         int64_t queueSize = static_cast<int64_t>(p->queue.size());
+         int64_t queueSize = static_cast<int64_t>(p->getQueueSize());
          UpdateExpMovingAverage(p->queueSizeEMA, EMA_EXP_180, queueSize);
          p->queueSizeVariance.update(queueSize);
 
@@ -369,7 +803,7 @@ static void MaintenanceThread(ThreadPool *p)
                   rq.func = nullptr;
                   rq.arg = s_stopAndUnregister;
                   rq.queueTime = GetCurrentTimeMs();
-                  p->queue.put(rq);
+                  EnqueueRequest(p, rq);
                }
             }
             p->waitTimeVariance.reset();
@@ -415,7 +849,7 @@ static void MaintenanceThread(ThreadPool *p)
             InterlockedIncrement(&p->activeRequests);
             InterlockedIncrement64(&p->taskExecutionCount);
             rq.queueTime = now;
-            p->queue.put(rq);
+            EnqueueRequest(p, rq);
             p->schedulerQueue.pop();
          }
       }
@@ -427,16 +861,17 @@ static void MaintenanceThread(ThreadPool *p)
 /**
  * Create thread pool
  */
-ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThreads, int maxThreads, int stackSize)
+ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThreads, int maxThreads, int stackSize, uint32_t flags)
 {
-   auto p = new ThreadPool(name, minThreads, maxThreads, stackSize);
+   auto p = new ThreadPool(name, minThreads, maxThreads, stackSize, flags);
    p->maintThread = ThreadCreateEx(MaintenanceThread, p, 256 * 1024);
 
    p->mutex.lock();
    for(int i = 0; i < p->minThreads; i++)
    {
-      WorkerThreadInfo *wt = new WorkerThreadInfo;
-      wt->pool = p;
+      WorkerThreadInfo *wt = new WorkerThreadInfo(p);
+      if (p->workStealing)
+         wt->queueIndex = BindLocalQueue(p);
       wt->handle = ThreadCreateEx(WorkerThread, wt, stackSize);
       if (wt->handle != INVALID_THREAD_HANDLE)
       {
@@ -445,6 +880,8 @@ ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThre
       else
       {
          nxlog_debug_tag(DEBUG_TAG, 1, _T("Cannot create worker thread in pool %s"), p->name);
+         if (p->workStealing)
+            UnbindLocalQueue(p, wt->queueIndex);
          delete wt;
       }
    }
@@ -454,7 +891,7 @@ ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThre
    s_registry.set(p->name, p);
    s_registryLock.unlock();
 
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("Thread pool %s initialized (min=%d, max=%d)"), p->name, p->minThreads, p->maxThreads);
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Thread pool %s initialized (min=%d, max=%d%s)"), p->name, p->minThreads, p->maxThreads, p->workStealing ? _T(", work stealing") : _T(""));
    return p;
 }
 
@@ -480,15 +917,31 @@ void LIBNETXMS_EXPORTABLE ThreadPoolDestroy(ThreadPool *p)
    p->maintThreadWakeup.set();
    ThreadJoin(p->maintThread);
 
-   WorkRequest rq;
-   rq.func = nullptr;
-   rq.arg = nullptr;
-   rq.queueTime = GetCurrentTimeMs();
-   p->mutex.lock();
-   int count = p->threads.size();
-   for(int i = 0; i < count; i++)
-      p->queue.put(rq);
-   p->mutex.unlock();
+   if (p->workStealing)
+   {
+      // Wake up all idle workers - they will exit after all local queues are drained
+      p->idleLock.lock();
+      while(p->idleWorkers != nullptr)
+      {
+         WorkerThreadInfo *wt = p->idleWorkers;
+         p->idleWorkers = wt->nextIdle;
+         InterlockedDecrement(&p->idleWorkerCount);
+         wt->wakeup.set();
+      }
+      p->idleLock.unlock();
+   }
+   else
+   {
+      WorkRequest rq;
+      rq.func = nullptr;
+      rq.arg = nullptr;
+      rq.queueTime = GetCurrentTimeMs();
+      p->mutex.lock();
+      int count = p->threads.size();
+      for(int i = 0; i < count; i++)
+         p->queue.put(rq);
+      p->mutex.unlock();
+   }
 
    p->threads.forEach(
       [] (const uint64_t& key, WorkerThreadInfo *object) -> EnumerationCallbackResult
@@ -515,7 +968,7 @@ void LIBNETXMS_EXPORTABLE ThreadPoolExecute(ThreadPool *p, ThreadPoolWorkerFunct
    rq.func = f;
    rq.arg = arg;
    rq.queueTime = GetCurrentTimeMs();
-   p->queue.put(rq);
+   EnqueueRequest(p, rq);
 }
 
 /**
@@ -638,6 +1091,8 @@ void LIBNETXMS_EXPORTABLE ThreadPoolScheduleRelative(ThreadPool *p, uint32_t del
  */
 void LIBNETXMS_EXPORTABLE ThreadPoolGetInfo(ThreadPool *p, ThreadPoolInfo *info)
 {
+   MergeLocalStatistics(p);
+
    p->mutex.lock();
    info->name = p->name;
    info->minThreads = p->minThreads;
@@ -583,6 +583,62 @@ static inline int __stat(LogParser *parser, const TCHAR *fname, NX_STAT_STRUCT*
 #endif
 }
 
+/**
+ * Interval between file checks (in milliseconds) when file changes are reported by inotify. Files are
+ * still checked periodically to catch changes not reported by underlying file system (like NFS).
+ */
+#define NOTIFIED_FILE_CHECK_INTERVAL   60000
+
+/**
+ * Start watching for changes of given file or re-arm existing watch if file was replaced
+ */
+static inline void WatchFileChanges(FileChangeWatch **watch, const TCHAR *fileName, const NX_STAT_STRUCT *st, Condition *wakeup)
+{
+   if (!IsFileChangeWatchValid(*watch, fileName, st))
+   {
+      // Add new watch before removing old one to keep dispatcher running
+      FileChangeWatch *oldWatch = *watch;
+      *watch = AddFileChangeWatch(fileName, st, wakeup);
+      RemoveFileChangeWatch(oldWatch);
+   }
+}
+
+/**
+ * Wait for file change notification or timeout. Returns true if parser stop was requested.
+ */
+bool LogParser::waitForFileChange(uint32_t timeout)
+{
+   if (!HasFileChangeNotifications(m_fileChangeWatch))
+      return m_stopCondition.wait(timeout);
+   m_fileChangeCondition.wait(timeout);
+   return m_stopCondition.wait(0);
+}
+
+/**
+ * Check if file name contains macros or wildcards, so actual file can change without any event
+ * for currently watched file or its name
+ */
+static inline bool IsFileNameTemplate(const TCHAR *fileName)
+{
+   return (_tcspbrk(fileName, _T("%`*?")) != nullptr) || (_tcsstr(fileName, _T("${")) != nullptr);
+}
+
+/**
+ * Get interval between file checks when there is no pending incomplete record
+ */
+uint32_t LogParser::getIdleCheckInterval() const
+{
+   if (!HasFileChangeNotifications(m_fileChangeWatch) || !m_exclusionSchedules.isEmpty() || IsFileNameTemplate(m_fileName))
+      return m_fileCheckInterval;
+
+   // Absence rules are evaluated on each check
+   for(int i = 0; i < m_rules.size(); i++)
+      if (m_rules.get(i)->isAbsenceRule())
+         return m_fileCheckInterval;
+
+   return std::max(m_fileCheckInterval, static_cast<uint32_t>(NOTIFIED_FILE_CHECK_INTERVAL));
+}
+
 /**
  * File parser thread
  */
@@ -642,7 +698,7 @@ bool LogParser::monitorFile(off_t startOffset)
          if (errno == ENOENT)
             readFromStart = true;
          setStatus(LPS_NO_FILE);
-         if (m_stopCondition.wait(10000))
+         if (waitForFileChange(10000))
             break;
          continue;
       }
@@ -662,6 +718,7 @@ bool LogParser::monitorFile(off_t startOffset)
 
 		setStatus(LPS_RUNNING);
 		nxlog_debug_tag(DEBUG_TAG, 3, _T("File \"%s\" (pattern \"%s\") successfully opened"), fname, m_fileName);
+		WatchFileChanges(&m_fileChangeWatch, fname, &st, &m_fileChangeCondition);
 
       if (m_fileEncoding == LP_FCP_AUTO)
       {
@@ -704,8 +761,8 @@ bool LogParser::monitorFile(off_t startOffset)
 		{
 			// When an incomplete record is pending, poll at the shorter of check interval and flush timeout
 			uint32_t waitTime = ((m_incompleteRecordTimeout > 0) && (incompleteRecordStart >= 0)) ?
-			      std::min(m_incompleteRecordTimeout, m_fileCheckInterval) : m_fileCheckInterval;
-			if (m_stopCondition.wait(waitTime))
+			      std::min(m_incompleteRecordTimeout, m_fileCheckInterval) : getIdleCheckInterval();
+			if (waitForFileChange(waitTime))
 			{
 			   _close(fh);
 				goto stop_parser;
@@ -841,6 +898,8 @@ bool LogParser::monitorFile(off_t startOffset)
 	}
 
 stop_parser:
+   RemoveFileChangeWatch(m_fileChangeWatch);
+   m_fileChangeWatch = nullptr;
    nxlog_debug_tag(DEBUG_TAG, 0, _T("Parser thread for file \"%s\" stopped"), m_fileName);
 	return true;
 }
@@ -898,11 +957,13 @@ bool LogParser::monitorFile2(off_t startOffset)
             startOffset = -1;
          }
          setStatus(LPS_NO_FILE);
-         if (m_stopCondition.wait(10000))
+         if (waitForFileChange(10000))
             break;
          continue;
       }
 
+      WatchFileChanges(&m_fileChangeWatch, fname, &st, &m_fileChangeCondition);
+
 #ifdef _WIN32
       if (firstRead)
          ctime = st.st_ctime; // prevent incorrect rotation detection on first read
@@ -928,8 +989,8 @@ bool LogParser::monitorFile2(off_t startOffset)
             {
                // When an incomplete record is pending, poll at the shorter of check interval and flush timeout
                uint32_t waitTime = ((m_incompleteRecordTimeout > 0) && (incompleteRecordStart >= 0)) ?
-                     std::min(m_incompleteRecordTimeout, m_fileCheckInterval) : m_fileCheckInterval;
-               if (m_stopCondition.wait(waitTime))
+                     std::min(m_incompleteRecordTimeout, m_fileCheckInterval) : getIdleCheckInterval();
+               if (waitForFileChange(waitTime))
                   break;
                continue;
             }
@@ -1049,13 +1110,15 @@ bool LogParser::monitorFile2(off_t startOffset)
 
       // When an incomplete record is pending, poll at the shorter of check interval and flush timeout
       uint32_t waitTime = ((m_incompleteRecordTimeout > 0) && (incompleteRecordStart >= 0)) ?
-            std::min(m_incompleteRecordTimeout, m_fileCheckInterval) : m_fileCheckInterval;
-      if (m_stopCondition.wait(waitTime))
+            std::min(m_incompleteRecordTimeout, m_fileCheckInterval) : getIdleCheckInterval();
+      if (waitForFileChange(waitTime))
          break;
 
       checkAbsenceRules(time(nullptr));
    }
 
+   RemoveFileChangeWatch(m_fileChangeWatch);
+   m_fileChangeWatch = nullptr;
    nxlog_debug_tag(DEBUG_TAG, 0, _T("Parser thread for file \"%s\" stopped"), m_fileName);
    return true;
 }
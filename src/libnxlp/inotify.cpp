@@ -0,0 +1,510 @@
+/*
+** NetXMS - Network Management System
+** Log Parsing Library
+** Copyright (C) 2003-2026 Raden Solutions
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation; either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: inotify.cpp
+**
+**/
+
+#include "libnxlp.h"
+#include <nxstat.h>
+
+#if HAVE_SYS_INOTIFY_H
+
+#include <sys/inotify.h>
+#include <sys/vfs.h>
+#include <poll.h>
+
+/**
+ * Events watched on monitored file itself
+ */
+#define FILE_WATCH_MASK       (IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF)
+
+/**
+ * Events watched on directory containing monitored file (to detect file re-creation after rotation)
+ */
+#define DIRECTORY_WATCH_MASK  (IN_CREATE | IN_MOVED_TO | IN_ONLYDIR)
+
+/**
+ * Check if file is located on network or FUSE file system. Changes made on other hosts are not
+ * reported by inotify for such file systems, so they should be polled.
+ */
+static bool IsNetworkFileSystem(const char *path)
+{
+   struct statfs fs;
+   if (statfs(path, &fs) != 0)
+      return false;
+   switch(static_cast<uint32_t>(fs.f_type))
+   {
+      case 0x6969:      // NFS
+      case 0x517B:      // SMB
+      case 0xFE534D42:  // SMB2
+      case 0xFF534D42:  // CIFS
+      case 0x00C36400:  // Ceph
+      case 0x5346414F:  // AFS
+      case 0x01161970:  // GFS2
+      case 0x47504653:  // GPFS
+      case 0x0BD00BD0:  // Lustre
+      case 0x65735546:  // FUSE
+         return true;
+      default:
+         return false;
+   }
+}
+
+/**
+ * File change watch
+ */
+struct FileChangeWatch
+{
+   TCHAR *path;
+   char *name;       // File name within directory (in system locale)
+   int fileWd;
+   int dirWd;
+   dev_t device;
+   ino_t inode;
+   Condition *wakeup;
+   bool failed;      // Kernel watch cannot be created
+};
+
+/**
+ * Watches associated with single inotify watch descriptor. Same file or directory can be
+ * monitored by multiple parsers, while kernel returns same descriptor for each of them.
+ */
+struct WatchDescriptorUsage
+{
+   ObjectArray<FileChangeWatch> fileWatches;
+   ObjectArray<FileChangeWatch> dirWatches;
+
+   WatchDescriptorUsage() : fileWatches(0, 8, Ownership::False), dirWatches(0, 8, Ownership::False) {}
+
+   bool isEmpty() const { return fileWatches.isEmpty() && dirWatches.isEmpty(); }
+};
+
+/**
+ * Dispatcher thread arguments
+ */
+struct DispatcherContext
+{
+   int fd;
+   int stopPipe[2];
+};
+
+/**
+ * Dispatcher state
+ */
+static Mutex s_lock(MutexType::FAST);
+static HashMap<int, WatchDescriptorUsage> s_descriptors(Ownership::True);
+static DispatcherContext *s_dispatcher = nullptr;
+static THREAD s_dispatcherThread = INVALID_THREAD_HANDLE;
+static int s_watchCount = 0;
+
+/**
+ * Detach all watches from given descriptor after it was removed by kernel. Dispatcher lock must be held.
+ */
+static void ReleaseWatchDescriptor(int wd)
+{
+   WatchDescriptorUsage *usage = s_descriptors.get(wd);
+   if (usage == nullptr)
+      return;
+   for(int i = 0; i < usage->fileWatches.size(); i++)
+   {
+      FileChangeWatch *w = usage->fileWatches.get(i);
+      w->fileWd = -1;
+      w->wakeup->set();
+   }
+   for(int i = 0; i < usage->dirWatches.size(); i++)
+   {
+      FileChangeWatch *w = usage->dirWatches.get(i);
+      w->dirWd = -1;
+      w->wakeup->set();
+   }
+   s_descriptors.remove(wd);
+}
+
+/**
+ * Process single inotify event. Dispatcher lock must be held.
+ */
+static void ProcessEvent(const struct inotify_event *event)
+{
+   if (event->mask & IN_Q_OVERFLOW)
+   {
+      // Events were lost, wake up all parsers to re-check their files
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("inotify event queue overflow"));
+      s_descriptors.forEach(
+         [] (const int& wd, WatchDescriptorUsage *usage) -> EnumerationCallbackResult
+         {
+            for(int i = 0; i < usage->fileWatches.size(); i++)
+               usage->fileWatches.get(i)->wakeup->set();
+            return _CONTINUE;
+         });
+      return;
+   }
+
+   if (event->mask & IN_IGNORED)
+   {
+      ReleaseWatchDescriptor(event->wd);
+      return;
+   }
+
+   WatchDescriptorUsage *usage = s_descriptors.get(event->wd);
+   if (usage == nullptr)
+      return;
+
+   for(int i = 0; i < usage->fileWatches.size(); i++)
+      usage->fileWatches.get(i)->wakeup->set();
+
+   if ((event->len > 0) && !usage->dirWatches.isEmpty())
+   {
+      for(int i = 0; i < usage->dirWatches.size(); i++)
+      {
+         FileChangeWatch *w = usage->dirWatches.get(i);
+         if (!strcmp(w->name, event->name))
+         {
+            nxlog_debug_tag(DEBUG_TAG, 6, _T("File \"%s\" created or moved in"), w->path);
+            w->wakeup->set();
+         }
+      }
+   }
+}
+
+/**
+ * Dispatcher thread - reads events for all monitored files and wakes up corresponding parsers
+ */
+static void DispatcherThread(DispatcherContext *context)
+{
+   nxlog_debug_tag(DEBUG_TAG, 3, _T("inotify dispatcher thread started"));
+
+   alignas(struct inotify_event) char buffer[65536];
+   struct pollfd fds[2];
+   fds[0].fd = context->fd;
+   fds[0].events = POLLIN;
+   fds[1].fd = context->stopPipe[0];
+   fds[1].events = POLLIN;
+   while(true)
+   {
+      if (poll(fds, 2, -1) < 0)
+      {
+         if (errno == EINTR)
+            continue;
+         nxlog_debug_tag(DEBUG_TAG, 3, _T("inotify dispatcher: poll() failed (%s)"), _tcserror(errno));
+         break;
+      }
+      if (fds[1].revents != 0)
+         break;
+      if (fds[0].revents == 0)
+         continue;
+
+      ssize_t bytes = read(context->fd, buffer, sizeof(buffer));
+      if (bytes <= 0)
+         continue;
+
+      s_lock.lock();
+      for(char *curr = buffer; curr < buffer + bytes;)
+      {
+         const struct inotify_event *event = reinterpret_cast<const struct inotify_event*>(curr);
+         ProcessEvent(event);
+         curr += sizeof(struct inotify_event) + event->len;
+      }
+      s_lock.unlock();
+   }
+
+   close(context->fd);
+   close(context->stopPipe[0]);
+   close(context->stopPipe[1]);
+   delete context;
+   nxlog_debug_tag(DEBUG_TAG, 3, _T("inotify dispatcher thread stopped"));
+}
+
+/**
+ * Start dispatcher if needed. Dispatcher lock must be held.
+ */
+static bool StartDispatcher()
+{
+   if (s_dispatcher != nullptr)
+      return true;
+
+   int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+   if (fd == -1)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot initialize inotify (%s), file changes will be detected by polling"), _tcserror(errno));
+      return false;
+   }
+
+   auto context = new DispatcherContext();
+   context->fd = fd;
+   if (pipe(context->stopPipe) != 0)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot create control pipe for inotify dispatcher (%s)"), _tcserror(errno));
+      close(fd);
+      delete context;
+      return false;
+   }
+
+   s_dispatcher = context;
+   s_dispatcherThread = ThreadCreateEx(DispatcherThread, context);
+   return true;
+}
+
+/**
+ * Add inotify watch and register it in descriptor map. Dispatcher lock must be held.
+ */
+static int AddWatchDescriptor(const char *path, uint32_t mask, FileChangeWatch *watch, bool directory)
+{
+   int wd = inotify_add_watch(s_dispatcher->fd, path, mask);
+   if (wd == -1)
+      return -1;
+
+   WatchDescriptorUsage *usage = s_descriptors.get(wd);
+   if (usage == nullptr)
+   {
+      usage = new WatchDescriptorUsage();
+      s_descriptors.set(wd, usage);
+   }
+   if (directory)
+      usage->dirWatches.add(watch);
+   else
+      usage->fileWatches.add(watch);
+   return wd;
+}
+
+/**
+ * Unregister watch from descriptor and remove inotify watch if it is not used anymore. Dispatcher lock must be held.
+ */
+static void RemoveWatchDescriptor(int wd, FileChangeWatch *watch, bool directory)
+{
+   WatchDescriptorUsage *usage = s_descriptors.get(wd);
+   if (usage == nullptr)
+      return;
+   if (directory)
+      usage->dirWatches.remove(watch);
+   else
+      usage->fileWatches.remove(watch);
+   if (usage->isEmpty())
+   {
+      inotify_rm_watch(s_dispatcher->fd, wd);
+      s_descriptors.remove(wd);
+   }
+}
+
+/**
+ * Remove kernel watches for given file change watch counted in running dispatcher. If this was last watch,
+ * dispatcher is detached and returned (together with its thread in "thread") so that caller can stop it
+ * after releasing the lock. Dispatcher lock must be held.
+ */
+static DispatcherContext *DetachKernelWatch(FileChangeWatch *watch, THREAD *thread)
+{
+   if (watch->fileWd != -1)
+      RemoveWatchDescriptor(watch->fileWd, watch, false);
+   if (watch->dirWd != -1)
+      RemoveWatchDescriptor(watch->dirWd, watch, true);
+   watch->fileWd = -1;
+   watch->dirWd = -1;
+   if (--s_watchCount > 0)
+      return nullptr;
+
+   DispatcherContext *dispatcher = s_dispatcher;
+   *thread = s_dispatcherThread;
+   s_dispatcher = nullptr;
+   s_dispatcherThread = INVALID_THREAD_HANDLE;
+   return dispatcher;
+}
+
+/**
+ * Stop detached dispatcher. Should be called without dispatcher lock.
+ */
+static void StopDispatcher(DispatcherContext *dispatcher, THREAD thread)
+{
+   // Dispatcher thread owns its context and will close descriptors on exit
+   char cmd = 0;
+   if (write(dispatcher->stopPipe[1], &cmd, 1) == 1)
+      ThreadJoin(thread);
+   else
+      ThreadDetach(thread);
+}
+
+/**
+ * Remove kernel watches for given file change watch. Dispatcher thread is stopped when last watch is removed.
+ */
+static void ReleaseKernelWatch(FileChangeWatch *watch)
+{
+   THREAD stoppedThread = INVALID_THREAD_HANDLE;
+   s_lock.lock();
+   DispatcherContext *stoppedDispatcher = (s_dispatcher != nullptr) ? DetachKernelWatch(watch, &stoppedThread) : nullptr;
+   s_lock.unlock();
+
+   if (stoppedDispatcher != nullptr)
+      StopDispatcher(stoppedDispatcher, stoppedThread);
+}
+
+/**
+ * Start watching for changes of given file and its re-creation in parent directory. Condition will be
+ * set on every change. If kernel watch cannot be created, returned watch is marked as failed and file
+ * should be polled instead.
+ */
+FileChangeWatch *AddFileChangeWatch(const TCHAR *path, const NX_STAT_STRUCT *st, Condition *wakeup)
+{
+   char mbpath[MAX_PATH];
+#ifdef UNICODE
+   WideCharToMultiByteSysLocale(path, mbpath, MAX_PATH);
+#else
+   strlcpy(mbpath, path, MAX_PATH);
+#endif
+
+   char *s = strrchr(mbpath, '/');
+
+   auto watch = MemAllocStruct<FileChangeWatch>();
+   watch->path = MemCopyString(path);
+   watch->name = MemCopyStringA((s != nullptr) ? s + 1 : mbpath);
+   watch->fileWd = -1;
+   watch->dirWd = -1;
+   watch->device = st->st_dev;
+   watch->inode = st->st_ino;
+   watch->wakeup = wakeup;
+
+   if ((s == nullptr) || (s[1] == 0))
+   {
+      watch->failed = true;
+      return watch;
+   }
+
+   if (IsNetworkFileSystem(mbpath))
+   {
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("File \"%s\" is located on network file system, file changes will be detected by polling"), path);
+      watch->failed = true;
+      return watch;
+   }
+
+   // Dispatcher start, watch count update, and rollback on failure are done under single lock, so that
+   // failed attempt cannot affect watch count of dispatcher started concurrently by another thread
+   DispatcherContext *stoppedDispatcher = nullptr;
+   THREAD stoppedThread = INVALID_THREAD_HANDLE;
+   s_lock.lock();
+   if (StartDispatcher())
+   {
+      s_watchCount++;
+      watch->fileWd = AddWatchDescriptor(mbpath, FILE_WATCH_MASK, watch, false);
+      if (watch->fileWd != -1)
+      {
+         if (s != mbpath)
+            *s = 0;
+         watch->dirWd = AddWatchDescriptor((s != mbpath) ? mbpath : "/", DIRECTORY_WATCH_MASK, watch, true);
+      }
+      watch->failed = (watch->fileWd == -1) || (watch->dirWd == -1);
+      if (watch->failed)
+      {
+         // Most likely reason is reaching fs.inotify.max_user_watches limit
+         nxlog_debug_tag(DEBUG_TAG, 4, _T("Cannot add inotify watch for file \"%s\" (%s), file changes will be detected by polling"), path, _tcserror(errno));
+         stoppedDispatcher = DetachKernelWatch(watch, &stoppedThread);
+      }
+   }
+   else
+   {
+      watch->failed = true;
+   }
+   s_lock.unlock();
+
+   if (stoppedDispatcher != nullptr)
+      StopDispatcher(stoppedDispatcher, stoppedThread);
+
+   if (!watch->failed)
+      nxlog_debug_tag(DEBUG_TAG, 6, _T("inotify watch added for file \"%s\" (wd=%d/%d)"), path, watch->fileWd, watch->dirWd);
+   return watch;
+}
+
+/**
+ * Stop watching for file changes
+ */
+void RemoveFileChangeWatch(FileChangeWatch *watch)
+{
+   if (watch == nullptr)
+      return;
+
+   if (!watch->failed)
+      ReleaseKernelWatch(watch);
+   MemFree(watch->path);
+   MemFree(watch->name);
+   MemFree(watch);
+}
+
+/**
+ * Check if watch still corresponds to given file. Watch becomes invalid when file or its directory
+ * is deleted, or when file name now refers to different file (after rotation or name change).
+ */
+bool IsFileChangeWatchValid(FileChangeWatch *watch, const TCHAR *path, const NX_STAT_STRUCT *st)
+{
+   if (watch == nullptr)
+      return false;
+   if ((watch->device != st->st_dev) || (watch->inode != st->st_ino) || _tcscmp(watch->path, path))
+      return false;
+   if (watch->failed)
+      return true;   // Do not retry until file is replaced
+   s_lock.lock();
+   bool valid = (watch->fileWd != -1) && (watch->dirWd != -1);
+   s_lock.unlock();
+   return valid;
+}
+
+/**
+ * Check if change notifications are delivered for given watch. Directory watch alone is
+ * sufficient for detecting re-creation of deleted file.
+ */
+bool HasFileChangeNotifications(FileChangeWatch *watch)
+{
+   if ((watch == nullptr) || watch->failed)
+      return false;
+   s_lock.lock();
+   bool active = (watch->dirWd != -1);
+   s_lock.unlock();
+   return active;
+}
+
+#else /* HAVE_SYS_INOTIFY_H */
+
+/**
+ * Start watching for file changes (not supported on this platform)
+ */
+FileChangeWatch *AddFileChangeWatch(const TCHAR *path, const NX_STAT_STRUCT *st, Condition *wakeup)
+{
+   return nullptr;
+}
+
+/**
+ * Stop watching for file changes (not supported on this platform)
+ */
+void RemoveFileChangeWatch(FileChangeWatch *watch)
+{
+}
+
+/**
+ * Check if watch still corresponds to given file (not supported on this platform)
+ */
+bool IsFileChangeWatchValid(FileChangeWatch *watch, const TCHAR *path, const NX_STAT_STRUCT *st)
+{
+   return true;
+}
+
+/**
+ * Check if change notifications are delivered for given watch (not supported on this platform)
+ */
+bool HasFileChangeNotifications(FileChangeWatch *watch)
+{
+   return false;
+}
+
+#endif /* HAVE_SYS_INOTIFY_H */
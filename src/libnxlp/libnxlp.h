@@ -27,9 +27,78 @@
 #include <nms_common.h>
 #include <nms_util.h>
 #include <nxlpapi.h>
+#include <nxstat.h>
 
 #define DEBUG_TAG _T("logwatch")
 
+/**
+ * Maximum length of literal extracted for prefiltering
+ */
+#define MAX_LITERAL_LENGTH    256
+
+bool ExtractRequiredLiteral(const TCHAR *regexp, char *literal);
+
+/**
+ * Multi-pattern prefilter for parser rules. Literal substring required by each rule's regular
+ * expression is extracted once, and all literals are searched in a single pass over the line
+ * (Aho-Corasick automaton over lowercase ASCII). Rules whose literal is not present in the line
+ * cannot match and regular expression evaluation for them can be skipped.
+ */
+class LogParserPrefilter
+{
+private:
+   struct State
+   {
+      uint32_t fail;
+      uint32_t dictLink;
+      uint32_t edgeStart;
+      uint32_t edgeCount;
+      uint32_t outputStart;
+      uint32_t outputCount;
+   };
+
+   struct RuleInfo
+   {
+      uint32_t stamp;
+      bool filtered;
+      bool caseless;
+   };
+
+   std::vector<State> m_states;
+   std::vector<char> m_edgeChars;
+   std::vector<uint32_t> m_edgeTargets;
+   std::vector<int> m_outputs;
+   std::vector<RuleInfo> m_rules;
+   uint32_t m_rootTransitions[128];
+   uint32_t m_generation;
+   int m_filteredRules;
+   bool m_nonAscii;
+
+   uint32_t transition(uint32_t state, char ch) const;
+
+public:
+   LogParserPrefilter(const ObjectArray<LogParserRule>& rules);
+
+   void scan(const TCHAR *line);
+
+   /**
+    * Check if rule with given index can match last scanned line. Caseless rules are always checked
+    * for lines with non-ASCII characters because of Unicode case folding (like KELVIN SIGN to k).
+    */
+   bool isCandidate(int index) const
+   {
+      const RuleInfo& r = m_rules[index];
+      return !r.filtered || (r.stamp == m_generation) || (r.caseless && m_nonAscii);
+   }
+
+   int getFilteredRuleCount() const { return m_filteredRules; }
+};
+
+FileChangeWatch *AddFileChangeWatch(const TCHAR *path, const NX_STAT_STRUCT *st, Condition *wakeup);
+void RemoveFileChangeWatch(FileChangeWatch *watch);
+bool IsFileChangeWatchValid(FileChangeWatch *watch, const TCHAR *path, const NX_STAT_STRUCT *st);
+bool HasFileChangeNotifications(FileChangeWatch *watch);
+
 #ifdef _WIN32
 
 THREAD_RESULT THREAD_CALL ParserThreadEventLog(void *);
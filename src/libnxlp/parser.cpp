@@ -138,8 +138,10 @@ struct LogParser_XmlParserState
 /**
  * Parser default constructor
  */
-LogParser::LogParser() : m_rules(0, 16, Ownership::True), m_stopCondition(true)
+LogParser::LogParser() : m_rules(0, 16, Ownership::True), m_stopCondition(true), m_fileChangeCondition(false)
 {
+   m_prefilter = nullptr;
+   m_fileChangeWatch = nullptr;
 	m_cb = nullptr;
 	m_cbAction = nullptr;
 	m_cbDataPush = nullptr;
@@ -179,11 +181,13 @@ LogParser::LogParser() : m_rules(0, 16, Ownership::True), m_stopCondition(true)
 /**
  * Parser copy constructor
  */
-LogParser::LogParser(const LogParser *src) : m_rules(src->m_rules.size(), 16, Ownership::True), m_stopCondition(true)
+LogParser::LogParser(const LogParser *src) : m_rules(src->m_rules.size(), 16, Ownership::True), m_stopCondition(true), m_fileChangeCondition(false)
 {
    int count = src->m_rules.size();
 	for(int i = 0; i < count; i++)
 		m_rules.add(new LogParserRule(src->m_rules.get(i), this));
+   m_prefilter = nullptr;
+   m_fileChangeWatch = nullptr;
 
 	m_macros.addAll(&src->m_macros);
 	m_contexts.addAll(&src->m_contexts);
@@ -241,6 +245,7 @@ LogParser::LogParser(const LogParser *src) : m_rules(src->m_rules.size(), 16, Ow
  */
 LogParser::~LogParser()
 {
+   delete m_prefilter;
 	MemFree(m_name);
 	MemFree(m_fileName);
 #ifdef _WIN32
@@ -270,6 +275,7 @@ bool LogParser::addRule(LogParserRule *rule)
 	if (valid)
 	{
 	   m_rules.add(rule);
+	   delete_and_null(m_prefilter);  // Will be rebuilt on next match
 	}
 	else
 	{
@@ -326,6 +332,16 @@ bool LogParser::matchLogRecord(bool hasAttributes, const TCHAR *source, uint32_t
 		trace(6, _T("Match line: \"%s\""), line);
 
 	m_recordsProcessed++;
+
+	// Find rules which cannot match because required literal is missing in the line
+	if ((m_prefilter == nullptr) && !m_rules.isEmpty())
+	{
+	   m_prefilter = new LogParserPrefilter(m_rules);
+	   trace(6, _T("Prefilter built for %d rules (%d rules have required literal)"), m_rules.size(), m_prefilter->getFilteredRuleCount());
+	}
+	if (m_prefilter != nullptr)
+	   m_prefilter->scan(line);
+
 	int i;
 	for(i = 0; i < m_rules.size(); i++)
 	{
@@ -333,6 +349,13 @@ bool LogParser::matchLogRecord(bool hasAttributes, const TCHAR *source, uint32_t
 		trace(7, _T("checking rule %d \"%s\""), i + 1, rule->getDescription());
 		if ((state = checkContext(rule)) != nullptr)
 		{
+		   if (!m_prefilter->isCandidate(i))
+		   {
+		      rule->incCheckCount(objectId);
+		      trace(7, _T("  rule skipped by prefilter"));
+		      continue;
+		   }
+
 			bool ruleMatched = hasAttributes ?
 			   rule->matchEx(source, eventId, level, line, variables, namedVariables, recordId, objectId, timestamp, logName, m_cb, m_cbDataPush, m_cbAction, m_userData) :
 				rule->match(line, objectId, m_cb, m_cbDataPush, m_cbAction, logName, m_userData);
@@ -1250,6 +1273,7 @@ bool LogParser::isExclusionPeriod()
 void LogParser::stop()
 {
    m_stopCondition.set();
+   m_fileChangeCondition.set();
    ThreadJoin(m_thread);
    m_thread = INVALID_THREAD_HANDLE;
 }
@@ -0,0 +1,395 @@
+/*
+** NetXMS - Network Management System
+** Log Parsing Library
+** Copyright (C) 2003-2026 Raden Solutions
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation; either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: prefilter.cpp
+**
+**/
+
+#include "libnxlp.h"
+
+/**
+ * Minimal length of literal used for prefiltering. Shorter literals occur in most lines and
+ * do not reduce number of regular expression executions.
+ */
+#define MIN_LITERAL_LENGTH    3
+
+/**
+ * Check if character is ASCII character (plain char can be signed in non-UNICODE builds)
+ */
+#ifdef UNICODE
+#define IS_ASCII(c)  (static_cast<uint32_t>(c) < 128)
+#else
+#define IS_ASCII(c)  (static_cast<unsigned char>(c) < 128)
+#endif
+
+/**
+ * Skip character class starting at given position (pointer should point to opening bracket).
+ * Returns pointer to character after closing bracket or nullptr if class is not terminated.
+ */
+static const TCHAR *SkipCharacterClass(const TCHAR *p)
+{
+   p++;
+   if (*p == _T('^'))
+      p++;
+   if (*p == _T(']'))
+      p++;
+   while((*p != 0) && (*p != _T(']')))
+   {
+      if ((*p == _T('\\')) && (p[1] != 0))
+      {
+         p++;
+      }
+      else if ((*p == _T('[')) && (p[1] == _T(':')))
+      {
+         const TCHAR *e = _tcsstr(p + 2, _T(":]"));
+         if (e == nullptr)
+            return nullptr;
+         p = e + 1;
+      }
+      p++;
+   }
+   return (*p == _T(']')) ? p + 1 : nullptr;
+}
+
+/**
+ * Parse counted quantifier ({n}, {n,} or {n,m}) starting at given position. Returns pointer
+ * to character after closing brace and minimal repeat count in minCount, or nullptr if
+ * brace does not start valid quantifier (and so should be treated as literal by PCRE).
+ */
+static const TCHAR *ParseCountedQuantifier(const TCHAR *p, int *minCount)
+{
+   p++;
+   if (!_istdigit(*p))
+      return nullptr;
+   int n = 0;
+   while(_istdigit(*p))
+   {
+      n = n * 10 + (*p - _T('0'));
+      p++;
+   }
+   if (*p == _T(','))
+   {
+      p++;
+      while(_istdigit(*p))
+         p++;
+   }
+   if (*p != _T('}'))
+      return nullptr;
+   *minCount = n;
+   return p + 1;
+}
+
+/**
+ * Extract longest literal substring which must be present (ignoring case) in any string matched
+ * by given regular expression. Only ASCII characters are included into literal. Literal buffer
+ * should be at least MAX_LITERAL_LENGTH + 1 bytes long. Returns false if expression uses constructs
+ * which cannot be analyzed safely (top level alternation, inline options, quoting, back references,
+ * etc.) or if extracted literal is too short to be useful.
+ */
+bool ExtractRequiredLiteral(const TCHAR *regexp, char *literal)
+{
+   char run[MAX_LITERAL_LENGTH];
+   size_t runLen = 0, bestLen = 0;
+   bool lastIsLiteral = false;   // true if last atom is literal character at the end of current run
+
+   auto endRun = [&] () -> void
+   {
+      if (runLen > bestLen)
+      {
+         memcpy(literal, run, runLen);
+         bestLen = runLen;
+      }
+      runLen = 0;
+      lastIsLiteral = false;
+   };
+
+   const TCHAR *p = regexp;
+   while(*p != 0)
+   {
+      TCHAR ch = *p;
+      switch(ch)
+      {
+         case _T('\\'):
+            p++;
+            ch = *p;
+            if (ch == 0)
+               return false;
+            if (IS_ASCII(ch) && _istalnum(ch))
+            {
+               if (ch == _T('t'))
+                  ch = _T('\t');
+               else if (ch == _T('n'))
+                  ch = _T('\n');
+               else if (ch == _T('r'))
+                  ch = _T('\r');
+               else if (_tcschr(_T("dDwWsSbBAzZGhHvVRXNK"), ch) != nullptr)
+                  ch = 0;  // Not a literal character
+               else
+                  return false;  // \x, \p, \Q, back references, etc.
+            }
+            break;
+         case _T('['):
+            p = SkipCharacterClass(p);
+            if (p == nullptr)
+               return false;
+            endRun();
+            continue;
+         case _T('('):
+            if (p[1] == _T('*'))
+               return false;  // Start of pattern options like (*UCP)
+            if ((p[1] == _T('?')) && ((p[2] == _T('-')) || (p[2] == _T('^')) || (IS_ASCII(p[2]) && _istalpha(p[2]) && (p[2] != _T('P')))))
+               return false;  // Inline options like (?i) or (?x)
+            {
+               int depth = 1;
+               p++;
+               while((*p != 0) && (depth > 0))
+               {
+                  if (*p == _T('\\'))
+                  {
+                     p++;
+                     if (*p != 0)
+                        p++;
+                     continue;
+                  }
+                  if (*p == _T('['))
+                  {
+                     p = SkipCharacterClass(p);
+                     if (p == nullptr)
+                        return false;
+                     continue;
+                  }
+                  if (*p == _T('('))
+                     depth++;
+                  else if (*p == _T(')'))
+                     depth--;
+                  p++;
+               }
+               if (depth > 0)
+                  return false;
+            }
+            endRun();
+            continue;
+         case _T(')'):
+         case _T('|'):
+            return false;
+         case _T('.'):
+         case _T('^'):
+         case _T('$'):
+            ch = 0;
+            break;
+         case _T('*'):
+         case _T('?'):
+         case _T('+'):
+         case _T('{'):
+            {
+               int minCount = (ch == _T('+')) ? 1 : 0;
+               if (ch == _T('{'))
+               {
+                  const TCHAR *next = ParseCountedQuantifier(p, &minCount);
+                  if (next == nullptr)
+                  {
+                     // Not a quantifier - PCRE treats brace as literal, but it is safe to just end current run
+                     endRun();
+                     p++;
+                     continue;
+                  }
+                  p = next;
+               }
+               else
+               {
+                  p++;
+               }
+               if ((minCount == 0) && lastIsLiteral)
+                  runLen--;   // Quantified character is optional
+               endRun();
+               if ((*p == _T('?')) || (*p == _T('+')))
+                  p++;  // Lazy or possessive quantifier
+            }
+            continue;
+         default:
+            break;
+      }
+
+      if ((ch == 0) || !IS_ASCII(ch))
+      {
+         endRun();
+      }
+      else
+      {
+         if (runLen == MAX_LITERAL_LENGTH)
+            endRun();
+         run[runLen++] = static_cast<char>(tolower(static_cast<int>(ch)));   // ch is ASCII here
+         lastIsLiteral = true;
+      }
+      p++;
+   }
+   endRun();
+
+   literal[bestLen] = 0;
+   return bestLen >= MIN_LITERAL_LENGTH;
+}
+
+/**
+ * Build prefilter for given rule set
+ */
+LogParserPrefilter::LogParserPrefilter(const ObjectArray<LogParserRule>& rules) : m_rules(rules.size())
+{
+   m_generation = 0;
+   m_nonAscii = false;
+   m_filteredRules = 0;
+
+   // Trie construction
+   std::vector<std::vector<std::pair<char, uint32_t>>> children(1);
+   std::vector<std::vector<int>> outputs(1);
+   for(int i = 0; i < rules.size(); i++)
+   {
+      LogParserRule *rule = rules.get(i);
+      RuleInfo& info = m_rules[i];
+      info.stamp = 0;
+      info.caseless = rule->isIgnoreCase();
+
+      // Inverted rules match when pattern is not found, so they cannot be filtered out by literal presence
+      char literal[MAX_LITERAL_LENGTH + 1];
+      info.filtered = !rule->isInverted() && ExtractRequiredLiteral(rule->getRegexpSource(), literal);
+      if (!info.filtered)
+         continue;
+
+      m_filteredRules++;
+      uint32_t state = 0;
+      for(const char *c = literal; *c != 0; c++)
+      {
+         uint32_t next = 0;
+         for(auto& e : children[state])
+         {
+            if (e.first == *c)
+            {
+               next = e.second;
+               break;
+            }
+         }
+         if (next == 0)
+         {
+            next = static_cast<uint32_t>(children.size());
+            children[state].emplace_back(*c, next);
+            children.emplace_back();
+            outputs.emplace_back();
+         }
+         state = next;
+      }
+      outputs[state].push_back(i);
+   }
+
+   // Flatten trie into state table
+   m_states.resize(children.size());
+   memset(m_rootTransitions, 0, sizeof(m_rootTransitions));
+   for(size_t s = 0; s < children.size(); s++)
+   {
+      State& state = m_states[s];
+      state.fail = 0;
+      state.dictLink = 0;
+      state.edgeStart = static_cast<uint32_t>(m_edgeChars.size());
+      state.edgeCount = static_cast<uint32_t>(children[s].size());
+      for(auto& e : children[s])
+      {
+         m_edgeChars.push_back(e.first);
+         m_edgeTargets.push_back(e.second);
+      }
+      state.outputStart = static_cast<uint32_t>(m_outputs.size());
+      state.outputCount = static_cast<uint32_t>(outputs[s].size());
+      m_outputs.insert(m_outputs.end(), outputs[s].begin(), outputs[s].end());
+   }
+   for(auto& e : children[0])
+      m_rootTransitions[static_cast<unsigned char>(e.first)] = e.second;
+
+   // Calculate failure and dictionary suffix links in breadth-first order
+   std::vector<uint32_t> queue;
+   queue.reserve(m_states.size());
+   for(auto& e : children[0])
+      queue.push_back(e.second);
+   for(size_t q = 0; q < queue.size(); q++)
+   {
+      uint32_t u = queue[q];
+      for(auto& e : children[u])
+      {
+         uint32_t v = e.second;
+         uint32_t f = m_states[u].fail;
+         uint32_t target;
+         while(((target = transition(f, e.first)) == 0) && (f != 0))
+            f = m_states[f].fail;
+         m_states[v].fail = (target != v) ? target : 0;
+         const State& fs = m_states[m_states[v].fail];
+         m_states[v].dictLink = (fs.outputCount > 0) ? m_states[v].fail : fs.dictLink;
+         queue.push_back(v);
+      }
+   }
+}
+
+/**
+ * Get transition from given state by given character (0 if there is no transition)
+ */
+inline uint32_t LogParserPrefilter::transition(uint32_t state, char ch) const
+{
+   if (state == 0)
+      return m_rootTransitions[static_cast<unsigned char>(ch)];
+   const State& s = m_states[state];
+   const char *chars = m_edgeChars.data() + s.edgeStart;   // edgeStart can be equal to m_edgeChars.size() for leaf states
+   for(uint32_t i = 0; i < s.edgeCount; i++)
+      if (chars[i] == ch)
+         return m_edgeTargets[s.edgeStart + i];
+   return 0;
+}
+
+/**
+ * Scan line and mark rules whose literals occur in it
+ */
+void LogParserPrefilter::scan(const TCHAR *line)
+{
+   if (++m_generation == 0)
+   {
+      // Generation counter wrapped around - reset stamps
+      for(RuleInfo& r : m_rules)
+         r.stamp = 0;
+      m_generation = 1;
+   }
+   m_nonAscii = false;
+
+   uint32_t state = 0;
+   for(const TCHAR *p = line; *p != 0; p++)
+   {
+      if (!IS_ASCII(*p))
+      {
+         m_nonAscii = true;
+         state = 0;
+         continue;
+      }
+
+      char ch = static_cast<char>(tolower(static_cast<int>(*p)));
+      uint32_t next;
+      while(((next = transition(state, ch)) == 0) && (state != 0))
+         state = m_states[state].fail;
+      state = next;
+
+      for(uint32_t s = (m_states[state].outputCount > 0) ? state : m_states[state].dictLink; s != 0; s = m_states[s].dictLink)
+      {
+         const State& o = m_states[s];
+         for(uint32_t i = 0; i < o.outputCount; i++)
+            m_rules[m_outputs[o.outputStart + i]].stamp = m_generation;
+      }
+   }
+}
@@ -56,6 +56,7 @@ void NXSL_Instruction::copyFrom(const NXSL_Instruction *src, NXSL_ValueManager *
          break;
    }
    m_addr2 = src->m_addr2;
+   m_slot = INVALID_VARIABLE_SLOT;  // Slots are specific to VM and assigned by NXSL_VM::assignVariableSlots
 }
 
 /**
@@ -161,6 +161,11 @@ typedef void *yyscan_t;
 #define OPCODE_CONCAT_VAR     116
 #define OPCODE_CONCAT_VARPTR  117
 
+/**
+ * Invalid variable slot index
+ */
+#define INVALID_VARIABLE_SLOT 0xFFFFFFFF
+
 class NXSL_Compiler;
 
 /**
@@ -220,6 +225,7 @@ struct NXSL_Instruction
       uint64_t m_valueUInt64;
    } m_operand;
    int32_t m_sourceLine;
+   uint32_t m_slot;    // Variable slot index, assigned when code is loaded into VM
 
    OperandType getOperandType() const;
    void copyFrom(const NXSL_Instruction *src, NXSL_ValueManager *vm);
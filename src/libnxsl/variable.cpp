@@ -88,6 +88,7 @@ NXSL_VariableSystem::NXSL_VariableSystem(NXSL_VM *vm, NXSL_VariableSystemType ty
    m_variables = nullptr;
 	m_type = type;
 	m_restorePointCount = 0;
+   m_frameId = vm->createFrameId();
 }
 
 /**
@@ -98,6 +99,7 @@ NXSL_VariableSystem::NXSL_VariableSystem(NXSL_VM *vm, const NXSL_VariableSystem
    m_variables = nullptr;
    m_type = src->m_type;
    m_restorePointCount = 0;
+   m_frameId = vm->createFrameId();
 
    NXSL_VariablePtr *var, *tmp;
    HASH_ITER(hh, src->m_variables, var, tmp)
@@ -127,6 +129,7 @@ void NXSL_VariableSystem::clear()
       HASH_DEL(m_variables, var);
       var->v.~NXSL_Variable();
    }
+   m_frameId = m_vm->createFrameId();   // Invalidate variables cached in VM slot table
 }
 
 /**
@@ -202,6 +205,7 @@ void NXSL_VariableSystem::remove(const NXSL_Identifier& name)
    {
       HASH_DEL(m_variables, var);
       var->v.~NXSL_Variable();
+      m_frameId = m_vm->createFrameId();   // Invalidate variables cached in VM slot table
    }
 }
 
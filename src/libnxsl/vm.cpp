@@ -217,6 +217,9 @@ uint32_t NXSL_SecurityContext::getUserId() const
 NXSL_VM::NXSL_VM(NXSL_Environment *env, NXSL_Storage *storage) : NXSL_ValueManager(), m_objectClassData(64), m_objects(64),
          m_instructionSet(256, 256), m_stopCondition(true), m_functions(0, 16), m_modules(0, 16, Ownership::True)
 {
+   m_variableSlots = nullptr;
+   m_variableSlotCount = 0;
+   m_frameIdSequence = 0;
    m_cp = INVALID_ADDRESS;
    m_stopFlag = false;
    m_instructionTraceFile = nullptr;
@@ -266,6 +269,7 @@ NXSL_VM::~NXSL_VM()
 
    for(int i = 0; i < m_instructionSet.size(); i++)
       m_instructionSet.get(i)->dispose(this);
+   MemFree(m_variableSlots);
 
    delete m_constants;
    delete m_globalVariables;
@@ -377,9 +381,198 @@ bool NXSL_VM::load(const NXSL_Program *program)
       }
    }
 
+   assignVariableSlots();
    return success;
 }
 
+/**
+ * Check if given instruction accesses variable by name and can use variable slot
+ */
+static inline bool IsSlotVariableInstruction(const NXSL_Instruction *instr)
+{
+   switch(instr->m_opCode)
+   {
+      case OPCODE_CONCAT_VAR:
+      case OPCODE_DEC:
+      case OPCODE_DECP:
+      case OPCODE_INC:
+      case OPCODE_INCP:
+      case OPCODE_LOCAL:
+      case OPCODE_PUSH_VARIABLE:
+      case OPCODE_SET:
+         return true;
+      default:
+         return false;
+   }
+}
+
+/**
+ * Mark all instructions reachable from function entry point as owned by given function. Calls to
+ * other functions are not followed, while frameless subroutines (expression variable code blocks),
+ * catch handlers and selector targets are, because they are executed within caller's frame.
+ */
+static void MarkFunctionCode(const StructArray<NXSL_Instruction>& code, uint32_t entry, int function, int *owners)
+{
+   uint32_t size = static_cast<uint32_t>(code.size());
+   IntegerArray<uint32_t> pending(64, 64);
+   pending.add(entry);
+   while(!pending.isEmpty())
+   {
+      uint32_t addr = pending.get(pending.size() - 1);
+      pending.remove(pending.size() - 1);
+      while((addr < size) && (owners[addr] == -1))
+      {
+         owners[addr] = function;
+         const NXSL_Instruction *instr = code.get(addr);
+         switch(instr->m_opCode)
+         {
+            case OPCODE_JMP:
+               addr = instr->m_operand.m_addr;
+               continue;
+            case OPCODE_JZ:
+            case OPCODE_JNZ:
+            case OPCODE_JZ_PEEK:
+            case OPCODE_JNZ_PEEK:
+            case OPCODE_CATCH:
+               pending.add(instr->m_operand.m_addr);
+               break;
+            case OPCODE_PUSH_EXPRVAR:
+            case OPCODE_UPDATE_EXPRVAR:
+               pending.add(instr->m_addr2);
+               pending.add(addr + 2);  // next instruction is skipped if expression variable already calculated
+               break;
+            case OPCODE_PUSHCP:
+               pending.add(addr + instr->m_stackItems);
+               break;
+            case OPCODE_RETURN:
+            case OPCODE_RET_NULL:
+            case OPCODE_EXIT:
+            case OPCODE_ABORT:
+               addr = size;
+               continue;
+            default:
+               break;
+         }
+         addr++;
+      }
+   }
+}
+
+/**
+ * Assign slot indexes to variable access instructions of loaded program and modules. Each function
+ * gets its own range in VM slot table sized by number of distinct identifiers referenced within
+ * function's code (including frameless subroutines called from it). All references to same identifier
+ * within function share one slot, so variable resolved once within call frame can be accessed by index
+ * instead of name lookup. Identifiers which are environment constants do not get slots because
+ * instruction OPCODE_PUSH_VARIABLE should resolve them to constant value. Instructions not reachable
+ * from any known function entry point also do not get slots and use name lookup.
+ */
+void NXSL_VM::assignVariableSlots()
+{
+   int codeSize = m_instructionSet.size();
+   int *owners = MemAllocArrayNoInit<int>(codeSize);
+   for(int i = 0; i < codeSize; i++)
+   {
+      m_instructionSet.get(i)->m_slot = INVALID_VARIABLE_SLOT;
+      owners[i] = -1;
+   }
+
+   int functionCount = 0;
+   for(int i = 0; i < m_functions.size(); i++)
+   {
+      uint32_t addr = m_functions.get(i)->m_addr;
+      if ((addr < static_cast<uint32_t>(codeSize)) && (owners[addr] == -1))
+         MarkFunctionCode(m_instructionSet, addr, functionCount++, owners);
+   }
+
+   // Group slot candidates by owning function (keeping address order within function)
+   int *groupStart = MemAllocArray<int>(functionCount + 1);
+   for(int i = 0; i < codeSize; i++)
+   {
+      if ((owners[i] != -1) && IsSlotVariableInstruction(m_instructionSet.get(i)))
+         groupStart[owners[i] + 1]++;
+   }
+   for(int i = 0; i < functionCount; i++)
+      groupStart[i + 1] += groupStart[i];
+   int *grouped = MemAllocArrayNoInit<int>(std::max(groupStart[functionCount], 1));
+   int *groupFill = MemAllocArrayNoInit<int>(std::max(functionCount, 1));
+   memcpy(groupFill, groupStart, sizeof(int) * functionCount);
+   for(int i = 0; i < codeSize; i++)
+   {
+      if ((owners[i] != -1) && IsSlotVariableInstruction(m_instructionSet.get(i)))
+         grouped[groupFill[owners[i]]++] = i;
+   }
+
+   m_variableSlotCount = 0;
+   HashMap<NXSL_Identifier, NXSL_Instruction> firstReferences(Ownership::False);
+   for(int f = 0; f < functionCount; f++)
+   {
+      firstReferences.clear();
+      for(int i = groupStart[f]; i < groupStart[f + 1]; i++)
+      {
+         NXSL_Instruction *instr = m_instructionSet.get(grouped[i]);
+         NXSL_Instruction *first = firstReferences.get(*instr->m_operand.m_identifier);
+         if (first != nullptr)
+         {
+            instr->m_slot = first->m_slot;
+            continue;
+         }
+
+         NXSL_Value *constant = m_env->getConstantValue(*instr->m_operand.m_identifier, this);
+         if (constant != nullptr)
+            destroyValue(constant);
+         else
+            instr->m_slot = m_variableSlotCount++;
+         firstReferences.set(*instr->m_operand.m_identifier, instr);
+      }
+   }
+
+   MemFree(groupFill);
+   MemFree(grouped);
+   MemFree(groupStart);
+   MemFree(owners);
+
+   // Slot table is allocated once and shared by all call frames - cached variable is only valid for
+   // frame with same frame ID, so new frames do not require table initialization
+   MemFree(m_variableSlots);
+   m_variableSlots = (m_variableSlotCount > 0) ? MemAllocArray<NXSL_VariableSlot>(m_variableSlotCount) : nullptr;
+}
+
+/**
+ * Reset VM to the state it had right after loading program, so it can be reused for another
+ * execution of same program. Loaded code, functions, constants, and modules are preserved;
+ * global variables, context object, security context, storage binding, user data, and
+ * last execution result and error are cleared.
+ */
+void NXSL_VM::reset()
+{
+   // Variable system memory is only released on destruction, so replace it instead of clearing
+   delete m_globalVariables;
+   m_globalVariables = new NXSL_VariableSystem(this, NXSL_VariableSystemType::GLOBAL);
+   setContextObject(nullptr);
+   delete_and_null(m_securityContext);
+
+   if (m_localStorage != nullptr)
+      static_cast<NXSL_LocalStorage*>(m_localStorage)->clear();
+   setStorage(nullptr);
+
+   m_userData = nullptr;
+   m_exportedExpressionVariables = nullptr;
+
+   destroyValue(m_pRetValue);
+   m_pRetValue = nullptr;
+   m_errorCode = 0;
+   m_errorLine = 0;
+   m_errorModule = nullptr;
+   MemFree(m_errorText);
+   m_errorText = nullptr;
+   MemFree(m_assertMessage);
+   m_assertMessage = nullptr;
+
+   m_stopFlag = false;
+   m_stopCondition.reset();
+}
+
 /**
  * Run program
  * Returns true on success and false on error
@@ -699,6 +892,37 @@ NXSL_Variable *NXSL_VM::findOrCreateVariable(const NXSL_Identifier& name, NXSL_V
    return var;
 }
 
+/**
+ * Find variable referenced by given instruction or create new local variable if it does not exist.
+ * Local variables and constants are cached in current call frame by instruction's slot index, so
+ * subsequent accesses within same frame do not require name lookup. For variables located in other
+ * variable systems (and for instructions without slot) variable system is returned in "vs" so caller
+ * can convert instruction to direct variable access; otherwise "vs" is set to nullptr.
+ */
+NXSL_Variable *NXSL_VM::findOrCreateSlotVariable(const NXSL_Instruction *instruction, NXSL_VariableSystem **vs)
+{
+   if (instruction->m_slot == INVALID_VARIABLE_SLOT)
+      return findOrCreateVariable(*instruction->m_operand.m_identifier, vs);
+
+   NXSL_VariableSlot *slot = &m_variableSlots[instruction->m_slot];
+   if (slot->frameId == m_localVariables->getFrameId())
+   {
+      *vs = nullptr;
+      return slot->variable;
+   }
+
+   // Local variables and constants cannot be shadowed by variables created later,
+   // so they can be safely cached until function returns
+   NXSL_Variable *var = findOrCreateVariable(*instruction->m_operand.m_identifier, vs);
+   if (((*vs)->getType() == NXSL_VariableSystemType::LOCAL) || ((*vs)->getType() == NXSL_VariableSystemType::CONSTANT))
+   {
+      slot->variable = var;
+      slot->frameId = m_localVariables->getFrameId();
+      *vs = nullptr;
+   }
+   return var;
+}
+
 /**
  * Implementation of in-place string append to variable (OPCODE_CONCAT_VAR).
  * Pops right-hand-side value from the data stack and appends its string form
@@ -842,17 +1066,18 @@ void NXSL_VM::execute()
          m_dataStack.push(createValue(cp->m_operand.m_valueUInt64));
          break;
       case OPCODE_PUSH_VARIABLE:
-         pValue = m_env->getConstantValue(*cp->m_operand.m_identifier, this);
+         // Slots are not assigned to identifiers which are environment constants
+         pValue = (cp->m_slot == INVALID_VARIABLE_SLOT) ? m_env->getConstantValue(*cp->m_operand.m_identifier, this) : nullptr;
          if (pValue != nullptr)
          {
             m_dataStack.push(pValue);
          }
          else
          {
-            pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs);
+            pVar = findOrCreateSlotVariable(cp, &vs);
             m_dataStack.push(createValueRef(pVar->getValue()));
             // convert to direct variable access without name lookup
-            if (vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
+            if ((vs != nullptr) && vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
             {
                cp->m_opCode = OPCODE_PUSH_VARPTR;
                cp->m_operand.m_variable = pVar;
@@ -982,7 +1207,7 @@ void NXSL_VM::execute()
          m_dataStack.push(createValue(new NXSL_HashMap(this)));
          break;
       case OPCODE_SET:
-         pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs);
+         pVar = findOrCreateSlotVariable(cp, &vs);
 			if (!pVar->isConstant())
 			{
 	         pValue = (cp->m_stackItems == 0) ? m_dataStack.peek() : m_dataStack.pop();
@@ -990,7 +1215,7 @@ void NXSL_VM::execute()
 				{
 					pVar->setValue((cp->m_stackItems == 0) ? createValueRef(pValue) : pValue);
                // convert to direct variable access without name lookup
-		         if (vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
+		         if ((vs != nullptr) && vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
 		         {
                   cp->m_opCode = OPCODE_SET_VARPTR;
                   cp->m_operand.m_variable = pVar;
@@ -1040,7 +1265,7 @@ void NXSL_VM::execute()
          }
          break;
       case OPCODE_CONCAT_VAR:
-         pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs);
+         pVar = findOrCreateSlotVariable(cp, &vs);
          if (!pVar->isConstant())
          {
             if (doConcatAssign(pVar))
@@ -1051,7 +1276,7 @@ void NXSL_VM::execute()
                if (cp->m_stackItems == 0)
                   m_dataStack.push(createValueRef(pVar->getValue()));
                // Convert to direct variable access without name lookup
-               if (vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
+               if ((vs != nullptr) && vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
                {
                   cp->m_opCode = OPCODE_CONCAT_VARPTR;
                   cp->m_operand.m_variable = pVar;
@@ -1168,7 +1393,7 @@ void NXSL_VM::execute()
                pValue = m_dataStack.pop();
                if (pValue != nullptr)
                {
-                  m_localVariables->create(*cp->m_operand.m_identifier, pValue);
+                  pVar = m_localVariables->create(*cp->m_operand.m_identifier, pValue);
                }
                else
                {
@@ -1177,7 +1402,14 @@ void NXSL_VM::execute()
             }
             else
             {
-               m_localVariables->create(*cp->m_operand.m_identifier, createValue());
+               pVar = m_localVariables->create(*cp->m_operand.m_identifier, createValue());
+            }
+
+            // Cache new variable so that following references will not need name lookup
+            if ((pVar != nullptr) && (cp->m_slot != INVALID_VARIABLE_SLOT))
+            {
+               m_variableSlots[cp->m_slot].variable = pVar;
+               m_variableSlots[cp->m_slot].frameId = m_localVariables->getFrameId();
             }
          }
          else if (cp->m_stackItems > 0)   // process initialization block as assignment
@@ -1826,7 +2058,7 @@ void NXSL_VM::execute()
          break;
       case OPCODE_INC:  // Post increment/decrement
       case OPCODE_DEC:
-         pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs);
+         pVar = findOrCreateSlotVariable(cp, &vs);
          if (!pVar->isConstant())
          {
             pValue = pVar->getValue();
@@ -1840,7 +2072,7 @@ void NXSL_VM::execute()
                   pValue->decrement();
 
                // Convert to direct variable access
-               if (vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
+               if ((vs != nullptr) && vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
                {
                   cp->m_opCode = (cp->m_opCode == OPCODE_INC) ? OPCODE_INC_VARPTR : OPCODE_DEC_VARPTR;
                   cp->m_operand.m_variable = pVar;
@@ -1876,7 +2108,7 @@ void NXSL_VM::execute()
          break;
       case OPCODE_INCP: // Pre increment/decrement
       case OPCODE_DECP:
-         pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs);
+         pVar = findOrCreateSlotVariable(cp, &vs);
          if (!pVar->isConstant())
          {
             pValue = pVar->getValue();
@@ -1890,7 +2122,7 @@ void NXSL_VM::execute()
                m_dataStack.push(createValueRef(pValue));
 
                // Convert to direct variable access
-               if (vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
+               if ((vs != nullptr) && vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
                {
                   cp->m_opCode = (cp->m_opCode == OPCODE_INCP) ? OPCODE_INCP_VARPTR : OPCODE_DECP_VARPTR;
                   cp->m_operand.m_variable = pVar;
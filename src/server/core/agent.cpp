@@ -926,6 +926,99 @@ uint32_t AgentConnectionEx::processCollectedData(NXCPMessage *msg)
    return success ? ERR_SUCCESS : ERR_INTERNAL_ERROR;
 }
 
+/**
+ * Process single element of bulk or batched data message. Returns element status (one of BULK_DATA_REC_xxx).
+ */
+BYTE AgentConnectionEx::processCollectedDataElement(NXCPMessage *request, uint32_t fieldId, const shared_ptr<DataCollectionTarget>& defaultTarget, int index)
+{
+   int origin = request->getFieldAsInt16(fieldId + 1);
+   if ((origin != DS_NATIVE_AGENT) && (origin != DS_SNMP_AGENT) && (origin != DS_MODBUS))
+   {
+      debugPrintf(5, _T("AgentConnectionEx::processCollectedDataElement: unsupported data source type %d (element %d)"), origin, index);
+      return BULK_DATA_REC_FAILURE;
+   }
+
+   shared_ptr<DataCollectionTarget> target;
+   uuid targetId = request->getFieldAsGUID(fieldId + 3);
+   if (!targetId.isNull())
+   {
+      shared_ptr<NetObj> object = FindObjectByGUID(targetId, -1);
+      if (object == nullptr)
+      {
+         wchar_t buffer[64];
+         debugPrintf(5, _T("AgentConnectionEx::processCollectedDataElement: cannot find target object with GUID %s (element %d)"),
+                     targetId.toString(buffer), index);
+         return BULK_DATA_REC_FAILURE;
+      }
+      if (!object->isDataCollectionTarget())
+      {
+         wchar_t buffer[64];
+         debugPrintf(5, _T("AgentConnectionEx::processCollectedDataElement: object with GUID %s (element %d) is not a data collection target"),
+                     targetId.toString(buffer), index);
+         return BULK_DATA_REC_FAILURE;
+      }
+      target = static_pointer_cast<DataCollectionTarget>(object);
+   }
+   else
+   {
+      target = defaultTarget;
+   }
+
+   uint32_t dciId = request->getFieldAsUInt32(fieldId);
+   shared_ptr<DCObject> dcObject = target->getDCObjectById(dciId, 0);
+   if (dcObject == nullptr)
+   {
+      debugPrintf(5, _T("AgentConnectionEx::processCollectedDataElement: cannot find DCI with ID %u on object %s [%u] (element %d)"),
+                  dciId, target->getName(), target->getId(), index);
+      return BULK_DATA_REC_FAILURE;
+   }
+
+   int type = request->getFieldAsInt16(fieldId + 2);
+   if ((type != DCO_TYPE_ITEM) || (dcObject->getType() != type) || (dcObject->getDataSource() != origin) || (dcObject->getAgentCacheMode() != AGENT_CACHE_ON))
+   {
+      debugPrintf(5, _T("AgentConnectionEx::processCollectedDataElement: DCI %s [%u] on object %s [%u] configuration mismatch (element %d)"),
+                  dcObject->getName().cstr(), dciId, target->getName(), target->getId(), index);
+      return BULK_DATA_REC_FAILURE;
+   }
+
+   wchar_t *value = request->getFieldAsString(fieldId + 5);
+   uint32_t statusCode = request->getFieldAsUInt32(fieldId + 6);
+   debugPrintf(7, _T("AgentConnectionEx::processCollectedDataElement: processing DCI %s [%u] (type=%d) (status=%d) on object %s [%u] (element %d)"),
+               dcObject->getName().cstr(), dciId, type, statusCode, target->getName(), target->getId(), index);
+   Timestamp t = request->getFieldAsTimestamp(fieldId + 7);
+   if (t.isNull())
+      t = Timestamp::fromTime(request->getFieldAsTime(fieldId + 4));
+   bool success = true;
+
+   switch(statusCode)
+   {
+      case ERR_SUCCESS:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         success = target->processNewDCValue(dcObject, t, value, shared_ptr<Table>(), false);
+         if (t > dcObject->getLastPollTime())
+            dcObject->setLastPollTime(t);
+         break;
+      case ERR_UNKNOWN_METRIC:
+      case ERR_UNSUPPORTED_METRIC:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         dcObject->processNewError(false, t);
+         break;
+      case ERR_NO_SUCH_INSTANCE:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         dcObject->processNewError(true, t);
+         break;
+      case ERR_INTERNAL_ERROR:
+         dcObject->processNewError(true, t);
+         break;
+   }
+
+   MemFree(value);
+   return success ? BULK_DATA_REC_SUCCESS : BULK_DATA_REC_FAILURE;
+}
+
 /**
  * Process collected data information in bulk mode (for DCI with agent-side cache)
  */
@@ -963,7 +1056,6 @@ uint32_t AgentConnectionEx::processBulkCollectedData(NXCPMessage *request, NXCPM
    // Use half timeout for sending progress updates
    uint32_t agentTimeout = request->getFieldAsUInt32(VID_TIMEOUT) / 2;
 
-   shared_ptr<Table> tableValue;
    BYTE status[MAX_BULK_DATA_BLOCK_SIZE];
    memset(status, 0, MAX_BULK_DATA_BLOCK_SIZE);
    uint32_t fieldId = VID_ELEMENT_LIST_BASE;
@@ -986,97 +1078,7 @@ uint32_t AgentConnectionEx::processBulkCollectedData(NXCPMessage *request, NXCPM
          continue;
       }
 
-      int origin = request->getFieldAsInt16(fieldId + 1);
-      if ((origin != DS_NATIVE_AGENT) && (origin != DS_SNMP_AGENT) && (origin != DS_MODBUS))
-      {
-         debugPrintf(5, _T("AgentConnectionEx::processBulkCollectedData: unsupported data source type %d (element %d)"), origin, i);
-         status[i] = BULK_DATA_REC_FAILURE;
-         continue;
-      }
-
-      shared_ptr<DataCollectionTarget> target;
-      uuid targetId = request->getFieldAsGUID(fieldId + 3);
-      if (!targetId.isNull())
-      {
-         shared_ptr<NetObj> object = FindObjectByGUID(targetId, -1);
-         if (object == nullptr)
-         {
-            wchar_t buffer[64];
-            debugPrintf(5, _T("AgentConnectionEx::processBulkCollectedData: cannot find target object with GUID %s (element %d)"),
-                        targetId.toString(buffer), i);
-            status[i] = BULK_DATA_REC_FAILURE;
-            continue;
-         }
-         if (!object->isDataCollectionTarget())
-         {
-            wchar_t buffer[64];
-            debugPrintf(5, _T("AgentConnectionEx::processBulkCollectedData: object with GUID %s (element %d) is not a data collection target"),
-                        targetId.toString(buffer), i);
-            status[i] = BULK_DATA_REC_FAILURE;
-            continue;
-         }
-         target = static_pointer_cast<DataCollectionTarget>(object);
-      }
-      else
-      {
-         target = node;
-      }
-
-      uint32_t dciId = request->getFieldAsUInt32(fieldId);
-      shared_ptr<DCObject> dcObject = target->getDCObjectById(dciId, 0);
-      if (dcObject == nullptr)
-      {
-         debugPrintf(5, _T("AgentConnectionEx::processBulkCollectedData: cannot find DCI with ID %u on object %s [%u] (element %d)"),
-                     dciId, target->getName(), target->getId(), i);
-         status[i] = BULK_DATA_REC_FAILURE;
-         continue;
-      }
-
-      int type = request->getFieldAsInt16(fieldId + 2);
-      if ((type != DCO_TYPE_ITEM) || (dcObject->getType() != type) || (dcObject->getDataSource() != origin) || (dcObject->getAgentCacheMode() != AGENT_CACHE_ON))
-      {
-         debugPrintf(5, _T("AgentConnectionEx::processBulkCollectedData: DCI %s [%u] on object %s [%u] configuration mismatch (element %d)"),
-                     dcObject->getName().cstr(), dciId, target->getName(), target->getId(), i);
-         status[i] = BULK_DATA_REC_FAILURE;
-         continue;
-      }
-
-      wchar_t *value = request->getFieldAsString(fieldId + 5);
-      uint32_t statusCode = request->getFieldAsUInt32(fieldId + 6);
-      debugPrintf(7, _T("AgentConnectionEx::processBulkCollectedData: processing DCI %s [%u] (type=%d) (status=%d) on object %s [%u] (element %d)"),
-                  dcObject->getName().cstr(), dciId, type, statusCode, target->getName(), target->getId(), i);
-      Timestamp t = request->getFieldAsTimestamp(fieldId + 7);
-      if (t.isNull())
-         t = Timestamp::fromTime(request->getFieldAsTime(fieldId + 4));
-      bool success = true;
-
-      switch(statusCode)
-      {
-         case ERR_SUCCESS:
-            if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-               dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-            success = target->processNewDCValue(dcObject, t, value, tableValue, false);
-            if (t > dcObject->getLastPollTime())
-               dcObject->setLastPollTime(t);
-            break;
-         case ERR_UNKNOWN_METRIC:
-         case ERR_UNSUPPORTED_METRIC:
-            if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-               dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-            dcObject->processNewError(false, t);
-            break;
-         case ERR_NO_SUCH_INSTANCE:
-            if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-               dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-            dcObject->processNewError(true, t);
-            break;
-         case ERR_INTERNAL_ERROR:
-            dcObject->processNewError(true, t);
-            break;
-      }
-
-      status[i] = success ? BULK_DATA_REC_SUCCESS : BULK_DATA_REC_FAILURE;
-      MemFree(value);
+      status[i] = processCollectedDataElement(request, fieldId, node, i);
    }
 
    response->setField(VID_STATUS, status, count);
@@ -1100,6 +1102,49 @@ uint32_t AgentConnectionEx::processBulkCollectedData(NXCPMessage *request, NXCPM
    return ERR_SUCCESS;
 }
 
+/**
+ * Process batch of collected data pushed by agent's data sender (for DCI with agent-side cache)
+ */
+uint32_t AgentConnectionEx::processCollectedDataBatch(NXCPMessage *request, NXCPMessage *response)
+{
+   if (IsShutdownInProgress())
+      return ERR_RESOURCE_BUSY;
+
+   if (m_nodeId == 0)
+   {
+      debugPrintf(5, _T("AgentConnectionEx::processCollectedDataBatch: node ID is 0 for agent session"));
+      return ERR_INTERNAL_ERROR;
+   }
+
+   shared_ptr<Node> node = static_pointer_cast<Node>(FindObjectById(m_nodeId, OBJECT_NODE));
+   if (node == nullptr)
+   {
+      debugPrintf(5, _T("AgentConnectionEx::processCollectedDataBatch: cannot find node object (node ID = %u)"), m_nodeId);
+      return ERR_INTERNAL_ERROR;
+   }
+
+   // Check that server is not overloaded with DCI data
+   int64_t queueSize = GetIDataWriterQueueSize();
+   if (queueSize >= m_dbWriterQueueThreshold)
+   {
+      debugPrintf(5, _T("AgentConnectionEx::processCollectedDataBatch: database writer queue is too large (") INT64_FMT _T(") - cannot accept new data"), queueSize);
+      return ERR_RESOURCE_BUSY;
+   }
+
+   int count = request->getFieldAsInt32(VID_NUM_ELEMENTS);
+   if (count > MAX_BULK_DATA_BLOCK_SIZE)
+      count = MAX_BULK_DATA_BLOCK_SIZE;
+   debugPrintf(7, _T("AgentConnectionEx::processCollectedDataBatch: %d elements from node %s [%u]"), count, node->getName(), node->getId());
+
+   BYTE status[MAX_BULK_DATA_BLOCK_SIZE];
+   uint32_t fieldId = VID_ELEMENT_LIST_BASE;
+   for(int i = 0; i < count; i++, fieldId += 10)
+      status[i] = IsShutdownInProgress() ? BULK_DATA_REC_RETRY : processCollectedDataElement(request, fieldId, node, i);
+
+   response->setField(VID_STATUS, status, count);
+   return ERR_SUCCESS;
+}
+
 /**
  * Set callback for receiving TCP proxy packets
  */
@@ -24,9 +24,15 @@
 #include <netxms-regex.h>
 #include <nms_users.h>
 #include <nxai.h>
+#include <map>
 
 #define DEBUG_TAG L"alarm"
 
+/**
+ * Maximum number of compiled alarm key patterns kept in cache
+ */
+#define MAX_CACHED_KEY_PATTERNS  256
+
 /**
  * Column list for loading alarms from database
  */
@@ -196,6 +202,51 @@ static void UpdateObjectOnAlarmResolve(uint32_t objectId, uint32_t alarmId, bool
       RecalculateObjectStatus(objectId);
 }
 
+/**
+ * Alarm key comparator for ordered key index
+ */
+struct AlarmKeyComparator
+{
+   bool operator()(const TCHAR *k1, const TCHAR *k2) const
+   {
+      return _tcscmp(k1, k2) < 0;
+   }
+};
+
+/**
+ * Alarm key snapshot element
+ */
+struct AlarmKeySnapshotElement
+{
+   const TCHAR *key;
+   int length;
+   uint32_t alarmId;
+};
+
+/**
+ * Snapshot of alarm keys. Keys are copied so that snapshot can be used without holding alarm list lock.
+ */
+class AlarmKeySnapshot
+{
+private:
+   MemoryPool m_pool;
+   StructArray<AlarmKeySnapshotElement> m_elements;
+
+public:
+   AlarmKeySnapshot(int initialSize) : m_elements(initialSize, 1024) { }
+
+   void add(const TCHAR *key, uint32_t alarmId)
+   {
+      AlarmKeySnapshotElement *e = m_elements.addPlaceholder();
+      e->key = m_pool.copyString(key);
+      e->length = static_cast<int>(_tcslen(key));
+      e->alarmId = alarmId;
+   }
+
+   int size() const { return m_elements.size(); }
+   const AlarmKeySnapshotElement *get(int index) const { return m_elements.get(index); }
+};
+
 /**
  * Alarm list
  */
@@ -205,6 +256,8 @@ class AlarmList
    Mutex m_lock;
    AbstractIndexWithDestructor<Alarm> m_primaryIndex;
    StringObjectMap<Alarm> m_keyIndex;
+   std::map<const TCHAR*, Alarm*, AlarmKeyComparator> m_orderedKeyIndex;   // Uses alarm's own key buffer as map key
+   shared_ptr<AlarmKeySnapshot> m_keySnapshot;  // Cached snapshot of all keys, reset on any change in key index
 
 public:
    AlarmList() : m_primaryIndex(Ownership::True), m_keyIndex(Ownership::False) { }
@@ -236,11 +289,39 @@ class AlarmList
    void forEach(std::function<EnumerationCallbackResult (Alarm*)> callback) { m_primaryIndex.forEach(callback); }
    void forEachKey(std::function<EnumerationCallbackResult (const TCHAR*, Alarm*)> callback) { m_keyIndex.forEach(callback); }
 
+   /**
+    * Get snapshot of alarm keys starting with given prefix (all keys if prefix is empty). Alarm list must be locked by caller.
+    */
+   shared_ptr<AlarmKeySnapshot> getKeySnapshot(const TCHAR *prefix)
+   {
+      if (*prefix == 0)
+      {
+         if (m_keySnapshot == nullptr)
+         {
+            m_keySnapshot = make_shared<AlarmKeySnapshot>(static_cast<int>(m_orderedKeyIndex.size()));
+            for(auto it = m_orderedKeyIndex.begin(); it != m_orderedKeyIndex.end(); it++)
+               m_keySnapshot->add(it->first, it->second->getAlarmId());
+         }
+         return m_keySnapshot;
+      }
+
+      auto snapshot = make_shared<AlarmKeySnapshot>(64);
+      size_t prefixLength = _tcslen(prefix);
+      for(auto it = m_orderedKeyIndex.lower_bound(prefix); (it != m_orderedKeyIndex.end()) && !_tcsncmp(it->first, prefix, prefixLength); it++)
+         snapshot->add(it->first, it->second->getAlarmId());
+      return snapshot;
+   }
+
    void add(Alarm *alarm)
    {
       m_primaryIndex.put(alarm->getAlarmId(), alarm);
       if (*alarm->getKey() != 0)
+      {
          m_keyIndex.set(alarm->getKey(), alarm);
+         m_orderedKeyIndex.erase(alarm->getKey());
+         m_orderedKeyIndex.emplace(alarm->getKey(), alarm);
+         m_keySnapshot.reset();
+      }
    }
 
    void remove(Alarm *alarm)
@@ -252,7 +333,13 @@ class AlarmList
             parent->removeSubordinateAlarm(alarm->getAlarmId());
       }
       if (*alarm->getKey() != 0)
+      {
          m_keyIndex.remove(alarm->getKey());
+         auto it = m_orderedKeyIndex.find(alarm->getKey());
+         if ((it != m_orderedKeyIndex.end()) && (it->second == alarm))
+            m_orderedKeyIndex.erase(it);
+         m_keySnapshot.reset();
+      }
       m_primaryIndex.remove(alarm->getAlarmId());
    }
 };
@@ -320,14 +407,6 @@ struct AlarmDbWriteRequest
 static ObjectQueue<AlarmDbWriteRequest> s_alarmDbWriterQueue;
 static THREAD s_alarmDbWriterThread = INVALID_THREAD_HANDLE;
 
-/**
- * Callback for client session enumeration
- */
-static void SendAlarmNotification(ClientSession *session, std::pair<uint32_t, const Alarm*> *data)
-{
-   session->onAlarmUpdate(data->first, data->second);
-}
-
 /**
  * Callback for client session enumeration
  */
@@ -343,8 +422,16 @@ static void NotifyClients(uint32_t code, const Alarm *alarm)
 {
    CALL_ALL_MODULES(pfAlarmChangeHook, (code, alarm));
 
-   std::pair<uint32_t, const Alarm*> data(code, alarm);
-   EnumerateClientSessions(SendAlarmNotification, &data);
+   // Build and serialize update message once, sessions only check access and enqueue it
+   NXCPMessage msg(CMD_ALARM_UPDATE, 0);
+   alarm->fillMessage(&msg);
+   msg.setField(VID_NOTIFICATION_CODE, code);
+   ClientBroadcastMessage bmsg(msg);
+   EnumerateClientSessions(
+      [alarm, &bmsg] (ClientSession *session) -> void
+      {
+         session->onAlarmUpdate(alarm, &bmsg);
+      });
 }
 
 /**
@@ -1792,60 +1879,152 @@ void NXCORE_EXPORTABLE ResolveAlarmsById(const IntegerArray<uint32_t>& alarmIds,
 }
 
 /**
- * Resolve alarm(s) by matching alarm key with regular expression
+ * Compiled alarm key pattern
  */
-static void ResolveAlarmByKeyRegexp(const TCHAR *keyPattern, bool terminate, Event *event)
+struct AlarmKeyPattern
 {
-   const char *errptr = nullptr;
-   int erroffset;
-   PCRE *preg = _pcre_compile_t(reinterpret_cast<const PCRE_TCHAR*>(keyPattern), PCRE_COMMON_FLAGS, &errptr, &erroffset, nullptr);
-   if (preg != nullptr)
+   PCRE *preg;
+   TCHAR prefix[MAX_DB_STRING];  // Literal prefix every matching key should start with (empty if pattern is not anchored)
+
+   AlarmKeyPattern(PCRE *_preg)
    {
-      IntegerArray<uint32_t> objectList;
-      ObjectArray<Alarm> matchedAlarms(128, 128, Ownership::False);
+      preg = _preg;
+      prefix[0] = 0;
+   }
 
-      s_alarmList.lock();
+   ~AlarmKeyPattern()
+   {
+      _pcre_free_t(preg);
+   }
+};
 
-      s_alarmList.forEachKey(
-         [preg, terminate, &matchedAlarms, &objectList] (const TCHAR *key, Alarm *alarm) -> EnumerationCallbackResult
-         {
-            int ovector[60];
-            if ((_pcre_exec_t(preg, nullptr, reinterpret_cast<const PCRE_TCHAR*>(key), static_cast<int>(_tcslen(key)), 0, 0, ovector, 60) >= 0) &&
-                ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false)) &&
-                (terminate || (alarm->getState() != ALARM_STATE_RESOLVED)))
-            {
-               // Add alarm and alarm's source object to update list
-               matchedAlarms.add(alarm);
-               if (!objectList.contains(alarm->getSourceObject()))
-                  objectList.add(alarm->getSourceObject());
-            }
-            return _CONTINUE;
-         });
+/**
+ * Compiled alarm key pattern cache
+ */
+static SharedStringObjectMap<AlarmKeyPattern> s_keyPatternCache;
+static Mutex s_keyPatternCacheLock(MutexType::FAST);
+
+/**
+ * Extract literal prefix from anchored regular expression. Prefix is left empty if pattern
+ * is not anchored or contains constructs that make prefix analysis unsafe (alternation, inline options, etc.).
+ * Prefix buffer should be at least MAX_DB_STRING characters long.
+ */
+void NXCORE_EXPORTABLE ExtractKeyPatternPrefix(const TCHAR *pattern, TCHAR *prefix)
+{
+   *prefix = 0;
+   if ((*pattern != _T('^')) || (_tcschr(pattern, _T('|')) != nullptr))
+      return;
 
-      // Resolve or terminate matched alarms
-      for(int i = 0; i < matchedAlarms.size(); i++)
+   int len = 0;
+   const TCHAR *p = pattern + 1;
+   while((*p != 0) && (len < MAX_DB_STRING - 1))
+   {
+      TCHAR ch = *p;
+      if (ch == _T('\\'))
       {
-         Alarm *alarm = matchedAlarms.get(i);
-         alarm->resolve(0, event, terminate, true, false);
-         UpdateObjectOnAlarmResolve(alarm->getSourceObject(), alarm->getAlarmId(), false);
-         if (terminate)
-         {
-            s_alarmList.remove(alarm);
-         }
+         ch = p[1];
+         if ((ch == 0) || _istalnum(ch))
+            break;   // Character classes, back references, \Q...\E, etc.
+      }
+      else if (_tcschr(_T(".[]()*+?{}^$"), ch) != nullptr)
+      {
+         break;
       }
 
-      s_alarmList.unlock();
+      p += (*p == _T('\\')) ? 2 : 1;
+      if ((*p == _T('*')) || (*p == _T('?')) || (*p == _T('{')))
+         break;   // Character is optional or repeat count is unknown
+      prefix[len++] = ch;
+   }
+   prefix[len] = 0;
+}
 
-      // Update status of objects
-      for(int i = 0; i < objectList.size(); i++)
-         RecalculateObjectStatus(objectList.get(i));
+/**
+ * Get compiled alarm key pattern from cache or compile and add to cache
+ */
+static shared_ptr<AlarmKeyPattern> GetAlarmKeyPattern(const TCHAR *keyPattern)
+{
+   s_keyPatternCacheLock.lock();
+   shared_ptr<AlarmKeyPattern> pattern = s_keyPatternCache.getShared(keyPattern);
+   s_keyPatternCacheLock.unlock();
+   if (pattern != nullptr)
+      return pattern;
 
-      _pcre_free_t(preg);
-   }
-   else
+   const char *errptr = nullptr;
+   int erroffset;
+   PCRE *preg = _pcre_compile_t(reinterpret_cast<const PCRE_TCHAR*>(keyPattern), PCRE_COMMON_FLAGS, &errptr, &erroffset, nullptr);
+   if (preg == nullptr)
    {
       nxlog_debug_tag(DEBUG_TAG, 5, _T("ResolveAlarmByKey: cannot compile regular expression \"%s\" (%hs)"), keyPattern, errptr);
+      return pattern;
+   }
+
+   pattern = make_shared<AlarmKeyPattern>(preg);
+   ExtractKeyPatternPrefix(keyPattern, pattern->prefix);
+   nxlog_debug_tag(DEBUG_TAG, 7, _T("ResolveAlarmByKey: compiled regular expression \"%s\" (literal prefix \"%s\")"), keyPattern, pattern->prefix);
+
+   s_keyPatternCacheLock.lock();
+   if (s_keyPatternCache.size() >= MAX_CACHED_KEY_PATTERNS)
+      s_keyPatternCache.clear();
+   s_keyPatternCache.set(keyPattern, pattern);
+   s_keyPatternCacheLock.unlock();
+   return pattern;
+}
+
+/**
+ * Resolve alarm(s) by matching alarm key with regular expression. Keys are matched on snapshot
+ * outside of alarm list lock; for anchored patterns only keys with matching literal prefix are checked.
+ */
+static void ResolveAlarmByKeyRegexp(const TCHAR *keyPattern, bool terminate, Event *event)
+{
+   shared_ptr<AlarmKeyPattern> pattern = GetAlarmKeyPattern(keyPattern);
+   if (pattern == nullptr)
+      return;
+
+   s_alarmList.lock();
+   shared_ptr<AlarmKeySnapshot> snapshot = s_alarmList.getKeySnapshot(pattern->prefix);
+   s_alarmList.unlock();
+
+   IntegerArray<uint32_t> candidates;
+   for(int i = 0; i < snapshot->size(); i++)
+   {
+      const AlarmKeySnapshotElement *e = snapshot->get(i);
+      int ovector[60];
+      if (_pcre_exec_t(pattern->preg, nullptr, reinterpret_cast<const PCRE_TCHAR*>(e->key), e->length, 0, 0, ovector, 60) >= 0)
+         candidates.add(e->alarmId);
+   }
+   if (candidates.isEmpty())
+      return;
+
+   bool ignoreHelpdeskState = ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false);
+   IntegerArray<uint32_t> objectList;
+
+   s_alarmList.lock();
+   for(int i = 0; i < candidates.size(); i++)
+   {
+      // Alarm could be terminated while alarm list was unlocked
+      Alarm *alarm = s_alarmList.find(candidates.get(i));
+      if ((alarm == nullptr) ||
+          ((alarm->getHelpDeskState() == ALARM_HELPDESK_OPEN) && !ignoreHelpdeskState) ||
+          (!terminate && (alarm->getState() == ALARM_STATE_RESOLVED)))
+         continue;
+
+      uint32_t objectId = alarm->getSourceObject();
+      if (!objectList.contains(objectId))
+         objectList.add(objectId);
+
+      alarm->resolve(0, event, terminate, true, false);
+      UpdateObjectOnAlarmResolve(objectId, alarm->getAlarmId(), false);
+      if (terminate)
+      {
+         s_alarmList.remove(alarm);
+      }
    }
+   s_alarmList.unlock();
+
+   // Update status of objects
+   for(int i = 0; i < objectList.size(); i++)
+      RecalculateObjectStatus(objectList.get(i));
 }
 
 /**
@@ -331,6 +331,8 @@ void Chassis::onObjectDelete(const NetObj& object)
  */
 void Chassis::onDataCollectionChange()
 {
+   scheduleDataCollection(time(nullptr), false);
+
    shared_ptr<Node> controller = static_pointer_cast<Node>(FindObjectById(m_controllerId, OBJECT_NODE));
    if (controller == nullptr)
    {
@@ -130,6 +130,7 @@ static void ClientSessionManager()
          break;
 
       msg.setFieldFromTime(VID_TIMESTAMP, time(nullptr));
+      ClientBroadcastMessage bmsg(msg);
 
       s_sessionListLock.readLock();
       auto it = s_sessions.begin();
@@ -138,7 +139,7 @@ static void ClientSessionManager()
          ClientSession *session = it.next();
          if (session->isAuthenticated())
          {
-            session->postMessage(&msg);
+            session->postMessage(&bmsg);
             session->runHousekeeper();
          }
       }
@@ -339,13 +340,14 @@ void SendUserDBUpdate(uint16_t code, uint32_t id, UserDatabaseObject *object)
          break;
    }
 
+   ClientBroadcastMessage bmsg(msg);
    s_sessionListLock.readLock();
    auto it = s_sessions.begin();
    while(it.hasNext())
    {
       ClientSession *session = it.next();
       if (session->isAuthenticated() && !session->isTerminated() && session->isSubscribedTo(NXC_CHANNEL_USERDB))
-         session->postMessage(msg);
+         session->postMessage(&bmsg);
    }
    s_sessionListLock.unlock();
 }
@@ -355,13 +357,14 @@ void SendUserDBUpdate(uint16_t code, uint32_t id, UserDatabaseObject *object)
  */
 void NXCORE_EXPORTABLE NotifyClientsOnGraphUpdate(const NXCPMessage& msg, uint32_t graphId)
 {
+   ClientBroadcastMessage bmsg(msg);
    s_sessionListLock.readLock();
    auto it = s_sessions.begin();
    while(it.hasNext())
    {
       ClientSession *session = it.next();
       if (session->isAuthenticated() && !session->isTerminated() && (CheckGraphAccess(graphId, session->getUserId(), NXGRAPH_ACCESS_READ) == RCC_SUCCESS))
-         session->postMessage(msg);
+         session->postMessage(&bmsg);
    }
    s_sessionListLock.unlock();
 }
@@ -371,13 +374,14 @@ void NXCORE_EXPORTABLE NotifyClientsOnGraphUpdate(const NXCPMessage& msg, uint32
  */
 void NotifyClientsOnPolicyUpdate(const NXCPMessage& msg, const Template& object)
 {
+   ClientBroadcastMessage bmsg(msg);
    s_sessionListLock.readLock();
    auto it = s_sessions.begin();
    while(it.hasNext())
    {
       ClientSession *session = it.next();
       if (session->isAuthenticated() && !session->isTerminated() && object.checkAccessRights(session->getUserId(), OBJECT_ACCESS_MODIFY))
-         session->postMessage(msg);
+         session->postMessage(&bmsg);
    }
    s_sessionListLock.unlock();
 }
@@ -398,6 +402,7 @@ void NotifyClientsOnPolicyDelete(uuid guid, const Template& object)
  */
 void NotifyClientsOnBusinessServiceCheckUpdate(const NXCPMessage& msg, const NetObj& object)
 {
+   ClientBroadcastMessage bmsg(msg);
    s_sessionListLock.readLock();
    auto it = s_sessions.begin();
    while(it.hasNext())
@@ -405,7 +410,7 @@ void NotifyClientsOnBusinessServiceCheckUpdate(const NXCPMessage& msg, const Net
       ClientSession *session = it.next();
       if (session->isAuthenticated() && !session->isTerminated() && object.checkAccessRights(session->getUserId(), OBJECT_ACCESS_READ))
       {
-         session->postMessage(msg);
+         session->postMessage(&bmsg);
       }
    }
    s_sessionListLock.unlock();
@@ -472,6 +477,7 @@ void NotifyClientsOnDCIStatusChange(const DataCollectionOwner& object, uint32_t
  */
 void NotifyClientsOnDCIUpdate(const NXCPMessage& msg, const NetObj& object)
 {
+   ClientBroadcastMessage bmsg(msg);
    s_sessionListLock.readLock();
    auto it = s_sessions.begin();
    while(it.hasNext())
@@ -481,7 +487,7 @@ void NotifyClientsOnDCIUpdate(const NXCPMessage& msg, const NetObj& object)
           session->isDataCollectionConfigurationOpen(object.getId()) &&
           object.checkAccessRights(session->getUserId(), OBJECT_ACCESS_MODIFY))
       {
-         session->postMessage(msg);
+         session->postMessage(&bmsg);
       }
    }
    s_sessionListLock.unlock();
@@ -503,6 +509,7 @@ void NotifyClientsOnThresholdChange(UINT32 objectId, UINT32 dciId, UINT32 thresh
    msg.setField(VID_INSTANCE, instance);
    msg.setField(VID_STATE, change == ThresholdCheckResult::ACTIVATED || change == ThresholdCheckResult::VALUE_CHANGED);
 
+   ClientBroadcastMessage bmsg(msg);
    s_sessionListLock.readLock();
    auto it = s_sessions.begin();
    while(it.hasNext())
@@ -512,7 +519,7 @@ void NotifyClientsOnThresholdChange(UINT32 objectId, UINT32 dciId, UINT32 thresh
           session->isSubscribedTo(NXC_CHANNEL_DC_THRESHOLDS) &&
           object->checkAccessRights(session->getUserId(), OBJECT_ACCESS_MODIFY))
       {
-         session->postMessage(msg);
+         session->postMessage(&bmsg);
       }
    }
    s_sessionListLock.unlock();
@@ -523,6 +530,7 @@ void NotifyClientsOnThresholdChange(UINT32 objectId, UINT32 dciId, UINT32 thresh
  */
 void NXCORE_EXPORTABLE NotifyClientSessions(const NXCPMessage& msg, std::function<bool (ClientSession*)> filter)
 {
+   ClientBroadcastMessage bmsg(msg);
    s_sessionListLock.readLock();
    if (s_sessions.size() > 0)
    {
@@ -532,7 +540,7 @@ void NXCORE_EXPORTABLE NotifyClientSessions(const NXCPMessage& msg, std::functio
          ClientSession *session = it.next();
          if (session->isAuthenticated() && !session->isTerminated() && filter(session))
          {
-            session->postMessage(msg);
+            session->postMessage(&bmsg);
          }
       }
    }
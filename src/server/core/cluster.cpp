@@ -1009,6 +1009,7 @@ void Cluster::onTemplateRemove(const shared_ptr<DataCollectionOwner>& templateOb
 void Cluster::onDataCollectionChange()
 {
    queueUpdate();
+   scheduleDataCollection(time(nullptr), false);
 }
 
 /**
@@ -928,6 +928,10 @@ static void OnConfigVariableChange(bool isCLOB, const TCHAR *name, const TCHAR *
    {
       UpdateServerFlag(AF_DELETE_EMPTY_SUBNETS, value);
    }
+   else if (!wcscmp(name, L"PerfDataStorage.MaxQueueSize"))
+   {
+      g_pdsMaxQueueSize = ConvertToUint32(value, 100000);
+   }
    else if (!_tcsncmp(name, L"SNMP.Agent.", 11))
    {
       OnSNMPAgentConfigurationChange(name, value);
@@ -948,10 +952,18 @@ static void OnConfigVariableChange(bool isCLOB, const TCHAR *name, const TCHAR *
    {
       UpdateServerFlag(AF_TRAPS_FROM_UNMANAGED_NODES, value);
    }
+   else if (!wcscmp(name, L"SNMP.BulkWalk.MaxRepetitions"))
+   {
+      g_snmpBulkWalkMaxRepetitions = ConvertToUint32(value, 25);
+   }
    else if (!wcscmp(name, L"SNMP.MinVersion"))
    {
       g_snmpMinVersion = SNMP_VersionFromInt(ConvertToUint32(value, 0));
    }
+   else if (!wcscmp(name, L"SNMP.TransportPool.IdleTimeout"))
+   {
+      g_snmpTransportPoolIdleTimeout = ConvertToUint32(value, 120);
+   }
    else if (!wcscmp(name, L"SNMP.Traps.RateLimit.Threshold"))
    {
       g_snmpTrapStormCountThreshold = ConvertToUint32(value, 0);
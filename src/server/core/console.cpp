@@ -23,6 +23,7 @@
 #include "nxcore.h"
 #include <entity_mib.h>
 #include <nxcore_discovery.h>
+#include <nxcore_syslog.h>
 #include <nxtask.h>
 #include <netxms-version.h>
 #include <nms_users.h>
@@ -35,7 +36,6 @@ struct SnmpTrap;
  */
 extern ObjectQueue<SnmpTrap> g_snmpTrapProcessorQueue;
 extern ObjectQueue<SnmpTrap> g_snmpTrapWriterQueue;
-extern ObjectQueue<SyslogMessage> g_syslogProcessingQueue;
 extern ObjectQueue<SyslogMessage> g_syslogWriteQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventProcessingQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventWriterQueue;
@@ -1381,10 +1381,17 @@ int ProcessConsoleCommand(const wchar_t *command, ServerConsole *console)
          {
             PoolConnectionInfo *c = list->get(i);
             TCHAR accessTime[64];
-            ConsolePrintf(console, _T("%p %s %hs:%d\n"), c->handle, FormatTimestamp(c->lastAccessTime, accessTime), c->srcFile, c->srcLine);
+            ConsolePrintf(console, _T("%p %s %hs:%d (waited %u ms; wait distribution <1ms:%u <10ms:%u <100ms:%u <1s:%u <10s:%u >=10s:%u)\n"),
+                     c->handle, FormatTimestamp(c->lastAccessTime, accessTime), c->srcFile, c->srcLine, c->waitTime,
+                     c->waitHistogram[0], c->waitHistogram[1], c->waitHistogram[2], c->waitHistogram[3], c->waitHistogram[4], c->waitHistogram[5]);
          }
-         ConsolePrintf(console, _T("%d database connections in use\n\n"), list->size());
+         ConsolePrintf(console, _T("%d database connections in use\n"), list->size());
          delete list;
+
+         uint32_t histogram[DB_POOL_WAIT_HISTOGRAM_SIZE];
+         DBConnectionPoolGetWaitTimeHistogram(histogram);
+         ConsolePrintf(console, _T("Total wait distribution <1ms:%u <10ms:%u <100ms:%u <1s:%u <10s:%u >=10s:%u\n\n"),
+                  histogram[0], histogram[1], histogram[2], histogram[3], histogram[4], histogram[5]);
       }
       else if (IsCommand(_T("DBSTATS"), szBuffer, 3))
       {
@@ -1805,11 +1812,12 @@ int ProcessConsoleCommand(const wchar_t *command, ServerConsole *console)
          ShowQueueStats(console, GetRawDataWriterQueueSize(), _T("Database writer (raw DCI values)"));
          ShowQueueStats(console, GetEventProcessorQueueSize(), _T("Event processor"));
          ShowQueueStats(console, GetEventLogWriterQueueSize(), _T("Event log writer"));
+         ShowQueueStats(console, GetPerfDataStorageQueueSize(), _T("Performance data storage writer"));
          ShowThreadPoolPendingQueue(console, g_pollerThreadPool, _T("Poller"));
          ShowQueueStats(console, GetDiscoveryPollerQueueSize(), _T("Node discovery poller"));
          ShowQueueStats(console, &g_snmpTrapProcessorQueue, _T("SNMP trap processor"));
          ShowQueueStats(console, &g_snmpTrapWriterQueue, _T("SNMP trap writer"));
-         ShowQueueStats(console, &g_syslogProcessingQueue, _T("Syslog processor"));
+         ShowQueueStats(console, GetSyslogProcessingQueueSize(), _T("Syslog processor"));
          ShowQueueStats(console, &g_syslogWriteQueue, _T("Syslog writer"));
          ShowThreadPoolPendingQueue(console, g_schedulerThreadPool, _T("Scheduler"));
          ShowQueueStats(console, &g_windowsEventProcessingQueue, _T("Windows event processor"));
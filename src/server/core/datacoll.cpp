@@ -46,6 +46,17 @@ ThreadPool *g_thresholdRepeatPool = nullptr;
  */
 SharedObjectQueue<DCObjectInfo> g_dciCacheLoaderQueue;
 
+/**
+ * SNMP request coalescing settings
+ */
+bool g_snmpRequestCoalescing = false;
+int g_snmpMaxVarbindsPerRequest = 16;
+
+/**
+ * Asynchronous SNMP engine for data collection (nullptr if disabled)
+ */
+static SNMP_AsyncEngine *s_snmpAsyncEngine = nullptr;
+
 /**
  * Average time to queue DCI
  */
@@ -326,22 +337,24 @@ static shared_ptr<Table> GetTableData(DataCollectionTarget *dcTarget, const DCTa
 }
 
 /**
- * Data collector
+ * Prepare DC object for data collection. Returns false if object was fully processed and
+ * no further actions needed. Otherwise target is set to effective data collection target
+ * (which can be nullptr if source node is not accessible).
  */
-void DataCollector(const shared_ptr<DCObject>& dcObject)
+static bool PrepareDataCollection(const shared_ptr<DCObject>& dcObject, shared_ptr<DataCollectionTarget> *target, uint32_t *sourceNodeId)
 {
-   shared_ptr<DataCollectionTarget> target = static_pointer_cast<DataCollectionTarget>(dcObject->getOwner());
+   *target = static_pointer_cast<DataCollectionTarget>(dcObject->getOwner());
 
    SharedString dcObjectName = dcObject->getName();
    if (dcObject->isScheduledForDeletion())
    {
       nxlog_debug_tag(DEBUG_TAG_DC_COLLECTOR, 7, _T("DataCollector(): about to destroy DC object [%u] \"%s\" owner=[%u]"),
-            dcObject->getId(), dcObjectName.cstr(), (target != nullptr) ? target->getId() : 0);
+            dcObject->getId(), dcObjectName.cstr(), (*target != nullptr) ? (*target)->getId() : 0);
       dcObject->deleteFromDatabase();
-      return;
+      return false;
    }
 
-   if (target == nullptr)
+   if (*target == nullptr)
    {
       nxlog_debug_tag(DEBUG_TAG_DC_COLLECTOR, 3, _T("DataCollector: attempt to collect data for non-existing node (DCI=[%u] \"%s\")"),
             dcObject->getId(), dcObjectName.cstr());
@@ -349,45 +362,140 @@ void DataCollector(const shared_ptr<DCObject>& dcObject)
       // Update item's last poll time and clear busy flag so item can be polled again
       dcObject->setLastPollTime(Timestamp::now());
       dcObject->clearBusyFlag();
-      return;
+      return false;
    }
 
    if (IsShutdownInProgress())
    {
       dcObject->clearBusyFlag();
-      return;
+      return false;
    }
 
    nxlog_debug_tag(DEBUG_TAG_DC_COLLECTOR, 8, _T("DataCollector(): processing DC object %u \"%s\" owner=%u sourceNode=%u"),
-         dcObject->getId(), dcObjectName.cstr(), target->getId(), dcObject->getSourceNode());
-   uint32_t sourceNodeId = target->getEffectiveSourceNode(dcObject.get());
-   if (sourceNodeId != 0)
+         dcObject->getId(), dcObjectName.cstr(), (*target)->getId(), dcObject->getSourceNode());
+   *sourceNodeId = (*target)->getEffectiveSourceNode(dcObject.get());
+   if (*sourceNodeId != 0)
    {
-      shared_ptr<Node> sourceNode = static_pointer_cast<Node>(FindObjectById(sourceNodeId, OBJECT_NODE));
+      shared_ptr<Node> sourceNode = static_pointer_cast<Node>(FindObjectById(*sourceNodeId, OBJECT_NODE));
       if (sourceNode != nullptr)
       {
-         if (((target->getObjectClass() == OBJECT_CHASSIS) && (static_cast<Chassis*>(target.get())->getControllerId() == sourceNodeId)) || sourceNode->isTrustedObject(target->getId()))
+         if ((((*target)->getObjectClass() == OBJECT_CHASSIS) && (static_cast<Chassis*>(target->get())->getControllerId() == *sourceNodeId)) || sourceNode->isTrustedObject((*target)->getId()))
          {
-            target = sourceNode;
+            *target = sourceNode;
          }
          else
          {
             // Change item's status to "not supported"
             dcObject->setStatus(ITEM_STATUS_NOT_SUPPORTED, true);
-            target.reset();
+            target->reset();
          }
       }
       else
       {
          // Change item's status to "not supported"
          dcObject->setStatus(ITEM_STATUS_NOT_SUPPORTED, true);
-         target.reset();
+         target->reset();
       }
    }
+   return true;
+}
+
+/**
+ * Process data collection result
+ */
+static void ProcessCollectionResult(const shared_ptr<DCObject>& dcObject, uint32_t error, Timestamp timestamp, const wchar_t *value, const shared_ptr<Table>& table)
+{
+   if ((error == DCE_NOT_SUPPORTED) && dcObject->isUnsupportedAsError())
+      error = DCE_COLLECTION_ERROR;
+
+   // Transform and store received value into database or handle error
+   switch(error)
+   {
+      case DCE_SUCCESS:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         static_cast<DataCollectionTarget*>(dcObject->getOwner().get())->processNewDCValue(dcObject, timestamp, value, table, false);
+         break;
+      case DCE_COLLECTION_ERROR:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         dcObject->processNewError(false);
+         break;
+      case DCE_NO_SUCH_INSTANCE:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         dcObject->processNewError(true);
+         break;
+      case DCE_COMM_ERROR:
+         dcObject->processNewError(false);
+         break;
+      case DCE_NOT_SUPPORTED:
+         // Change item's status
+         dcObject->setStatus(ITEM_STATUS_NOT_SUPPORTED, true);
+         break;
+   }
+
+   // Send session notification when force poll is performed
+   if (dcObject->isForcePollRequested())
+   {
+      session_id_t sessionId = dcObject->processForcePoll();
+      if (sessionId != -1)
+      {
+         NotifyClientSession(sessionId, NX_NOTIFY_FORCE_DCI_POLL, dcObject->getOwnerId());
+      }
+   }
+}
+
+/**
+ * Report DC object with inaccessible data collection target
+ */
+static void ReportInaccessibleTarget(const shared_ptr<DCObject>& dcObject, uint32_t sourceNodeId)
+{
+   shared_ptr<DataCollectionOwner> n = dcObject->getOwner();
+   nxlog_debug_tag(DEBUG_TAG_DC_COLLECTOR, 5, _T("Attempt to collect data from non-existing or inaccessible node (DCI=[%u] \"%s\" target=[%u] sourceNode=[%u])"),
+               dcObject->getId(), dcObject->getName().cstr(), (n != nullptr) ? n->getId() : 0, sourceNodeId);
+}
+
+/**
+ * Start collection of SNMP DCI value using asynchronous SNMP engine. Returns true if request was submitted and
+ * result will be processed by completion callback.
+ */
+static bool StartAsyncItemCollection(const shared_ptr<DataCollectionTarget>& target, const shared_ptr<DCObject>& dcObject, Timestamp timestamp)
+{
+   const DCItem *dci = static_cast<DCItem*>(dcObject.get());
+   if ((dci->getDataSource() != DS_SNMP_AGENT) || (target->getObjectClass() != OBJECT_NODE) || dci->isInterpretSnmpRawValue() ||
+       ((dci->getSnmpAgentName() != nullptr) && (*dci->getSnmpAgentName() != 0)))
+      return false;
+
+   return static_cast<Node*>(target.get())->getMetricFromSNMPAsync(s_snmpAsyncEngine, dci->getSnmpPort(), dci->getSnmpVersion(), dci->getName(), dci->getSnmpContext(),
+      [target, dcObject, timestamp] (DataCollectionError error, const wchar_t *value) -> void
+      {
+         if (!IsShutdownInProgress())
+            ProcessCollectionResult(dcObject, error, timestamp, value, shared_ptr<Table>());
+
+         // Update item's last poll time and clear busy flag so item can be polled again
+         dcObject->setLastPollTime(timestamp);
+         dcObject->clearBusyFlag();
+      });
+}
+
+/**
+ * Data collector
+ */
+void DataCollector(const shared_ptr<DCObject>& dcObject)
+{
+   shared_ptr<DataCollectionTarget> target;
+   uint32_t sourceNodeId;
+   if (!PrepareDataCollection(dcObject, &target, &sourceNodeId))
+      return;
 
    Timestamp currTime = Timestamp::now();
    if (target != nullptr)
    {
+      if ((s_snmpAsyncEngine != nullptr) && (dcObject->getType() == DCO_TYPE_ITEM) && !IsShutdownInProgress() &&
+          StartAsyncItemCollection(target, dcObject, currTime))
+         return;  // Result will be processed by asynchronous request completion callback
+
       if (!IsShutdownInProgress())
       {
          wchar_t value[MAX_RESULT_LENGTH];
@@ -405,53 +513,12 @@ void DataCollector(const shared_ptr<DCObject>& dcObject)
                error = DCE_NOT_SUPPORTED;
                break;
          }
-
-         if ((error == DCE_NOT_SUPPORTED) && dcObject->isUnsupportedAsError())
-            error = DCE_COLLECTION_ERROR;
-
-         // Transform and store received value into database or handle error
-         switch(error)
-         {
-            case DCE_SUCCESS:
-               if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-                  dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-               static_cast<DataCollectionTarget*>(dcObject->getOwner().get())->processNewDCValue(dcObject, currTime, value, table, false);
-               break;
-            case DCE_COLLECTION_ERROR:
-               if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-                  dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-               dcObject->processNewError(false);
-               break;
-            case DCE_NO_SUCH_INSTANCE:
-               if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-                  dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-               dcObject->processNewError(true);
-               break;
-            case DCE_COMM_ERROR:
-               dcObject->processNewError(false);
-               break;
-            case DCE_NOT_SUPPORTED:
-               // Change item's status
-               dcObject->setStatus(ITEM_STATUS_NOT_SUPPORTED, true);
-               break;
-         }
-
-         // Send session notification when force poll is performed
-         if (dcObject->isForcePollRequested())
-         {
-            session_id_t sessionId = dcObject->processForcePoll();
-            if (sessionId != -1)
-            {
-               NotifyClientSession(sessionId, NX_NOTIFY_FORCE_DCI_POLL, dcObject->getOwnerId());
-            }
-         }
+         ProcessCollectionResult(dcObject, error, currTime, value, table);
       }
    }
    else     /* target == nullptr */
    {
-      shared_ptr<DataCollectionOwner> n = dcObject->getOwner();
-      nxlog_debug_tag(DEBUG_TAG_DC_COLLECTOR, 5, _T("Attempt to collect data from non-existing or inaccessible node (DCI=[%u] \"%s\" target=[%u] sourceNode=[%u])"),
-                  dcObject->getId(), dcObjectName.cstr(), (n != nullptr) ? n->getId() : 0, sourceNodeId);
+      ReportInaccessibleTarget(dcObject, sourceNodeId);
    }
 
    // Update item's last poll time and clear busy flag so item can be polled again
@@ -460,21 +527,129 @@ void DataCollector(const shared_ptr<DCObject>& dcObject)
 }
 
 /**
- * Callback for queueing DCIs
+ * Data collector for batch of SNMP items sharing same node, port, SNMP version, context, and agent.
+ * Values are requested using multi-varbind GET requests. Batch is destroyed by this function.
  */
-static EnumerationCallbackResult QueueItems(NetObj *object, uint32_t *watchdogId)
+void SNMPBatchDataCollector(SharedObjectArray<DCObject> *batch)
 {
-   if (IsShutdownInProgress())
-      return _STOP;
+   shared_ptr<Node> node;
+   SharedObjectArray<DCObject> items(batch->size());
+   for(int i = 0; i < batch->size(); i++)
+   {
+      shared_ptr<DCObject> dcObject = batch->getShared(i);
+      shared_ptr<DataCollectionTarget> target;
+      uint32_t sourceNodeId;
+      if (!PrepareDataCollection(dcObject, &target, &sourceNodeId))
+         continue;
 
-   WatchdogNotify(*watchdogId);
-	nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 8, _T("ItemPoller: calling DataCollectionTarget::queueItemsForPolling for object %s [%u]"), object->getName(), object->getId());
-	static_cast<DataCollectionTarget*>(object)->queueItemsForPolling();
-	return _CONTINUE;
+      if (target == nullptr)
+      {
+         ReportInaccessibleTarget(dcObject, sourceNodeId);
+         dcObject->setLastPollTime(Timestamp::now());
+         dcObject->clearBusyFlag();
+      }
+      else if ((target->getObjectClass() == OBJECT_NODE) && ((node == nullptr) || (node.get() == target.get())))
+      {
+         if (node == nullptr)
+            node = static_pointer_cast<Node>(target);
+         items.add(dcObject);
+      }
+      else
+      {
+         // Should not happen because batch is built for single node, but handle it anyway
+         DataCollector(dcObject);
+      }
+   }
+   delete batch;
+
+   if (items.isEmpty())
+      return;
+
+   Timestamp currTime = Timestamp::now();
+   if (!IsShutdownInProgress())
+   {
+      int count = items.size();
+      SharedString *nameStrings = new SharedString[count];
+      const wchar_t **names = MemAllocArrayNoInit<const wchar_t*>(count);
+      wchar_t **values = MemAllocArrayNoInit<wchar_t*>(count);
+      wchar_t *valueBuffer = MemAllocArrayNoInit<wchar_t>(count * MAX_RESULT_LENGTH);
+      DataCollectionError *results = MemAllocArrayNoInit<DataCollectionError>(count);
+      for(int i = 0; i < count; i++)
+      {
+         nameStrings[i] = items.get(i)->getName();
+         names[i] = nameStrings[i].cstr();
+         values[i] = &valueBuffer[i * MAX_RESULT_LENGTH];
+      }
+
+      const DCItem *first = static_cast<DCItem*>(items.get(0));
+      node->getMetricsFromSNMP(first->getSnmpPort(), first->getSnmpVersion(), first->getSnmpContext(), first->getSnmpAgentName(),
+            count, names, values, MAX_RESULT_LENGTH, results, g_snmpMaxVarbindsPerRequest);
+
+      for(int i = 0; i < count; i++)
+         ProcessCollectionResult(items.getShared(i), results[i], currTime, values[i], shared_ptr<Table>());
+
+      MemFree(results);
+      MemFree(valueBuffer);
+      MemFree(values);
+      MemFree(names);
+      delete[] nameStrings;
+   }
+
+   for(int i = 0; i < items.size(); i++)
+   {
+      // Update item's last poll time and clear busy flag so item can be polled again
+      DCObject *dcObject = items.get(i);
+      dcObject->setLastPollTime(currTime);
+      dcObject->clearBusyFlag();
+   }
 }
 
 /**
- * Item poller thread: check nodes' items and put into the
+ * Check DCIs which are due according to schedule and put ones which require polling into
+ * the data collector queue
+ */
+static void QueueScheduledItems(time_t now, uint32_t watchdogId)
+{
+   SharedObjectArray<DCObject> dueObjects(1024, 1024);
+   CollectScheduledDataCollectionObjects(now, &dueObjects);
+   if (dueObjects.isEmpty())
+      return;
+
+   nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 8, _T("ItemPoller: %d data collection objects due for check"), dueObjects.size());
+
+   // Group by owner so that each target is processed once
+   HashMap<uint32_t, SharedObjectArray<DCObject>> owners(Ownership::True);
+   for(int i = 0; i < dueObjects.size(); i++)
+   {
+      DCObject *dcObject = dueObjects.get(i);
+      SharedObjectArray<DCObject> *objects = owners.get(dcObject->getOwnerId());
+      if (objects == nullptr)
+      {
+         objects = new SharedObjectArray<DCObject>();
+         owners.set(dcObject->getOwnerId(), objects);
+      }
+      objects->add(dueObjects.getShared(i));
+   }
+
+   owners.forEach(
+      [watchdogId] (const uint32_t& ownerId, SharedObjectArray<DCObject> *objects) -> EnumerationCallbackResult
+      {
+         if (IsShutdownInProgress())
+            return _STOP;
+
+         shared_ptr<NetObj> owner = FindObjectById(ownerId);
+         if ((owner != nullptr) && owner->isDataCollectionTarget())
+         {
+            WatchdogNotify(watchdogId);
+            nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 8, _T("ItemPoller: calling DataCollectionTarget::queueItemsForPolling for object %s [%u] (%d objects)"), owner->getName(), ownerId, objects->size());
+            static_cast<DataCollectionTarget&>(*owner).queueItemsForPolling(*objects);
+         }
+         return _CONTINUE;
+      });
+}
+
+/**
+ * Item poller thread: check DCIs which are due according to schedule and put into the
  * data collector queue when data polling required
  */
 static void ItemPoller()
@@ -502,16 +677,7 @@ static void ItemPoller()
       nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 8, _T("ItemPoller: wakeup"));
 
       int64_t startTime = GetCurrentTimeMs();
-      g_idxAccessPointById.forEach(QueueItems, &watchdogId);
-      g_idxChassisById.forEach(QueueItems, &watchdogId);
-      g_idxCircuitById.forEach(QueueItems, &watchdogId);
-      g_idxCloudDomainById.forEach(QueueItems, &watchdogId);
-      g_idxClusterById.forEach(QueueItems, &watchdogId);
-      g_idxCollectorById.forEach(QueueItems, &watchdogId);
-		g_idxMobileDeviceById.forEach(QueueItems, &watchdogId);
-      g_idxNodeById.forEach(QueueItems, &watchdogId);
-		g_idxResourceById.forEach(QueueItems, &watchdogId);
-      g_idxSensorById.forEach(QueueItems, &watchdogId);
+      QueueScheduledItems(static_cast<time_t>(startTime / 1000), watchdogId);
 
 		queuingTime.update(static_cast<uint32_t>(GetCurrentTimeMs() - startTime));
 		g_averageDCIQueuingTime = static_cast<uint32_t>(queuingTime.getAverage());
@@ -541,6 +707,7 @@ static void CacheLoader()
             nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 6, _T("Loading cache for DCI %s [%d] on %s [%d]"),
                      ref->getName(), ref->getId(), object->getName(), object->getId());
             static_cast<DCItem*>(dci.get())->reloadCache(false);
+            ScheduleDataCollection(dci, time(nullptr));
          }
       }
    }
@@ -561,10 +728,30 @@ void InitDataCollector()
    g_dataCollectorThreadPool = ThreadPoolCreate(L"DATACOLL",
             ConfigReadInt(L"ThreadPool.DataCollector.BaseSize", 10),
             ConfigReadInt(L"ThreadPool.DataCollector.MaxSize", 250),
-            256 * 1024);
+            256 * 1024,
+            ConfigReadBoolean(L"ThreadPool.DataCollector.WorkStealing", false) ? THREAD_POOL_WORK_STEALING : 0);
 
    g_thresholdRepeatPool = ThreadPoolCreate(L"THREVT", 2, 4);
 
+   g_snmpRequestCoalescing = ConfigReadBoolean(L"DataCollection.SNMP.RequestCoalescing", false);
+   g_snmpMaxVarbindsPerRequest = std::max(ConfigReadInt(L"DataCollection.SNMP.MaxVarbindsPerRequest", 16), 1);
+   if (g_snmpRequestCoalescing)
+      nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 2, _T("SNMP request coalescing enabled (up to %d varbinds per request)"), g_snmpMaxVarbindsPerRequest);
+
+   if (ConfigReadBoolean(L"DataCollection.SNMP.UseAsyncEngine", false))
+   {
+      s_snmpAsyncEngine = new SNMP_AsyncEngine(ConfigReadInt(L"DataCollection.SNMP.AsyncEngineSockets", 4), g_dataCollectorThreadPool);
+      if (s_snmpAsyncEngine->start())
+      {
+         nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 2, _T("Asynchronous SNMP engine enabled for data collection"));
+      }
+      else
+      {
+         nxlog_write_tag(NXLOG_WARNING, DEBUG_TAG_DC_POLLER, _T("Cannot start asynchronous SNMP engine, synchronous SNMP data collection will be used"));
+         delete_and_null(s_snmpAsyncEngine);
+      }
+   }
+
    s_itemPollerThread = ThreadCreateEx(ItemPoller);
    s_cacheLoaderThread = ThreadCreateEx(CacheLoader);
 
@@ -578,6 +765,11 @@ void StopDataCollection()
 {
    ThreadJoin(s_itemPollerThread);
    ThreadJoin(s_cacheLoaderThread);
+   if (s_snmpAsyncEngine != nullptr)
+   {
+      s_snmpAsyncEngine->stop();   // Pending requests will be completed on data collector thread pool
+      delete_and_null(s_snmpAsyncEngine);
+   }
    ThreadPoolDestroy(g_dataCollectorThreadPool);
    ThreadPoolDestroy(g_thresholdRepeatPool);
 }
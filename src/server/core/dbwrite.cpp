@@ -103,6 +103,11 @@ static void WriterQueueElementDestructor(void *element, Queue *queue)
  */
 ObjectQueue<DELAYED_SQL_REQUEST> g_dbWriterQueue(1024, Ownership::True, WriterQueueElementDestructor);
 
+/**
+ * Hourly aggregate writer queue
+ */
+static ObjectQueue<DCIAggregateRecord> s_aggregateWriterQueue(1024, Ownership::True);
+
 /**
  * Raw DCI data writer queue
  */
@@ -129,6 +134,7 @@ static Condition s_queueMonitorStopCondition(true);
  */
 static THREAD s_writerThread = INVALID_THREAD_HANDLE;
 static THREAD s_rawDataWriterThread = INVALID_THREAD_HANDLE;
+static THREAD s_aggregateWriterThread = INVALID_THREAD_HANDLE;
 static THREAD s_queueMonitorThread = INVALID_THREAD_HANDLE;
 
 /**
@@ -306,6 +312,15 @@ void QueueRawDciDataDelete(uint32_t dciId)
    s_rawDataWriterLock.unlock();
 }
 
+/**
+ * Queue UPSERT request for completed in-memory hourly aggregate. Queue takes ownership of the record.
+ */
+void QueueHourlyAggregateUpsert(DCIAggregateRecord *record)
+{
+   s_aggregateWriterQueue.put(record);
+   InterlockedIncrement64(&g_otherWriteRequests);
+}
+
 /**
  * Database "lazy" write thread
  */
@@ -532,6 +547,31 @@ static void IDataWriteThreadSingleTable_Generic(IDataWriter *writer)
    }
 }
 
+/**
+ * Append idata record to multi-row INSERT statement for PostgreSQL
+ */
+static inline void AppendIDataRecord_PostgreSQL(StringBuffer& query, DELAYED_IDATA_INSERT *rq, bool convertTimestamps, bool first)
+{
+   query.append(first ? _T(" (") : _T(",("), 2);
+   query.append(rq->dciId);
+   if (convertTimestamps)
+   {
+      query.append(L",ms_to_timestamptz(", 19);
+      query.append(rq->timestamp);
+      query.append(L"),", 2);
+   }
+   else
+   {
+      query.append(L',');
+      query.append(rq->timestamp);
+      query.append(L',');
+   }
+   query.append(DBPrepareString(g_dbDriver, rq->transformedValue));
+   query.append(L',');
+   query.append(DBPrepareString(g_dbDriver, rq->rawValue));
+   query.append(L')');
+}
+
 /**
  * Prepared PostgreSQL INSERT statement
  */
@@ -580,24 +620,7 @@ static void QueryPrepareThread_PostgreSQL(IDataWriter *writer, ObjectQueue<Prepa
       int count = 0;
       while(true)
       {
-         query.append((count > 0) ? _T(",(") : _T(" ("), 2);
-         query.append(rq->dciId);
-         if (convertTimestamps)
-         {
-            query.append(L",ms_to_timestamptz(", 19);
-            query.append(rq->timestamp);
-            query.append(L"),", 2);
-         }
-         else
-         {
-            query.append(L',');
-            query.append(rq->timestamp);
-            query.append(L',');
-         }
-         query.append(DBPrepareString(g_dbDriver, rq->transformedValue));
-         query.append(L',');
-         query.append(DBPrepareString(g_dbDriver, rq->rawValue));
-         query.append(L')');
+         AppendIDataRecord_PostgreSQL(query, rq, convertTimestamps, count == 0);
          MemFree(rq);
 
          count++;
@@ -752,6 +775,196 @@ static void IDataWriteThreadSingleTable_PostgreSQL(IDataWriter *writer)
       ThreadPoolDestroy(writerPool);
 }
 
+/**
+ * Insert idata records with single multi-row INSERT statement which ignores conflicting records
+ */
+static bool InsertIDataRecords_PostgreSQL(DB_HANDLE hdb, StringBuffer& query, const TCHAR *table, DELAYED_IDATA_INSERT **records, int count, bool convertTimestamps)
+{
+   query.clear(false);
+   query.append(_T("INSERT INTO "));
+   query.append(table);
+   query.append(_T(" (item_id,idata_timestamp,idata_value,raw_value) VALUES"));
+   for(int i = 0; i < count; i++)
+      AppendIDataRecord_PostgreSQL(query, records[i], convertTimestamps, i == 0);
+   query.append(L" ON CONFLICT DO NOTHING");
+   return DBQuery(hdb, query);
+}
+
+/**
+ * Write batch of idata records using bulk load (COPY for PostgreSQL). If bulk load fails (for example,
+ * because batch contains records already present in database) records are written with multi-row
+ * INSERT statements which ignore conflicting records. Failed statement aborts whole transaction on
+ * PostgreSQL, so if any of them fails, transaction is rolled back and each statement is retried on
+ * its own, so that only records from failing statements are lost.
+ */
+static void WriteIDataBatch_BulkLoad(IDataWriter *writer, DELAYED_IDATA_INSERT **batch, int count, const TCHAR *table, bool idataLock, int maxRecordsPerStmt)
+{
+   if (idataLock)
+      s_idataWriteLock.readLock();
+
+   DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+
+   bool success = false;
+   DB_BULK_LOAD hBulkLoad = DBBulkLoadBegin(hdb, table, _T("item_id,idata_timestamp,idata_value,raw_value"));
+   if (hBulkLoad != nullptr)
+   {
+      for(int i = 0; i < count; i++)
+      {
+         DELAYED_IDATA_INSERT *rq = batch[i];
+         DBBulkLoadBind(hBulkLoad, 1, rq->dciId);
+         DBBulkLoadBind(hBulkLoad, 2, rq->timestamp);
+         DBBulkLoadBind(hBulkLoad, 3, rq->transformedValue, DB_BIND_STATIC);
+         DBBulkLoadBind(hBulkLoad, 4, rq->rawValue, DB_BIND_STATIC);
+         if (!DBBulkLoadAddRow(hBulkLoad))
+            break;
+      }
+      success = DBBulkLoadEnd(hBulkLoad);
+   }
+
+   if (!success)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 5, _T("Bulk load of %d records into %s failed, falling back to INSERT statements"), count, table);
+
+      bool convertTimestamps = (writer->storageClass != nullptr);
+      StringBuffer query;
+      query.setAllocationStep(65536);
+      if (DBBegin(hdb))
+      {
+         for(int i = 0; i < count; i += maxRecordsPerStmt)
+         {
+            success = InsertIDataRecords_PostgreSQL(hdb, query, table, &batch[i], std::min(maxRecordsPerStmt, count - i), convertTimestamps);
+            if (!success)
+               break;
+         }
+         if (success)
+            DBCommit(hdb);
+         else
+            DBRollback(hdb);
+      }
+
+      if (!success)
+      {
+         nxlog_debug_tag(DEBUG_TAG, 5, _T("Transactional insert of %d records into %s failed, retrying each statement separately"), count, table);
+         int lostRecords = 0;
+         for(int i = 0; i < count; i += maxRecordsPerStmt)
+         {
+            int n = std::min(maxRecordsPerStmt, count - i);
+            if (!InsertIDataRecords_PostgreSQL(hdb, query, table, &batch[i], n, convertTimestamps))
+               lostRecords += n;
+         }
+         if (lostRecords > 0)
+            nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG, _T("Failed to write %d of %d DCI data records into %s"), lostRecords, count, table);
+      }
+   }
+
+   DBConnectionPoolReleaseConnection(hdb);
+
+   if (idataLock)
+      s_idataWriteLock.unlock();
+
+   for(int i = 0; i < count; i++)
+      MemFree(batch[i]);
+   InterlockedAdd(&writer->pendingRequests, -count);
+}
+
+/**
+ * Database "lazy" write thread for idata INSERTs - bulk load version (PostgreSQL and TimescaleDB)
+ */
+static void IDataWriteThreadSingleTable_BulkLoad(IDataWriter *writer)
+{
+   ThreadSetName("DBWriter/IData");
+
+   bool idataLock;
+   if (writer->storageClass == nullptr)   // Lock is not needed for TimescaleDB
+      idataLock = ((g_flags & AF_DBWRITER_HK_INTERLOCK) != 0);
+   else
+      idataLock = false;
+
+   int maxRecordsPerTxn = ConfigReadInt(_T("DBWriter.MaxRecordsPerTransaction"), 1000);
+   if (maxRecordsPerTxn < 1)
+      maxRecordsPerTxn = 1;
+   int maxRecordsPerStmt = ConfigReadInt(_T("DBWriter.MaxRecordsPerStatement"), 100);
+   if (maxRecordsPerStmt < 1)
+      maxRecordsPerStmt = 1;
+
+   TCHAR table[64];
+   if (writer->storageClass != nullptr)   // TimescaleDB
+      _sntprintf(table, 64, _T("idata_sc_%s"), writer->storageClass);
+   else
+      _tcscpy(table, _T("idata"));
+
+   ThreadPool *writerPool = nullptr;
+   int numWriters = ConfigReadInt(L"DBWriter.InsertParallelismDegree", 1);
+   if (numWriters > 1)
+   {
+      if (!idataLock)
+      {
+         TCHAR poolName[64] = _T("DBWRITE");
+         if (writer->storageClass != nullptr)
+         {
+            _tcscat(poolName, _T("/"));
+            _tcscat(poolName, writer->storageClass);
+            _tcsupr(poolName);
+         }
+         writerPool = ThreadPoolCreate(poolName, numWriters, numWriters);
+         nxlog_write_tag(NXLOG_INFO, DEBUG_TAG, _T("Using parallel bulk load mode for idata (%d writers)"), numWriters);
+      }
+      else
+      {
+         nxlog_write_tag(NXLOG_WARNING, DEBUG_TAG, _T("Parallel write disabled because DBWriter/Housekeeper interlock is ON"));
+      }
+   }
+
+   while(true)
+   {
+      DELAYED_IDATA_INSERT *rq = writer->queue->getOrBlock();
+      if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
+         break;
+
+      if (HACheckFence())
+      {
+         MemFree(rq);
+         break;   // node fenced - no further role-sensitive work
+      }
+
+      DELAYED_IDATA_INSERT **batch = MemAllocArrayNoInit<DELAYED_IDATA_INSERT*>(maxRecordsPerTxn);
+      int count = 0;
+      batch[count++] = rq;
+      while(count < maxRecordsPerTxn)
+      {
+         rq = writer->queue->getOrBlock(500);
+         if ((rq == nullptr) || (rq == INVALID_POINTER_VALUE))
+            break;
+         batch[count++] = rq;
+      }
+      InterlockedAdd(&writer->pendingRequests, count);
+
+      if (writerPool != nullptr)
+      {
+         ThreadPoolExecute(writerPool,
+            [writer, batch, count, &table, idataLock, maxRecordsPerStmt] ()
+            {
+               WriteIDataBatch_BulkLoad(writer, batch, count, table, idataLock, maxRecordsPerStmt);
+               MemFree(batch);
+            });
+      }
+      else
+      {
+         WriteIDataBatch_BulkLoad(writer, batch, count, table, idataLock, maxRecordsPerStmt);
+         MemFree(batch);
+      }
+
+      if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
+         break;
+
+      if (HACheckFence())
+         break;   // node fenced - no further role-sensitive work
+   }
+
+   if (writerPool != nullptr)
+      ThreadPoolDestroy(writerPool);
+}
+
 /**
  * Database "lazy" write thread for idata INSERTs - Oracle version
  */
@@ -960,6 +1173,46 @@ static void RawDataWriteThread()
    nxlog_debug_tag(DEBUG_TAG, 1, L"Raw DCI data writer stopped");
 }
 
+/**
+ * Database "lazy" write thread for in-memory hourly aggregates. Records are collected into
+ * batches, so that aggregates for all DCIs closing the same hour are written together.
+ */
+static void AggregateWriteThread()
+{
+   ThreadSetName("DBWriter/Aggr");
+   int maxRecords = ConfigReadInt(L"DBWriter.MaxRecordsPerTransaction", 1000);
+
+   ObjectArray<DCIAggregateRecord> batch(maxRecords, 1024, Ownership::True);
+   while(true)
+   {
+      DCIAggregateRecord *rq = s_aggregateWriterQueue.getOrBlock();
+      if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
+         break;
+
+      if (HACheckFence())
+      {
+         delete rq;
+         break;   // node fenced - no further role-sensitive work
+      }
+
+      batch.add(rq);
+      while(batch.size() < maxRecords)
+      {
+         rq = s_aggregateWriterQueue.getOrBlock(500);
+         if ((rq == nullptr) || (rq == INVALID_POINTER_VALUE))
+            break;
+         batch.add(rq);
+      }
+
+      SaveHourlyAggregates(&batch);
+      batch.clear();
+
+      if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
+         break;
+   }
+   nxlog_debug_tag(DEBUG_TAG, 1, L"Hourly aggregate writer stopped");
+}
+
 /**
  * Queue monitor thread
  */
@@ -1013,9 +1266,20 @@ void StartDBWriter()
 {
    s_writerThread = ThreadCreateEx(DBWriteThread);
 	s_rawDataWriterThread = ThreadCreateEx(RawDataWriteThread);
+	s_aggregateWriterThread = ThreadCreateEx(AggregateWriteThread);
 
 	if (g_flags & AF_SINGLE_TABLE_PERF_DATA)
 	{
+      bool useBulkLoad = false;
+      if (((g_dbSyntax == DB_SYNTAX_PGSQL) || (g_dbSyntax == DB_SYNTAX_TSDB)) && ConfigReadBoolean(_T("DBWriter.UseBulkLoad"), false))
+      {
+         useBulkLoad = DBIsBulkLoadSupported(g_dbDriver);
+         if (useBulkLoad)
+            nxlog_write_tag(NXLOG_INFO, DEBUG_TAG, _T("Using bulk load for DCI data writes"));
+         else
+            nxlog_write_tag(NXLOG_WARNING, DEBUG_TAG, _T("Bulk load for DCI data writes is enabled in configuration but not supported by database driver"));
+      }
+
 	   // Always use single writer if performance data stored in single table
       switch(g_dbSyntax)
       {
@@ -1029,9 +1293,17 @@ void StartDBWriter()
          case DB_SYNTAX_PGSQL:
             s_idataWriters[0].storageClass = nullptr;
             s_idataWriters[0].queue = new ObjectQueue<DELAYED_IDATA_INSERT>(4096, Ownership::True, QueuedRequestDestructor);
-            s_idataWriters[0].thread = ThreadCreateEx(IDataWriteThreadSingleTable_PostgreSQL, &s_idataWriters[0]);
-            s_idataWriters[0].workerCount = ConfigReadInt(_T("DBWriter.BackgroundWorkers"), 1);
             s_idataWriters[0].pendingRequests = 0;
+            if (useBulkLoad)
+            {
+               s_idataWriters[0].thread = ThreadCreateEx(IDataWriteThreadSingleTable_BulkLoad, &s_idataWriters[0]);
+               s_idataWriters[0].workerCount = 0;
+            }
+            else
+            {
+               s_idataWriters[0].thread = ThreadCreateEx(IDataWriteThreadSingleTable_PostgreSQL, &s_idataWriters[0]);
+               s_idataWriters[0].workerCount = ConfigReadInt(_T("DBWriter.BackgroundWorkers"), 1);
+            }
             break;
          case DB_SYNTAX_TSDB:
             s_idataWriterCount = static_cast<int>(DCObjectStorageClass::OTHER) + 1;
@@ -1039,9 +1311,17 @@ void StartDBWriter()
             {
                s_idataWriters[i].storageClass = DCObject::getStorageClassName(static_cast<DCObjectStorageClass>(i));
                s_idataWriters[i].queue = new ObjectQueue<DELAYED_IDATA_INSERT>(4096, Ownership::True, QueuedRequestDestructor);
-               s_idataWriters[i].thread = ThreadCreateEx(IDataWriteThreadSingleTable_PostgreSQL, &s_idataWriters[i]);
-               s_idataWriters[i].workerCount = ConfigReadInt(_T("DBWriter.BackgroundWorkers"), 1);
                s_idataWriters[i].pendingRequests = 0;
+               if (useBulkLoad)
+               {
+                  s_idataWriters[i].thread = ThreadCreateEx(IDataWriteThreadSingleTable_BulkLoad, &s_idataWriters[i]);
+                  s_idataWriters[i].workerCount = 0;
+               }
+               else
+               {
+                  s_idataWriters[i].thread = ThreadCreateEx(IDataWriteThreadSingleTable_PostgreSQL, &s_idataWriters[i]);
+                  s_idataWriters[i].workerCount = ConfigReadInt(_T("DBWriter.BackgroundWorkers"), 1);
+               }
             }
             break;
          default:
@@ -1099,6 +1379,9 @@ void StopDBWriter()
    }
    ThreadJoin(s_rawDataWriterThread);
 
+   s_aggregateWriterQueue.put(INVALID_POINTER_VALUE);
+   ThreadJoin(s_aggregateWriterThread);
+
    nxlog_debug_tag(DEBUG_TAG, 1, _T("All background database writers stopped"));
 }
 
@@ -21,6 +21,7 @@
 **/
 
 #include "nxcore.h"
+#include <pdsdrv.h>
 
 /**
  * Convert last value of DCI (item or table) into NXSL value.
@@ -480,6 +481,34 @@ NXSL_Value *GetDCItemValuesForNXSL(NXSL_VM *vm, DCObject *dci, DataCollectionTar
    DciTier resolvedTier = ResolveDciTier(requestedTier, *dci, DCO_TYPE_ITEM, startMs, endMs,
             target->getRuntimeFlags(), autoSelectThreshold);
 
+   // Processed values can be served by performance data storage driver with read capability
+   if (!rawValue && (g_flags & AF_PERFDATA_STORAGE_DRIVER_LOADED))
+   {
+      StructArray<PerfDataPoint> points(0, 1024);
+      if (ReadDataFromPerfDataStorage(static_cast<DCItem&>(*dci), resolvedTier, aggFunction, 0, startMs, endMs, MAX_DCI_DATA_RECORDS, &points))
+      {
+         // Tier values are always floating point, same as database aggregate columns
+         int dataType = (resolvedTier != DCI_TIER_RAW) ? DCI_DT_FLOAT : static_cast<DCItem*>(dci)->getTransformedDataType();
+         wchar_t buffer[64];
+         NXSL_Array *array = new NXSL_Array(vm);
+         for(int i = 0; i < points.size(); i++)
+         {
+            const PerfDataPoint *p = points.get(i);
+            FormatPerfDataPointValue(*p, dataType, buffer);
+            if (asDataPoints)
+            {
+               auto data = new std::pair<time_t, String>(static_cast<time_t>(p->timestamp.asMilliseconds()), String(buffer));
+               array->set(i, vm->createValue(vm->createObject(&g_nxslDataPointClass, data)));
+            }
+            else
+            {
+               array->set(i, vm->createValue(buffer));
+            }
+         }
+         return vm->createValue(array);
+      }
+   }
+
    DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
 
    DB_STATEMENT hStmt = nullptr;
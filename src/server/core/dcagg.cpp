@@ -203,6 +203,262 @@ static inline int64_t FloorToBucket(int64_t timestampMs, int64_t bucketSizeMs)
    return (timestampMs / bucketSizeMs) * bucketSizeMs;
 }
 
+/**
+ * Parse stored DCI value as number for in-memory aggregation. Accepts same format as the
+ * numeric filter used by SQL rollup (^[-+]?[0-9]*\.?[0-9]+([eE][-+]?[0-9]+)?$), so both
+ * paths aggregate the same set of samples.
+ */
+bool NXCORE_EXPORTABLE ParseAggregateValue(const wchar_t *text, double *value)
+{
+   const wchar_t *p = text;
+   if ((*p == L'-') || (*p == L'+'))
+      p++;
+   const wchar_t *mantissa = p;
+   while(iswdigit(*p))
+      p++;
+   if (*p == L'.')
+   {
+      p++;
+      const wchar_t *fraction = p;
+      while(iswdigit(*p))
+         p++;
+      if (p == fraction)
+         return false;   // Decimal point must be followed by at least one digit
+   }
+   else if (p == mantissa)
+   {
+      return false;
+   }
+   if ((*p == L'e') || (*p == L'E'))
+   {
+      p++;
+      if ((*p == L'-') || (*p == L'+'))
+         p++;
+      const wchar_t *exponent = p;
+      while(iswdigit(*p))
+         p++;
+      if (p == exponent)
+         return false;
+   }
+   if (*p != 0)
+      return false;
+   *value = wcstod(text, nullptr);
+   return true;
+}
+
+/**
+ * Add stored value to hourly aggregate bucket. When value opens new bucket, current bucket
+ * is closed and, if it was complete (opened by rollover rather than by the first value seen
+ * after server start), written into "closed" and true is returned. In that case all stored
+ * values since the start of closed bucket were seen, so watermark is moved to the start of
+ * new bucket if it does not point to earlier data not rolled up yet (closed->watermark is set
+ * to new watermark or 0 if it was not changed). Values for already closed buckets are ignored
+ * (they are left to the hourly rollup).
+ */
+bool DCIAggregateBucket::update(int64_t timestampMs, const wchar_t *value, int64_t *watermark, DCIAggregateRecord *closed)
+{
+   int64_t bucketStart = FloorToBucket(timestampMs, ONE_HOUR_MS);
+   if (bucketStart < start)
+      return false;
+
+   bool hasClosed = false;
+   if (bucketStart > start)
+   {
+      if (complete)
+      {
+         closed->bucketStart = start;
+         closed->minValue = minValue;
+         closed->maxValue = maxValue;
+         closed->avgValue = (count > 0) ? sum / count : 0;
+         closed->sampleCount = count;
+         if ((*watermark == 0) || ((*watermark >= start) && (*watermark < bucketStart)))
+         {
+            *watermark = bucketStart;
+            closed->watermark = bucketStart;
+         }
+         else
+         {
+            closed->watermark = 0;   // Earlier data not rolled up yet - leave it to the hourly rollup
+         }
+         hasClosed = (closed->sampleCount > 0) || (closed->watermark != 0);
+      }
+      reset(bucketStart, start != 0);
+   }
+
+   double v;
+   if (!ParseAggregateValue(value, &v))
+      return hasClosed;
+
+   if (count == 0)
+   {
+      minValue = v;
+      maxValue = v;
+   }
+   else
+   {
+      if (v < minValue)
+         minValue = v;
+      if (v > maxValue)
+         maxValue = v;
+   }
+   sum += v;
+   count++;
+   return hasClosed;
+}
+
+/**
+ * Add stored value to in-memory hourly aggregate and queue closed bucket for writing
+ * (see DCIAggregateBucket::update).
+ *
+ * Must be called with the DCItem mutex held.
+ */
+void DCItem::updateHourlyAggregate(uint32_t objectId, int64_t timestampMs, const wchar_t *value)
+{
+   if (!isHourlyAggregationEligible())
+      return;
+
+   DCIAggregateRecord closed;
+   if (m_hourlyAggregate.update(timestampMs, value, &m_aggregationWatermark, &closed))
+   {
+      closed.objectId = objectId;
+      closed.dciId = m_id;
+      QueueHourlyAggregateUpsert(new DCIAggregateRecord(closed));
+   }
+}
+
+/**
+ * Compare aggregate records by object ID
+ */
+static int CompareAggregateRecords(const DCIAggregateRecord **r1, const DCIAggregateRecord **r2)
+{
+   return ((*r1)->objectId < (*r2)->objectId) ? -1 : (((*r1)->objectId > (*r2)->objectId) ? 1 : 0);
+}
+
+/**
+ * Get current in-memory aggregation watermark of given DCI (0 if DCI not found)
+ */
+static int64_t GetAggregationWatermark(const NetObj& object, uint32_t dciId)
+{
+   shared_ptr<DCObject> dci = static_cast<const DataCollectionTarget&>(object).getDCObjectById(dciId, 0);
+   return ((dci != nullptr) && (dci->getType() == DCO_TYPE_ITEM)) ? static_cast<DCItem&>(*dci).getAggregationWatermark() : 0;
+}
+
+/**
+ * Write batch of hourly aggregates accumulated in memory (called by database writer).
+ * Records are grouped by object so that each object's UPSERT statement is prepared once,
+ * and written together with watermark updates in one transaction per object.
+ *
+ * Watermark stored in database is advanced only if in-memory watermark still has the value
+ * set when bucket was closed. Late data for closed bucket moves in-memory watermark back,
+ * but that push-back does not change database value (which is not past closed bucket yet),
+ * so advancing database watermark in that case would lose late data after server restart.
+ */
+void SaveHourlyAggregates(ObjectArray<DCIAggregateRecord> *records)
+{
+   records->sort(CompareAggregateRecords);
+
+   DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+   DB_STATEMENT hWatermark = DBPrepare(hdb,
+      L"UPDATE items SET aggregation_watermark=? "
+      L"WHERE item_id=? AND (aggregation_watermark IS NULL OR aggregation_watermark=0 OR aggregation_watermark>=?)", true);
+
+   int upsertCount = 0;
+   int start = 0;
+   while(start < records->size())
+   {
+      uint32_t objectId = records->get(start)->objectId;
+      int end = start + 1;
+      while((end < records->size()) && (records->get(end)->objectId == objectId))
+         end++;
+
+      bool success = false;
+      int groupUpsertCount = 0;
+      shared_ptr<NetObj> object = FindObjectById(objectId);
+      if ((hWatermark != nullptr) && (object != nullptr) && object->isDataCollectionTarget() &&
+          static_cast<DataCollectionTarget&>(*object).ensureAggregateTable(hdb, true) && DBBegin(hdb))
+      {
+         wchar_t upsertSql[1024];
+         BuildAggregateUpsert(upsertSql, 1024, L"1h", objectId);
+         DB_STATEMENT hUpsert = DBPrepare(hdb, upsertSql, (end - start) > 1);
+         if (hUpsert != nullptr)
+         {
+            success = true;
+            for(int i = start; (i < end) && success; i++)
+            {
+               DCIAggregateRecord *r = records->get(i);
+               if (r->sampleCount > 0)
+               {
+                  if (ExecuteAggregateUpsert(hUpsert, r->dciId, r->bucketStart, r->minValue, r->maxValue, r->avgValue, r->sampleCount))
+                  {
+                     groupUpsertCount++;
+                  }
+                  else
+                  {
+                     nxlog_debug_tag(DEBUG_TAG, 4, L"Hourly UPSERT failed for DCI [%u] bucket " INT64_FMT, r->dciId, r->bucketStart);
+                     success = false;
+                  }
+               }
+               if (success && (r->watermark != 0) && (GetAggregationWatermark(*object, r->dciId) == r->watermark))
+               {
+                  DBBind(hWatermark, 1, DB_SQLTYPE_BIGINT, r->watermark);
+                  DBBind(hWatermark, 2, DB_SQLTYPE_INTEGER, r->dciId);
+                  DBBind(hWatermark, 3, DB_SQLTYPE_BIGINT, r->bucketStart);
+                  success = DBExecute(hWatermark);
+               }
+            }
+            DBFreeStatement(hUpsert);
+         }
+         if (success)
+            success = DBCommit(hdb);
+         else
+            DBRollback(hdb);
+      }
+
+      if (success)
+      {
+         upsertCount += groupUpsertCount;
+
+         // Late data could arrive after in-memory watermark check and before commit
+         for(int i = start; i < end; i++)
+         {
+            DCIAggregateRecord *r = records->get(i);
+            if (r->watermark == 0)
+               continue;
+            int64_t watermark = GetAggregationWatermark(*object, r->dciId);
+            if ((watermark > 0) && (watermark < r->watermark))
+            {
+               wchar_t query[256];
+               nx_swprintf(query, 256,
+                  L"UPDATE items SET aggregation_watermark=" INT64_FMT
+                  L" WHERE item_id=%u AND (aggregation_watermark IS NULL OR aggregation_watermark>" INT64_FMT L")",
+                  watermark, r->dciId, watermark);
+               QueueSQLRequest(query);
+            }
+         }
+      }
+      else if ((object != nullptr) && object->isDataCollectionTarget())
+      {
+         // Watermark was advanced in memory when bucket was closed; move it back so that
+         // hourly rollup will aggregate these buckets from raw data
+         nxlog_debug_tag(DEBUG_TAG, 4, L"Cannot write in-memory hourly aggregates for object %s [%u], watermark reverted", object->getName(), objectId);
+         for(int i = start; i < end; i++)
+         {
+            DCIAggregateRecord *r = records->get(i);
+            shared_ptr<DCObject> dci = static_cast<DataCollectionTarget&>(*object).getDCObjectById(r->dciId, 0);
+            if ((dci != nullptr) && (dci->getType() == DCO_TYPE_ITEM))
+               static_cast<DCItem&>(*dci).restoreAggregationWatermark(r->bucketStart);
+         }
+      }
+      start = end;
+   }
+
+   if (hWatermark != nullptr)
+      DBFreeStatement(hWatermark);
+   DBConnectionPoolReleaseConnection(hdb);
+
+   nxlog_debug_tag(DEBUG_TAG, 7, L"%d in-memory hourly aggregates written (%d records in batch)", upsertCount, records->size());
+}
+
 /**
  * Build SELECT statement for reading raw idata_<N> values grouped into buckets of
  * bucketSizeMs. Returns rows (bucket_start, min, max, avg, count) for buckets with
@@ -303,7 +559,9 @@ static void BuildHourlyToDailySelect(wchar_t *query, size_t size, uint32_t objec
  *
  * Start is taken from the DCI's in-memory watermark. 0/null means "fresh DCI" and starts
  * from the most recent closed bucket. End is aligned to bucket boundary and capped at
- * now - HourlyCloseWindow so partial buckets stay open.
+ * now - HourlyCloseWindow so partial buckets stay open. Buckets written from in-memory
+ * aggregates already moved the watermark past them, so normally this only reconciles
+ * ranges left after server restart or pushed back by late data.
  */
 static int64_t RollupHourlyForDCI(DB_HANDLE hdb, DataCollectionTarget *target, DCItem *dci, int64_t nowMs, int64_t hourlyCloseWindowMs)
 {
@@ -580,7 +838,9 @@ static void AdvanceAggregationWatermark(DCItem *dci, int64_t expectedStart, int6
 /**
  * Scheduled task handler - hourly DCI data aggregation rollup.
  *
- * Runs at :05 past each hour. For every eligible DCI:
+ * Runs at :05 past each hour. Most buckets are written from in-memory aggregates as values
+ * are processed (see DCItem::updateHourlyAggregate), and DCIs whose watermark is already
+ * past the cutoff are skipped without reading raw data. For every other eligible DCI:
  *   - read raw idata_<N> rows within [watermark, now - HourlyCloseWindow)
  *   - group into 1-hour buckets, skip empty buckets
  *   - UPSERT non-empty buckets into idata_1h_<N>
@@ -21,6 +21,7 @@
 **/
 
 #include "nxcore.h"
+#include <pdsdrv.h>
 
 #define SELECTION_COLUMNS (historicalDataType != HDT_RAW) ? tablePrefix : _T(""), (historicalDataType == HDT_RAW_AND_PROCESSED) ? _T("_value,raw_value") : ((historicalDataType == HDT_PROCESSED) || (historicalDataType == HDT_FULL_TABLE)) ?  _T("_value") : _T("raw_value")
 
@@ -406,3 +407,52 @@ DciTier NXCORE_EXPORTABLE ResolveDciTier(DciTier requested, const DCObject& dci,
       return DCI_TIER_HOURLY;
    return DCI_TIER_RAW;
 }
+
+/**
+ * Read DCI history from performance data storage driver which declares read capability instead of
+ * database. Tier reads are mapped to hourly or daily buckets; for raw tier bucketSizeMs selects on-the-fly
+ * aggregation (0 to read raw values). Only processed values of numeric DCIs can be read from drivers.
+ * Returns false if request should be served from database.
+ */
+bool NXCORE_EXPORTABLE ReadDataFromPerfDataStorage(const DCItem& dci, DciTier tier, DciAggregationFunction function, int64_t bucketSizeMs,
+         int64_t timeFrom, int64_t timeTo, uint32_t maxRows, StructArray<PerfDataPoint> *values)
+{
+   if (!(g_flags & AF_PERFDATA_STORAGE_DRIVER_LOADED) || (dci.getTransformedDataType() == DCI_DT_STRING))
+      return false;
+
+   int64_t bucketSize;
+   if (tier == DCI_TIER_HOURLY)
+      bucketSize = 3600LL * 1000;
+   else if (tier == DCI_TIER_DAILY)
+      bucketSize = 86400LL * 1000;
+   else
+      bucketSize = bucketSizeMs;
+
+   return ReadDCItemValuesFromPerfDataStorage(dci, Timestamp::fromMilliseconds(timeFrom), Timestamp::fromMilliseconds(timeTo),
+            bucketSize, function, maxRows, values);
+}
+
+/**
+ * Format value of data point read from performance data storage driver as string according to DCI data type.
+ * Buffer should be at least 64 characters long.
+ */
+wchar_t NXCORE_EXPORTABLE *FormatPerfDataPointValue(const PerfDataPoint& p, int dataType, wchar_t *buffer)
+{
+   switch(dataType)
+   {
+      case DCI_DT_INT:
+      case DCI_DT_INT64:
+         IntegerToString(static_cast<int64_t>(p.value), buffer);
+         break;
+      case DCI_DT_UINT:
+      case DCI_DT_COUNTER32:
+      case DCI_DT_UINT64:
+      case DCI_DT_COUNTER64:
+         IntegerToString(static_cast<uint64_t>(p.value), buffer);
+         break;
+      default:
+         swprintf(buffer, 64, L"%f", p.value);
+         break;
+   }
+   return buffer;
+}
@@ -167,18 +167,9 @@ DCItem::DCItem(const DCItem *src, bool shadowCopy, bool copyThresholds) : DCObje
    m_transformedDataType = src->m_transformedDataType;
    m_deltaCalculation = src->m_deltaCalculation;
 	m_sampleCount = src->m_sampleCount;
-   m_cacheSize = shadowCopy ? src->m_cacheSize : 0;
    m_requiredCacheSize = shadowCopy ? src->m_requiredCacheSize : 0;
-   if (m_cacheSize > 0)
-   {
-      m_ppValueCache = MemAllocArray<ItemValue*>(m_cacheSize);
-      for(uint32_t i = 0; i < m_cacheSize; i++)
-         m_ppValueCache[i] = new ItemValue(*src->m_ppValueCache[i]);
-   }
-   else
-   {
-      m_ppValueCache = nullptr;
-   }
+   if (shadowCopy)
+      m_valueCache = src->m_valueCache;
    m_prevValueTimeStamp = shadowCopy ? src->m_prevValueTimeStamp : Timestamp::fromMilliseconds(0);
    m_prevDeltaValue = shadowCopy ? src->m_prevDeltaValue : 0;
    m_cacheLoaded = shadowCopy ? src->m_cacheLoaded : false;
@@ -202,6 +193,7 @@ DCItem::DCItem(const DCItem *src, bool shadowCopy, bool copyThresholds) : DCObje
    m_hourlyRetention = src->m_hourlyRetention;
    m_dailyRetention = src->m_dailyRetention;
    m_aggregationWatermark = shadowCopy ? src->m_aggregationWatermark : 0;
+   m_hourlyAggregate.reset(0, false);
 
    // Copy thresholds
 	if (copyThresholds && (src->getThresholdCount() > 0))
@@ -250,9 +242,7 @@ DCItem::DCItem(DB_HANDLE hdb, DB_STATEMENT *preparedStatements, DB_RESULT hResul
    m_instanceName = DBGetFieldAsSharedString(hResult, row, 11);
    m_templateItemId = DBGetFieldUInt32(hResult, row, 12);
    m_thresholds = nullptr;
-   m_cacheSize = 0;
    m_requiredCacheSize = 0;
-   m_ppValueCache = nullptr;
    m_prevValueTimeStamp = Timestamp::fromMilliseconds(0);
    m_prevDeltaValue = 0;
    m_cacheLoaded = false;
@@ -300,6 +290,7 @@ DCItem::DCItem(DB_HANDLE hdb, DB_STATEMENT *preparedStatements, DB_RESULT hResul
    m_hourlyRetention = DBGetFieldInt32(hResult, row, 48);
    m_dailyRetention = DBGetFieldInt32(hResult, row, 49);
    m_aggregationWatermark = DBGetFieldInt64(hResult, row, 50);
+   m_hourlyAggregate.reset(0, false);
    m_mappingTableId = DBGetFieldUInt32(hResult, row, 51);
    m_snmpAgentName = DBGetFieldAsSharedString(hResult, row, 52);
 
@@ -347,9 +338,7 @@ DCItem::DCItem(uint32_t id, const TCHAR *name, int source, int dataType, BYTE sc
    m_deltaCalculation = DCM_ORIGINAL_VALUE;
 	m_sampleCount = 0;
    m_thresholds = nullptr;
-   m_cacheSize = 0;
    m_requiredCacheSize = 0;
-   m_ppValueCache = nullptr;
    m_prevValueTimeStamp = Timestamp::fromMilliseconds(0);
    m_prevDeltaValue = 0;
    m_cacheLoaded = false;
@@ -371,6 +360,7 @@ DCItem::DCItem(uint32_t id, const TCHAR *name, int source, int dataType, BYTE sc
 	m_hourlyRetention = 0;
 	m_dailyRetention = 0;
 	m_aggregationWatermark = 0;
+	m_hourlyAggregate.reset(0, false);
 
    updateCacheSizeInternal(false);
 }
@@ -384,9 +374,7 @@ DCItem::DCItem(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& owner
    m_transformedDataType = (BYTE)config->getSubEntryValueAsInt(_T("transformedDataType"), 0, DCI_DT_NULL);
    m_deltaCalculation = (BYTE)config->getSubEntryValueAsInt(_T("delta"));
    m_sampleCount = (BYTE)config->getSubEntryValueAsInt(_T("samples"));
-   m_cacheSize = 0;
    m_requiredCacheSize = 0;
-   m_ppValueCache = nullptr;
    m_prevValueTimeStamp = Timestamp::fromMilliseconds(0);
    m_prevDeltaValue = 0;
    m_cacheLoaded = false;
@@ -407,6 +395,7 @@ DCItem::DCItem(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& owner
    m_hourlyRetention = config->getSubEntryValueAsInt(_T("hourlyRetention"));
    m_dailyRetention = config->getSubEntryValueAsInt(_T("dailyRetention"));
    m_aggregationWatermark = 0;
+   m_hourlyAggregate.reset(0, false);
    _tcslcpy(m_predictionEngine, config->getSubEntryValue(_T("predictionEngine"), 0, _T("")), MAX_NPE_NAME_LEN);
 
    // for compatibility with old format
@@ -442,9 +431,7 @@ DCItem::DCItem(json_t *json, const shared_ptr<DataCollectionOwner>& owner, Impor
    m_transformedDataType = static_cast<BYTE>(json_object_get_int32(json, "transformedDataType", DCI_DT_NULL));
    m_deltaCalculation = static_cast<BYTE>(json_object_get_int32(json, "delta"));
    m_sampleCount = static_cast<BYTE>(json_object_get_int32(json, "samples"));
-   m_cacheSize = 0;
    m_requiredCacheSize = 0;
-   m_ppValueCache = nullptr;
    m_prevValueTimeStamp = Timestamp::fromMilliseconds(0);
    m_prevDeltaValue = 0;
    m_cacheLoaded = false;
@@ -465,6 +452,7 @@ DCItem::DCItem(json_t *json, const shared_ptr<DataCollectionOwner>& owner, Impor
    m_hourlyRetention = json_object_get_int32(json, "hourlyRetention");
    m_dailyRetention = json_object_get_int32(json, "dailyRetention");
    m_aggregationWatermark = 0;
+   m_hourlyAggregate.reset(0, false);
 
    String predictionEngine = json_object_get_string(json, "predictionEngine", _T(""));
    _tcslcpy(m_predictionEngine, predictionEngine, MAX_NPE_NAME_LEN);
@@ -542,11 +530,7 @@ bool DCItem::deleteThresholdById(uint32_t thresholdId)
  */
 void DCItem::clearCache()
 {
-   for(uint32_t i = 0; i < m_cacheSize; i++)
-      delete m_ppValueCache[i];
-   MemFree(m_ppValueCache);
-   m_ppValueCache = nullptr;
-   m_cacheSize = 0;
+   m_valueCache.setCapacity(0);
 }
 
 /**
@@ -714,7 +698,7 @@ bool DCItem::saveToDatabase(DB_HANDLE hdb)
          DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, m_id);
          DBBind(hStmt, 2, DB_SQLTYPE_VARCHAR, m_prevRawValue.getString(), DB_BIND_STATIC, 255);
          DBBind(hStmt, 3, DB_SQLTYPE_BIGINT, m_prevValueTimeStamp);
-         DBBind(hStmt, 4, DB_SQLTYPE_BIGINT, (m_cacheLoaded  && (m_cacheSize > 0)) ? m_ppValueCache[m_cacheSize - 1]->getTimeStamp() : Timestamp::fromMilliseconds(0));
+         DBBind(hStmt, 4, DB_SQLTYPE_BIGINT, (m_cacheLoaded && !m_valueCache.isEmpty()) ? m_valueCache.getTimeStamp(m_valueCache.size() - 1) : Timestamp::fromMilliseconds(0));
          DBBind(hStmt, 5, DB_SQLTYPE_VARCHAR, m_anomalyDetected ? L"1" : L"0", DB_BIND_STATIC);
          success = DBExecute(hStmt);
          DBFreeStatement(hStmt);
@@ -883,7 +867,7 @@ void DCItem::checkThresholds(ItemValue &value, const shared_ptr<DCObject>& origi
 		Threshold *t = m_thresholds->get(i);
 		uint32_t thresholdId = t->getId();
       ItemValue checkValue, thresholdValue;
-      ThresholdCheckResult result = t->check(value, m_ppValueCache, checkValue, thresholdValue, owner, this);
+      ThresholdCheckResult result = t->check(value, m_valueCache, checkValue, thresholdValue, owner, this);
       t->setLastCheckedValue(checkValue);
       switch(result)
       {
@@ -1252,7 +1236,7 @@ bool DCItem::processNewValue(Timestamp timestamp, const wchar_t *originalValue,
 
    m_errorCount = 0;
 
-   if (isStatusDCO() && (timestamp > m_prevValueTimeStamp) && ((m_cacheSize == 0) || !m_cacheLoaded || (pValue->getUInt32() != m_ppValueCache[0]->getUInt32())))
+   if (isStatusDCO() && (timestamp > m_prevValueTimeStamp) && (m_valueCache.isEmpty() || !m_cacheLoaded || (pValue->getUInt32() != m_valueCache.getUInt32(0))))
    {
       *updateStatus = true;
    }
@@ -1288,7 +1272,7 @@ bool DCItem::processNewValue(Timestamp timestamp, const wchar_t *originalValue,
 
       // Save raw value into database
       QueueRawDciDataUpdate(timestamp, m_id, originalValue, pValue->getString(),
-         (m_cacheLoaded && (m_cacheSize > 0)) ? m_ppValueCache[m_cacheSize - 1]->getTimeStamp() : Timestamp::fromMilliseconds(0), m_anomalyDetected);
+         (m_cacheLoaded && !m_valueCache.isEmpty()) ? m_valueCache.getTimeStamp(m_valueCache.size() - 1) : Timestamp::fromMilliseconds(0), m_anomalyDetected);
    }
 
 	// Check if this is the N-th sample that should be saved
@@ -1304,7 +1288,8 @@ bool DCItem::processNewValue(Timestamp timestamp, const wchar_t *originalValue,
 
    // Then check if user wants to collect all values or only changed values
    bool storedInDb = false;
-   if (shouldSave && (!isStoreChangesOnly() || (m_cacheLoaded && (m_cacheSize > 0) && wcscmp(pValue->getString(), m_ppValueCache[0]->getString()))))
+   wchar_t cachedValue[DCI_VALUE_CACHE_STRING_BUFFER_SIZE];
+   if (shouldSave && (!isStoreChangesOnly() || (m_cacheLoaded && !m_valueCache.isEmpty() && wcscmp(pValue->getString(), m_valueCache.getString(0, cachedValue)))))
    {
       // Save transformed value to database
       if (m_retentionType != DC_RETENTION_NONE)
@@ -1314,19 +1299,18 @@ bool DCItem::processNewValue(Timestamp timestamp, const wchar_t *originalValue,
 
          // If aggregation is active and this sample pre-dates our rollup watermark,
          // push the watermark back so the next rollup pass re-aggregates the affected bucket.
+         // Otherwise accumulate it into in-memory hourly aggregate.
          if ((g_dbSyntax != DB_SYNTAX_TSDB) && !(g_flags & AF_SINGLE_TABLE_PERF_DATA) &&
              isAggregationActive(ConfigReadBoolean(L"DataCollection.Aggregation.Enabled", false)))
+         {
             pushBackAggregationWatermark(timestamp.asMilliseconds());
+            updateHourlyAggregate(owner->getId(), timestamp.asMilliseconds(), pValue->getString());
+         }
       }
 
+      // Request is queued with copy of this DCI and processed by drivers asynchronously
       if (g_flags & AF_PERFDATA_STORAGE_DRIVER_LOADED)
-      {
-         // Operate on copy with this DCI unlocked to prevent deadlock if fan-out driver access owning object
-         DCItem copy(this, false, false);
-         unlock();
-         PerfDataStorageRequest(&copy, timestamp, prevValueTimestamp, pValue->getString());
-         lock();
-      }
+         PerfDataStorageRequest(this, timestamp, prevValueTimestamp, pValue->getString());
    }
 
    // Feed the value to the standby cluster node (raw value keeps delta-calculation
@@ -1417,34 +1401,22 @@ bool DCItem::processNewValue(Timestamp timestamp, const wchar_t *originalValue,
    }
 
    // Update cache
-   if ((m_cacheSize > 0) && (timestamp >= m_prevValueTimeStamp))
+   if (!m_valueCache.isEmpty() && (timestamp >= m_prevValueTimeStamp))
    {
-      delete m_ppValueCache[m_cacheSize - 1];
-      memmove(&m_ppValueCache[1], m_ppValueCache, sizeof(ItemValue *) * (m_cacheSize - 1));
-      m_ppValueCache[0] = pValue;
+      m_valueCache.push(*pValue, getTransformedDataType());
       m_lastValueTimestamp = timestamp;
    }
    else if (!m_cacheLoaded && (m_requiredCacheSize == 1))
    {
       // If required cache size is 1 and we got value before cache loader
       // loads DCI cache then update it directly
-      for(uint32_t i = 0; i < m_cacheSize; i++)
-         delete m_ppValueCache[i];
-
-      if (m_cacheSize != m_requiredCacheSize)
-      {
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_requiredCacheSize);
-         m_cacheSize = m_requiredCacheSize;
-      }
-
-      m_ppValueCache[0] = pValue;
+      m_valueCache.clear();
+      m_valueCache.setCapacity(m_requiredCacheSize);
+      m_valueCache.push(*pValue, getTransformedDataType());
       m_cacheLoaded = true;
       m_lastValueTimestamp = timestamp;
    }
-   else
-   {
-      delete pValue;
-   }
+   delete pValue;
 
    unlock();
 
@@ -1488,22 +1460,13 @@ void DCItem::feedValueFromPeer(Timestamp timestamp, const wchar_t *rawValue, con
    // and is marked loaded once fully populated, so reloadCache() at
    // activation skips the database read.
    if (storedInDb && (m_requiredCacheSize > 0) &&
-       ((m_cacheSize == 0) || (timestamp > m_ppValueCache[0]->getTimeStamp())))
+       (m_valueCache.isEmpty() || (timestamp > m_valueCache.getTimeStamp(0))))
    {
-      if (m_cacheSize < m_requiredCacheSize)
-      {
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_cacheSize + 1);
-         memmove(&m_ppValueCache[1], m_ppValueCache, sizeof(ItemValue*) * m_cacheSize);
-         m_cacheSize++;
-      }
-      else
-      {
-         delete m_ppValueCache[m_cacheSize - 1];
-         memmove(&m_ppValueCache[1], m_ppValueCache, sizeof(ItemValue*) * (m_cacheSize - 1));
-      }
-      m_ppValueCache[0] = new ItemValue(transformedValue, timestamp, false);
+      if (m_valueCache.capacity() != m_requiredCacheSize)
+         m_valueCache.setCapacity(m_requiredCacheSize);
+      m_valueCache.push(ItemValue(transformedValue, timestamp, false), getTransformedDataType());
       m_lastValueTimestamp = timestamp;
-      if ((m_cacheSize == m_requiredCacheSize) && !m_cacheLoaded)
+      if ((m_valueCache.size() == m_requiredCacheSize) && !m_cacheLoaded)
       {
          m_cacheLoaded = true;
          nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 7, _T("Cache for DCI %s [%u] fully populated from cluster data feed"), m_name.cstr(), m_id);
@@ -1643,6 +1606,8 @@ void DCItem::generateEventsAfterMaintenance()
    lock();
    int trCount = getThresholdCount() - 1;
    uint32_t ownerId = m_owner.lock()->getId();
+   wchar_t cachedValue[DCI_VALUE_CACHE_STRING_BUFFER_SIZE];
+   const wchar_t *dciValue = (m_cacheLoaded && !m_valueCache.isEmpty()) ? m_valueCache.getString(0, cachedValue) : L"";
    for(int i = trCount; i >= 0; i--)   // go backwards to generate events in correct order
    {
       Threshold *t = m_thresholds->get(i);
@@ -1661,7 +1626,7 @@ void DCItem::generateEventsAfterMaintenance()
                .param(_T("dciId"), m_id, EventBuilder::OBJECT_ID_FORMAT)
                .param(_T("instance"), m_instanceName)
                .param(_T("isRepeatedEvent"), _T("0"))
-               .param(_T("dciValue"), (m_cacheLoaded && (m_cacheSize > 0)) ? m_ppValueCache[0]->getString() : _T(""))
+               .param(_T("dciValue"), dciValue)
                .param(_T("operation"), t->getOperation())
                .param(_T("function"), t->getFunction())
                .param(_T("pollCount"), t->getSampleCount())
@@ -1680,7 +1645,7 @@ void DCItem::generateEventsAfterMaintenance()
                .param(_T("instance"), m_instanceName)
                .param(_T("thresholdValue"), t->getStringValue())
                .param(_T("currentValue"), t->getLastCheckValue().getString())
-               .param(_T("dciValue"), (m_cacheLoaded && (m_cacheSize > 0)) ? m_ppValueCache[0]->getString() : _T(""))
+               .param(_T("dciValue"), dciValue)
                .param(_T("operation"), t->getOperation())
                .param(_T("function"), t->getFunction())
                .param(_T("pollCount"), t->getSampleCount())
@@ -1915,7 +1880,9 @@ bool DCItem::transform(ItemValue &value, int64_t elapsedTime)
 
    if (m_transformationScript != nullptr)
    {
-      ScriptVMHandle vm = CreateServerScriptVM(m_transformationScript.get(), m_owner.lock(), createDescriptorInternal());
+      // Keep reference to script because it can be changed while DCI is unlocked
+      shared_ptr<NXSL_Program> script = m_transformationScript;
+      ScriptVMHandle vm = AcquirePooledServerScriptVM(script, m_owner.lock(), createDescriptorInternal());
       if (vm.isValid())
       {
          SetRestrictedSecurityContext(vm);
@@ -1981,7 +1948,7 @@ bool DCItem::transform(ItemValue &value, int64_t elapsedTime)
                m_lastScriptErrorReport = now;
             }
          }
-         vm.destroy();
+         ReleasePooledServerScriptVM(vm, script);
       }
       else if (vm.failureReason() == ScriptVMFailureReason::SCRIPT_IS_EMPTY)
       {
@@ -2084,37 +2051,22 @@ void DCItem::updateCacheSizeInternal(bool allowLoad)
    m_requiredCacheSize = calculateRequiredCacheSize(*owner);
 
    nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 8, _T("DCItem::updateCacheSizeInternal(dci=\"%s\", node=%s [%d]): requiredSize=%d cacheSize=%d"),
-            m_name.cstr(), owner->getName(), owner->getId(), m_requiredCacheSize, m_cacheSize);
+            m_name.cstr(), owner->getName(), owner->getId(), m_requiredCacheSize, m_valueCache.size());
 
    // Update cache if needed
-   if (m_requiredCacheSize < m_cacheSize)
+   if (m_requiredCacheSize < m_valueCache.size())
    {
       // Destroy unneeded values
-      if (m_cacheSize > 0)
-		{
-         for(uint32_t i = m_requiredCacheSize; i < m_cacheSize; i++)
-            delete m_ppValueCache[i];
-		}
-
-      m_cacheSize = m_requiredCacheSize;
-      if (m_cacheSize > 0)
-      {
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_cacheSize);
-      }
-      else
-      {
-         MemFree(m_ppValueCache);
-         m_ppValueCache = nullptr;
-      }
+      m_valueCache.setCapacity(m_requiredCacheSize);
    }
-   else if (m_requiredCacheSize > m_cacheSize)
+   else if (m_requiredCacheSize > m_valueCache.size())
    {
       // Load missing values from database
       // Skip caching for DCIs where estimated time to fill the cache is less then 5 minutes
       // to reduce load on database at server startup
       if (allowLoad &&
           (m_ownerId != 0) &&
-          (((m_requiredCacheSize - m_cacheSize) * getEffectivePollingInterval() > 300) ||
+          (((m_requiredCacheSize - m_valueCache.size()) * getEffectivePollingInterval() > 300) ||
            (m_source == DS_PUSH_AGENT) || (m_source == DS_OTLP) ||
            (m_pollingScheduleType == DC_POLLING_SCHEDULE_ADVANCED)))
       {
@@ -2124,11 +2076,10 @@ void DCItem::updateCacheSizeInternal(bool allowLoad)
       else
       {
          // will not read data from database, fill cache with empty values
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_requiredCacheSize);
-         for(uint32_t i = m_cacheSize; i < m_requiredCacheSize; i++)
-            m_ppValueCache[i] = new ItemValue(_T(""), Timestamp::fromMilliseconds(1), false);
+         m_valueCache.setCapacity(m_requiredCacheSize);
+         while(m_valueCache.size() < m_requiredCacheSize)
+            m_valueCache.appendPlaceholder();
          nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 7, _T("Cache load skipped for parameter %s [%u]"), m_name.cstr(), m_id);
-         m_cacheSize = m_requiredCacheSize;
          m_cacheLoaded = true;
       }
    }
@@ -2148,7 +2099,7 @@ void DCItem::loadCache()
 void DCItem::reloadCache(bool forceReload)
 {
    lock();
-   if (!forceReload && m_cacheLoaded && (m_cacheSize == m_requiredCacheSize))
+   if (!forceReload && m_cacheLoaded && (m_valueCache.size() == m_requiredCacheSize))
    {
       unlock();
       return;  // Cache already fully populated
@@ -2300,55 +2251,40 @@ void DCItem::reloadCache(bool forceReload)
 
    // While reload request was in queue DCI cache may have been already filled
    lock();
-   if (forceReload || !m_cacheLoaded || (m_cacheSize != m_requiredCacheSize))
+   if (forceReload || !m_cacheLoaded || (m_valueCache.size() != m_requiredCacheSize))
    {
-      for(uint32_t i = 0; i < m_cacheSize; i++)
-         delete m_ppValueCache[i];
-
-      if (m_cacheSize != m_requiredCacheSize)
-      {
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_requiredCacheSize);
-      }
-
       nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 8, _T("DCItem::reloadCache(dci=\"%s\", node=%s [%d]): requiredSize=%d cacheSize=%d"),
-               m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize, m_cacheSize);
+               m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize, m_valueCache.size());
+
+      m_valueCache.clear();
+      m_valueCache.setCapacity(m_requiredCacheSize);
       if (hResult != nullptr)
       {
          // Create cache entries
-         bool moreData = true;
-         uint32_t i;
-         for(i = 0; (i < m_requiredCacheSize) && moreData; i++)
+         int dataType = getTransformedDataType();
+         while((m_valueCache.size() < m_requiredCacheSize) && DBFetch(hResult))
          {
-            moreData = DBFetch(hResult);
-            if (moreData)
-            {
-               DBGetField(hResult, 0, szBuffer, MAX_DB_STRING);
-               m_ppValueCache[i] = new ItemValue(szBuffer, DBGetFieldTimestamp(hResult, 1), false);
-            }
-            else
-            {
-               m_ppValueCache[i] = new ItemValue(L"", Timestamp::fromMilliseconds(1), false);   // Empty value
-            }
+            DBGetField(hResult, 0, szBuffer, MAX_DB_STRING);
+            m_valueCache.append(ItemValue(szBuffer, DBGetFieldTimestamp(hResult, 1), false), dataType);
          }
 
          // Fill up cache with empty values if we don't have enough values in database
-         if (i < m_requiredCacheSize)
+         if (m_valueCache.size() < m_requiredCacheSize)
          {
             nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 8, _T("DCItem::reloadCache(dci=\"%s\", node=%s [%u]): %d values missing in DB"),
-                     m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize - i);
-            for(; i < m_requiredCacheSize; i++)
-               m_ppValueCache[i] = new ItemValue(L"", Timestamp::fromMilliseconds(1), false);
+                     m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize - m_valueCache.size());
+            while(m_valueCache.size() < m_requiredCacheSize)
+               m_valueCache.appendPlaceholder();
          }
          DBFreeResult(hResult);
       }
       else
       {
          // Error reading data from database, fill cache with empty values
-         for(uint32_t i = 0; i < m_requiredCacheSize; i++)
-            m_ppValueCache[i] = new ItemValue(L"", Timestamp::fromMilliseconds(1), false);
+         while(m_valueCache.size() < m_requiredCacheSize)
+            m_valueCache.appendPlaceholder();
       }
 
-      m_cacheSize = m_requiredCacheSize;
       m_cacheLoaded = true;
    }
    else if (hResult != nullptr)
@@ -2366,7 +2302,7 @@ void DCItem::reloadCache(bool forceReload)
 uint64_t DCItem::getCacheMemoryUsage() const
 {
    lock();
-   uint64_t size = m_cacheSize * (sizeof(ItemValue) + sizeof(ItemValue*));
+   uint64_t size = m_valueCache.getMemoryUsage();
    unlock();
    return size;
 }
@@ -2378,12 +2314,13 @@ void DCItem::fillLastValueMessage(NXCPMessage *msg)
 {
    lock();
    msg->setField(VID_DCI_SOURCE_TYPE, m_source);
-   if (m_cacheSize > 0)
+   if (!m_valueCache.isEmpty())
    {
+      wchar_t buffer[DCI_VALUE_CACHE_STRING_BUFFER_SIZE];
       msg->setField(VID_DCI_DATA_TYPE, static_cast<uint16_t>(getTransformedDataType()));
-      msg->setField(VID_VALUE, m_ppValueCache[0]->getString());
+      msg->setField(VID_VALUE, m_valueCache.getString(0, buffer));
       msg->setField(VID_RAW_VALUE, m_prevRawValue.getString());
-      msg->setField(VID_TIMESTAMP_MS, m_ppValueCache[0]->getTimeStamp());
+      msg->setField(VID_TIMESTAMP_MS, m_valueCache.getTimeStamp(0));
    }
    else
    {
@@ -2407,11 +2344,12 @@ void DCItem::fillLastValueSummaryMessage(NXCPMessage *msg, uint32_t baseId, cons
    msg->setField(baseId++, m_flags);
    msg->setField(baseId++, m_description);
    msg->setField(baseId++, static_cast<uint16_t>(m_source));
-   if (m_cacheSize > 0)
+   if (!m_valueCache.isEmpty())
    {
+      wchar_t buffer[DCI_VALUE_CACHE_STRING_BUFFER_SIZE];
       msg->setField(baseId++, static_cast<uint16_t>(getTransformedDataType()));
-      msg->setField(baseId++, m_ppValueCache[0]->getString());
-      msg->setField(baseId++, m_ppValueCache[0]->getTimeStamp());
+      msg->setField(baseId++, m_valueCache.getString(0, buffer));
+      msg->setField(baseId++, m_valueCache.getTimeStamp(0));
    }
    else
    {
@@ -2489,11 +2427,12 @@ json_t *DCItem::lastValueToJSON()
    json_object_set_new(data, "description", json_string_t(m_description));
    json_object_set_new(data, "sourceType", json_integer(m_source));
 
-   if (m_cacheSize > 0)
+   if (!m_valueCache.isEmpty())
    {
+      wchar_t buffer[DCI_VALUE_CACHE_STRING_BUFFER_SIZE];
       json_object_set_new(data, "dataType", json_integer(getTransformedDataType()));
-      json_object_set_new(data, "value", json_string_t(m_ppValueCache[0]->getString()));
-      json_object_set_new(data, "timestamp", m_ppValueCache[0]->getTimeStamp().asJson());
+      json_object_set_new(data, "value", json_string_t(m_valueCache.getString(0, buffer)));
+      json_object_set_new(data, "timestamp", m_valueCache.getTimeStamp(0).asJson());
    }
    else
    {
@@ -2614,14 +2553,22 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
    {
       case F_LAST:
          // cache placeholders will have timestamp 1
-         value = (m_cacheLoaded && (m_cacheSize > 0) && (m_ppValueCache[0]->getTimeStamp().asMilliseconds() != 1)) ? vm->createValue(m_ppValueCache[0]->getString()) : vm->createValue();
+         if (m_cacheLoaded && !m_valueCache.isEmpty() && !m_valueCache.isPlaceholder(0))
+         {
+            wchar_t buffer[DCI_VALUE_CACHE_STRING_BUFFER_SIZE];
+            value = vm->createValue(m_valueCache.getString(0, buffer));
+         }
+         else
+         {
+            value = vm->createValue();
+         }
          CastNXSLValue(value, getTransformedDataType());
          break;
       case F_DIFF:
-         if (m_cacheLoaded && (m_cacheSize >= 2))
+         if (m_cacheLoaded && (m_valueCache.size() >= 2))
          {
             ItemValue result;
-            CalculateItemValueDiff(&result, getTransformedDataType(), *m_ppValueCache[0], *m_ppValueCache[1]);
+            CalculateItemValueDiff(&result, getTransformedDataType(), m_valueCache.get(0), m_valueCache.get(1));
             value = vm->createValue(result.getString());
          }
          else
@@ -2630,10 +2577,10 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
          }
          break;
       case F_AVERAGE:
-         if (m_cacheLoaded && (m_cacheSize > 0))
+         if (m_cacheLoaded && !m_valueCache.isEmpty())
          {
             ItemValue result;
-            CalculateItemValueAverage(&result, getTransformedDataType(), m_ppValueCache, std::min(m_cacheSize, static_cast<uint32_t>(sampleCount)));
+            CalculateItemValueAverage(&result, getTransformedDataType(), m_valueCache, sampleCount);
             value = vm->createValue(result.getString());
             CastNXSLValue(value, getTransformedDataType());
          }
@@ -2643,10 +2590,10 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
          }
          break;
       case F_MEAN_DEVIATION:
-         if (m_cacheLoaded && (m_cacheSize > 0))
+         if (m_cacheLoaded && !m_valueCache.isEmpty())
          {
             ItemValue result;
-            CalculateItemValueMeanDeviation(&result, getTransformedDataType(), m_ppValueCache, std::min(m_cacheSize, static_cast<uint32_t>(sampleCount)));
+            CalculateItemValueMeanDeviation(&result, getTransformedDataType(), m_valueCache, sampleCount);
             value = vm->createValue(result.getString());
          }
          else
@@ -2668,10 +2615,11 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
 /**
  * Get last value
  */
-const TCHAR *DCItem::getLastValue()
+String DCItem::getLastValue()
 {
    lock();
-   const TCHAR *v = (m_cacheSize > 0) ? (const TCHAR *)m_ppValueCache[0]->getString() : nullptr;
+   wchar_t buffer[DCI_VALUE_CACHE_STRING_BUFFER_SIZE];
+   String v = !m_valueCache.isEmpty() ? String(m_valueCache.getString(0, buffer)) : String();
    unlock();
    return v;
 }
@@ -2682,7 +2630,7 @@ const TCHAR *DCItem::getLastValue()
 ItemValue *DCItem::getInternalLastValue()
 {
    lock();
-   ItemValue *v = (m_cacheSize > 0) ? new ItemValue(*m_ppValueCache[0]) : nullptr;
+   ItemValue *v = !m_valueCache.isEmpty() ? new ItemValue(m_valueCache.get(0)) : nullptr;
    unlock();
    return v;
 }
@@ -2938,13 +2886,11 @@ bool DCItem::deleteEntry(Timestamp timestamp)
       return false;
 
    lock();
-   for(uint32_t i = 0; i < m_cacheSize; i++)
+   for(uint32_t i = 0; i < m_valueCache.size(); i++)
    {
-      if (m_ppValueCache[i]->getTimeStamp() == timestamp)
+      if (m_valueCache.getTimeStamp(i) == timestamp)
       {
-         delete m_ppValueCache[i];
-         memmove(&m_ppValueCache[i], &m_ppValueCache[i + 1], sizeof(ItemValue *) * (m_cacheSize - (i + 1)));
-         m_cacheSize--;
+         m_valueCache.remove(i);
          updateCacheSizeInternal(true);
          break;
       }
@@ -3543,11 +3489,9 @@ void DCItem::recalculateValue(ItemValue &value)
       m_prevValueTimeStamp = value.getTimeStamp();
    }
 
-   if ((m_cacheSize > 0) && (value.getTimeStamp() >= m_prevValueTimeStamp))
+   if (!m_valueCache.isEmpty() && (value.getTimeStamp() >= m_prevValueTimeStamp))
    {
-      delete m_ppValueCache[m_cacheSize - 1];
-      memmove(&m_ppValueCache[1], m_ppValueCache, sizeof(ItemValue *) * (m_cacheSize - 1));
-      m_ppValueCache[0] = new ItemValue(value);
+      m_valueCache.push(value, getTransformedDataType());
    }
 
    m_lastPollTime = value.getTimeStamp();
@@ -3671,7 +3615,8 @@ uint32_t DCItem::postThresholdRepeatEvent(uint32_t thresholdId, uint64_t activat
    }
 
    // Gather values for event
-   const wchar_t *dciValue = (m_cacheSize > 0) ? m_ppValueCache[0]->getString() : L"";
+   wchar_t cachedValue[DCI_VALUE_CACHE_STRING_BUFFER_SIZE];
+   const wchar_t *dciValue = !m_valueCache.isEmpty() ? m_valueCache.getString(0, cachedValue) : L"";
    String currentValue = t->getLastCheckValue().getString();
    String thresholdValue = t->getStringValue();
 
@@ -3852,10 +3797,10 @@ bool DCItem::checkAnomalyAIProfile(const ItemValue& value)
    json_t *changeDetection = json_object_get(m_anomalyProfile, "changeDetection");
    if (changeDetection != nullptr && json_is_true(json_object_get(changeDetection, "enabled")))
    {
-      if (m_cacheSize > 0 && m_ppValueCache != nullptr && m_ppValueCache[0] != nullptr)
+      if (!m_valueCache.isEmpty())
       {
-         double prevValue = m_ppValueCache[0]->getDouble();
-         time_t prevTime = m_ppValueCache[0]->getTimeStamp().asTime();
+         double prevValue = m_valueCache.getDouble(0);
+         time_t prevTime = m_valueCache.getTimeStamp(0).asTime();
          double elapsedMinutes = difftime(now, prevTime) / 60.0;
          if (elapsedMinutes > 0)
          {
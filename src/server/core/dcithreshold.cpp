@@ -272,7 +272,6 @@ Threshold::Threshold(json_t *json, DCItem *parentItem)
 Threshold::~Threshold()
 {
    MemFree(m_scriptSource);
-   delete m_script;
    MemFree(m_lastEventMessage);
 }
 
@@ -352,7 +351,7 @@ static void SaveThresholdStateChange(uint32_t thresholdId, bool isReached)
  *    THRESHOLD_REARMED - when item's value doesn't match the threshold condition while previous check do
  *    NO_ACTION - when there are no changes in item's value match to threshold's condition
  */
-ThresholdCheckResult Threshold::check(ItemValue &value, ItemValue **ppPrevValues, ItemValue &fvalue, ItemValue &tvalue, shared_ptr<NetObj> target, DCItem *dci)
+ThresholdCheckResult Threshold::check(ItemValue &value, const DCIValueCache& prevValues, ItemValue &fvalue, ItemValue &tvalue, shared_ptr<NetObj> target, DCItem *dci)
 {
    if (m_disabled)
    {
@@ -368,14 +367,16 @@ ThresholdCheckResult Threshold::check(ItemValue &value, ItemValue **ppPrevValues
    switch(m_function)
    {
       case F_DIFF:
-         if (ppPrevValues[0]->getTimeStamp().asMilliseconds() == 1) // Timestamp 1 means placeholder value inserted by cache loader
+         if ((prevValues.size() < 1) || prevValues.isPlaceholder(0))
             return m_isReached ? ThresholdCheckResult::ALREADY_ACTIVE : ThresholdCheckResult::ALREADY_INACTIVE;
          break;
       case F_AVERAGE:
       case F_SUM:
       case F_MEAN_DEVIATION:
+         if (prevValues.size() < static_cast<uint32_t>(std::max(m_sampleCount - 1, 0)))
+            return m_isReached ? ThresholdCheckResult::ALREADY_ACTIVE : ThresholdCheckResult::ALREADY_INACTIVE;
          for(int i = 0; i < m_sampleCount - 1; i++)
-            if (ppPrevValues[i]->getTimeStamp().asMilliseconds() == 1) // Timestamp 1 means placeholder value inserted by cache loader
+            if (prevValues.isPlaceholder(i))
                return m_isReached ? ThresholdCheckResult::ALREADY_ACTIVE : ThresholdCheckResult::ALREADY_INACTIVE;
          break;
       default:
@@ -393,19 +394,19 @@ ThresholdCheckResult Threshold::check(ItemValue &value, ItemValue **ppPrevValues
          fvalue = value;
          break;
       case F_AVERAGE:      // Check average value for last n polls
-         calculateAverage(&fvalue, value, ppPrevValues);
+         calculateAverage(&fvalue, value, prevValues);
          break;
 		case F_SUM:
-         calculateTotal(&fvalue, value, ppPrevValues);
+         calculateTotal(&fvalue, value, prevValues);
 			break;
       case F_MEAN_DEVIATION:    // Check mean absolute deviation
-         calculateMeanDeviation(&fvalue, value, ppPrevValues);
+         calculateMeanDeviation(&fvalue, value, prevValues);
          break;
       case F_ABS_DEVIATION:    // Check absolute deviation for last point
-         calculateAbsoluteDeviation(&fvalue, value, ppPrevValues);
+         calculateAbsoluteDeviation(&fvalue, value, prevValues);
          break;
       case F_DIFF:
-         CalculateItemValueDiff(&fvalue, m_dataType, value, *ppPrevValues[0]);
+         CalculateItemValueDiff(&fvalue, m_dataType, value, prevValues.get(0));
          switch(m_dataType)
          {
             case DCI_DT_STRING:
@@ -446,7 +447,8 @@ ThresholdCheckResult Threshold::check(ItemValue &value, ItemValue **ppPrevValues
                m_value;
       if ((m_script != nullptr) && !m_script->isEmpty())
       {
-         NXSL_VM *vm = CreateServerScriptVM(m_script, target, dci->createDescriptor());
+         shared_ptr<NXSL_Program> script = m_script;
+         NXSL_VM *vm = AcquirePooledServerScriptVM(script, target, dci->createDescriptor());
          if (vm != nullptr)
          {
             SetRestrictedSecurityContext(vm);
@@ -484,7 +486,7 @@ ThresholdCheckResult Threshold::check(ItemValue &value, ItemValue **ppPrevValues
                   m_lastScriptErrorReport = now;
                }
             }
-            delete vm;
+            ReleasePooledServerScriptVM(vm, script);
          }
          else
          {
@@ -903,18 +905,18 @@ void Threshold::updateFromJson(json_t *json)
 /**
  * Calculate average value for values of given type
  */
-template<typename T> static T CalculateAverage(const ItemValue &lastValue, ItemValue **prevValues, int sampleCount)
+template<typename T> static T CalculateAverage(const ItemValue &lastValue, const DCIValueCache& prevValues, int sampleCount)
 {
    T sum = static_cast<T>(lastValue);
    for(int i = 1; i < sampleCount; i++)
-      sum += static_cast<T>(*prevValues[i - 1]);
+      sum += prevValues.getValue<T>(i - 1);
    return sum / static_cast<T>(sampleCount);
 }
 
 /**
  * Calculate average value for metric
  */
-void Threshold::calculateAverage(ItemValue *result, const ItemValue &lastValue, ItemValue **prevValues)
+void Threshold::calculateAverage(ItemValue *result, const ItemValue &lastValue, const DCIValueCache& prevValues)
 {
    switch(m_dataType)
    {
@@ -946,18 +948,18 @@ void Threshold::calculateAverage(ItemValue *result, const ItemValue &lastValue,
 /**
  * Calculate sum value for values of given type
  */
-template<typename T> static T CalculateSum(const ItemValue &lastValue, ItemValue **prevValues, int sampleCount)
+template<typename T> static T CalculateSum(const ItemValue &lastValue, const DCIValueCache& prevValues, int sampleCount)
 {
    T sum = static_cast<T>(lastValue);
    for(int i = 1; i < sampleCount; i++)
-      sum += static_cast<T>(*prevValues[i - 1]);
+      sum += prevValues.getValue<T>(i - 1);
    return sum;
 }
 
 /**
  * Calculate sum value for metric
  */
-void Threshold::calculateTotal(ItemValue *result, const ItemValue &lastValue, ItemValue **prevValues)
+void Threshold::calculateTotal(ItemValue *result, const ItemValue &lastValue, const DCIValueCache& prevValues)
 {
    switch(m_dataType)
    {
@@ -989,18 +991,18 @@ void Threshold::calculateTotal(ItemValue *result, const ItemValue &lastValue, It
 /**
  * Calculate mean absolute deviation for values of given type
  */
-template<typename T, T (*ABS)(T)> static T CalculateMeanDeviation(const ItemValue& lastValue, ItemValue **prevValues, int sampleCount)
+template<typename T, T (*ABS)(T)> static T CalculateMeanDeviation(const ItemValue& lastValue, const DCIValueCache& prevValues, int sampleCount)
 {
    T mean = static_cast<T>(lastValue);
    for(int i = 1; i < sampleCount; i++)
    {
-      mean += static_cast<T>(*prevValues[i - 1]);
+      mean += prevValues.getValue<T>(i - 1);
    }
    mean /= static_cast<T>(sampleCount);
    T dev = ABS(static_cast<T>(lastValue) - mean);
    for(int i = 1; i < sampleCount; i++)
    {
-      dev += ABS(static_cast<T>(*prevValues[i - 1]) - mean);
+      dev += ABS(prevValues.getValue<T>(i - 1) - mean);
    }
    return dev / static_cast<T>(sampleCount);
 }
@@ -1040,7 +1042,7 @@ static uint64_t noop64(uint64_t v)
 /**
  * Calculate mean absolute deviation for metric
  */
-void Threshold::calculateMeanDeviation(ItemValue *result, const ItemValue &lastValue, ItemValue **prevValues)
+void Threshold::calculateMeanDeviation(ItemValue *result, const ItemValue &lastValue, const DCIValueCache& prevValues)
 {
    switch(m_dataType)
    {
@@ -1072,12 +1074,12 @@ void Threshold::calculateMeanDeviation(ItemValue *result, const ItemValue &lastV
 /**
  * Calculate mean absolute deviation for values of given type
  */
-template<typename T, T (*ABS)(T)> static T CalculateAbsoluteDeviation(const ItemValue& lastValue, ItemValue **prevValues, int sampleCount)
+template<typename T, T (*ABS)(T)> static T CalculateAbsoluteDeviation(const ItemValue& lastValue, const DCIValueCache& prevValues, int sampleCount)
 {
    T mean = static_cast<T>(lastValue);
    for(int i = 1; i < sampleCount; i++)
    {
-      mean += static_cast<T>(*prevValues[i - 1]);
+      mean += prevValues.getValue<T>(i - 1);
    }
    mean /= static_cast<T>(sampleCount);
    return ABS(static_cast<T>(lastValue) - mean);
@@ -1086,7 +1088,7 @@ template<typename T, T (*ABS)(T)> static T CalculateAbsoluteDeviation(const Item
 /**
  * Calculate absolute deviation for metric
  */
-void Threshold::calculateAbsoluteDeviation(ItemValue *result, const ItemValue &lastValue, ItemValue **prevValues)
+void Threshold::calculateAbsoluteDeviation(ItemValue *result, const ItemValue &lastValue, const DCIValueCache& prevValues)
 {
    switch(m_dataType)
    {
@@ -1259,15 +1261,14 @@ void Threshold::associate(DCItem *pItem)
 void Threshold::setScript(TCHAR *script)
 {
    MemFree(m_scriptSource);
-   delete m_script;
+   m_script.reset();
    if (script != nullptr)
    {
       m_scriptSource = Trim(script);
       if (m_scriptSource[0] != 0)
       {
          NXSL_CompilationDiagnostic diag;
-         NXSL_ServerEnv env;
-         m_script = NXSLCompile(m_scriptSource, &env, &diag);
+         m_script = CompileSharedServerScript(m_scriptSource, &diag);
          if (m_script == nullptr)
          {
             TCHAR defaultName[32];
@@ -1340,5 +1341,5 @@ void Threshold::getScriptDependencies(StringSet *dependencies) const
    {
       FindScriptMacrosInText(m_value.getString(), dependencies);
    }
-   AddScriptDependencies(dependencies, m_script);
+   AddScriptDependencies(dependencies, m_script.get());
 }
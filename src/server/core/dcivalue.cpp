@@ -182,6 +182,371 @@ void ItemValue::set(uint64_t value, const TCHAR *stringValue)
    m_int64 = static_cast<int64_t>(m_uint64);
 }
 
+/**
+ * Shared empty string used by cache elements with empty string representation
+ */
+static wchar_t s_emptyString[1] = L"";
+
+/**
+ * Check if given data type is stored in cache as signed integer
+ */
+static inline bool IsSignedIntegerType(int dataType)
+{
+   return (dataType == DCI_DT_INT) || (dataType == DCI_DT_INT64);
+}
+
+/**
+ * Check if given data type is stored in cache as unsigned integer
+ */
+static inline bool IsUnsignedIntegerType(int dataType)
+{
+   return (dataType == DCI_DT_UINT) || (dataType == DCI_DT_UINT64) || (dataType == DCI_DT_COUNTER32) || (dataType == DCI_DT_COUNTER64);
+}
+
+/**
+ * Create empty value cache
+ */
+DCIValueCache::DCIValueCache()
+{
+   m_elements = nullptr;
+   m_capacity = 0;
+   m_size = 0;
+   m_head = 0;
+   m_dataType = DCI_DT_STRING;
+}
+
+/**
+ * Copy constructor
+ */
+DCIValueCache::DCIValueCache(const DCIValueCache& src)
+{
+   copyFrom(src);
+}
+
+/**
+ * Assignment operator
+ */
+DCIValueCache& DCIValueCache::operator=(const DCIValueCache& src)
+{
+   if (this != &src)
+   {
+      clear();
+      MemFree(m_elements);
+      copyFrom(src);
+   }
+   return *this;
+}
+
+/**
+ * Copy content of another cache (existing content should be already destroyed)
+ */
+void DCIValueCache::copyFrom(const DCIValueCache& src)
+{
+   m_capacity = src.m_capacity;
+   m_size = src.m_size;
+   m_head = 0;
+   m_dataType = src.m_dataType;
+   if (m_capacity > 0)
+   {
+      m_elements = MemAllocArrayNoInit<Element>(m_capacity);
+      for(uint32_t i = 0; i < m_size; i++)
+      {
+         Element& e = m_elements[i];
+         e = src.element(i);
+         if ((e.string != nullptr) && (e.string != s_emptyString))
+            e.string = MemCopyStringW(e.string);
+      }
+   }
+   else
+   {
+      m_elements = nullptr;
+   }
+}
+
+/**
+ * Destructor
+ */
+DCIValueCache::~DCIValueCache()
+{
+   clear();
+   MemFree(m_elements);
+}
+
+/**
+ * Free string representation of cache element
+ */
+void DCIValueCache::freeString(Element *e)
+{
+   if (e->string != s_emptyString)
+      MemFree(e->string);
+   e->string = nullptr;
+}
+
+/**
+ * Remove all elements from cache (capacity is not changed)
+ */
+void DCIValueCache::clear()
+{
+   for(uint32_t i = 0; i < m_size; i++)
+      freeString(&element(i));
+   m_size = 0;
+   m_head = 0;
+}
+
+/**
+ * Set cache capacity. If new capacity is less than current number of elements, oldest elements are dropped.
+ */
+void DCIValueCache::setCapacity(uint32_t capacity)
+{
+   if (capacity == m_capacity)
+      return;
+
+   while(m_size > capacity)
+      freeString(&element(--m_size));
+
+   Element *elements = (capacity > 0) ? MemAllocArrayNoInit<Element>(capacity) : nullptr;
+   for(uint32_t i = 0; i < m_size; i++)
+      elements[i] = element(i);
+   MemFree(m_elements);
+   m_elements = elements;
+   m_capacity = capacity;
+   m_head = 0;
+}
+
+/**
+ * Encode given value into cache element according to current data type
+ */
+void DCIValueCache::encode(Element *e, const ItemValue& value) const
+{
+   e->timestamp = value.getTimeStamp().asMilliseconds();
+
+   const wchar_t *s = value.getString();
+   if (*s == 0)
+   {
+      e->value.i = 0;
+      e->string = s_emptyString;
+      return;
+   }
+
+   if (IsSignedIntegerType(m_dataType))
+      e->value.i = value.getInt64();
+   else if (IsUnsignedIntegerType(m_dataType))
+      e->value.u = value.getUInt64();
+   else
+      e->value.d = value.getDouble();
+
+   if (m_dataType != DCI_DT_STRING)
+   {
+      e->string = nullptr;
+      wchar_t buffer[DCI_VALUE_CACHE_STRING_BUFFER_SIZE];
+      if (!wcscmp(format(*e, buffer), s))
+         return;
+   }
+   e->string = MemCopyStringW(s);
+}
+
+/**
+ * Get string representation of cache element. Provided buffer is used for numeric values without stored string representation.
+ */
+const wchar_t *DCIValueCache::format(const Element& e, wchar_t *buffer) const
+{
+   if (e.string != nullptr)
+      return e.string;
+
+   if (IsSignedIntegerType(m_dataType))
+      return IntegerToString(e.value.i, buffer);
+   if (IsUnsignedIntegerType(m_dataType))
+      return IntegerToString(e.value.u, buffer);
+
+   // Floating point value is stored without string representation only if
+   // it is finite, fits into 6 significant digits and has no exponent
+   if (!std::isfinite(e.value.d))
+   {
+      buffer[0] = 0;
+      return buffer;
+   }
+   nx_swprintf(buffer, DCI_VALUE_CACHE_STRING_BUFFER_SIZE, L"%g", e.value.d);
+   if ((wcschr(buffer, L'e') != nullptr) || (wcstod(buffer, nullptr) != e.value.d))
+      buffer[0] = 0;
+   return buffer;
+}
+
+/**
+ * Change data type of cached values, converting existing elements if needed
+ */
+void DCIValueCache::setDataType(int dataType)
+{
+   if (dataType == m_dataType)
+      return;
+
+   if (m_size == 0)
+   {
+      m_dataType = dataType;
+      return;
+   }
+
+   ItemValue *values = new ItemValue[m_size];
+   for(uint32_t i = 0; i < m_size; i++)
+      values[i] = get(i);
+   m_dataType = dataType;
+   for(uint32_t i = 0; i < m_size; i++)
+   {
+      Element& e = element(i);
+      freeString(&e);
+      encode(&e, values[i]);
+   }
+   delete[] values;
+}
+
+/**
+ * Add new value at cache head. Oldest value is dropped if cache is full.
+ */
+void DCIValueCache::push(const ItemValue& value, int dataType)
+{
+   if (m_capacity == 0)
+      return;
+
+   setDataType(dataType);
+   m_head = (m_head + m_capacity - 1) % m_capacity;
+   if (m_size < m_capacity)
+      m_size++;
+   else
+      freeString(&m_elements[m_head]);
+   encode(&m_elements[m_head], value);
+}
+
+/**
+ * Add value at cache tail (as oldest value). Value is ignored if cache is full.
+ */
+void DCIValueCache::append(const ItemValue& value, int dataType)
+{
+   if (m_size >= m_capacity)
+      return;
+
+   setDataType(dataType);
+   encode(&element(m_size++), value);
+}
+
+/**
+ * Add placeholder value at cache tail
+ */
+void DCIValueCache::appendPlaceholder()
+{
+   if (m_size >= m_capacity)
+      return;
+
+   Element& e = element(m_size++);
+   e.timestamp = 1;
+   e.value.i = 0;
+   e.string = s_emptyString;
+}
+
+/**
+ * Remove element at given index
+ */
+void DCIValueCache::remove(uint32_t index)
+{
+   if (index >= m_size)
+      return;
+
+   freeString(&element(index));
+   for(uint32_t i = index + 1; i < m_size; i++)
+      element(i - 1) = element(i);
+   m_size--;
+}
+
+/**
+ * Get element at given index for reading. Empty element is returned if index is out of range.
+ */
+const DCIValueCache::Element& DCIValueCache::element(uint32_t index) const
+{
+   if (index >= m_size)
+   {
+      static const Element emptyElement = { 0, { 0 }, s_emptyString };
+      return emptyElement;
+   }
+   return m_elements[(m_head + index) % m_capacity];
+}
+
+/**
+ * Get cached value as signed 64 bit integer
+ */
+int64_t DCIValueCache::getInt64(uint32_t index) const
+{
+   const Element& e = element(index);
+   if (IsSignedIntegerType(m_dataType))
+      return e.value.i;
+   if (e.string != nullptr)
+      return wcstoll(e.string, nullptr, 0);
+   if (IsUnsignedIntegerType(m_dataType))
+      return (e.value.u > static_cast<uint64_t>(INT64_MAX)) ? INT64_MAX : static_cast<int64_t>(e.value.u);
+   return static_cast<int64_t>(e.value.d);
+}
+
+/**
+ * Get cached value as unsigned 64 bit integer
+ */
+uint64_t DCIValueCache::getUInt64(uint32_t index) const
+{
+   const Element& e = element(index);
+   if (IsUnsignedIntegerType(m_dataType))
+      return e.value.u;
+   if (e.string != nullptr)
+      return wcstoull(e.string, nullptr, 0);
+   if (IsSignedIntegerType(m_dataType))
+      return static_cast<uint64_t>(e.value.i);
+   return static_cast<uint64_t>(static_cast<int64_t>(e.value.d));
+}
+
+/**
+ * Get cached value as floating point number
+ */
+double DCIValueCache::getDouble(uint32_t index) const
+{
+   const Element& e = element(index);
+   if (!IsSignedIntegerType(m_dataType) && !IsUnsignedIntegerType(m_dataType))
+      return e.value.d;
+   if (e.string != nullptr)
+      return wcstod(e.string, nullptr);
+   return IsSignedIntegerType(m_dataType) ? static_cast<double>(e.value.i) : static_cast<double>(e.value.u);
+}
+
+/**
+ * Get cached value as ItemValue object
+ */
+ItemValue DCIValueCache::get(uint32_t index) const
+{
+   const Element& e = element(index);
+   wchar_t buffer[DCI_VALUE_CACHE_STRING_BUFFER_SIZE];
+   const wchar_t *s = format(e, buffer);
+
+   ItemValue value(L"", Timestamp::fromMilliseconds(e.timestamp), false);
+   if (IsSignedIntegerType(m_dataType))
+      value.set(e.value.i, s);
+   else if (IsUnsignedIntegerType(m_dataType))
+      value.set(e.value.u, s);
+   else if (m_dataType == DCI_DT_FLOAT)
+      value.set(e.value.d, s);
+   else
+      value.set(s);
+   return value;
+}
+
+/**
+ * Get estimated memory usage by cache
+ */
+uint64_t DCIValueCache::getMemoryUsage() const
+{
+   uint64_t size = static_cast<uint64_t>(m_capacity) * sizeof(Element);
+   for(uint32_t i = 0; i < m_size; i++)
+   {
+      const Element& e = element(i);
+      if ((e.string != nullptr) && (e.string != s_emptyString))
+         size += (wcslen(e.string) + 1) * sizeof(wchar_t);
+   }
+   return size;
+}
+
 /**
  * Signed diff for unsigned int32 values
  */
@@ -232,18 +597,50 @@ void CalculateItemValueDiff(ItemValue *result, int dataType, const ItemValue &cu
    }
 }
 
+/**
+ * Check if sample at given position is a placeholder (array of values)
+ */
+static inline bool IsPlaceholderSample(const ItemValue * const *valueList, size_t index)
+{
+   return valueList[index]->getTimeStamp().asMilliseconds() == 1;
+}
+
+/**
+ * Check if sample at given position is a placeholder (value cache)
+ */
+static inline bool IsPlaceholderSample(const DCIValueCache& cache, size_t index)
+{
+   return cache.isPlaceholder(static_cast<uint32_t>(index));
+}
+
+/**
+ * Get sample at given position as value of given type (array of values)
+ */
+template<typename T> static inline T GetSampleValue(const ItemValue * const *valueList, size_t index)
+{
+   return static_cast<T>(*valueList[index]);
+}
+
+/**
+ * Get sample at given position as value of given type (value cache)
+ */
+template<typename T> static inline T GetSampleValue(const DCIValueCache& cache, size_t index)
+{
+   return cache.getValue<T>(static_cast<uint32_t>(index));
+}
+
 /**
  * Calculate average value for values of given type
  */
-template<typename T> static T CalculateAverage(const ItemValue * const *valueList, size_t sampleCount)
+template<typename T, typename L> static T CalculateAverage(const L& valueList, size_t sampleCount)
 {
    T sum = 0;
    int count = 0;
    for(size_t i = 0; i < sampleCount; i++)
    {
-      if (valueList[i]->getTimeStamp().asMilliseconds() != 1)
+      if (!IsPlaceholderSample(valueList, i))
       {
-         sum += static_cast<T>(*valueList[i]);
+         sum += GetSampleValue<T>(valueList, i);
          count++;
       }
    }
@@ -253,7 +650,7 @@ template<typename T> static T CalculateAverage(const ItemValue * const *valueLis
 /**
  * Calculate average value for set of values
  */
-void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount)
+template<typename L> static void CalculateAverageForType(ItemValue *result, int dataType, const L& valueList, size_t sampleCount)
 {
    switch(dataType)
    {
@@ -282,6 +679,22 @@ void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValue
    }
 }
 
+/**
+ * Calculate average value for set of values
+ */
+void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount)
+{
+   CalculateAverageForType(result, dataType, valueList, sampleCount);
+}
+
+/**
+ * Calculate average value for first sampleCount values in cache
+ */
+void CalculateItemValueAverage(ItemValue *result, int dataType, const DCIValueCache& cache, size_t sampleCount)
+{
+   CalculateAverageForType(result, dataType, cache, std::min(sampleCount, static_cast<size_t>(cache.size())));
+}
+
 /**
  * Calculate total value for values of given type
  */
@@ -331,15 +744,15 @@ void CalculateItemValueTotal(ItemValue *result, int dataType, const ItemValue *
 /**
  * Calculate mean absolute deviation for values of given type
  */
-template<typename T, T (*ABS)(T)> static T CalculateMeanDeviation(const ItemValue * const *valueList, size_t sampleCount)
+template<typename T, T (*ABS)(T), typename L> static T CalculateMeanDeviation(const L& valueList, size_t sampleCount)
 {
    T mean = 0;
    int count = 0;
    for(size_t i = 0; i < sampleCount; i++)
    {
-      if (valueList[i]->getTimeStamp().asMilliseconds() != 1)
+      if (!IsPlaceholderSample(valueList, i))
       {
-         mean += static_cast<T>(*valueList[i]);
+         mean += GetSampleValue<T>(valueList, i);
          count++;
       }
    }
@@ -347,8 +760,8 @@ template<typename T, T (*ABS)(T)> static T CalculateMeanDeviation(const ItemValu
    T dev = 0;
    for(size_t i = 0; i < sampleCount; i++)
    {
-      if (valueList[i]->getTimeStamp().asMilliseconds() != 1)
-         dev += ABS(static_cast<T>(*valueList[i]) - mean);
+      if (!IsPlaceholderSample(valueList, i))
+         dev += ABS(GetSampleValue<T>(valueList, i) - mean);
    }
    return dev / static_cast<T>(count);
 }
@@ -388,7 +801,7 @@ static uint64_t noop64(uint64_t v)
 /**
  * Calculate mean absolute deviation for set of values
  */
-void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount)
+template<typename L> static void CalculateMeanDeviationForType(ItemValue *result, int dataType, const L& valueList, size_t sampleCount)
 {
    switch(dataType)
    {
@@ -417,6 +830,22 @@ void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const Item
    }
 }
 
+/**
+ * Calculate mean absolute deviation for set of values
+ */
+void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount)
+{
+   CalculateMeanDeviationForType(result, dataType, valueList, sampleCount);
+}
+
+/**
+ * Calculate mean absolute deviation for first sampleCount values in cache
+ */
+void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const DCIValueCache& cache, size_t sampleCount)
+{
+   CalculateMeanDeviationForType(result, dataType, cache, std::min(sampleCount, static_cast<size_t>(cache.size())));
+}
+
 /**
  * Calculate min value for values of given type
  */
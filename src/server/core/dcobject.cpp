@@ -205,6 +205,8 @@ DCObject::DCObject(const shared_ptr<DataCollectionOwner>& owner) : m_owner(owner
    m_lastScriptErrorReport = 0;
    m_doForcePoll = false;
    m_pollingSessionId = -1;
+   m_schedulerTicket = 0;
+   m_scheduledPollTime = 0;
    m_instanceDiscoveryMethod = IDM_NONE;
    m_instanceRetentionTime = -1;
    m_instanceGracePeriodStart = 0;
@@ -253,6 +255,8 @@ DCObject::DCObject(const DCObject *src, bool shadowCopy) :
    m_snmpAgentName = src->m_snmpAgentName;
 	m_doForcePoll = false;
 	m_pollingSessionId = -1;
+   m_schedulerTicket = 0;
+   m_scheduledPollTime = 0;
    m_lastScriptErrorReport = 0;
    m_schedules = (src->m_schedules != nullptr) ? new StringList(src->m_schedules) : nullptr;
    m_instanceDiscoveryMethod = src->m_instanceDiscoveryMethod;
@@ -298,6 +302,8 @@ DCObject::DCObject(uint32_t id, const TCHAR *name, int source, BYTE scheduleType
    m_lastScriptErrorReport = 0;
    m_doForcePoll = false;
    m_pollingSessionId = -1;
+   m_schedulerTicket = 0;
+   m_scheduledPollTime = 0;
    m_instanceDiscoveryMethod = IDM_NONE;
    m_instanceRetentionTime = -1;
    m_instanceGracePeriodStart = 0;
@@ -377,6 +383,8 @@ DCObject::DCObject(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& o
    m_comments = config->getSubEntryValue(_T("comments"));
    m_doForcePoll = false;
    m_pollingSessionId = -1;
+   m_schedulerTicket = 0;
+   m_scheduledPollTime = 0;
    if (nxslV5)
    {
       setTransformationScriptInternal(config->getSubEntryValue(_T("transformation")));
@@ -473,6 +481,8 @@ DCObject::DCObject(json_t *json, const shared_ptr<DataCollectionOwner>& owner, I
    m_comments = json_object_get_string(json, "comments", _T(""));
    m_doForcePoll = false;
    m_pollingSessionId = -1;
+   m_schedulerTicket = 0;
+   m_scheduledPollTime = 0;
    setTransformationScriptInternal(json_object_get_string(json, "transformation", _T("")));
 
    json_t *schedulesArray = json_object_get(json, "schedules");
@@ -837,6 +847,28 @@ void DCObject::setThresholdDisableEndTime(time_t thresholdDisableEndTime)
    unlock();
 }
 
+/**
+ * Count number of fields in schedule string
+ */
+static int CountScheduleFields(const TCHAR *schedule)
+{
+   int count = 0;
+   bool inField = false;
+   for(const TCHAR *p = schedule; *p != 0; p++)
+   {
+      if (_istspace(*p))
+      {
+         inField = false;
+      }
+      else if (!inField)
+      {
+         inField = true;
+         count++;
+      }
+   }
+   return count;
+}
+
 /**
  * Expand custom schedule string
  */
@@ -874,9 +906,10 @@ String DCObject::expandSchedule(const TCHAR *schedule)
 }
 
 /**
- * Check if data collection object have to be polled
+ * Check if data collection object have to be polled. On return nextCheckTime is set to the time
+ * when object should be checked again, or to 0 if object cannot be polled until it is changed.
  */
-bool DCObject::isReadyForPolling(time_t currTime)
+bool DCObject::isReadyForPolling(time_t currTime, time_t *nextCheckTime)
 {
    // Normally data collection object will be locked when it is being
    // changed or when it is processing new data
@@ -885,6 +918,7 @@ bool DCObject::isReadyForPolling(time_t currTime)
    if (!tryLock())
    {
       nxlog_debug_tag(DEBUG_TAG_DC_SCHEDULER, 5, _T("DCObject::isReadyForPolling: cannot obtain lock for data collection object [%u]"), m_id);
+      *nextCheckTime = currTime + 1;
       return false;
    }
 
@@ -895,6 +929,7 @@ bool DCObject::isReadyForPolling(time_t currTime)
           matchClusterResource() && hasValue()) // Ignore agent cache mode for forced polls and always request data as if cache is off
       {
          unlock();
+         *nextCheckTime = currTime + 1;
          return true;
       }
       else
@@ -903,18 +938,30 @@ bool DCObject::isReadyForPolling(time_t currTime)
          nxlog_debug_tag(DEBUG_TAG_DC_SCHEDULER, 6, _T("Forced poll of DC object %s [%u] on node %s [%u] cancelled"), m_name.cstr(), m_id, getOwnerName(), m_ownerId);
          m_pollingSessionId = -1;
          m_doForcePoll = false;
-         unlock();
-         return false;
       }
    }
 
-   bool result;
-   if ((m_status != ITEM_STATUS_DISABLED) && (!m_busy) &&
-       isCacheLoaded() && (m_source != DS_PUSH_AGENT) && (m_source != DS_OTLP) &&
-       matchClusterResource() && hasValue() && (getAgentCacheMode() == AGENT_CACHE_OFF) &&
-       (m_nextPollTime <= currTime))
+   // Objects which are disabled, waiting for cache load, or not collected by server are dropped from schedule
+   // and re-scheduled by corresponding change hooks
+   bool result = false;
+   *nextCheckTime = 0;
+   if ((m_status != ITEM_STATUS_DISABLED) &&
+       isCacheLoaded() && (m_source != DS_PUSH_AGENT) && (m_source != DS_OTLP) && hasValue())
    {
-      if (m_pollingScheduleType == DC_POLLING_SCHEDULE_ADVANCED)
+      if (!matchClusterResource() || (getAgentCacheMode() != AGENT_CACHE_OFF))
+      {
+         // Cluster resource ownership and agent cache mode may change without data collection configuration change
+         *nextCheckTime = currTime + DC_STATE_RECHECK_INTERVAL;
+      }
+      else if (m_busy)
+      {
+         *nextCheckTime = currTime + 1;   // Check again when current poll completes
+      }
+      else if (m_nextPollTime > currTime)
+      {
+         *nextCheckTime = m_nextPollTime;
+      }
+      else if (m_pollingScheduleType == DC_POLLING_SCHEDULE_ADVANCED)
       {
          if (m_schedules != nullptr)
          {
@@ -926,40 +973,45 @@ bool DCObject::isReadyForPolling(time_t currTime)
             memcpy(&tmCurrLocal, localtime(&currTime), sizeof(struct tm));
             memcpy(&tmLastLocal, localtime(&m_tLastCheck), sizeof(struct tm));
 #endif
-            result = false;
+            bool secondsResolution = false;
             for(int i = 0; i < m_schedules->size(); i++)
             {
                bool withSeconds = false;
 
-               String schedule = expandSchedule(m_schedules->get(i));
+               // Schedules generated by script or containing seconds field should be checked every second
+               const TCHAR *source = m_schedules->get(i);
+               if (!secondsResolution && (!_tcsncmp(source, _T("%["), 2) || (CountScheduleFields(source) > 5)))
+                  secondsResolution = true;
+
+               if (result)
+                  continue;
+
+               String schedule = expandSchedule(source);
                if (MatchScheduleWithSeconds(schedule, &withSeconds, &tmCurrLocal, currTime))
                {
                   if (withSeconds || (currTime - m_tLastCheck >= 60) || (tmCurrLocal.tm_min != tmLastLocal.tm_min))
-                  {
                      result = true;
-                     break;
-                  }
                }
             }
-         }
-         else
-         {
-            result = false;
+            *nextCheckTime = secondsResolution ? currTime + 1 : currTime - currTime % 60 + 60;
          }
          m_tLastCheck = currTime;
       }
       else
       {
-			if (m_status == ITEM_STATUS_NOT_SUPPORTED)
-		      result = ((m_lastPollTime.asTime() + getEffectivePollingInterval() * 10 <= currTime) && (m_startTime <= currTime));
-			else
-		      result = ((m_lastPollTime.asTime() + getEffectivePollingInterval() <= currTime) && (m_startTime <= currTime));
+         int32_t interval = getEffectivePollingInterval();
+         time_t nextPollTime = std::max(m_lastPollTime.asTime() + ((m_status == ITEM_STATUS_NOT_SUPPORTED) ? interval * 10 : interval), m_startTime);
+         if (nextPollTime <= currTime)
+         {
+            result = true;
+            *nextCheckTime = currTime + std::max(interval, 1);
+         }
+         else
+         {
+            *nextCheckTime = nextPollTime;
+         }
       }
    }
-   else
-   {
-      result = false;
-   }
    unlock();
    return result;
 }
@@ -1370,7 +1422,10 @@ void DCObject::setTransformationScriptInternal(const wchar_t *source)
    if ((source != nullptr) && !IsBlankString(source))
    {
       m_transformationScriptSource = source;
-      m_transformationScript = shared_ptr<NXSL_Program>(CompileServerScript(m_transformationScriptSource, SCRIPT_CONTEXT_DCI, getOwner().get(), m_id, _T("DCI::%s::%d::TransformationScript"), getOwnerName(), m_id));
+      NXSL_CompilationDiagnostic diag;
+      m_transformationScript = CompileSharedServerScript(m_transformationScriptSource, &diag);
+      if (m_transformationScript == nullptr)
+         ReportScriptError(SCRIPT_CONTEXT_DCI, getOwner().get(), m_id, diag.errorText, _T("DCI::%s::%d::TransformationScript"), getOwnerName(), m_id);
    }
    else
    {
@@ -1566,6 +1621,7 @@ void DCObject::requestForcePoll(session_id_t sessionId)
    m_pollingSessionId = sessionId;
    m_doForcePoll = true;
    unlock();
+   ScheduleDataCollection(shared_from_this(), time(nullptr));
 }
 
 /**
@@ -1719,28 +1775,34 @@ StringObjectMap<InstanceDiscoveryData> *DCObject::filterInstanceList(StringMap *
       return filteredInstances;
    }
 
-   FilterCallbackData data;
-   data.instanceFilter = new NXSL_VM(new NXSL_ServerEnv());
-   data.instanceFilter->setUserData(getOwner().get());
-   if (!data.instanceFilter->load(m_instanceFilter.get()))
+   shared_ptr<NXSL_Program> script = m_instanceFilter;
+   unlock();
+
+   ScriptVMHandle vm = AcquirePooledServerScriptVM(script, shared_ptr<NetObj>());
+   if (!vm.isValid())
    {
-      ReportScriptError(SCRIPT_CONTEXT_DCI, getOwner().get(), m_id, data.instanceFilter->getErrorText(), _T("DCI::%s::%d::InstanceFilter"), getOwnerName(), m_id);
-      unlock();
-      delete data.instanceFilter;
+      if (vm.failureReason() == ScriptVMFailureReason::SCRIPT_IS_EMPTY)
+      {
+         // Empty script returns null for every instance, so all instances are filtered out
+         return filteredInstances;
+      }
+      ReportScriptError(SCRIPT_CONTEXT_DCI, getOwner().get(), m_id, vm.failureReasonText(), _T("DCI::%s::%d::InstanceFilter"), getOwnerName(), m_id);
       delete filteredInstances;
       nxlog_debug_tag(DEBUG_TAG_DC_CONFIG, 5, _T("DCObject::filterInstanceList(%s [%u]): all instances removed because filtering script cannot be loaded"), m_name.cstr(), m_id);
       getOwner()->sendPollerMsg(POLLER_ERROR _T("      Cannot load instance filtering script\r\n"));
       return nullptr;
    }
-   unlock();
+   vm->setUserData(getOwner().get());
 
+   FilterCallbackData data;
+   data.instanceFilter = vm;
    data.filteredInstances = filteredInstances;
    data.dco = this;
    if (instances->forEach(FilterCallback, &data) == _STOP)
    {
       delete_and_null(filteredInstances);
    }
-   delete data.instanceFilter;
+   ReleasePooledServerScriptVM(vm, script);
    return filteredInstances;
 }
 
@@ -1754,8 +1816,7 @@ void DCObject::setInstanceFilter(const TCHAR *script)
       m_instanceFilterSource = script;
 
       NXSL_CompilationDiagnostic diag;
-      NXSL_ServerEnv env;
-      m_instanceFilter = shared_ptr<NXSL_Program>(NXSLCompile(m_instanceFilterSource, &env, &diag));
+      m_instanceFilter = CompileSharedServerScript(m_instanceFilterSource, &diag);
       if (m_instanceFilter == nullptr)
       {
          // node can be nullptr if this DCO was just created from template
@@ -0,0 +1,55 @@
+/*
+** NetXMS - Network Management System
+** Copyright (C) 2003-2026 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: dcsched.cpp
+**
+**/
+
+#include "nxcore.h"
+#include <nxcore_dcsched.h>
+
+/**
+ * Scheduler instance
+ */
+static DataCollectionScheduler<DCObject> s_scheduler(time(nullptr));
+
+/**
+ * Schedule data collection object to be checked for polling not later than at given time.
+ * If onlyIfNotScheduled is true, object will be scheduled only if it does not have active schedule entry.
+ */
+void ScheduleDataCollection(const shared_ptr<DCObject>& dcObject, time_t dueTime, bool onlyIfNotScheduled)
+{
+   s_scheduler.schedule(dcObject, dueTime, onlyIfNotScheduled);
+}
+
+/**
+ * Schedule set of data collection objects to be checked for polling not later than at given time
+ */
+void ScheduleDataCollection(const SharedObjectArray<DCObject>& dcObjects, time_t dueTime, bool onlyIfNotScheduled)
+{
+   s_scheduler.schedule(dcObjects, dueTime, onlyIfNotScheduled);
+}
+
+/**
+ * Collect data collection objects due for polling check at given time. Collected objects are
+ * removed from schedule and should be re-scheduled by caller after check.
+ */
+void CollectScheduledDataCollectionObjects(time_t now, SharedObjectArray<DCObject> *dueObjects)
+{
+   s_scheduler.collectDueObjects(now, dueObjects);
+}
@@ -389,7 +389,7 @@ bool DCTable::processNewValue(Timestamp timestamp, const shared_ptr<Table>& valu
    }
 
    if (g_flags & AF_PERFDATA_STORAGE_DRIVER_LOADED)
-      PerfDataStorageRequest(this, timestamp, value.get());
+      PerfDataStorageRequest(this, timestamp, value);
 
    return true;
 }
@@ -406,7 +406,8 @@ bool DCTable::transform(const shared_ptr<Table>& value)
    }
 
    bool success = false;
-   ScriptVMHandle vm = CreateServerScriptVM(m_transformationScript.get(), m_owner.lock(), createDescriptorInternal());
+   shared_ptr<NXSL_Program> script = m_transformationScript;  // Script can be changed while DCI is unlocked
+   ScriptVMHandle vm = AcquirePooledServerScriptVM(script, m_owner.lock(), createDescriptorInternal());
    if (vm.isValid())
    {
       SetRestrictedSecurityContext(vm);
@@ -440,7 +441,7 @@ bool DCTable::transform(const shared_ptr<Table>& value)
             }
          }
       }
-      vm.destroy();
+      ReleasePooledServerScriptVM(vm, script);
    }
    else if (vm.failureReason() != ScriptVMFailureReason::SCRIPT_IS_EMPTY)
    {
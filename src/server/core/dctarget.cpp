@@ -36,6 +36,16 @@ extern ThreadPool *g_dataCollectorThreadPool;
  */
 void DataCollector(const shared_ptr<DCObject>& dcObject);
 
+/**
+ * Data collector worker for batch of SNMP items
+ */
+void SNMPBatchDataCollector(SharedObjectArray<DCObject> *batch);
+
+/**
+ * SNMP request coalescing flag
+ */
+extern bool g_snmpRequestCoalescing;
+
 /**
  * Throttle housekeeper if needed. Returns false if shutdown time has arrived and housekeeper process should be aborted.
  */
@@ -1198,22 +1208,36 @@ bool DataCollectionTarget::isDataCollectionDisabled()
 }
 
 /**
- * Put items which requires polling into the queue
+ * Check given data collection objects (which should belong to this target) and put ones
+ * which require polling into the queue. Checked objects are re-scheduled for next check.
  */
-void DataCollectionTarget::queueItemsForPolling()
+void DataCollectionTarget::queueItemsForPolling(const SharedObjectArray<DCObject>& dcObjects)
 {
-   if ((m_status == STATUS_UNMANAGED) || isDataCollectionDisabled() || m_isDeleted)
-      return;  // Do not collect data for unmanaged objects or if data collection is disabled
+   if ((m_status == STATUS_UNMANAGED) || m_isDeleted)
+      return;  // Do not collect data for unmanaged objects (will be re-scheduled when object become managed)
 
    time_t currTime = time(nullptr);
+   if (isDataCollectionDisabled())
+   {
+      // Data collection can be re-enabled without data collection configuration change
+      ScheduleDataCollection(dcObjects, currTime + DC_STATE_RECHECK_INTERVAL);
+      return;
+   }
 
    bool requireConnectivity = getCustomAttributeAsBoolean(L"SysConfig:DataCollection.Scheduler.RequireConnectivity", (g_flags & AF_DC_SCHEDULER_REQUIRES_CONNECTIVITY) != 0);
 
+   // SNMP items which are due on same node with same transport settings can be collected with combined requests
+   StringObjectMap<SharedObjectArray<DCObject>> snmpBatches(Ownership::False);
+
    readLockDciAccess();
-   for(int i = 0; i < m_dcObjects.size(); i++)
+   for(int i = 0; i < dcObjects.size(); i++)
    {
-		DCObject *object = m_dcObjects.get(i);
-      if (m_dcObjects.get(i)->isReadyForPolling(currTime))
+		DCObject *object = dcObjects.get(i);
+      time_t nextCheckTime;
+      bool ready = object->isReadyForPolling(currTime, &nextCheckTime);
+      if (nextCheckTime != 0)
+         ScheduleDataCollection(dcObjects.getShared(i), nextCheckTime);
+      if (ready)
       {
          object->setBusyFlag();
 
@@ -1252,6 +1276,7 @@ void DataCollectionTarget::queueItemsForPolling()
                               m_name, object->getId(), object->getName().cstr());
                      // Set next poll time to be at least half of status polling interval later to avoid re-checking too often
                      object->setNextPollTime(currTime + g_statusPollingInterval / 2);
+                     ScheduleDataCollection(dcObjects.getShared(i), currTime + g_statusPollingInterval / 2);
                      object->clearBusyFlag();
                      continue;  // Skip polling if agent is unreachable
                   }
@@ -1261,6 +1286,7 @@ void DataCollectionTarget::queueItemsForPolling()
                               m_name, object->getId(), object->getName().cstr());
                      // Set next poll time to be at least half of status polling interval later to avoid re-checking too often
                      object->setNextPollTime(currTime + g_statusPollingInterval / 2);
+                     ScheduleDataCollection(dcObjects.getShared(i), currTime + g_statusPollingInterval / 2);
                      object->clearBusyFlag();
                      continue;  // Skip polling if SNMP is unreachable
                   }
@@ -1270,6 +1296,7 @@ void DataCollectionTarget::queueItemsForPolling()
                               m_name, object->getId(), object->getName().cstr());
                      // Set next poll time to be at least half of status polling interval later to avoid re-checking too often
                      object->setNextPollTime(currTime + g_statusPollingInterval / 2);
+                     ScheduleDataCollection(dcObjects.getShared(i), currTime + g_statusPollingInterval / 2);
                      object->clearBusyFlag();
                      continue;  // Skip polling if SSH is unreachable
                   }
@@ -1279,25 +1306,79 @@ void DataCollectionTarget::queueItemsForPolling()
                               m_name, object->getId(), object->getName().cstr());
                      // Set next poll time to be at least half of status polling interval later to avoid re-checking too often
                      object->setNextPollTime(currTime + g_statusPollingInterval / 2);
+                     ScheduleDataCollection(dcObjects.getShared(i), currTime + g_statusPollingInterval / 2);
                      object->clearBusyFlag();
                      continue;  // Skip polling if MODBUS is unreachable
                   }
                }
             }
 
+            if (g_snmpRequestCoalescing && (object->getDataSource() == DS_SNMP_AGENT) && (object->getType() == DCO_TYPE_ITEM) &&
+                !static_cast<DCItem*>(object)->isInterpretSnmpRawValue() && ((sourceNodeId != 0) || (getObjectClass() == OBJECT_NODE)))
+            {
+               StringBuffer batchKey;
+               batchKey.appendFormattedString(L"%08X/%u/%d/", (sourceNodeId != 0) ? sourceNodeId : m_id, object->getSnmpPort(), static_cast<int>(object->getSnmpVersion()));
+               batchKey.append(object->getSnmpContext().cstr());
+               batchKey.append(L'/');
+               batchKey.append(object->getSnmpAgentName().cstr());
+               SharedObjectArray<DCObject> *batch = snmpBatches.get(batchKey);
+               if (batch == nullptr)
+               {
+                  batch = new SharedObjectArray<DCObject>();
+                  snmpBatches.set(batchKey, batch);
+               }
+               batch->add(dcObjects.getShared(i));
+               nxlog_debug_tag(_T("obj.dc.queue"), 8, _T("DataCollectionTarget(%s)->QueueItemsForPolling(): item %d \"%s\" added to SNMP batch"),
+                        m_name, object->getId(), object->getName().cstr());
+               continue;
+            }
+
             wchar_t key[32];
             _sntprintf(key, 32, L"%08X/%s", (sourceNodeId != 0) ? sourceNodeId : m_id, object->getDataProviderName());
-            ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, DataCollector, m_dcObjects.getShared(i));
+            ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, DataCollector, dcObjects.getShared(i));
          }
          else
          {
-            ThreadPoolExecute(g_dataCollectorThreadPool, DataCollector, m_dcObjects.getShared(i));
+            ThreadPoolExecute(g_dataCollectorThreadPool, DataCollector, dcObjects.getShared(i));
          }
 			nxlog_debug_tag(_T("obj.dc.queue"), 8, _T("DataCollectionTarget(%s)->QueueItemsForPolling(): item %d \"%s\" added to queue"),
 			         m_name, object->getId(), object->getName().cstr());
       }
    }
    unlockDciAccess();
+
+   // Queue SNMP batches (use same serialization key as for individual SNMP items)
+   snmpBatches.forEach(
+      [this] (const wchar_t *batchKey, SharedObjectArray<DCObject> *batch) -> EnumerationCallbackResult
+      {
+         wchar_t key[32];
+         _sntprintf(key, 32, L"%08X/%s", static_cast<uint32_t>(wcstoul(batchKey, nullptr, 16)), DCObject::getDataProviderName(DS_SNMP_AGENT));
+         if (batch->size() == 1)
+         {
+            ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, DataCollector, batch->getShared(0));
+            delete batch;
+         }
+         else
+         {
+            nxlog_debug_tag(_T("obj.dc.queue"), 7, _T("DataCollectionTarget(%s)->QueueItemsForPolling(): SNMP batch of %d items queued"), m_name, batch->size());
+            ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, SNMPBatchDataCollector, batch);
+         }
+         return _CONTINUE;
+      });
+}
+
+/**
+ * Schedule all data collection objects of this target to be checked for polling not later than at given time.
+ * If onlyIfNotScheduled is true, only objects without active schedule will be scheduled.
+ */
+void DataCollectionTarget::scheduleDataCollection(time_t dueTime, bool onlyIfNotScheduled)
+{
+   if ((m_status == STATUS_UNMANAGED) || m_isDeleted)
+      return;
+
+   readLockDciAccess();
+   ScheduleDataCollection(m_dcObjects, dueTime, onlyIfNotScheduled);
+   unlockDciAccess();
 }
 
 /**
@@ -1311,6 +1392,7 @@ void DataCollectionTarget::updateDataCollectionTimeIntervals()
       m_dcObjects.get(i)->updateTimeIntervals();
    }
    unlockDciAccess();
+   scheduleDataCollection(time(nullptr), false);
 }
 
 /**
@@ -3019,8 +3101,13 @@ bool DataCollectionTarget::updateInstances(DCObject *root, StringObjectMap<Insta
          }
          if (object->getInstanceGracePeriodStart() > 0)
          {
+            // Object should be saved and re-scheduled as it was dropped from scheduler while disabled
             object->setInstanceGracePeriodStart(0);
             object->setStatus(ITEM_STATUS_ACTIVE, false);
+            nxlog_debug_tag(DEBUG_TAG_INSTANCE_POLL, 5, _T("DataCollectionTarget::updateInstances(%s [%u], %s [%u]): instance \"%s\" found again, grace period ended"),
+                      m_name, m_id, root->getName().cstr(), root->getId(), dcoInstance.cstr());
+            changed = true;
+            notify = true;
          }
          if (instanceObject->getRelatedObject() != object->getRelatedObject())
          {
@@ -3226,6 +3313,7 @@ void DataCollectionTarget::onDataCollectionLoad()
 {
    super::onDataCollectionLoad();
    calculateProxyLoad();
+   scheduleDataCollection(time(nullptr), true);
 }
 
 /**
@@ -3235,6 +3323,17 @@ void DataCollectionTarget::onDataCollectionChange()
 {
    super::onDataCollectionChange();
    calculateProxyLoad();
+   scheduleDataCollection(time(nullptr), false);   // Changed objects may be due earlier than currently scheduled
+}
+
+/**
+ * Hook for management status change
+ */
+void DataCollectionTarget::onMgmtStatusChange(bool isManaged, int oldStatus)
+{
+   super::onMgmtStatusChange(isManaged, oldStatus);
+   if (isManaged)
+      scheduleDataCollection(time(nullptr), true);
 }
 
 /**
@@ -43,7 +43,7 @@ NodeDeviceContext::~NodeDeviceContext()
    if (m_sshChannel != nullptr)
       m_sshChannel->close();
    if (m_ownSnmpTransport)
-      delete m_snmpTransport;
+      m_node->releaseSnmpTransport(m_snmpTransport);
 }
 
 /**
@@ -169,7 +169,7 @@ SNMP_Transport *NodeDeviceContext::getSNMPTransport()
    if (m_snmpTransport != nullptr)
       return m_snmpTransport;
 
-   m_snmpTransport = m_node->createSnmpTransport();
+   m_snmpTransport = m_node->acquireSnmpTransport();
    m_ownSnmpTransport = (m_snmpTransport != nullptr);
    return m_snmpTransport;
 }
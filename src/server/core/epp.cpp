@@ -960,55 +960,99 @@ void EPRule::getScriptDependencies(StringSet *dependencies) const
 }
 
 /**
- * Check if source object's id match to the rule
+ * Resolve event source object and collect IDs of source object and all its parents
  */
-bool EPRule::matchSource(const shared_ptr<NetObj>& object) const
+void EPRuleMatchContext::resolveSource()
+{
+   m_source = FindObjectById(m_event->getSourceId());
+   if (m_source != nullptr)
+   {
+      m_sourceObjectIds.put(m_source->getId());
+      m_source->getAllParentIds(&m_sourceObjectIds);
+      m_sourceObjectIds.forEach(
+         [this] (const uint32_t& id) -> EnumerationCallbackResult
+         {
+            m_sourceObjectIdList.add(id);
+            return _CONTINUE;
+         });
+   }
+   m_sourceResolved = true;
+}
+
+/**
+ * Get local time for event processing
+ */
+struct tm *EPRuleMatchContext::getLocalTime()
+{
+   if (!m_timeResolved)
+   {
+      time_t now = time(nullptr);
+#if HAVE_LOCALTIME_R
+      localtime_r(&now, &m_localTime);
+#else
+      memcpy(&m_localTime, localtime(&now), sizeof(struct tm));
+#endif
+      m_timeResolved = true;
+   }
+   return &m_localTime;
+}
+
+/**
+ * Check if any of the given object IDs is in the list (list is also available as set for fast lookup)
+ */
+static bool MatchObjectList(const IntegerArray<uint32_t>& list, const HashSet<uint32_t>& listAsSet, const IntegerArray<uint32_t>& objectIdList, const HashSet<uint32_t>& objectIds)
+{
+   if (list.size() <= objectIdList.size())
+   {
+      for(int i = 0; i < list.size(); i++)
+         if (objectIds.contains(list.get(i)))
+            return true;
+   }
+   else
+   {
+      for(int i = 0; i < objectIdList.size(); i++)
+         if (listAsSet.contains(objectIdList.get(i)))
+            return true;
+   }
+   return false;
+}
+
+/**
+ * Check if source object's id match to the rule. Source object is considered matching
+ * if it or any of its parents is in the list.
+ */
+bool EPRule::matchSource(EPRuleMatchContext *context) const
 {
    if (m_sources.isEmpty() && m_sourceExclusions.isEmpty())
       return (m_flags & RF_NEGATED_SOURCE) ? false : true;
 
-   if (object == nullptr)
+   if (context->getSource() == nullptr)
       return (m_flags & RF_NEGATED_SOURCE) ? true : false;
 
-   uint32_t objectId = object->getId();
-   bool exception = false;
-   for(int i = 0; i < m_sourceExclusions.size(); i++)
-   {
-      uint32_t id = m_sourceExclusions.get(i);
-      if (id == objectId)
-      {
-         exception = true;
-         break;
-      }
-
-      if (object->isParent(id))
-      {
-         exception = true;
-         break;
-      }
-   }
-   if (exception)
+   const IntegerArray<uint32_t>& objectIdList = context->getSourceObjectIdList();
+   const HashSet<uint32_t>& objectIds = context->getSourceObjectIds();
+   if (MatchObjectList(m_sourceExclusions, m_sourceExclusionSet, objectIdList, objectIds))
    {
       return (m_flags & RF_NEGATED_SOURCE) ? true : false;
    }
 
-   bool match = m_sources.isEmpty();
+   bool match = m_sources.isEmpty() || MatchObjectList(m_sources, m_sourceSet, objectIdList, objectIds);
+   return (m_flags & RF_NEGATED_SOURCE) ? !match : match;
+}
+
+/**
+ * Prepare internal structures used for fast event matching. Should be called after rule
+ * configuration is loaded or changed and before rule is used for event processing.
+ */
+void EPRule::compile()
+{
+   m_sourceSet.clear();
    for(int i = 0; i < m_sources.size(); i++)
-   {
-      uint32_t id = m_sources.get(i);
-      if (id == objectId)
-      {
-         match = true;
-         break;
-      }
+      m_sourceSet.put(m_sources.get(i));
 
-      if (object->isParent(id))
-      {
-         match = true;
-         break;
-      }
-   }
-   return (m_flags & RF_NEGATED_SOURCE) ? !match : match;
+   m_sourceExclusionSet.clear();
+   for(int i = 0; i < m_sourceExclusions.size(); i++)
+      m_sourceExclusionSet.put(m_sourceExclusions.get(i));
 }
 
 /**
@@ -1206,7 +1250,7 @@ static EnumerationCallbackResult ExecutePstorageSetAction(const TCHAR *key, cons
  * Check if event match to rule and perform required actions if yes
  * Method will return TRUE if event matched and RF_STOP_PROCESSING flag is set
  */
-bool EPRule::processEvent(Event *event) const
+bool EPRule::processEvent(Event *event, EPRuleMatchContext *context, bool eventCodeMatched) const
 {
    if (m_flags & RF_DISABLED)
       return false;
@@ -1221,23 +1265,17 @@ bool EPRule::processEvent(Event *event) const
       return false;
    }
 
-   if (!matchSeverity(event->getSeverity()) || !matchEvent(event->getCode()))
+   if (!matchSeverity(event->getSeverity()) || (!eventCodeMatched && !matchEvent(event->getCode())))
       return false;
 
-   shared_ptr<NetObj> object = FindObjectById(event->getSourceId());
-   if (!matchSource(object))
+   if (!matchSource(context))
       return false;
 
-   time_t now = time(nullptr);
-   struct tm currLocal;
-#if HAVE_LOCALTIME_R
-   localtime_r(&now, &currLocal);
-#else
-   memcpy(&currLocal, localtime(&now), sizeof(struct tm));
-#endif
-   if (!matchTime(&currLocal) || !matchScript(event))
+   if (!matchTime(context->getLocalTime()) || !matchScript(event))
       return false;
 
+   shared_ptr<NetObj> object = context->getSource();
+
    nxlog_debug_tag(DEBUG_TAG, 6, _T("Event ") UINT64_FMT _T(" match EPP rule %u"), event->getId(), m_id + 1);
 
    EventRuleExecution *rec = event->recordRuleExecution(this);   // nullptr if metadata recording is disabled
@@ -2288,6 +2326,7 @@ bool EventProcessingPolicy::loadFromDB()
             m_rules.add(rule);
       }
       DBFreeResult(hResult);
+      buildIndex();
    }
 
    DBConnectionPoolReleaseConnection(hdb);
@@ -2394,6 +2433,7 @@ uint32_t EventProcessingPolicy::saveWithMerge(uint32_t baseVersion, const Shared
          }
          m_rules.add(rule);
       }
+      buildIndex();
       m_version++;
       *newVersion = m_version;
       unlock();
@@ -2610,6 +2650,7 @@ uint32_t EventProcessingPolicy::saveWithMerge(uint32_t baseVersion, const Shared
          }
          m_rules.add(rule);
       }
+      buildIndex();
       m_version++;
       *newVersion = m_version;
       unlock();
@@ -2652,6 +2693,7 @@ uint32_t EventProcessingPolicy::replaceAllRules(const SharedObjectArray<EPRule>&
       rule->setId(static_cast<uint32_t>(i));
       m_rules.add(rule);
    }
+   buildIndex();
    m_version++;
    *newVersion = m_version;
    unlock();
@@ -2683,20 +2725,68 @@ void EventProcessingPolicy::fillRuleVersions(NXCPMessage *msg) const
 void EventProcessingPolicy::processEvent(Event *pEvent)
 {
 	nxlog_debug_tag(DEBUG_TAG, 7, L"EPP: processing event " UINT64_FMT, pEvent->getId());
+   EPRuleMatchContext context(pEvent);
    readLock();
-   int ruleNum = 1;
-   for (auto& rule : m_rules)
+   // Rules in both indexed and generic lists are already filtered by event code
+   const IntegerArray<int> *ruleList = m_eventIndex.get(pEvent->getCode());
+   if (ruleList == nullptr)
+      ruleList = &m_genericRules;
+   for(int i = 0; i < ruleList->size(); i++)
    {
-      if (rule->processEvent(pEvent))
+      int ruleIndex = ruleList->get(i);
+      if (m_rules.get(ruleIndex)->processEvent(pEvent, &context, true))
       {
-         nxlog_debug_tag(DEBUG_TAG, 7, _T("EPP: got \"stop processing\" flag for event ") UINT64_FMT _T(" at rule %d"), pEvent->getId(), ruleNum);
+         nxlog_debug_tag(DEBUG_TAG, 7, _T("EPP: got \"stop processing\" flag for event ") UINT64_FMT _T(" at rule %d"), pEvent->getId(), ruleIndex + 1);
          break;   // EPRule::ProcessEvent() return TRUE if we should stop processing this event
       }
-      ruleNum++;
    }
    unlock();
 }
 
+/**
+ * Build event code index for current rule list. Each indexed event code gets ordered list of rules
+ * which can match that code. Rules which can match events not explicitly referenced by any rule
+ * (rules without event list and rules with negated event list) form generic list.
+ * Policy should be write locked by caller.
+ */
+void EventProcessingPolicy::buildIndex()
+{
+   m_eventIndex.clear();
+   m_genericRules.clear();
+
+   HashSet<uint32_t> eventCodes;
+   for(int i = 0; i < m_rules.size(); i++)
+   {
+      EPRule *rule = m_rules.get(i);
+      rule->compile();
+
+      const IntegerArray<uint32_t>& events = rule->getEvents();
+      for(int j = 0; j < events.size(); j++)
+         eventCodes.put(events.get(j));
+
+      if (rule->isEventListNegated() ? !events.isEmpty() : events.isEmpty())
+         m_genericRules.add(i);
+   }
+
+   eventCodes.forEach(
+      [this] (const uint32_t& code) -> EnumerationCallbackResult
+      {
+         auto ruleList = new IntegerArray<int>(0, 16);
+         for(int i = 0; i < m_rules.size(); i++)
+         {
+            EPRule *rule = m_rules.get(i);
+            const IntegerArray<uint32_t>& events = rule->getEvents();
+            bool match = events.isEmpty() ? !rule->isEventListNegated() : (events.contains(code) != rule->isEventListNegated());
+            if (match)
+               ruleList->add(i);
+         }
+         m_eventIndex.set(code, ruleList);
+         return _CONTINUE;
+      });
+
+   nxlog_debug_tag(DEBUG_TAG, 5, _T("EPP index built: %d rules, %d indexed event codes, %d generic rules"), m_rules.size(), m_eventIndex.size(), m_genericRules.size());
+}
+
 /**
  * Send event policy to client
  */
@@ -2732,6 +2822,7 @@ void EventProcessingPolicy::replacePolicy(uint32_t numRules, EPRule **ruleList)
          ruleList[i] = nullptr;  // Ownership transferred
       }
    }
+   buildIndex();
    unlock();
 }
 
@@ -2939,6 +3030,7 @@ void EventProcessingPolicy::importRule(EPRule *rule, bool overwrite, ObjectArray
       }
    }
 
+   buildIndex();
    unlock();
 }
 
@@ -168,12 +168,16 @@ void LoadGeoAreas()
    if (hResult != nullptr)
    {
       int count = DBGetNumRows(hResult);
+      IntegerArray<uint64_t> keys(count);
+      SharedObjectArray<GeoArea> areas(count);
       for(int i = 0; i < count; i++)
       {
          auto area = make_shared<GeoArea>(hResult, i);
-         s_geoAreas.put(area->getId(), area);
+         keys.add(area->getId());
+         areas.add(area);
       }
       DBFreeResult(hResult);
+      s_geoAreas.putAll(keys, areas);
    }
    DBConnectionPoolReleaseConnection(hdb);
 }
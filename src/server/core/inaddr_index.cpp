@@ -1,6 +1,6 @@
 /*
 ** NetXMS - Network Management System
-** Copyright (C) 2003-2022 Victor Kirhenshtein
+** Copyright (C) 2003-2026 Victor Kirhenshtein
 **
 ** This program is free software; you can redistribute it and/or modify
 ** it under the terms of the GNU General Public License as published by
@@ -34,12 +34,91 @@ struct InetAddressIndexEntry
    shared_ptr<NetObj> object;
 };
 
+/**
+ * Node of address prefix radix tree. Nodes without entry are branching nodes and always have two children.
+ */
+struct InetAddressPrefixNode
+{
+   InetAddressPrefixNode *child[2];
+   InetAddressIndexEntry *entry;
+   BYTE prefix[16];
+   int prefixLen;
+};
+
+/**
+ * Build radix tree key from IP address (network byte order)
+ *
+ * @return prefix length in bits
+ */
+static int BuildPrefixKey(const InetAddress& addr, BYTE *key)
+{
+   if (addr.getFamily() == AF_INET)
+   {
+      uint32_t a = htonl(addr.getAddressV4());
+      memcpy(key, &a, 4);
+      memset(&key[4], 0, 12);
+   }
+   else
+   {
+      memcpy(key, addr.getAddressV6(), 16);
+   }
+   return addr.getMaskBits();
+}
+
+/**
+ * Get bit from radix tree key
+ */
+static inline int GetKeyBit(const BYTE *key, int bit)
+{
+   return (key[bit >> 3] >> (7 - (bit & 7))) & 1;
+}
+
+/**
+ * Get length of common prefix of two keys (up to given maximum length)
+ */
+static int CommonPrefixLength(const BYTE *key1, const BYTE *key2, int maxLen)
+{
+   int len = 0;
+   while((len + 8 <= maxLen) && (key1[len >> 3] == key2[len >> 3]))
+      len += 8;
+   while((len < maxLen) && (GetKeyBit(key1, len) == GetKeyBit(key2, len)))
+      len++;
+   return len;
+}
+
+/**
+ * Create radix tree node
+ */
+static InetAddressPrefixNode *CreatePrefixNode(const BYTE *key, int prefixLen, InetAddressIndexEntry *entry)
+{
+   auto node = MemAllocStruct<InetAddressPrefixNode>();
+   memcpy(node->prefix, key, 16);
+   node->prefixLen = prefixLen;
+   node->entry = entry;
+   return node;
+}
+
+/**
+ * Destroy radix tree
+ */
+static void DestroyPrefixTree(InetAddressPrefixNode *node)
+{
+   if (node == nullptr)
+      return;
+   DestroyPrefixTree(node->child[0]);
+   DestroyPrefixTree(node->child[1]);
+   MemFree(node);
+}
+
 /**
  * Constructor
  */
-InetAddressIndex::InetAddressIndex()
+InetAddressIndex::InetAddressIndex(bool prefixSearch)
 {
    m_root = nullptr;
+   m_prefixRootV4 = nullptr;
+   m_prefixRootV6 = nullptr;
+   m_prefixSearch = prefixSearch;
 }
 
 /**
@@ -54,6 +133,90 @@ InetAddressIndex::~InetAddressIndex()
       entry->object.~shared_ptr();
       MemFree(entry);
    }
+   DestroyPrefixTree(m_prefixRootV4);
+   DestroyPrefixTree(m_prefixRootV6);
+}
+
+/**
+ * Add entry to prefix tree. Index write lock must be held.
+ */
+void InetAddressIndex::addPrefix(InetAddressIndexEntry *entry)
+{
+   BYTE key[16];
+   int len = BuildPrefixKey(entry->addr, key);
+
+   InetAddressPrefixNode **link = (entry->addr.getFamily() == AF_INET) ? &m_prefixRootV4 : &m_prefixRootV6;
+   while(*link != nullptr)
+   {
+      InetAddressPrefixNode *node = *link;
+      int common = CommonPrefixLength(node->prefix, key, std::min(node->prefixLen, len));
+      if (common == node->prefixLen)
+      {
+         if (node->prefixLen == len)
+         {
+            node->entry = entry;
+            return;
+         }
+         link = &node->child[GetKeyBit(key, node->prefixLen)];
+         continue;
+      }
+
+      if (common == len)
+      {
+         // New prefix contains prefix of current node
+         InetAddressPrefixNode *n = CreatePrefixNode(key, len, entry);
+         n->child[GetKeyBit(node->prefix, len)] = node;
+         *link = n;
+      }
+      else
+      {
+         InetAddressPrefixNode *branch = CreatePrefixNode(key, common, nullptr);
+         branch->child[GetKeyBit(key, common)] = CreatePrefixNode(key, len, entry);
+         branch->child[GetKeyBit(node->prefix, common)] = node;
+         *link = branch;
+      }
+      return;
+   }
+   *link = CreatePrefixNode(key, len, entry);
+}
+
+/**
+ * Remove entry from prefix tree. Index write lock must be held.
+ */
+void InetAddressIndex::removePrefix(InetAddressIndexEntry *entry)
+{
+   BYTE key[16];
+   int len = BuildPrefixKey(entry->addr, key);
+
+   InetAddressPrefixNode **parentLink = nullptr;
+   InetAddressPrefixNode **link = (entry->addr.getFamily() == AF_INET) ? &m_prefixRootV4 : &m_prefixRootV6;
+   while((*link != nullptr) && ((*link)->prefixLen < len))
+   {
+      if (CommonPrefixLength((*link)->prefix, key, (*link)->prefixLen) < (*link)->prefixLen)
+         return;
+      parentLink = link;
+      link = &(*link)->child[GetKeyBit(key, (*link)->prefixLen)];
+   }
+
+   InetAddressPrefixNode *node = *link;
+   if ((node == nullptr) || (node->entry != entry))
+      return;
+
+   node->entry = nullptr;
+   if ((node->child[0] != nullptr) && (node->child[1] != nullptr))
+      return;  // Keep as branching node
+
+   InetAddressPrefixNode *child = (node->child[0] != nullptr) ? node->child[0] : node->child[1];
+   *link = child;
+   MemFree(node);
+
+   if ((child == nullptr) && (parentLink != nullptr) && ((*parentLink)->entry == nullptr))
+   {
+      // Parent branching node has only one child left
+      InetAddressPrefixNode *parent = *parentLink;
+      *parentLink = (parent->child[0] != nullptr) ? parent->child[0] : parent->child[1];
+      MemFree(parent);
+   }
 }
 
 /**
@@ -84,8 +247,16 @@ bool InetAddressIndex::put(const InetAddress& addr, const shared_ptr<NetObj>& ob
       entry->addr = addr;
       new(&entry->object) shared_ptr<NetObj>();
       HASH_ADD_KEYPTR(hh, m_root, entry->key, sizeof(key), entry);
+      if (m_prefixSearch)
+         addPrefix(entry);
       replace = false;
    }
+   else if (m_prefixSearch && (entry->addr.getMaskBits() != addr.getMaskBits()))
+   {
+      removePrefix(entry);
+      entry->addr = addr;
+      addPrefix(entry);
+   }
    entry->object = object;
 
    m_lock.unlock();
@@ -127,6 +298,8 @@ void InetAddressIndex::remove(const InetAddress& addr)
    HASH_FIND(hh, m_root, key, sizeof(key), entry);
    if (entry != NULL)
    {
+      if (m_prefixSearch)
+         removePrefix(entry);
       HASH_DEL(m_root, entry);
       entry->object.~shared_ptr();
       MemFree(entry);
@@ -182,6 +355,89 @@ shared_ptr<NetObj> InetAddressIndex::find(bool (*comparator)(NetObj *, void *),
    return object;
 }
 
+/**
+ * Find object with longest address prefix containing given address. Index should be created with prefix search enabled.
+ */
+shared_ptr<NetObj> InetAddressIndex::findLongestPrefixMatch(const InetAddress& addr) const
+{
+   shared_ptr<NetObj> object;
+
+   if (!m_prefixSearch || !addr.isValid())
+      return object;
+
+   BYTE key[16];
+   BuildPrefixKey(addr, key);
+   int keyLen = (addr.getFamily() == AF_INET) ? 32 : 128;
+
+   m_lock.readLock();
+
+   const InetAddressPrefixNode *node = (addr.getFamily() == AF_INET) ? m_prefixRootV4 : m_prefixRootV6;
+   while(node != nullptr)
+   {
+      if (CommonPrefixLength(node->prefix, key, node->prefixLen) < node->prefixLen)
+         break;
+      if ((node->entry != nullptr) && node->entry->addr.contains(addr))
+         object = node->entry->object;
+      if (node->prefixLen >= keyLen)
+         break;
+      node = node->child[GetKeyBit(key, node->prefixLen)];
+   }
+
+   m_lock.unlock();
+   return object;
+}
+
+/**
+ * Collect all entries from given subtree which overlap with given prefix
+ */
+static void CollectOverlappingEntries(const InetAddressPrefixNode *node, const InetAddress& prefix, SharedObjectArray<NetObj> *objects)
+{
+   if (node == nullptr)
+      return;
+   if ((node->entry != nullptr) && (prefix.contains(node->entry->addr) || node->entry->addr.contains(prefix)))
+      objects->add(node->entry->object);
+   CollectOverlappingEntries(node->child[0], prefix, objects);
+   CollectOverlappingEntries(node->child[1], prefix, objects);
+}
+
+/**
+ * Get all objects with address prefix overlapping given prefix (either containing it or contained in it).
+ * Index should be created with prefix search enabled.
+ */
+unique_ptr<SharedObjectArray<NetObj>> InetAddressIndex::getOverlappingObjects(const InetAddress& prefix) const
+{
+   unique_ptr<SharedObjectArray<NetObj>> objects = make_unique<SharedObjectArray<NetObj>>();
+
+   if (!m_prefixSearch || !prefix.isValid())
+      return objects;
+
+   BYTE key[16];
+   int len = BuildPrefixKey(prefix, key);
+
+   m_lock.readLock();
+
+   const InetAddressPrefixNode *node = (prefix.getFamily() == AF_INET) ? m_prefixRootV4 : m_prefixRootV6;
+   while(node != nullptr)
+   {
+      int common = CommonPrefixLength(node->prefix, key, std::min(node->prefixLen, len));
+      if (node->prefixLen >= len)
+      {
+         // Whole subtree is within given prefix
+         if (common == len)
+            CollectOverlappingEntries(node, prefix, objects.get());
+         break;
+      }
+      if (common < node->prefixLen)
+         break;
+      if ((node->entry != nullptr) && (prefix.contains(node->entry->addr) || node->entry->addr.contains(prefix)))
+         objects->add(node->entry->object);
+      node = node->child[GetKeyBit(key, node->prefixLen)];
+   }
+
+   m_lock.unlock();
+   return objects;
+}
+
 /**
  * Get index size
  */
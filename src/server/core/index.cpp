@@ -23,134 +23,273 @@
 #include "nxcore.h"
 
 /**
- * Object index element
+ * Maximum number of elements in index tree node
  */
-struct INDEX_ELEMENT
+#define INDEX_NODE_CAPACITY   64
+
+/**
+ * Node with less elements will be merged with neighbor after element removal
+ */
+#define INDEX_NODE_MIN_FILL   (INDEX_NODE_CAPACITY / 4)
+
+/**
+ * Index tree node. In leaf nodes values are indexed objects, in internal nodes values are child nodes
+ * and keys are lower bounds of child subtrees (key of child N is greater than any key in child N - 1
+ * and is less or equal to any key in child N).
+ */
+struct INDEX_NODE
 {
-   uint64_t key;
-   void *object;
+   uint64_t version;       // Write version that created this node; nodes from current write version can be modified in place
+   INDEX_NODE *nextRetired;
+   int count;
+   bool leaf;
+   uint64_t keys[INDEX_NODE_CAPACITY];
+   void *values[INDEX_NODE_CAPACITY];
+
+   INDEX_NODE *child(int index) const
+   {
+      return static_cast<INDEX_NODE*>(values[index]);
+   }
 };
 
 /**
- * Index head
+ * Index head (published version of index tree)
  */
 struct INDEX_HEAD
 {
-   INDEX_ELEMENT *elements;
+   INDEX_NODE *root;
    size_t size;
-   size_t allocated;
-   uint64_t maxKey;
+   uint64_t version;             // Write version that published this head
    VolatileCounter readers;
-   VolatileCounter writers;
+   INDEX_HEAD *next;             // Next head in retired or free list
+   INDEX_NODE *retiredNodes;     // Nodes replaced when this version was superseded
+   Array retiredObjects;         // Owned objects replaced or removed when this version was superseded
+
+   INDEX_HEAD() : retiredObjects(0, 64, Ownership::False)
+   {
+      root = nullptr;
+      size = 0;
+      version = 0;
+      readers = 0;
+      next = nullptr;
+      retiredNodes = nullptr;
+   }
 };
 
 /**
- * Default object destructor
+ * Find position of first key in node which is greater or equal to given key
  */
-static void DefaultObjectDestructor(void *object, AbstractIndexBase *index)
+static inline int LowerBound(const INDEX_NODE *node, uint64_t key)
 {
-   MemFree(object);
+   int first = 0;
+   int last = node->count;
+   while(first < last)
+   {
+      int mid = (first + last) / 2;
+      if (node->keys[mid] < key)
+         first = mid + 1;
+      else
+         last = mid;
+   }
+   return first;
 }
 
 /**
- * Constructor for object index
+ * Find child of internal node which may contain given key. Returns -1 if key is less than any key in subtree.
  */
-AbstractIndexBase::AbstractIndexBase(Ownership owner) : m_writerLock(MutexType::FAST)
+static inline int FindChild(const INDEX_NODE *node, uint64_t key)
 {
-	m_primary = MemAllocStruct<INDEX_HEAD>();
-   m_secondary = MemAllocStruct<INDEX_HEAD>();
-	m_owner = static_cast<bool>(owner);
-	m_startupMode = false;
-	m_dirty = false;
-	m_objectDestructor = DefaultObjectDestructor;
+   int pos = LowerBound(node, key);
+   return ((pos < node->count) && (node->keys[pos] == key)) ? pos : pos - 1;
 }
 
 /**
- * Destructor
+ * Find element in tree
+ *
+ * @return true if element with given key exists
  */
-AbstractIndexBase::~AbstractIndexBase()
+static bool FindElement(const INDEX_NODE *node, uint64_t key, void **object)
 {
-   if (m_owner)
+   while(node != nullptr)
    {
-      for(size_t i = 0; i < m_primary->size; i++)
-         destroyObject(m_primary->elements[i].object);
+      if (node->leaf)
+      {
+         int pos = LowerBound(node, key);
+         if ((pos < node->count) && (node->keys[pos] == key))
+         {
+            *object = node->values[pos];
+            return true;
+         }
+         return false;
+      }
+
+      int pos = FindChild(node, key);
+      if (pos < 0)
+         return false;
+      node = node->child(pos);
    }
-	MemFree(m_primary->elements);
-   MemFree(m_primary);
-   MemFree(m_secondary->elements);
-   MemFree(m_secondary);
+   return false;
 }
 
 /**
- * Compare index elements - qsort callback
+ * Walk tree elements in key order. Callback should return false to stop walk.
+ *
+ * @return false if walk was stopped by callback
  */
-static int IndexCompare(const void *pArg1, const void *pArg2)
+template<typename C> static bool WalkTree(const INDEX_NODE *node, C& callback)
 {
-   return (((INDEX_ELEMENT *)pArg1)->key < ((INDEX_ELEMENT *)pArg2)->key) ? -1 :
-            ((((INDEX_ELEMENT *)pArg1)->key > ((INDEX_ELEMENT *)pArg2)->key) ? 1 : 0);
+   if (node->leaf)
+   {
+      for(int i = 0; i < node->count; i++)
+         if (!callback(node->keys[i], node->values[i]))
+            return false;
+      return true;
+   }
+
+   for(int i = 0; i < node->count; i++)
+      if (!WalkTree(node->child(i), callback))
+         return false;
+   return true;
 }
 
 /**
- * Set/clear startup mode
+ * Walk all elements in given index version
  */
-void AbstractIndexBase::setStartupMode(bool startupMode)
+template<typename C> static inline void ForEachElement(const INDEX_HEAD *index, C callback)
 {
-   if (m_startupMode == startupMode)
-      return;
+   if (index->root != nullptr)
+      WalkTree(index->root, callback);
+}
 
-   m_startupMode = startupMode;
-   if (!startupMode)
+/**
+ * Insert key and value into node at given position. Node must be writable and have free space.
+ */
+static inline void InsertIntoSlot(INDEX_NODE *node, int pos, uint64_t key, void *value)
+{
+   if (pos < node->count)
    {
-      if (m_primary->size > 0)
-      {
-         qsort(m_primary->elements, m_primary->size, sizeof(INDEX_ELEMENT), IndexCompare);
-         m_primary->maxKey = m_primary->elements[m_primary->size - 1].key;
-      }
-      else
-      {
-         m_primary->maxKey = 0;
-      }
+      memmove(&node->keys[pos + 1], &node->keys[pos], sizeof(uint64_t) * (node->count - pos));
+      memmove(&node->values[pos + 1], &node->values[pos], sizeof(void*) * (node->count - pos));
+   }
+   node->keys[pos] = key;
+   node->values[pos] = value;
+   node->count++;
+}
 
-      m_secondary->maxKey = m_primary->maxKey;
-      m_secondary->allocated = m_primary->allocated;
-      m_secondary->size = m_primary->size;
-      MemFree(m_secondary->elements);
-      if (m_secondary->allocated > 0)
-      {
-         m_secondary->elements = MemAllocArray<INDEX_ELEMENT>(m_secondary->allocated);
-         memcpy(m_secondary->elements, m_primary->elements, m_secondary->size * sizeof(INDEX_ELEMENT));
-      }
-      else
+/**
+ * Remove key and value at given position from writable node
+ */
+static inline void RemoveFromSlot(INDEX_NODE *node, int pos)
+{
+   node->count--;
+   if (pos < node->count)
+   {
+      memmove(&node->keys[pos], &node->keys[pos + 1], sizeof(uint64_t) * (node->count - pos));
+      memmove(&node->values[pos], &node->values[pos + 1], sizeof(void*) * (node->count - pos));
+   }
+}
+
+/**
+ * Free all nodes in tree
+ */
+static void FreeTree(INDEX_NODE *node)
+{
+   if (!node->leaf)
+   {
+      for(int i = 0; i < node->count; i++)
+         FreeTree(node->child(i));
+   }
+   MemFree(node);
+}
+
+/**
+ * Default object destructor
+ */
+static void DefaultObjectDestructor(void *object, AbstractIndexBase *index)
+{
+   MemFree(object);
+}
+
+/**
+ * Constructor for object index
+ */
+AbstractIndexBase::AbstractIndexBase(Ownership owner) : m_writerLock(MutexType::FAST)
+{
+   m_current = new INDEX_HEAD();
+   m_retiredHead = nullptr;
+   m_retiredTail = nullptr;
+   m_freeHeads = nullptr;
+   m_workRoot = nullptr;
+   m_workSize = 0;
+   m_writeVersion = 0;
+   m_owner = static_cast<bool>(owner);
+   m_startupMode = false;
+   m_objectDestructor = DefaultObjectDestructor;
+}
+
+/**
+ * Destructor
+ */
+AbstractIndexBase::~AbstractIndexBase()
+{
+   while(m_retiredHead != nullptr)
+   {
+      INDEX_HEAD *h = m_retiredHead;
+      m_retiredHead = h->next;
+      reclaimHead(h);
+      delete h;
+   }
+
+   while(m_freeHeads != nullptr)
+   {
+      INDEX_HEAD *h = m_freeHeads;
+      m_freeHeads = h->next;
+      delete h;
+   }
+
+   reclaimHead(m_current);
+   if (m_current->root != nullptr)
+   {
+      if (m_owner)
       {
-         m_secondary->elements = nullptr;
+         ForEachElement(m_current,
+            [this] (uint64_t key, void *object) -> bool
+            {
+               destroyObject(object);
+               return true;
+            });
       }
+      FreeTree(m_current->root);
    }
-   m_dirty = false;
+   delete m_current;
 }
 
 /**
- * Swap indexes and wait for new secondary copy to became writable
+ * Set/clear startup mode. In startup mode index is expected to be accessed by single thread only,
+ * so nodes are updated in place and replaced nodes and objects are destroyed immediately.
  */
-void AbstractIndexBase::swapAndWait()
+void AbstractIndexBase::setStartupMode(bool startupMode)
 {
-   m_secondary = InterlockedExchangeObjectPointer(&m_primary, m_secondary);
-   InterlockedIncrement(&m_secondary->writers);
-   while(m_secondary->readers > 0)
-      ThreadSleepMs(10);
+   m_writerLock.lock();
+   if (startupMode && !m_startupMode)
+      m_writeVersion++;   // Nodes created before entering startup mode should not be updated in place
+   m_startupMode = startupMode;
+   m_writerLock.unlock();
 }
 
 /**
- * Acquire index
+ * Acquire current index version for reading
  */
 INDEX_HEAD *AbstractIndexBase::acquireIndex() const
 {
    INDEX_HEAD *h;
    while(true)
    {
-      h = m_primary;
+      h = m_current;
       InterlockedIncrement(&h->readers);
-      if (h->writers == 0)
+      if (h == m_current)
          break;
+      // Version was superseded before reader registration, retry with new one
       InterlockedDecrement(&h->readers);
    }
    return h;
@@ -165,212 +304,516 @@ static inline void ReleaseIndex(INDEX_HEAD *h)
 }
 
 /**
- * Put element. If element with given key already exist, it will be replaced.
- *
- * @param key object's key
- * @param object object
- * @return true if existing object was replaced
+ * Start update of index tree. Acquires writer lock.
  */
-bool AbstractIndexBase::put(uint64_t key, void *object)
+void AbstractIndexBase::beginUpdate()
+{
+   m_writerLock.lock();
+   if (!m_startupMode)
+      m_writeVersion++;
+   m_workRoot = m_current->root;
+   m_workSize = m_current->size;
+}
+
+/**
+ * Publish updated index tree and release writer lock. Previous version is retired and will be reclaimed
+ * after all its readers leave (index heads are never freed while index exists, so late readers can
+ * safely detect that version they picked up was already superseded).
+ */
+void AbstractIndexBase::commitUpdate()
 {
    if (m_startupMode)
    {
-      if (m_primary->size == m_primary->allocated)
+      m_current->root = m_workRoot;
+      m_current->size = m_workSize;
+      m_current->version = m_writeVersion;
+      reclaim();
+      if (m_retiredHead == nullptr)
+         reclaimHead(m_current);
+   }
+   else if ((m_workRoot != m_current->root) || (m_workSize != m_current->size))
+   {
+      INDEX_HEAD *h;
+      if (m_freeHeads != nullptr)
+      {
+         h = m_freeHeads;
+         m_freeHeads = h->next;
+      }
+      else
       {
-         m_primary->allocated += 1024;
-         m_primary->elements = MemReallocArray<INDEX_ELEMENT>(m_primary->elements, m_primary->allocated);
+         h = new INDEX_HEAD();
       }
+      h->root = m_workRoot;
+      h->size = m_workSize;
+      h->version = m_writeVersion;
+      h->next = nullptr;
 
-      m_primary->elements[m_primary->size].key = key;
-      m_primary->elements[m_primary->size].object = object;
-      m_primary->size++;
-      m_dirty = true;
-      return false;
+      INDEX_HEAD *prev = InterlockedExchangeObjectPointer(&m_current, h);
+      if (m_retiredTail != nullptr)
+         m_retiredTail->next = prev;
+      else
+         m_retiredHead = prev;
+      m_retiredTail = prev;
+
+      reclaim();
+   }
+   m_workRoot = nullptr;
+   m_workSize = 0;
+   m_writerLock.unlock();
+}
+
+/**
+ * Check if any of given pinned versions (sorted in ascending order) is within given range
+ */
+static inline bool IsVersionRangePinned(const IntegerArray<uint64_t>& pinnedVersions, uint64_t from, uint64_t to)
+{
+   for(int i = 0; i < pinnedVersions.size(); i++)
+   {
+      uint64_t v = pinnedVersions.get(i);
+      if (v > to)
+         break;
+      if (v >= from)
+         return true;
    }
+   return false;
+}
 
-   bool replace = false;
-	void *oldObject = nullptr;
+/**
+ * Reclaim nodes and objects retired by superseded versions. Node retired by given version is reachable
+ * only from versions published between node creation and its retirement, so it is destroyed as soon as
+ * none of these versions has active readers. This way long running reader only holds nodes of the version
+ * it is reading, and not everything retired after it. Objects do not have creation version and are
+ * destroyed only when no older or same version has active readers. Writer lock must be held.
+ */
+void AbstractIndexBase::reclaim()
+{
+   if (m_retiredHead == nullptr)
+      return;
 
-   m_writerLock.lock();
+   // Retired list is ordered by version, so pinned versions are collected in ascending order
+   IntegerArray<uint64_t> pinnedVersions(0, 16);
+   for(INDEX_HEAD *h = m_retiredHead; h != nullptr; h = h->next)
+   {
+      if (h->readers > 0)
+         pinnedVersions.add(h->version);
+   }
 
-	ssize_t pos = findElement(m_secondary, key);
-	if (pos != -1)
-	{
-		// Element already exist
-      oldObject = m_secondary->elements[pos].object;
-      m_secondary->elements[pos].object = object;
-		replace = true;
-	}
-	else
-	{
-		if (m_secondary->size == m_secondary->allocated)
-		{
-		   m_secondary->allocated += 1024;
-		   m_secondary->elements = MemReallocArray<INDEX_ELEMENT>(m_secondary->elements, m_secondary->allocated);
-		}
-
-		m_secondary->elements[m_secondary->size].key = key;
-		m_secondary->elements[m_secondary->size].object = object;
-		m_secondary->size++;
-		if (key < m_secondary->maxKey)
-		{
-		   qsort(m_secondary->elements, m_secondary->size, sizeof(INDEX_ELEMENT), IndexCompare);
-		}
-		else
-		{
-		   m_secondary->maxKey = key;
-		}
-	}
-
-	swapAndWait();
-
-	if (replace)
-	{
-      m_secondary->elements[pos].object = object;
-	   if (m_owner)
-	      destroyObject(oldObject);
-	}
-	else
-	{
-	   if (m_primary->allocated > m_secondary->allocated)
-	   {
-	      m_secondary->allocated = m_primary->allocated;
-         m_secondary->elements = MemReallocArray<INDEX_ELEMENT>(m_secondary->elements, m_secondary->allocated);
-	   }
-	   m_secondary->size = m_primary->size;
-      if (key < m_secondary->maxKey)
+   if (pinnedVersions.isEmpty())
+   {
+      while(m_retiredHead != nullptr)
       {
-         memcpy(m_secondary->elements, m_primary->elements, m_secondary->size * sizeof(INDEX_ELEMENT));
+         INDEX_HEAD *h = m_retiredHead;
+         m_retiredHead = h->next;
+         releaseHead(h);
+      }
+      m_retiredTail = nullptr;
+      return;
+   }
+
+   INDEX_HEAD *prev = nullptr;
+   INDEX_HEAD *h = m_retiredHead;
+   while(h != nullptr)
+   {
+      INDEX_NODE **nextPtr = &h->retiredNodes;
+      while(*nextPtr != nullptr)
+      {
+         INDEX_NODE *n = *nextPtr;
+         if (IsVersionRangePinned(pinnedVersions, n->version, h->version))
+         {
+            nextPtr = &n->nextRetired;
+         }
+         else
+         {
+            *nextPtr = n->nextRetired;
+            MemFree(n);
+         }
+      }
+
+      if (!h->retiredObjects.isEmpty() && !IsVersionRangePinned(pinnedVersions, 0, h->version))
+      {
+         for(int i = 0; i < h->retiredObjects.size(); i++)
+            destroyObject(h->retiredObjects.get(i));
+         h->retiredObjects.clear();
+      }
+
+      INDEX_HEAD *next = h->next;
+      if ((h->readers == 0) && (h->retiredNodes == nullptr) && h->retiredObjects.isEmpty())
+      {
+         if (prev != nullptr)
+            prev->next = next;
+         else
+            m_retiredHead = next;
+         if (m_retiredTail == h)
+            m_retiredTail = prev;
+         releaseHead(h);
       }
       else
       {
-         m_secondary->maxKey = key;
-         m_secondary->elements[m_secondary->size - 1].key = key;
-         m_secondary->elements[m_secondary->size - 1].object = object;
+         prev = h;
       }
-	}
+      h = next;
+   }
+}
 
-   InterlockedDecrement(&m_secondary->writers);
+/**
+ * Destroy nodes and objects retired by given version and put index head into free list
+ */
+void AbstractIndexBase::releaseHead(INDEX_HEAD *head)
+{
+   reclaimHead(head);
+   head->root = nullptr;
+   head->size = 0;
+   head->version = 0;
+   head->next = m_freeHeads;
+   m_freeHeads = head;
+}
 
-   m_writerLock.unlock();
-	return replace;
+/**
+ * Destroy nodes and objects retired by given version
+ */
+void AbstractIndexBase::reclaimHead(INDEX_HEAD *head)
+{
+   while(head->retiredNodes != nullptr)
+   {
+      INDEX_NODE *n = head->retiredNodes;
+      head->retiredNodes = n->nextRetired;
+      MemFree(n);
+   }
+   for(int i = 0; i < head->retiredObjects.size(); i++)
+      destroyObject(head->retiredObjects.get(i));
+   head->retiredObjects.clear();
 }
 
 /**
- * Remove object from index
+ * Create new node for current write version
+ */
+INDEX_NODE *AbstractIndexBase::createNode(bool leaf)
+{
+   INDEX_NODE *node = static_cast<INDEX_NODE*>(MemAlloc(sizeof(INDEX_NODE)));
+   node->version = m_writeVersion;
+   node->nextRetired = nullptr;
+   node->count = 0;
+   node->leaf = leaf;
+   return node;
+}
+
+/**
+ * Get writable version of given node. Node from previous version is copied and retired.
+ */
+INDEX_NODE *AbstractIndexBase::makeWritable(INDEX_NODE *node)
+{
+   if (node->version == m_writeVersion)
+      return node;
+
+   INDEX_NODE *copy = static_cast<INDEX_NODE*>(MemAlloc(sizeof(INDEX_NODE)));
+   copy->nextRetired = nullptr;
+   copy->version = m_writeVersion;
+   copy->leaf = node->leaf;
+   copy->count = node->count;
+   memcpy(copy->keys, node->keys, sizeof(uint64_t) * node->count);
+   memcpy(copy->values, node->values, sizeof(void*) * node->count);
+   retireNode(node);
+   return copy;
+}
+
+/**
+ * Retire node removed from tree. Nodes not yet visible to readers are destroyed immediately.
+ */
+void AbstractIndexBase::retireNode(INDEX_NODE *node)
+{
+   if (node->version == m_writeVersion)
+   {
+      MemFree(node);
+   }
+   else
+   {
+      node->nextRetired = m_current->retiredNodes;
+      m_current->retiredNodes = node;
+   }
+}
+
+/**
+ * Retire object removed from index (destroyed only if index owns objects)
+ */
+void AbstractIndexBase::retireObject(void *object)
+{
+   if (m_owner && (object != nullptr))
+      m_current->retiredObjects.add(object);
+}
+
+/**
+ * Retire all nodes and objects in given subtree
+ */
+void AbstractIndexBase::retireTree(INDEX_NODE *node)
+{
+   for(int i = 0; i < node->count; i++)
+   {
+      if (node->leaf)
+         retireObject(node->values[i]);
+      else
+         retireTree(node->child(i));
+   }
+   retireNode(node);
+}
+
+/**
+ * Insert element into subtree. If node has to be split, new right sibling is returned via "sibling".
  *
- * @param key object's key
+ * @return writable version of given node
  */
-void AbstractIndexBase::remove(uint64_t key)
+INDEX_NODE *AbstractIndexBase::insertIntoNode(INDEX_NODE *node, uint64_t key, void *object, INDEX_NODE **sibling, bool *replaced)
 {
-   if (m_startupMode)
+   node = makeWritable(node);
+   *sibling = nullptr;
+
+   int pos;
+   void *value;
+   if (node->leaf)
    {
-      if (m_dirty)
+      pos = LowerBound(node, key);
+      if ((pos < node->count) && (node->keys[pos] == key))
       {
-         qsort(m_primary->elements, m_primary->size, sizeof(INDEX_ELEMENT), IndexCompare);
-         m_primary->maxKey = (m_primary->size > 0) ? m_primary->elements[m_primary->size - 1].key : 0;
-         m_dirty = false;
+         retireObject(node->values[pos]);
+         node->values[pos] = object;
+         *replaced = true;
+         return node;
       }
-      ssize_t pos = findElement(m_primary, key);
-      if (pos != -1)
+      value = object;
+   }
+   else
+   {
+      int cpos = FindChild(node, key);
+      if (cpos < 0)
       {
-         if (m_owner)
-            destroyObject(m_primary->elements[pos].object);
-         m_primary->size--;
-         memmove(&m_primary->elements[pos], &m_primary->elements[pos + 1], sizeof(INDEX_ELEMENT) * (m_primary->size - pos));
+         cpos = 0;
+         node->keys[0] = key;
       }
-      return;
-   }
 
-   m_writerLock.lock();
-
-	ssize_t pos = findElement(m_secondary, key);
-	if (pos != -1)
-	{
-      m_secondary->size--;
-      memmove(&m_secondary->elements[pos], &m_secondary->elements[pos + 1], sizeof(INDEX_ELEMENT) * (m_secondary->size - pos));
-      if (m_secondary->maxKey == key)
-         m_secondary->maxKey = (m_secondary->size > 0) ? m_secondary->elements[m_secondary->size - 1].key : 0;
-
-      swapAndWait();
+      INDEX_NODE *childSibling;
+      node->values[cpos] = insertIntoNode(node->child(cpos), key, object, &childSibling, replaced);
+      if (childSibling == nullptr)
+         return node;
 
-      if (m_owner)
-         destroyObject(m_secondary->elements[pos].object);
-      m_secondary->size--;
-      memmove(&m_secondary->elements[pos], &m_secondary->elements[pos + 1], sizeof(INDEX_ELEMENT) * (m_secondary->size - pos));
-      if (m_secondary->maxKey == key)
-         m_secondary->maxKey = (m_secondary->size > 0) ? m_secondary->elements[m_secondary->size - 1].key : 0;
+      pos = cpos + 1;
+      key = childSibling->keys[0];
+      value = childSibling;
+   }
 
-      InterlockedDecrement(&m_secondary->writers);
+   if (node->count < INDEX_NODE_CAPACITY)
+   {
+      InsertIntoSlot(node, pos, key, value);
+      return node;
    }
 
-   m_writerLock.unlock();
+   // Split full node. When appending to the end (typical for sequentially allocated identifiers)
+   // left node is kept full to avoid half-empty nodes.
+   INDEX_NODE *right = createNode(node->leaf);
+   bool append = (pos == node->count);
+   int splitPoint = append ? node->count : node->count / 2;
+   right->count = node->count - splitPoint;
+   memcpy(right->keys, &node->keys[splitPoint], sizeof(uint64_t) * right->count);
+   memcpy(right->values, &node->values[splitPoint], sizeof(void*) * right->count);
+   node->count = splitPoint;
+   if (append || (pos > splitPoint))
+      InsertIntoSlot(right, pos - splitPoint, key, value);
+   else
+      InsertIntoSlot(node, pos, key, value);
+   *sibling = right;
+   return node;
 }
 
 /**
- * Clear index
+ * Remove element from subtree. Element with given key must exist in subtree.
+ *
+ * @return writable version of given node
  */
-void AbstractIndexBase::clear()
+INDEX_NODE *AbstractIndexBase::removeFromNode(INDEX_NODE *node, uint64_t key)
 {
-   m_writerLock.lock();
+   node = makeWritable(node);
 
-   m_secondary->size = 0;
-   m_secondary->allocated = 0;
-   m_secondary->maxKey = 0;
-   MemFreeAndNull(m_secondary->elements);
+   if (node->leaf)
+   {
+      int pos = LowerBound(node, key);
+      retireObject(node->values[pos]);
+      RemoveFromSlot(node, pos);
+      return node;
+   }
 
-   swapAndWait();
+   int pos = FindChild(node, key);
+   INDEX_NODE *child = removeFromNode(node->child(pos), key);
+   node->values[pos] = child;
+   if (child->count == 0)
+   {
+      retireNode(child);
+      RemoveFromSlot(node, pos);
+   }
+   else if (child->count < INDEX_NODE_MIN_FILL)
+   {
+      int left = (pos > 0) ? pos - 1 : pos;
+      int right = left + 1;
+      if ((right < node->count) && (node->child(left)->count + node->child(right)->count <= INDEX_NODE_CAPACITY))
+      {
+         INDEX_NODE *l = makeWritable(node->child(left));
+         INDEX_NODE *r = node->child(right);
+         memcpy(&l->keys[l->count], r->keys, sizeof(uint64_t) * r->count);
+         memcpy(&l->values[l->count], r->values, sizeof(void*) * r->count);
+         l->count += r->count;
+         node->values[left] = l;
+         retireNode(r);
+         RemoveFromSlot(node, right);
+      }
+   }
+   return node;
+}
 
-   if (m_owner)
+/**
+ * Insert element into working tree. Writer lock must be held.
+ *
+ * @return true if existing element was replaced
+ */
+bool AbstractIndexBase::insertElement(uint64_t key, void *object)
+{
+   if (m_workRoot == nullptr)
    {
-      for(size_t i = 0; i < m_secondary->size; i++)
-         destroyObject(m_secondary->elements[i].object);
+      m_workRoot = createNode(true);
+      InsertIntoSlot(m_workRoot, 0, key, object);
+      m_workSize = 1;
+      return false;
    }
 
-   m_secondary->size = 0;
-   m_secondary->allocated = 0;
-   m_secondary->maxKey = 0;
-   MemFreeAndNull(m_secondary->elements);
+   bool replaced = false;
+   INDEX_NODE *sibling;
+   m_workRoot = insertIntoNode(m_workRoot, key, object, &sibling, &replaced);
+   if (sibling != nullptr)
+   {
+      INDEX_NODE *root = createNode(false);
+      InsertIntoSlot(root, 0, m_workRoot->keys[0], m_workRoot);
+      InsertIntoSlot(root, 1, sibling->keys[0], sibling);
+      m_workRoot = root;
+   }
+   if (!replaced)
+      m_workSize++;
+   return replaced;
+}
 
-   InterlockedDecrement(&m_secondary->writers);
+/**
+ * Remove element from working tree. Writer lock must be held.
+ */
+void AbstractIndexBase::removeElement(uint64_t key)
+{
+   void *object;
+   if (!FindElement(m_workRoot, key, &object))
+      return;
 
-   m_writerLock.unlock();
+   m_workRoot = removeFromNode(m_workRoot, key);
+   m_workSize--;
+   if (m_workRoot->count == 0)
+   {
+      retireNode(m_workRoot);
+      m_workRoot = nullptr;
+   }
+   else
+   {
+      while(!m_workRoot->leaf && (m_workRoot->count == 1))
+      {
+         INDEX_NODE *child = m_workRoot->child(0);
+         retireNode(m_workRoot);
+         m_workRoot = child;
+      }
+   }
 }
 
 /**
- * Find element in index
+ * Put element. If element with given key already exist, it will be replaced.
  *
  * @param key object's key
- * @return element index or -1 if not found
+ * @param object object
+ * @return true if existing object was replaced
  */
-ssize_t AbstractIndexBase::findElement(INDEX_HEAD *index, uint64_t key)
+bool AbstractIndexBase::put(uint64_t key, void *object)
 {
-   size_t first, last, mid;
+   beginUpdate();
+   bool replaced = insertElement(key, object);
+   commitUpdate();
+   return replaced;
+}
 
-	if (index->size == 0)
-      return -1;
+/**
+ * Put multiple elements as single update. Existing elements with same keys will be replaced.
+ *
+ * @param keys object keys
+ * @param objects objects
+ * @param count number of elements
+ * @return number of replaced elements
+ */
+size_t AbstractIndexBase::putAll(const uint64_t *keys, void * const *objects, size_t count)
+{
+   size_t replaced = 0;
+   beginUpdate();
+   for(size_t i = 0; i < count; i++)
+   {
+      if (insertElement(keys[i], objects[i]))
+         replaced++;
+   }
+   commitUpdate();
+   return replaced;
+}
 
-   first = 0;
-   last = index->size - 1;
+/**
+ * Remove object from index
+ *
+ * @param key object's key
+ */
+void AbstractIndexBase::remove(uint64_t key)
+{
+   beginUpdate();
+   removeElement(key);
+   commitUpdate();
+}
 
-   if ((key < index->elements[0].key) || (key > index->elements[last].key))
-      return -1;
+/**
+ * Remove multiple objects from index as single update
+ *
+ * @param keys object keys
+ * @param count number of keys
+ */
+void AbstractIndexBase::removeAll(const uint64_t *keys, size_t count)
+{
+   beginUpdate();
+   for(size_t i = 0; i < count; i++)
+      removeElement(keys[i]);
+   commitUpdate();
+}
 
-   while(first < last)
+/**
+ * Clear index
+ */
+void AbstractIndexBase::clear()
+{
+   beginUpdate();
+   if (m_workRoot != nullptr)
    {
-      mid = (first + last) / 2;
-      if (key == index->elements[mid].key)
-         return mid;
-      if (key < index->elements[mid].key)
-         last = mid - 1;
-      else
-         first = mid + 1;
+      retireTree(m_workRoot);
+      m_workRoot = nullptr;
+      m_workSize = 0;
    }
+   commitUpdate();
+}
 
-   if (key == index->elements[last].key)
-      return last;
-
-   return -1;
+/**
+ * Get number of retired index tree nodes not yet destroyed because of active readers
+ */
+size_t AbstractIndexBase::getRetiredNodeCount() const
+{
+   size_t count = 0;
+   m_writerLock.lock();
+   for(INDEX_HEAD *h = m_retiredHead; h != nullptr; h = h->next)
+   {
+      for(INDEX_NODE *n = h->retiredNodes; n != nullptr; n = n->nextRetired)
+         count++;
+   }
+   m_writerLock.unlock();
+   return count;
 }
 
 /**
@@ -381,17 +824,12 @@ ssize_t AbstractIndexBase::findElement(INDEX_HEAD *index, uint64_t key)
  */
 void *AbstractIndexBase::get(uint64_t key) const
 {
-   if (m_startupMode && m_dirty)
-   {
-      qsort(m_primary->elements, m_primary->size, sizeof(INDEX_ELEMENT), IndexCompare);
-      m_primary->maxKey = (m_primary->size > 0) ? m_primary->elements[m_primary->size - 1].key : 0;
-      const_cast<AbstractIndexBase*>(this)->m_dirty = false;   // This is internal marker, changing it does not break const contract
-   }
    INDEX_HEAD *index = acquireIndex();
-	ssize_t pos = findElement(index, key);
-	void *object = (pos == -1) ? nullptr : index->elements[pos].object;
+   void *object;
+   if (!FindElement(index->root, key, &object))
+      object = nullptr;
    ReleaseIndex(index);
-	return object;
+   return object;
 }
 
 /**
@@ -400,9 +838,13 @@ void *AbstractIndexBase::get(uint64_t key) const
 IntegerArray<uint64_t> AbstractIndexBase::keys() const
 {
    INDEX_HEAD *index = acquireIndex();
-   IntegerArray<uint64_t> result(index->size);
-   for(size_t i = 0; i < index->size; i++)
-      result.add(index->elements[i].key);
+   IntegerArray<uint64_t> result(static_cast<int>(index->size));
+   ForEachElement(index,
+      [&result] (uint64_t key, void *object) -> bool
+      {
+         result.add(key);
+         return true;
+      });
    ReleaseIndex(index);
    return result;
 }
@@ -413,9 +855,9 @@ IntegerArray<uint64_t> AbstractIndexBase::keys() const
 size_t AbstractIndexBase::size() const
 {
    INDEX_HEAD *index = acquireIndex();
-	size_t s = index->size;
+   size_t s = index->size;
    ReleaseIndex(index);
-	return s;
+   return s;
 }
 
 /**
@@ -426,18 +868,20 @@ size_t AbstractIndexBase::size() const
  */
 void *AbstractIndexBase::find(bool (*comparator)(void *, void *), void *data) const
 {
-	void *result = nullptr;
+   void *result = nullptr;
 
    INDEX_HEAD *index = acquireIndex();
-	for(size_t i = 0; i < index->size; i++)
-		if (comparator(index->elements[i].object, data))
-		{
-			result = index->elements[i].object;
-			break;
-		}
+   ForEachElement(index,
+      [comparator, data, &result] (uint64_t key, void *object) -> bool
+      {
+         if (!comparator(object, data))
+            return true;
+         result = object;
+         return false;
+      });
    ReleaseIndex(index);
 
-	return result;
+   return result;
 }
 
 /**
@@ -450,12 +894,14 @@ void *AbstractIndexBase::find(std::function<bool (void*)> comparator) const
    void *result = nullptr;
 
    INDEX_HEAD *index = acquireIndex();
-   for(size_t i = 0; i < index->size; i++)
-      if (comparator(index->elements[i].object))
+   ForEachElement(index,
+      [&comparator, &result] (uint64_t key, void *object) -> bool
       {
-         result = index->elements[i].object;
-         break;
-      }
+         if (!comparator(object))
+            return true;
+         result = object;
+         return false;
+      });
    ReleaseIndex(index);
 
    return result;
@@ -470,11 +916,13 @@ void *AbstractIndexBase::find(std::function<bool (void*)> comparator) const
 void AbstractIndexBase::findAll(Array *resultSet, bool (*comparator)(void *, void *), void *data) const
 {
    INDEX_HEAD *index = acquireIndex();
-   for(size_t i = 0; i < index->size; i++)
-   {
-      if (comparator(index->elements[i].object, data))
-         resultSet->add(index->elements[i].object);
-   }
+   ForEachElement(index,
+      [resultSet, comparator, data] (uint64_t key, void *object) -> bool
+      {
+         if (comparator(object, data))
+            resultSet->add(object);
+         return true;
+      });
    ReleaseIndex(index);
 }
 
@@ -486,11 +934,13 @@ void AbstractIndexBase::findAll(Array *resultSet, bool (*comparator)(void *, voi
 void AbstractIndexBase::findAll(Array *resultSet, std::function<bool (void*)> comparator) const
 {
    INDEX_HEAD *index = acquireIndex();
-   for(size_t i = 0; i < index->size; i++)
-   {
-      if (comparator(index->elements[i].object))
-         resultSet->add(index->elements[i].object);
-   }
+   ForEachElement(index,
+      [resultSet, &comparator] (uint64_t key, void *object) -> bool
+      {
+         if (comparator(object))
+            resultSet->add(object);
+         return true;
+      });
    ReleaseIndex(index);
 }
 
@@ -503,9 +953,11 @@ void AbstractIndexBase::findAll(Array *resultSet, std::function<bool (void*)> co
 void AbstractIndexBase::forEach(EnumerationCallbackResult (*callback)(void*, void*), void *data) const
 {
    INDEX_HEAD *index = acquireIndex();
-	for(size_t i = 0; i < index->size; i++)
-		if (callback(index->elements[i].object, data) != _CONTINUE)
-		   break;
+   ForEachElement(index,
+      [callback, data] (uint64_t key, void *object) -> bool
+      {
+         return callback(object, data) == _CONTINUE;
+      });
    ReleaseIndex(index);
 }
 
@@ -517,9 +969,11 @@ void AbstractIndexBase::forEach(EnumerationCallbackResult (*callback)(void*, voi
 void AbstractIndexBase::forEach(std::function<EnumerationCallbackResult (void*)> callback) const
 {
    INDEX_HEAD *index = acquireIndex();
-   for(size_t i = 0; i < index->size; i++)
-      if (callback(index->elements[i].object) != _CONTINUE)
-         break;
+   ForEachElement(index,
+      [&callback] (uint64_t key, void *object) -> bool
+      {
+         return callback(object) == _CONTINUE;
+      });
    ReleaseIndex(index);
 }
 
@@ -532,13 +986,13 @@ unique_ptr<SharedObjectArray<NetObj>> ObjectIndex::getObjects(bool (*filter)(Net
 {
    INDEX_HEAD *index = acquireIndex();
    auto result = make_unique<SharedObjectArray<NetObj>>(index->size);
-   for(size_t i = 0; i < index->size; i++)
-   {
-      if ((filter == nullptr) || filter(static_cast<shared_ptr<NetObj>*>(index->elements[i].object)->get(), context))
+   ForEachElement(index,
+      [&result, filter, context] (uint64_t key, void *object) -> bool
       {
-         result->add(*static_cast<shared_ptr<NetObj>*>(index->elements[i].object));
-      }
-   }
+         if ((filter == nullptr) || filter(static_cast<shared_ptr<NetObj>*>(object)->get(), context))
+            result->add(*static_cast<shared_ptr<NetObj>*>(object));
+         return true;
+      });
    ReleaseIndex(index);
    return result;
 }
@@ -552,13 +1006,13 @@ unique_ptr<SharedObjectArray<NetObj>> ObjectIndex::getObjects(std::function<bool
 {
    INDEX_HEAD *index = acquireIndex();
    auto result = make_unique<SharedObjectArray<NetObj>>(index->size);
-   for(size_t i = 0; i < index->size; i++)
-   {
-      if (filter(static_cast<shared_ptr<NetObj>*>(index->elements[i].object)->get()))
+   ForEachElement(index,
+      [&result, &filter] (uint64_t key, void *object) -> bool
       {
-         result->add(*static_cast<shared_ptr<NetObj>*>(index->elements[i].object));
-      }
-   }
+         if (filter(static_cast<shared_ptr<NetObj>*>(object)->get()))
+            result->add(*static_cast<shared_ptr<NetObj>*>(object));
+         return true;
+      });
    ReleaseIndex(index);
    return result;
 }
@@ -569,13 +1023,13 @@ unique_ptr<SharedObjectArray<NetObj>> ObjectIndex::getObjects(std::function<bool
 void ObjectIndex::getObjects(SharedObjectArray<NetObj> *destination, bool (*filter)(NetObj *, void *), void *context)
 {
    INDEX_HEAD *index = acquireIndex();
-   for(size_t i = 0; i < index->size; i++)
-   {
-      if ((filter == nullptr) || filter(static_cast<shared_ptr<NetObj>*>(index->elements[i].object)->get(), context))
+   ForEachElement(index,
+      [destination, filter, context] (uint64_t key, void *object) -> bool
       {
-         destination->add(*static_cast<shared_ptr<NetObj>*>(index->elements[i].object));
-      }
-   }
+         if ((filter == nullptr) || filter(static_cast<shared_ptr<NetObj>*>(object)->get(), context))
+            destination->add(*static_cast<shared_ptr<NetObj>*>(object));
+         return true;
+      });
    ReleaseIndex(index);
 }
 
@@ -585,12 +1039,12 @@ void ObjectIndex::getObjects(SharedObjectArray<NetObj> *destination, bool (*filt
 void ObjectIndex::getObjects(SharedObjectArray<NetObj> *destination, std::function<bool (NetObj*)> filter)
 {
    INDEX_HEAD *index = acquireIndex();
-   for(size_t i = 0; i < index->size; i++)
-   {
-      if (filter(static_cast<shared_ptr<NetObj>*>(index->elements[i].object)->get()))
+   ForEachElement(index,
+      [destination, &filter] (uint64_t key, void *object) -> bool
       {
-         destination->add(*static_cast<shared_ptr<NetObj>*>(index->elements[i].object));
-      }
-   }
+         if (filter(static_cast<shared_ptr<NetObj>*>(object)->get()))
+            destination->add(*static_cast<shared_ptr<NetObj>*>(object));
+         return true;
+      });
    ReleaseIndex(index);
 }
@@ -306,7 +306,7 @@ static shared_ptr<Interface> FindRemoteInterface(Node *node, uint32_t idSubType,
 			   NetworkDeviceDriver *driver = node->getDriver();
 			   if (driver != nullptr)
 			   {
-			      SNMP_Transport *snmp = node->createSnmpTransport();
+			      SNMP_Transport *snmp = node->acquireSnmpTransport();
 			      InterfaceId iid;
 			      NodeDeviceContext context(node->self(), snmp);
 			      if ((snmp != nullptr) && driver->lldpNameToInterfaceId(&context, node, node->getDriverData(), ifName, &iid))
@@ -327,7 +327,7 @@ static shared_ptr<Interface> FindRemoteInterface(Node *node, uint32_t idSubType,
                         break;
 			         }
 			      }
-			      delete snmp;
+			      node->releaseSnmpTransport(snmp);
 			   }
 	         if (ifc == nullptr)
 			   {
@@ -360,7 +360,7 @@ static StringObjectMap<SNMP_Variable> *ReadLLDPRemoteTable(Node *node, bool lldp
    // Entire table should be cached before processing because some devices (D-Link for example)
    // do not allow GET requests for table elements
    StringObjectMap<SNMP_Variable> *connections = nullptr;
-   SNMP_Transport *snmp = node->createSnmpTransport();
+   SNMP_Transport *snmp = node->acquireSnmpTransport();
    if (snmp != nullptr)
    {
       connections = new StringObjectMap<SNMP_Variable>(Ownership::True);
@@ -381,7 +381,7 @@ static StringObjectMap<SNMP_Variable> *ReadLLDPRemoteTable(Node *node, bool lldp
          nxlog_debug_tag(DEBUG_TAG_TOPO_LLDP, 5, _T("%s connection database empty for node %s [%u]"), LLDP_MIB_NAME(lldpMibV2), node->getName(), node->getId());
          delete_and_null(connections);
       }
-      delete snmp;
+      node->releaseSnmpTransport(snmp);
    }
    else
    {
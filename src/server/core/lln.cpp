@@ -62,7 +62,7 @@ static bool AddDriverNeighbors(Node *node, LinkLayerNeighbors *nbs)
    if (!node->isSNMPSupported())
       return true;
 
-   SNMP_Transport *snmp = node->createSnmpTransport();
+   SNMP_Transport *snmp = node->acquireSnmpTransport();
    if (snmp == nullptr)
       return true;
 
@@ -139,7 +139,7 @@ static bool AddDriverNeighbors(Node *node, LinkLayerNeighbors *nbs)
    {
       nxlog_debug_tag(DEBUG_TAG_TOPO_DRIVER, 5, _T("Driver for node %s [%u] cannot provide link layer topology information"), node->getName(), node->getId());
    }
-   delete snmp;
+   node->releaseSnmpTransport(snmp);
    return !ignoreStandardMibs;
 }
 
@@ -23,6 +23,11 @@
 #include "nxcore.h"
 #include <nxcore_logs.h>
 
+/**
+ * Number of records covered by query SQL returned to client
+ */
+#define DEFAULT_ROW_COUNT_LIMIT  1000
+
 /**
  * Check if given column should be read for "get detains" request only
  */
@@ -78,13 +83,13 @@ static void AppendQueryColumn(StringBuffer *columnList, const LOG_COLUMN& column
 /**
  * Constructor
  */
-LogHandle::LogHandle(const NXCORE_LOG *info)
+LogHandle::LogHandle(const NXCORE_LOG *info) : m_keyset(0, 8), m_cursorKey(0, 8)
 {
 	m_log = info;
 	m_filter = nullptr;
-	m_resultSet = nullptr;
-	m_rowCountLimit = 1000;
 	m_maxRecordId = 0;
+	m_cursorRow = 0;
+	m_endOfData = false;
 }
 
 /**
@@ -92,7 +97,6 @@ LogHandle::LogHandle(const NXCORE_LOG *info)
  */
 LogHandle::~LogHandle()
 {
-	deleteQueryResults();
 	delete m_filter;
 }
 
@@ -136,15 +140,13 @@ const LOG_COLUMN *LogHandle::getColumnDefinition(const TCHAR *name) const
 }
 
 /**
- * Delete query results
+ * Reset read position to the beginning of query result
  */
-void LogHandle::deleteQueryResults()
+void LogHandle::resetCursor()
 {
-	if (m_resultSet != nullptr)
-	{
-		DBFreeResult(m_resultSet);
-		m_resultSet = nullptr;
-	}
+   m_cursorKey.clear();
+   m_cursorRow = 0;
+   m_endOfData = false;
 }
 
 /**
@@ -177,15 +179,19 @@ void LogHandle::buildQueryColumnList()
 }
 
 /**
- * Do query according to filter
+ * Do query according to filter. Full query is executed only when client requests data, so
+ * here only first matching record is selected to validate the query. On success row count is
+ * set to estimated number of matching records (or -1 if estimate is not available).
  */
 bool LogHandle::query(LogFilter *filter, int64_t *rowCount, uint32_t userId)
 {
-	deleteQueryResults();
 	delete m_filter;
 	m_filter = filter;
+	resetCursor();
 
 	buildQueryColumnList();
+	if (!buildKeyset(m_filter, &m_keyset))
+	   m_keyset.clear();
 
 	m_maxRecordId = -1;
 	TCHAR query[256];
@@ -198,11 +204,27 @@ bool LogHandle::query(LogFilter *filter, int64_t *rowCount, uint32_t userId)
 			m_maxRecordId = DBGetFieldInt64(hResult, 0, 0);
 		DBFreeResult(hResult);
 	}
-	DBConnectionPoolReleaseConnection(hdb);
 	if (m_maxRecordId < 0)
+	{
+		DBConnectionPoolReleaseConnection(hdb);
+		return false;
+	}
+
+	// Probe query so that invalid filter is reported on query request and not on first data request
+	StringBuffer probe = buildQuerySql(m_filter, m_maxRecordId, userId, m_keyset, nullptr, 1);
+	hResult = DBSelect(hdb, probe);
+	DBConnectionPoolReleaseConnection(hdb);
+	if (hResult == nullptr)
+	{
+		nxlog_debug_tag(DEBUG_TAG_LOGS, 4, _T("Log query probe failed for %s (%s)"), m_log->name, probe.cstr());
 		return false;
+	}
+	DBFreeResult(hResult);
 
-	return queryInternal(rowCount, userId);
+	*rowCount = estimateRowCount(m_filter, userId);
+	nxlog_debug_tag(DEBUG_TAG_LOGS, 4, _T("Log query prepared for %s (maxRecordId=") INT64_FMT _T(", keyset=%s, estimatedRows=") INT64_FMT _T(")"),
+	         m_log->name, m_maxRecordId, BooleanToString(!m_keyset.isEmpty()), *rowCount);
+	return true;
 }
 
 /**
@@ -283,6 +305,108 @@ StringBuffer LogHandle::buildObjectAccessConstraint(uint32_t userId)
 	return constraint;
 }
 
+/**
+ * Find column with given name in query result. Returns column index or -1 if column is not
+ * part of query result.
+ */
+static int FindQueryColumn(const NXCORE_LOG *log, const wchar_t *name, const LOG_COLUMN **definition)
+{
+   int index = 0;
+   for(int i = 0; log->columns[i].name != nullptr; i++)
+   {
+      if (IsIgnoredColumn(log->columns[i].type))
+         continue;
+      if (!wcsicmp(log->columns[i].name, name))
+      {
+         *definition = &log->columns[i];
+         return index;
+      }
+      index++;
+   }
+   return -1;
+}
+
+/**
+ * Build key for keyset pagination from filter's ordering columns, with record ID appended
+ * as tie breaker. Only timestamp and record ID columns are accepted as they are always set
+ * and compared as numbers. Returns false if ordering does not allow keyset pagination.
+ */
+bool LogHandle::buildKeyset(LogFilter *filter, StructArray<KeysetColumn> *keyset)
+{
+   keyset->clear();
+   int count = filter->getNumOrderingColumns();
+   if (count == 0)
+      return false;  // No defined order, records are returned in database's natural order
+
+   bool hasRecordId = false;
+   for(int i = 0; (i < count) && !hasRecordId; i++)
+   {
+      const OrderingColumn *oc = filter->getOrderingColumn(i);
+      KeysetColumn *k = keyset->addPlaceholder();
+      k->index = FindQueryColumn(m_log, oc->name, &k->definition);
+      if (k->index == -1)
+         return false;
+      hasRecordId = !wcsicmp(k->definition->name, m_log->idColumn);
+      if (!hasRecordId && (k->definition->type != LC_TIMESTAMP) && (k->definition->type != LC_TIMESTAMP_MS))
+         return false;
+      k->descending = oc->descending;
+   }
+
+   if (!hasRecordId)
+   {
+      KeysetColumn *k = keyset->addPlaceholder();
+      k->index = FindQueryColumn(m_log, m_log->idColumn, &k->definition);
+      if (k->index == -1)
+         return false;
+      k->descending = filter->getOrderingColumn(count - 1)->descending;
+   }
+   return true;
+}
+
+/**
+ * Append key value to SQL query, converting it for TimescaleDB timestamptz columns
+ */
+static void AppendKeyValue(StringBuffer *sql, const LOG_COLUMN *column, int64_t value)
+{
+   if ((column->flags & LCF_TSDB_TIMESTAMPTZ) && (g_dbSyntax == DB_SYNTAX_TSDB))
+   {
+      sql->append((column->type == LC_TIMESTAMP_MS) ? L"ms_to_timestamptz(" : L"to_timestamp(");
+      sql->append(value);
+      sql->append(L")");
+   }
+   else
+   {
+      sql->append(value);
+   }
+}
+
+/**
+ * Build condition selecting records following given key in keyset order
+ */
+StringBuffer NXCORE_EXPORTABLE BuildLogSeekCondition(const StructArray<KeysetColumn>& keyset, const IntegerArray<int64_t>& key)
+{
+   StringBuffer condition;
+   for(int i = 0; i < keyset.size(); i++)
+   {
+      if (i > 0)
+         condition.append(L" OR ");
+      condition.append(L'(');
+      for(int j = 0; j < i; j++)
+      {
+         condition.append(keyset.get(j)->definition->name);
+         condition.append(L'=');
+         AppendKeyValue(&condition, keyset.get(j)->definition, key.get(j));
+         condition.append(L" AND ");
+      }
+      const KeysetColumn *k = keyset.get(i);
+      condition.append(k->definition->name);
+      condition.append(k->descending ? L'<' : L'>');
+      AppendKeyValue(&condition, k->definition, key.get(i));
+      condition.append(L')');
+   }
+   return condition;
+}
+
 /**
  * Build SQL query from filter
  *
@@ -292,6 +416,25 @@ StringBuffer LogHandle::buildObjectAccessConstraint(uint32_t userId)
  * @return SQL query string
  */
 StringBuffer LogHandle::buildQuerySql(LogFilter *filter, int64_t maxRecordId, uint32_t userId)
+{
+   StructArray<KeysetColumn> keyset;
+   if (!buildKeyset(filter, &keyset))
+      keyset.clear();
+   return buildQuerySql(filter, maxRecordId, userId, keyset, nullptr, DEFAULT_ROW_COUNT_LIMIT);
+}
+
+/**
+ * Build SQL query from filter
+ *
+ * @param filter log filter to use
+ * @param maxRecordId maximum record ID to include (pass -1 to omit this constraint)
+ * @param userId user ID for access control (pass 0 to skip access control check)
+ * @param keyset keyset pagination key (empty if ordering from filter should be used as is)
+ * @param cursor key of last record already read (pass nullptr to read from the beginning)
+ * @param limit maximum number of records to select (pass 0 to omit this constraint)
+ * @return SQL query string
+ */
+StringBuffer LogHandle::buildQuerySql(LogFilter *filter, int64_t maxRecordId, uint32_t userId, const StructArray<KeysetColumn>& keyset, const IntegerArray<int64_t> *cursor, int64_t limit)
 {
    buildQueryColumnList();
 
@@ -299,13 +442,22 @@ StringBuffer LogHandle::buildQuerySql(LogFilter *filter, int64_t maxRecordId, ui
    switch(g_dbSyntax)
    {
       case DB_SYNTAX_MSSQL:
-         query.appendFormattedString(_T("SELECT TOP %u %s FROM %s"), m_rowCountLimit, m_queryColumns.cstr(), m_log->table);
+         if (limit > 0)
+            query.appendFormattedString(_T("SELECT TOP ") INT64_FMT _T(" %s FROM %s"), limit, m_queryColumns.cstr(), m_log->table);
+         else
+            query.appendFormattedString(_T("SELECT %s FROM %s"), m_queryColumns.cstr(), m_log->table);
          break;
       case DB_SYNTAX_INFORMIX:
-         query.appendFormattedString(_T("SELECT FIRST %u %s FROM %s"), m_rowCountLimit, m_queryColumns.cstr(), m_log->table);
+         if (limit > 0)
+            query.appendFormattedString(_T("SELECT FIRST ") INT64_FMT _T(" %s FROM %s"), limit, m_queryColumns.cstr(), m_log->table);
+         else
+            query.appendFormattedString(_T("SELECT %s FROM %s"), m_queryColumns.cstr(), m_log->table);
          break;
       case DB_SYNTAX_ORACLE:
-         query.appendFormattedString(_T("SELECT * FROM (SELECT %s FROM %s"), m_queryColumns.cstr(), m_log->table);
+         if (limit > 0)
+            query.appendFormattedString(_T("SELECT * FROM (SELECT %s FROM %s"), m_queryColumns.cstr(), m_log->table);
+         else
+            query.appendFormattedString(_T("SELECT %s FROM %s"), m_queryColumns.cstr(), m_log->table);
          break;
       case DB_SYNTAX_DB2:
       case DB_SYNTAX_MYSQL:
@@ -344,54 +496,118 @@ StringBuffer LogHandle::buildQuerySql(LogFilter *filter, int64_t maxRecordId, ui
          query.append(hasWhereClause ? _T(" AND (") : _T(" WHERE ("));
          query.append(constraint);
          query.append(_T(")"));
+         hasWhereClause = true;
       }
    }
 
-   query.append(filter->buildOrderClause());
+   if (!keyset.isEmpty())
+   {
+      if ((cursor != nullptr) && (cursor->size() == keyset.size()))
+      {
+         query.append(hasWhereClause ? _T(" AND (") : _T(" WHERE ("));
+         query.append(BuildLogSeekCondition(keyset, *cursor));
+         query.append(_T(")"));
+      }
+
+      query.append(_T(" ORDER BY "));
+      for(int i = 0; i < keyset.size(); i++)
+      {
+         if (i > 0)
+            query.append(_T(","));
+         query.append(keyset.get(i)->definition->name);
+         if (keyset.get(i)->descending)
+            query.append(_T(" DESC"));
+      }
+   }
+   else
+   {
+      query.append(filter->buildOrderClause());
+   }
 
    // Limit record count
-   switch(g_dbSyntax)
+   if (limit > 0)
    {
-      case DB_SYNTAX_MYSQL:
-      case DB_SYNTAX_PGSQL:
-      case DB_SYNTAX_SQLITE:
-      case DB_SYNTAX_TSDB:
-         query.appendFormattedString(_T(" LIMIT %u"), m_rowCountLimit);
-         break;
-      case DB_SYNTAX_ORACLE:
-         query.appendFormattedString(_T(") WHERE ROWNUM<=%u"), m_rowCountLimit);
-         break;
-      case DB_SYNTAX_DB2:
-         query.appendFormattedString(_T(" FETCH FIRST %u ROWS ONLY"), m_rowCountLimit);
-         break;
+      switch(g_dbSyntax)
+      {
+         case DB_SYNTAX_MYSQL:
+         case DB_SYNTAX_PGSQL:
+         case DB_SYNTAX_SQLITE:
+         case DB_SYNTAX_TSDB:
+            query.appendFormattedString(_T(" LIMIT ") INT64_FMT, limit);
+            break;
+         case DB_SYNTAX_ORACLE:
+            query.appendFormattedString(_T(") WHERE ROWNUM<=") INT64_FMT, limit);
+            break;
+         case DB_SYNTAX_DB2:
+            query.appendFormattedString(_T(" FETCH FIRST ") INT64_FMT _T(" ROWS ONLY"), limit);
+            break;
+      }
    }
 
    return query;
 }
 
 /**
- * Do query with current filter and column set
+ * Estimate number of records matching given filter. PostgreSQL based databases use planner
+ * estimate for actual query, other databases use table statistics and only for queries without
+ * filters. Returns -1 if estimate is not available.
  */
-bool LogHandle::queryInternal(int64_t *rowCount, uint32_t userId)
+int64_t LogHandle::estimateRowCount(LogFilter *filter, uint32_t userId)
 {
-   int64_t startTime = GetCurrentTimeMs();
-   StringBuffer query = buildQuerySql(m_filter, m_maxRecordId, userId);
+   StringBuffer query;
+   bool explain = (g_dbSyntax == DB_SYNTAX_PGSQL) || (g_dbSyntax == DB_SYNTAX_TSDB);
+   if (explain)
+   {
+      query.append(_T("EXPLAIN "));
+      query.append(buildQuerySql(filter, -1, userId, StructArray<KeysetColumn>(), nullptr, 0));
+   }
+   else
+   {
+      if ((filter->getNumColumnFilter() > 0) ||
+          ((userId != 0) && (m_log->relatedObjectIdColumn != nullptr) && ConfigReadBoolean(_T("Server.Security.ExtendedLogQueryAccessControl"), false)))
+         return -1;
 
-   nxlog_debug_tag(DEBUG_TAG_LOGS, 4, _T("LOG QUERY: %s"), query.cstr());
+      switch(g_dbSyntax)
+      {
+         case DB_SYNTAX_MSSQL:
+            query.appendFormattedString(_T("SELECT sum(row_count) FROM sys.dm_db_partition_stats WHERE object_id=object_id('%s') AND index_id<2"), m_log->table);
+            break;
+         case DB_SYNTAX_MYSQL:
+            query.appendFormattedString(_T("SELECT table_rows FROM information_schema.tables WHERE table_schema=database() AND table_name='%s'"), m_log->table);
+            break;
+         case DB_SYNTAX_ORACLE:
+            query.appendFormattedString(_T("SELECT num_rows FROM user_tables WHERE table_name=upper('%s')"), m_log->table);
+            break;
+         default:
+            return -1;
+      }
+   }
 
-   DB_HANDLE dbHandle = DBConnectionPoolAcquireConnection();
-   bool ret = false;
-   nxlog_debug_tag(DEBUG_TAG_LOGS, 7, _T("LogHandle::query(): DB connection acquired"));
-   m_resultSet = DBSelect(dbHandle, query.cstr());
-   if (m_resultSet != nullptr)
+   int64_t count = -1;
+   DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+   DB_RESULT hResult = DBSelect(hdb, query);
+   if (hResult != nullptr)
    {
-      *rowCount = DBGetNumRows(m_resultSet);
-      ret = true;
-      nxlog_debug_tag(DEBUG_TAG_LOGS, 4, _T("Log query successful, %d rows fetched in %d ms"), static_cast<int>(*rowCount), static_cast<int>(GetCurrentTimeMs() - startTime));
+      if (DBGetNumRows(hResult) > 0)
+      {
+         if (explain)
+         {
+            // Top plan node looks like "Sort  (cost=1.00..2.00 rows=100 width=64)"
+            TCHAR plan[1024];
+            DBGetField(hResult, 0, 0, plan, 1024);
+            const TCHAR *p = _tcsstr(plan, _T(" rows="));
+            if (p != nullptr)
+               count = _tcstoll(p + 6, nullptr, 10);
+         }
+         else
+         {
+            count = DBGetFieldInt64(hResult, 0, 0);
+         }
+      }
+      DBFreeResult(hResult);
    }
-   DBConnectionPoolReleaseConnection(dbHandle);
-
-   return ret;
+   DBConnectionPoolReleaseConnection(hdb);
+   return count;
 }
 
 /**
@@ -413,49 +629,71 @@ Table *LogHandle::createTable()
 }
 
 /**
- * Get data from query result
+ * Get data from query result. Rows are streamed from database without keeping result set
+ * between requests. If ordering allows keyset pagination and client reads rows sequentially,
+ * query continues from the key of last row sent to client; otherwise query is re-executed
+ * and preceding rows are skipped.
  */
 Table *LogHandle::getData(int64_t startRow, int64_t numRows, bool refresh, uint32_t userId)
 {
 	nxlog_debug(4, _T("Log data request: startRow=") INT64_FMT _T(", numRows=") INT64_FMT _T(", refresh=%s, userId=%u"),
 	         startRow, numRows, BooleanToString(refresh), userId);
 
-	if (m_resultSet == nullptr)
+	if (m_filter == nullptr)
 		return createTable();	// send empty table to indicate end of data
 
-	int resultSize = DBGetNumRows(m_resultSet);
-	if (((int)(startRow + numRows) >= resultSize) || refresh)
+	if (refresh)
+	   resetCursor();
+	else if (m_endOfData && (startRow >= m_cursorRow))
+	   return createTable();	// send empty table to indicate end of data
+
+	bool seek = !m_keyset.isEmpty() && (startRow == m_cursorRow) && ((startRow == 0) || (m_cursorKey.size() == m_keyset.size()));
+	int64_t skip = seek ? 0 : startRow;
+	StringBuffer query = buildQuerySql(m_filter, m_maxRecordId, userId, m_keyset, (seek && (startRow > 0)) ? &m_cursorKey : nullptr, skip + numRows);
+	nxlog_debug_tag(DEBUG_TAG_LOGS, 4, _T("LOG QUERY: %s"), query.cstr());
+
+	int64_t startTime = GetCurrentTimeMs();
+	DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+	DB_UNBUFFERED_RESULT hResult = DBSelectUnbuffered(hdb, query);
+	if (hResult == nullptr)
 	{
-		if ((resultSize < (int)m_rowCountLimit) && !refresh)
-		{
-			if (startRow >= resultSize)
-				return createTable();	// send empty table to indicate end of data
-		}
-		else
-		{
-			// possibly we have more rows or refresh was requested
-			uint32_t newLimit = (UINT32)(startRow + numRows);
-			if (newLimit > m_rowCountLimit)
-				m_rowCountLimit = (newLimit - m_rowCountLimit < 1000) ? (m_rowCountLimit + 1000) : newLimit;
-			deleteQueryResults();
-			int64_t rowCount;
-			if (!queryInternal(&rowCount, userId))
-				return nullptr;
-			resultSize = DBGetNumRows(m_resultSet);
-		}
+	   DBConnectionPoolReleaseConnection(hdb);
+	   return nullptr;
 	}
 
 	Table *table = createTable();
-	int maxRow = std::min((int)(startRow + numRows), resultSize);
-	for(int i = (int)startRow; i < maxRow; i++)
+	while(DBFetch(hResult))
 	{
+	   if (skip > 0)
+	   {
+	      skip--;
+	      continue;
+	   }
 		table->addRow();
 		for(int j = 0; j < table->getNumColumns(); j++)
 		{
-			table->setPreallocated(j, DBGetField(m_resultSet, i, j, NULL, 0));
+			table->setPreallocated(j, DBGetField(hResult, j, nullptr, 0));
 		}
 	}
+	DBFreeResult(hResult);
+	DBConnectionPoolReleaseConnection(hdb);
+
+	int rows = table->getNumRows();
+	if (rows > 0)
+	{
+	   m_cursorKey.clear();
+	   for(int i = 0; i < m_keyset.size(); i++)
+	      m_cursorKey.add(table->getAsInt64(rows - 1, m_keyset.get(i)->index));
+	}
+	else if (!seek)
+	{
+	   m_cursorKey.clear();
+	}
+	m_cursorRow = startRow + rows;
+	m_endOfData = (rows < numRows);
 
+	nxlog_debug_tag(DEBUG_TAG_LOGS, 4, _T("Log query successful, %d rows fetched in %d ms (%s)"), rows,
+	         static_cast<int>(GetCurrentTimeMs() - startTime), seek ? _T("keyset") : _T("offset"));
 	return table;
 }
 
@@ -548,16 +786,17 @@ json_t *LogHandle::getColumnInfoAsJson() const
 }
 
 /**
- * Convert single value from query result to JSON according to column type
+ * Convert single value from query result to JSON according to column type. Position is
+ * given as row and column for buffered result and as column only for unbuffered result.
  */
-static json_t *ColumnValueToJson(DB_RESULT hResult, int row, int column, const LOG_COLUMN& definition)
+template<typename R, typename... P> static json_t *ColumnValueToJson(const LOG_COLUMN& definition, R hResult, P... position)
 {
    switch(definition.type)
    {
       case LC_TIMESTAMP:
-         return json_time_string(static_cast<time_t>(DBGetFieldInt64(hResult, row, column)));
+         return json_time_string(static_cast<time_t>(DBGetFieldInt64(hResult, position...)));
       case LC_TIMESTAMP_MS:
-         return json_time_string_ms(DBGetFieldInt64(hResult, row, column));
+         return json_time_string_ms(DBGetFieldInt64(hResult, position...));
       case LC_ACTION_CODE:
       case LC_AI_OP_EXEC_STATUS:
       case LC_AI_TASK_STATUS:
@@ -576,10 +815,10 @@ static json_t *ColumnValueToJson(DB_RESULT hResult, int row, int column, const L
       case LC_SEVERITY:
       case LC_USER_ID:
       case LC_ZONE_UIN:
-         return json_integer(DBGetFieldInt64(hResult, row, column));
+         return json_integer(DBGetFieldInt64(hResult, position...));
       case LC_JSON_DETAILS:
          {
-            char *value = DBGetFieldUTF8(hResult, row, column, nullptr, 0);
+            char *value = DBGetFieldUTF8(hResult, position..., nullptr, 0);
             if (value == nullptr)
                return json_null();
             json_t *json = json_loads(value, 0, nullptr);
@@ -590,7 +829,7 @@ static json_t *ColumnValueToJson(DB_RESULT hResult, int row, int column, const L
          }
       default:
          {
-            wchar_t *value = DBGetField(hResult, row, column, nullptr, 0);
+            wchar_t *value = DBGetField(hResult, position..., nullptr, 0);
             json_t *json = json_string_w(value);
             MemFree(value);
             return json;
@@ -599,55 +838,114 @@ static json_t *ColumnValueToJson(DB_RESULT hResult, int row, int column, const L
 }
 
 /**
- * Create JSON document for single record from query result. Column set must match the one
- * used to build the query (detail columns are omitted from log queries).
+ * Create JSON document for single record from query result (row number should be given
+ * only for buffered result). Column set must match the one used to build the query
+ * (detail columns are omitted from log queries).
  */
-json_t *LogHandle::createRecordFromDBResult(DB_RESULT hResult, int row, bool includeDetailColumns)
+template<typename R, typename... P> static json_t *CreateRecordFromDBResult(const NXCORE_LOG *log, bool includeDetailColumns, R hResult, P... row)
 {
    json_t *record = json_object();
    int index = 0;
-   for(int i = 0; m_log->columns[i].name != nullptr; i++)
+   for(int i = 0; log->columns[i].name != nullptr; i++)
    {
-      const LOG_COLUMN& column = m_log->columns[i];
+      const LOG_COLUMN& column = log->columns[i];
       if (includeDetailColumns ? IsHiddenColumn(column.type) : IsIgnoredColumn(column.type))
          continue;
 
       char name[MAX_COLUMN_NAME_LEN * 3];
       wchar_to_utf8(column.name, -1, name, sizeof(name));
-      json_object_set_new(record, name, ColumnValueToJson(hResult, row, index++, column));
+      json_object_set_new(record, name, ColumnValueToJson(column, hResult, row..., index++));
    }
    return record;
 }
 
 /**
- * Build SQL query for given filter and page of records. Sets row count limit to cover
- * requested page, so that records to be skipped are still selected by the query.
+ * Decode pagination cursor received from client. Cursor is a comma separated list of key
+ * values of the last record on previous page. Returns false if cursor is malformed or
+ * filter's ordering does not allow keyset pagination.
  */
-StringBuffer LogHandle::buildPagedQuerySql(LogFilter *filter, int64_t offset, int64_t limit, uint32_t userId)
+bool LogHandle::decodeCursor(LogFilter *filter, const char *cursor, IntegerArray<int64_t> *key)
 {
-   m_rowCountLimit = static_cast<uint32_t>(offset + limit);
-   return buildQuerySql(filter, -1, userId);
+   StructArray<KeysetColumn> keyset;
+   if (!buildKeyset(filter, &keyset))
+      return false;
+
+   key->clear();
+   const char *p = cursor;
+   while(true)
+   {
+      char *eptr;
+      int64_t value = strtoll(p, &eptr, 10);
+      if (eptr == p)
+         return false;
+      key->add(value);
+      if (*eptr == 0)
+         break;
+      if (*eptr != ',')
+         return false;
+      p = eptr + 1;
+   }
+   return key->size() == keyset.size();
+}
+
+/**
+ * Build SQL query for given filter and page of records. Row count limit covers requested
+ * page, so that records to be skipped are still selected by the query.
+ */
+StringBuffer LogHandle::buildPagedQuerySql(LogFilter *filter, int64_t offset, int64_t limit, const IntegerArray<int64_t> *cursor, uint32_t userId)
+{
+   StructArray<KeysetColumn> keyset;
+   if (!buildKeyset(filter, &keyset))
+      keyset.clear();
+   return buildQuerySql(filter, -1, userId, keyset, cursor, offset + limit);
 }
 
 /**
- * Execute query and return requested page of records as JSON array. Returns nullptr on database failure.
+ * Execute query and return requested page of records as JSON array. Records are streamed
+ * from database and first offset records are skipped. If cursor is given, page starts after
+ * the record identified by cursor. If ordering allows keyset pagination and page is full,
+ * cursor for the next page is returned in nextCursor. Returns nullptr on database failure.
  */
-json_t *LogHandle::queryAsJson(LogFilter *filter, int64_t offset, int64_t limit, uint32_t userId)
+json_t *LogHandle::queryAsJson(LogFilter *filter, int64_t offset, int64_t limit, const IntegerArray<int64_t> *cursor, uint32_t userId, StringBuffer *nextCursor)
 {
-   StringBuffer query = buildPagedQuerySql(filter, offset, limit, userId);
+   StructArray<KeysetColumn> keyset;
+   if (!buildKeyset(filter, &keyset))
+      keyset.clear();
+   StringBuffer query = buildQuerySql(filter, -1, userId, keyset, cursor, offset + limit);
    nxlog_debug_tag(DEBUG_TAG_LOGS, 4, L"LOG QUERY: %s", query.cstr());
 
    int64_t startTime = GetCurrentTimeMs();
    DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
-   DB_RESULT hResult = DBSelect(hdb, query);
+   DB_UNBUFFERED_RESULT hResult = DBSelectUnbuffered(hdb, query);
    json_t *records;
    if (hResult != nullptr)
    {
       records = json_array();
-      int numRows = DBGetNumRows(hResult);
-      for(int i = static_cast<int>(offset); i < numRows; i++)
-         json_array_append_new(records, createRecordFromDBResult(hResult, i, false));
+      IntegerArray<int64_t> lastKey(keyset.size());
+      while(DBFetch(hResult))
+      {
+         if (offset > 0)
+         {
+            offset--;
+            continue;
+         }
+         json_array_append_new(records, CreateRecordFromDBResult(m_log, false, hResult));
+         lastKey.clear();
+         for(int i = 0; i < keyset.size(); i++)
+            lastKey.add(DBGetFieldInt64(hResult, keyset.get(i)->index));
+      }
       DBFreeResult(hResult);
+
+      if (!keyset.isEmpty() && (json_array_size(records) == static_cast<size_t>(limit)))
+      {
+         for(int i = 0; i < lastKey.size(); i++)
+         {
+            if (i > 0)
+               nextCursor->append(L',');
+            nextCursor->append(lastKey.get(i));
+         }
+      }
+
       nxlog_debug_tag(DEBUG_TAG_LOGS, 4, L"Log query successful, %d records returned in %d ms",
                static_cast<int>(json_array_size(records)), static_cast<int>(GetCurrentTimeMs() - startTime));
    }
@@ -690,7 +988,7 @@ uint32_t LogHandle::getRecordAsJson(int64_t recordId, json_t **record)
    {
       if (DBGetNumRows(hResult) > 0)
       {
-         *record = createRecordFromDBResult(hResult, 0, true);
+         *record = CreateRecordFromDBResult(m_log, true, hResult, 0);
          rcc = RCC_SUCCESS;
       }
       else
@@ -106,6 +106,7 @@ void StopHouseKeeper();
 void InitStorageClassMigration();
 void ShutdownStorageClassMigration();
 void StartSNMPAgent();
+void ExpireIdleSnmpTransports();
 void StopSNMPAgent();
 void LoadTrapMappings();
 void StartSnmpTrapReceiver();
@@ -230,6 +231,8 @@ uint32_t g_thresholdRepeatInterval = 0;	// Disabled by default
 uint32_t g_requiredPolls = 1;
 int32_t g_instanceRetentionTime = 7; // Default instance retention time (in days)
 SNMP_Version g_snmpMinVersion = SNMP_VERSION_1;
+uint32_t g_snmpBulkWalkMaxRepetitions = 25;
+uint32_t g_snmpTransportPoolIdleTimeout = 120;
 uint32_t g_snmpTrapStormCountThreshold = 0;
 uint32_t g_snmpTrapStormDurationThreshold = 15;
 DB_DRIVER g_dbDriver = nullptr;
@@ -774,6 +777,9 @@ static void LoadGlobalConfig()
    g_offlineDataRelevanceTime = ConfigReadInt(_T("DataCollection.OfflineDataRelevanceTime"), 86400) * 1000L; // Config value is in seconds
    g_instanceRetentionTime = ConfigReadInt(_T("DataCollection.InstanceRetentionTime"), 7); // Config values are in days
    g_snmpMinVersion = SNMP_VersionFromInt(ConfigReadInt(_T("SNMP.MinVersion"), 0));
+   g_snmpBulkWalkMaxRepetitions = ConfigReadULong(_T("SNMP.BulkWalk.MaxRepetitions"), 25);
+   g_snmpTransportPoolIdleTimeout = ConfigReadULong(_T("SNMP.TransportPool.IdleTimeout"), 120);
+   g_pdsMaxQueueSize = ConfigReadULong(_T("PerfDataStorage.MaxQueueSize"), 100000);
    g_snmpTrapStormCountThreshold = ConfigReadInt(_T("SNMP.Traps.RateLimit.Threshold"), 0);
    g_snmpTrapStormDurationThreshold = ConfigReadInt(_T("SNMP.Traps.RateLimit.Duration"), 15);
    ConfigReadStrUTF8(_T("SNMP.Codepage"), g_snmpCodepage, 16, "");
@@ -1490,6 +1496,7 @@ bool NXCORE_EXPORTABLE Initialize()
 
    // Load and compile scripts
    LoadScripts();
+   InitServerScriptVMPool();
 
    // Load MIB tree for SNMP display hint support
    LoadMIBTree();
@@ -1691,6 +1698,9 @@ bool ActivateServer()
    StartHouseKeeper();
    StartV5DataMigration();
 
+   // Start periodic cleanup of idle pooled SNMP transports
+   ThreadPoolExecute(g_mainThreadPool, ExpireIdleSnmpTransports);
+
    // Start event processor
    s_eventProcessorThread = StartEventProcessor();
 
@@ -1957,6 +1967,7 @@ void NXCORE_EXPORTABLE Shutdown()
 
    ShutdownPerfDataStorageDrivers();
 
+   ShutdownServerScriptVMPool();
    CleanupActions();
    ShutdownEventSubsystem();
    ShutdownIncidentManager();
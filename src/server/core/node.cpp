@@ -354,7 +354,7 @@ json_t *AdditionalSnmpAgent::toJson(bool includeSensitiveData) const
  * Node class default constructor
  */
 Node::Node() : super(Pollable::STATUS | Pollable::CONFIGURATION | Pollable::DISCOVERY | Pollable::TOPOLOGY | Pollable::ROUTING_TABLE | Pollable::ICMP),
-         m_additionalSnmpAgents(0, 8, Ownership::True), m_routingTableMutex(MutexType::FAST), m_topologyMutex(MutexType::FAST)
+         m_additionalSnmpAgents(0, 8, Ownership::True), m_snmpTransportPoolLock(MutexType::FAST), m_routingTableMutex(MutexType::FAST), m_topologyMutex(MutexType::FAST)
 {
    m_status = STATUS_UNKNOWN;
    m_type = NODE_TYPE_UNKNOWN;
@@ -493,7 +493,7 @@ Node::Node() : super(Pollable::STATUS | Pollable::CONFIGURATION | Pollable::DISC
  */
 Node::Node(const NewNodeData *newNodeData, uint32_t flags) : super(Pollable::STATUS | Pollable::CONFIGURATION | Pollable::DISCOVERY | Pollable::TOPOLOGY | Pollable::ROUTING_TABLE | Pollable::ICMP),
          m_ipAddress(newNodeData->ipAddr), m_primaryHostName(newNodeData->ipAddr.toString()), m_additionalSnmpAgents(0, 8, Ownership::True),
-         m_routingTableMutex(MutexType::FAST), m_topologyMutex(MutexType::FAST),
+         m_snmpTransportPoolLock(MutexType::FAST), m_routingTableMutex(MutexType::FAST), m_topologyMutex(MutexType::FAST),
          m_sshLogin(newNodeData->sshLogin), m_sshPassword(newNodeData->sshPassword), m_vncPassword(newNodeData->vncPassword)
 {
    m_runtimeFlags |= ODF_CONFIGURATION_POLL_PENDING;
@@ -676,6 +676,8 @@ Node::~Node()
    delete m_icmpStatCollectors;
    MemFree(m_chassisPlacementConf);
    delete m_reconciliation;
+   for(int i = 0; i < m_snmpTransportPool.size(); i++)
+      delete m_snmpTransportPool.get(i)->transport;
 }
 
 /**
@@ -2113,7 +2115,7 @@ InterfaceList *Node::getInterfaceList()
    }
    if ((ifList == nullptr) && (m_capabilities & NC_IS_SNMP) && !(m_flags & NF_DISABLE_SNMP))
    {
-      SNMP_Transport *snmpTransport = createSnmpTransport();
+      SNMP_Transport *snmpTransport = acquireSnmpTransport();
       if (snmpTransport != nullptr)
       {
          bool useIfXTable;
@@ -2172,7 +2174,7 @@ InterfaceList *Node::getInterfaceList()
             }
          }
 
-         delete snmpTransport;
+         releaseSnmpTransport(snmpTransport);
       }
       else
       {
@@ -2813,6 +2815,8 @@ bool Node::isManagementStatusChangeAllowed(bool isManaged)
  */
 void Node::onMgmtStatusChange(bool isManaged, int oldStatus)
 {
+   super::onMgmtStatusChange(isManaged, oldStatus);
+
    // Generate event if current object is a node
    EventBuilder(isManaged ? EVENT_NODE_UNKNOWN : EVENT_NODE_UNMANAGED, m_id)
       .param(_T("previousNodeStatus"), oldStatus)
@@ -3090,7 +3094,7 @@ void Node::statusPoll(PollerInfo *poller, ClientSession *pSession, uint32_t rqId
 
       uint32_t snmpProxyId;
       bool snmpProxyConnectionFailed;
-      SNMP_Transport *pTransport = createSnmpTransportForPoller(&snmpProxyId, &snmpProxyConnectionFailed);
+      SNMP_Transport *pTransport = acquireSnmpTransportForPoller(&snmpProxyId, &snmpProxyConnectionFailed);
       if (pTransport != nullptr)
       {
          SharedString testOid = getCustomAttribute(_T("snmp.testoid"));
@@ -3141,7 +3145,8 @@ void Node::statusPoll(PollerInfo *poller, ClientSession *pSession, uint32_t rqId
             m_snmpSecurity->setAuthoritativeEngine(SNMP_Engine());
             m_snmpSecurity->setContextEngine(SNMP_Engine());
             unlockProperties();
-            delete pTransport;
+            invalidateSnmpTransportPool();   // Pooled transports have outdated engine data
+            releaseSnmpTransport(pTransport);
             retryCount--;
             goto restart_status_poll;
          }
@@ -3159,7 +3164,7 @@ void Node::statusPoll(PollerInfo *poller, ClientSession *pSession, uint32_t rqId
                   {
                      nxlog_debug_tag(DEBUG_TAG_STATUS_POLL, 6, _T("StatusPoll(%s): proxy connection for SNMP is valid"), m_name);
                      retryCount--;
-                     delete pTransport;
+                     releaseSnmpTransport(pTransport);
                      goto restart_status_poll;
                   }
                   else
@@ -3212,7 +3217,7 @@ void Node::statusPoll(PollerInfo *poller, ClientSession *pSession, uint32_t rqId
                }
             }
          }
-         delete pTransport;
+         releaseSnmpTransport(pTransport);
       }
       else
       {
@@ -3655,7 +3660,7 @@ void Node::statusPoll(PollerInfo *poller, ClientSession *pSession, uint32_t rqId
    poller->setStatus(_T("child poll"));
    nxlog_debug_tag(DEBUG_TAG_STATUS_POLL, 7, _T("StatusPoll(%s): starting child object poll"), m_name);
    shared_ptr<Cluster> cluster = getCluster();
-   SNMP_Transport *snmp = snmpReachable ? createSnmpTransport() : nullptr;
+   SNMP_Transport *snmp = snmpReachable ? acquireSnmpTransport() : nullptr;
    for(int i = 0; i < pollList.size(); i++)
    {
       NetObj *curr = pollList.get(i);
@@ -3674,9 +3679,9 @@ void Node::statusPoll(PollerInfo *poller, ClientSession *pSession, uint32_t rqId
             break;
       }
 
-      POLL_CANCELLATION_CHECKPOINT_EX({ delete eventQueue; delete snmp; });
+      POLL_CANCELLATION_CHECKPOINT_EX({ delete eventQueue; releaseSnmpTransport(snmp); });
    }
-   delete snmp;
+   releaseSnmpTransport(snmp);
    nxlog_debug_tag(DEBUG_TAG_STATUS_POLL, 7, _T("StatusPoll(%s): finished child object poll"), m_name);
 
    // Check if entire node is down
@@ -5032,12 +5037,12 @@ bool Node::updateSystemHardwareInformation(PollerInfo *poller, uint32_t requestI
 
    if (!success && (m_capabilities & NC_IS_SNMP))
    {
-      SNMP_Transport *snmp = createSnmpTransport();
+      SNMP_Transport *snmp = acquireSnmpTransport();
       if (snmp != nullptr)
       {
          NodeDeviceContext context(self(), snmp);
          success = m_driver->getHardwareInformation(&context, this, m_driverData, &hwInfo);
-         delete snmp;
+         releaseSnmpTransport(snmp);
       }
       if ((!success || (hwInfo.vendor[0] == 0) || (hwInfo.productName[0] == 0) || (hwInfo.productVersion[0] == 0) || (hwInfo.serialNumber[0] == 0)) && (m_capabilities & NC_HAS_ENTITY_MIB))
       {
@@ -5437,6 +5442,7 @@ void Node::configurationPoll(PollerInfo *poller, ClientSession *session, uint32_
 
    if (confPollAgent())
       modified |= MODIFY_NODE_PROPERTIES;
+   UpdateNodeAttributeIndexes(*this);
 
    if ((oldCapabilities & NC_IS_NATIVE_AGENT) && !(m_capabilities & NC_IS_NATIVE_AGENT))
       m_lastAgentCommTime = TIMESTAMP_NEVER;
@@ -5484,6 +5490,7 @@ void Node::configurationPoll(PollerInfo *poller, ClientSession *session, uint32_
 
    if (confPollSnmp())
       modified |= MODIFY_NODE_PROPERTIES;
+   UpdateNodeAttributeIndexes(*this);
 
    // Check if SNMP was marked as unreachable before full poll
    if ((m_capabilities & NC_IS_SNMP) && !(m_expectedCapabilities & NC_IS_SNMP) && (m_state & NSF_SNMP_UNREACHABLE) && (m_runtimeFlags & NDF_RECHECK_CAPABILITIES))
@@ -6207,13 +6214,13 @@ NodeType Node::detectNodeType(TCHAR *hypervisorType, TCHAR *hypervisorInfo)
       nxlog_debug_tag(DEBUG_TAG_CONF_POLL, 6, _T("Node::detectNodeType(%s [%d]): SNMP node, driver name is %s"), m_name, m_id, m_driver->getName());
 
       bool vtypeReportedByDevice = false;
-      SNMP_Transport *snmp = createSnmpTransport();
+      SNMP_Transport *snmp = acquireSnmpTransport();
       if (snmp != nullptr)
       {
          VirtualizationType vt;
          NodeDeviceContext context(self(), snmp);
          vtypeReportedByDevice = m_driver->getVirtualizationType(&context, this, m_driverData, &vt);
-         delete snmp;
+         releaseSnmpTransport(snmp);
          if (vtypeReportedByDevice)
          {
             if (vt != VTYPE_NONE)
@@ -7067,6 +7074,8 @@ bool Node::confPollSnmp()
       return false;
    }
 
+   invalidateSnmpTransportPool();
+
    lockProperties();
    m_snmpPort = pTransport->getPort();
    delete m_snmpSecurity;
@@ -8742,6 +8751,27 @@ static inline char *ContextToUtf8(const wchar_t *context, char *buffer, size_t s
    return nullptr;
 }
 
+/**
+ * Read single DCI value via SNMP using given transport
+ */
+static uint32_t ReadSNMPValue(SNMP_Transport *snmp, const wchar_t *name, wchar_t *buffer, size_t size)
+{
+   SNMP_PDU request(SNMP_GET_REQUEST, SnmpNewRequestId(), snmp->getSnmpVersion());
+   request.bindVariable(new SNMP_Variable(name));
+
+   SNMP_PDU *response;
+   uint32_t snmpResult = snmp->doRequest(&request, &response);
+   if (snmpResult == SNMP_ERR_SUCCESS)
+   {
+      if ((response->getNumVariables() > 0) && (response->getErrorCode() == SNMP_PDU_ERR_SUCCESS))
+         snmpResult = GetSNMPResponseValue(response->getVariable(0), buffer, size);
+      else
+         snmpResult = SNMP_ERR_NO_OBJECT;
+      delete response;
+   }
+   return snmpResult;
+}
+
 /**
  * Get DCI value via SNMP. Buffer size should be at least 64 characters.
  */
@@ -8768,7 +8798,7 @@ DataCollectionError Node::getMetricFromSNMP(uint16_t port, SNMP_Version version,
    bool agentNotFound = false;
    SNMP_Transport *snmp = useAdditionalAgent ?
       createSnmpTransportForAgent(snmpAgentName, &agentNotFound) :
-      createSnmpTransport(port, version, ContextToUtf8(context, contextUtf8, sizeof(contextUtf8)));
+      acquireSnmpTransport(port, version, ContextToUtf8(context, contextUtf8, sizeof(contextUtf8)));
    if (agentNotFound)
    {
       nxlog_debug_tag(DEBUG_TAG_DC_SNMP _T(".error"), 7, _T("Node(%s)->getMetricFromSNMP(%s): additional SNMP agent \"%s\" is not configured"), m_name, name, snmpAgentName);
@@ -8778,24 +8808,7 @@ DataCollectionError Node::getMetricFromSNMP(uint16_t port, SNMP_Version version,
    {
       if (interpretRawValue == SNMP_RAWTYPE_NONE)
       {
-         SNMP_PDU request(SNMP_GET_REQUEST, SnmpNewRequestId(), snmp->getSnmpVersion());
-         request.bindVariable(new SNMP_Variable(name));
-
-         SNMP_PDU *response;
-         snmpResult = snmp->doRequest(&request, &response);
-         if (snmpResult == SNMP_ERR_SUCCESS)
-         {
-            if ((response->getNumVariables() > 0) && (response->getErrorCode() == SNMP_PDU_ERR_SUCCESS))
-            {
-               SNMP_Variable *varbind = response->getVariable(0);
-               FormatSNMPValue(varbind, buffer, size);
-            }
-            else
-            {
-               snmpResult = SNMP_ERR_NO_OBJECT;
-            }
-            delete response;
-         }
+         snmpResult = ReadSNMPValue(snmp, name, buffer, size);
       }
       else
       {
@@ -8846,7 +8859,7 @@ DataCollectionError Node::getMetricFromSNMP(uint16_t port, SNMP_Version version,
             }
          }
       }
-      delete snmp;
+      releaseSnmpTransport(snmp);
 
       if (snmpResult == SNMP_ERR_SUCCESS)
       {
@@ -8866,6 +8879,159 @@ DataCollectionError Node::getMetricFromSNMP(uint16_t port, SNMP_Version version,
    return DCErrorFromSNMPError(snmpResult);
 }
 
+/**
+ * Get multiple DCI values via SNMP using as few requests as possible. Up to maxVarbinds
+ * OIDs are requested in single GET PDU. If agent rejects combined request (for example with
+ * noSuchName or tooBig error) values from that PDU are requested one by one. Each buffer
+ * should be at least 64 characters long.
+ */
+void Node::getMetricsFromSNMP(uint16_t port, SNMP_Version version, const wchar_t *context, const wchar_t *snmpAgentName,
+         int count, const wchar_t * const *names, wchar_t **buffers, size_t size, DataCollectionError *results, int maxVarbinds)
+{
+   bool useAdditionalAgent = (snmpAgentName != nullptr) && (*snmpAgentName != 0);
+   if ((((m_state & NSF_SNMP_UNREACHABLE) || !(m_capabilities & NC_IS_SNMP)) && (port == 0) && !useAdditionalAgent) ||
+       (m_state & DCSF_UNREACHABLE) ||
+       (m_flags & NF_DISABLE_SNMP))
+   {
+      nxlog_debug_tag(DEBUG_TAG_DC_SNMP _T(".error"), 7, _T("Node(%s)->getMetricsFromSNMP(%d metrics): SNMP unreachable or disabled (state=0x%08x flags=0x%08x is_snmp=%s)"),
+         m_name, count, m_state, m_flags, BooleanToString((m_capabilities & NC_IS_SNMP) != 0));
+      for(int i = 0; i < count; i++)
+         results[i] = DCErrorFromSNMPError(SNMP_ERR_COMM);
+      return;
+   }
+
+   char contextUtf8[256];
+   bool agentNotFound = false;
+   SNMP_Transport *snmp = useAdditionalAgent ?
+      createSnmpTransportForAgent(snmpAgentName, &agentNotFound) :
+      acquireSnmpTransport(port, version, ContextToUtf8(context, contextUtf8, sizeof(contextUtf8)));
+   if (agentNotFound || (snmp == nullptr))
+   {
+      if (agentNotFound)
+         nxlog_debug_tag(DEBUG_TAG_DC_SNMP _T(".error"), 7, _T("Node(%s)->getMetricsFromSNMP(%d metrics): additional SNMP agent \"%s\" is not configured"), m_name, count, snmpAgentName);
+      else
+         nxlog_debug_tag(DEBUG_TAG_DC_SNMP _T(".error"), 7, _T("Node(%s)->getMetricsFromSNMP(%d metrics): cannot create SNMP transport"), m_name, count);
+      for(int i = 0; i < count; i++)
+         results[i] = agentNotFound ? DCE_NOT_SUPPORTED : DCErrorFromSNMPError(SNMP_ERR_COMM);
+      releaseSnmpTransport(snmp);
+      return;
+   }
+
+   if (maxVarbinds < 1)
+      maxVarbinds = 1;
+
+   uint32_t commError = SNMP_ERR_SUCCESS;
+   for(int start = 0; start < count; start += maxVarbinds)
+   {
+      int chunkSize = std::min(maxVarbinds, count - start);
+
+      // Do not send further requests if agent does not respond
+      if (commError != SNMP_ERR_SUCCESS)
+      {
+         for(int i = 0; i < chunkSize; i++)
+            results[start + i] = DCErrorFromSNMPError(commError);
+         continue;
+      }
+
+      SNMP_PDU request(SNMP_GET_REQUEST, SnmpNewRequestId(), snmp->getSnmpVersion());
+      for(int i = 0; i < chunkSize; i++)
+         request.bindVariable(new SNMP_Variable(names[start + i]));
+
+      SNMP_PDU *response;
+      uint32_t snmpResult = snmp->doRequest(&request, &response);
+      if (snmpResult == SNMP_ERR_SUCCESS)
+      {
+         if ((response->getErrorCode() == SNMP_PDU_ERR_SUCCESS) && (response->getNumVariables() == chunkSize))
+         {
+            // SNMPv2 agents report missing objects as exception values in otherwise successful response
+            for(int i = 0; i < chunkSize; i++)
+               results[start + i] = DCErrorFromSNMPError(GetSNMPResponseValue(response->getVariable(i), buffers[start + i], size));
+            delete response;
+            continue;
+         }
+
+         nxlog_debug_tag(DEBUG_TAG_DC_SNMP, 7, _T("Node(%s)->getMetricsFromSNMP(): combined request for %d metrics failed (PDU error %d, %d varbinds in response), falling back to individual requests"),
+            m_name, chunkSize, static_cast<int>(response->getErrorCode()), static_cast<int>(response->getNumVariables()));
+         delete response;
+
+         for(int i = 0; i < chunkSize; i++)
+         {
+            uint32_t rc = (commError == SNMP_ERR_SUCCESS) ? ReadSNMPValue(snmp, names[start + i], buffers[start + i], size) : commError;
+            if ((rc == SNMP_ERR_TIMEOUT) || (rc == SNMP_ERR_COMM))
+               commError = rc;
+            results[start + i] = DCErrorFromSNMPError(rc);
+         }
+      }
+      else
+      {
+         nxlog_debug_tag(DEBUG_TAG_DC_SNMP _T(".error"), 7, _T("Node(%s)->getMetricsFromSNMP(): SNMP error %u (%s) on combined request for %d metrics"),
+            m_name, snmpResult, SnmpGetErrorText(snmpResult), chunkSize);
+         if ((snmpResult == SNMP_ERR_TIMEOUT) || (snmpResult == SNMP_ERR_COMM))
+            commError = snmpResult;
+         for(int i = 0; i < chunkSize; i++)
+            results[start + i] = DCErrorFromSNMPError(snmpResult);
+      }
+   }
+   releaseSnmpTransport(snmp);
+
+   nxlog_debug_tag(DEBUG_TAG_DC_SNMP, 7, _T("Node(%s)->getMetricsFromSNMP(): %d metrics processed"), m_name, count);
+}
+
+/**
+ * Start asynchronous collection of single DCI value via SNMP using given asynchronous engine. Returns false if
+ * request cannot be handled asynchronously (node is unreachable, SNMPv3 or proxy is used, etc.) and caller should
+ * fall back to synchronous collection. Otherwise callback will be called with collection result and value.
+ */
+bool Node::getMetricFromSNMPAsync(SNMP_AsyncEngine *engine, uint16_t port, SNMP_Version version, const wchar_t *metric, const wchar_t *context,
+         std::function<void (DataCollectionError, const wchar_t*)> callback)
+{
+   if ((((m_state & NSF_SNMP_UNREACHABLE) || !(m_capabilities & NC_IS_SNMP)) && (port == 0)) ||
+       (m_state & DCSF_UNREACHABLE) ||
+       (m_flags & NF_DISABLE_SNMP))
+      return false;  // Let synchronous code path handle and report error
+
+   char contextUtf8[256];
+   SNMP_Transport *snmp = acquireSnmpTransport(port, version, ContextToUtf8(context, contextUtf8, sizeof(contextUtf8)));
+   if (snmp == nullptr)
+      return false;
+
+   if (snmp->isProxyTransport() || (snmp->getSnmpVersion() == SNMP_VERSION_3))
+   {
+      releaseSnmpTransport(snmp);
+      return false;
+   }
+
+   SNMP_PDU request(SNMP_GET_REQUEST, 0, snmp->getSnmpVersion());
+   request.bindVariable(new SNMP_Variable(metric));
+
+   uint32_t nodeId = m_id;
+   uint32_t rc = engine->sendRequest(&request, snmp->getPeerIpAddress(), snmp->getPort(), snmp->getSecurityContext(),
+      SnmpGetDefaultTimeout(), SnmpGetDefaultRetryCount(),
+      [nodeId, callback] (uint32_t snmpResult, SNMP_PDU *response) -> void
+      {
+         wchar_t value[MAX_RESULT_LENGTH];
+         value[0] = 0;
+         if (snmpResult == SNMP_ERR_SUCCESS)
+         {
+            if ((response->getNumVariables() > 0) && (response->getErrorCode() == SNMP_PDU_ERR_SUCCESS))
+               snmpResult = GetSNMPResponseValue(response->getVariable(0), value, MAX_RESULT_LENGTH);
+            else
+               snmpResult = SNMP_ERR_NO_OBJECT;
+            delete response;
+         }
+         else
+         {
+            nxlog_debug_tag(DEBUG_TAG_DC_SNMP _T(".error"), 7, _T("Node [%u]: asynchronous SNMP request failed (%s)"), nodeId, SnmpGetErrorText(snmpResult));
+         }
+         callback(DCErrorFromSNMPError(snmpResult), value);
+      }, snmp->getCodepage());
+   releaseSnmpTransport(snmp);
+
+   if (rc != SNMP_ERR_SUCCESS)
+      nxlog_debug_tag(DEBUG_TAG_DC_SNMP _T(".error"), 7, _T("Node(%s)->getMetricFromSNMPAsync(%s): cannot send request (%s)"), m_name, metric, SnmpGetErrorText(rc));
+   return rc == SNMP_ERR_SUCCESS;
+}
+
 /**
  * Read one row for SNMP table
  */
@@ -9016,7 +9182,7 @@ DataCollectionError Node::getTableFromSNMP(uint16_t port, SNMP_Version version,
    bool agentNotFound = false;
    SNMP_Transport *snmp = ((snmpAgentName != nullptr) && (*snmpAgentName != 0)) ?
       createSnmpTransportForAgent(snmpAgentName, &agentNotFound) :
-      createSnmpTransport(port, version, ContextToUtf8(context, contextUtf8, sizeof(contextUtf8)));
+      acquireSnmpTransport(port, version, ContextToUtf8(context, contextUtf8, sizeof(contextUtf8)));
    if (snmp == nullptr)
       return agentNotFound ? DCE_NOT_SUPPORTED : DCE_COMM_ERROR;
 
@@ -9050,7 +9216,7 @@ DataCollectionError Node::getTableFromSNMP(uint16_t port, SNMP_Version version,
          }
       }
    }
-   delete snmp;
+   releaseSnmpTransport(snmp);
    return DCErrorFromSNMPError(rc);
 }
 
@@ -9075,13 +9241,13 @@ DataCollectionError Node::getListFromSNMP(uint16_t port, SNMP_Version version, c
    bool agentNotFound = false;
    SNMP_Transport *snmp = ((snmpAgentName != nullptr) && (*snmpAgentName != 0)) ?
       createSnmpTransportForAgent(snmpAgentName, &agentNotFound) :
-      createSnmpTransport(port, version, ContextToUtf8(context, contextUtf8, sizeof(contextUtf8)));
+      acquireSnmpTransport(port, version, ContextToUtf8(context, contextUtf8, sizeof(contextUtf8)));
    if (snmp == nullptr)
       return agentNotFound ? DCE_NOT_SUPPORTED : DCE_COMM_ERROR;
 
    *list = new StringList;
    uint32_t rc = SnmpWalk(snmp, oid, SNMPGetListCallback, *list);
-   delete snmp;
+   releaseSnmpTransport(snmp);
    if (rc != SNMP_ERR_SUCCESS)
    {
       delete *list;
@@ -9100,7 +9266,7 @@ DataCollectionError Node::getOIDSuffixListFromSNMP(uint16_t port, SNMP_Version v
    bool agentNotFound = false;
    SNMP_Transport *snmp = ((snmpAgentName != nullptr) && (*snmpAgentName != 0)) ?
       createSnmpTransportForAgent(snmpAgentName, &agentNotFound) :
-      createSnmpTransport(port, version, ContextToUtf8(context, contextUtf8, sizeof(contextUtf8)));
+      acquireSnmpTransport(port, version, ContextToUtf8(context, contextUtf8, sizeof(contextUtf8)));
    if (snmp == nullptr)
       return agentNotFound ? DCE_NOT_SUPPORTED : DCE_COMM_ERROR;
 
@@ -9108,7 +9274,7 @@ DataCollectionError Node::getOIDSuffixListFromSNMP(uint16_t port, SNMP_Version v
    size_t baseOidLen = SnmpParseOID(baseOid, baseOidBin, 256);
    if (baseOidLen == 0)
    {
-      delete snmp;
+      releaseSnmpTransport(snmp);
       return DCE_NOT_SUPPORTED;
    }
 
@@ -9130,7 +9296,7 @@ DataCollectionError Node::getOIDSuffixListFromSNMP(uint16_t port, SNMP_Version v
          oidSuffixes->set(key, (value[0] != 0) ? value : key);
          return SNMP_ERR_SUCCESS;
       });
-   delete snmp;
+   releaseSnmpTransport(snmp);
    if (rc == SNMP_ERR_SUCCESS)
    {
       *values = oidSuffixes;
@@ -10825,6 +10991,8 @@ uint32_t Node::modifyFromMessageInternal(const NXCPMessage& msg, ClientSession *
 
       if (m_snmpVersion == SNMP_VERSION_3)
          m_snmpSecurity->recalculateKeys();
+
+      invalidateSnmpTransportPool();
    }
 
    // Change SNMP trap credentials
@@ -11088,6 +11256,7 @@ static const struct
 {
    { "disableAgent",            NF_DISABLE_NXCP },
    { "disableSNMP",             NF_DISABLE_SNMP },
+   { "disableSNMPGetBulk",      NF_DISABLE_SNMP_GETBULK },
    { "disableICMP",             NF_DISABLE_ICMP },
    { "disableSSH",              NF_DISABLE_SSH },
    { "disableVNC",              NF_DISABLE_VNC },
@@ -12686,11 +12855,11 @@ shared_ptr<RoutingTable> Node::readRoutingTable()
    }
    if ((routingTable == nullptr) && (m_capabilities & NC_IS_SNMP) && (!(m_flags & NF_DISABLE_SNMP)))
    {
-      SNMP_Transport *snmp = createSnmpTransport();
+      SNMP_Transport *snmp = acquireSnmpTransport();
       if (snmp != nullptr)
       {
          routingTable = SnmpGetRoutingTable(snmp, *this);
-         delete snmp;
+         releaseSnmpTransport(snmp);
       }
    }
 
@@ -13222,6 +13391,10 @@ SNMP_Transport *Node::createSnmpTransport(uint16_t port, SNMP_Version version, c
       {
          transport->setCodepage(g_snmpCodepage);
       }
+      if ((g_snmpBulkWalkMaxRepetitions > 0) && !(m_flags & NF_DISABLE_SNMP_GETBULK))
+      {
+         transport->enableBulkWalk(g_snmpBulkWalkMaxRepetitions);
+      }
 
       if (context == nullptr)
       {
@@ -13389,6 +13562,226 @@ SNMP_Transport *Node::createSnmpTransportForAgent(const wchar_t *agentName, bool
    return transport;
 }
 
+/**
+ * Maximum number of idle SNMP transports kept in node's transport pool
+ */
+#define MAX_IDLE_SNMP_TRANSPORTS 4
+
+/**
+ * Update FNV-1a hash with given data
+ */
+static inline uint64_t UpdateTransportKeyHash(uint64_t hash, const void *data, size_t size)
+{
+   const BYTE *p = static_cast<const BYTE*>(data);
+   for(size_t i = 0; i < size; i++)
+   {
+      hash ^= p[i];
+      hash *= 0x100000001B3ULL;
+   }
+   return hash;
+}
+
+/**
+ * Update FNV-1a hash with given string (including terminating zero)
+ */
+static inline uint64_t UpdateTransportKeyHash(uint64_t hash, const char *s)
+{
+   return UpdateTransportKeyHash(hash, s, strlen(s) + 1);
+}
+
+/**
+ * Calculate key for SNMP transport pool. Key covers all node settings which affect transport configuration,
+ * so any change of address, port, version, credentials, or codepage makes previously pooled transports unusable.
+ */
+uint64_t Node::getSnmpTransportPoolKey(uint16_t port, SNMP_Version version, const char *context)
+{
+   uint64_t key = 0xCBF29CE484222325ULL;
+
+   lockProperties();
+   uint16_t effectivePort = (port != 0) ? port : m_snmpPort;
+   SNMP_Version effectiveVersion = (version != SNMP_VERSION_DEFAULT) ? version : m_snmpVersion;
+   key = UpdateTransportKeyHash(key, &effectivePort, sizeof(effectivePort));
+   key = UpdateTransportKeyHash(key, &effectiveVersion, sizeof(effectiveVersion));
+   key = UpdateTransportKeyHash(key, CHECK_NULL_EX_A(context));
+   char addr[64];
+   key = UpdateTransportKeyHash(key, m_ipAddress.toStringA(addr));
+   SNMP_SecurityModel securityModel = m_snmpSecurity->getSecurityModel();
+   key = UpdateTransportKeyHash(key, &securityModel, sizeof(securityModel));
+   key = UpdateTransportKeyHash(key, m_snmpSecurity->getCommunity());
+   key = UpdateTransportKeyHash(key, m_snmpSecurity->getUserName());
+   key = UpdateTransportKeyHash(key, m_snmpSecurity->getAuthPassword());
+   key = UpdateTransportKeyHash(key, m_snmpSecurity->getPrivPassword());
+   SNMP_AuthMethod authMethod = m_snmpSecurity->getAuthMethod();
+   key = UpdateTransportKeyHash(key, &authMethod, sizeof(authMethod));
+   SNMP_EncryptionMethod privMethod = m_snmpSecurity->getPrivMethod();
+   key = UpdateTransportKeyHash(key, &privMethod, sizeof(privMethod));
+   key = UpdateTransportKeyHash(key, m_snmpCodepage);
+   bool bulkWalkDisabled = (m_flags & NF_DISABLE_SNMP_GETBULK) != 0;
+   key = UpdateTransportKeyHash(key, &bulkWalkDisabled, sizeof(bulkWalkDisabled));
+   unlockProperties();
+
+   key = UpdateTransportKeyHash(key, g_snmpCodepage);
+   key = UpdateTransportKeyHash(key, &g_snmpBulkWalkMaxRepetitions, sizeof(g_snmpBulkWalkMaxRepetitions));
+   return key;
+}
+
+/**
+ * Acquire SNMP transport from node's transport pool. Idle transport with matching configuration is reused
+ * if available (keeping open socket and cached SNMPv3 engine data and localized keys), otherwise new transport
+ * is created. Transport acquired by this method should be returned by calling releaseSnmpTransport().
+ * Only direct (not proxied) transports are pooled.
+ */
+SNMP_Transport *Node::acquireSnmpTransport(uint16_t port, SNMP_Version version, const char *context, bool pollerMessageOnFailure, uint32_t *proxyNodeId, bool *proxyConnectionFailed)
+{
+   if ((g_snmpTransportPoolIdleTimeout == 0) || (getEffectiveSnmpProxy() != 0))
+      return createSnmpTransport(port, version, context, nullptr, pollerMessageOnFailure, proxyNodeId, proxyConnectionFailed);
+
+   if ((m_flags & NF_DISABLE_SNMP) || (m_status == STATUS_UNMANAGED) || (g_flags & AF_SHUTDOWN) || m_isDeleteInitiated ||
+       isPortBlocked((port != 0) ? port : m_snmpPort, false))
+   {
+      // Let createSnmpTransport do all checks and logging
+      return createSnmpTransport(port, version, context, nullptr, pollerMessageOnFailure, proxyNodeId, proxyConnectionFailed);
+   }
+
+   uint64_t key = getSnmpTransportPoolKey(port, version, context);
+   time_t now = time(nullptr);
+   SNMP_Transport *transport = nullptr;
+
+   m_snmpTransportPoolLock.lock();
+   expireIdleSnmpTransportsUnlocked(now);
+   for(int i = 0; i < m_snmpTransportPool.size(); i++)
+   {
+      SNMPTransportPoolEntry *e = m_snmpTransportPool.get(i);
+      if (e->key == key)
+      {
+         transport = e->transport;
+         m_snmpTransportPool.remove(i);
+         break;
+      }
+   }
+   m_snmpTransportPoolLock.unlock();
+
+   if (transport != nullptr)
+   {
+      if (proxyNodeId != nullptr)
+         *proxyNodeId = 0;
+      if (proxyConnectionFailed != nullptr)
+         *proxyConnectionFailed = false;
+   }
+   else
+   {
+      transport = createSnmpTransport(port, version, context, nullptr, pollerMessageOnFailure, proxyNodeId, proxyConnectionFailed);
+      if ((transport == nullptr) || transport->isProxyTransport())
+         return transport;
+   }
+
+   m_snmpTransportPoolLock.lock();
+   SNMPTransportPoolEntry *e = m_snmpTransportsInUse.addPlaceholder();
+   e->transport = transport;
+   e->key = key;
+   e->lastUsed = now;
+   m_snmpTransportPoolLock.unlock();
+   return transport;
+}
+
+/**
+ * Return SNMP transport acquired by acquireSnmpTransport() to node's transport pool. Transports
+ * not created from pool (or invalidated while in use) are destroyed.
+ */
+void Node::releaseSnmpTransport(SNMP_Transport *transport)
+{
+   if (transport == nullptr)
+      return;
+
+   time_t now = time(nullptr);
+   m_snmpTransportPoolLock.lock();
+   expireIdleSnmpTransportsUnlocked(now);
+   for(int i = 0; i < m_snmpTransportsInUse.size(); i++)
+   {
+      SNMPTransportPoolEntry *e = m_snmpTransportsInUse.get(i);
+      if (e->transport == transport)
+      {
+         if ((m_snmpTransportPool.size() < MAX_IDLE_SNMP_TRANSPORTS) && (g_snmpTransportPoolIdleTimeout != 0) && !m_isDeleteInitiated && !(g_flags & AF_SHUTDOWN))
+         {
+            e->lastUsed = now;
+            m_snmpTransportPool.add(e);
+            transport = nullptr;
+         }
+         m_snmpTransportsInUse.remove(i);
+         break;
+      }
+   }
+   m_snmpTransportPoolLock.unlock();
+
+   delete transport;
+}
+
+/**
+ * Destroy idle SNMP transports which were not used for longer than configured idle timeout.
+ * Transport pool lock must be held by caller.
+ */
+void Node::expireIdleSnmpTransportsUnlocked(time_t now)
+{
+   for(int i = 0; i < m_snmpTransportPool.size(); i++)
+   {
+      SNMPTransportPoolEntry *e = m_snmpTransportPool.get(i);
+      if (now - e->lastUsed >= static_cast<time_t>(g_snmpTransportPoolIdleTimeout))
+      {
+         delete e->transport;
+         m_snmpTransportPool.remove(i);
+         i--;
+      }
+   }
+}
+
+/**
+ * Destroy idle SNMP transports which were not used for longer than configured idle timeout
+ */
+void Node::expireIdleSnmpTransports(time_t now)
+{
+   m_snmpTransportPoolLock.lock();
+   expireIdleSnmpTransportsUnlocked(now);
+   m_snmpTransportPoolLock.unlock();
+}
+
+/**
+ * Interval between checks for idle SNMP transports (milliseconds)
+ */
+#define SNMP_TRANSPORT_EXPIRATION_INTERVAL   60000
+
+/**
+ * Periodically destroy idle pooled SNMP transports on all nodes, so that sockets are closed
+ * even for nodes which do not make SNMP requests anymore
+ */
+void ExpireIdleSnmpTransports()
+{
+   if (g_flags & AF_SHUTDOWN)
+      return;
+
+   time_t now = time(nullptr);
+   g_idxNodeById.forEach(
+      [now] (NetObj *node) -> EnumerationCallbackResult
+      {
+         static_cast<Node*>(node)->expireIdleSnmpTransports(now);
+         return _CONTINUE;
+      });
+
+   ThreadPoolScheduleRelative(g_mainThreadPool, SNMP_TRANSPORT_EXPIRATION_INTERVAL, ExpireIdleSnmpTransports);
+}
+
+/**
+ * Destroy all idle SNMP transports in node's pool. Transports currently in use will be destroyed when released.
+ */
+void Node::invalidateSnmpTransportPool()
+{
+   m_snmpTransportPoolLock.lock();
+   for(int i = 0; i < m_snmpTransportPool.size(); i++)
+      delete m_snmpTransportPool.get(i)->transport;
+   m_snmpTransportPool.clear();
+   m_snmpTransportsInUse.clear();
+   m_snmpTransportPoolLock.unlock();
+}
+
 /**
  * Get SNMP security context
  * ATTENTION: This method returns new copy of security context
@@ -13843,12 +14236,12 @@ void Node::topologyPoll(PollerInfo *poller, ClientSession *pSession, uint32_t rq
    if (isSNMPSupported())
    {
       poller->setStatus(_T("reading VLANs"));
-      SNMP_Transport *snmp = createSnmpTransportForPoller();
+      SNMP_Transport *snmp = acquireSnmpTransportForPoller();
       if (snmp != nullptr)
       {
          NodeDeviceContext context(self(), snmp);
          VlanList *vlanList = m_driver->getVlans(&context, this, m_driverData);
-         delete snmp;
+         releaseSnmpTransport(snmp);
 
          m_topologyMutex.lock();
          if (vlanList != nullptr)
@@ -13886,7 +14279,7 @@ void Node::topologyPoll(PollerInfo *poller, ClientSession *pSession, uint32_t rq
 
       shared_ptr<ForwardingDatabase> fdb;
 
-      SNMP_Transport *snmp = createSnmpTransport();
+      SNMP_Transport *snmp = acquireSnmpTransport();
       if (snmp != nullptr)
       {
          NodeDeviceContext context(self(), snmp);
@@ -13920,7 +14313,7 @@ void Node::topologyPoll(PollerInfo *poller, ClientSession *pSession, uint32_t rq
             sendPollerMsg(POLLER_WARNING _T("Failed to get switch forwarding database\r\n"));
          }
 
-         delete snmp;
+         releaseSnmpTransport(snmp);
       }
    }
    else
@@ -14072,12 +14465,12 @@ void Node::topologyPoll(PollerInfo *poller, ClientSession *pSession, uint32_t rq
    if (m_capabilities & (NC_IS_WIFI_CONTROLLER | NC_IS_WIFI_AP))
    {
       poller->setStatus(_T("reading wireless stations"));
-      SNMP_Transport *snmp = createSnmpTransport();
+      SNMP_Transport *snmp = acquireSnmpTransport();
       if (snmp != nullptr)
       {
          NodeDeviceContext context(self(), snmp);
          ObjectArray<WirelessStationInfo> *stations = m_driver->getWirelessStations(&context, this, m_driverData);
-         delete snmp;
+         releaseSnmpTransport(snmp);
          if (stations != nullptr)
          {
             sendPollerMsg(_T("   %d wireless stations found\r\n"), stations->size());
@@ -15468,7 +15861,7 @@ AccessPointState Node::getAccessPointState(AccessPoint *ap, SNMP_Transport *snmp
  */
 ObjectArray<AccessPointInfo> *Node::getAccessPoints()
 {
-   SNMP_Transport *snmp = createSnmpTransport();
+   SNMP_Transport *snmp = acquireSnmpTransport();
    if (snmp == nullptr)
       return nullptr;
    NodeDeviceContext context(self(), snmp);
@@ -15478,7 +15871,7 @@ ObjectArray<AccessPointInfo> *Node::getAccessPoints()
       for(AccessPointInfo *ap : *accessPoints)
          ap->setControllerId(m_id);
    }
-   delete snmp;
+   releaseSnmpTransport(snmp);
    return accessPoints;
 }
 
@@ -37,12 +37,16 @@ void LoadObjectCategories()
    if (hResult != nullptr)
    {
       int count = DBGetNumRows(hResult);
+      IntegerArray<uint64_t> keys(count);
+      SharedObjectArray<ObjectCategory> categories(count);
       for(int i = 0; i < count; i++)
       {
          auto category = make_shared<ObjectCategory>(hResult, i);
-         s_objectCategories.put(category->getId(), category);
+         keys.add(category->getId());
+         categories.add(category);
       }
       DBFreeResult(hResult);
+      s_objectCategories.putAll(keys, categories);
    }
    DBConnectionPoolReleaseConnection(hdb);
 }
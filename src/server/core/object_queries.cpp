@@ -350,12 +350,16 @@ void LoadObjectQueries()
    if (hResult != nullptr)
    {
       int count = DBGetNumRows(hResult);
+      IntegerArray<uint64_t> keys(count);
+      SharedObjectArray<ObjectQuery> queries(count);
       for(int i = 0; i < count; i++)
       {
          auto query = make_shared<ObjectQuery>(hdb, hResult, i);
-         s_objectQueries.put(query->getId(), query);
+         keys.add(query->getId());
+         queries.add(query);
       }
       DBFreeResult(hResult);
+      s_objectQueries.putAll(keys, queries);
    }
 
    DBConnectionPoolReleaseConnection(hdb);
@@ -55,7 +55,7 @@ ObjectQueue<TemplateUpdateTask> g_templateUpdateQueue(256, Ownership::True);
 ObjectIndex g_idxObjectById;
 HashIndex<uuid> g_idxObjectByGUID;
 ObjectIndex g_idxSubnetById;
-InetAddressIndex g_idxSubnetByAddr;
+InetAddressIndex g_idxSubnetByAddr(true);
 InetAddressIndex g_idxInterfaceByAddr;
 ObjectIndex g_idxZoneByUIN;
 ObjectIndex g_idxNodeById;
@@ -320,6 +320,7 @@ void NetObjInsert(const shared_ptr<NetObj>& object, bool newObject, bool importe
             break;
          case OBJECT_NODE:
 				g_idxNodeById.put(object->getId(), object);
+            UpdateNodeAttributeIndexes(static_cast<Node&>(*object));
             if (!(static_cast<Node&>(*object).getFlags() & NF_EXTERNAL_GATEWAY))
             {
 			      if (IsZoningEnabled())
@@ -477,6 +478,11 @@ void NetObjInsert(const shared_ptr<NetObj>& object, bool newObject, bool importe
    }
 }
 
+/**
+ * Remove node from secondary node indexes
+ */
+static void RemoveNodeFromAttributeIndexes(uint32_t nodeId);
+
 /**
  * Delete object from indexes
  * If object has an IP address, this function will delete it from
@@ -511,6 +517,7 @@ void NetObjDeleteFromIndexes(const NetObj& object)
 			break;
       case OBJECT_NODE:
 			g_idxNodeById.remove(object.getId());
+         RemoveNodeFromAttributeIndexes(object.getId());
          if (!(static_cast<const Node&>(object).getFlags() & NF_EXTERNAL_GATEWAY))
          {
 			   if (IsZoningEnabled())
@@ -922,6 +929,136 @@ shared_ptr<Interface> NXCORE_EXPORTABLE FindInterfaceByDescription(const TCHAR *
 	return static_pointer_cast<Interface>(g_idxObjectById.find(DescriptionComparator, (void *)description));
 }
 
+/**
+ * Secondary node index by attribute value. Multiple nodes can share same value.
+ */
+class NodeAttributeIndex
+{
+private:
+   StringObjectMap<IntegerArray<uint32_t>> m_nodes;   // Attribute value -> node identifiers (sorted)
+   HashMap<uint32_t, String> m_values;                // Node identifier -> indexed attribute value
+   RWLock m_lock;
+
+public:
+   NodeAttributeIndex() : m_nodes(Ownership::True), m_values(Ownership::True) { }
+
+   void update(uint32_t nodeId, const TCHAR *value);
+   void remove(uint32_t nodeId) { update(nodeId, nullptr); }
+   IntegerArray<uint32_t> get(const TCHAR *value) const;
+};
+
+/**
+ * Update indexed attribute value for given node. Null or empty value removes node from index.
+ */
+void NodeAttributeIndex::update(uint32_t nodeId, const TCHAR *value)
+{
+   if ((value != nullptr) && (*value == 0))
+      value = nullptr;
+
+   m_lock.writeLock();
+   String *oldValue = m_values.get(nodeId);
+   if ((oldValue != nullptr) && (value != nullptr) && !_tcscmp(oldValue->cstr(), value))
+   {
+      m_lock.unlock();
+      return;
+   }
+
+   if (oldValue != nullptr)
+   {
+      IntegerArray<uint32_t> *nodes = m_nodes.get(oldValue->cstr());
+      if (nodes != nullptr)
+      {
+         nodes->remove(nodes->indexOf(nodeId));
+         if (nodes->isEmpty())
+            m_nodes.remove(oldValue->cstr());
+      }
+      m_values.remove(nodeId);
+   }
+
+   if (value != nullptr)
+   {
+      IntegerArray<uint32_t> *nodes = m_nodes.get(value);
+      if (nodes == nullptr)
+      {
+         nodes = new IntegerArray<uint32_t>(1, 4);
+         m_nodes.set(value, nodes);
+      }
+      nodes->add(nodeId);
+      nodes->sortAscending();
+      m_values.set(nodeId, new String(value));
+   }
+   m_lock.unlock();
+}
+
+/**
+ * Get identifiers of nodes with given attribute value (in ascending order)
+ */
+IntegerArray<uint32_t> NodeAttributeIndex::get(const TCHAR *value) const
+{
+   m_lock.readLock();
+   IntegerArray<uint32_t> *nodes = m_nodes.get(value);
+   IntegerArray<uint32_t> result = (nodes != nullptr) ? IntegerArray<uint32_t>(*nodes) : IntegerArray<uint32_t>();
+   m_lock.unlock();
+   return result;
+}
+
+/**
+ * Secondary node indexes
+ */
+static NodeAttributeIndex s_nodeIndexBySysName;
+static NodeAttributeIndex s_nodeIndexByLLDPId;
+static NodeAttributeIndex s_nodeIndexByBridgeId;
+static NodeAttributeIndex s_nodeIndexByAgentId;
+static NodeAttributeIndex s_nodeIndexByHardwareId;
+
+/**
+ * Update secondary node indexes (by sysName, LLDP ID, bridge ID, agent ID, and hardware ID).
+ * Should be called when node is added to indexes and after any of indexed attributes is changed.
+ */
+void UpdateNodeAttributeIndexes(const Node& node)
+{
+   uint32_t id = node.getId();
+   s_nodeIndexBySysName.update(id, node.getSysName());
+   s_nodeIndexByLLDPId.update(id, node.getLLDPNodeId());
+   s_nodeIndexByBridgeId.update(id, (node.isBridge() && node.getBridgeId().isValid()) ? node.getBridgeId().toString().cstr() : nullptr);
+
+   TCHAR buffer[64];
+   s_nodeIndexByAgentId.update(id, !node.getAgentId().isNull() ? node.getAgentId().toString(buffer) : nullptr);
+   s_nodeIndexByHardwareId.update(id, !node.getHardwareId().isNull() ? node.getHardwareId().toString().cstr() : nullptr);
+}
+
+/**
+ * Remove node from secondary node indexes
+ */
+static void RemoveNodeFromAttributeIndexes(uint32_t nodeId)
+{
+   s_nodeIndexBySysName.remove(nodeId);
+   s_nodeIndexByLLDPId.remove(nodeId);
+   s_nodeIndexByBridgeId.remove(nodeId);
+   s_nodeIndexByAgentId.remove(nodeId);
+   s_nodeIndexByHardwareId.remove(nodeId);
+}
+
+/**
+ * Find nodes using secondary index. Candidates are checked with comparator to filter out
+ * entries not yet updated after attribute change.
+ *
+ * @param maxCount stop after finding given number of matching nodes
+ */
+template<typename C> static SharedObjectArray<Node> FindNodesByAttribute(const NodeAttributeIndex& index, const TCHAR *value,
+         bool (*comparator)(NetObj*, C*), C *context, int maxCount)
+{
+   SharedObjectArray<Node> nodes;
+   IntegerArray<uint32_t> candidates = index.get(value);
+   for(int i = 0; (i < candidates.size()) && (nodes.size() < maxCount); i++)
+   {
+      shared_ptr<NetObj> object = g_idxNodeById.get(candidates.get(i));
+      if ((object != nullptr) && comparator(object.get(), context))
+         nodes.add(static_pointer_cast<Node>(object));
+   }
+   return nodes;
+}
+
 /**
  * LLDP ID comparator
  */
@@ -936,7 +1073,10 @@ static bool LldpIdComparator(NetObj *object, const TCHAR *lldpId)
  */
 shared_ptr<Node> NXCORE_EXPORTABLE FindNodeByLLDPId(const TCHAR *lldpId)
 {
-	return static_pointer_cast<Node>(g_idxNodeById.find(LldpIdComparator, lldpId));
+   if ((lldpId == nullptr) || (lldpId[0] == 0))
+      return shared_ptr<Node>();
+   SharedObjectArray<Node> nodes = FindNodesByAttribute(s_nodeIndexByLLDPId, lldpId, LldpIdComparator, lldpId, 1);
+   return !nodes.isEmpty() ? nodes.getShared(0) : shared_ptr<Node>();
 }
 
 /**
@@ -957,9 +1097,8 @@ shared_ptr<Node> NXCORE_EXPORTABLE FindNodeBySysName(const TCHAR *sysName)
       return shared_ptr<Node>();
 
    // return nullptr if multiple nodes with same sysName found
-   unique_ptr<SharedObjectArray<NetObj>> objects = g_idxNodeById.findAll(SysNameComparator, sysName);
-   shared_ptr<Node> node = (objects->size() == 1) ? static_pointer_cast<Node>(objects->getShared(0)) : shared_ptr<Node>();
-   return node;
+   SharedObjectArray<Node> nodes = FindNodesByAttribute(s_nodeIndexBySysName, sysName, SysNameComparator, sysName, 2);
+   return (nodes.size() == 1) ? nodes.getShared(0) : shared_ptr<Node>();
 }
 
 /**
@@ -975,7 +1114,8 @@ static bool BridgeIdComparator(NetObj *object, const BYTE *bridgeId)
  */
 shared_ptr<Node> NXCORE_EXPORTABLE FindNodeByBridgeId(const BYTE *bridgeId)
 {
-	return static_pointer_cast<Node>(g_idxNodeById.find(BridgeIdComparator, bridgeId));
+   SharedObjectArray<Node> nodes = FindNodesByAttribute(s_nodeIndexByBridgeId, MacAddress(bridgeId, 6).toString().cstr(), BridgeIdComparator, bridgeId, 1);
+   return !nodes.isEmpty() ? nodes.getShared(0) : shared_ptr<Node>();
 }
 
 /**
@@ -993,7 +1133,9 @@ shared_ptr<Node> NXCORE_EXPORTABLE FindNodeByAgentId(const uuid& agentId)
 {
    if (agentId.isNull())
       return shared_ptr<Node>();
-   return static_pointer_cast<Node>(g_idxNodeById.find(AgentIdComparator, &agentId));
+   TCHAR buffer[64];
+   SharedObjectArray<Node> nodes = FindNodesByAttribute(s_nodeIndexByAgentId, agentId.toString(buffer), AgentIdComparator, &agentId, 1);
+   return !nodes.isEmpty() ? nodes.getShared(0) : shared_ptr<Node>();
 }
 
 /**
@@ -1011,7 +1153,8 @@ shared_ptr<Node> NXCORE_EXPORTABLE FindNodeByHardwareId(const NodeHardwareId& ha
 {
    if (hardwareId.isNull())
       return shared_ptr<Node>();
-   return static_pointer_cast<Node>(g_idxNodeById.find(HardwareIdComparator, &hardwareId));
+   SharedObjectArray<Node> nodes = FindNodesByAttribute(s_nodeIndexByHardwareId, hardwareId.toString().cstr(), HardwareIdComparator, &hardwareId, 1);
+   return !nodes.isEmpty() ? nodes.getShared(0) : shared_ptr<Node>();
 }
 
 /**
@@ -1039,59 +1182,27 @@ shared_ptr<Subnet> NXCORE_EXPORTABLE FindSubnetByIP(int32_t zoneUIN, const InetA
 }
 
 /**
- * Subnet matching data
- */
-struct SubnetMatchingData
-{
-   InetAddress ipAddr; // IP address to find subnet for
-   int maskLen;        // Current match mask length
-   shared_ptr<Subnet> subnet;     // search result
-
-   SubnetMatchingData(const InetAddress& _ipAddr) : ipAddr(_ipAddr)
-   {
-      maskLen = -1;
-   }
-};
-
-/**
- * Subnet matching callback
- */
-static void SubnetMatchCallback(const InetAddress& addr, NetObj *object, void *context)
-{
-   SubnetMatchingData *data = static_cast<SubnetMatchingData*>(context);
-   if (static_cast<Subnet*>(object)->getIpAddress().contains(data->ipAddr))
-   {
-      int maskLen = static_cast<Subnet*>(object)->getIpAddress().getMaskBits();
-      if (maskLen > data->maskLen)
-      {
-         data->maskLen = maskLen;
-         data->subnet = static_cast<Subnet*>(object)->self();
-      }
-   }
-}
-
-/**
- * Find subnet for given IP address
+ * Find subnet for given IP address (subnet with longest prefix containing given address)
  */
 shared_ptr<Subnet> NXCORE_EXPORTABLE FindSubnetForNode(int32_t zoneUIN, const InetAddress& nodeAddr)
 {
    if (!nodeAddr.isValidUnicast())
       return shared_ptr<Subnet>();
 
-   SubnetMatchingData matchData(nodeAddr);
+   shared_ptr<Subnet> subnet;
    if (IsZoningEnabled())
    {
       shared_ptr<Zone> zone = FindZoneByUIN(zoneUIN);
       if (zone != nullptr)
       {
-         zone->forEachSubnet(SubnetMatchCallback, &matchData);
+         subnet = zone->findSubnetForAddress(nodeAddr);
       }
    }
    else
    {
-      g_idxSubnetByAddr.forEach(SubnetMatchCallback, &matchData);
+      subnet = static_pointer_cast<Subnet>(g_idxSubnetByAddr.findLongestPrefixMatch(nodeAddr));
    }
-   return matchData.subnet;
+   return subnet;
 }
 
 /**
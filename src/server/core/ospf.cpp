@@ -225,7 +225,7 @@ bool CollectOSPFInformation(Node *node, StructArray<OSPFArea> *areas, StructArra
    TCHAR debugPrefix[256];
    _sntprintf(debugPrefix, 256, _T("CollectOSPFInformation(%s [%u]):"), node->getName(), node->getId());
 
-   SNMP_Transport *snmp = node->createSnmpTransport();
+   SNMP_Transport *snmp = node->acquireSnmpTransport();
    if (snmp == nullptr)
    {
       nxlog_debug_tag(DEBUG_TAG, 5, _T("%s cannot create SNMP transport"), debugPrefix);
@@ -290,7 +290,7 @@ bool CollectOSPFInformation(Node *node, StructArray<OSPFArea> *areas, StructArra
       }
    }
 
-   delete snmp;
+   node->releaseSnmpTransport(snmp);
 
    if (!success)
       return false;
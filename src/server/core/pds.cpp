@@ -26,6 +26,11 @@
 
 #define MAX_PDS_DRIVERS		8
 
+/**
+ * Maximum number of samples passed to driver in single batch
+ */
+#define MAX_PDS_BATCH_SIZE    1000
+
 #define DEBUG_TAG L"pdsdrv"
 
 /**
@@ -44,6 +49,58 @@ wchar_t *g_pdsLoadList = nullptr;
 static int s_numDrivers = 0;
 static PerfDataStorageDriver *s_drivers[MAX_PDS_DRIVERS];
 
+/**
+ * Queued storage request. Holds private copy of data collection object so that drivers
+ * can access it from writer thread without locking original object.
+ */
+struct PerfDataStorageQueueEntry
+{
+   DCObject *dci;
+   Timestamp timestamp;
+   Timestamp startTimestamp;
+   wchar_t *value;
+   shared_ptr<Table> table;
+
+   PerfDataStorageQueueEntry(DCItem *_dci, Timestamp _timestamp, Timestamp _startTimestamp, const wchar_t *_value) :
+            timestamp(_timestamp), startTimestamp(_startTimestamp)
+   {
+      dci = _dci;
+      value = MemCopyStringW(_value);
+   }
+
+   PerfDataStorageQueueEntry(DCTable *_dci, Timestamp _timestamp, const shared_ptr<Table>& _table) :
+            timestamp(_timestamp), startTimestamp(Timestamp::fromMilliseconds(0)), table(_table)
+   {
+      dci = _dci;
+      value = nullptr;
+   }
+
+   ~PerfDataStorageQueueEntry()
+   {
+      delete dci;
+      MemFree(value);
+   }
+};
+
+/**
+ * Storage request queue and writer thread
+ */
+static ObjectQueue<PerfDataStorageQueueEntry> s_writerQueue(1024, Ownership::True);
+static THREAD s_writerThread = INVALID_THREAD_HANDLE;
+
+/**
+ * Maximum size of writer queue (0 for unlimited). When queue is full new requests are dropped.
+ */
+uint32_t g_pdsMaxQueueSize = 100000;
+
+/**
+ * Writer queue overflow state and number of dropped requests
+ */
+static bool s_queueOverflow = false;
+static VolatileCounter64 s_droppedRequests = 0;
+
+static void StartWriterThread();
+
 /**
  * Register performance data storage driver provided by server module. Driver will be initialized
  * with server configuration; on success ownership of driver instance passes to the core. On failure
@@ -69,6 +126,7 @@ bool NXCORE_EXPORTABLE RegisterPerfDataStorageDriver(PerfDataStorageDriver *driv
    s_drivers[s_numDrivers] = driver;
    s_numDrivers++;
    g_flags |= AF_PERFDATA_STORAGE_DRIVER_LOADED;
+   StartWriterThread();
    nxlog_write_tag(NXLOG_INFO, DEBUG_TAG, L"Performance data storage driver %s registered", driver->getName());
    return true;
 }
@@ -134,6 +192,59 @@ bool PerfDataStorageDriver::saveDCTableValue(DCTable *dcObject, Timestamp timest
    return false;
 }
 
+/**
+ * Save batch of DCI values. Default implementation calls saveDCItemValue for each sample.
+ * Returns true if all samples were accepted by driver.
+ */
+bool PerfDataStorageDriver::saveDCItemValues(const PerfDataItemSample *samples, size_t count)
+{
+   bool success = true;
+   for(size_t i = 0; i < count; i++)
+   {
+      const PerfDataItemSample& s = samples[i];
+      if (!saveDCItemValue(s.dci, s.timestamp, s.startTimestamp, s.value))
+         success = false;
+   }
+   return success;
+}
+
+/**
+ * Save batch of table values. Default implementation calls saveDCTableValue for each sample.
+ * Returns true if all samples were accepted by driver.
+ */
+bool PerfDataStorageDriver::saveDCTableValues(const PerfDataTableSample *samples, size_t count)
+{
+   bool success = true;
+   for(size_t i = 0; i < count; i++)
+   {
+      const PerfDataTableSample& s = samples[i];
+      if (!saveDCTableValue(s.dci, s.timestamp, s.value))
+         success = false;
+   }
+   return success;
+}
+
+/**
+ * Get driver capabilities (combination of PDSDRV_CAP_xxx flags). Default implementation returns 0.
+ */
+uint32_t PerfDataStorageDriver::getCapabilities()
+{
+   return 0;
+}
+
+/**
+ * Read DCI values for given time range, newest first (null from or to timestamp means that range is open on
+ * that side). If bucketSize is 0, raw values should be returned, otherwise values should be aggregated into
+ * buckets of given size (in milliseconds) using given function. At most maxRows data points should be returned.
+ * Only called if driver declares PDSDRV_CAP_READ capability. Should return false if request cannot be served,
+ * in that case values will be read from database.
+ */
+bool PerfDataStorageDriver::readDCItemValues(const DCItem& dci, Timestamp from, Timestamp to, int64_t bucketSize,
+         DciAggregationFunction function, uint32_t maxRows, StructArray<PerfDataPoint> *values)
+{
+   return false;
+}
+
 /**
  * Get internal metric
  */
@@ -142,24 +253,171 @@ DataCollectionError PerfDataStorageDriver::getInternalMetric(const TCHAR *metric
    return DCE_NOT_SUPPORTED;
 }
 
+/**
+ * Pass collected batch to all drivers
+ */
+static void FlushBatch(StructArray<PerfDataItemSample> *items, StructArray<PerfDataTableSample> *tables)
+{
+   for(int i = 0; i < s_numDrivers; i++)
+   {
+      if (!items->isEmpty())
+         s_drivers[i]->saveDCItemValues(items->getBuffer(), items->size());
+      if (!tables->isEmpty())
+         s_drivers[i]->saveDCTableValues(tables->getBuffer(), tables->size());
+   }
+}
+
+/**
+ * Writer thread - takes storage requests from queue and passes them to drivers in batches
+ */
+static void WriterThread()
+{
+   ThreadSetName("PDSWriter");
+   nxlog_debug_tag(DEBUG_TAG, 1, L"Performance data storage writer started");
+
+   ObjectArray<PerfDataStorageQueueEntry> batch(MAX_PDS_BATCH_SIZE, 1024, Ownership::True);
+   StructArray<PerfDataItemSample> items(MAX_PDS_BATCH_SIZE, 1024);
+   StructArray<PerfDataTableSample> tables(64, 64);
+   while(true)
+   {
+      PerfDataStorageQueueEntry *rq = s_writerQueue.getOrBlock();
+      if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
+         break;
+
+      batch.add(rq);
+      while(batch.size() < MAX_PDS_BATCH_SIZE)
+      {
+         rq = s_writerQueue.getOrBlock(500);
+         if ((rq == nullptr) || (rq == INVALID_POINTER_VALUE))
+            break;
+         batch.add(rq);
+      }
+
+      for(int i = 0; i < batch.size(); i++)
+      {
+         PerfDataStorageQueueEntry *e = batch.get(i);
+         if (e->dci->getType() == DCO_TYPE_ITEM)
+         {
+            PerfDataItemSample *s = items.addPlaceholder();
+            s->dci = static_cast<DCItem*>(e->dci);
+            s->timestamp = e->timestamp;
+            s->startTimestamp = e->startTimestamp;
+            s->value = e->value;
+         }
+         else
+         {
+            PerfDataTableSample *s = tables.addPlaceholder();
+            s->dci = static_cast<DCTable*>(e->dci);
+            s->timestamp = e->timestamp;
+            s->value = e->table.get();
+         }
+      }
+      FlushBatch(&items, &tables);
+      items.clear();
+      tables.clear();
+      batch.clear();
+
+      if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
+         break;
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 1, L"Performance data storage writer stopped");
+}
+
+/**
+ * Start writer thread if not started yet
+ */
+static void StartWriterThread()
+{
+   if (s_writerThread == INVALID_THREAD_HANDLE)
+      s_writerThread = ThreadCreateEx(WriterThread);
+}
+
+/**
+ * Check writer queue size before accepting new storage request. Requests are dropped while queue is full,
+ * so that slow or unavailable driver cannot exhaust server memory with queued DCI copies.
+ */
+static bool CheckWriterQueueSize()
+{
+   uint32_t maxQueueSize = g_pdsMaxQueueSize;
+   if ((maxQueueSize > 0) && (s_writerQueue.size() >= maxQueueSize))
+   {
+      InterlockedIncrement64(&s_droppedRequests);
+      if (!s_queueOverflow)
+      {
+         s_queueOverflow = true;
+         nxlog_write_tag(NXLOG_WARNING, DEBUG_TAG,
+            L"Performance data storage writer queue size exceeds threshold (size=%u, max=%u), new values will not be passed to drivers",
+            static_cast<uint32_t>(s_writerQueue.size()), maxQueueSize);
+      }
+      return false;
+   }
+
+   if (s_queueOverflow)
+   {
+      s_queueOverflow = false;
+      nxlog_write_tag(NXLOG_INFO, DEBUG_TAG, L"Performance data storage writer queue size is below threshold (" INT64_FMT L" requests dropped so far)",
+         static_cast<int64_t>(s_droppedRequests));
+   }
+   return true;
+}
+
 /**
  * Storage request. startTimestamp is the timestamp of the previous collected value (the start of the
  * interval this value covers); it is null on the first sample. Drivers that export interval-based
- * metrics (e.g. OTLP delta sums) use it as the metric start time; others may ignore it.
+ * metrics (e.g. OTLP delta sums) use it as the metric start time; others may ignore it. Request is
+ * queued with copy of DCI and passed to drivers asynchronously, so caller may hold DCI lock.
  */
 void PerfDataStorageRequest(DCItem *dci, Timestamp timestamp, Timestamp startTimestamp, const wchar_t *value)
 {
-   for(int i = 0; i < s_numDrivers; i++)
-      s_drivers[i]->saveDCItemValue(dci, timestamp, startTimestamp, value);
+   if (CheckWriterQueueSize())
+      s_writerQueue.put(new PerfDataStorageQueueEntry(new DCItem(dci, false, false), timestamp, startTimestamp, value));
+}
+
+/**
+ * Storage request. Request is queued with copy of DCI and passed to drivers asynchronously.
+ */
+void PerfDataStorageRequest(DCTable *dci, Timestamp timestamp, const shared_ptr<Table>& value)
+{
+   if (CheckWriterQueueSize())
+      s_writerQueue.put(new PerfDataStorageQueueEntry(new DCTable(dci, false), timestamp, value));
+}
+
+/**
+ * Get size of performance data storage writer queue
+ */
+int64_t GetPerfDataStorageQueueSize()
+{
+   return s_writerQueue.size();
 }
 
 /**
- * Storage request
+ * Get number of storage requests dropped because of writer queue overflow
  */
-void PerfDataStorageRequest(DCTable *dci, Timestamp timestamp, Table *value)
+int64_t GetPerfDataStorageDroppedRequestCount()
+{
+   return s_droppedRequests;
+}
+
+/**
+ * Read DCI values from first driver which declares read capability. Returns false if there are
+ * no such drivers or driver cannot serve request.
+ */
+bool ReadDCItemValuesFromPerfDataStorage(const DCItem& dci, Timestamp from, Timestamp to, int64_t bucketSize,
+         DciAggregationFunction function, uint32_t maxRows, StructArray<PerfDataPoint> *values)
 {
    for(int i = 0; i < s_numDrivers; i++)
-      s_drivers[i]->saveDCTableValue(dci, timestamp, value);
+   {
+      if (!(s_drivers[i]->getCapabilities() & PDSDRV_CAP_READ))
+         continue;
+      if (s_drivers[i]->readDCItemValues(dci, from, to, bucketSize, function, maxRows, values))
+      {
+         nxlog_debug_tag(DEBUG_TAG, 7, L"Read request for DCI [%u] served by driver %s (%d data points)", dci.getId(), s_drivers[i]->getName(), values->size());
+         return true;
+      }
+      values->clear();
+   }
+   return false;
 }
 
 /**
@@ -278,7 +536,10 @@ void LoadPerfDataStorageDrivers()
       LoadDriver(curr);
    }
    if (s_numDrivers > 0)
+   {
       g_flags |= AF_PERFDATA_STORAGE_DRIVER_LOADED;
+      StartWriterThread();
+   }
    nxlog_debug_tag(DEBUG_TAG, 1, L"%d performance data storage drivers active", s_numDrivers);
 }
 
@@ -287,6 +548,13 @@ void LoadPerfDataStorageDrivers()
  */
 void ShutdownPerfDataStorageDrivers()
 {
+   if (s_writerThread != INVALID_THREAD_HANDLE)
+   {
+      s_writerQueue.put(INVALID_POINTER_VALUE);
+      ThreadJoin(s_writerThread);
+      s_writerThread = INVALID_THREAD_HANDLE;
+   }
+
    for(int i = 0; i < s_numDrivers; i++)
    {
       nxlog_debug_tag(DEBUG_TAG, 2, L"Executing shutdown handler for driver %s", s_drivers[i]->getName());
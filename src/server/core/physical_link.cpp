@@ -258,12 +258,16 @@ bool LoadPhysicalLinks()
    }
 
    int count = DBGetNumRows(result);
+   IntegerArray<uint64_t> keys(count);
+   SharedObjectArray<PhysicalLink> links(count);
    for(int i = 0; i < count; i++)
    {
       auto link = make_shared<PhysicalLink>(result, i);
-      s_physicalLinks.put(link->getId(), link);
+      keys.add(link->getId());
+      links.add(link);
    }
    DBFreeResult(result);
+   s_physicalLinks.putAll(keys, links);
 
    DBConnectionPoolReleaseConnection(hdb);
    return true;
@@ -538,18 +542,19 @@ static bool FindPLinksForDeletionCallback2(PhysicalLink *link, std::pair<UINT32,
 void DeleteObjectFromPhysicalLinks(uint32_t id)
 {
    unique_ptr<SharedObjectArray<PhysicalLink>> objectsForDeletion = s_physicalLinks.findAll(FindPLinksForDeletionCallback, &id);
+   if (objectsForDeletion->isEmpty())
+      return;
 
-   bool modified = false;
+   IntegerArray<uint64_t> keys(objectsForDeletion->size());
    for(int i = 0; i < objectsForDeletion->size(); i++)
    {
-      shared_ptr<PhysicalLink> link = objectsForDeletion->getShared(i);
-      ThreadPoolExecuteSerialized(g_clientThreadPool, PL_THREAD_KEY, DeletePhysicalLinkFromDB, CAST_TO_POINTER(link->getId(), void*));
-      s_physicalLinks.remove(link->getId());
-      modified = true;
+      uint32_t linkId = objectsForDeletion->get(i)->getId();
+      ThreadPoolExecuteSerialized(g_clientThreadPool, PL_THREAD_KEY, DeletePhysicalLinkFromDB, CAST_TO_POINTER(linkId, void*));
+      keys.add(linkId);
    }
+   s_physicalLinks.removeAll(keys);
 
-   if (modified)
-      NotifyClientSessions(NX_NOTIFY_PHYSICAL_LINK_UPDATE, 0);
+   NotifyClientSessions(NX_NOTIFY_PHYSICAL_LINK_UPDATE, 0);
 }
 
 /**
@@ -560,18 +565,19 @@ void DeletePatchPanelFromPhysicalLinks(uint32_t rackId, uint32_t patchPanelId)
 {
    std::pair<uint32_t, uint32_t> context(rackId, patchPanelId);
    unique_ptr<SharedObjectArray<PhysicalLink>> objectsForDeletion = s_physicalLinks.findAll(FindPLinksForDeletionCallback2, &context);
+   if (objectsForDeletion->isEmpty())
+      return;
 
-   bool modified = false;
+   IntegerArray<uint64_t> keys(objectsForDeletion->size());
    for(int i = 0; i < objectsForDeletion->size(); i++)
    {
-      shared_ptr<PhysicalLink> link = objectsForDeletion->getShared(i);
-      ThreadPoolExecuteSerialized(g_clientThreadPool, PL_THREAD_KEY, DeletePhysicalLinkFromDB, CAST_TO_POINTER(link->getId(), void*));
-      s_physicalLinks.remove(link->getId());
-      modified = true;
+      uint32_t linkId = objectsForDeletion->get(i)->getId();
+      ThreadPoolExecuteSerialized(g_clientThreadPool, PL_THREAD_KEY, DeletePhysicalLinkFromDB, CAST_TO_POINTER(linkId, void*));
+      keys.add(linkId);
    }
+   s_physicalLinks.removeAll(keys);
 
-   if (modified)
-      NotifyClientSessions(NX_NOTIFY_PHYSICAL_LINK_UPDATE, 0);
+   NotifyClientSessions(NX_NOTIFY_PHYSICAL_LINK_UPDATE, 0);
 }
 
 /**
@@ -221,6 +221,297 @@ ScriptVMHandle NXCORE_EXPORTABLE CreateServerScriptVM(const NXSL_Program *script
    return ScriptVMHandle(SetupServerScriptVM(vm, object, dciInfo));
 }
 
+/**
+ * Compiled scripts shared between DCIs, thresholds and instance filters with identical source.
+ * Map holds weak references only - entry is removed by program's deleter when last user releases it.
+ */
+static StringObjectMap<weak_ptr<NXSL_Program>> CreateSharedScriptMap()
+{
+   StringObjectMap<weak_ptr<NXSL_Program>> map(Ownership::True);
+   map.setIgnoreCase(false);
+   return map;
+}
+static StringObjectMap<weak_ptr<NXSL_Program>> s_sharedScripts = CreateSharedScriptMap();
+static Mutex s_sharedScriptsLock(MutexType::FAST);
+
+/**
+ * Deleter for shared compiled scripts
+ */
+struct SharedScriptDeleter
+{
+   String source;
+
+   SharedScriptDeleter(const wchar_t *_source) : source(_source) { }
+
+   void operator()(NXSL_Program *program)
+   {
+      s_sharedScriptsLock.lock();
+      weak_ptr<NXSL_Program> *ref = s_sharedScripts.get(source);
+      if ((ref != nullptr) && ref->expired())
+         s_sharedScripts.remove(source);  // Entry can be already replaced by new program for same source
+      s_sharedScriptsLock.unlock();
+      delete program;
+   }
+};
+
+/**
+ * Compile server script or get already compiled program with same source. Sharing compiled programs lets
+ * DCIs created from same template reuse pooled VMs (see AcquirePooledServerScriptVM). Diagnostic is only
+ * filled if script was actually compiled. Returns null on compilation error.
+ */
+shared_ptr<NXSL_Program> NXCORE_EXPORTABLE CompileSharedServerScript(const wchar_t *source, NXSL_CompilationDiagnostic *diag)
+{
+   s_sharedScriptsLock.lock();
+   weak_ptr<NXSL_Program> *ref = s_sharedScripts.get(source);
+   shared_ptr<NXSL_Program> program = (ref != nullptr) ? ref->lock() : shared_ptr<NXSL_Program>();
+   s_sharedScriptsLock.unlock();
+   if (program != nullptr)
+      return program;
+
+   NXSL_ServerEnv env;
+   NXSL_Program *compiledProgram = NXSLCompile(source, &env, diag);
+   if (compiledProgram == nullptr)
+      return program;
+
+   program = shared_ptr<NXSL_Program>(compiledProgram, SharedScriptDeleter(source));
+   s_sharedScriptsLock.lock();
+   ref = s_sharedScripts.get(source);
+   shared_ptr<NXSL_Program> existing = (ref != nullptr) ? ref->lock() : shared_ptr<NXSL_Program>();
+   if (existing == nullptr)
+      s_sharedScripts.set(source, new weak_ptr<NXSL_Program>(program));
+   s_sharedScriptsLock.unlock();
+
+   // Same script could be compiled concurrently by another thread
+   return (existing != nullptr) ? existing : program;
+}
+
+/**
+ * Get number of distinct shared compiled scripts
+ */
+static inline int GetSharedScriptCount()
+{
+   s_sharedScriptsLock.lock();
+   int count = s_sharedScripts.size();
+   s_sharedScriptsLock.unlock();
+   return count;
+}
+
+/**
+ * Maximum number of idle VMs kept for single script
+ */
+#define MAX_POOLED_VMS_PER_SCRIPT   16
+
+/**
+ * Minimal VM pool size in automatic mode
+ */
+#define MIN_AUTO_VM_POOL_SIZE       256
+
+/**
+ * Idle VMs for single compiled script. Entries are linked into LRU list (most recently used first).
+ */
+struct ScriptVMPoolEntry
+{
+   const NXSL_Program *key;
+   weak_ptr<NXSL_Program> script;
+   ObjectArray<NXSL_VM> vms;
+   ScriptVMPoolEntry *prev;
+   ScriptVMPoolEntry *next;
+
+   ScriptVMPoolEntry() : vms(0, MAX_POOLED_VMS_PER_SCRIPT, Ownership::True)
+   {
+      key = nullptr;
+      prev = this;
+      next = this;
+   }
+
+   ScriptVMPoolEntry(const shared_ptr<NXSL_Program>& _script) : script(_script), vms(0, MAX_POOLED_VMS_PER_SCRIPT, Ownership::True)
+   {
+      key = _script.get();
+      prev = nullptr;
+      next = nullptr;
+   }
+
+   /**
+    * Check if this entry was created for different program object which had same address
+    */
+   bool isStale(const shared_ptr<NXSL_Program>& program) const
+   {
+      return script.owner_before(program) || program.owner_before(script);
+   }
+
+   void unlinkFromList()
+   {
+      prev->next = next;
+      next->prev = prev;
+   }
+
+   void linkAfter(ScriptVMPoolEntry *e)
+   {
+      prev = e;
+      next = e->next;
+      e->next->prev = this;
+      e->next = this;
+   }
+
+   void moveVMs(ObjectArray<NXSL_VM> *target)
+   {
+      target->addAll(vms);
+      vms.setOwner(Ownership::False);
+      vms.clear();
+      vms.setOwner(Ownership::True);
+   }
+};
+
+/**
+ * Script VM pool
+ */
+static HashMap<const NXSL_Program*, ScriptVMPoolEntry> s_vmPool(Ownership::True);
+static ScriptVMPoolEntry s_vmPoolLRU;  // List head
+static Mutex s_vmPoolLock(MutexType::FAST);
+static int s_vmPoolSize = 0;
+static int s_idleVMCount = 0;
+
+/**
+ * Remove entry from VM pool and move its VMs to given list. VM pool lock must be held by caller.
+ */
+static void RemoveVMPoolEntry(ScriptVMPoolEntry *entry, ObjectArray<NXSL_VM> *evicted)
+{
+   s_idleVMCount -= entry->vms.size();
+   entry->moveVMs(evicted);
+   entry->unlinkFromList();
+   const NXSL_Program *key = entry->key;
+   s_vmPool.remove(key);
+}
+
+/**
+ * Initialize script VM pool
+ */
+void InitServerScriptVMPool()
+{
+   s_vmPoolSize = std::max(ConfigReadInt(L"NXSL.VMPoolSize", -1), -1);
+   if (s_vmPoolSize < 0)
+      nxlog_debug_tag(DEBUG_TAG_BASE, 2, L"Script VM pool size set to automatic");
+   else
+      nxlog_debug_tag(DEBUG_TAG_BASE, 2, L"Script VM pool size set to %d", s_vmPoolSize);
+}
+
+/**
+ * Get current VM pool size limit. In automatic mode pool is sized to the working set - two idle VMs
+ * per distinct shared script, but not less than MIN_AUTO_VM_POOL_SIZE. Pool lock must not be held
+ * by caller.
+ */
+static int GetVMPoolLimit()
+{
+   return (s_vmPoolSize >= 0) ? s_vmPoolSize : std::max(GetSharedScriptCount() * 2, MIN_AUTO_VM_POOL_SIZE);
+}
+
+/**
+ * Destroy all idle VMs in script VM pool
+ */
+void ShutdownServerScriptVMPool()
+{
+   s_vmPoolLock.lock();
+   s_vmPoolSize = 0;
+   s_vmPool.clear();
+   s_vmPoolLRU.prev = &s_vmPoolLRU;
+   s_vmPoolLRU.next = &s_vmPoolLRU;
+   s_idleVMCount = 0;
+   s_vmPoolLock.unlock();
+}
+
+/**
+ * Get NXSL VM for compiled script from pool of idle VMs or create new one if pool is empty. VM should be
+ * returned to pool by calling ReleasePooledServerScriptVM. Caller must keep reference to script while VM is in use.
+ */
+ScriptVMHandle NXCORE_EXPORTABLE AcquirePooledServerScriptVM(const shared_ptr<NXSL_Program>& script, const shared_ptr<NetObj>& object, const shared_ptr<DCObjectInfo>& dciInfo)
+{
+   if (script->isEmpty())
+      return ScriptVMHandle(ScriptVMFailureReason::SCRIPT_IS_EMPTY);
+
+   NXSL_VM *vm = nullptr;
+   s_vmPoolLock.lock();
+   ScriptVMPoolEntry *entry = s_vmPool.get(script.get());
+   if ((entry != nullptr) && !entry->vms.isEmpty() && !entry->isStale(script))
+   {
+      vm = entry->vms.last();
+      entry->vms.unlink(entry->vms.size() - 1);
+      s_idleVMCount--;
+   }
+   s_vmPoolLock.unlock();
+
+   if (vm == nullptr)
+   {
+      vm = new NXSL_VM(new NXSL_ServerEnv());
+      if (!vm->load(script.get()))
+      {
+         delete vm;
+         return ScriptVMHandle(ScriptVMFailureReason::SCRIPT_LOAD_ERROR);
+      }
+   }
+
+   return ScriptVMHandle(SetupServerScriptVM(vm, object, dciInfo));
+}
+
+/**
+ * Return VM obtained by AcquirePooledServerScriptVM to pool. VM will be destroyed instead if it was stopped or pool is full.
+ */
+void NXCORE_EXPORTABLE ReleasePooledServerScriptVM(NXSL_VM *vm, const shared_ptr<NXSL_Program>& script)
+{
+   if (vm == nullptr)
+      return;
+
+   if ((s_vmPoolSize == 0) || vm->isStopRequested() || (g_flags & AF_SHUTDOWN))
+   {
+      delete vm;
+      return;
+   }
+
+   vm->reset();
+
+   int poolLimit = GetVMPoolLimit();
+   ObjectArray<NXSL_VM> evicted(0, 64, Ownership::True);
+   s_vmPoolLock.lock();
+
+   ScriptVMPoolEntry *entry = s_vmPool.get(script.get());
+   if ((entry != nullptr) && entry->isStale(script))
+   {
+      // Previous program with same address was destroyed
+      RemoveVMPoolEntry(entry, &evicted);
+      entry = nullptr;
+   }
+
+   if (entry != nullptr)
+   {
+      entry->unlinkFromList();
+   }
+   else
+   {
+      entry = new ScriptVMPoolEntry(script);
+      s_vmPool.set(script.get(), entry);
+   }
+   entry->linkAfter(&s_vmPoolLRU);
+
+   if (entry->vms.size() < MAX_POOLED_VMS_PER_SCRIPT)
+   {
+      entry->vms.add(vm);
+      s_idleVMCount++;
+   }
+   else
+   {
+      evicted.add(vm);
+   }
+
+   // Evict least recently used scripts
+   while((s_idleVMCount > poolLimit) || (s_vmPool.size() > poolLimit))
+   {
+      ScriptVMPoolEntry *victim = s_vmPoolLRU.prev;
+      RemoveVMPoolEntry(victim, &evicted);
+   }
+
+   s_vmPoolLock.unlock();
+   // VMs in "evicted" are destroyed outside lock
+}
+
 /**
  * Compile server script and report error on failure
  */
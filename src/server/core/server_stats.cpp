@@ -23,6 +23,7 @@
 #include "nxcore.h"
 #include <nxcore_discovery.h>
 #include <nxcore_ha.h>
+#include <nxcore_syslog.h>
 #include <gauge_helpers.h>
 #include <nxcore_agent_tunnel.h>
 #include <ncdrv.h>
@@ -50,7 +51,6 @@ struct SnmpTrap;
  */
 extern ObjectQueue<SnmpTrap> g_snmpTrapProcessorQueue;
 extern ObjectQueue<SnmpTrap> g_snmpTrapWriterQueue;
-extern ObjectQueue<SyslogMessage> g_syslogProcessingQueue;
 extern ObjectQueue<SyslogMessage> g_syslogWriteQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventProcessingQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventWriterQueue;
@@ -133,11 +133,12 @@ void ServerStatCollector()
    AddQueueToCollector(_T("EventLogWriter"), GetEventLogWriterQueueSize);
    AddQueueToCollector(_T("EventProcessor"), GetEventProcessorQueueSize);
    AddQueueToCollector(_T("NodeDiscoveryPoller"), GetDiscoveryPollerQueueSize);
+   AddQueueToCollector(_T("PerfDataStorageWriter"), GetPerfDataStorageQueueSize);
    AddQueueToCollector(_T("Poller"), g_pollerThreadPool);
    AddQueueToCollector(_T("Scheduler"), g_schedulerThreadPool);
    AddQueueToCollector(_T("SNMPTrapProcessor"), &g_snmpTrapProcessorQueue);
    AddQueueToCollector(_T("SNMPTrapWriter"), &g_snmpTrapWriterQueue);
-   AddQueueToCollector(_T("SyslogProcessor"), &g_syslogProcessingQueue);
+   AddQueueToCollector(_T("SyslogProcessor"), GetSyslogProcessingQueueSize);
    AddQueueToCollector(_T("SyslogWriter"), &g_syslogWriteQueue);
    AddQueueToCollector(_T("TemplateUpdater"), &g_templateUpdateQueue);
    AddQueueToCollector(_T("WindowsEventProcessor"), &g_windowsEventProcessingQueue);
@@ -550,6 +551,23 @@ DataCollectionError GetLocalManagementServerMetric(const wchar_t *name, wchar_t
          });
       ret_int(buffer, dciCount);
    }
+   else if (MatchString(L"Server.DB.ConnectionPool.AcquireWaits(*)", name, false))
+   {
+      wchar_t arg[64];
+      AgentGetMetricArgW(name, 1, arg, 64);
+      wchar_t *eptr;
+      int bucket = wcstol(arg, &eptr, 10);
+      if ((*eptr == 0) && (bucket >= 0) && (bucket < DB_POOL_WAIT_HISTOGRAM_SIZE))
+      {
+         uint32_t histogram[DB_POOL_WAIT_HISTOGRAM_SIZE];
+         DBConnectionPoolGetWaitTimeHistogram(histogram);
+         IntegerToString(histogram[bucket], buffer);
+      }
+      else
+      {
+         rc = DCE_NOT_SUPPORTED;
+      }
+   }
    else if (!wcsicmp(name, L"Server.DB.Queries.Failed"))
    {
       LIBNXDB_PERF_COUNTERS counters;
@@ -756,6 +774,10 @@ DataCollectionError GetLocalManagementServerMetric(const wchar_t *name, wchar_t
    {
       ret_uint(buffer, static_cast<uint32_t>(g_idxObjectById.size()));
    }
+   else if (!wcsicmp(name, L"Server.PDS.DroppedRequests"))
+   {
+      ret_int64(buffer, GetPerfDataStorageDroppedRequestCount());
+   }
    else if (MatchString(L"Server.PDS.DriverStat(*)", name, false))
    {
       wchar_t driver[64], metric[64];
@@ -29,6 +29,7 @@
 #include <nxcore_websvc.h>
 #include <nxcore_netconf.h>
 #include <nxcore_logs.h>
+#include <pdsdrv.h>
 #include <nxcore_syslog.h>
 #include <nxcore_ps.h>
 #include <nxcore_discovery.h>
@@ -2399,6 +2400,30 @@ void ClientSession::postRawMessageAndDelete(NXCP_MESSAGE *msg)
    ThreadPoolExecuteSerialized(g_clientThreadPool, key, this, &ClientSession::sendRawMessageAndDelete, msg);
 }
 
+/**
+ * Send serialized message shared with other sessions
+ */
+void ClientSession::sendSharedMessage(shared_ptr<NXCP_MESSAGE> msg)
+{
+   sendRawMessage(msg.get());
+   decRefCount();
+}
+
+/**
+ * Post broadcast message in background. Serialized message is shared with other sessions,
+ * only encryption (if enabled) is done individually for this session.
+ */
+void ClientSession::postMessage(ClientBroadcastMessage *msg)
+{
+   if (isTerminated())
+      return;
+
+   TCHAR key[32];
+   _sntprintf(key, 32, _T("POST/%u"), m_id);
+   incRefCount();
+   ThreadPoolExecuteSerialized(g_clientThreadPool, key, this, &ClientSession::sendSharedMessage, msg->get((m_flags & CSF_COMPRESSION_ENABLED) != 0));
+}
+
 /**
  * Send file to client
  */
@@ -5599,6 +5624,60 @@ static void ProcessTieredDataSelectResults(DB_UNBUFFERED_RESULT hResult, ClientS
    MemFree(msg);
 }
 
+/**
+ * Send DCI data points read from performance data storage driver. Wire format matches
+ * corresponding database read path (tier read, on-the-fly aggregation, or raw values).
+ */
+static void SendPerfDataPoints(const StructArray<PerfDataPoint>& values, ClientSession *session, uint32_t requestId,
+         const DCItem& dci, DciTier tier, DciAggregationFunction function, bool aggregated)
+{
+   bool tiered = (tier != DCI_TIER_RAW);
+   bool minmax = aggregated || (tiered && (function == DCI_HAGG_MINMAX));
+   int16_t dataType = (tiered || aggregated) ? DCI_DT_FLOAT : dci.getTransformedDataType();
+
+   ByteStream data(32768);
+   data.writeB(static_cast<int32_t>(values.size()));
+   data.writeB(dataType);
+   data.writeB(static_cast<uint16_t>((minmax ? 0x0002 : 0x0000) | (tiered ? 0x0008 : 0x0000)));   // Options
+
+   for(int i = 0; i < values.size(); i++)
+   {
+      const PerfDataPoint *p = values.get(i);
+      data.writeB(p->timestamp.asMilliseconds());
+      switch(dataType)
+      {
+         case DCI_DT_INT:
+            data.writeB(static_cast<int32_t>(p->value));
+            break;
+         case DCI_DT_UINT:
+         case DCI_DT_COUNTER32:
+            data.writeB(static_cast<uint32_t>(p->value));
+            break;
+         case DCI_DT_INT64:
+            data.writeB(static_cast<int64_t>(p->value));
+            break;
+         case DCI_DT_UINT64:
+         case DCI_DT_COUNTER64:
+            data.writeB(static_cast<uint64_t>(p->value));
+            break;
+         default:
+            data.writeB(p->value);
+            break;
+      }
+      if (minmax)
+      {
+         data.writeB(p->minValue);
+         data.writeB(p->maxValue);
+      }
+      if (tiered)
+         data.writeB(static_cast<int32_t>(p->sampleCount));
+   }
+
+   NXCP_MESSAGE *msg = CreateRawNXCPMessage(CMD_DCI_DATA, requestId, 0, data.buffer(), data.size(), nullptr, session->isCompressionEnabled());
+   session->sendRawMessage(msg);
+   MemFree(msg);
+}
+
 /**
  * Process results from SELECT statement for DCI data
  */
@@ -5740,6 +5819,32 @@ static void ProcessTableDataSelectResults(DB_UNBUFFERED_RESULT hResult, ClientSe
    session->sendMessage(msg);
 }
 
+/**
+ * Fill response to collected data request with DCI information
+ */
+static void FillCollectedDataResponse(NXCPMessage *response, DCObject& dci, DciTier tierUsed)
+{
+   response->setField(VID_RCC, RCC_SUCCESS);
+   if (dci.getType() == DCO_TYPE_ITEM)
+   {
+      DCItem& dciItem = static_cast<DCItem&>(dci);
+      dciItem.fillMessageWithThresholds(response, false);
+      response->setField(VID_CURRENT_SEVERITY, dciItem.getThresholdSeverity());
+      response->setField(VID_UNITS_NAME, dciItem.getUnitName());
+      response->setField(VID_MULTIPLIER, dciItem.getMultiplier());
+      response->setField(VID_USE_MULTIPLIER, dciItem.getUseMultiplier());
+      response->setField(VID_MAPPING_TABLE_ID, dciItem.getMappingTableId());
+   }
+   response->setField(VID_DCI_NAME, dci.getName());
+   response->setField(VID_DESCRIPTION, dci.getDescription());
+   int dataSource = dci.getDataSource();
+   response->setField(VID_POLLING_INTERVAL, ((dataSource != DS_PUSH_AGENT) && (dataSource != DS_OTLP)) ? dci.getEffectivePollingInterval() : 0);
+   response->setField(VID_STORE_CHANGES_ONLY, dci.isStoreChangesOnly());
+   response->setField(VID_DCI_STATUS, static_cast<uint16_t>(dci.getStatus()));
+   response->setField(VID_ERROR_COUNT, dci.getErrorCount());
+   response->setField(VID_DCI_TIER_USED, static_cast<int16_t>(tierUsed));
+}
+
 /**
  * Get collected data for table or simple DCI
  */
@@ -5856,25 +5961,7 @@ bool ClientSession::getCollectedDataFromDB(const NXCPMessage& request, NXCPMessa
 	   }
 
       // Send CMD_REQUEST_COMPLETED message
-      response->setField(VID_RCC, RCC_SUCCESS);
-      if (dciType == DCO_TYPE_ITEM)
-      {
-         DCItem* dciItem = static_cast<DCItem*>(dci.get());
-         dciItem->fillMessageWithThresholds(response, false);
-         response->setField(VID_CURRENT_SEVERITY, dciItem->getThresholdSeverity());
-         response->setField(VID_UNITS_NAME, dciItem->getUnitName());
-         response->setField(VID_MULTIPLIER, dciItem->getMultiplier());
-         response->setField(VID_USE_MULTIPLIER, dciItem->getUseMultiplier());
-         response->setField(VID_MAPPING_TABLE_ID, dciItem->getMappingTableId());
-      }
-      response->setField(VID_DCI_NAME, dci->getName());
-      response->setField(VID_DESCRIPTION, dci->getDescription());
-      int dataSource = dci->getDataSource();
-      response->setField(VID_POLLING_INTERVAL, ((dataSource != DS_PUSH_AGENT) && (dataSource != DS_OTLP)) ? dci->getEffectivePollingInterval() : 0);
-      response->setField(VID_STORE_CHANGES_ONLY, dci->isStoreChangesOnly());
-      response->setField(VID_DCI_STATUS, static_cast<uint16_t>(dci->getStatus()));
-      response->setField(VID_ERROR_COUNT, dci->getErrorCount());
-      response->setField(VID_DCI_TIER_USED, static_cast<int16_t>(DCI_TIER_RAW));
+      FillCollectedDataResponse(response, *dci, DCI_TIER_RAW);
       sendMessage(response);
 
       int16_t dataType;
@@ -5930,6 +6017,29 @@ bool ClientSession::getCollectedDataFromDB(const NXCPMessage& request, NXCPMessa
 	}
 
 read_from_db:
+   // Serve processed values of single value DCIs from performance data storage driver if there is one with read capability
+   if ((dciType == DCO_TYPE_ITEM) && (historicalDataType == HDT_PROCESSED) && (g_flags & AF_PERFDATA_STORAGE_DRIVER_LOADED))
+   {
+      int64_t bucketSizeMs = 0;
+      if (useAggregation)
+      {
+         bucketSizeMs = (timeTo - timeFrom) / maxDataPoints;
+         if (bucketSizeMs < 1)
+            bucketSizeMs = 1;
+      }
+
+      StructArray<PerfDataPoint> values(0, 1024);
+      if (ReadDataFromPerfDataStorage(static_cast<DCItem&>(*dci), resolvedTier, useAggregation ? DCI_HAGG_MINMAX : aggFunction,
+               bucketSizeMs, timeFrom, timeTo, maxRows, &values))
+      {
+         debugPrintf(7, _T("getCollectedDataFromDB: %d data points read from performance data storage driver (tier = %d)"), values.size(), static_cast<int>(resolvedTier));
+         FillCollectedDataResponse(response, *dci, resolvedTier);
+         sendMessage(response);
+         SendPerfDataPoints(values, this, request.getId(), static_cast<DCItem&>(*dci), resolvedTier, aggFunction, useAggregation);
+         return true;
+      }
+   }
+
    debugPrintf(7, _T("getCollectedDataFromDB: will read from database (maxRows = %u, tier = %d)"), maxRows, static_cast<int>(resolvedTier));
 
    TCHAR condition[256] = _T("");
@@ -6008,25 +6118,7 @@ bool ClientSession::getCollectedDataFromDB(const NXCPMessage& request, NXCPMessa
 		if (hResult != nullptr)
 		{
 			// Send CMD_REQUEST_COMPLETED message
-			response->setField(VID_RCC, RCC_SUCCESS);
-	      if (dciType == DCO_TYPE_ITEM)
-	      {
-	         DCItem* dciItem = static_cast<DCItem*>(dci.get());
-	         dciItem->fillMessageWithThresholds(response, false);
-	         response->setField(VID_CURRENT_SEVERITY, dciItem->getThresholdSeverity());
-	         response->setField(VID_UNITS_NAME, dciItem->getUnitName());
-	         response->setField(VID_MULTIPLIER, dciItem->getMultiplier());
-	         response->setField(VID_USE_MULTIPLIER, dciItem->getUseMultiplier());
-	         response->setField(VID_MAPPING_TABLE_ID, dciItem->getMappingTableId());
-	      }
-	      response->setField(VID_DCI_NAME, dci->getName());
-	      response->setField(VID_DESCRIPTION, dci->getDescription());
-	      int dataSource = dci->getDataSource();
-	      response->setField(VID_POLLING_INTERVAL, ((dataSource != DS_PUSH_AGENT) && (dataSource != DS_OTLP)) ? dci->getEffectivePollingInterval() : 0);
-	      response->setField(VID_STORE_CHANGES_ONLY, dci->isStoreChangesOnly());
-	      response->setField(VID_DCI_STATUS, static_cast<uint16_t>(dci->getStatus()));
-	      response->setField(VID_ERROR_COUNT, dci->getErrorCount());
-	      response->setField(VID_DCI_TIER_USED, static_cast<int16_t>(resolvedTier));
+	      FillCollectedDataResponse(response, *dci, resolvedTier);
 	      sendMessage(response);
 
 			if (resolvedTier != DCI_TIER_RAW)
@@ -7410,21 +7502,18 @@ void ClientSession::decommissionNode(const NXCPMessage& request)
 /**
  * Alarm update worker function (executed in thread pool)
  */
-void ClientSession::alarmUpdateWorker(Alarm *alarm)
+void ClientSession::alarmUpdateWorker(shared_ptr<NXCP_MESSAGE> msg)
 {
-   NXCPMessage msg(CMD_ALARM_UPDATE, 0);
-   alarm->fillMessage(&msg);
    m_mutexSendAlarms.lock();
-   sendMessage(msg);
+   sendRawMessage(msg.get());
    m_mutexSendAlarms.unlock();
-   delete alarm;
    decRefCount();
 }
 
 /**
- * Process changes in alarms
+ * Process changes in alarms. Alarm update message is prepared by caller once for all sessions.
  */
-void ClientSession::onAlarmUpdate(UINT32 code, const Alarm *alarm)
+void ClientSession::onAlarmUpdate(const Alarm *alarm, ClientBroadcastMessage *msg)
 {
    if (isAuthenticated() && isSubscribedTo(NXC_CHANNEL_ALARMS))
    {
@@ -7436,7 +7525,7 @@ void ClientSession::onAlarmUpdate(UINT32 code, const Alarm *alarm)
          incRefCount();
          TCHAR key[16];
          _sntprintf(key, 16, _T("ALRM-%d"), m_id);
-         ThreadPoolExecuteSerialized(g_clientThreadPool, key, this, &ClientSession::alarmUpdateWorker, new Alarm(alarm, false, code));
+         ThreadPoolExecuteSerialized(g_clientThreadPool, key, this, &ClientSession::alarmUpdateWorker, msg->get((m_flags & CSF_COMPRESSION_ENABLED) != 0));
       }
    }
 }
@@ -13474,7 +13563,7 @@ void ClientSession::queryServerLog(const NXCPMessage& request)
 	shared_ptr<LogHandle> log = AcquireLogHandleObject(this, handle);
 	if (log != nullptr)
 	{
-		int64_t rowCount;
+		int64_t rowCount = -1;
 		response.setField(VID_RCC, log->query(new LogFilter(request, log.get()), &rowCount, getUserId()) ? RCC_SUCCESS : RCC_DB_FAILURE);
 		response.setField(VID_NUM_ROWS, rowCount);
 		log->release();
@@ -754,3 +754,18 @@ wchar_t NXCORE_EXPORTABLE *FormatSNMPValue(const SNMP_Variable *var, wchar_t *bu
    bool convertToHex = true;
    return var->getValueAsPrintableString(buffer, bufferSize, &convertToHex);
 }
+
+/**
+ * Get value of varbind from GET response formatted with display hint if available. Returns
+ * SNMP_ERR_NO_OBJECT if varbind holds SNMPv2 exception (noSuchObject, noSuchInstance or
+ * endOfMibView) instead of value.
+ */
+uint32_t NXCORE_EXPORTABLE GetSNMPResponseValue(const SNMP_Variable *var, wchar_t *buffer, size_t bufferSize)
+{
+   if ((var->getType() == ASN_NO_SUCH_OBJECT) ||
+       (var->getType() == ASN_NO_SUCH_INSTANCE) ||
+       (var->getType() == ASN_END_OF_MIBVIEW))
+      return SNMP_ERR_NO_OBJECT;
+   FormatSNMPValue(var, buffer, bufferSize);
+   return SNMP_ERR_SUCCESS;
+}
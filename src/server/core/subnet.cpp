@@ -200,7 +200,7 @@ void Subnet::setCorrectMask(const InetAddress& addr)
       _sntprintf(m_name, MAX_OBJECT_NAME, _T("%s/%d"), addr.toString(szBuffer), addr.getMaskBits());
 	}
 
-	bool reAdd = !m_ipAddress.equals(addr);
+	bool reAdd = !m_ipAddress.equals(addr) || (m_ipAddress.getMaskBits() != addr.getMaskBits());
 	InetAddress oldAddress = m_ipAddress;
 
 	m_ipAddress = addr;
@@ -385,24 +385,17 @@ IntegerArray<uint32_t> CheckSubnetOverlap(const InetAddress &addr, int32_t uin)
    {
       auto zone = FindZoneByUIN(uin);
       if (zone != nullptr)
-         subnets = zone->getSubnets();
+         subnets = zone->getOverlappingSubnets(addr);
    }
    else
    {
-      subnets = g_idxSubnetByAddr.getObjects();
+      subnets = g_idxSubnetByAddr.getOverlappingObjects(addr);
    }
 
    if (subnets != nullptr)
    {
       for (int i = 0; i < subnets->size(); i++)
-      {
-         auto subnet = static_cast<Subnet *>(subnets->get(i));
-         auto subnetAddr = subnet->getIpAddress();
-         if (addr.contains(subnetAddr) || subnetAddr.contains(addr))
-         {
-            overlappingSubnet.add(subnet->getId());
-         }
-      }
+         overlappingSubnet.add(subnets->get(i)->getId());
    }
 
    return overlappingSubnet;
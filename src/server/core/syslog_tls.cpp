@@ -48,7 +48,6 @@
 /**
  * Processing queue (syslogd.cpp)
  */
-extern ObjectQueue<SyslogMessage> g_syslogProcessingQueue;
 
 /**
  * Shutdown flag
@@ -383,7 +382,7 @@ bool SyslogTlsSession::processData(const char *data, size_t len)
 void SyslogTlsSession::queueMessage()
 {
    m_frame[m_frameLen] = 0;
-   g_syslogProcessingQueue.put(new SyslogMessage(m_peer, m_frame, m_frameLen));
+   QueueSyslogMessage(new SyslogMessage(m_peer, m_frame, m_frameLen));
    m_frameLen = 0;
 }
 
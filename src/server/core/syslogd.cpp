@@ -27,12 +27,37 @@
 
 #define DEBUG_TAG _T("syslog")
 
+/**
+ * Maximum number of syslog processing threads
+ */
+#define MAX_SYSLOG_PROCESSING_THREADS  32
+
+/**
+ * Number of datagrams read by single receive call
+ */
+#ifdef HAVE_RECVMMSG
+#define SYSLOG_RECEIVE_BATCH_SIZE      64
+#else
+#define SYSLOG_RECEIVE_BATCH_SIZE      1
+#endif
+
+/**
+ * Number of independently locked resolver cache stripes
+ */
+#define RESOLVER_CACHE_STRIPES         16
+
 /**
  * Queues
  */
-ObjectQueue<SyslogMessage> g_syslogProcessingQueue(1024, Ownership::False);
 ObjectQueue<SyslogMessage> g_syslogWriteQueue(1024, Ownership::False);
 
+/**
+ * Processing queues (one per processing thread). Messages queued before syslog server start go to first queue.
+ */
+static ObjectQueue<SyslogMessage> s_processingQueues[MAX_SYSLOG_PROCESSING_THREADS];
+static THREAD s_processingThreads[MAX_SYSLOG_PROCESSING_THREADS];
+static int s_processingThreadCount = 1;
+
 /**
  * Total number of received syslog messages
  */
@@ -47,15 +72,127 @@ enum NodeMatchingPolicy
    HOSTNAME_THEN_SOURCE_IP = 1
 };
 
+/**
+ * Syslog parser instance. Parser is cloned for each processing thread. Messages are matched by
+ * instance selected by node ID, so per-object rule state (counters, absence detection) is always
+ * kept within same instance regardless of processing thread.
+ */
+struct SyslogParserInstance
+{
+   LogParser *parser;
+   Mutex lock;
+
+   SyslogParserInstance() : lock(MutexType::FAST)
+   {
+      parser = nullptr;
+   }
+};
+
+/**
+ * Host name resolver cache entry
+ */
+struct ResolverCacheEntry
+{
+   uint32_t nodeId;  // 0 for negative cache entry
+   time_t timestamp;
+};
+
+/**
+ * Host name resolver cache. Split into independently locked stripes so that processing threads
+ * do not contend on single lock.
+ */
+class ResolverCache
+{
+private:
+   struct Stripe
+   {
+      Mutex lock;
+      StringObjectMap<ResolverCacheEntry> entries;
+
+      Stripe() : lock(MutexType::FAST), entries(Ownership::True) { }
+   };
+
+   Stripe m_stripes[RESOLVER_CACHE_STRIPES];
+
+   Stripe& stripe(const wchar_t *name)
+   {
+      uint32_t hash = 5381;
+      for(const wchar_t *p = name; *p != 0; p++)
+         hash = hash * 33 + static_cast<uint32_t>(*p);
+      return m_stripes[hash % RESOLVER_CACHE_STRIPES];
+   }
+
+public:
+   bool get(const wchar_t *name, int ttl, uint32_t *nodeId);
+   void put(const wchar_t *name, uint32_t nodeId);
+   void clear();
+};
+
+/**
+ * Get cached node ID for given host name. Expired entries are removed.
+ */
+bool ResolverCache::get(const wchar_t *name, int ttl, uint32_t *nodeId)
+{
+   Stripe& s = stripe(name);
+   bool found = false;
+   s.lock.lock();
+   ResolverCacheEntry *entry = s.entries.get(name);
+   if (entry != nullptr)
+   {
+      if (time(nullptr) - entry->timestamp < ttl)
+      {
+         *nodeId = entry->nodeId;
+         found = true;
+      }
+      else
+      {
+         s.entries.remove(name);
+      }
+   }
+   s.lock.unlock();
+   return found;
+}
+
+/**
+ * Put resolved node ID for given host name into cache
+ */
+void ResolverCache::put(const wchar_t *name, uint32_t nodeId)
+{
+   Stripe& s = stripe(name);
+   s.lock.lock();
+   ResolverCacheEntry *entry = s.entries.get(name);
+   if (entry == nullptr)
+   {
+      entry = new ResolverCacheEntry;
+      s.entries.set(name, entry);
+   }
+   entry->nodeId = nodeId;
+   entry->timestamp = time(nullptr);
+   s.lock.unlock();
+}
+
+/**
+ * Remove all entries from cache
+ */
+void ResolverCache::clear()
+{
+   for(int i = 0; i < RESOLVER_CACHE_STRIPES; i++)
+   {
+      m_stripes[i].lock.lock();
+      m_stripes[i].entries.clear();
+      m_stripes[i].lock.unlock();
+   }
+}
+
 /**
  * Static data
  */
-static uint64_t s_msgId = 1;  // Next available message ID
-static LogParser *s_parser = nullptr;
-static Mutex s_parserLock(MutexType::FAST);
+static VolatileCounter64 s_msgId = 1;  // Next available message ID
+static SyslogParserInstance s_parsers[MAX_SYSLOG_PROCESSING_THREADS];
+static int s_parserCount = 1;
+static Mutex s_parserUpdateLock(MutexType::FAST);
 static NodeMatchingPolicy s_nodeMatchingPolicy = SOURCE_IP_THEN_HOSTNAME;
 static THREAD s_receiverThread = INVALID_THREAD_HANDLE;
-static THREAD s_processingThread = INVALID_THREAD_HANDLE;
 static THREAD s_writerThread = INVALID_THREAD_HANDLE;
 static int s_absenceSaveCounter = 0;
 static bool s_running = true;
@@ -65,8 +202,7 @@ static bool s_allowUnknownSources = false;
 static bool s_parseUnknownSources = false;
 static char s_syslogCodepage[16] = "";
 static int s_resolverCacheTTL = 300;
-static bool s_invalidateResolverCache = false;
-static std::unordered_map<std::string, std::pair<uint32_t, time_t>> s_resolverCache;
+static ResolverCache s_resolverCache;
 
 /**
  * Parse timestamp field
@@ -594,33 +730,22 @@ static shared_ptr<Node> FindNodeByHostname(const char *hostName, int32_t zoneUIN
    if (hostName[0] == 0)
       return shared_ptr<Node>();
 
+   wchar_t wname[MAX_OBJECT_NAME];
+   mb_to_wchar(hostName, -1, wname, MAX_OBJECT_NAME);
+   wname[MAX_OBJECT_NAME - 1] = 0;
+
    // Check resolver cache
-   if (s_invalidateResolverCache)
-   {
-      s_resolverCache.clear();
-      s_invalidateResolverCache = false;
-      nxlog_debug_tag(DEBUG_TAG, 5, _T("Resolver cache invalidated"));
-   }
-   else if (s_resolverCacheTTL > 0)
+   int cacheTTL = s_resolverCacheTTL;
+   uint32_t cachedNodeId;
+   if ((cacheTTL > 0) && s_resolverCache.get(wname, cacheTTL, &cachedNodeId))
    {
-      auto it = s_resolverCache.find(hostName);
-      if (it != s_resolverCache.end())
-      {
-         if (time(nullptr) - it->second.second < s_resolverCacheTTL)
-         {
-            nxlog_debug_tag(DEBUG_TAG, 8, _T("Resolver cache hit for \"%hs\" → node ID %u"), hostName, it->second.first);
-            if (it->second.first != 0)
-               return static_pointer_cast<Node>(FindObjectById(it->second.first, OBJECT_NODE));
-            return shared_ptr<Node>();
-         }
-         s_resolverCache.erase(it);
-      }
+      nxlog_debug_tag(DEBUG_TAG, 8, _T("Resolver cache hit for \"%hs\" → node ID %u"), hostName, cachedNodeId);
+      if (cachedNodeId != 0)
+         return static_pointer_cast<Node>(FindObjectById(cachedNodeId, OBJECT_NODE));
+      return shared_ptr<Node>();
    }
 
    // Try fast in-memory name lookup first (no network I/O)
-   wchar_t wname[MAX_OBJECT_NAME];
-   mb_to_wchar(hostName, -1, wname, MAX_OBJECT_NAME);
-   wname[MAX_OBJECT_NAME - 1] = 0;
    shared_ptr<Node> node = static_pointer_cast<Node>(FindObjectByName(wname, OBJECT_NODE));
 
    // Fall back to DNS resolution
@@ -635,9 +760,9 @@ static shared_ptr<Node> FindNodeByHostname(const char *hostName, int32_t zoneUIN
    }
 
    // Cache the result (node ID 0 = negative cache)
-   if (s_resolverCacheTTL > 0)
+   if (cacheTTL > 0)
    {
-      s_resolverCache[std::string(hostName)] = std::make_pair((node != nullptr) ? node->getId() : 0, time(nullptr));
+      s_resolverCache.put(wname, (node != nullptr) ? node->getId() : 0);
    }
 
    return node;
@@ -777,6 +902,26 @@ static void SyslogWriterThread()
    nxlog_debug_tag(DEBUG_TAG, 1, _T("Syslog writer thread stopped"));
 }
 
+/**
+ * Calculate hash of message source address used for distributing messages between processing threads
+ */
+static uint32_t HashSourceAddress(const InetAddress& addr)
+{
+   uint32_t hash;
+   if (addr.getFamily() == AF_INET)
+   {
+      hash = addr.getAddressV4();
+   }
+   else
+   {
+      hash = 0;
+      const BYTE *a = addr.getAddressV6();
+      for(int i = 0; i < 16; i++)
+         hash = hash * 31 + a[i];
+   }
+   return (hash * 2654435761u) >> 8;
+}
+
 /**
  * Process syslog message
  */
@@ -794,7 +939,7 @@ static void ProcessSyslogMessage(SyslogMessage *msg)
          return;
       }
 
-      msg->setId(s_msgId++);
+      msg->setId(static_cast<uint64_t>(InterlockedIncrement64(&s_msgId) - 1));
       const char *codepage = (s_syslogCodepage[0] != 0) ? s_syslogCodepage : nullptr;
       if (msg->getNodeId() != 0)
       {
@@ -809,14 +954,18 @@ static void ProcessSyslogMessage(SyslogMessage *msg)
 		            msg->getSourceAddress().toString(ipAddr), msg->getZoneUIN(), msg->getNodeId(), msg->getTag(), msg->getProcId(), msg->getMsgId(), msg->getMessage());
 
 		bool writeToDatabase = true;
-		s_parserLock.lock();
-		if (((msg->getNodeId() != 0) || s_parseUnknownSources) && (s_parser != nullptr))
+		if ((msg->getNodeId() != 0) || s_parseUnknownSources)
 		{
 		   wchar_t wtag[MAX_SYSLOG_TAG_LEN];
 			mbcp_to_wchar(msg->getTag(), -1, wtag, MAX_SYSLOG_TAG_LEN, codepage);
-			s_parser->matchEvent(wtag, msg->getFacility(), 1 << msg->getSeverity(), msg->getMessage(), nullptr, 0, msg->getNodeId(), 0, ipAddr, &writeToDatabase);
+			// Parser instance is selected by object ID (messages from unknown sources all go to instance 0),
+			// same as absence detection state is distributed in LoadAbsenceState
+			SyslogParserInstance *instance = &s_parsers[msg->getNodeId() % s_parserCount];
+			instance->lock.lock();
+			if (instance->parser != nullptr)
+			   instance->parser->matchEvent(wtag, msg->getFacility(), 1 << msg->getSeverity(), msg->getMessage(), nullptr, 0, msg->getNodeId(), 0, ipAddr, &writeToDatabase);
+			instance->lock.unlock();
 		}
-		s_parserLock.unlock();
 
       // Send message to all connected clients
       EnumerateClientSessions(BroadcastSyslogMessage, msg);
@@ -843,12 +992,12 @@ static void ProcessSyslogMessage(SyslogMessage *msg)
 /**
  * Syslog processing thread
  */
-static void SyslogProcessingThread()
+static void SyslogProcessingThread(ObjectQueue<SyslogMessage> *queue)
 {
    ThreadSetName("SyslogProcessor");
    while(true)
    {
-      SyslogMessage *msg = g_syslogProcessingQueue.getOrBlock();
+      SyslogMessage *msg = queue->getOrBlock();
       if (msg == INVALID_POINTER_VALUE)
          break;
 
@@ -857,11 +1006,12 @@ static void SyslogProcessingThread()
 }
 
 /**
- * Queue syslog message for processing
+ * Queue syslog message for processing. Messages from same source address are always
+ * processed by same thread, so their order is preserved.
  */
-static void QueueSyslogMessage(char *msg, int msgLen, const InetAddress& sourceAddr)
+void QueueSyslogMessage(SyslogMessage *msg)
 {
-   g_syslogProcessingQueue.put(new SyslogMessage(sourceAddr, msg, msgLen));
+   s_processingQueues[HashSourceAddress(msg->getSourceAddress()) % s_processingThreadCount].put(msg);
 }
 
 /**
@@ -869,7 +1019,18 @@ static void QueueSyslogMessage(char *msg, int msgLen, const InetAddress& sourceA
  */
 void QueueProxiedSyslogMessage(const InetAddress &addr, int32_t zoneUIN, uint32_t nodeId, time_t timestamp, const char *msg, int msgLen)
 {
-   g_syslogProcessingQueue.put(new SyslogMessage(addr, timestamp, zoneUIN, nodeId, msg, msgLen));
+   QueueSyslogMessage(new SyslogMessage(addr, timestamp, zoneUIN, nodeId, msg, msgLen));
+}
+
+/**
+ * Get total number of messages waiting in processing queues
+ */
+int64_t GetSyslogProcessingQueueSize()
+{
+   int64_t size = 0;
+   for(int i = 0; i < MAX_SYSLOG_PROCESSING_THREADS; i++)
+      size += s_processingQueues[i].size();
+   return size;
 }
 
 /**
@@ -901,12 +1062,12 @@ static void SyslogParserCallback(const LogParserCallbackData& data)
 }
 
 /**
- * Save absence detection state to database.
- * Must be called with s_parserLock held.
+ * Save absence detection state of all parser instances to database.
+ * Must be called with s_parserUpdateLock held.
  */
 static void SaveAbsenceState()
 {
-   if (s_parser == nullptr)
+   if (s_parsers[0].parser == nullptr)
       return;
 
    DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
@@ -922,17 +1083,26 @@ static void SaveAbsenceState()
    if (hStmt != nullptr)
    {
       int count = 0;
-      s_parser->forEachAbsenceState(
-         [hStmt, &count] (const uuid& ruleGuid, uint32_t objectId, const AbsenceState *state)
+      for(int i = 0; i < s_parserCount; i++)
+      {
+         SyslogParserInstance *instance = &s_parsers[i];
+         instance->lock.lock();
+         if (instance->parser != nullptr)
          {
-            TCHAR guidStr[64];
-            DBBind(hStmt, 1, DB_SQLTYPE_VARCHAR, ruleGuid.toString(guidStr), DB_BIND_STATIC);
-            DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, objectId);
-            DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(state->lastMatchTime));
-            DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(state->lastAlertTime));
-            DBExecute(hStmt);
-            count++;
-         });
+            instance->parser->forEachAbsenceState(
+               [hStmt, &count] (const uuid& ruleGuid, uint32_t objectId, const AbsenceState *state)
+               {
+                  TCHAR guidStr[64];
+                  DBBind(hStmt, 1, DB_SQLTYPE_VARCHAR, ruleGuid.toString(guidStr), DB_BIND_STATIC);
+                  DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, objectId);
+                  DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(state->lastMatchTime));
+                  DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(state->lastAlertTime));
+                  DBExecute(hStmt);
+                  count++;
+               });
+         }
+         instance->lock.unlock();
+      }
       DBFreeStatement(hStmt);
       nxlog_debug_tag(DEBUG_TAG, 5, L"Saved %d absence state entries to database", count);
    }
@@ -942,14 +1112,11 @@ static void SaveAbsenceState()
 }
 
 /**
- * Load absence detection state from database into parser.
- * Must be called with s_parserLock held and s_parser not null.
+ * Load absence detection state from database into new (not yet published) parser instances.
+ * Each object's state goes to instance responsible for that object.
  */
-static void LoadAbsenceState()
+static void LoadAbsenceState(LogParser **parsers, int count)
 {
-   if (s_parser == nullptr)
-      return;
-
    DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
    if (hdb == nullptr)
       return;
@@ -957,8 +1124,8 @@ static void LoadAbsenceState()
    DB_RESULT hResult = DBSelect(hdb, L"SELECT rule_guid,object_id,last_match_time,last_alert_time FROM lp_absence_state WHERE parser_type='S'");
    if (hResult != nullptr)
    {
-      int count = DBGetNumRows(hResult);
-      for (int i = 0; i < count; i++)
+      int rows = DBGetNumRows(hResult);
+      for (int i = 0; i < rows; i++)
       {
          TCHAR guidStr[64];
          DBGetField(hResult, i, 0, guidStr, 64);
@@ -966,10 +1133,10 @@ static void LoadAbsenceState()
          uint32_t objectId = DBGetFieldULong(hResult, i, 1);
          time_t lastMatchTime = static_cast<time_t>(DBGetFieldULong(hResult, i, 2));
          time_t lastAlertTime = static_cast<time_t>(DBGetFieldULong(hResult, i, 3));
-         s_parser->loadAbsenceState(ruleGuid, objectId, lastMatchTime, lastAlertTime);
+         parsers[objectId % count]->loadAbsenceState(ruleGuid, objectId, lastMatchTime, lastAlertTime);
       }
       DBFreeResult(hResult);
-      nxlog_debug_tag(DEBUG_TAG, 3, L"Loaded %d absence state entries from database", count);
+      nxlog_debug_tag(DEBUG_TAG, 3, L"Loaded %d absence state entries from database", rows);
    }
 
    DBConnectionPoolReleaseConnection(hdb);
@@ -980,9 +1147,9 @@ static void LoadAbsenceState()
  */
 static void CreateParserFromConfig()
 {
-	LockGuard lockGuard(s_parserLock);
-	LogParser *prev = s_parser;
-	s_parser = nullptr;
+	LockGuard lockGuard(s_parserUpdateLock);
+	LogParser *parsers[MAX_SYSLOG_PROCESSING_THREADS];
+	memset(parsers, 0, sizeof(parsers));
    char *xml;
    wchar_t *wxml = ConfigReadCLOB(_T("SyslogParser"), _T("<parser></parser>"));
 	if (wxml != nullptr)
@@ -997,25 +1164,91 @@ static void CreateParserFromConfig()
 	if (xml != nullptr)
 	{
 	   wchar_t parseError[256];
-		ObjectArray<LogParser> *parsers = LogParser::createFromXml(xml, -1, parseError, 256, EventNameResolver);
-		if ((parsers != nullptr) && (parsers->size() > 0))
+		ObjectArray<LogParser> *parserList = LogParser::createFromXml(xml, -1, parseError, 256, EventNameResolver);
+		if ((parserList != nullptr) && (parserList->size() > 0))
 		{
-			s_parser = parsers->get(0);
-			s_parser->setCallback(SyslogParserCallback);
-			if (prev != nullptr)
-			   s_parser->restoreCounters(prev);
-			else
-			   LoadAbsenceState(); // First load - restore from database
-			nxlog_debug_tag(DEBUG_TAG, 3, L"Syslog parser successfully created from config");
+		   parsers[0] = parserList->get(0);
+		   parsers[0]->setCallback(SyslogParserCallback);
+		   for(int i = 1; i < s_parserCount; i++)
+		      parsers[i] = new LogParser(parsers[0]);
+			if (s_parsers[0].parser == nullptr)
+			   LoadAbsenceState(parsers, s_parserCount); // First load - restore from database
+			nxlog_debug_tag(DEBUG_TAG, 3, L"Syslog parser successfully created from config (%d instances)", s_parserCount);
 		}
 		else
 		{
 			nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG, L"Cannot initialize syslog parser (%s)", parseError);
 		}
 		MemFree(xml);
-		delete parsers;
+		delete parserList;
+	}
+
+	for(int i = 0; i < s_parserCount; i++)
+	{
+	   SyslogParserInstance *instance = &s_parsers[i];
+	   instance->lock.lock();
+	   LogParser *prev = instance->parser;
+	   if ((parsers[i] != nullptr) && (prev != nullptr))
+	      parsers[i]->restoreCounters(prev);
+	   instance->parser = parsers[i];
+	   instance->lock.unlock();
+	   delete prev;
 	}
-	delete prev;
+}
+
+/**
+ * Receive buffers for syslog receiver
+ */
+struct SyslogReceiveBuffers
+{
+   char data[SYSLOG_RECEIVE_BATCH_SIZE][MAX_SYSLOG_MSG_LEN + 1];
+   SockAddrBuffer addr[SYSLOG_RECEIVE_BATCH_SIZE];
+#ifdef HAVE_RECVMMSG
+   struct iovec iov[SYSLOG_RECEIVE_BATCH_SIZE];
+   struct mmsghdr headers[SYSLOG_RECEIVE_BATCH_SIZE];
+#endif
+};
+
+/**
+ * Read all pending datagrams (up to receive batch size) from socket and queue them for processing.
+ * Returns false on socket error.
+ */
+static bool ReceiveSyslogMessages(SOCKET s, SyslogReceiveBuffers *buffers)
+{
+#ifdef HAVE_RECVMMSG
+   for(int i = 0; i < SYSLOG_RECEIVE_BATCH_SIZE; i++)
+   {
+      buffers->iov[i].iov_base = buffers->data[i];
+      buffers->iov[i].iov_len = MAX_SYSLOG_MSG_LEN;
+      memset(&buffers->headers[i], 0, sizeof(struct mmsghdr));
+      buffers->headers[i].msg_hdr.msg_iov = &buffers->iov[i];
+      buffers->headers[i].msg_hdr.msg_iovlen = 1;
+      buffers->headers[i].msg_hdr.msg_name = &buffers->addr[i];
+      buffers->headers[i].msg_hdr.msg_namelen = sizeof(SockAddrBuffer);
+   }
+
+   int count = recvmmsg(s, buffers->headers, SYSLOG_RECEIVE_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+   if (count <= 0)
+      return (count == 0) || (errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR);
+
+   for(int i = 0; i < count; i++)
+   {
+      size_t bytes = buffers->headers[i].msg_len;
+      if (bytes == 0)
+         continue;
+      buffers->data[i][bytes] = 0;
+      QueueSyslogMessage(new SyslogMessage(InetAddress::createFromSockaddr(reinterpret_cast<struct sockaddr*>(&buffers->addr[i])), buffers->data[i], bytes));
+   }
+   return true;
+#else
+   socklen_t addrLen = sizeof(SockAddrBuffer);
+   int bytes = recvfrom(s, buffers->data[0], MAX_SYSLOG_MSG_LEN, 0, reinterpret_cast<struct sockaddr*>(&buffers->addr[0]), &addrLen);
+   if (bytes <= 0)
+      return false;
+   buffers->data[0][bytes] = 0;
+   QueueSyslogMessage(new SyslogMessage(InetAddress::createFromSockaddr(reinterpret_cast<struct sockaddr*>(&buffers->addr[0])), buffers->data[0], bytes));
+   return true;
+#endif
 }
 
 /**
@@ -1161,6 +1394,7 @@ static void SyslogReceiver()
 #endif
 
    SocketPoller sp;
+   SyslogReceiveBuffers *buffers = MemAllocStruct<SyslogReceiveBuffers>();
 
    nxlog_debug_tag(DEBUG_TAG, 1, _T("Syslog receiver thread started"));
 
@@ -1178,21 +1412,14 @@ static void SyslogReceiver()
       int rc = sp.poll(1000);
       if (rc > 0)
       {
-         char syslogMessage[MAX_SYSLOG_MSG_LEN + 1];
-         SockAddrBuffer addr;
-         socklen_t addrLen = sizeof(SockAddrBuffer);
+         bool success = true;
+         if ((hSocket != INVALID_SOCKET) && sp.isSet(hSocket))
+            success = ReceiveSyslogMessages(hSocket, buffers);
 #ifdef WITH_IPV6
-         SOCKET s = sp.isSet(hSocket) ? hSocket : hSocket6;
-#else
-         SOCKET s = hSocket;
+         if ((hSocket6 != INVALID_SOCKET) && sp.isSet(hSocket6))
+            success = ReceiveSyslogMessages(hSocket6, buffers) && success;
 #endif
-         int bytes = recvfrom(s, syslogMessage, MAX_SYSLOG_MSG_LEN, 0, (struct sockaddr *)&addr, &addrLen);
-         if (bytes > 0)
-         {
-            syslogMessage[bytes] = 0;
-            QueueSyslogMessage(syslogMessage, bytes, InetAddress::createFromSockaddr((struct sockaddr *)&addr));
-         }
-         else
+         if (!success)
          {
             // Sleep on error
             ThreadSleepMs(100);
@@ -1205,6 +1432,8 @@ static void SyslogReceiver()
       }
    }
 
+   MemFree(buffers);
+
    if (hSocket != INVALID_SOCKET)
       closesocket(hSocket);
 #ifdef WITH_IPV6
@@ -1256,11 +1485,34 @@ void OnSyslogConfigurationChange(const wchar_t *name, const wchar_t *value)
    else if (!wcscmp(name, L"Syslog.ResolverCacheTTL"))
    {
       s_resolverCacheTTL = wcstol(value, nullptr, 0);
-      s_invalidateResolverCache = true;
+      s_resolverCache.clear();
       nxlog_debug_tag(DEBUG_TAG, 4, L"Syslog resolver cache TTL set to %d seconds", s_resolverCacheTTL);
    }
 }
 
+/**
+ * Get rule check or match count. Counters for specific object are taken from parser instance
+ * responsible for that object, total counters are summed over all instances.
+ */
+static int GetRuleCounter(const TCHAR *ruleName, uint32_t objectId, bool matchCount)
+{
+   int first = (objectId != 0) ? objectId % s_parserCount : 0;
+   int last = (objectId != 0) ? first : s_parserCount - 1;
+   int result = 0;
+   for(int i = first; i <= last; i++)
+   {
+      SyslogParserInstance *instance = &s_parsers[i];
+      instance->lock.lock();
+      int count = (instance->parser != nullptr) ?
+               (matchCount ? instance->parser->getRuleMatchCount(ruleName, objectId) : instance->parser->getRuleCheckCount(ruleName, objectId)) : -1;
+      instance->lock.unlock();
+      if (count == -1)
+         return -1;
+      result += count;
+   }
+   return result;
+}
+
 /**
  * Get syslog rule check count in NXSL
  */
@@ -1288,9 +1540,7 @@ int F_GetSyslogRuleCheckCount(int argc, NXSL_Value **argv, NXSL_Value **result,
       }
    }
 
-   s_parserLock.lock();
-   *result = vm->createValue((s_parser != nullptr) ? s_parser->getRuleCheckCount(argv[0]->getValueAsCString(), objectId) : -1);
-   s_parserLock.unlock();
+   *result = vm->createValue(GetRuleCounter(argv[0]->getValueAsCString(), objectId, false));
    return 0;
 }
 
@@ -1318,9 +1568,7 @@ int F_GetSyslogRuleMatchCount(int argc, NXSL_Value **argv, NXSL_Value **result,
       }
    }
 
-   s_parserLock.lock();
-   *result = vm->createValue((s_parser != nullptr) ? s_parser->getRuleMatchCount(argv[0]->getValueAsCString(), objectId) : -1);
-   s_parserLock.unlock();
+   *result = vm->createValue(GetRuleCounter(argv[0]->getValueAsCString(), objectId, true));
    return 0;
 }
 
@@ -1329,7 +1577,7 @@ int F_GetSyslogRuleMatchCount(int argc, NXSL_Value **argv, NXSL_Value **result,
  */
 uint64_t GetNextSyslogId()
 {
-   return s_msgId;
+   return static_cast<uint64_t>(s_msgId);
 }
 
 /**
@@ -1340,10 +1588,17 @@ static void SyslogAbsenceCheckTask()
    if (!s_running)
       return;
 
-   s_parserLock.lock();
-   if (s_parser != nullptr)
+   s_parserUpdateLock.lock();
+   if (s_parsers[0].parser != nullptr)
    {
-      s_parser->checkAbsenceRules(time(nullptr));
+      time_t now = time(nullptr);
+      for(int i = 0; i < s_parserCount; i++)
+      {
+         SyslogParserInstance *instance = &s_parsers[i];
+         instance->lock.lock();
+         instance->parser->checkAbsenceRules(now);
+         instance->lock.unlock();
+      }
 
       // Save state to database every 5 minutes
       s_absenceSaveCounter++;
@@ -1353,7 +1608,7 @@ static void SyslogAbsenceCheckTask()
          s_absenceSaveCounter = 0;
       }
    }
-   s_parserLock.unlock();
+   s_parserUpdateLock.unlock();
 
    if (s_running)
       ThreadPoolScheduleRelative(g_mainThreadPool, 60000, SyslogAbsenceCheckTask);
@@ -1371,10 +1626,12 @@ void StartSyslogServer()
    s_enableStorage = ConfigReadBoolean(_T("Syslog.EnableStorage"), false);
    s_nodeMatchingPolicy = static_cast<NodeMatchingPolicy>(ConfigReadInt(_T("Syslog.NodeMatchingPolicy"), SOURCE_IP_THEN_HOSTNAME));
    s_resolverCacheTTL = ConfigReadInt(_T("Syslog.ResolverCacheTTL"), 300);
+   s_processingThreadCount = std::min(std::max(ConfigReadInt(_T("Syslog.ProcessingThreads"), 1), 1), MAX_SYSLOG_PROCESSING_THREADS);
+   s_parserCount = s_processingThreadCount;
 
    // Determine first available message id
    uint64_t id = ConfigReadUInt64(_T("FirstFreeSyslogId"), s_msgId);
-   if (id > s_msgId)
+   if (id > static_cast<uint64_t>(s_msgId))
       s_msgId = id;
    DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
    DB_RESULT hResult = DBSelect(hdb, _T("SELECT max(msg_id) FROM syslog"));
@@ -1382,7 +1639,7 @@ void StartSyslogServer()
    {
       if (DBGetNumRows(hResult) > 0)
       {
-         s_msgId = std::max(DBGetFieldUInt64(hResult, 0, 0) + 1, s_msgId);
+         s_msgId = std::max(DBGetFieldUInt64(hResult, 0, 0) + 1, static_cast<uint64_t>(s_msgId));
       }
       DBFreeResult(hResult);
    }
@@ -1394,8 +1651,10 @@ void StartSyslogServer()
    // Create message parser
    CreateParserFromConfig();
 
-   // Start processing thread
-   s_processingThread = ThreadCreateEx(SyslogProcessingThread);
+   // Start processing threads
+   for(int i = 0; i < s_processingThreadCount; i++)
+      s_processingThreads[i] = ThreadCreateEx(SyslogProcessingThread, &s_processingQueues[i]);
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("%d syslog processing threads started"), s_processingThreadCount);
    s_writerThread = ThreadCreateEx(SyslogWriterThread);
    ThreadPoolScheduleRelative(g_mainThreadPool, 60000, SyslogAbsenceCheckTask);
 
@@ -1415,20 +1674,26 @@ void StopSyslogServer()
    ThreadJoin(s_receiverThread);
    StopSyslogTlsListener();
 
-   // Stop processing thread
-   g_syslogProcessingQueue.put(INVALID_POINTER_VALUE);
-   ThreadJoin(s_processingThread);
+   // Stop processing threads
+   for(int i = 0; i < s_processingThreadCount; i++)
+      s_processingQueues[i].put(INVALID_POINTER_VALUE);
+   for(int i = 0; i < s_processingThreadCount; i++)
+      ThreadJoin(s_processingThreads[i]);
 
-   // Stop writer thread - it must be done after processing thread already finished
+   // Stop writer thread - it must be done after processing threads already finished
    g_syslogWriteQueue.put(INVALID_POINTER_VALUE);
    ThreadJoin(s_writerThread);
 
    // Save absence state before shutting down
-   s_parserLock.lock();
+   s_parserUpdateLock.lock();
    SaveAbsenceState();
-   s_parserLock.unlock();
+   s_parserUpdateLock.unlock();
 
-   delete s_parser;
+   for(int i = 0; i < s_parserCount; i++)
+   {
+      delete s_parsers[i].parser;
+      s_parsers[i].parser = nullptr;
+   }
    CleanupLogParserLibrary();
 }
 
@@ -1437,10 +1702,10 @@ void StopSyslogServer()
  */
 void GetSyslogEventReferences(uint32_t eventCode, ObjectArray<EventReference>* eventReferences)
 {
-   s_parserLock.lock();
-   if ((s_parser != nullptr) && s_parser->isUsingEvent(eventCode))
+   s_parsers[0].lock.lock();
+   if ((s_parsers[0].parser != nullptr) && s_parsers[0].parser->isUsingEvent(eventCode))
    {
       eventReferences->add(new EventReference(EventReferenceType::SYSLOG));
    }
-   s_parserLock.unlock();
+   s_parsers[0].lock.unlock();
 }
@@ -111,14 +111,14 @@ VrrpInfo *GetVRRPInfo(Node *node)
 	if (!node->isSNMPSupported())
 		return nullptr;
 
-	SNMP_Transport *transport = node->createSnmpTransport();
+	SNMP_Transport *transport = node->acquireSnmpTransport();
 	if (transport == nullptr)
 		return nullptr;
 
 	int32_t version;
 	if (SnmpGetEx(transport, { 1, 3, 6, 1, 2, 1, 68, 1, 1, 0 }, &version, sizeof(int32_t), 0, nullptr) != SNMP_ERR_SUCCESS)
 	{
-		delete transport;
+		node->releaseSnmpTransport(transport);
 		return nullptr;
 	}
 
@@ -129,6 +129,6 @@ VrrpInfo *GetVRRPInfo(Node *node)
 		info = nullptr;
 	}
 
-	delete transport;
+	node->releaseSnmpTransport(transport);
 	return info;
 }
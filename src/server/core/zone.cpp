@@ -40,7 +40,7 @@ Zone::Zone() : super(), Pollable(this, Pollable::STATUS)
    GenerateRandomBytes(m_proxyAuthKey, ZONE_PROXY_KEY_LENGTH);
 	m_idxNodeByAddr = new InetAddressIndex;
 	m_idxInterfaceByAddr = new InetAddressIndex;
-	m_idxSubnetByAddr = new InetAddressIndex;
+	m_idxSubnetByAddr = new InetAddressIndex(true);
    m_lastHealthCheck = TIMESTAMP_NEVER;
    m_lockedForHealthCheck = false;
 }
@@ -56,7 +56,7 @@ Zone::Zone(int32_t uin, const TCHAR *name) : super(), Pollable(this, Pollable::S
    GenerateRandomBytes(m_proxyAuthKey, ZONE_PROXY_KEY_LENGTH);
 	m_idxNodeByAddr = new InetAddressIndex;
 	m_idxInterfaceByAddr = new InetAddressIndex;
-	m_idxSubnetByAddr = new InetAddressIndex;
+	m_idxSubnetByAddr = new InetAddressIndex(true);
    m_lastHealthCheck = TIMESTAMP_NEVER;
    m_lockedForHealthCheck = false;
    setCreationTime();
@@ -260,6 +260,7 @@ uint32_t NXCORE_EXPORTABLE ResolveAlarmById(uint32_t alarmId, GenericClientSessi
 void NXCORE_EXPORTABLE ResolveAlarmsById(const IntegerArray<uint32_t>& alarmIds, IntegerArray<uint32_t> *failIds,
          IntegerArray<uint32_t> *failCodes, GenericClientSession *session, bool terminate, bool includeSubordinates);
 void NXCORE_EXPORTABLE ResolveAlarmByKey(const TCHAR *key, bool useRegexp, bool terminate, Event *event);
+void NXCORE_EXPORTABLE ExtractKeyPatternPrefix(const TCHAR *pattern, TCHAR *prefix);
 void NXCORE_EXPORTABLE ResolveAlarmByDCObjectId(uint32_t dciId, bool terminate);
 uint32_t NXCORE_EXPORTABLE ResolveAlarmByHDRef(const TCHAR *hdref, GenericClientSession *session, bool terminate);
 uint32_t NXCORE_EXPORTABLE ResolveAlarmByHDRef(const TCHAR *hdref);
@@ -525,6 +525,32 @@ class EPPConflict;
  */
 struct LoginInfo;
 
+/**
+ * NXCP message broadcast to multiple client sessions. Message is serialized (and compressed if
+ * requested) only once for each serialization mode, and serialized form is shared between all
+ * receiving sessions. Encryption is applied by each session when message is written to socket.
+ * Instance is not thread safe and should be used within single fan-out pass.
+ */
+class ClientBroadcastMessage
+{
+private:
+   const NXCPMessage& m_message;
+   shared_ptr<NXCP_MESSAGE> m_serialized[2];
+
+public:
+   ClientBroadcastMessage(const NXCPMessage& msg) : m_message(msg) {}
+
+   const NXCPMessage& getMessage() const { return m_message; }
+
+   shared_ptr<NXCP_MESSAGE> get(bool compressed)
+   {
+      shared_ptr<NXCP_MESSAGE>& msg = m_serialized[compressed ? 1 : 0];
+      if (msg == nullptr)
+         msg = shared_ptr<NXCP_MESSAGE>(m_message.serialize(compressed), [] (NXCP_MESSAGE *m) { MemFree(m); });
+      return msg;
+   }
+};
+
 /**
  * Client (user) session
  */
@@ -597,6 +623,7 @@ class NXCORE_EXPORTABLE ClientSession : public GenericClientSession, public TcpP
 
    void postRawMessageAndDelete(NXCP_MESSAGE *msg);
    void sendRawMessageAndDelete(NXCP_MESSAGE *msg);
+   void sendSharedMessage(shared_ptr<NXCP_MESSAGE> msg);
 
    void debugPrintf(int level, const TCHAR *format, ...);
 
@@ -1018,7 +1045,7 @@ class NXCORE_EXPORTABLE ClientSession : public GenericClientSession, public TcpP
    void queryTrafficData(const NXCPMessage& request);
    void getConnectionHistory(const NXCPMessage& request);
 
-   void alarmUpdateWorker(Alarm *alarm);
+   void alarmUpdateWorker(shared_ptr<NXCP_MESSAGE> msg);
    void sendActionDBUpdateMessage(NXCP_MESSAGE *msg);
    void sendObjectUpdates();
 
@@ -1044,6 +1071,7 @@ class NXCORE_EXPORTABLE ClientSession : public GenericClientSession, public TcpP
    {
       postMessage(*msg);
    }
+   void postMessage(ClientBroadcastMessage *msg);
    bool sendMessage(const NXCPMessage& msg);
    bool sendMessage(const NXCPMessage *msg)
    {
@@ -1085,7 +1113,7 @@ class NXCORE_EXPORTABLE ClientSession : public GenericClientSession, public TcpP
    void onNewEvent(Event *pEvent);
    void onSyslogMessage(const SyslogMessage *sm);
    void onObjectChange(const shared_ptr<NetObj>& object, bool accessChange = false);
-   void onAlarmUpdate(UINT32 dwCode, const Alarm *alarm);
+   void onAlarmUpdate(const Alarm *alarm, ClientBroadcastMessage *msg);
    void onActionDBUpdate(UINT32 dwCode, const Action *action);
    void onLibraryImageChange(const uuid& guid, bool removed = false);
    virtual void onTcpProxyData(AgentConnectionEx *conn, uint32_t channelId, const void *data, size_t size, bool errorIndicator) override;
@@ -1379,6 +1407,7 @@ class ImportContext : public StringBuffer
 /**
  * DCI data query functions
  */
+struct PerfDataPoint;
 DB_STATEMENT NXCORE_EXPORTABLE PrepareDataSelect(DB_HANDLE hdb, uint32_t nodeId, int dciType, DCObjectStorageClass storageClass,
          uint32_t maxRows, HistoricalDataType historicalDataType, const TCHAR *condition);
 DB_STATEMENT NXCORE_EXPORTABLE PrepareAggregatedDataSelect(DB_HANDLE hdb, uint32_t nodeId, DCObjectStorageClass storageClass,
@@ -1387,6 +1416,9 @@ DB_STATEMENT NXCORE_EXPORTABLE PrepareTieredDataSelect(DB_HANDLE hdb, uint32_t n
          DciAggregationFunction function, uint32_t maxRows, const wchar_t *condition);
 DciTier NXCORE_EXPORTABLE ResolveDciTier(DciTier requested, const DCObject& dci, int dciType, int64_t timeFrom, int64_t timeTo,
          uint32_t runtimeFlags, int autoSelectThreshold);
+bool NXCORE_EXPORTABLE ReadDataFromPerfDataStorage(const DCItem& dci, DciTier tier, DciAggregationFunction function, int64_t bucketSizeMs,
+         int64_t timeFrom, int64_t timeTo, uint32_t maxRows, StructArray<PerfDataPoint> *values);
+wchar_t NXCORE_EXPORTABLE *FormatPerfDataPointValue(const PerfDataPoint& p, int dataType, wchar_t *buffer);
 
 /**
  * Functions
@@ -1456,7 +1488,11 @@ void OnDBWriterMaxQueueSizeChange();
 void ClearDBWriterData(ServerConsole *console, const TCHAR *component);
 
 void PerfDataStorageRequest(DCItem *dci, Timestamp timestamp, Timestamp startTimestamp, const TCHAR *value);
-void PerfDataStorageRequest(DCTable *dci, Timestamp timestamp, Table *value);
+void PerfDataStorageRequest(DCTable *dci, Timestamp timestamp, const shared_ptr<Table>& value);
+int64_t GetPerfDataStorageQueueSize();
+int64_t GetPerfDataStorageDroppedRequestCount();
+bool ReadDCItemValuesFromPerfDataStorage(const DCItem& dci, Timestamp from, Timestamp to, int64_t bucketSize,
+         DciAggregationFunction function, uint32_t maxRows, StructArray<PerfDataPoint> *values);
 
 bool SnmpTestRequest(SNMP_Transport *snmp, const StringList &testOids, bool separateRequests);
 SNMP_Transport *SnmpCheckCommSettings(uint32_t snmpProxy, const InetAddress& ipAddr, SNMP_Version *version,
@@ -1469,6 +1505,7 @@ void ReloadMIBTree();
 SNMP_MIBObject NXCORE_EXPORTABLE *AcquireMIBTreeReadLock();
 void NXCORE_EXPORTABLE ReleaseMIBTreeReadLock();
 wchar_t NXCORE_EXPORTABLE *FormatSNMPValue(const SNMP_Variable *var, wchar_t *buffer, size_t bufferSize);
+uint32_t NXCORE_EXPORTABLE GetSNMPResponseValue(const SNMP_Variable *var, wchar_t *buffer, size_t bufferSize);
 
 bool SSHCheckConnection(const shared_ptr<Node>& proxyNode, const InetAddress& addr, uint16_t port,
    const TCHAR *login, const TCHAR *password, uint32_t keyId);
@@ -1925,6 +1962,9 @@ extern uint32_t g_requiredPolls;
 extern int64_t g_offlineDataRelevanceTime;
 extern int32_t g_instanceRetentionTime;
 extern SNMP_Version g_snmpMinVersion;
+extern uint32_t g_snmpBulkWalkMaxRepetitions;
+extern uint32_t g_snmpTransportPoolIdleTimeout;
+extern uint32_t g_pdsMaxQueueSize;
 extern uint32_t g_snmpTrapStormCountThreshold;
 extern uint32_t g_snmpTrapStormDurationThreshold;
 extern uint32_t g_pollsBetweenPrimaryIpUpdate;
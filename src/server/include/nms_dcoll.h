@@ -30,6 +30,12 @@ class ImportContext;
  */
 #define MAX_NPE_NAME_LEN            16
 
+/**
+ * Interval (in seconds) for re-checking data collection objects which cannot be polled
+ * because of state that can change without data collection configuration change
+ */
+#define DC_STATE_RECHECK_INTERVAL   60
+
 /**
  * Code/name lookup tables for symbolic representation of data collection enumerations in
  * JSON (REST API). Each table is terminated by a { 0, nullptr } element and is used both for
@@ -162,6 +168,86 @@ class NXCORE_EXPORTABLE ItemValue
    ItemValue& operator=(uint64_t value) { set(value); return *this; }
 };
 
+/**
+ * Compact cache of recent DCI values. Values are kept in ring buffer with most recent value at index 0.
+ * Numeric values are stored in native form and string representation is kept out of line only if it
+ * cannot be restored from numeric value (which is always the case for string DCIs).
+ */
+class NXCORE_EXPORTABLE DCIValueCache
+{
+private:
+   struct Element
+   {
+      int64_t timestamp;
+      union
+      {
+         int64_t i;
+         uint64_t u;
+         double d;
+      } value;
+      wchar_t *string;  // nullptr if string representation can be restored from numeric value
+   };
+
+   Element *m_elements;
+   uint32_t m_capacity;
+   uint32_t m_size;
+   uint32_t m_head;
+   int m_dataType;
+
+   Element& element(uint32_t index) { return m_elements[(m_head + index) % m_capacity]; }
+   const Element& element(uint32_t index) const;
+
+   void encode(Element *e, const ItemValue& value) const;
+   const wchar_t *format(const Element& e, wchar_t *buffer) const;
+   void setDataType(int dataType);
+   void copyFrom(const DCIValueCache& src);
+   static void freeString(Element *e);
+
+public:
+   DCIValueCache();
+   DCIValueCache(const DCIValueCache& src);
+   ~DCIValueCache();
+
+   DCIValueCache& operator=(const DCIValueCache& src);
+
+   uint32_t size() const { return m_size; }
+   uint32_t capacity() const { return m_capacity; }
+   bool isEmpty() const { return m_size == 0; }
+
+   void clear();
+   void setCapacity(uint32_t capacity);
+   void push(const ItemValue& value, int dataType);
+   void append(const ItemValue& value, int dataType);
+   void appendPlaceholder();
+   void remove(uint32_t index);
+
+   Timestamp getTimeStamp(uint32_t index) const { return Timestamp::fromMilliseconds(element(index).timestamp); }
+   bool isPlaceholder(uint32_t index) const { return element(index).timestamp == 1; } // Timestamp 1 means placeholder value inserted by cache loader
+
+   int32_t getInt32(uint32_t index) const { return static_cast<int32_t>(getInt64(index)); }
+   uint32_t getUInt32(uint32_t index) const { return static_cast<uint32_t>(getUInt64(index)); }
+   int64_t getInt64(uint32_t index) const;
+   uint64_t getUInt64(uint32_t index) const;
+   double getDouble(uint32_t index) const;
+   const wchar_t *getString(uint32_t index, wchar_t *buffer) const { return format(element(index), buffer); }
+   ItemValue get(uint32_t index) const;
+
+   template<typename T> T getValue(uint32_t index) const;
+
+   uint64_t getMemoryUsage() const;
+};
+
+/**
+ * Minimal size of buffer passed to DCIValueCache::getString
+ */
+#define DCI_VALUE_CACHE_STRING_BUFFER_SIZE   64
+
+template<> inline int32_t DCIValueCache::getValue<int32_t>(uint32_t index) const { return getInt32(index); }
+template<> inline uint32_t DCIValueCache::getValue<uint32_t>(uint32_t index) const { return getUInt32(index); }
+template<> inline int64_t DCIValueCache::getValue<int64_t>(uint32_t index) const { return getInt64(index); }
+template<> inline uint64_t DCIValueCache::getValue<uint64_t>(uint32_t index) const { return getUInt64(index); }
+template<> inline double DCIValueCache::getValue<double>(uint32_t index) const { return getDouble(index); }
+
 class DCItem;
 class DataCollectionTarget;
 
@@ -186,7 +272,7 @@ class NXCORE_EXPORTABLE Threshold
    int m_sampleCount;        // Number of samples to calculate function on
    int m_deactivationSampleCount; // Number of consecutive non-matching polls before deactivation
    TCHAR *m_scriptSource;
-   NXSL_Program *m_script;
+   shared_ptr<NXSL_Program> m_script;
    time_t m_lastScriptErrorReport;
    bool m_isReached;
    bool m_wasReachedBeforeMaint;
@@ -200,10 +286,10 @@ class NXCORE_EXPORTABLE Threshold
    uint64_t m_activationSequence;  // Incremented on each activation, used for repeat event scheduling
 
    const ItemValue& value() const { return m_value; }
-   void calculateAverage(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateTotal(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateAbsoluteDeviation(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateMeanDeviation(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
+   void calculateAverage(ItemValue *result, const ItemValue &lastValue, const DCIValueCache& prevValues);
+   void calculateTotal(ItemValue *result, const ItemValue &lastValue, const DCIValueCache& prevValues);
+   void calculateAbsoluteDeviation(ItemValue *result, const ItemValue &lastValue, const DCIValueCache& prevValues);
+   void calculateMeanDeviation(ItemValue *result, const ItemValue &lastValue, const DCIValueCache& prevValues);
    void setScript(TCHAR *script);
 
 public:
@@ -244,7 +330,7 @@ class NXCORE_EXPORTABLE Threshold
    void incrementActivationSequence() { m_activationSequence++; }
 
    bool saveToDB(DB_HANDLE hdb, uint32_t index);
-   ThresholdCheckResult check(ItemValue &value, ItemValue **ppPrevValues, ItemValue &fvalue, ItemValue &tvalue, shared_ptr<NetObj> target, DCItem *dci);
+   ThresholdCheckResult check(ItemValue &value, const DCIValueCache& prevValues, ItemValue &fvalue, ItemValue &tvalue, shared_ptr<NetObj> target, DCItem *dci);
    ThresholdCheckResult checkError(uint32_t errorCount);
 
    void fillMessage(NXCPMessage *msg, uint32_t baseId) const;
@@ -337,6 +423,7 @@ enum DciAggregationFunction
 class NXCORE_EXPORTABLE DCObject : public enable_shared_from_this<DCObject>, public SearchAttributeProvider
 {
    friend class DCObjectInfo;
+   template<typename T> friend class DataCollectionScheduler;
 
 protected:
    uint32_t m_id;
@@ -381,6 +468,8 @@ class NXCORE_EXPORTABLE DCObject : public enable_shared_from_this<DCObject>, pub
    SharedString m_comments;
 	bool m_doForcePoll;                    // Force poll indicator
 	session_id_t m_pollingSessionId;       // Force poll requestor session ID
+   uint64_t m_schedulerTicket;            // Ticket of active scheduler entry or 0 if not scheduled (protected by scheduler lock)
+   time_t m_scheduledPollTime;            // Time of active scheduler entry (protected by scheduler lock)
    uint16_t m_instanceDiscoveryMethod;
    SharedString m_instanceDiscoveryData;  // Instance discovery data (instance value for discovered DCIs and method specific data for prototype)
    SharedString m_instanceFilterSource;
@@ -499,7 +588,7 @@ class NXCORE_EXPORTABLE DCObject : public enable_shared_from_this<DCObject>, pub
    time_t getThresholdDisableEndTime() const { return m_thresholdDisableEndTime; }
 
 	bool matchClusterResource();
-   bool isReadyForPolling(time_t currTime);
+   bool isReadyForPolling(time_t currTime, time_t *nextCheckTime);
 	bool isScheduledForDeletion() const { return m_scheduledForDeletion ? true : false; }
    void setLastPollTime(Timestamp lastPollTime) { m_lastPollTime = lastPollTime; }
    void setStatus(int status, bool generateEvent, bool userChange = false);
@@ -580,6 +669,48 @@ class NXCORE_EXPORTABLE DCObject : public enable_shared_from_this<DCObject>, pub
    virtual json_t *createExportRecord() const = 0;
 };
 
+/**
+ * Completed hourly aggregate bucket queued for writing to database
+ */
+struct DCIAggregateRecord
+{
+   uint32_t objectId;
+   uint32_t dciId;
+   int64_t bucketStart;
+   double minValue;
+   double maxValue;
+   double avgValue;
+   int32_t sampleCount;
+   int64_t watermark;   // New aggregation watermark for DCI (0 if it should not be updated)
+};
+
+/**
+ * In-memory accumulator for hourly aggregate of DCI values
+ */
+struct NXCORE_EXPORTABLE DCIAggregateBucket
+{
+   int64_t start;       // Bucket start (ms), 0 if no bucket is open
+   double minValue;
+   double maxValue;
+   double sum;
+   int32_t count;
+   bool complete;       // true if bucket was open from its start and so has seen all its samples
+
+   void reset(int64_t bucketStart, bool isComplete)
+   {
+      start = bucketStart;
+      minValue = 0;
+      maxValue = 0;
+      sum = 0;
+      count = 0;
+      complete = isComplete;
+   }
+
+   bool update(int64_t timestampMs, const wchar_t *value, int64_t *watermark, DCIAggregateRecord *closed);
+};
+
+bool NXCORE_EXPORTABLE ParseAggregateValue(const wchar_t *text, double *value);
+
 /**
  * Data collection item class
  */
@@ -593,9 +724,8 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
    BYTE m_transformedDataType;   // Data type after transformation
 	int m_sampleCount;            // Number of samples required to calculate value
 	ObjectArray<Threshold> *m_thresholds;
-   uint32_t m_cacheSize;          // Number of items in cache
    uint32_t m_requiredCacheSize;
-   ItemValue **m_ppValueCache;
+   DCIValueCache m_valueCache;
    ItemValue m_prevRawValue;     // Previous raw value (used for delta calculation)
    uint64_t m_prevDeltaValue;    // Previous delta value for counter types
    Timestamp m_prevValueTimeStamp;
@@ -620,9 +750,11 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
    int32_t m_hourlyRetention;          // Per-DCI hourly aggregate retention override (days), 0 = use default
    int32_t m_dailyRetention;           // Per-DCI daily aggregate retention override (days), 0 = use default
    int64_t m_aggregationWatermark;     // Earliest bucket start (ms) not yet rolled up; non-TSDB only
+   DCIAggregateBucket m_hourlyAggregate;  // Hourly aggregate of values stored since server start; non-TSDB only
 
    bool transform(ItemValue &value, int64_t elapsedTime);
    void checkThresholds(ItemValue &value, const shared_ptr<DCObject>& originalDci);
+   void updateHourlyAggregate(uint32_t objectId, int64_t timestampMs, const wchar_t *value);
    uint32_t calculateRequiredCacheSize(const NetObj& owner) const;
    void updateCacheSizeInternal(bool allowLoad);
    void clearCache();
@@ -707,6 +839,12 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
 	bool isHourlyAggregationEligible() const;
 	bool isAggregationActive(bool globalEnabled) const;
 	void pushBackAggregationWatermark(int64_t timestampMs);
+	void restoreAggregationWatermark(int64_t timestampMs)
+	{
+	   lock();
+	   pushBackAggregationWatermark(timestampMs);
+	   unlock();
+	}
 	bool tryAdvanceAggregationWatermark(int64_t expectedStart, int64_t newWatermark, int64_t *currentOut);
 	bool setInitialAggregationWatermark(int64_t timestampMs);
 
@@ -729,7 +867,7 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
 
    NXSL_Value *getValueForNXSL(NXSL_VM *vm, int function, int sampleCount);
    NXSL_Value *getRawValueForNXSL(NXSL_VM *vm);
-   const TCHAR *getLastValue();
+   String getLastValue();
    ItemValue *getInternalLastValue();
    TCHAR *getAggregateValue(AggregationFunction func, time_t periodStart, time_t periodEnd);
 
@@ -1173,6 +1311,9 @@ static inline uint32_t RCCFromDCIError(DataCollectionError error)
  * Functions
  */
 void InitDataCollector();
+void ScheduleDataCollection(const shared_ptr<DCObject>& dcObject, time_t dueTime, bool onlyIfNotScheduled = false);
+void ScheduleDataCollection(const SharedObjectArray<DCObject>& dcObjects, time_t dueTime, bool onlyIfNotScheduled = false);
+void CollectScheduledDataCollectionObjects(time_t now, SharedObjectArray<DCObject> *dueObjects);
 void WriteFullParamListToMessage(NXCPMessage *msg, int origin, uint16_t flags);
 int GetDCObjectType(uint32_t nodeId, uint32_t dciId);
 
@@ -1181,6 +1322,8 @@ bool ParseModbusMetric(const TCHAR *metric, uint16_t *unitId, const TCHAR **sour
 void CalculateItemValueDiff(ItemValue *result, int dataType, const ItemValue &value1, const ItemValue &value2);
 void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount);
 void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount);
+void CalculateItemValueAverage(ItemValue *result, int dataType, const DCIValueCache& cache, size_t sampleCount);
+void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const DCIValueCache& cache, size_t sampleCount);
 void CalculateItemValueTotal(ItemValue *result, int dataType, const ItemValue *const *valueList, size_t sampleCount);
 void CalculateItemValueMin(ItemValue *result, int dataType, const ItemValue *const *valueList, size_t sampleCount);
 void CalculateItemValueMax(ItemValue *result, int dataType, const ItemValue *const *valueList, size_t sampleCount);
@@ -1209,6 +1352,9 @@ void CleanDCIAggregates(DB_HANDLE hdb);
 void ReconcileTSDBAggregation();
 void ReconcileNonTSDBAggregation();
 
+void QueueHourlyAggregateUpsert(DCIAggregateRecord *record);
+void SaveHourlyAggregates(ObjectArray<DCIAggregateRecord> *records);
+
 /**
  * Get database-specific expression for converting v5 second-precision timestamp to milliseconds.
  * The v5 tables store timestamps as 32-bit integers; multiplying directly by 1000 overflows on
@@ -714,6 +714,54 @@ class TimeFrame
    uint64_t getDateFilter() const { return m_dateFilter; }
 };
 
+/**
+ * Data about event being passed through event processing policy, shared between rule evaluations
+ */
+class EPRuleMatchContext
+{
+private:
+   Event *m_event;
+   bool m_sourceResolved;
+   shared_ptr<NetObj> m_source;
+   HashSet<uint32_t> m_sourceObjectIds;        // Source object and all its parents
+   IntegerArray<uint32_t> m_sourceObjectIdList;
+   bool m_timeResolved;
+   struct tm m_localTime;
+
+   void resolveSource();
+
+public:
+   EPRuleMatchContext(Event *event) : m_sourceObjectIdList(0, 16)
+   {
+      m_event = event;
+      m_sourceResolved = false;
+      m_timeResolved = false;
+   }
+
+   const shared_ptr<NetObj>& getSource()
+   {
+      if (!m_sourceResolved)
+         resolveSource();
+      return m_source;
+   }
+
+   const HashSet<uint32_t>& getSourceObjectIds()
+   {
+      if (!m_sourceResolved)
+         resolveSource();
+      return m_sourceObjectIds;
+   }
+
+   const IntegerArray<uint32_t>& getSourceObjectIdList()
+   {
+      if (!m_sourceResolved)
+         resolveSource();
+      return m_sourceObjectIdList;
+   }
+
+   struct tm *getLocalTime();
+};
+
 /**
  * Event policy rule
  */
@@ -730,6 +778,8 @@ class NXCORE_EXPORTABLE EPRule
    uint32_t m_flags;
    IntegerArray<uint32_t> m_sources;
    IntegerArray<uint32_t> m_sourceExclusions;
+   HashSet<uint32_t> m_sourceSet;             // Built by compile() for fast source matching
+   HashSet<uint32_t> m_sourceExclusionSet;    // Built by compile() for fast source matching
    IntegerArray<uint32_t> m_events;
    ObjectArray<TimeFrame> m_timeFrames;
    ObjectArray<ActionExecutionConfiguration> m_actions;
@@ -767,7 +817,7 @@ class NXCORE_EXPORTABLE EPRule
 
    wchar_t *m_aiAgentInstructions;
 
-   bool matchSource(const shared_ptr<NetObj>& object) const;
+   bool matchSource(EPRuleMatchContext *context) const;
    bool matchEvent(uint32_t eventCode) const;
    bool matchSeverity(uint32_t severity) const;
    bool matchScript(Event *event) const;
@@ -808,7 +858,7 @@ class NXCORE_EXPORTABLE EPRule
 
    bool loadFromDB(DB_HANDLE hdb);
    bool saveToDB(DB_HANDLE hdb, const uuid& modifiedByGuid, const TCHAR* modifiedByName, time_t modificationTime) const;
-   bool processEvent(Event *event) const;
+   bool processEvent(Event *event, EPRuleMatchContext *context, bool eventCodeMatched) const;
    void fillMessage(NXCPMessage *msg) const;
 
    json_t *createExportRecord() const;
@@ -819,6 +869,10 @@ class NXCORE_EXPORTABLE EPRule
    bool isCategoryInUse(uint32_t categoryId) const { return m_alarmCategoryList.contains(categoryId); }
 
    bool isUsingEvent(uint32_t eventCode) const { return m_events.contains(eventCode); }
+   const IntegerArray<uint32_t>& getEvents() const { return m_events; }
+   bool isEventListNegated() const { return (m_flags & RF_NEGATED_EVENTS) != 0; }
+
+   void compile();
    const wchar_t *getComments() const { return m_comments; }
 
    void getScriptDependencies(StringSet *dependencies) const;
@@ -953,6 +1007,8 @@ class NXCORE_EXPORTABLE EventProcessingPolicy
 {
 private:
    SharedObjectArray<EPRule> m_rules;
+   HashMap<uint32_t, IntegerArray<int>> m_eventIndex;   // Ordered indexes of rules which can match event code, for codes referenced by rules
+   IntegerArray<int> m_genericRules;                   // Ordered indexes of rules which can match event codes not referenced by any rule
    RWLock m_rwlock;
    uint32_t m_version;   // Policy version for optimistic concurrency (in-memory only)
 
@@ -960,9 +1016,10 @@ class NXCORE_EXPORTABLE EventProcessingPolicy
    void writeLock() { m_rwlock.writeLock(); }
    void unlock() const { m_rwlock.unlock(); }
    int findRuleIndexByGuid(const uuid& guid, int shift = 0) const;
+   void buildIndex();
 
 public:
-   EventProcessingPolicy() : m_version(0) { }
+   EventProcessingPolicy() : m_eventIndex(Ownership::True), m_genericRules(0, 64), m_version(0) { }
 
    uint32_t getNumRules() const { return static_cast<uint32_t>(m_rules.size()); }
    uint32_t getVersion() const { return m_version; }
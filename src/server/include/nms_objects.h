@@ -246,6 +246,7 @@ class NXCORE_EXPORTABLE AgentConnectionEx : public AgentConnection
 
    void scheduleTrapAcknowledgement();
    void sendTrapAcknowledgement();
+   BYTE processCollectedDataElement(NXCPMessage *request, uint32_t fieldId, const shared_ptr<DataCollectionTarget>& defaultTarget, int index);
 
    virtual shared_ptr<AbstractCommChannel> createChannel() override;
    virtual void onTrap(NXCPMessage *msg) override;
@@ -258,6 +259,7 @@ class NXCORE_EXPORTABLE AgentConnectionEx : public AgentConnection
    virtual void onNotify(NXCPMessage *msg) override;
    virtual uint32_t processCollectedData(NXCPMessage *msg) override;
    virtual uint32_t processBulkCollectedData(NXCPMessage *request, NXCPMessage *response) override;
+   virtual uint32_t processCollectedDataBatch(NXCPMessage *request, NXCPMessage *response) override;
    virtual bool processCustomMessage(NXCPMessage *msg) override;
    virtual void processTcpProxyData(uint32_t channelId, const void *data, size_t size, bool errorIndicator) override;
    virtual void getSshKeys(NXCPMessage *msg, NXCPMessage *response) override;
@@ -351,22 +353,33 @@ struct TemplateUpdateTask
 };
 
 /**
- * Index head
+ * Index version head
  */
 struct INDEX_HEAD;
 
 /**
- * Generic index implementation
+ * Index tree node
+ */
+struct INDEX_NODE;
+
+/**
+ * Generic index implementation. Index is a copy-on-write B+tree: readers work with immutable published
+ * version without locking, writers copy only nodes on the path to modified element and publish new root.
+ * Replaced nodes and objects are reclaimed when last reader of each retired version leaves.
  */
 class NXCORE_EXPORTABLE AbstractIndexBase
 {
 protected:
-   INDEX_HEAD* volatile m_primary;
-   INDEX_HEAD* volatile m_secondary;
+   INDEX_HEAD* volatile m_current;
+   INDEX_HEAD *m_retiredHead;
+   INDEX_HEAD *m_retiredTail;
+   INDEX_HEAD *m_freeHeads;
+   INDEX_NODE *m_workRoot;
+   size_t m_workSize;
+   uint64_t m_writeVersion;
    Mutex m_writerLock;
    bool m_owner;
    bool m_startupMode;
-   bool m_dirty;
    void (*m_objectDestructor)(void*, AbstractIndexBase*);
 
    void destroyObject(void *object)
@@ -376,9 +389,21 @@ class NXCORE_EXPORTABLE AbstractIndexBase
    }
 
    INDEX_HEAD *acquireIndex() const;
-   void swapAndWait();
 
-   static ssize_t findElement(INDEX_HEAD *index, uint64_t key);
+   void beginUpdate();
+   void commitUpdate();
+   void reclaim();
+   void reclaimHead(INDEX_HEAD *head);
+   void releaseHead(INDEX_HEAD *head);
+   INDEX_NODE *createNode(bool leaf);
+   INDEX_NODE *makeWritable(INDEX_NODE *node);
+   void retireNode(INDEX_NODE *node);
+   void retireObject(void *object);
+   void retireTree(INDEX_NODE *node);
+   INDEX_NODE *insertIntoNode(INDEX_NODE *node, uint64_t key, void *object, INDEX_NODE **sibling, bool *replaced);
+   INDEX_NODE *removeFromNode(INDEX_NODE *node, uint64_t key);
+   bool insertElement(uint64_t key, void *object);
+   void removeElement(uint64_t key);
 
    void findAll(Array *resultSet, bool (*comparator)(void*, void*), void *data) const;
    void findAll(Array *resultSet, std::function<bool (void*)> comparator) const;
@@ -390,7 +415,13 @@ class NXCORE_EXPORTABLE AbstractIndexBase
 
    size_t size() const;
    bool put(uint64_t key, void *object);
+   size_t putAll(const uint64_t *keys, void * const *objects, size_t count);
    void remove(uint64_t key);
+   void removeAll(const uint64_t *keys, size_t count);
+   void removeAll(const IntegerArray<uint64_t>& keys)
+   {
+      removeAll(keys.getBuffer(), keys.size());
+   }
    void clear();
    void *get(uint64_t key) const;
    bool contains(uint64_t key) const { return get(key) != nullptr; }
@@ -413,6 +444,8 @@ class NXCORE_EXPORTABLE AbstractIndexBase
    }
 
    void setStartupMode(bool startupMode);
+
+   size_t getRetiredNodeCount() const;
 };
 
 /**
@@ -465,6 +498,17 @@ template<typename T> class SharedPointerIndex : public AbstractIndexBase
       return AbstractIndexBase::put(key, new(m_pool.allocate()) shared_ptr<T>(object));
    }
 
+   size_t putAll(const IntegerArray<uint64_t>& keys, const SharedObjectArray<T>& objects)
+   {
+      size_t count = static_cast<size_t>(std::min(keys.size(), objects.size()));
+      void **elements = MemAllocArrayNoInit<void*>(count);
+      for(size_t i = 0; i < count; i++)
+         elements[i] = new(m_pool.allocate()) shared_ptr<T>(objects.getShared(static_cast<int>(i)));
+      size_t replaced = AbstractIndexBase::putAll(keys.getBuffer(), elements, count);
+      MemFree(elements);
+      return replaced;
+   }
+
    shared_ptr<T> get(uint64_t key) const
    {
       auto v = static_cast<shared_ptr<T>*>(AbstractIndexBase::get(key));
@@ -641,18 +685,26 @@ template<typename T> class AbstractIndexWithDestructor : public AbstractIndex<T>
 };
 
 struct InetAddressIndexEntry;
+struct InetAddressPrefixNode;
 
 /**
- * Object index by IP address
+ * Object index by IP address. If prefix search is enabled, index also maintains radix tree of
+ * address prefixes (address with mask) for longest prefix match and overlap queries.
  */
 class NXCORE_EXPORTABLE InetAddressIndex
 {
 private:
    InetAddressIndexEntry *m_root;
+   InetAddressPrefixNode *m_prefixRootV4;
+   InetAddressPrefixNode *m_prefixRootV6;
+   bool m_prefixSearch;
    RWLock m_lock;
 
+   void addPrefix(InetAddressIndexEntry *entry);
+   void removePrefix(InetAddressIndexEntry *entry);
+
 public:
-   InetAddressIndex();
+   InetAddressIndex(bool prefixSearch = false);
    ~InetAddressIndex();
 
    bool put(const InetAddress& addr, const shared_ptr<NetObj>& object);
@@ -661,6 +713,8 @@ class NXCORE_EXPORTABLE InetAddressIndex
    void remove(const InetAddress& addr);
    shared_ptr<NetObj> get(const InetAddress& addr) const;
    shared_ptr<NetObj> find(bool (*comparator)(NetObj *, void *), void *context) const;
+   shared_ptr<NetObj> findLongestPrefixMatch(const InetAddress& addr) const;
+   unique_ptr<SharedObjectArray<NetObj>> getOverlappingObjects(const InetAddress& prefix) const;
 
    int size() const;
    unique_ptr<SharedObjectArray<NetObj>> getObjects(bool (*filter)(NetObj *, void *) = nullptr, void *context = nullptr) const;
@@ -2924,6 +2978,7 @@ class NXCORE_EXPORTABLE DataCollectionTarget : public DataCollectionOwner, publi
    virtual void onDataCollectionLoad() override;
    virtual void onDataCollectionChange() override;
    virtual void onInstanceDiscoveryChange() override;
+   virtual void onMgmtStatusChange(bool isManaged, int oldStatus) override;
    virtual bool isDataCollectionDisabled();
 
    virtual int getAdditionalMostCriticalStatus(StringBuffer *explanation = nullptr) override;
@@ -3045,7 +3100,8 @@ class NXCORE_EXPORTABLE DataCollectionTarget : public DataCollectionOwner, publi
    bool hasV5TdataTable() const { return (m_runtimeFlags & ODF_HAS_TDATA_V5_TABLE) != 0; }
    void deleteV5DataTable(DB_HANDLE hdb, bool tdata, const wchar_t *reason);
    bool ensureAggregateTable(DB_HANDLE hdb, bool hourly);
-   void queueItemsForPolling();
+   void queueItemsForPolling(const SharedObjectArray<DCObject>& dcObjects);
+   void scheduleDataCollection(time_t dueTime, bool onlyIfNotScheduled);
    bool processNewDCValue(const shared_ptr<DCObject>& dco, Timestamp timestamp, const wchar_t *itemValue, const shared_ptr<Table>& tableValue, bool allowPastDataPoints);
    void scheduleItemDataCleanup(uint32_t dciId);
    void scheduleTableDataCleanup(uint32_t dciId);
@@ -4158,6 +4214,16 @@ struct ReconciliationStatus
    int64_t rateAnchorTime;          // time (ms) of rate calculation sample
 };
 
+/**
+ * Entry in node's SNMP transport pool
+ */
+struct SNMPTransportPoolEntry
+{
+   SNMP_Transport *transport;
+   uint64_t key;        // Hash of node SNMP settings used for transport creation
+   time_t lastUsed;
+};
+
 /**
  * Additional SNMP agent on a node - defines alternative SNMP endpoint (different port,
  * credentials, and optionally IP address) that can be referenced by name from data
@@ -4265,6 +4331,9 @@ class NXCORE_EXPORTABLE Node : public DataCollectionTarget
    SNMP_SecurityContext *m_snmpTrapSecurity;  // Separate credentials for trap reception (null = use m_snmpSecurity)
    SNMP_Version m_snmpTrapVersion;            // Only used when m_snmpTrapSecurity != nullptr
    ObjectArray<AdditionalSnmpAgent> m_additionalSnmpAgents;
+   Mutex m_snmpTransportPoolLock;
+   StructArray<SNMPTransportPoolEntry> m_snmpTransportPool;     // Idle SNMP transports available for reuse
+   StructArray<SNMPTransportPoolEntry> m_snmpTransportsInUse;   // SNMP transports acquired from pool
    char m_snmpCodepage[16];
    uuid m_agentId;
    TCHAR *m_agentCertSubject;
@@ -4474,6 +4543,8 @@ class NXCORE_EXPORTABLE Node : public DataCollectionTarget
    void checkBridgeMib(SNMP_Transport *snmp);
    void checkIfXTable(SNMP_Transport *snmp);
    SNMP_Transport *createSnmpTransportInternal(const InetAddress& targetAddr, uint16_t port, bool pollerMessageOnFailure, uint32_t *proxyNodeId, bool *proxyConnectionFailed);
+   uint64_t getSnmpTransportPoolKey(uint16_t port, SNMP_Version version, const char *context);
+   void expireIdleSnmpTransportsUnlocked(time_t now);
    NetworkPathCheckResult checkNetworkPath(uint32_t requestId, const StatusPollProxyEvidence& proxyEvidence);
    NetworkPathCheckResult checkNetworkPathLayer2(uint32_t requestId, bool secondPass, const StatusPollProxyEvidence& proxyEvidence);
    NetworkPathCheckResult checkNetworkPathLayer3(uint32_t requestId, bool secondPass);
@@ -4824,6 +4895,10 @@ class NXCORE_EXPORTABLE Node : public DataCollectionTarget
    virtual DataCollectionError getInternalTable(const TCHAR *name, shared_ptr<Table> *result) override;
 
    DataCollectionError getMetricFromSNMP(uint16_t port, SNMP_Version version, const TCHAR *metric, TCHAR *buffer, size_t size, int interpretRawValue, const TCHAR *context = nullptr, const TCHAR *snmpAgentName = nullptr);
+   void getMetricsFromSNMP(uint16_t port, SNMP_Version version, const wchar_t *context, const wchar_t *snmpAgentName, int count,
+            const wchar_t * const *names, wchar_t **buffers, size_t size, DataCollectionError *results, int maxVarbinds);
+   bool getMetricFromSNMPAsync(SNMP_AsyncEngine *engine, uint16_t port, SNMP_Version version, const wchar_t *metric, const wchar_t *context,
+            std::function<void (DataCollectionError, const wchar_t*)> callback);
    DataCollectionError getTableFromSNMP(uint16_t port, SNMP_Version version, const TCHAR *oid, const ObjectArray<DCTableColumn> &columns, shared_ptr<Table> *table, const TCHAR *context = nullptr, bool addInstanceOidColumn = false, const TCHAR *snmpAgentName = nullptr);
    DataCollectionError getListFromSNMP(uint16_t port, SNMP_Version version, const TCHAR *oid, StringList **list, const TCHAR *context = nullptr, const TCHAR *snmpAgentName = nullptr);
    DataCollectionError getOIDSuffixListFromSNMP(uint16_t port, SNMP_Version version, const TCHAR *baseOid, StringMap **values, const TCHAR *context = nullptr, const TCHAR *snmpAgentName = nullptr);
@@ -4874,6 +4949,11 @@ class NXCORE_EXPORTABLE Node : public DataCollectionTarget
    SNMP_Transport *createSnmpTransport(uint16_t port = 0, SNMP_Version version = SNMP_VERSION_DEFAULT, const char *context = nullptr, const char *community = nullptr, bool pollerMessageOnFailure = false, uint32_t *proxyNodeId = nullptr, bool *proxyConnectionFailed = nullptr);
    SNMP_Transport *createSnmpTransportForPoller(uint32_t *proxyNodeId = nullptr, bool *proxyConnectionFailed = nullptr) { return createSnmpTransport(0, SNMP_VERSION_DEFAULT, nullptr, nullptr, true, proxyNodeId, proxyConnectionFailed); }
    SNMP_Transport *createSnmpTransportForAgent(const wchar_t *agentName, bool *agentNotFound = nullptr);
+   SNMP_Transport *acquireSnmpTransport(uint16_t port = 0, SNMP_Version version = SNMP_VERSION_DEFAULT, const char *context = nullptr, bool pollerMessageOnFailure = false, uint32_t *proxyNodeId = nullptr, bool *proxyConnectionFailed = nullptr);
+   SNMP_Transport *acquireSnmpTransportForPoller(uint32_t *proxyNodeId = nullptr, bool *proxyConnectionFailed = nullptr) { return acquireSnmpTransport(0, SNMP_VERSION_DEFAULT, nullptr, true, proxyNodeId, proxyConnectionFailed); }
+   void releaseSnmpTransport(SNMP_Transport *transport);
+   void invalidateSnmpTransportPool();
+   void expireIdleSnmpTransports(time_t now);
    SNMP_SecurityContext *getSnmpSecurityContext() const;
    SNMP_SecurityContext *getSnmpTrapSecurityContext() const;
    AdditionalSnmpAgent *getAdditionalSnmpAgent(const wchar_t *name) const;
@@ -5450,6 +5530,8 @@ class NXCORE_EXPORTABLE Zone : public NetObj, public Pollable
    void updateInterfaceIndex(const InetAddress& oldIp, const InetAddress& newIp, const shared_ptr<Interface>& iface);
    void updateNodeIndex(const InetAddress& oldIp, const InetAddress& newIp, const shared_ptr<Node>& node);
    shared_ptr<Subnet> getSubnetByAddr(const InetAddress& ipAddr) const { return static_pointer_cast<Subnet>(m_idxSubnetByAddr->get(ipAddr)); }
+   shared_ptr<Subnet> findSubnetForAddress(const InetAddress& ipAddr) const { return static_pointer_cast<Subnet>(m_idxSubnetByAddr->findLongestPrefixMatch(ipAddr)); }
+   unique_ptr<SharedObjectArray<NetObj>> getOverlappingSubnets(const InetAddress& prefix) const { return m_idxSubnetByAddr->getOverlappingObjects(prefix); }
    shared_ptr<Interface> getInterfaceByAddr(const InetAddress& ipAddr) const { return static_pointer_cast<Interface>(m_idxInterfaceByAddr->get(ipAddr)); }
    shared_ptr<Node> getNodeByAddr(const InetAddress& ipAddr) const { return static_pointer_cast<Node>(m_idxNodeByAddr->get(ipAddr)); }
    shared_ptr<Subnet> findSubnet(bool (*comparator)(NetObj *, void *), void *context) const { return static_pointer_cast<Subnet>(m_idxSubnetByAddr->find(comparator, context)); }
@@ -6623,6 +6705,7 @@ void ObjectsInit();
 
 void NXCORE_EXPORTABLE NetObjInsert(const shared_ptr<NetObj>& object, bool newObject, bool importedObject);
 void NetObjDeleteFromIndexes(const NetObj& object);
+void UpdateNodeAttributeIndexes(const Node& node);
 
 void UpdateInterfaceIndex(const InetAddress& oldIpAddr, const InetAddress& newIpAddr, const shared_ptr<Interface>& iface);
 void UpdateNodeIndex(const InetAddress& oldIpAddr, const InetAddress& newIpAddr, const shared_ptr<Node>& node);
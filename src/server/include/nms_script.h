@@ -824,6 +824,16 @@ ScriptVMHandle NXCORE_EXPORTABLE CreateServerScriptVM(const TCHAR *name, const s
  */
 ScriptVMHandle NXCORE_EXPORTABLE CreateServerScriptVM(const NXSL_Program *script, const shared_ptr<NetObj>& object, const shared_ptr<DCObjectInfo>& dciInfo = shared_ptr<DCObjectInfo>());
 
+/**
+ * Get NXSL VM for compiled script from VM pool
+ */
+ScriptVMHandle NXCORE_EXPORTABLE AcquirePooledServerScriptVM(const shared_ptr<NXSL_Program>& script, const shared_ptr<NetObj>& object, const shared_ptr<DCObjectInfo>& dciInfo = shared_ptr<DCObjectInfo>());
+
+/**
+ * Return NXSL VM to VM pool
+ */
+void NXCORE_EXPORTABLE ReleasePooledServerScriptVM(NXSL_VM *vm, const shared_ptr<NXSL_Program>& script);
+
 /**
  * Attach a read-only security context to given NXSL VM if script write restriction is enabled
  * (controlled by AF_RESTRICT_SCRIPT_WRITES / Scripts.RestrictWriteAccess).
@@ -839,6 +849,11 @@ static inline void SetRestrictedSecurityContext(NXSL_VM *vm)
  */
 NXSL_Program NXCORE_EXPORTABLE *CompileServerScript(const TCHAR *source, const TCHAR *context, const NetObj *object, uint32_t dciId, const TCHAR *nameFormat, ...);
 
+/**
+ * Compile server script or get already compiled program with same source
+ */
+shared_ptr<NXSL_Program> NXCORE_EXPORTABLE CompileSharedServerScript(const wchar_t *source, NXSL_CompilationDiagnostic *diag);
+
 /**
  * Report script error
  */
@@ -859,6 +874,8 @@ class ImportContext;
  */
 void LoadScripts();
 void ValidateScripts();
+void InitServerScriptVMPool();
+void ShutdownServerScriptVMPool();
 void NXCORE_EXPORTABLE ReloadScript(uint32_t scriptId);
 bool NXCORE_EXPORTABLE IsValidScriptId(uint32_t id);
 uint32_t NXCORE_EXPORTABLE ResolveScriptName(const wchar_t *name);
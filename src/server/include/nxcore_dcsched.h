@@ -0,0 +1,270 @@
+/*
+** NetXMS - Network Management System
+** Server Core
+** Copyright (C) 2003-2026 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: nxcore_dcsched.h
+**
+**/
+
+#ifndef _nxcore_dcsched_h_
+#define _nxcore_dcsched_h_
+
+#define DEBUG_TAG_DC_SCHEDULER   _T("dc.scheduler")
+
+/**
+ * Timer wheel geometry. Each level has 64 slots; level 0 slot is one second,
+ * so four levels cover about 194 days. Entries scheduled further away are
+ * clamped to the end of the wheel and re-evaluated when they expire.
+ */
+#define DC_WHEEL_LEVELS       4
+#define DC_WHEEL_LEVEL_BITS   6
+#define DC_WHEEL_LEVEL_SIZE   (1 << DC_WHEEL_LEVEL_BITS)
+#define DC_WHEEL_LEVEL_MASK   (DC_WHEEL_LEVEL_SIZE - 1)
+#define DC_WHEEL_SPAN         (static_cast<time_t>(1) << (DC_WHEEL_LEVELS * DC_WHEEL_LEVEL_BITS))
+
+/**
+ * Maximum forward clock jump (in seconds) handled by advancing wheel one slot at a time
+ */
+#define DC_MAX_CLOCK_ADVANCE  86400
+
+/**
+ * Data collection scheduler - hierarchical timer wheel keyed by next check time of scheduled object.
+ * Each object has at most one active entry identified by ticket stored in the object (members
+ * m_schedulerTicket and m_scheduledPollTime, protected by scheduler lock). Entries replaced by
+ * rescheduling are not removed from the wheel and are silently dropped on expiration.
+ */
+template<typename T> class DataCollectionScheduler
+{
+private:
+   /**
+    * Scheduler entry
+    */
+   struct Entry
+   {
+      Entry *next;
+      weak_ptr<T> object;
+      time_t dueTime;
+      uint64_t ticket;
+   };
+
+   Mutex m_mutex;
+   ObjectMemoryPool<Entry> m_pool;
+   Entry *m_wheel[DC_WHEEL_LEVELS][DC_WHEEL_LEVEL_SIZE];
+   time_t m_currentTime;   // Last processed second
+   uint64_t m_ticketSequence;
+
+   /**
+    * Insert entry into appropriate wheel slot. Scheduler lock must be held by caller.
+    */
+   void insertEntry(Entry *entry)
+   {
+      if (entry->dueTime <= m_currentTime)
+         entry->dueTime = m_currentTime + 1;
+      else if (entry->dueTime - m_currentTime >= DC_WHEEL_SPAN)
+         entry->dueTime = m_currentTime + DC_WHEEL_SPAN - 1;
+
+      time_t delta = entry->dueTime - m_currentTime;
+      int level = 0;
+      while((level < DC_WHEEL_LEVELS - 1) && (delta >= (static_cast<time_t>(1) << ((level + 1) * DC_WHEEL_LEVEL_BITS))))
+         level++;
+
+      int slot = static_cast<int>((entry->dueTime >> (level * DC_WHEEL_LEVEL_BITS)) & DC_WHEEL_LEVEL_MASK);
+      entry->next = m_wheel[level][slot];
+      m_wheel[level][slot] = entry;
+   }
+
+   /**
+    * Move entries from current slot of given level to lower levels. Scheduler lock must be held by caller.
+    */
+   void cascade(int level)
+   {
+      int slot = static_cast<int>((m_currentTime >> (level * DC_WHEEL_LEVEL_BITS)) & DC_WHEEL_LEVEL_MASK);
+      Entry *entry = m_wheel[level][slot];
+      m_wheel[level][slot] = nullptr;
+      while(entry != nullptr)
+      {
+         Entry *next = entry->next;
+         if (entry->dueTime <= m_currentTime)
+         {
+            // Due in current second - put directly into level 0 slot which is about to be processed
+            int slot = static_cast<int>(m_currentTime & DC_WHEEL_LEVEL_MASK);
+            entry->next = m_wheel[0][slot];
+            m_wheel[0][slot] = entry;
+         }
+         else
+         {
+            insertEntry(entry);
+         }
+         entry = next;
+      }
+   }
+
+   /**
+    * Reset wheel to given time after system clock change. All entries become due immediately
+    * so that affected objects will be re-evaluated against new clock.
+    */
+   void rebase(time_t now)
+   {
+      Entry *list = nullptr;
+      for(int level = 0; level < DC_WHEEL_LEVELS; level++)
+      {
+         for(int slot = 0; slot < DC_WHEEL_LEVEL_SIZE; slot++)
+         {
+            Entry *entry = m_wheel[level][slot];
+            while(entry != nullptr)
+            {
+               Entry *next = entry->next;
+               entry->next = list;
+               list = entry;
+               entry = next;
+            }
+            m_wheel[level][slot] = nullptr;
+         }
+      }
+
+      m_currentTime = now - 1;
+      while(list != nullptr)
+      {
+         Entry *next = list->next;
+         list->dueTime = now;
+         insertEntry(list);
+         list = next;
+      }
+   }
+
+   /**
+    * Process expired entries from given list. Scheduler lock must be held by caller.
+    */
+   void expireEntries(Entry *entry, SharedObjectArray<T> *dueObjects)
+   {
+      while(entry != nullptr)
+      {
+         Entry *next = entry->next;
+         shared_ptr<T> object = entry->object.lock();
+         if ((object != nullptr) && (object->m_schedulerTicket == entry->ticket))
+         {
+            object->m_schedulerTicket = 0;
+            dueObjects->add(object);
+         }
+         m_pool.destroy(entry);
+         entry = next;
+      }
+   }
+
+   /**
+    * Schedule object. Scheduler lock must be held by caller.
+    */
+   void scheduleUnlocked(const shared_ptr<T>& object, time_t dueTime, bool onlyIfNotScheduled)
+   {
+      if ((object->m_schedulerTicket != 0) && (onlyIfNotScheduled || (object->m_scheduledPollTime <= dueTime)))
+         return;  // Already scheduled for same or earlier time
+
+      Entry *entry = m_pool.create();
+      entry->object = object;
+      entry->dueTime = dueTime;
+      entry->ticket = ++m_ticketSequence;
+      insertEntry(entry);
+
+      object->m_schedulerTicket = entry->ticket;
+      object->m_scheduledPollTime = entry->dueTime;
+   }
+
+public:
+   DataCollectionScheduler(time_t now) : m_mutex(MutexType::FAST), m_pool(4096)
+   {
+      memset(m_wheel, 0, sizeof(m_wheel));
+      m_currentTime = now;
+      m_ticketSequence = 0;
+   }
+
+   ~DataCollectionScheduler()
+   {
+      for(int level = 0; level < DC_WHEEL_LEVELS; level++)
+      {
+         for(int slot = 0; slot < DC_WHEEL_LEVEL_SIZE; slot++)
+         {
+            for(Entry *entry = m_wheel[level][slot]; entry != nullptr;)
+            {
+               Entry *next = entry->next;
+               m_pool.destroy(entry);
+               entry = next;
+            }
+         }
+      }
+   }
+
+   /**
+    * Schedule object to be checked not later than at given time. If onlyIfNotScheduled is true,
+    * object will be scheduled only if it does not have active schedule entry.
+    */
+   void schedule(const shared_ptr<T>& object, time_t dueTime, bool onlyIfNotScheduled)
+   {
+      m_mutex.lock();
+      scheduleUnlocked(object, dueTime, onlyIfNotScheduled);
+      m_mutex.unlock();
+   }
+
+   /**
+    * Schedule set of objects to be checked not later than at given time
+    */
+   void schedule(const SharedObjectArray<T>& objects, time_t dueTime, bool onlyIfNotScheduled)
+   {
+      m_mutex.lock();
+      for(int i = 0; i < objects.size(); i++)
+         scheduleUnlocked(objects.getShared(i), dueTime, onlyIfNotScheduled);
+      m_mutex.unlock();
+   }
+
+   /**
+    * Advance wheel to given time and collect objects which are due. Collected objects are
+    * removed from schedule and should be re-scheduled by caller after check.
+    */
+   void collectDueObjects(time_t now, SharedObjectArray<T> *dueObjects)
+   {
+      m_mutex.lock();
+
+      if ((now < m_currentTime) || (now - m_currentTime > DC_MAX_CLOCK_ADVANCE))
+      {
+         nxlog_debug_tag(DEBUG_TAG_DC_SCHEDULER, 3, _T("System clock change detected (scheduler time ") INT64_FMT _T(", system time ") INT64_FMT _T("), rescheduling all data collection objects"),
+                  static_cast<int64_t>(m_currentTime), static_cast<int64_t>(now));
+         rebase(now);
+      }
+
+      while(m_currentTime < now)
+      {
+         m_currentTime++;
+
+         // Cascade entries from higher levels when lower level wraps around
+         for(int level = 1; level < DC_WHEEL_LEVELS; level++)
+         {
+            if (((m_currentTime >> ((level - 1) * DC_WHEEL_LEVEL_BITS)) & DC_WHEEL_LEVEL_MASK) != 0)
+               break;
+            cascade(level);
+         }
+
+         int slot = static_cast<int>(m_currentTime & DC_WHEEL_LEVEL_MASK);
+         Entry *entry = m_wheel[0][slot];
+         m_wheel[0][slot] = nullptr;
+         expireEntries(entry, dueObjects);
+      }
+
+      m_mutex.unlock();
+   }
+};
+
+#endif
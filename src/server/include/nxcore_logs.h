@@ -228,6 +228,21 @@ class NXCORE_EXPORTABLE LogFilter
    {
       return m_numOrderingColumns;
    }
+
+   const OrderingColumn *getOrderingColumn(int index) const
+   {
+      return &m_orderingColumns[index];
+   }
+};
+
+/**
+ * Column which is part of the key used for keyset (seek) pagination
+ */
+struct KeysetColumn
+{
+   const LOG_COLUMN *definition;
+   int index;        // Column index in query result
+   bool descending;
 };
 
 /**
@@ -240,16 +255,18 @@ class NXCORE_EXPORTABLE LogHandle
    LogFilter *m_filter;
    Mutex m_mutex;
    StringBuffer m_queryColumns;
-   uint32_t m_rowCountLimit;
    int64_t m_maxRecordId;
-   DB_RESULT m_resultSet;
+   StructArray<KeysetColumn> m_keyset;    // Empty if current ordering does not allow keyset pagination
+   IntegerArray<int64_t> m_cursorKey;     // Key of last row read by client
+   int64_t m_cursorRow;                   // Index of row following cursor position
+   bool m_endOfData;
 
    void buildQueryColumnList();
    StringBuffer buildObjectAccessConstraint(uint32_t userId);
-   void deleteQueryResults();
-   bool queryInternal(int64_t *rowCount, uint32_t userId);
+   bool buildKeyset(LogFilter *filter, StructArray<KeysetColumn> *keyset);
+   StringBuffer buildQuerySql(LogFilter *filter, int64_t maxRecordId, uint32_t userId, const StructArray<KeysetColumn>& keyset, const IntegerArray<int64_t> *cursor, int64_t limit);
+   void resetCursor();
    Table *createTable();
-   json_t *createRecordFromDBResult(DB_RESULT hResult, int row, bool includeDetailColumns);
 
 public:
    LogHandle(const NXCORE_LOG *log);
@@ -264,10 +281,12 @@ class NXCORE_EXPORTABLE LogHandle
    void getRecordDetails(int64_t recordId, NXCPMessage *msg);
    void getColumnInfo(NXCPMessage *msg);
    const LOG_COLUMN *getColumnDefinition(const TCHAR *name) const;
+   int64_t estimateRowCount(LogFilter *filter, uint32_t userId);
 
    json_t *getColumnInfoAsJson() const;
-   StringBuffer buildPagedQuerySql(LogFilter *filter, int64_t offset, int64_t limit, uint32_t userId);
-   json_t *queryAsJson(LogFilter *filter, int64_t offset, int64_t limit, uint32_t userId);
+   bool decodeCursor(LogFilter *filter, const char *cursor, IntegerArray<int64_t> *key);
+   StringBuffer buildPagedQuerySql(LogFilter *filter, int64_t offset, int64_t limit, const IntegerArray<int64_t> *cursor, uint32_t userId);
+   json_t *queryAsJson(LogFilter *filter, int64_t offset, int64_t limit, const IntegerArray<int64_t> *cursor, uint32_t userId, StringBuffer *nextCursor);
    uint32_t getRecordAsJson(int64_t recordId, json_t **record);
 };
 
@@ -279,5 +298,6 @@ shared_ptr<LogHandle> AcquireLogHandleObject(ClientSession *session, int32_t log
 const NXCORE_LOG NXCORE_EXPORTABLE *FindLogDefinition(const wchar_t *name);
 void NXCORE_EXPORTABLE EnumerateLogDefinitions(std::function<void(const NXCORE_LOG*)> callback);
 const char NXCORE_EXPORTABLE *LogColumnTypeName(int type);
+StringBuffer NXCORE_EXPORTABLE BuildLogSeekCondition(const StructArray<KeysetColumn>& keyset, const IntegerArray<int64_t>& key);
 
 #endif
@@ -141,6 +141,12 @@ class SyslogMessage
    const char *getStructuredData() const { return m_structuredData; }
 };
 
+/**
+ * Syslog message processing (syslogd.cpp)
+ */
+void QueueSyslogMessage(SyslogMessage *msg);
+int64_t GetSyslogProcessingQueueSize();
+
 /**
  * Syslog over TLS listener (syslog_tls.cpp)
  */
@@ -664,6 +664,7 @@ class LIBNXSRV_EXPORTABLE NObject : public enable_shared_from_this<NObject>
    bool isDirectChild(uint32_t id) const;
    bool isParent(uint32_t id) const;
    bool isDirectParent(uint32_t id) const;
+   void getAllParentIds(HashSet<uint32_t> *ids) const;
 
    int getChildCount() const { return m_childList.size(); }
    int getParentCount() const { return m_parentList.size(); }
@@ -1194,6 +1195,7 @@ class LIBNXSRV_EXPORTABLE AgentConnection : public enable_shared_from_this<Agent
    void processFileTransferAbort(NXCPMessage *msg);
 
    void processCollectedDataCallback(NXCPMessage *msg);
+   void processCollectedDataBatchCallback(NXCPMessage *msg);
    void onDataPushCallback(NXCPMessage *msg);
    void onFileMonitoringDataCallback(NXCPMessage *msg);
    void onSnmpTrapCallback(NXCPMessage *msg);
@@ -1221,6 +1223,7 @@ class LIBNXSRV_EXPORTABLE AgentConnection : public enable_shared_from_this<Agent
    virtual void onDisconnect();
    virtual uint32_t processCollectedData(NXCPMessage *msg);
    virtual uint32_t processBulkCollectedData(NXCPMessage *request, NXCPMessage *response);
+   virtual uint32_t processCollectedDataBatch(NXCPMessage *request, NXCPMessage *response);
    virtual bool processCustomMessage(NXCPMessage *pMsg);
    virtual void processTcpProxyData(uint32_t channelId, const void *data, size_t size, bool errorIndicator);
    virtual void processSSHChannelData(uint32_t channelId, const void *data, size_t size, bool errorIndicator);
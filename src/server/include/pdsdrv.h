@@ -29,7 +29,12 @@
 /**
  *API version
  */
-#define PDSDRV_API_VERSION          1
+#define PDSDRV_API_VERSION          2
+
+/**
+ * Driver capabilities
+ */
+#define PDSDRV_CAP_READ             0x0001   /* Driver can serve DCI history reads */
 
 /**
  * Driver header
@@ -41,6 +46,42 @@ int __EXPORT pdsdrvAPIVersion = PDSDRV_API_VERSION; \
 const wchar_t __EXPORT *pdsdrvName = name; \
 extern "C" PerfDataStorageDriver __EXPORT *pdsdrvCreateInstance() { return new implClass; }
 
+/**
+ * DCI value passed to driver in batch write request
+ */
+struct PerfDataItemSample
+{
+   DCItem *dci;
+   Timestamp timestamp;
+   Timestamp startTimestamp;  // Timestamp of previous collected value (null on first sample)
+   const wchar_t *value;
+};
+
+/**
+ * Table DCI value passed to driver in batch write request
+ */
+struct PerfDataTableSample
+{
+   DCTable *dci;
+   Timestamp timestamp;
+   Table *value;
+};
+
+/**
+ * Data point returned by driver on read request. For raw reads minValue and maxValue are equal
+ * to value and sampleCount is 1. For aggregated reads timestamp is bucket start and value is the
+ * result of requested aggregation function (average for DCI_HAGG_MINMAX). Data points are expected
+ * in the same order as database reads return them (newest first).
+ */
+struct PerfDataPoint
+{
+   Timestamp timestamp;
+   double value;
+   double minValue;
+   double maxValue;
+   uint32_t sampleCount;
+};
+
 /**
  * Base class for performance data storage drivers
  */
@@ -58,6 +99,12 @@ class NXCORE_EXPORTABLE PerfDataStorageDriver
 
    virtual bool saveDCItemValue(DCItem *dcObject, Timestamp timestamp, Timestamp startTimestamp, const wchar_t *value);
    virtual bool saveDCTableValue(DCTable *dcObject, Timestamp timestamp, Table *value);
+   virtual bool saveDCItemValues(const PerfDataItemSample *samples, size_t count);
+   virtual bool saveDCTableValues(const PerfDataTableSample *samples, size_t count);
+
+   virtual uint32_t getCapabilities();
+   virtual bool readDCItemValues(const DCItem& dci, Timestamp from, Timestamp to, int64_t bucketSize, DciAggregationFunction function,
+            uint32_t maxRows, StructArray<PerfDataPoint> *values);
 
    virtual DataCollectionError getInternalMetric(const wchar_t *metric, wchar_t *value);
 };
@@ -385,6 +385,22 @@ MessageReceiverResult AgentConnectionReceiver::readMessage(bool allowChannelRead
                delete msg;
             }
             break;
+         case CMD_DCI_DATA_BATCH:
+            if (g_agentConnectionThreadPool != nullptr)
+            {
+               // Batches are processed serially to preserve order of values within agent's send pipeline
+               TCHAR key[64];
+               CreateCallbackKey('D', this, key);
+               ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, connection, &AgentConnection::processCollectedDataBatchCallback, msg);
+            }
+            else
+            {
+               NXCPMessage response(CMD_REQUEST_COMPLETED, msg->getId(), connection->m_nProtocolVersion);
+               response.setField(VID_RCC, ERR_INTERNAL_ERROR);
+               connection->sendMessage(&response);
+               delete msg;
+            }
+            break;
          case CMD_GET_SSH_KEYS:
             if (g_agentConnectionThreadPool != nullptr)
             {
@@ -1363,6 +1379,7 @@ uint32_t AgentConnection::setServerCapabilities()
    msg.setField(VID_ENABLED, true);   // Enables IPv6 on pre-2.0 agents
    msg.setField(VID_IPV6_SUPPORT, true);
    msg.setField(VID_BULK_RECONCILIATION, true);
+   msg.setField(VID_DATA_BATCHING, true);
    msg.setField(VID_ENABLE_COMPRESSION, m_allowCompression);
    msg.setField(VID_ACCEPT_KEEPALIVE, true);
    msg.setId(requestId);
@@ -3334,6 +3351,17 @@ void AgentConnection::processCollectedDataCallback(NXCPMessage *msg)
    delete msg;
 }
 
+/**
+ * Callback for processing batch of collected data on separate thread
+ */
+void AgentConnection::processCollectedDataBatchCallback(NXCPMessage *msg)
+{
+   NXCPMessage response(CMD_REQUEST_COMPLETED, msg->getId(), m_nProtocolVersion);
+   response.setField(VID_RCC, processCollectedDataBatch(msg, &response));
+   sendMessage(&response);
+   delete msg;
+}
+
 /**
  * Process collected data information (for DCI with agent-side cache)
  */
@@ -3350,6 +3378,14 @@ uint32_t AgentConnection::processBulkCollectedData(NXCPMessage *request, NXCPMes
    return ERR_NOT_IMPLEMENTED;
 }
 
+/**
+ * Process batch of collected data pushed by agent's data sender (for DCI with agent-side cache)
+ */
+uint32_t AgentConnection::processCollectedDataBatch(NXCPMessage *request, NXCPMessage *response)
+{
+   return ERR_NOT_IMPLEMENTED;
+}
+
 /**
  * Callback for getting SSH keys by id
  */
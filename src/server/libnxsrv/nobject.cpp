@@ -245,6 +245,26 @@ bool NObject::isParent(uint32_t id) const
    return result;
 }
 
+/**
+ * Add IDs of all direct and indirect parents of this object to given set
+ *
+ * @param ids set to add parent IDs to
+ */
+void NObject::getAllParentIds(HashSet<uint32_t> *ids) const
+{
+   readLockParentList();
+   for(int i = 0; i < m_parentList.size(); i++)
+   {
+      NObject *parent = m_parentList.get(i);
+      if (!ids->contains(parent->getId()))
+      {
+         ids->put(parent->getId());
+         parent->getAllParentIds(ids);
+      }
+   }
+   unlockParentList();
+}
+
 /**
  * Check if given object is our direct parent
  *
@@ -23,6 +23,120 @@
 #include "nxdbmgr.h"
 #include <nxevent.h>
 
+/**
+ * Upgrade from 70.34 to 70.35
+ */
+static bool H_UpgradeFromV34()
+{
+   CHK_EXEC(CreateConfigParam(L"PerfDataStorage.MaxQueueSize", L"100000",
+         L"Maximum number of values waiting to be passed to performance data storage drivers. New values are not passed to drivers while queue is full. Set to 0 to disable limit.",
+         nullptr, 'I', true, false, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(35));
+   return true;
+}
+
+/**
+ * Upgrade from 70.33 to 70.34
+ */
+static bool H_UpgradeFromV33()
+{
+   CHK_EXEC(CreateConfigParam(L"NXSL.VMPoolSize", L"-1",
+         L"Maximum number of idle script virtual machines kept for reuse by data collection transformation, threshold, and instance filter scripts. Set to -1 to size pool automatically by number of distinct scripts in use, or to 0 to disable pooling.",
+         nullptr, 'I', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(34));
+   return true;
+}
+
+/**
+ * Upgrade from 70.32 to 70.33
+ */
+static bool H_UpgradeFromV32()
+{
+   CHK_EXEC(CreateConfigParam(L"Syslog.ProcessingThreads", L"1",
+         L"Number of syslog processing threads. Messages are distributed between threads by source address, so messages from same source are always processed in order. Syslog parser is cloned for each thread and parser instance is selected by node, so rule contexts and repeat counters are maintained per instance and shared only between nodes handled by same instance; messages from unknown sources are all matched by first instance.",
+         nullptr, 'I', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(33));
+   return true;
+}
+
+/**
+ * Upgrade from 70.31 to 70.32
+ */
+static bool H_UpgradeFromV31()
+{
+   CHK_EXEC(CreateConfigParam(L"ThreadPool.DataCollector.WorkStealing", L"0",
+         L"Use per-worker request queues with work stealing in data collector thread pool.",
+         nullptr, 'B', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(32));
+   return true;
+}
+
+/**
+ * Upgrade from 70.30 to 70.31
+ */
+static bool H_UpgradeFromV30()
+{
+   CHK_EXEC(CreateConfigParam(L"DataCollection.SNMP.AsyncEngineSockets", L"4",
+         L"Number of shared UDP sockets used by asynchronous SNMP engine.",
+         nullptr, 'I', true, true, false, false));
+   CHK_EXEC(CreateConfigParam(L"DataCollection.SNMP.UseAsyncEngine", L"0",
+         L"Collect single SNMPv1/v2c DCIs using asynchronous SNMP engine which multiplexes requests over small set of shared sockets instead of blocking data collector threads.",
+         nullptr, 'B', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(31));
+   return true;
+}
+
+/**
+ * Upgrade from 70.29 to 70.30
+ */
+static bool H_UpgradeFromV29()
+{
+   CHK_EXEC(CreateConfigParam(L"SNMP.TransportPool.IdleTimeout", L"120",
+         L"Time after which idle pooled SNMP transport is closed. Pooled transports are reused by data collection, polls, and MIB walks on same node. Set to 0 to disable transport pooling.",
+         L"seconds", 'I', true, false, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(30));
+   return true;
+}
+
+/**
+ * Upgrade from 70.28 to 70.29
+ */
+static bool H_UpgradeFromV28()
+{
+   CHK_EXEC(CreateConfigParam(L"SNMP.BulkWalk.MaxRepetitions", L"25",
+         L"Maximum number of repetitions in SNMP GETBULK requests used for walking MIB subtrees on SNMP version 2c and 3 agents. Set to 0 to always use GETNEXT requests.",
+         nullptr, 'I', true, false, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(29));
+   return true;
+}
+
+/**
+ * Upgrade from 70.27 to 70.28
+ */
+static bool H_UpgradeFromV27()
+{
+   CHK_EXEC(CreateConfigParam(L"DataCollection.SNMP.MaxVarbindsPerRequest", L"16",
+         L"Maximum number of varbinds in single SNMP request when SNMP request coalescing is enabled.",
+         nullptr, 'I', true, true, false, false));
+   CHK_EXEC(CreateConfigParam(L"DataCollection.SNMP.RequestCoalescing", L"0",
+         L"Collect SNMP DCIs which become due on same node at same time using combined multi-varbind requests.",
+         nullptr, 'B', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(28));
+   return true;
+}
+
+/**
+ * Upgrade from 70.26 to 70.27
+ */
+static bool H_UpgradeFromV26()
+{
+   CHK_EXEC(CreateConfigParam(L"DBWriter.UseBulkLoad", L"0",
+         L"Use bulk load (binary COPY) instead of INSERT statements for writing collected DCI data (only valid for PostgreSQL and TimescaleDB).",
+         nullptr, 'B', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(27));
+   return true;
+}
+
 /**
  * Upgrade from 70.25 to 70.26
  */
@@ -887,6 +1001,15 @@ static struct
    int nextMinor;
    bool (*upgradeProc)();
 } s_dbUpgradeMap[] = {
+   { 34, 70, 35, H_UpgradeFromV34 },
+   { 33, 70, 34, H_UpgradeFromV33 },
+   { 32, 70, 33, H_UpgradeFromV32 },
+   { 31, 70, 32, H_UpgradeFromV31 },
+   { 30, 70, 31, H_UpgradeFromV30 },
+   { 29, 70, 30, H_UpgradeFromV29 },
+   { 28, 70, 29, H_UpgradeFromV28 },
+   { 27, 70, 28, H_UpgradeFromV27 },
+   { 26, 70, 27, H_UpgradeFromV26 },
    { 25, 70, 26, H_UpgradeFromV25 },
    { 24, 70, 25, H_UpgradeFromV24 },
    { 23, 70, 24, H_UpgradeFromV23 },
@@ -20,6 +20,7 @@
 **/
 
 #include "webapi.h"
+#include <pdsdrv.h>
 
 /**
  * Parse `tier` query parameter — auto/raw/hourly/daily, case-insensitive. Numeric values
@@ -69,6 +70,69 @@ static const char* DciTierName(DciTier tier)
    }
 }
 
+/**
+ * Fill history response with data points read from performance data storage driver. Produces same
+ * JSON shape as database reads for given tier and aggregation mode.
+ */
+static void FillDataPointsFromPerfDataStorage(const StructArray<PerfDataPoint>& points, json_t *response, json_t *values,
+         const DCItem& dci, DciTier tier, DciAggregationFunction function, bool aggregated, int64_t bucketSizeMs)
+{
+   if (tier != DCI_TIER_RAW)
+   {
+      json_object_set_new(response, "aggregated", json_true());
+      const char *valueKey = "avg";
+      if (function == DCI_HAGG_MIN)
+         valueKey = "min";
+      else if (function == DCI_HAGG_MAX)
+         valueKey = "max";
+      for(int i = 0; i < points.size(); i++)
+      {
+         const PerfDataPoint *p = points.get(i);
+         json_t *dataPoint = json_object();
+         json_object_set_new(dataPoint, "timestamp", p->timestamp.asJson());
+         if (function == DCI_HAGG_MINMAX)
+         {
+            json_object_set_new(dataPoint, "avg", json_real(p->value));
+            json_object_set_new(dataPoint, "min", json_real(p->minValue));
+            json_object_set_new(dataPoint, "max", json_real(p->maxValue));
+         }
+         else
+         {
+            json_object_set_new(dataPoint, valueKey, json_real(p->value));
+         }
+         json_object_set_new(dataPoint, "sampleCount", json_integer(p->sampleCount));
+         json_array_append_new(values, dataPoint);
+      }
+   }
+   else if (aggregated)
+   {
+      json_object_set_new(response, "aggregated", json_true());
+      json_object_set_new(response, "bucketSize", json_integer(bucketSizeMs));
+      for(int i = 0; i < points.size(); i++)
+      {
+         const PerfDataPoint *p = points.get(i);
+         json_t *dataPoint = json_object();
+         json_object_set_new(dataPoint, "timestamp", p->timestamp.asJson());
+         json_object_set_new(dataPoint, "avg", json_real(p->value));
+         json_object_set_new(dataPoint, "min", json_real(p->minValue));
+         json_object_set_new(dataPoint, "max", json_real(p->maxValue));
+         json_array_append_new(values, dataPoint);
+      }
+   }
+   else
+   {
+      wchar_t buffer[64];
+      for(int i = 0; i < points.size(); i++)
+      {
+         const PerfDataPoint *p = points.get(i);
+         json_t *dataPoint = json_object();
+         json_object_set_new(dataPoint, "timestamp", p->timestamp.asJson());
+         json_object_set_new(dataPoint, "value", json_string_t(FormatPerfDataPointValue(*p, dci.getTransformedDataType(), buffer)));
+         json_array_append_new(values, dataPoint);
+      }
+   }
+}
+
 /**
  * Handler for /v1/objects/:object-id/data-collection/:dci-id/history
  */
@@ -157,6 +221,28 @@ int H_DataCollectionHistory(Context *context)
       }
    }
 
+   // Serve processed values from performance data storage driver if there is one with read capability
+   if ((historicalDataType == HDT_PROCESSED) && (g_flags & AF_PERFDATA_STORAGE_DRIVER_LOADED))
+   {
+      int64_t bucketSizeMs = 0;
+      if (useAggregation)
+      {
+         bucketSizeMs = (timeTo.asMilliseconds() - timeFrom.asMilliseconds()) / maxDataPoints;
+         if (bucketSizeMs < 1)
+            bucketSizeMs = 1;
+      }
+
+      StructArray<PerfDataPoint> points(0, 1024);
+      if (ReadDataFromPerfDataStorage(static_cast<DCItem&>(*dci), resolvedTier, useAggregation ? DCI_HAGG_MINMAX : aggFunction, bucketSizeMs,
+               timeFrom.isNull() ? 0 : timeFrom.asMilliseconds(), timeTo.isNull() ? 0 : timeTo.asMilliseconds(), maxRows, &points))
+      {
+         FillDataPointsFromPerfDataStorage(points, response, values, static_cast<DCItem&>(*dci), resolvedTier, aggFunction, useAggregation, bucketSizeMs);
+         context->setResponseData(response);
+         json_decref(response);
+         return 200;
+      }
+   }
+
    // Tier reads filter on bucket_start (idata_1h_<N>/idata_1d_<N> or unified TSDB views) which is
    // stored as a millisecond bigint on non-TSDB and timestamptz on TSDB. The raw path keeps the
    // existing idata_timestamp predicates so on-the-fly bucketing and full-table reads still work.
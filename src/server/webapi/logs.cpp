@@ -31,9 +31,9 @@
 #define MAX_LOG_QUERY_LIMIT       10000
 
 /**
- * Maximum number of records read from database by single query. Paging is done by
- * re-executing the query and skipping requested number of records, so this also limits
- * how far into the result set client can page.
+ * Maximum number of records read from database by single query. Paging by offset is done
+ * by re-executing the query and skipping requested number of records, so this also limits
+ * how far into the result set client can page by offset (paging by cursor is not limited).
  */
 #define MAX_LOG_QUERY_WINDOW      100000
 
@@ -111,12 +111,15 @@ int H_LogDetails(Context *context)
 }
 
 /**
- * Read paging parameters from query request document
+ * Read paging parameters from query request document. Cursor cannot be combined with offset.
  */
-static bool GetPagingParameters(json_t *request, int64_t *offset, int64_t *limit)
+static bool GetPagingParameters(json_t *request, int64_t *offset, int64_t *limit, const char **cursor)
 {
    *offset = json_object_get_int64(request, "offset", 0);
    *limit = json_object_get_int64(request, "limit", DEFAULT_LOG_QUERY_LIMIT);
+   *cursor = json_object_get_string_utf8(request, "cursor", nullptr);
+   if ((*cursor != nullptr) && ((**cursor == 0) || (*offset != 0)))
+      return false;
    return (*offset >= 0) && (*limit >= 1) && (*limit <= MAX_LOG_QUERY_LIMIT) && (*offset + *limit <= MAX_LOG_QUERY_WINDOW);
 }
 
@@ -203,9 +206,10 @@ int H_LogQuery(Context *context)
    }
 
    int64_t offset, limit;
-   if (!GetPagingParameters(request, &offset, &limit))
+   const char *cursor;
+   if (!GetPagingParameters(request, &offset, &limit, &cursor))
    {
-      context->setErrorResponse("Invalid offset or limit");
+      context->setErrorResponse("Invalid offset, limit, or cursor");
       return 400;
    }
 
@@ -217,7 +221,15 @@ int H_LogQuery(Context *context)
       return 400;
    }
 
-   json_t *records = handle.queryAsJson(&filter, offset, limit, context->getUserId());
+   IntegerArray<int64_t> cursorKey;
+   if ((cursor != nullptr) && !handle.decodeCursor(&filter, cursor, &cursorKey))
+   {
+      context->setErrorResponse("Invalid cursor");
+      return 400;
+   }
+
+   StringBuffer nextCursor;
+   json_t *records = handle.queryAsJson(&filter, offset, limit, (cursor != nullptr) ? &cursorKey : nullptr, context->getUserId(), &nextCursor);
    if (records == nullptr)
    {
       context->setErrorResponse("Database failure");
@@ -228,6 +240,14 @@ int H_LogQuery(Context *context)
    json_object_set_new(output, "columns", handle.getColumnInfoAsJson());
    json_object_set_new(output, "offset", json_integer(offset));
    json_object_set_new(output, "count", json_integer(json_array_size(records)));
+   if (!nextCursor.isEmpty())
+      json_object_set_new(output, "nextCursor", json_string_t(nextCursor));
+   if (json_object_get_boolean(request, "estimateCount", false))
+   {
+      int64_t estimate = handle.estimateRowCount(&filter, context->getUserId());
+      if (estimate >= 0)
+         json_object_set_new(output, "estimatedCount", json_integer(estimate));
+   }
    json_object_set_new(output, "records", records);
    AddResolvedValues(output, log, records, context->getUserId());
    context->setResponseData(output);
@@ -253,9 +273,10 @@ int H_LogQuerySql(Context *context)
    }
 
    int64_t offset, limit;
-   if (!GetPagingParameters(request, &offset, &limit))
+   const char *cursor;
+   if (!GetPagingParameters(request, &offset, &limit, &cursor))
    {
-      context->setErrorResponse("Invalid offset or limit");
+      context->setErrorResponse("Invalid offset, limit, or cursor");
       return 400;
    }
 
@@ -267,8 +288,15 @@ int H_LogQuerySql(Context *context)
       return 400;
    }
 
+   IntegerArray<int64_t> cursorKey;
+   if ((cursor != nullptr) && !handle.decodeCursor(&filter, cursor, &cursorKey))
+   {
+      context->setErrorResponse("Invalid cursor");
+      return 400;
+   }
+
    json_t *output = json_object();
-   json_object_set_new(output, "query", json_string_t(handle.buildPagedQuerySql(&filter, offset, limit, context->getUserId())));
+   json_object_set_new(output, "query", json_string_t(handle.buildPagedQuerySql(&filter, offset, limit, (cursor != nullptr) ? &cursorKey : nullptr, context->getUserId())));
    context->setResponseData(output);
    json_decref(output);
    return 200;
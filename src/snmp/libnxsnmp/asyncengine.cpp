@@ -0,0 +1,500 @@
+/*
+** NetXMS - Network Management System
+** SNMP support library
+** Copyright (C) 2003-2024 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation; either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: asyncengine.cpp
+**
+**/
+
+#include "libnxsnmp.h"
+
+#define DEBUG_TAG _T("snmp.async")
+
+/**
+ * Timer wheel tick duration in milliseconds
+ */
+#define TIMER_TICK 10
+
+/**
+ * Pending asynchronous request
+ */
+struct SNMP_AsyncRequest
+{
+   SNMP_AsyncRequest *prev;   // Timer wheel slot list
+   SNMP_AsyncRequest *next;
+   uint64_t expirationTick;
+   uint32_t requestId;
+   uint32_t timeout;
+   int retriesLeft;
+   SOCKET socket;
+   SockAddrBuffer addr;
+   BYTE *packet;
+   size_t packetSize;
+   SNMP_Codepage codepage;
+   SNMP_AsyncCallback callback;
+   uint32_t rcc;
+   SNMP_PDU *response;
+   SNMP_AsyncRequest *nextCompleted;
+
+   SNMP_AsyncRequest(const char *_codepage, SNMP_AsyncCallback _callback) : codepage(_codepage), callback(_callback)
+   {
+      prev = nullptr;
+      next = nullptr;
+      expirationTick = 0;
+      requestId = 0;
+      timeout = 0;
+      retriesLeft = 0;
+      socket = INVALID_SOCKET;
+      memset(&addr, 0, sizeof(addr));
+      packet = nullptr;
+      packetSize = 0;
+      rcc = SNMP_ERR_SUCCESS;
+      response = nullptr;
+      nextCompleted = nullptr;
+   }
+
+   ~SNMP_AsyncRequest()
+   {
+      MemFree(packet);
+   }
+};
+
+/**
+ * Create and bind UDP socket for given address family
+ */
+static SOCKET CreateEngineSocket(int family)
+{
+   SOCKET s = CreateSocket(family, SOCK_DGRAM, 0);
+   if (s == INVALID_SOCKET)
+      return INVALID_SOCKET;
+
+   SockAddrBuffer localAddr;
+   memset(&localAddr, 0, sizeof(localAddr));
+   if (family == AF_INET)
+   {
+      localAddr.sa4.sin_family = AF_INET;
+      localAddr.sa4.sin_addr.s_addr = INADDR_ANY;
+   }
+#ifdef WITH_IPV6
+   else
+   {
+      localAddr.sa6.sin6_family = AF_INET6;
+   }
+#endif
+   if (bind(s, &localAddr.sa, SA_LEN(&localAddr.sa)) != 0)
+   {
+      closesocket(s);
+      return INVALID_SOCKET;
+   }
+
+   SetSocketNonBlocking(s);
+   return s;
+}
+
+/**
+ * Asynchronous engine constructor
+ */
+SNMP_AsyncEngine::SNMP_AsyncEngine(int numSockets, ThreadPool *callbackPool) : m_mutex(MutexType::FAST)
+{
+   m_numSockets = std::max(1, std::min(numSockets, SOCKET_POLLER_MAX_SOCKETS / 2));
+   m_sockets = MemAllocArrayNoInit<SOCKET>(m_numSockets);
+   m_socketsV6 = MemAllocArrayNoInit<SOCKET>(m_numSockets);
+   for(int i = 0; i < m_numSockets; i++)
+   {
+      m_sockets[i] = INVALID_SOCKET;
+      m_socketsV6[i] = INVALID_SOCKET;
+   }
+   m_nextSocket = 0;
+   m_callbackPool = callbackPool;
+   memset(m_timerWheel, 0, sizeof(m_timerWheel));
+   m_currentTick = 0;
+   m_startTime = GetCurrentTimeMs();
+   m_nextRequestId = GetCurrentProcessId() << 16;
+   m_ioThread = INVALID_THREAD_HANDLE;
+   m_shutdown = false;
+}
+
+/**
+ * Asynchronous engine destructor
+ */
+SNMP_AsyncEngine::~SNMP_AsyncEngine()
+{
+   stop();
+   MemFree(m_sockets);
+   MemFree(m_socketsV6);
+}
+
+/**
+ * Start engine
+ */
+bool SNMP_AsyncEngine::start()
+{
+   if (m_ioThread != INVALID_THREAD_HANDLE)
+      return true;
+
+   int count = 0;
+   for(int i = 0; i < m_numSockets; i++)
+   {
+      m_sockets[i] = CreateEngineSocket(AF_INET);
+      if (m_sockets[i] != INVALID_SOCKET)
+         count++;
+#ifdef WITH_IPV6
+      m_socketsV6[i] = CreateEngineSocket(AF_INET6);
+#endif
+   }
+   if (count == 0)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Cannot create sockets for asynchronous SNMP engine"));
+      return false;
+   }
+
+   m_shutdown = false;
+   m_startTime = GetCurrentTimeMs();
+   m_currentTick = 0;
+   m_ioThread = ThreadCreateEx(this, &SNMP_AsyncEngine::ioThread);
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("Asynchronous SNMP engine started (%d sockets)"), count);
+   return true;
+}
+
+/**
+ * Stop engine. All pending requests are completed with SNMP_ERR_ABORTED.
+ */
+void SNMP_AsyncEngine::stop()
+{
+   if (m_ioThread == INVALID_THREAD_HANDLE)
+      return;
+
+   m_shutdown = true;
+   ThreadJoin(m_ioThread);
+   m_ioThread = INVALID_THREAD_HANDLE;
+
+   SNMP_AsyncRequest *completed = nullptr;
+   m_mutex.lock();
+   for(int i = 0; i < SNMP_ASYNC_TIMER_WHEEL_SIZE; i++)
+   {
+      SNMP_AsyncRequest *r = m_timerWheel[i];
+      while(r != nullptr)
+      {
+         SNMP_AsyncRequest *next = r->next;
+         r->rcc = SNMP_ERR_ABORTED;
+         r->nextCompleted = completed;
+         completed = r;
+         r = next;
+      }
+      m_timerWheel[i] = nullptr;
+   }
+   m_requests.clear();
+
+   for(int i = 0; i < m_numSockets; i++)
+   {
+      if (m_sockets[i] != INVALID_SOCKET)
+      {
+         closesocket(m_sockets[i]);
+         m_sockets[i] = INVALID_SOCKET;
+      }
+      if (m_socketsV6[i] != INVALID_SOCKET)
+      {
+         closesocket(m_socketsV6[i]);
+         m_socketsV6[i] = INVALID_SOCKET;
+      }
+   }
+   m_mutex.unlock();
+
+   while(completed != nullptr)
+   {
+      SNMP_AsyncRequest *next = completed->nextCompleted;
+      completeRequest(completed, completed->rcc, nullptr);
+      completed = next;
+   }
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("Asynchronous SNMP engine stopped"));
+}
+
+/**
+ * Get current timer wheel tick
+ */
+uint64_t SNMP_AsyncEngine::getTick() const
+{
+   return static_cast<uint64_t>(GetCurrentTimeMs() - m_startTime) / TIMER_TICK;
+}
+
+/**
+ * Put request into timer wheel (engine lock must be held)
+ */
+void SNMP_AsyncEngine::scheduleTimer(SNMP_AsyncRequest *request)
+{
+   request->expirationTick = getTick() + std::max(request->timeout / TIMER_TICK, static_cast<uint32_t>(1));
+   SNMP_AsyncRequest **slot = &m_timerWheel[request->expirationTick % SNMP_ASYNC_TIMER_WHEEL_SIZE];
+   request->prev = nullptr;
+   request->next = *slot;
+   if (*slot != nullptr)
+      (*slot)->prev = request;
+   *slot = request;
+}
+
+/**
+ * Remove request from timer wheel (engine lock must be held)
+ */
+void SNMP_AsyncEngine::cancelTimer(SNMP_AsyncRequest *request)
+{
+   if (request->prev != nullptr)
+      request->prev->next = request->next;
+   else
+      m_timerWheel[request->expirationTick % SNMP_ASYNC_TIMER_WHEEL_SIZE] = request->next;
+   if (request->next != nullptr)
+      request->next->prev = request->prev;
+   request->prev = nullptr;
+   request->next = nullptr;
+}
+
+/**
+ * Complete request - call callback and destroy request object (engine lock must not be held)
+ */
+void SNMP_AsyncEngine::completeRequest(SNMP_AsyncRequest *request, uint32_t rcc, SNMP_PDU *response)
+{
+   if (m_callbackPool != nullptr)
+   {
+      SNMP_AsyncCallback callback = std::move(request->callback);
+      ThreadPoolExecute(m_callbackPool,
+         [callback, rcc, response] () -> void
+         {
+            callback(rcc, response);
+         });
+   }
+   else
+   {
+      request->callback(rcc, response);
+   }
+   delete request;
+}
+
+/**
+ * Send request. Request ID in given PDU is replaced by engine-assigned one. Request PDU is encoded
+ * immediately and can be destroyed by caller after this method returns. Callback is called
+ * (on callback thread pool if one was provided) when response is received, request times out after
+ * all retries, or engine is stopped. Callback is not called if this method returns an error.
+ */
+uint32_t SNMP_AsyncEngine::sendRequest(SNMP_PDU *request, const InetAddress& addr, uint16_t port, SNMP_SecurityContext *securityContext,
+         uint32_t timeout, int numRetries, SNMP_AsyncCallback callback, const char *codepage)
+{
+   if ((request == nullptr) || (request->getVersion() == SNMP_VERSION_3) || !addr.isValid() || (numRetries <= 0))
+      return SNMP_ERR_PARAM;
+
+   if (m_ioThread == INVALID_THREAD_HANDLE)
+      return SNMP_ERR_ABORTED;
+
+   SOCKET *sockets = (addr.getFamily() == AF_INET) ? m_sockets : m_socketsV6;
+   SOCKET s = sockets[static_cast<uint32_t>(InterlockedIncrement(&m_nextSocket)) % m_numSockets];
+   if (s == INVALID_SOCKET)
+      return SNMP_ERR_SOCKET;
+
+   auto r = new SNMP_AsyncRequest(codepage, callback);
+   r->timeout = (timeout > 0) ? timeout : 1;
+   r->retriesLeft = numRetries - 1;
+   r->socket = s;
+   addr.fillSockAddr(&r->addr, port);
+
+   m_mutex.lock();
+
+   do
+   {
+      m_nextRequestId = (m_nextRequestId + 1) & 0x7FFFFFFF;
+   } while((m_nextRequestId == 0) || (m_requests.get(m_nextRequestId) != nullptr));
+   r->requestId = m_nextRequestId;
+   request->setRequestId(r->requestId);
+
+   SNMP_PDUBuffer buffer;
+   r->packetSize = request->encode(&buffer, securityContext);
+   if (r->packetSize == 0)
+   {
+      m_mutex.unlock();
+      delete r;
+      return SNMP_ERR_PARAM;
+   }
+   r->packet = MemCopyBlock(buffer.buffer(), r->packetSize);
+
+   // Register request before sending to avoid race with fast response
+   m_requests.set(r->requestId, r);
+   scheduleTimer(r);
+   if (sendto(s, reinterpret_cast<char*>(r->packet), static_cast<int>(r->packetSize), 0, &r->addr.sa, SA_LEN(&r->addr.sa)) <= 0)
+   {
+      cancelTimer(r);
+      m_requests.remove(r->requestId);
+      m_mutex.unlock();
+      delete r;
+      return SNMP_ERR_COMM;
+   }
+
+   m_mutex.unlock();
+   return SNMP_ERR_SUCCESS;
+}
+
+/**
+ * Get number of pending requests
+ */
+int SNMP_AsyncEngine::getPendingRequestCount()
+{
+   m_mutex.lock();
+   int count = m_requests.size();
+   m_mutex.unlock();
+   return count;
+}
+
+/**
+ * Process incoming packet on given socket
+ */
+void SNMP_AsyncEngine::processIncomingPacket(SOCKET s, BYTE *buffer, size_t bufferSize)
+{
+   SockAddrBuffer sender;
+   socklen_t addrLen = sizeof(sender);
+   int bytes = recvfrom(s, reinterpret_cast<char*>(buffer), static_cast<int>(bufferSize), 0, &sender.sa, &addrLen);
+   if (bytes <= 0)
+      return;
+
+   // Only SNMPv1 and SNMPv2c messages are accepted - check version before full parsing
+   uint32_t type, version;
+   size_t length, idLength;
+   const BYTE *curr;
+   if (!BER_DecodeIdentifier(buffer, bytes, &type, &length, &curr, &idLength) || (type != ASN_SEQUENCE))
+      return;
+   size_t remaining = bytes - idLength;
+   if (!BER_DecodeIdentifier(curr, remaining, &type, &length, &curr, &idLength) || (type != ASN_INTEGER) ||
+       !BER_DecodeContent(type, curr, length, reinterpret_cast<BYTE*>(&version)) ||
+       ((version != SNMP_VERSION_1) && (version != SNMP_VERSION_2C)))
+      return;
+
+   SNMP_PDU *response = new SNMP_PDU();
+   if (!response->parse(buffer, bytes, nullptr, false))
+   {
+      delete response;
+      return;
+   }
+
+   m_mutex.lock();
+   SNMP_AsyncRequest *r = m_requests.get(response->getRequestId());
+   if ((r == nullptr) || (r->socket != s) || !SocketAddressEquals(&sender.sa, &r->addr.sa))
+   {
+      m_mutex.unlock();
+      nxlog_debug_tag(DEBUG_TAG, 7, _T("Unexpected response with request ID %u"), response->getRequestId());
+      delete response;
+      return;
+   }
+   cancelTimer(r);
+   m_requests.remove(r->requestId);
+   m_mutex.unlock();
+
+   if (!r->codepage.isNull())
+      response->setCodepage(r->codepage);
+   if (response->getCommand() == SNMP_RESPONSE)
+   {
+      completeRequest(r, SNMP_ERR_SUCCESS, response);
+   }
+   else
+   {
+      delete response;
+      completeRequest(r, SNMP_ERR_BAD_RESPONSE, nullptr);
+   }
+}
+
+/**
+ * Process expired timers. Requests with retries left are re-sent, other requests are completed with timeout error.
+ */
+void SNMP_AsyncEngine::processTimers()
+{
+   uint64_t now = getTick();
+   if (now <= m_currentTick)
+      return;
+
+   SNMP_AsyncRequest *completed = nullptr;
+   m_mutex.lock();
+
+   // Scan each slot passed since last call, but not more than full wheel turn
+   uint64_t start = (now - m_currentTick > SNMP_ASYNC_TIMER_WHEEL_SIZE) ? now - SNMP_ASYNC_TIMER_WHEEL_SIZE + 1 : m_currentTick + 1;
+   for(uint64_t tick = start; tick <= now; tick++)
+   {
+      SNMP_AsyncRequest *r = m_timerWheel[tick % SNMP_ASYNC_TIMER_WHEEL_SIZE];
+      while(r != nullptr)
+      {
+         SNMP_AsyncRequest *next = r->next;
+         if (r->expirationTick <= now)
+         {
+            cancelTimer(r);
+            if ((r->retriesLeft > 0) &&
+                (sendto(r->socket, reinterpret_cast<char*>(r->packet), static_cast<int>(r->packetSize), 0, &r->addr.sa, SA_LEN(&r->addr.sa)) > 0))
+            {
+               r->retriesLeft--;
+               scheduleTimer(r);
+            }
+            else
+            {
+               m_requests.remove(r->requestId);
+               r->rcc = (r->retriesLeft > 0) ? SNMP_ERR_COMM : SNMP_ERR_TIMEOUT;
+               r->nextCompleted = completed;
+               completed = r;
+            }
+         }
+         r = next;
+      }
+   }
+   m_currentTick = now;
+   m_mutex.unlock();
+
+   while(completed != nullptr)
+   {
+      SNMP_AsyncRequest *next = completed->nextCompleted;
+      completeRequest(completed, completed->rcc, nullptr);
+      completed = next;
+   }
+}
+
+/**
+ * I/O thread
+ */
+void SNMP_AsyncEngine::ioThread()
+{
+   nxlog_debug_tag(DEBUG_TAG, 3, _T("Asynchronous SNMP engine I/O thread started"));
+
+   BYTE *buffer = static_cast<BYTE*>(MemAlloc(SNMP_DEFAULT_MSG_MAX_SIZE));
+   SocketPoller sp;
+   while(!m_shutdown)
+   {
+      sp.reset();
+      for(int i = 0; i < m_numSockets; i++)
+      {
+         if (m_sockets[i] != INVALID_SOCKET)
+            sp.add(m_sockets[i]);
+         if (m_socketsV6[i] != INVALID_SOCKET)
+            sp.add(m_socketsV6[i]);
+      }
+
+      if (sp.poll(TIMER_TICK) > 0)
+      {
+         for(int i = 0; i < m_numSockets; i++)
+         {
+            if ((m_sockets[i] != INVALID_SOCKET) && sp.isSet(m_sockets[i]))
+               processIncomingPacket(m_sockets[i], buffer, SNMP_DEFAULT_MSG_MAX_SIZE);
+            if ((m_socketsV6[i] != INVALID_SOCKET) && sp.isSet(m_socketsV6[i]))
+               processIncomingPacket(m_socketsV6[i], buffer, SNMP_DEFAULT_MSG_MAX_SIZE);
+         }
+      }
+
+      processTimers();
+   }
+   MemFree(buffer);
+
+   nxlog_debug_tag(DEBUG_TAG, 3, _T("Asynchronous SNMP engine I/O thread stopped"));
+}
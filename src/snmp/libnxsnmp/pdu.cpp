@@ -56,6 +56,8 @@ static struct
    { ASN_TRAP_V2_PDU, SNMP_VERSION_3, SNMP_TRAP },
    { ASN_GET_REQUEST_PDU, -1, SNMP_GET_REQUEST },
    { ASN_GET_NEXT_REQUEST_PDU, -1, SNMP_GET_NEXT_REQUEST },
+   { ASN_GET_BULK_REQUEST_PDU, SNMP_VERSION_2C, SNMP_GET_BULK_REQUEST },
+   { ASN_GET_BULK_REQUEST_PDU, SNMP_VERSION_3, SNMP_GET_BULK_REQUEST },
    { ASN_SET_REQUEST_PDU, -1, SNMP_SET_REQUEST },
    { ASN_RESPONSE_PDU, -1, SNMP_RESPONSE },
    { ASN_REPORT_PDU, -1, SNMP_REPORT },
@@ -656,6 +658,10 @@ bool SNMP_PDU::parsePdu(const BYTE *pdu, size_t pduLength)
             m_command = SNMP_GET_NEXT_REQUEST;
             success = parsePduContent(content, length);
             break;
+         case ASN_GET_BULK_REQUEST_PDU:
+            m_command = SNMP_GET_BULK_REQUEST;
+            success = parsePduContent(content, length);
+            break;
          case ASN_RESPONSE_PDU:
             m_command = SNMP_RESPONSE;
             success = parsePduContent(content, length);
@@ -330,34 +330,120 @@ static inline uint64_t HashObjectId(const uint32_t *value, size_t length)
 }
 
 /**
- * Enumerate multiple values by walking through MIB, starting at given root
+ * SNMP walk state - current position within walked subtree and loop detection data.
+ * Shared by GETNEXT and GETBULK walk implementations.
  */
-uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const uint32_t *rootOid, size_t rootOidLen, std::function<uint32_t (SNMP_Variable*)> handler, bool logErrors, bool failOnShutdown)
+class SnmpWalkState
 {
-   if (transport == nullptr)
-      return SNMP_ERR_COMM;
-
-   // First OID to request
-   uint32_t objectName[MAX_OID_LEN];
-   memcpy(objectName, rootOid, rootOidLen * sizeof(uint32_t));
-   size_t nameLength = rootOidLen;
+private:
+   const uint32_t *m_rootOid;
+   size_t m_rootOidLen;
+   uint32_t m_objectName[MAX_OID_LEN];
+   size_t m_nameLength;
 
    // Loop detection: ring buffer of recent response OID hashes. We accept OID_PRECEDING responses
    // (some agents, e.g. H3C Q-BRIDGE FDB, return rows in hash-bucket order rather than sorted),
    // but abort the walk if any response OID has already been seen. The dense ring catches short
    // cycles immediately; cycles longer than the ring are caught by the Brent-style milestone below.
-   uint64_t recentHashes[SNMP_WALK_LOOP_DETECT_RING_SIZE];
-   size_t recentCount = 0;
-   size_t recentNext = 0;
+   uint64_t m_recentHashes[SNMP_WALK_LOOP_DETECT_RING_SIZE];
+   size_t m_recentCount;
+   size_t m_recentNext;
 
    // Brent-style milestone: a single hash refreshed at exponentially-spaced iterations
    // (1, 2, 4, 8, ...). Guarantees detection of any cycle of length L within O(L) iterations
    // after the milestone falls inside the cycle, using O(1) extra memory.
-   size_t walkIteration = 0;
-   size_t milestoneIteration = 1;
-   uint64_t milestoneHash = 0;
+   size_t m_walkIteration;
+   size_t m_milestoneIteration;
+   uint64_t m_milestoneHash;
+
+public:
+   SnmpWalkState(const uint32_t *rootOid, size_t rootOidLen)
+   {
+      m_rootOid = rootOid;
+      m_rootOidLen = rootOidLen;
+      memcpy(m_objectName, rootOid, rootOidLen * sizeof(uint32_t));
+      m_nameLength = rootOidLen;
+      m_recentCount = 0;
+      m_recentNext = 0;
+      m_walkIteration = 0;
+      m_milestoneIteration = 1;
+      m_milestoneHash = 0;
+   }
 
-   // Walk the MIB
+   /**
+    * Get OID of last accepted variable (or root OID if none was accepted yet)
+    */
+   const uint32_t *getObjectName() const { return m_objectName; }
+   size_t getObjectNameLength() const { return m_nameLength; }
+
+   bool acceptVariable(const SNMP_Variable *var);
+};
+
+/**
+ * Check variable received from agent and advance walk position. Returns false if variable
+ * indicates end of walk (end of MIB view, left requested subtree, or loop detected).
+ */
+bool SnmpWalkState::acceptVariable(const SNMP_Variable *var)
+{
+   if ((var->getType() == ASN_NO_SUCH_OBJECT) ||
+       (var->getType() == ASN_NO_SUCH_INSTANCE) ||
+       (var->getType() == ASN_END_OF_MIBVIEW))
+   {
+      // Consider no object/no instance as end of walk signal instead of failure
+      return false;
+   }
+
+   // Check if response left the requested subtree
+   const SNMP_ObjectId& name = var->getName();
+   if ((name.length() < m_rootOidLen) || memcmp(m_rootOid, name.value(), m_rootOidLen * sizeof(uint32_t)))
+      return false;
+
+   // Loop detection
+   int cr = name.compare(m_objectName, m_nameLength);
+   if (cr == OID_EQUAL)
+      return false;  // Got same object again
+
+   uint64_t responseHash = HashObjectId(name.value(), name.length());
+
+   // Brent milestone: O(1) check that catches cycles of any length.
+   // On power-of-2 iterations, refresh the milestone with the current hash;
+   // on all other iterations, compare the current hash against the stored milestone.
+   m_walkIteration++;
+   if (m_walkIteration == m_milestoneIteration)
+   {
+      m_milestoneHash = responseHash;
+      m_milestoneIteration *= 2;
+   }
+   else if (responseHash == m_milestoneHash)
+   {
+      return false;
+   }
+
+   // Dense ring: scan recent hashes only when the agent moved backward.
+   // Catches short cycles within one period without scanning on every forward step.
+   if ((cr == OID_PRECEDING) || (cr == OID_SHORTER))
+   {
+      for (size_t i = 0; i < m_recentCount; i++)
+      {
+         if (m_recentHashes[i] == responseHash)
+            return false;
+      }
+   }
+   m_recentHashes[m_recentNext] = responseHash;
+   m_recentNext = (m_recentNext + 1) % SNMP_WALK_LOOP_DETECT_RING_SIZE;
+   if (m_recentCount < SNMP_WALK_LOOP_DETECT_RING_SIZE)
+      m_recentCount++;
+
+   m_nameLength = name.length();
+   memcpy(m_objectName, name.value(), m_nameLength * sizeof(uint32_t));
+   return true;
+}
+
+/**
+ * Walk MIB using GETNEXT requests, starting at current position of walk state
+ */
+static uint32_t SnmpWalkUsingGetNext(SNMP_Transport *transport, SnmpWalkState *state, std::function<uint32_t (SNMP_Variable*)> handler, bool failOnShutdown)
+{
    uint32_t result;
    bool running = true;
    while(running)
@@ -369,7 +455,7 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const uint32_t
       }
 
       SNMP_PDU requestPDU(SNMP_GET_NEXT_REQUEST, static_cast<uint32_t>(InterlockedIncrement(&s_requestId)) & 0x7FFFFFFF, transport->getSnmpVersion());
-      requestPDU.bindVariable(new SNMP_Variable(objectName, nameLength));
+      requestPDU.bindVariable(new SNMP_Variable(state->getObjectName(), state->getObjectNameLength()));
       SNMP_PDU *responsePDU;
       result = transport->doRequest(&requestPDU, &responsePDU);
 
@@ -380,65 +466,8 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const uint32_t
              (responsePDU->getErrorCode() == SNMP_PDU_ERR_SUCCESS))
          {
             SNMP_Variable *var = responsePDU->getVariable(0);
-
-            if ((var->getType() != ASN_NO_SUCH_OBJECT) &&
-                (var->getType() != ASN_NO_SUCH_INSTANCE) &&
-                (var->getType() != ASN_END_OF_MIBVIEW))
+            if (state->acceptVariable(var))
             {
-               // Check if response left the requested subtree
-               if ((var->getName().length() < rootOidLen) ||
-                   memcmp(rootOid, var->getName().value(), rootOidLen * sizeof(uint32_t)))
-               {
-                  delete responsePDU;
-                  break;
-               }
-
-               // Loop detection
-               int cr = var->getName().compare(objectName, nameLength);
-               if (cr == OID_EQUAL)
-               {
-                  // Got same object again
-                  delete responsePDU;
-                  break;
-               }
-               uint64_t responseHash = HashObjectId(var->getName().value(), var->getName().length());
-
-               // Brent milestone: O(1) check that catches cycles of any length.
-               // On power-of-2 iterations, refresh the milestone with the current hash;
-               // on all other iterations, compare the current hash against the stored milestone.
-               walkIteration++;
-               if (walkIteration == milestoneIteration)
-               {
-                  milestoneHash = responseHash;
-                  milestoneIteration *= 2;
-               }
-               else if (responseHash == milestoneHash)
-               {
-                  delete responsePDU;
-                  goto stop_walk;
-               }
-
-               // Dense ring: scan recent hashes only when the agent moved backward.
-               // Catches short cycles within one period without scanning on every forward step.
-               if ((cr == OID_PRECEDING) || (cr == OID_SHORTER))
-               {
-                  for (size_t i = 0; i < recentCount; i++)
-                  {
-                     if (recentHashes[i] == responseHash)
-                     {
-                        delete responsePDU;
-                        goto stop_walk;
-                     }
-                  }
-               }
-               recentHashes[recentNext] = responseHash;
-               recentNext = (recentNext + 1) % SNMP_WALK_LOOP_DETECT_RING_SIZE;
-               if (recentCount < SNMP_WALK_LOOP_DETECT_RING_SIZE)
-                  recentCount++;
-
-               nameLength = var->getName().length();
-               memcpy(objectName, var->getName().value(), nameLength * sizeof(uint32_t));
-
                // Call user's callback function for processing
                result = handler(var);
                if (result != SNMP_ERR_SUCCESS)
@@ -448,7 +477,6 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const uint32_t
             }
             else
             {
-               // Consider no object/no instance as end of walk signal instead of failure
                running = false;
             }
          }
@@ -467,10 +495,122 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const uint32_t
          running = false;
       }
    }
-stop_walk:
    return result;
 }
 
+/**
+ * Walk MIB using GETBULK requests, starting at current position of walk state. Number of
+ * max-repetitions is adapted on the fly within the walk: it grows after each full response and
+ * shrinks when agent responds with tooBig or stops responding after some data was received.
+ * Transport is not modified, so walks over pooled transports are independent of each other.
+ */
+static uint32_t SnmpWalkUsingGetBulk(SNMP_Transport *transport, SnmpWalkState *state, std::function<uint32_t (SNMP_Variable*)> handler, bool failOnShutdown)
+{
+   const uint32_t limit = transport->getBulkWalkMaxRepetitions();
+   uint32_t maxRepetitions = std::min(limit, static_cast<uint32_t>(SNMP_BULK_WALK_INITIAL_REPETITIONS));
+   uint32_t result;
+   bool running = true;
+   bool dataReceived = false;
+   while(running)
+   {
+      if (failOnShutdown && IsShutdownInProgress())
+      {
+         result = SNMP_ERR_ABORTED;
+         break;
+      }
+
+      SNMP_PDU requestPDU(SNMP_GET_BULK_REQUEST, static_cast<uint32_t>(InterlockedIncrement(&s_requestId)) & 0x7FFFFFFF, transport->getSnmpVersion());
+      requestPDU.setBulkParameters(0, maxRepetitions);
+      requestPDU.bindVariable(new SNMP_Variable(state->getObjectName(), state->getObjectNameLength()));
+      SNMP_PDU *responsePDU;
+      result = transport->doRequest(&requestPDU, &responsePDU);
+
+      if (result == SNMP_ERR_TIMEOUT)
+      {
+         // If agent already responded during this walk, response may be dropped somewhere on the path
+         // because of its size. Otherwise agent is most likely unreachable and walk should fail immediately.
+         if (dataReceived && (maxRepetitions > 1))
+         {
+            maxRepetitions = std::max(maxRepetitions / 2, static_cast<uint32_t>(1));
+            nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 7, _T("SnmpWalk: timeout on GETBULK request, max-repetitions reduced to %u"), maxRepetitions);
+            continue;
+         }
+         nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 7, _T("Error %u processing SNMP GETBULK request"), result);
+         break;
+      }
+
+      if (result != SNMP_ERR_SUCCESS)
+      {
+         nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 7, _T("Error %u processing SNMP GETBULK request"), result);
+         break;
+      }
+
+      SNMP_ErrorCode errorCode = responsePDU->getErrorCode();
+      if (errorCode == SNMP_PDU_ERR_SUCCESS)
+      {
+         int count = responsePDU->getNumVariables();
+         if (count == 0)
+         {
+            running = false;
+         }
+         for(int i = 0; (i < count) && running; i++)
+         {
+            SNMP_Variable *var = responsePDU->getVariable(i);
+            if (state->acceptVariable(var))
+            {
+               dataReceived = true;
+               result = handler(var);
+               if (result != SNMP_ERR_SUCCESS)
+                  running = false;
+            }
+            else
+            {
+               running = false;
+            }
+         }
+         if (running && (static_cast<uint32_t>(count) >= maxRepetitions))
+            maxRepetitions = std::min(maxRepetitions * 2, limit);
+         delete responsePDU;
+      }
+      else if ((errorCode == SNMP_PDU_ERR_TOO_BIG) && (maxRepetitions > 1))
+      {
+         delete responsePDU;
+         maxRepetitions = std::max(maxRepetitions / 2, static_cast<uint32_t>(1));
+         nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 7, _T("SnmpWalk: tooBig error on GETBULK request, max-repetitions reduced to %u"), maxRepetitions);
+      }
+      else
+      {
+         delete responsePDU;
+         if (errorCode == SNMP_PDU_ERR_NO_SUCH_NAME)
+            break;   // Some SNMP agents sends NO_SUCH_NAME PDU error after last element in MIB
+         if (!dataReceived)
+         {
+            // Agent may not support GETBULK at all - continue with GETNEXT requests
+            nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 6, _T("SnmpWalk: agent returned error %d on GETBULK request, falling back to GETNEXT"), static_cast<int>(errorCode));
+            return SnmpWalkUsingGetNext(transport, state, handler, failOnShutdown);
+         }
+         result = SNMP_ERR_AGENT;
+         break;
+      }
+   }
+   return result;
+}
+
+/**
+ * Enumerate multiple values by walking through MIB, starting at given root. GETBULK requests
+ * are used if transport is configured for bulk walk and SNMP version is 2c or 3.
+ */
+uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const uint32_t *rootOid, size_t rootOidLen, std::function<uint32_t (SNMP_Variable*)> handler, bool logErrors, bool failOnShutdown)
+{
+   if (transport == nullptr)
+      return SNMP_ERR_COMM;
+
+   SnmpWalkState state(rootOid, rootOidLen);
+   return ((transport->getSnmpVersion() != SNMP_VERSION_1) && transport->isBulkWalkEnabled()) ?
+      SnmpWalkUsingGetBulk(transport, &state, handler, failOnShutdown) :
+      SnmpWalkUsingGetNext(transport, &state, handler, failOnShutdown);
+}
+
 /**
  * Handler for counting walk
  */
@@ -0,0 +1,175 @@
+/*
+** NetXMS agent data sender unit tests
+** Copyright (C) 2026 Raden Solutions
+*/
+
+#include <nms_common.h>
+#include <nms_util.h>
+#include <testtools.h>
+#include <netxms-version.h>
+#include "datasender.h"
+
+NETXMS_EXECUTABLE_HEADER(test-unit-datasender)
+
+/**
+ * Batch timeout used in tests
+ */
+#define TEST_TIMEOUT    10000
+
+/**
+ * Test batch
+ */
+struct TestBatch
+{
+   uint64_t serverId;
+   int64_t sendTime;
+   uint32_t requestId;
+
+   TestBatch(uint64_t _serverId, int64_t _sendTime, uint32_t _requestId)
+   {
+      serverId = _serverId;
+      sendTime = _sendTime;
+      requestId = _requestId;
+   }
+};
+
+/**
+ * Test that batches are taken from window in send order
+ */
+static void TestSendOrder()
+{
+   StartTest(_T("Data sender window: send order"));
+
+   DataSenderWindow<TestBatch> window(TEST_TIMEOUT);
+   AssertTrue(window.isEmpty());
+   AssertNull(window.oldest());
+   AssertNull(window.takeOldest());
+
+   for(uint32_t i = 1; i <= 5; i++)
+      window.add(new TestBatch(1, 1000, i));
+   AssertEquals(window.size(), 5);
+   AssertEquals(window.oldest()->requestId, 1u);
+
+   for(uint32_t i = 1; i <= 5; i++)
+   {
+      TestBatch *batch = window.takeOldest();
+      AssertNotNull(batch);
+      AssertEquals(batch->requestId, i);
+      delete batch;
+   }
+   AssertTrue(window.isEmpty());
+
+   EndTest();
+}
+
+/**
+ * Test acknowledgement wait time calculation
+ */
+static void TestWaitTime()
+{
+   StartTest(_T("Data sender window: wait time"));
+
+   DataSenderWindow<TestBatch> window(TEST_TIMEOUT);
+   TestBatch batch(1, 100000, 1);
+
+   AssertEquals(window.getWaitTime(&batch, 100000), static_cast<uint32_t>(TEST_TIMEOUT));
+   AssertEquals(window.getWaitTime(&batch, 103000), static_cast<uint32_t>(TEST_TIMEOUT - 3000));
+   AssertEquals(window.getWaitTime(&batch, 109999), 1u);
+   AssertEquals(window.getWaitTime(&batch, 110000), 0u);
+   AssertEquals(window.getWaitTime(&batch, 200000), 0u);
+
+   // Clock going backwards should not produce longer than configured timeout
+   AssertEquals(window.getWaitTime(&batch, 90000), static_cast<uint32_t>(TEST_TIMEOUT));
+
+   EndTest();
+}
+
+/**
+ * Test that draining full window takes about one timeout in total when no acknowledgements arrive
+ */
+static void TestDrainTime()
+{
+   StartTest(_T("Data sender window: drain time"));
+
+   DataSenderWindow<TestBatch> window(TEST_TIMEOUT);
+   for(uint32_t i = 0; i < 8; i++)
+      window.add(new TestBatch(1, 100000 + i * 10, i));
+
+   // Simulate sequential waits where every wait runs to its timeout
+   int64_t now = 100050;
+   uint32_t totalWaitTime = 0;
+   while(!window.isEmpty())
+   {
+      TestBatch *batch = window.takeOldest();
+      uint32_t waitTime = window.getWaitTime(batch, now);
+      totalWaitTime += waitTime;
+      now += waitTime;
+      delete batch;
+   }
+
+   // Total wait ends at timeout of the last sent batch
+   AssertEquals(totalWaitTime, static_cast<uint32_t>(TEST_TIMEOUT + 70 - 50));
+
+   EndTest();
+}
+
+/**
+ * Test removal of later batches for server after oldest batch was not fully accepted
+ */
+static void TestTakeServerBatches()
+{
+   StartTest(_T("Data sender window: take server batches"));
+
+   DataSenderWindow<TestBatch> window(TEST_TIMEOUT);
+   window.add(new TestBatch(1, 1000, 1));
+   window.add(new TestBatch(2, 1000, 2));
+   window.add(new TestBatch(1, 1000, 3));
+   window.add(new TestBatch(3, 1000, 4));
+   window.add(new TestBatch(1, 1000, 5));
+   window.add(new TestBatch(2, 1000, 6));
+
+   // Oldest batch (server 1) failed - later batches for server 1 should be deferred in send order
+   TestBatch *failed = window.takeOldest();
+   AssertEquals(failed->requestId, 1u);
+
+   ObjectArray<TestBatch> laterBatches(16, 16, Ownership::True);
+   window.takeServerBatches(failed->serverId, &laterBatches);
+   AssertEquals(laterBatches.size(), 2);
+   AssertEquals(laterBatches.get(0)->requestId, 3u);
+   AssertEquals(laterBatches.get(1)->requestId, 5u);
+   delete failed;
+
+   // Batches for other servers are kept in original order
+   AssertEquals(window.size(), 3);
+   static const uint32_t expected[] = { 2, 4, 6 };
+   for(int i = 0; i < 3; i++)
+   {
+      TestBatch *batch = window.takeOldest();
+      AssertEquals(batch->requestId, expected[i]);
+      delete batch;
+   }
+
+   // Nothing to take for unknown server
+   window.add(new TestBatch(2, 1000, 7));
+   laterBatches.clear();
+   window.takeServerBatches(1, &laterBatches);
+   AssertTrue(laterBatches.isEmpty());
+   AssertEquals(window.size(), 1);
+
+   EndTest();
+}
+
+/**
+ * main()
+ */
+int main(int argc, char *argv[])
+{
+   InitNetXMSProcess(true);
+
+   TestSendOrder();
+   TestWaitTime();
+   TestDrainTime();
+   TestTakeServerBatches();
+
+   return 0;
+}
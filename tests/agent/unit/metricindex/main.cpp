@@ -0,0 +1,158 @@
+/*
+** NetXMS agent metric dispatch index unit tests
+** Copyright (C) 2026 Raden Solutions
+*/
+
+#include <nms_common.h>
+#include <nms_util.h>
+#include <testtools.h>
+#include <netxms-version.h>
+#include "metricindex.h"
+
+NETXMS_EXECUTABLE_HEADER(test-unit-metricindex)
+
+/**
+ * Test registration
+ */
+struct TestRegistration
+{
+   TCHAR name[MAX_PARAM_NAME];
+   int id;
+};
+
+/**
+ * Add registration to array
+ */
+static void AddRegistration(StructArray<TestRegistration> *registrations, const TCHAR *name, int id)
+{
+   TestRegistration r;
+   _tcslcpy(r.name, name, MAX_PARAM_NAME);
+   r.id = id;
+   registrations->add(&r);
+}
+
+/**
+ * Get ID of registration found for given name or -1 if not found
+ */
+static int FindRegistration(const MetricDispatchIndex<TestRegistration>& index, const TCHAR *name)
+{
+   TestRegistration *r = index.find(name);
+   return (r != nullptr) ? r->id : -1;
+}
+
+/**
+ * Test lookup by exact and parameterized names
+ */
+static void TestNamedLookup()
+{
+   StartTest(_T("Named lookup"));
+
+   StructArray<TestRegistration> registrations;
+   AddRegistration(&registrations, _T("Agent.Version"), 1);
+   AddRegistration(&registrations, _T("System.CPU.Usage(*)"), 2);
+   AddRegistration(&registrations, _T("System.Memory.Physical.Free"), 3);
+   MetricDispatchIndex<TestRegistration> index(registrations);
+
+   AssertEquals(FindRegistration(index, _T("Agent.Version")), 1);
+   AssertEquals(FindRegistration(index, _T("agent.version")), 1);
+   AssertEquals(FindRegistration(index, _T("System.CPU.Usage(5)")), 2);
+   AssertEquals(FindRegistration(index, _T("System.Memory.Physical.Free")), 3);
+   AssertEquals(FindRegistration(index, _T("System.CPU.Usage")), -1);
+   AssertEquals(FindRegistration(index, _T("Agent.Uptime")), -1);
+   AssertEquals(FindRegistration(index, _T("Agent.Version(1)")), -1);
+
+   EndTest();
+}
+
+/**
+ * Test that first matching registration wins
+ */
+static void TestFirstMatchPrecedence()
+{
+   StartTest(_T("First match precedence"));
+
+   StructArray<TestRegistration> registrations;
+   AddRegistration(&registrations, _T("FileSystem.Free(/)"), 1);
+   AddRegistration(&registrations, _T("FileSystem.Free(*)"), 2);
+   AddRegistration(&registrations, _T("FileSystem.Free(/)"), 3);
+   MetricDispatchIndex<TestRegistration> index(registrations);
+
+   AssertEquals(FindRegistration(index, _T("FileSystem.Free(/)")), 1);
+   AssertEquals(FindRegistration(index, _T("FileSystem.Free(/var)")), 2);
+
+   EndTest();
+}
+
+/**
+ * Test registrations with wildcard characters in base name
+ */
+static void TestWildcardEntries()
+{
+   StartTest(_T("Wildcard entries"));
+
+   StructArray<TestRegistration> registrations;
+   AddRegistration(&registrations, _T("Net.Interface.*(*)"), 1);
+   AddRegistration(&registrations, _T("Net.Interface.BytesIn(*)"), 2);
+   AddRegistration(&registrations, _T("Custom.Metric?"), 3);
+   AddRegistration(&registrations, _T("Custom.Metric1"), 4);
+   AddRegistration(&registrations, _T("Custom.Metric10"), 5);
+   MetricDispatchIndex<TestRegistration> index(registrations);
+
+   // Wildcard registration made earlier takes precedence over named one
+   AssertEquals(FindRegistration(index, _T("Net.Interface.BytesIn(1)")), 1);
+   AssertEquals(FindRegistration(index, _T("Net.Interface.BytesOut(1)")), 1);
+
+   // Named registration made earlier takes precedence over wildcard one
+   AssertEquals(FindRegistration(index, _T("Custom.Metric1")), 3);
+   AssertEquals(FindRegistration(index, _T("Custom.Metric2")), 3);
+   AssertEquals(FindRegistration(index, _T("Custom.Metric10")), 5);
+   AssertEquals(FindRegistration(index, _T("Custom.Metric")), -1);
+
+   EndTest();
+}
+
+/**
+ * Test incremental add, clear, and rebuild
+ */
+static void TestUpdate()
+{
+   StartTest(_T("Index update"));
+
+   StructArray<TestRegistration> registrations;
+   AddRegistration(&registrations, _T("Agent.Version"), 1);
+   MetricDispatchIndex<TestRegistration> index(registrations);
+   AssertEquals(FindRegistration(index, _T("Agent.Version")), 1);
+   AssertEquals(FindRegistration(index, _T("Agent.Uptime")), -1);
+
+   AddRegistration(&registrations, _T("Agent.Uptime"), 2);
+   index.add(registrations.size() - 1);
+   AssertEquals(FindRegistration(index, _T("Agent.Uptime")), 2);
+
+   index.clear();
+   AssertEquals(FindRegistration(index, _T("Agent.Version")), -1);
+   AssertEquals(FindRegistration(index, _T("Agent.Uptime")), -1);
+
+   registrations.clear();
+   AddRegistration(&registrations, _T("Agent.*"), 3);
+   index.rebuild();
+   AssertEquals(FindRegistration(index, _T("Agent.Version")), 3);
+   AssertEquals(FindRegistration(index, _T("Agent.Uptime")), 3);
+   AssertEquals(FindRegistration(index, _T("System.Uptime")), -1);
+
+   EndTest();
+}
+
+/**
+ * main()
+ */
+int main(int argc, char *argv[])
+{
+   InitNetXMSProcess(true);
+
+   TestNamedLookup();
+   TestFirstMatchPrecedence();
+   TestWildcardEntries();
+   TestUpdate();
+
+   return 0;
+}
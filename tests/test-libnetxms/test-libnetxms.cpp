@@ -28,6 +28,7 @@ void TestCondition();
 void TestRWLock();
 void TestThreadCountAndMaxWaitTime();
 void TestThreadPoolStalledExpansion();
+void TestThreadPoolWorkStealing();
 void TestProcessExecutor(const char *procname);
 void TestProcessExecutorWorker();
 void TestStringConversion();
@@ -3755,6 +3756,7 @@ int main(int argc, char *argv[])
    TestThreadPoolDelayedExecution();
    TestThreadCountAndMaxWaitTime();
    TestThreadPoolStalledExpansion();
+   TestThreadPoolWorkStealing();
    TestWebSocketURLParsing();
    TestWebSocketClient();
 
@@ -244,3 +244,69 @@ void TestThreadPoolStalledExpansion()
    ThreadPoolDestroy(p);
    EndTest();
 }
+
+static VolatileCounter s_workStealingCounter;
+static ThreadPool *s_workStealingPool;
+
+static void WorkStealingLeafTask()
+{
+   InterlockedIncrement(&s_workStealingCounter);
+}
+
+static void WorkStealingSpawnTask()
+{
+   InterlockedIncrement(&s_workStealingCounter);
+   for(int i = 0; i < 9; i++)
+      ThreadPoolExecute(s_workStealingPool, WorkStealingLeafTask);
+}
+
+static void WorkStealingSlowTask()
+{
+   ThreadSleepMs(2);
+   InterlockedIncrement(&s_workStealingCounter);
+}
+
+/**
+ * Test thread pool in work stealing mode
+ */
+void TestThreadPoolWorkStealing()
+{
+   StartTest(_T("Thread pool - work stealing"));
+   s_workStealingPool = ThreadPoolCreate(_T("WSTEAL"), 4, 16, 0, THREAD_POOL_WORK_STEALING);
+   AssertNotNull(s_workStealingPool);
+
+   ThreadPoolInfo info;
+   ThreadPoolGetInfo(s_workStealingPool, &info);
+   AssertEquals(info.curThreads, 4);
+
+   // Tasks submitted from outside of the pool and from pool's own workers
+   s_workStealingCounter = 0;
+   for(int i = 0; i < 1000; i++)
+      ThreadPoolExecute(s_workStealingPool, WorkStealingSpawnTask);
+
+   for(int i = 0; i < 500; i++)
+   {
+      ThreadSleepMs(10);
+      ThreadPoolGetInfo(s_workStealingPool, &info);
+      if (info.activeRequests == 0)
+         break;
+   }
+   AssertEquals(info.activeRequests, 0);
+   AssertEquals(static_cast<int32_t>(s_workStealingCounter), 10000);
+   AssertEquals(info.totalRequests, _ULL(10000));
+
+   // Scheduled tasks
+   bool executed = false;
+   ThreadPoolScheduleRelative(s_workStealingPool, 200, [&executed] () -> void { executed = true; });
+   ThreadSleepMs(500);
+   AssertTrue(executed);
+
+   // Queued tasks should be completed before pool is destroyed
+   s_workStealingCounter = 0;
+   for(int i = 0; i < 200; i++)
+      ThreadPoolExecute(s_workStealingPool, WorkStealingSlowTask);
+   ThreadPoolDestroy(s_workStealingPool);
+   AssertEquals(static_cast<int32_t>(s_workStealingCounter), 200);
+
+   EndTest();
+}
@@ -0,0 +1,1078 @@
+#include <nms_common.h>
+#include <nms_util.h>
+#include <nms_core.h>
+#include <nxsnmp.h>
+#include <nxcore_dcsched.h>
+#include <nxcore_logs.h>
+#include <testtools.h>
+#include <netxms-version.h>
+
+NETXMS_EXECUTABLE_HEADER(test-libnxcore)
+
+#define ONE_HOUR_MS  _LL(3600000)
+
+/**
+ * Test numeric value parser used by in-memory DCI aggregation
+ */
+static void TestParseAggregateValue()
+{
+   StartTest(_T("ParseAggregateValue"));
+
+   static const wchar_t *valid[] = { L"5", L"-42", L"100", L"+7", L"0", L"1e5", L"1E+5", L"-2e-3", L"3.25", L"+3.5", L".5", L"-.5", L"10.0e2", nullptr };
+   for(int i = 0; valid[i] != nullptr; i++)
+   {
+      double v = -1;
+      AssertTrue(ParseAggregateValue(valid[i], &v));
+      AssertTrue(v == wcstod(valid[i], nullptr));
+   }
+
+   static const wchar_t *invalid[] = { L"", L"-", L"+", L".", L"5.", L"abc", L"1e", L"1e+", L"e5", L"12abc", L" 5", L"5 ", L"1.2.3", L"0x10", L"--1", nullptr };
+   for(int i = 0; invalid[i] != nullptr; i++)
+   {
+      double v = -1;
+      AssertFalse(ParseAggregateValue(invalid[i], &v));
+      AssertTrue(v == -1);
+   }
+
+   EndTest();
+}
+
+/**
+ * Test hourly aggregate bucket rollover
+ */
+static void TestAggregateBucketRollover()
+{
+   StartTest(_T("DCIAggregateBucket rollover"));
+
+   const int64_t base = _LL(1700000000000) / ONE_HOUR_MS * ONE_HOUR_MS;
+
+   DCIAggregateBucket bucket;
+   bucket.reset(0, false);
+   int64_t watermark = 0;
+   DCIAggregateRecord closed;
+
+   // First bucket after start is incomplete and is never written
+   AssertFalse(bucket.update(base + 1000, L"5", &watermark, &closed));
+   AssertEquals(bucket.start, base);
+   AssertFalse(bucket.complete);
+   AssertFalse(bucket.update(base + 2000, L"7", &watermark, &closed));
+   AssertEquals(bucket.count, 2);
+
+   // Rollover from incomplete bucket opens complete one without closing anything
+   AssertFalse(bucket.update(base + ONE_HOUR_MS, L"10", &watermark, &closed));
+   AssertEquals(bucket.start, base + ONE_HOUR_MS);
+   AssertTrue(bucket.complete);
+   AssertEquals(watermark, _LL(0));
+
+   // Integer, signed and exponent values are all aggregated; non-numeric values are skipped
+   AssertFalse(bucket.update(base + ONE_HOUR_MS + 1000, L"-42", &watermark, &closed));
+   AssertFalse(bucket.update(base + ONE_HOUR_MS + 2000, L"1e2", &watermark, &closed));
+   AssertFalse(bucket.update(base + ONE_HOUR_MS + 3000, L"n/a", &watermark, &closed));
+   AssertEquals(bucket.count, 3);
+
+   // Value from already closed bucket is ignored
+   AssertFalse(bucket.update(base + 5000, L"1000", &watermark, &closed));
+   AssertEquals(bucket.count, 3);
+
+   // Rollover closes complete bucket and advances watermark
+   AssertTrue(bucket.update(base + 2 * ONE_HOUR_MS + 1000, L"1", &watermark, &closed));
+   AssertEquals(closed.bucketStart, base + ONE_HOUR_MS);
+   AssertEquals(closed.sampleCount, 3);
+   AssertTrue(closed.minValue == -42);
+   AssertTrue(closed.maxValue == 100);
+   AssertTrue(closed.avgValue == 68.0 / 3);
+   AssertEquals(closed.watermark, base + 2 * ONE_HOUR_MS);
+   AssertEquals(watermark, base + 2 * ONE_HOUR_MS);
+   AssertEquals(bucket.start, base + 2 * ONE_HOUR_MS);
+   AssertEquals(bucket.count, 1);
+
+   // Gap of several hours: closed bucket is written, watermark jumps to new bucket
+   AssertTrue(bucket.update(base + 5 * ONE_HOUR_MS, L"2", &watermark, &closed));
+   AssertEquals(closed.bucketStart, base + 2 * ONE_HOUR_MS);
+   AssertEquals(closed.sampleCount, 1);
+   AssertEquals(watermark, base + 5 * ONE_HOUR_MS);
+
+   // Watermark pushed back to earlier data (late value) is not advanced, but aggregate is still written
+   watermark = base + ONE_HOUR_MS;
+   AssertTrue(bucket.update(base + 6 * ONE_HOUR_MS, L"3", &watermark, &closed));
+   AssertEquals(closed.bucketStart, base + 5 * ONE_HOUR_MS);
+   AssertEquals(closed.watermark, _LL(0));
+   AssertEquals(watermark, base + ONE_HOUR_MS);
+
+   // Bucket without numeric samples is still closed to advance watermark
+   watermark = base + 6 * ONE_HOUR_MS;
+   AssertTrue(bucket.update(base + 7 * ONE_HOUR_MS, L"text", &watermark, &closed));
+   AssertEquals(closed.sampleCount, 1);
+   AssertEquals(watermark, base + 7 * ONE_HOUR_MS);
+   AssertEquals(bucket.count, 0);
+   AssertTrue(bucket.update(base + 8 * ONE_HOUR_MS, L"text", &watermark, &closed));
+   AssertEquals(closed.bucketStart, base + 7 * ONE_HOUR_MS);
+   AssertEquals(closed.sampleCount, 0);
+   AssertEquals(closed.watermark, base + 8 * ONE_HOUR_MS);
+
+   // Empty bucket with watermark pointing to earlier data produces nothing to write
+   watermark = base;
+   AssertFalse(bucket.update(base + 9 * ONE_HOUR_MS, L"text", &watermark, &closed));
+   AssertEquals(watermark, base);
+
+   EndTest();
+}
+
+/**
+ * Push integer value into DCI value cache
+ */
+static void PushCacheValue(DCIValueCache *cache, int64_t value)
+{
+   wchar_t text[32];
+   cache->push(ItemValue(IntegerToString(value, text), Timestamp::fromMilliseconds(value * 1000), false), DCI_DT_INT64);
+}
+
+/**
+ * Append integer value to DCI value cache
+ */
+static void AppendCacheValue(DCIValueCache *cache, int64_t value)
+{
+   wchar_t text[32];
+   cache->append(ItemValue(IntegerToString(value, text), Timestamp::fromMilliseconds(value * 1000), false), DCI_DT_INT64);
+}
+
+/**
+ * Test DCI value cache ring buffer
+ */
+static void TestValueCache()
+{
+   StartTest(_T("DCIValueCache"));
+
+   wchar_t buffer[DCI_VALUE_CACHE_STRING_BUFFER_SIZE];
+
+   // Cache with zero capacity ignores new values and returns empty value for any index
+   DCIValueCache cache;
+   PushCacheValue(&cache, 1);
+   AppendCacheValue(&cache, 2);
+   cache.appendPlaceholder();
+   cache.remove(0);
+   AssertEquals(cache.size(), 0u);
+   AssertEquals(cache.getInt64(0), _LL(0));
+   AssertTrue(cache.getDouble(1) == 0);
+   AssertEquals(cache.getString(0, buffer), L"");
+   AssertEquals(cache.getTimeStamp(0).asMilliseconds(), _LL(0));
+   AssertFalse(cache.isPlaceholder(0));
+
+   // Wrap-around: most recent value is at index 0, oldest values are dropped
+   cache.setCapacity(3);
+   for(int64_t i = 1; i <= 5; i++)
+      PushCacheValue(&cache, i);
+   AssertEquals(cache.size(), 3u);
+   AssertEquals(cache.getInt64(0), _LL(5));
+   AssertEquals(cache.getInt64(1), _LL(4));
+   AssertEquals(cache.getInt64(2), _LL(3));
+   AssertEquals(cache.getTimeStamp(2).asMilliseconds(), _LL(3000));
+   AssertEquals(cache.getInt64(3), _LL(0));
+   AssertEquals(cache.get(3).getString(), L"");
+
+   // Remove from the middle and from out of range index
+   cache.remove(1);
+   cache.remove(5);
+   AssertEquals(cache.size(), 2u);
+   AssertEquals(cache.getInt64(0), _LL(5));
+   AssertEquals(cache.getInt64(1), _LL(3));
+
+   // Append adds oldest values until cache is full
+   AppendCacheValue(&cache, 2);
+   AppendCacheValue(&cache, 1);
+   AssertEquals(cache.size(), 3u);
+   AssertEquals(cache.getInt64(2), _LL(2));
+   cache.clear();
+   PushCacheValue(&cache, 10);
+   AppendCacheValue(&cache, 9);
+   cache.appendPlaceholder();
+   AssertEquals(cache.size(), 3u);
+   AssertEquals(cache.getInt64(0), _LL(10));
+   AssertEquals(cache.getInt64(1), _LL(9));
+   AssertTrue(cache.isPlaceholder(2));
+
+   // Shrinking drops oldest values, growing keeps order
+   cache.clear();
+   for(int64_t i = 1; i <= 5; i++)
+      PushCacheValue(&cache, i);
+   cache.setCapacity(2);
+   AssertEquals(cache.size(), 2u);
+   AssertEquals(cache.getInt64(0), _LL(5));
+   AssertEquals(cache.getInt64(1), _LL(4));
+   cache.setCapacity(4);
+   PushCacheValue(&cache, 6);
+   AssertEquals(cache.size(), 3u);
+   AssertEquals(cache.getInt64(0), _LL(6));
+   AssertEquals(cache.getInt64(2), _LL(4));
+   AssertEquals(cache.getString(1, buffer), L"5");
+
+   // String values
+   cache.push(ItemValue(L"text", Timestamp::fromMilliseconds(7000), false), DCI_DT_STRING);
+   AssertEquals(cache.getString(0, buffer), L"text");
+   AssertEquals(cache.getString(1, buffer), L"6");
+
+   // Copy keeps order
+   DCIValueCache copy(cache);
+   AssertEquals(copy.size(), 4u);
+   AssertEquals(copy.getString(3, buffer), L"4");
+
+   // Dropping capacity to zero removes all values
+   cache.setCapacity(0);
+   AssertEquals(cache.size(), 0u);
+   AssertEquals(cache.getInt64(0), _LL(0));
+   PushCacheValue(&cache, 1);
+   AssertEquals(cache.size(), 0u);
+
+   EndTest();
+}
+
+/**
+ * Create address with given mask length
+ */
+static InetAddress MakePrefix(const wchar_t *addr, int maskBits)
+{
+   InetAddress a = InetAddress::parse(addr);
+   a.setMaskBits(maskBits);
+   return a;
+}
+
+/**
+ * Check object found by longest prefix match
+ */
+static void AssertLongestPrefixMatch(const InetAddressIndex& index, const wchar_t *addr, const shared_ptr<NetObj>& expected)
+{
+   AssertTrue(index.findLongestPrefixMatch(InetAddress::parse(addr)) == expected);
+}
+
+/**
+ * Check objects overlapping given prefix
+ */
+static void AssertOverlappingObjects(const InetAddressIndex& index, const wchar_t *addr, int maskBits, std::initializer_list<shared_ptr<NetObj>> expected)
+{
+   unique_ptr<SharedObjectArray<NetObj>> objects = index.getOverlappingObjects(MakePrefix(addr, maskBits));
+   AssertEquals(objects->size(), static_cast<int>(expected.size()));
+   for(const shared_ptr<NetObj>& object : expected)
+   {
+      bool found = false;
+      for(int i = 0; (i < objects->size()) && !found; i++)
+         found = (objects->get(i) == object.get());
+      AssertTrue(found);
+   }
+}
+
+/**
+ * Test IP address index with prefix search
+ */
+static void TestInetAddressIndexPrefixSearch()
+{
+   StartTest(_T("InetAddressIndex: prefix search"));
+
+   InetAddressIndex index(true);
+   shared_ptr<NetObj> net8 = make_shared<Subnet>();
+   shared_ptr<NetObj> net16 = make_shared<Subnet>();
+   shared_ptr<NetObj> net24 = make_shared<Subnet>();
+   shared_ptr<NetObj> net25 = make_shared<Subnet>();
+   shared_ptr<NetObj> other = make_shared<Subnet>();
+   shared_ptr<NetObj> v6net32 = make_shared<Subnet>();
+   shared_ptr<NetObj> v6net48 = make_shared<Subnet>();
+   shared_ptr<NetObj> v6net64 = make_shared<Subnet>();
+
+   // Insert in order that requires splitting of existing nodes
+   AssertFalse(index.put(MakePrefix(L"10.1.2.0", 24), net24));
+   AssertFalse(index.put(MakePrefix(L"10.0.0.0", 8), net8));
+   AssertFalse(index.put(MakePrefix(L"192.168.1.0", 24), other));
+   AssertFalse(index.put(MakePrefix(L"10.1.2.128", 25), net25));
+   AssertFalse(index.put(MakePrefix(L"10.1.0.0", 16), net16));
+   AssertFalse(index.put(MakePrefix(L"2001:db8:1:2::", 64), v6net64));
+   AssertFalse(index.put(MakePrefix(L"2001:db8::", 32), v6net32));
+   AssertFalse(index.put(MakePrefix(L"2001:db8:1::", 48), v6net48));
+   AssertEquals(index.size(), 8);
+
+   // Longest prefix match for IPv4
+   AssertLongestPrefixMatch(index, L"10.1.2.3", net24);
+   AssertLongestPrefixMatch(index, L"10.1.2.200", net25);
+   AssertLongestPrefixMatch(index, L"10.1.3.1", net16);
+   AssertLongestPrefixMatch(index, L"10.200.0.1", net8);
+   AssertLongestPrefixMatch(index, L"192.168.1.77", other);
+   AssertLongestPrefixMatch(index, L"11.0.0.1", shared_ptr<NetObj>());
+   AssertLongestPrefixMatch(index, L"192.168.2.1", shared_ptr<NetObj>());
+
+   // Longest prefix match for IPv6
+   AssertLongestPrefixMatch(index, L"2001:db8:1:2::1", v6net64);
+   AssertLongestPrefixMatch(index, L"2001:db8:1:3::1", v6net48);
+   AssertLongestPrefixMatch(index, L"2001:db8:ffff::1", v6net32);
+   AssertLongestPrefixMatch(index, L"2001:db9::1", shared_ptr<NetObj>());
+
+   // Subnet enumeration returns both containing and contained prefixes
+   AssertOverlappingObjects(index, L"10.0.0.0", 8, { net8, net16, net24, net25 });
+   AssertOverlappingObjects(index, L"10.1.0.0", 16, { net8, net16, net24, net25 });
+   AssertOverlappingObjects(index, L"10.1.2.0", 24, { net8, net16, net24, net25 });
+   AssertOverlappingObjects(index, L"10.1.3.0", 24, { net8, net16 });
+   AssertOverlappingObjects(index, L"192.168.0.0", 16, { other });
+   AssertOverlappingObjects(index, L"172.16.0.0", 12, { });
+   AssertOverlappingObjects(index, L"2001:db8:1::", 48, { v6net32, v6net48, v6net64 });
+   AssertOverlappingObjects(index, L"2001:db8:2::", 48, { v6net32 });
+
+   // Removing intermediate prefix keeps more and less specific ones
+   index.remove(MakePrefix(L"10.1.0.0", 16));
+   AssertLongestPrefixMatch(index, L"10.1.3.1", net8);
+   AssertLongestPrefixMatch(index, L"10.1.2.3", net24);
+   AssertLongestPrefixMatch(index, L"10.1.2.200", net25);
+   index.remove(MakePrefix(L"10.1.2.0", 24));
+   AssertLongestPrefixMatch(index, L"10.1.2.3", net8);
+   AssertLongestPrefixMatch(index, L"10.1.2.200", net25);
+   index.remove(MakePrefix(L"10.1.2.128", 25));
+   AssertLongestPrefixMatch(index, L"10.1.2.200", net8);
+   AssertOverlappingObjects(index, L"10.1.0.0", 16, { net8 });
+   index.remove(MakePrefix(L"2001:db8:1::", 48));
+   AssertLongestPrefixMatch(index, L"2001:db8:1:2::1", v6net64);
+   AssertLongestPrefixMatch(index, L"2001:db8:1:3::1", v6net32);
+   AssertEquals(index.size(), 4);
+
+   // Same address with different mask replaces entry
+   AssertTrue(index.put(MakePrefix(L"10.0.0.0", 7), net8));
+   AssertLongestPrefixMatch(index, L"11.0.0.1", net8);
+   AssertLongestPrefixMatch(index, L"10.1.2.3", net8);
+   AssertTrue(index.put(MakePrefix(L"10.0.0.0", 8), net8));
+   AssertLongestPrefixMatch(index, L"11.0.0.1", shared_ptr<NetObj>());
+   AssertEquals(index.size(), 4);
+
+   // Removing all entries leaves empty tree
+   index.remove(MakePrefix(L"10.0.0.0", 8));
+   index.remove(MakePrefix(L"192.168.1.0", 24));
+   index.remove(MakePrefix(L"2001:db8::", 32));
+   index.remove(MakePrefix(L"2001:db8:1:2::", 64));
+   AssertEquals(index.size(), 0);
+   AssertLongestPrefixMatch(index, L"10.1.2.3", shared_ptr<NetObj>());
+   AssertLongestPrefixMatch(index, L"2001:db8:1:2::1", shared_ptr<NetObj>());
+   AssertOverlappingObjects(index, L"0.0.0.0", 0, { });
+
+   EndTest();
+}
+
+/**
+ * Check literal prefix extracted from alarm key pattern
+ */
+static void AssertKeyPatternPrefix(const TCHAR *pattern, const TCHAR *expected)
+{
+   TCHAR prefix[MAX_DB_STRING];
+   ExtractKeyPatternPrefix(pattern, prefix);
+   AssertEquals(prefix, expected);
+}
+
+/**
+ * Test extraction of literal prefix from alarm key patterns
+ */
+static void TestKeyPatternPrefix()
+{
+   StartTest(_T("ExtractKeyPatternPrefix"));
+
+   // Unanchored patterns can match anywhere in the key
+   AssertKeyPatternPrefix(_T("NODE_DOWN_1"), _T(""));
+   AssertKeyPatternPrefix(_T(".*NODE_DOWN"), _T(""));
+   AssertKeyPatternPrefix(_T("a^b"), _T(""));
+
+   // Anchored patterns
+   AssertKeyPatternPrefix(_T("^NODE_DOWN_1"), _T("NODE_DOWN_1"));
+   AssertKeyPatternPrefix(_T("^NODE_DOWN_1$"), _T("NODE_DOWN_1"));
+   AssertKeyPatternPrefix(_T("^NODE_DOWN_[0-9]+"), _T("NODE_DOWN_"));
+   AssertKeyPatternPrefix(_T("^IF_DOWN_.*"), _T("IF_DOWN_"));
+   AssertKeyPatternPrefix(_T("^"), _T(""));
+
+   // Alternation anywhere makes prefix unsafe
+   AssertKeyPatternPrefix(_T("^NODE_DOWN|^IF_DOWN"), _T(""));
+   AssertKeyPatternPrefix(_T("^NODE_(DOWN|UP)"), _T(""));
+   AssertKeyPatternPrefix(_T("^A\\|B"), _T(""));
+
+   // Escaped metacharacters are part of literal prefix
+   AssertKeyPatternPrefix(_T("^192\\.168\\.1\\.1$"), _T("192.168.1.1"));
+   AssertKeyPatternPrefix(_T("^JOB\\(1\\)\\*"), _T("JOB(1)*"));
+   AssertKeyPatternPrefix(_T("^C:\\\\TEMP"), _T("C:\\TEMP"));
+
+   // Escapes for character classes, back references, and assertions end prefix
+   AssertKeyPatternPrefix(_T("^DISK_\\d+"), _T("DISK_"));
+   AssertKeyPatternPrefix(_T("^A\\bB"), _T("A"));
+   AssertKeyPatternPrefix(_T("^\\QA.B\\E"), _T(""));
+   AssertKeyPatternPrefix(_T("^ABC\\"), _T("ABC"));
+
+   // Quantifiers make preceding character optional or repeated unknown number of times
+   AssertKeyPatternPrefix(_T("^ABC*"), _T("AB"));
+   AssertKeyPatternPrefix(_T("^ABC?"), _T("AB"));
+   AssertKeyPatternPrefix(_T("^ABC{2}"), _T("AB"));
+   AssertKeyPatternPrefix(_T("^ABC+D"), _T("ABC"));
+   AssertKeyPatternPrefix(_T("^AB\\.?C"), _T("AB"));
+
+   // Other metacharacters in prefix
+   AssertKeyPatternPrefix(_T("^AB.C"), _T("AB"));
+   AssertKeyPatternPrefix(_T("^AB[CD]"), _T("AB"));
+   AssertKeyPatternPrefix(_T("^AB(C)"), _T("AB"));
+   AssertKeyPatternPrefix(_T("^(?i)AB"), _T(""));
+   AssertKeyPatternPrefix(_T("^AB$C"), _T("AB"));
+   AssertKeyPatternPrefix(_T("^^AB"), _T(""));
+
+   EndTest();
+}
+
+/**
+ * Test extraction of values from SNMP GET response varbinds
+ */
+static void TestSNMPResponseValue()
+{
+   StartTest(_T("GetSNMPResponseValue"));
+
+   wchar_t buffer[64];
+
+   SNMP_Variable integer(L".1.3.6.1.2.1.2.2.1.10.1");
+   integer.setValueFromUInt32(ASN_COUNTER32, 12345);
+   AssertEquals(GetSNMPResponseValue(&integer, buffer, 64), static_cast<uint32_t>(SNMP_ERR_SUCCESS));
+   AssertEquals(buffer, L"12345");
+
+   SNMP_Variable string(L".1.3.6.1.2.1.1.5.0");
+   string.setValueFromString(ASN_OCTET_STRING, L"router");
+   AssertEquals(GetSNMPResponseValue(&string, buffer, 64), static_cast<uint32_t>(SNMP_ERR_SUCCESS));
+   AssertEquals(buffer, L"router");
+
+   // SNMPv2 exceptions in otherwise successful response
+   static const uint32_t exceptions[] = { ASN_NO_SUCH_OBJECT, ASN_NO_SUCH_INSTANCE, ASN_END_OF_MIBVIEW };
+   for(int i = 0; i < 3; i++)
+   {
+      SNMP_Variable v(L".1.3.6.1.4.1.99999.1.0", exceptions[i]);
+      wcscpy(buffer, L"unchanged");
+      AssertEquals(GetSNMPResponseValue(&v, buffer, 64), static_cast<uint32_t>(SNMP_ERR_NO_OBJECT));
+      AssertEquals(buffer, L"unchanged");
+   }
+
+   EndTest();
+}
+
+/**
+ * Object for data collection scheduler tests
+ */
+struct SchedulerTestObject
+{
+   time_t expectedTime;
+   time_t dueTime;
+   uint64_t m_schedulerTicket;
+   time_t m_scheduledPollTime;
+
+   SchedulerTestObject(time_t _expectedTime)
+   {
+      expectedTime = _expectedTime;
+      dueTime = 0;
+      m_schedulerTicket = 0;
+      m_scheduledPollTime = 0;
+   }
+};
+
+/**
+ * Test that entries on all wheel levels are cascaded down and expire exactly at scheduled time
+ */
+static void TestSchedulerCascade()
+{
+   StartTest(_T("DataCollectionScheduler: cascade"));
+
+   const time_t base = 1700000000;
+   DataCollectionScheduler<SchedulerTestObject> scheduler(base);
+
+   static const time_t offsets[] = { 1, 2, 63, 64, 65, 100, 4095, 4096, 4097, 5000, 86399, 262143, 262144, 262145, 300000 };
+   SharedObjectArray<SchedulerTestObject> objects;
+   for(size_t i = 0; i < sizeof(offsets) / sizeof(time_t); i++)
+   {
+      auto object = make_shared<SchedulerTestObject>(base + offsets[i]);
+      scheduler.schedule(object, object->expectedTime, false);
+      objects.add(object);
+   }
+
+   SharedObjectArray<SchedulerTestObject> dueObjects;
+   bool valid = true;
+   for(time_t now = base + 1; now <= base + 300001; now++)
+   {
+      scheduler.collectDueObjects(now, &dueObjects);
+      for(int i = 0; i < dueObjects.size(); i++)
+      {
+         SchedulerTestObject *object = dueObjects.get(i);
+         if (object->dueTime != 0)
+            valid = false;   // Expired twice
+         object->dueTime = now;
+      }
+      dueObjects.clear();
+   }
+   AssertTrue(valid);
+
+   for(int i = 0; i < objects.size(); i++)
+   {
+      SchedulerTestObject *object = objects.get(i);
+      AssertEquals(static_cast<int64_t>(object->dueTime), static_cast<int64_t>(object->expectedTime));
+      AssertEquals(object->m_schedulerTicket, _ULL(0));
+   }
+
+   EndTest();
+}
+
+/**
+ * Test that all entries become due immediately after system clock change
+ */
+static void TestSchedulerRebase()
+{
+   StartTest(_T("DataCollectionScheduler: rebase"));
+
+   const time_t base = 1700000000;
+   DataCollectionScheduler<SchedulerTestObject> scheduler(base);
+
+   auto near = make_shared<SchedulerTestObject>(base + 10);
+   auto far = make_shared<SchedulerTestObject>(base + 100000);
+   scheduler.schedule(near, near->expectedTime, false);
+   scheduler.schedule(far, far->expectedTime, false);
+
+   // Clock moved backwards
+   SharedObjectArray<SchedulerTestObject> dueObjects;
+   scheduler.collectDueObjects(base - 3600, &dueObjects);
+   AssertEquals(dueObjects.size(), 2);
+   dueObjects.clear();
+
+   // Scheduling is relative to new clock after rebase
+   scheduler.schedule(near, base - 3600 + 10, false);
+   scheduler.collectDueObjects(base - 3600 + 9, &dueObjects);
+   AssertEquals(dueObjects.size(), 0);
+   scheduler.collectDueObjects(base - 3600 + 10, &dueObjects);
+   AssertEquals(dueObjects.size(), 1);
+   dueObjects.clear();
+
+   // Clock jumped forward by more than maximum advance
+   scheduler.schedule(near, base - 3600 + 20, false);
+   scheduler.schedule(far, base + 200000, false);
+   scheduler.collectDueObjects(base - 3600 + DC_MAX_CLOCK_ADVANCE + 100, &dueObjects);
+   AssertEquals(dueObjects.size(), 2);
+   dueObjects.clear();
+
+   // Nothing left in wheel
+   scheduler.collectDueObjects(base + 300000, &dueObjects);
+   AssertEquals(dueObjects.size(), 0);
+
+   EndTest();
+}
+
+/**
+ * Test replacement of scheduler entries by ticket
+ */
+static void TestSchedulerTicketReplacement()
+{
+   StartTest(_T("DataCollectionScheduler: ticket replacement"));
+
+   const time_t base = 1700000000;
+   DataCollectionScheduler<SchedulerTestObject> scheduler(base);
+   SharedObjectArray<SchedulerTestObject> dueObjects;
+
+   // Rescheduling for earlier time replaces existing entry, old entry is dropped on expiration
+   auto object = make_shared<SchedulerTestObject>(base + 5);
+   scheduler.schedule(object, base + 10, false);
+   uint64_t ticket = object->m_schedulerTicket;
+   AssertTrue(ticket != 0);
+   scheduler.schedule(object, base + 5, false);
+   AssertTrue(object->m_schedulerTicket != ticket);
+   AssertEquals(static_cast<int64_t>(object->m_scheduledPollTime), static_cast<int64_t>(base + 5));
+
+   // Rescheduling for later time or only if not scheduled does not change existing entry
+   ticket = object->m_schedulerTicket;
+   scheduler.schedule(object, base + 20, false);
+   scheduler.schedule(object, base + 2, true);
+   AssertEquals(object->m_schedulerTicket, ticket);
+   AssertEquals(static_cast<int64_t>(object->m_scheduledPollTime), static_cast<int64_t>(base + 5));
+
+   scheduler.collectDueObjects(base + 4, &dueObjects);
+   AssertEquals(dueObjects.size(), 0);
+   scheduler.collectDueObjects(base + 5, &dueObjects);
+   AssertEquals(dueObjects.size(), 1);
+   AssertEquals(object->m_schedulerTicket, _ULL(0));
+   dueObjects.clear();
+   scheduler.collectDueObjects(base + 30, &dueObjects);
+   AssertEquals(dueObjects.size(), 0);
+
+   // Object without active entry can be scheduled with onlyIfNotScheduled
+   scheduler.schedule(object, base + 40, true);
+   AssertTrue(object->m_schedulerTicket != 0);
+
+   // Entry for destroyed object is dropped
+   auto destroyed = make_shared<SchedulerTestObject>(base + 40);
+   scheduler.schedule(destroyed, base + 40, false);
+   destroyed.reset();
+   scheduler.collectDueObjects(base + 40, &dueObjects);
+   AssertEquals(dueObjects.size(), 1);
+   AssertTrue(dueObjects.get(0) == object.get());
+
+   EndTest();
+}
+
+/**
+ * Number of destroyed index test objects
+ */
+static VolatileCounter s_destroyedIndexObjects = 0;
+
+/**
+ * Object for index tests
+ */
+class IndexTestObject
+{
+public:
+   uint64_t id;
+
+   IndexTestObject(uint64_t _id)
+   {
+      id = _id;
+   }
+
+   ~IndexTestObject()
+   {
+      InterlockedIncrement(&s_destroyedIndexObjects);
+   }
+};
+
+/**
+ * Test batched put and remove on object index
+ */
+static void TestIndexBulkUpdate()
+{
+   StartTest(_T("Object index: bulk update"));
+
+   SharedPointerIndex<IndexTestObject> index;
+   index.put(5, new IndexTestObject(5));
+
+   IntegerArray<uint64_t> keys(1000);
+   SharedObjectArray<IndexTestObject> objects(1000);
+   for(uint64_t key = 0; key < 1000; key++)
+   {
+      keys.add(key);
+      objects.add(make_shared<IndexTestObject>(key));
+   }
+   AssertEquals(static_cast<uint64_t>(index.putAll(keys, objects)), _ULL(1));
+   AssertEquals(static_cast<uint64_t>(index.size()), _ULL(1000));
+   for(uint64_t key = 0; key < 1000; key++)
+   {
+      shared_ptr<IndexTestObject> object = index.get(key);
+      AssertNotNull(object.get());
+      AssertTrue(object == objects.getShared(static_cast<int>(key)));
+   }
+
+   IntegerArray<uint64_t> removeKeys(500);
+   for(uint64_t key = 0; key < 1000; key += 2)
+      removeKeys.add(key);
+   removeKeys.add(5000);   // Non-existing key should be ignored
+   index.removeAll(removeKeys);
+   AssertEquals(static_cast<uint64_t>(index.size()), _ULL(500));
+   AssertNull(index.get(0).get());
+   AssertNull(index.get(998).get());
+   AssertNotNull(index.get(1).get());
+   AssertNotNull(index.get(999).get());
+
+   EndTest();
+}
+
+/**
+ * Test concurrent put/get/remove on object index
+ */
+static void TestIndexConcurrentAccess()
+{
+   StartTest(_T("Object index: concurrent put/get/remove"));
+
+   static const int writerCount = 4;
+   static const int keysPerWriter = 2000;
+
+   SharedPointerIndex<IndexTestObject> index;
+   VolatileCounter mismatches = 0;
+   volatile bool stop = false;
+
+   THREAD readers[2];
+   for(int r = 0; r < 2; r++)
+   {
+      readers[r] = ThreadCreateEx(
+         [&index, &mismatches, &stop, r] () -> void
+         {
+            uint64_t key = r;
+            while(!stop)
+            {
+               key = (key * 7 + 13) % (writerCount * keysPerWriter);
+               shared_ptr<IndexTestObject> object = index.get(key);
+               if ((object != nullptr) && (object->id != key))
+                  InterlockedIncrement(&mismatches);
+            }
+         });
+   }
+
+   bool present[writerCount][keysPerWriter];
+   THREAD writers[writerCount];
+   for(int w = 0; w < writerCount; w++)
+   {
+      memset(present[w], 0, sizeof(present[w]));
+      writers[w] = ThreadCreateEx(
+         [&index, &present, w] () -> void
+         {
+            uint32_t seed = w + 1;
+            for(int i = 0; i < 20000; i++)
+            {
+               seed = seed * 1103515245 + 12345;
+               int n = (seed >> 8) % keysPerWriter;
+               uint64_t key = static_cast<uint64_t>(w * keysPerWriter + n);
+               if ((seed >> 4) & 1)
+               {
+                  index.remove(key);
+                  present[w][n] = false;
+               }
+               else
+               {
+                  index.put(key, new IndexTestObject(key));
+                  present[w][n] = true;
+               }
+            }
+         });
+   }
+
+   for(int w = 0; w < writerCount; w++)
+      ThreadJoin(writers[w]);
+   stop = true;
+   for(int r = 0; r < 2; r++)
+      ThreadJoin(readers[r]);
+
+   AssertEquals(static_cast<int>(mismatches), 0);
+
+   size_t expectedSize = 0;
+   bool contentValid = true;
+   for(int w = 0; w < writerCount; w++)
+   {
+      for(int n = 0; n < keysPerWriter; n++)
+      {
+         if (present[w][n])
+            expectedSize++;
+         if (index.contains(w * keysPerWriter + n) != present[w][n])
+            contentValid = false;
+      }
+   }
+   AssertTrue(contentValid);
+   AssertEquals(static_cast<uint64_t>(index.size()), static_cast<uint64_t>(expectedSize));
+
+   IntegerArray<uint64_t> keys = index.keys();
+   AssertEquals(static_cast<uint64_t>(keys.size()), static_cast<uint64_t>(expectedSize));
+   for(int i = 1; i < keys.size(); i++)
+      AssertTrue(keys.get(i - 1) < keys.get(i));
+
+   EndTest();
+}
+
+/**
+ * Test that iteration sees consistent snapshot while index is modified
+ */
+static void TestIndexIterationUnderMutation()
+{
+   StartTest(_T("Object index: iteration under mutation"));
+
+   // Even keys are stable, odd keys are constantly added and removed
+   SharedPointerIndex<IndexTestObject> index;
+   for(uint64_t key = 0; key < 10000; key += 2)
+      index.put(key, new IndexTestObject(key));
+
+   volatile bool stop = false;
+   THREAD writer = ThreadCreateEx(
+      [&index, &stop] () -> void
+      {
+         uint64_t key = 1;
+         while(!stop)
+         {
+            index.put(key, new IndexTestObject(key));
+            if (key > 2000)
+               index.remove(key - 2000);
+            key = (key + 2) % 10000;
+         }
+      });
+
+   bool valid = true;
+   for(int i = 0; i < 50; i++)
+   {
+      int stableCount = 0;
+      uint64_t lastId = 0;
+      bool first = true;
+      index.forEach(
+         [&stableCount, &lastId, &first, &valid] (IndexTestObject *object) -> EnumerationCallbackResult
+         {
+            if (!first && (object->id <= lastId))
+               valid = false;
+            if ((object->id & 1) == 0)
+               stableCount++;
+            lastId = object->id;
+            first = false;
+            return _CONTINUE;
+         });
+      if (stableCount != 5000)
+         valid = false;
+   }
+
+   stop = true;
+   ThreadJoin(writer);
+   AssertTrue(valid);
+
+   EndTest();
+}
+
+/**
+ * Test reclamation of retired nodes and objects while long running reader holds index version
+ */
+static void TestIndexReclamation()
+{
+   StartTest(_T("Object index: reclamation"));
+
+   auto index = new SharedPointerIndex<IndexTestObject>();
+   for(uint64_t key = 0; key < 10000; key++)
+      index->put(key, new IndexTestObject(key));
+   AssertEquals(static_cast<uint64_t>(index->getRetiredNodeCount()), _ULL(0));
+
+   Condition readerStarted(true), readerRelease(true);
+   THREAD reader = ThreadCreateEx(
+      [index, &readerStarted, &readerRelease] () -> void
+      {
+         index->forEach(
+            [&readerStarted, &readerRelease] (IndexTestObject *object) -> EnumerationCallbackResult
+            {
+               readerStarted.set();
+               readerRelease.wait(INFINITE);
+               return _STOP;
+            });
+      });
+   AssertTrue(readerStarted.wait(5000));
+
+   // Removed object is still visible to reader and should not be destroyed
+   int32_t destroyedBefore = s_destroyedIndexObjects;
+   index->remove(5000);
+   AssertEquals(static_cast<int>(s_destroyedIndexObjects - destroyedBefore), 0);
+
+   // Each update copies path to modified leaf. Nodes created after reader's version should be destroyed
+   // immediately, so number of retired nodes is limited by size of tree seen by reader.
+   for(int i = 0; i < 5000; i++)
+   {
+      uint64_t key = (i * 7919) % 10000;
+      if (key != 5000)
+         index->put(key, new IndexTestObject(key));
+   }
+   size_t retiredNodes = index->getRetiredNodeCount();
+   AssertTrue(retiredNodes > 0);
+   AssertTrue(retiredNodes <= 10000 / 32);
+
+   readerRelease.set();
+   ThreadJoin(reader);
+
+   // Next update reclaims everything retired while reader was active
+   index->put(20000, new IndexTestObject(20000));
+   AssertEquals(static_cast<uint64_t>(index->getRetiredNodeCount()), _ULL(0));
+   AssertEquals(static_cast<int>(s_destroyedIndexObjects - destroyedBefore), 5001);
+
+   destroyedBefore = s_destroyedIndexObjects;
+   delete index;
+   AssertEquals(static_cast<int>(s_destroyedIndexObjects - destroyedBefore), 10000);
+
+   EndTest();
+}
+
+/**
+ * Node with access to instance update for instance discovery tests
+ */
+class InstanceTestNode : public Node
+{
+public:
+   bool testUpdateInstances(DCObject *root, StringObjectMap<InstanceDiscoveryData> *instances)
+   {
+      return updateInstances(root, instances, 0);
+   }
+};
+
+/**
+ * Test that instance DCI which reappears within grace period is re-activated and reported as changed,
+ * so that it will be saved and scheduled for data collection again
+ */
+static void TestInstanceGracePeriodReactivation()
+{
+   StartTest(_T("Instance discovery: grace period re-activation"));
+
+   auto node = make_shared<InstanceTestNode>();
+   DCItem *root = new DCItem(1001, L"Root", DS_NATIVE_AGENT, DCI_DT_INT, DC_POLLING_SCHEDULE_DEFAULT, nullptr, DC_RETENTION_DEFAULT, nullptr, node);
+   root->setInstanceDiscoveryMethod(IDM_AGENT_LIST);
+   node->addDCObject(root, false, false);
+
+   DCItem *instance = new DCItem(1002, L"Instance {instance}", DS_NATIVE_AGENT, DCI_DT_INT, DC_POLLING_SCHEDULE_DEFAULT, nullptr, DC_RETENTION_DEFAULT, nullptr, node);
+   instance->setTemplateId(node->getId(), root->getId());
+   instance->setInstanceDiscoveryData(L"eth0");
+   instance->setInstanceName(L"eth0");
+   node->addDCObject(instance, false, false);
+   AssertEquals(instance->getStatus(), static_cast<int>(ITEM_STATUS_ACTIVE));
+
+   // Instance missing - grace period starts and DCI is disabled
+   StringObjectMap<InstanceDiscoveryData> instances(Ownership::True);
+   AssertTrue(node->testUpdateInstances(root, &instances));
+   AssertTrue(instance->getInstanceGracePeriodStart() > 0);
+   AssertEquals(instance->getStatus(), static_cast<int>(ITEM_STATUS_DISABLED));
+
+   // Still missing - nothing changes
+   AssertFalse(node->testUpdateInstances(root, &instances));
+
+   // Instance is back - DCI is re-activated and change is reported
+   instances.set(L"eth0", new InstanceDiscoveryData(L"eth0", 0));
+   AssertTrue(node->testUpdateInstances(root, &instances));
+   AssertEquals(instance->getInstanceGracePeriodStart(), static_cast<time_t>(0));
+   AssertEquals(instance->getStatus(), static_cast<int>(ITEM_STATUS_ACTIVE));
+
+   // Instance still present - no changes
+   instances.set(L"eth0", new InstanceDiscoveryData(L"eth0", 0));
+   AssertFalse(node->testUpdateInstances(root, &instances));
+
+   EndTest();
+}
+
+/**
+ * Log definition used by log query tests
+ */
+static const NXCORE_LOG s_testLog =
+{
+   L"TestLog", L"test_log", L"record_id", nullptr, 0, nullptr,
+   {
+      { L"record_id", L"Record ID", LC_INTEGER, LCF_RECORD_ID },
+      { L"event_timestamp", L"Time", LC_TIMESTAMP, LCF_TSDB_TIMESTAMPTZ },
+      { L"severity", L"Severity", LC_SEVERITY, 0 },
+      { L"message", L"Message", LC_TEXT, 0 },
+      { nullptr, nullptr, 0, 0 }
+   }
+};
+
+/**
+ * Create log filter from JSON document
+ */
+static LogFilter *CreateLogFilter(LogHandle *log, const char *source)
+{
+   json_t *json = json_loads(source, 0, nullptr);
+   LogFilter *filter = new LogFilter(json, log);
+   json_decref(json);
+   return filter;
+}
+
+/**
+ * Test seek condition used for keyset pagination of log queries
+ */
+static void TestLogSeekCondition()
+{
+   StartTest(_T("BuildLogSeekCondition"));
+
+   int dbSyntax = g_dbSyntax;
+   g_dbSyntax = DB_SYNTAX_SQLITE;
+
+   StructArray<KeysetColumn> keyset;
+   KeysetColumn *k = keyset.addPlaceholder();
+   k->definition = &s_testLog.columns[1];
+   k->index = 1;
+   k->descending = true;
+   k = keyset.addPlaceholder();
+   k->definition = &s_testLog.columns[0];
+   k->index = 0;
+   k->descending = true;
+
+   IntegerArray<int64_t> key;
+   key.add(1000);
+   key.add(55);
+
+   // Descending order - record ID breaks ties on same timestamp in same direction
+   AssertTrue(!_tcscmp(BuildLogSeekCondition(keyset, key), _T("(event_timestamp<1000) OR (event_timestamp=1000 AND record_id<55)")));
+
+   // Ascending order
+   keyset.get(0)->descending = false;
+   keyset.get(1)->descending = false;
+   AssertTrue(!_tcscmp(BuildLogSeekCondition(keyset, key), _T("(event_timestamp>1000) OR (event_timestamp=1000 AND record_id>55)")));
+
+   // Each column uses its own direction
+   keyset.get(1)->descending = true;
+   AssertTrue(!_tcscmp(BuildLogSeekCondition(keyset, key), _T("(event_timestamp>1000) OR (event_timestamp=1000 AND record_id<55)")));
+
+   // Timestamp values are converted for TimescaleDB timestamptz columns
+   g_dbSyntax = DB_SYNTAX_TSDB;
+   AssertTrue(!_tcscmp(BuildLogSeekCondition(keyset, key), _T("(event_timestamp>to_timestamp(1000)) OR (event_timestamp=to_timestamp(1000) AND record_id<55)")));
+
+   g_dbSyntax = dbSyntax;
+   EndTest();
+}
+
+/**
+ * Test decoding of log query pagination cursor
+ */
+static void TestLogCursorDecoding()
+{
+   StartTest(_T("LogHandle::decodeCursor"));
+
+   int dbSyntax = g_dbSyntax;
+   g_dbSyntax = DB_SYNTAX_SQLITE;
+
+   LogHandle log(&s_testLog);
+   IntegerArray<int64_t> key;
+
+   // Ordering by timestamp gets record ID appended as tie breaker
+   LogFilter *filter = CreateLogFilter(&log, "{\"orderBy\":[{\"column\":\"event_timestamp\",\"descending\":true}]}");
+   AssertTrue(filter->isValid());
+   AssertTrue(log.decodeCursor(filter, "1000,55", &key));
+   AssertEquals(key.size(), 2);
+   AssertEquals(key.get(0), static_cast<int64_t>(1000));
+   AssertEquals(key.get(1), static_cast<int64_t>(55));
+   AssertTrue(log.decodeCursor(filter, "-1,0", &key));
+   AssertEquals(key.get(0), static_cast<int64_t>(-1));
+
+   // Seek condition follows descending order of timestamp for tie breaker
+   AssertTrue(log.decodeCursor(filter, "1000,55", &key));
+   StringBuffer sql = log.buildPagedQuerySql(filter, 0, 10, &key, 0);
+   AssertTrue(_tcsstr(sql, _T(" WHERE ((event_timestamp<1000) OR (event_timestamp=1000 AND record_id<55)) ORDER BY event_timestamp DESC,record_id DESC LIMIT 10")) != nullptr);
+
+   // Wrong number of key values
+   AssertFalse(log.decodeCursor(filter, "1000", &key));
+   AssertFalse(log.decodeCursor(filter, "1000,55,3", &key));
+
+   // Malformed cursors
+   static const char *malformed[] = { "", ",", "abc", "1000,", ",55", "1000;55", "1000,55x", "1000,,55", "0x10,55", nullptr };
+   for(int i = 0; malformed[i] != nullptr; i++)
+      AssertFalse(log.decodeCursor(filter, malformed[i], &key));
+   delete filter;
+
+   // Ordering by record ID only
+   filter = CreateLogFilter(&log, "{\"orderBy\":[{\"column\":\"record_id\",\"descending\":false}]}");
+   AssertTrue(log.decodeCursor(filter, "55", &key));
+   AssertEquals(key.size(), 1);
+   AssertFalse(log.decodeCursor(filter, "1000,55", &key));
+   delete filter;
+
+   // Orderings which do not allow keyset pagination
+   filter = CreateLogFilter(&log, "{\"orderBy\":[{\"column\":\"message\",\"descending\":false}]}");
+   AssertFalse(log.decodeCursor(filter, "1000,55", &key));
+   delete filter;
+
+   filter = CreateLogFilter(&log, "{}");
+   AssertFalse(log.decodeCursor(filter, "55", &key));
+   delete filter;
+
+   g_dbSyntax = dbSyntax;
+   EndTest();
+}
+
+/**
+ * main()
+ */
+int main(int argc, char *argv[])
+{
+   InitNetXMSProcess(true);
+
+   TestParseAggregateValue();
+   TestAggregateBucketRollover();
+   TestValueCache();
+   TestSNMPResponseValue();
+   TestKeyPatternPrefix();
+   TestInetAddressIndexPrefixSearch();
+   TestIndexBulkUpdate();
+   TestIndexConcurrentAccess();
+   TestIndexIterationUnderMutation();
+   TestIndexReclamation();
+   TestSchedulerCascade();
+   TestSchedulerRebase();
+   TestSchedulerTicketReplacement();
+   TestInstanceGracePeriodReactivation();
+   TestLogSeekCondition();
+   TestLogCursorDecoding();
+   return 0;
+}
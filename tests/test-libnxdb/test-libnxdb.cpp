@@ -11,6 +11,11 @@ NETXMS_EXECUTABLE_HEADER(test-libnxdb)
 #define MYSQL_LOGIN    _T("builder")
 #define MYSQL_PASSWORD _T("builder1")
 
+#define PGSQL_SERVER   _T("postgres")
+#define PGSQL_DBNAME   _T("nx_build_test")
+#define PGSQL_LOGIN    _T("builder")
+#define PGSQL_PASSWORD _T("builder1")
+
 #define ORA_SERVER   _T("//127.0.0.1/XE")
 #define ORA_LOGIN    _T("netxms")
 #define ORA_PASSWORD _T("netxms")
@@ -137,6 +142,268 @@ static void CommonTests(const TCHAR *prefix, const TCHAR *driver, const TCHAR *s
    EndTest();
 }
 
+/**
+ * Bind values for bulk load test record
+ */
+static void BindBulkLoadRecord(DB_BULK_LOAD hBulkLoad, int id)
+{
+   TCHAR value[64];
+   _sntprintf(value, 64, _T("value %d"), id);
+   DBBulkLoadBind(hBulkLoad, 1, static_cast<int32_t>(id));
+   DBBulkLoadBind(hBulkLoad, 2, static_cast<int64_t>(id) * _LL(1000000000));
+   DBBulkLoadBind(hBulkLoad, 3, value, DB_BIND_TRANSIENT);
+   DBBulkLoadBind(hBulkLoad, 4, id + 0.5);
+}
+
+/**
+ * Load records using bulk load. Returns false if bulk load is not supported or failed.
+ */
+static bool BulkLoadRecords(DB_HANDLE session, int first, int last)
+{
+   DB_BULK_LOAD hBulkLoad = DBBulkLoadBegin(session, _T("nx_bulk"), _T("id,ts,value,dvalue"));
+   if (hBulkLoad == nullptr)
+      return false;
+
+   for(int id = first; id <= last; id++)
+   {
+      BindBulkLoadRecord(hBulkLoad, id);
+      if (!DBBulkLoadAddRow(hBulkLoad))
+         break;
+   }
+   return DBBulkLoadEnd(hBulkLoad);
+}
+
+/**
+ * Insert records using INSERT statements, ignoring existing ones (same as fallback in server's DCI data writer)
+ */
+static bool InsertRecords(DB_HANDLE session, int first, int last, const TCHAR *syntax)
+{
+   const TCHAR *query = !_tcscmp(syntax, _T("PGSQL")) ?
+            _T("INSERT INTO nx_bulk (id,ts,value,dvalue) VALUES (?,?,?,?) ON CONFLICT DO NOTHING") :
+            _T("INSERT OR IGNORE INTO nx_bulk (id,ts,value,dvalue) VALUES (?,?,?,?)");
+   DB_STATEMENT hStmt = DBPrepare(session, query, true);
+   if (hStmt == nullptr)
+      return false;
+
+   bool success = DBBegin(session);
+   for(int id = first; (id <= last) && success; id++)
+   {
+      TCHAR value[64];
+      _sntprintf(value, 64, _T("value %d"), id);
+      DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, static_cast<int32_t>(id));
+      DBBind(hStmt, 2, DB_SQLTYPE_BIGINT, static_cast<int64_t>(id) * _LL(1000000000));
+      DBBind(hStmt, 3, DB_SQLTYPE_VARCHAR, value, DB_BIND_TRANSIENT);
+      DBBind(hStmt, 4, DB_SQLTYPE_DOUBLE, id + 0.5);
+      success = DBExecute(hStmt);
+   }
+   if (success)
+      success = DBCommit(session);
+   else
+      DBRollback(session);
+   DBFreeStatement(hStmt);
+   return success;
+}
+
+/**
+ * Get number of records in bulk load test table
+ */
+static int32_t GetBulkLoadRecordCount(DB_HANDLE session)
+{
+   DB_RESULT hResult = DBSelect(session, _T("SELECT count(*) FROM nx_bulk"));
+   if (hResult == nullptr)
+      return -1;
+   int32_t count = DBGetFieldInt32(hResult, 0, 0);
+   DBFreeResult(hResult);
+   return count;
+}
+
+/**
+ * Check values of bulk load test record
+ */
+static bool CheckBulkLoadRecord(DB_HANDLE session, int id)
+{
+   TCHAR query[256];
+   _sntprintf(query, 256, _T("SELECT ts,value,dvalue FROM nx_bulk WHERE id=%d"), id);
+   DB_RESULT hResult = DBSelect(session, query);
+   if (hResult == nullptr)
+      return false;
+
+   bool match = false;
+   if (DBGetNumRows(hResult) == 1)
+   {
+      TCHAR value[64], expectedValue[64];
+      _sntprintf(expectedValue, 64, _T("value %d"), id);
+      match = (DBGetFieldInt64(hResult, 0, 0) == static_cast<int64_t>(id) * _LL(1000000000)) &&
+               !_tcscmp(DBGetField(hResult, 0, 1, value, 64), expectedValue) &&
+               (DBGetFieldDouble(hResult, 0, 2) == id + 0.5);
+   }
+   DBFreeResult(hResult);
+   return match;
+}
+
+/**
+ * Bulk load tests. For drivers without bulk load support only fallback to INSERT statements is tested.
+ */
+static void BulkLoadTests(const TCHAR *prefix, const TCHAR *driver, const TCHAR *server,
+         const TCHAR *dbName, const TCHAR *login, const TCHAR *password, const TCHAR *syntax)
+{
+   DB_DRIVER drv = DBLoadDriver(driver, _T(""), nullptr, nullptr);
+   if (drv == nullptr)
+      return;
+
+   TCHAR buffer[DBDRV_MAX_ERROR_TEXT];
+   DB_HANDLE session = DBConnect(drv, server, dbName, login, password, nullptr, buffer);
+   if (session == nullptr)
+   {
+      DBUnloadDriver(drv);
+      return;
+   }
+
+   bool supported = DBIsBulkLoadSupported(drv);
+
+   if (DBIsTableExist(session, _T("nx_bulk")) == DBIsTableExist_Found)
+      DBQuery(session, _T("DROP TABLE nx_bulk"));
+   AssertTrueEx(DBQueryEx(session, _T("CREATE TABLE nx_bulk (id integer not null, ts bigint not null, value varchar(63), dvalue double precision, PRIMARY KEY(id))"), buffer), buffer);
+
+   /*** bulk load (COPY for PostgreSQL) ***/
+   StartTest(prefix, _T("bulk load"));
+   if (supported)
+   {
+      AssertTrue(BulkLoadRecords(session, 1, 1000));
+   }
+   else
+   {
+      AssertNull(DBBulkLoadBegin(session, _T("nx_bulk"), _T("id,ts,value,dvalue")));
+      AssertTrue(InsertRecords(session, 1, 1000, syntax));
+   }
+   AssertEquals(GetBulkLoadRecordCount(session), 1000);
+   AssertTrue(CheckBulkLoadRecord(session, 1));
+   AssertTrue(CheckBulkLoadRecord(session, 500));
+   AssertTrue(CheckBulkLoadRecord(session, 1000));
+   EndTest();
+
+   /*** repeated bulk load on same connection (uses cached column types) ***/
+   StartTest(prefix, _T("repeated bulk load"));
+   AssertTrue(supported ? BulkLoadRecords(session, 1001, 2000) : InsertRecords(session, 1001, 2000, syntax));
+   AssertEquals(GetBulkLoadRecordCount(session), 2000);
+   AssertTrue(CheckBulkLoadRecord(session, 1500));
+   EndTest();
+
+   /*** bulk load with duplicate records fails as a whole and records are re-written with INSERT ***/
+   StartTest(prefix, _T("bulk load fallback to INSERT"));
+   if (supported)
+   {
+      AssertFalse(BulkLoadRecords(session, 1991, 2010));
+      AssertEquals(GetBulkLoadRecordCount(session), 2000);
+   }
+   AssertTrue(InsertRecords(session, 1991, 2010, syntax));
+   AssertEquals(GetBulkLoadRecordCount(session), 2010);
+   AssertTrue(CheckBulkLoadRecord(session, 2005));
+   EndTest();
+
+   if (supported)
+   {
+      /*** cancelled bulk load ***/
+      StartTest(prefix, _T("cancelled bulk load"));
+      DB_BULK_LOAD hBulkLoad = DBBulkLoadBegin(session, _T("nx_bulk"), _T("id,ts,value,dvalue"));
+      AssertNotNull(hBulkLoad);
+      for(int id = 3001; id <= 3010; id++)
+      {
+         BindBulkLoadRecord(hBulkLoad, id);
+         AssertTrue(DBBulkLoadAddRow(hBulkLoad));
+      }
+      DBBulkLoadCancel(hBulkLoad);
+      AssertEquals(GetBulkLoadRecordCount(session), 2010);
+      EndTest();
+
+      /*** bulk load after table structure change ***/
+      StartTest(prefix, _T("bulk load after table change"));
+      AssertTrue(DBQuery(session, _T("DROP TABLE nx_bulk")));
+      AssertTrueEx(DBQueryEx(session, _T("CREATE TABLE nx_bulk (id bigint not null, ts bigint not null, value varchar(63), dvalue real, PRIMARY KEY(id))"), buffer), buffer);
+      // First bulk load may fail because of column types cached for previous table structure
+      bool success = BulkLoadRecords(session, 1, 100) || BulkLoadRecords(session, 1, 100);
+      AssertTrue(success);
+      AssertEquals(GetBulkLoadRecordCount(session), 100);
+      AssertTrue(CheckBulkLoadRecord(session, 50));
+      EndTest();
+   }
+
+   DBQuery(session, _T("DROP TABLE nx_bulk"));
+   DBDisconnect(session);
+   DBUnloadDriver(drv);
+}
+
+/**
+ * Connection pool tests
+ */
+static void ConnectionPoolTests(const TCHAR *prefix, const TCHAR *driver, const TCHAR *server,
+         const TCHAR *dbName, const TCHAR *login, const TCHAR *password)
+{
+   DB_DRIVER drv = DBLoadDriver(driver, _T(""), nullptr, nullptr);
+   if (drv == nullptr)
+      return;
+
+   StartTest(prefix, _T("connection pool startup"));
+   AssertTrue(DBConnectionPoolStartup(drv, server, dbName, login, password, nullptr, 1, 1, 300, 14400));
+   AssertEquals(DBConnectionPoolGetSize(), 1);
+   uint32_t histogram[DB_POOL_WAIT_HISTOGRAM_SIZE];
+   DBConnectionPoolGetWaitTimeHistogram(histogram);
+   for(int i = 0; i < DB_POOL_WAIT_HISTOGRAM_SIZE; i++)
+      AssertEquals(histogram[i], 0u);
+   EndTest();
+
+   StartTest(prefix, _T("connection pool acquire without wait"));
+   for(int i = 0; i < 10; i++)
+   {
+      DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+      AssertNotNull(hdb);
+      AssertEquals(DBConnectionPoolGetAcquiredCount(), 1);
+      DBConnectionPoolReleaseConnection(hdb);
+   }
+   AssertEquals(DBConnectionPoolGetAcquiredCount(), 0);
+   DBConnectionPoolGetWaitTimeHistogram(histogram);
+   AssertEquals(histogram[0], 10u);
+   for(int i = 1; i < DB_POOL_WAIT_HISTOGRAM_SIZE; i++)
+      AssertEquals(histogram[i], 0u);
+   EndTest();
+
+   StartTest(prefix, _T("connection pool wait time histogram"));
+   DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+   AssertNotNull(hdb);
+   DB_HANDLE waiterHandle = nullptr;
+   THREAD waiter = ThreadCreateEx(
+      [&waiterHandle] () -> void
+      {
+         waiterHandle = DBConnectionPoolAcquireConnection();
+      });
+   ThreadSleepMs(200);
+   AssertNull(waiterHandle);
+   DBConnectionPoolReleaseConnection(hdb);
+   ThreadJoin(waiter);
+   AssertTrue(waiterHandle == hdb);   // Released connection handed over to waiting thread
+   DBConnectionPoolReleaseConnection(waiterHandle);
+
+   DBConnectionPoolGetWaitTimeHistogram(histogram);
+   AssertEquals(histogram[0], 11u);
+   AssertEquals(histogram[1] + histogram[2], 0u);
+   AssertEquals(histogram[3], 1u);   // waited between 100 ms and 1 second
+   AssertEquals(histogram[4] + histogram[5], 0u);
+
+   ObjectArray<PoolConnectionInfo> *list = DBConnectionPoolGetConnectionList();
+   AssertTrue(list->isEmpty());
+   delete list;
+   EndTest();
+
+   StartTest(prefix, _T("connection pool shutdown"));
+   DBConnectionPoolShutdown();
+   DBConnectionPoolGetWaitTimeHistogram(histogram);
+   for(int i = 0; i < DB_POOL_WAIT_HISTOGRAM_SIZE; i++)
+      AssertEquals(histogram[i], 0u);
+   EndTest();
+
+   DBUnloadDriver(drv);
+}
+
 /**
  * main()
  */
@@ -145,6 +412,7 @@ int main(int argc, char *argv[])
    InitNetXMSProcess(true);
 
    bool skipMySQL = false;
+   bool skipPgSQL = false;
    bool skipOracle = false;
    bool skipSQLite = false;
 
@@ -152,6 +420,8 @@ int main(int argc, char *argv[])
    {
       if (!strcmp(argv[i], "--skip-mysql"))
          skipMySQL = true;
+      else if (!strcmp(argv[i], "--skip-pgsql"))
+         skipPgSQL = true;
       else if (!strcmp(argv[i], "--skip-oracle"))
          skipOracle = true;
       else if (!strcmp(argv[i], "--skip-sqlite"))
@@ -165,6 +435,12 @@ int main(int argc, char *argv[])
       CommonTests(_T("MySQL"), _T("mysql.ddr"), MYSQL_SERVER, MYSQL_DBNAME, MYSQL_LOGIN, MYSQL_PASSWORD, _T("MYSQL"));
    }
 
+   if (!skipPgSQL)
+   {
+      CommonTests(_T("PostgreSQL"), _T("pgsql.ddr"), PGSQL_SERVER, PGSQL_DBNAME, PGSQL_LOGIN, PGSQL_PASSWORD, _T("PGSQL"));
+      BulkLoadTests(_T("PostgreSQL"), _T("pgsql.ddr"), PGSQL_SERVER, PGSQL_DBNAME, PGSQL_LOGIN, PGSQL_PASSWORD, _T("PGSQL"));
+   }
+
    if (!skipOracle)
    {
       CommonTests(_T("Oracle"), _T("oracle.ddr"), ORA_SERVER, NULL, ORA_LOGIN, ORA_PASSWORD, _T("ORACLE"));
@@ -174,6 +450,8 @@ int main(int argc, char *argv[])
    if (!skipSQLite)
    {
       CommonTests(_T("SQLite"), _T("sqlite.ddr"), SQLITE_DB, NULL, NULL, NULL, _T("SQLITE"));
+      BulkLoadTests(_T("SQLite"), _T("sqlite.ddr"), SQLITE_DB, nullptr, nullptr, nullptr, _T("SQLITE"));
+      ConnectionPoolTests(_T("SQLite"), _T("sqlite.ddr"), SQLITE_DB, nullptr, nullptr, nullptr);
    }
    return 0;
 }
@@ -0,0 +1,348 @@
+#include <nms_common.h>
+#include <nms_util.h>
+#include <testtools.h>
+#include <netxms-version.h>
+#include "libnxlp.h"
+#include <nxstat.h>
+
+NETXMS_EXECUTABLE_HEADER(test-libnxlp)
+
+/**
+ * Check literal extracted from regular expression
+ */
+static void CheckLiteral(const TCHAR *regexp, const char *expected)
+{
+   char literal[MAX_LITERAL_LENGTH + 1];
+   bool success = ExtractRequiredLiteral(regexp, literal);
+   if (expected != nullptr)
+   {
+      AssertTrue(success);
+      AssertEquals(literal, expected);
+   }
+   else
+   {
+      AssertFalse(success);
+   }
+}
+
+/**
+ * Test extraction of required literals from regular expressions
+ */
+static void TestExtractRequiredLiteral()
+{
+   StartTest(_T("ExtractRequiredLiteral"));
+
+   // Plain literals are converted to lower case
+   CheckLiteral(_T("Error: Disk Full"), "error: disk full");
+   CheckLiteral(_T("\\d+ packets dropped"), " packets dropped");
+   CheckLiteral(_T("User \\w+ logged in"), " logged in");
+   CheckLiteral(_T("^Connection from ([0-9.]+) refused$"), "connection from ");
+   CheckLiteral(_T("^.*timeout\\t+waiting"), "timeout\t");
+
+   // Character classes and groups end literal run
+   CheckLiteral(_T("abc[xyz]defgh"), "defgh");
+   CheckLiteral(_T("abcd(?:efghijk)lmn"), "abcd");
+   CheckLiteral(_T("start[[:digit:]]+ending"), "ending");
+
+   // Quantifiers
+   CheckLiteral(_T("colou?r failure"), "r failure");
+   CheckLiteral(_T("x{0,3}abcd"), "abcd");
+   CheckLiteral(_T("abcde*fg"), "abcd");
+   CheckLiteral(_T("abcde+fg"), "abcde");
+   CheckLiteral(_T("abcde{2}fg"), "abcde");
+   CheckLiteral(_T("abcde*?f"), "abcd");
+   CheckLiteral(_T("abc{x}defg"), "x}defg");
+
+   // Non-ASCII characters end literal run
+   CheckLiteral(_T("Fehler: Datei größer als erlaubt"), "fehler: datei gr");
+   CheckLiteral(_T("Ошибка диска"), nullptr);
+
+   // Unsupported constructs or too short literals
+   CheckLiteral(_T("abc|def"), nullptr);
+   CheckLiteral(_T("(?i)error"), nullptr);
+   CheckLiteral(_T("(*UCP)error"), nullptr);
+   CheckLiteral(_T("error\\x41bcd"), nullptr);
+   CheckLiteral(_T("(abc)\\1"), nullptr);
+   CheckLiteral(_T("abc)"), nullptr);
+   CheckLiteral(_T("abc[def"), nullptr);
+   CheckLiteral(_T("ab.cd"), nullptr);
+   CheckLiteral(_T(".*"), nullptr);
+   CheckLiteral(_T("error\\"), nullptr);
+
+   EndTest();
+}
+
+/**
+ * Create rule for prefilter test
+ */
+static LogParserRule *CreateRule(const TCHAR *regexp, bool ignoreCase = false, bool inverted = false)
+{
+   LogParserRule *rule = new LogParserRule(nullptr, regexp, regexp, ignoreCase, 0, nullptr, nullptr, 0, 0, false, StructArray<LogParserMetric>());
+   rule->setInverted(inverted);
+   return rule;
+}
+
+/**
+ * Test prefilter automaton
+ */
+static void TestPrefilter()
+{
+   StartTest(_T("LogParserPrefilter"));
+
+   ObjectArray<LogParserRule> rules(16, 16, Ownership::True);
+   rules.add(CreateRule(_T("Disk full on (.*)")));     // 0
+   rules.add(CreateRule(_T("link down")));             // 1
+   rules.add(CreateRule(_T("down")));                  // 2 - suffix of rule 1 literal
+   rules.add(CreateRule(_T("^.*$")));                  // 3 - no literal
+   rules.add(CreateRule(_T("abc|def")));               // 4 - not analyzable
+   rules.add(CreateRule(_T("link down"), false, true));// 5 - inverted
+   rules.add(CreateRule(_T("ab")));                    // 6 - literal too short
+   rules.add(CreateRule(_T("kelvin"), true));          // 7 - caseless
+   rules.add(CreateRule(_T("link up")));               // 8 - shares prefix with rule 1
+
+   LogParserPrefilter prefilter(rules);
+   AssertEquals(prefilter.getFilteredRuleCount(), 5);
+
+   static const bool expectedAlways[] = { false, false, false, true, true, true, true, false, false };
+
+   prefilter.scan(_T("Interface eth0: LINK DOWN"));
+   static const bool expected1[] = { false, true, true, true, true, true, true, false, false };
+   for(int i = 0; i < rules.size(); i++)
+      AssertTrue(prefilter.isCandidate(i) == expected1[i]);
+
+   prefilter.scan(_T("disk full on /var"));
+   static const bool expected2[] = { true, false, false, true, true, true, true, false, false };
+   for(int i = 0; i < rules.size(); i++)
+      AssertTrue(prefilter.isCandidate(i) == expected2[i]);
+
+   // Match through dictionary suffix link and transitions from leaf state
+   prefilter.scan(_T("shutdown down downdown"));
+   static const bool expected3[] = { false, false, true, true, true, true, true, false, false };
+   for(int i = 0; i < rules.size(); i++)
+      AssertTrue(prefilter.isCandidate(i) == expected3[i]);
+
+   // Failure links: "link link up" requires falling back from "link " state
+   prefilter.scan(_T("link link up"));
+   static const bool expected4[] = { false, false, false, true, true, true, true, false, true };
+   for(int i = 0; i < rules.size(); i++)
+      AssertTrue(prefilter.isCandidate(i) == expected4[i]);
+
+   // Candidates from previous line are not carried over
+   prefilter.scan(_T("nothing interesting"));
+   for(int i = 0; i < rules.size(); i++)
+      AssertTrue(prefilter.isCandidate(i) == expectedAlways[i]);
+
+   prefilter.scan(_T(""));
+   for(int i = 0; i < rules.size(); i++)
+      AssertTrue(prefilter.isCandidate(i) == expectedAlways[i]);
+
+   // Non-ASCII characters reset automaton and make caseless rules candidates
+   prefilter.scan(_T("Kelvin liénk down"));
+   static const bool expected5[] = { false, false, true, true, true, true, true, true, false };
+   for(int i = 0; i < rules.size(); i++)
+      AssertTrue(prefilter.isCandidate(i) == expected5[i]);
+
+   prefilter.scan(_T("liénk up"));
+   static const bool expected6[] = { false, false, false, true, true, true, true, true, false };
+   for(int i = 0; i < rules.size(); i++)
+      AssertTrue(prefilter.isCandidate(i) == expected6[i]);
+
+   EndTest();
+}
+
+#if HAVE_SYS_INOTIFY_H
+
+/**
+ * Append line to file
+ */
+static void AppendLine(const char *path, const char *line)
+{
+   FILE *f = fopen(path, "a");
+   AssertNotNull(f);
+   fputs(line, f);
+   fputc('\n', f);
+   fclose(f);
+}
+
+/**
+ * Add file change watch for given file
+ */
+static FileChangeWatch *AddWatch(const char *path, Condition *wakeup)
+{
+   TCHAR tpath[MAX_PATH];
+   _sntprintf(tpath, MAX_PATH, _T("%hs"), path);
+   NX_STAT_STRUCT st;
+   AssertEquals(CALL_STAT_A(path, &st), 0);
+   return AddFileChangeWatch(tpath, &st, wakeup);
+}
+
+/**
+ * Check if watch is still valid for given file
+ */
+static bool IsWatchValid(FileChangeWatch *watch, const char *path)
+{
+   TCHAR tpath[MAX_PATH];
+   _sntprintf(tpath, MAX_PATH, _T("%hs"), path);
+   NX_STAT_STRUCT st;
+   AssertEquals(CALL_STAT_A(path, &st), 0);
+   return IsFileChangeWatchValid(watch, tpath, &st);
+}
+
+/**
+ * Wait until watch is invalidated by kernel (removal of watch descriptor is reported asynchronously)
+ */
+static bool WaitForWatchInvalidation(FileChangeWatch *watch, const char *path, const NX_STAT_STRUCT *st)
+{
+   TCHAR tpath[MAX_PATH];
+   _sntprintf(tpath, MAX_PATH, _T("%hs"), path);
+   for(int i = 0; i < 50; i++)
+   {
+      if (!IsFileChangeWatchValid(watch, tpath, st))
+         return true;
+      ThreadSleepMs(100);
+   }
+   return false;
+}
+
+/**
+ * Test file change notifications via inotify
+ */
+static void TestFileChangeWatch()
+{
+   StartTest(_T("File change watch"));
+
+   char dir[] = "/tmp/test-libnxlp.XXXXXX";
+   AssertNotNull(mkdtemp(dir));
+
+   char path[MAX_PATH], rotatedPath[MAX_PATH];
+   snprintf(path, MAX_PATH, "%s/test.log", dir);
+   snprintf(rotatedPath, MAX_PATH, "%s/test.log.1", dir);
+   AppendLine(path, "first");
+
+   // Write to file wakes up all watches for that file
+   Condition wakeup1(false), wakeup2(false);
+   FileChangeWatch *watch1 = AddWatch(path, &wakeup1);
+   FileChangeWatch *watch2 = AddWatch(path, &wakeup2);
+   AssertTrue(HasFileChangeNotifications(watch1));
+   AssertTrue(HasFileChangeNotifications(watch2));
+   AssertTrue(IsWatchValid(watch1, path));
+   AppendLine(path, "second");
+   AssertTrue(wakeup1.wait(5000));
+   AssertTrue(wakeup2.wait(5000));
+
+   // Removing one watch should not affect other watch on same file
+   RemoveFileChangeWatch(watch2);
+   wakeup1.reset();
+   AppendLine(path, "third");
+   AssertTrue(wakeup1.wait(5000));
+   AssertTrue(IsWatchValid(watch1, path));
+
+   // Rotation by rename, then re-creation of file with same name
+   NX_STAT_STRUCT st;
+   AssertEquals(CALL_STAT_A(path, &st), 0);
+   wakeup1.reset();
+   AssertEquals(rename(path, rotatedPath), 0);
+   AssertTrue(wakeup1.wait(5000));
+   wakeup1.reset();
+   AppendLine(path, "new file");
+   AssertTrue(wakeup1.wait(5000));
+   AssertFalse(IsWatchValid(watch1, path));
+   RemoveFileChangeWatch(watch1);
+
+   // New watch after rotation
+   watch1 = AddWatch(path, &wakeup1);
+   AssertTrue(IsWatchValid(watch1, path));
+   AppendLine(path, "fourth");
+   AssertTrue(wakeup1.wait(5000));
+
+   // Deletion invalidates file watch but directory watch still detects re-creation
+   AssertEquals(CALL_STAT_A(path, &st), 0);
+   wakeup1.reset();
+   AssertEquals(unlink(path), 0);
+   AssertTrue(wakeup1.wait(5000));
+   AssertTrue(WaitForWatchInvalidation(watch1, path, &st));
+   AssertTrue(HasFileChangeNotifications(watch1));
+   wakeup1.reset();
+   AppendLine(path, "re-created");
+   AssertTrue(wakeup1.wait(5000));
+   RemoveFileChangeWatch(watch1);
+
+   unlink(path);
+   unlink(rotatedPath);
+   rmdir(dir);
+
+   EndTest();
+}
+
+/**
+ * Test concurrent adding and removing of file change watches
+ */
+static void TestFileChangeWatchConcurrency()
+{
+   StartTest(_T("File change watch concurrency"));
+
+   char dir[] = "/tmp/test-libnxlp.XXXXXX";
+   AssertNotNull(mkdtemp(dir));
+
+   static const int threadCount = 4;
+   char paths[threadCount][MAX_PATH];
+   for(int i = 0; i < threadCount; i++)
+   {
+      snprintf(paths[i], MAX_PATH, "%s/test%d.log", dir, i);
+      AppendLine(paths[i], "line");
+   }
+
+   // Watch count drops to zero repeatedly, so dispatcher is started and stopped concurrently with adding watches
+   VolatileCounter failures = 0;
+   THREAD threads[threadCount];
+   for(int i = 0; i < threadCount; i++)
+   {
+      threads[i] = ThreadCreateEx(
+         [&paths, &failures, i] () -> void
+         {
+            Condition wakeup(false);
+            for(int n = 0; n < 500; n++)
+            {
+               FileChangeWatch *watch = AddWatch(paths[(i + n) % threadCount], &wakeup);
+               if (!HasFileChangeNotifications(watch))
+                  InterlockedIncrement(&failures);
+               RemoveFileChangeWatch(watch);
+            }
+         });
+   }
+   for(int i = 0; i < threadCount; i++)
+      ThreadJoin(threads[i]);
+   AssertEquals(static_cast<int>(failures), 0);
+
+   // Notifications should still be delivered after all watches were removed
+   Condition wakeup(false);
+   FileChangeWatch *watch = AddWatch(paths[0], &wakeup);
+   AssertTrue(HasFileChangeNotifications(watch));
+   AppendLine(paths[0], "after");
+   AssertTrue(wakeup.wait(5000));
+   RemoveFileChangeWatch(watch);
+
+   for(int i = 0; i < threadCount; i++)
+      unlink(paths[i]);
+   rmdir(dir);
+
+   EndTest();
+}
+
+#endif /* HAVE_SYS_INOTIFY_H */
+
+/**
+ * main()
+ */
+int main(int argc, char *argv[])
+{
+   InitNetXMSProcess(true);
+
+   TestExtractRequiredLiteral();
+   TestPrefilter();
+#if HAVE_SYS_INOTIFY_H
+   TestFileChangeWatch();
+   TestFileChangeWatchConcurrency();
+#endif
+   return 0;
+}
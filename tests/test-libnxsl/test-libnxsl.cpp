@@ -83,6 +83,50 @@ static void TestStop()
    EndTest();
 }
 
+/**
+ * Test NXSL VM reset (used for reusing pooled VMs)
+ */
+static void TestReset()
+{
+   StartTest(_T("NXSL_VM::reset"));
+
+   NXSL_Environment compileTimeEnvironment;
+   NXSL_CompilationDiagnostic compileDiag;
+   NXSL_Program *p = NXSLCompile(_T("global mode; if (mode == 1) return NoSuchFunction(); return 7;"), &compileTimeEnvironment, &compileDiag);
+   AssertNotNull(p);
+
+   NXSL_VM *vm = new NXSL_VM(new NXSL_Environment());
+   AssertTrue(vm->load(p));
+
+   vm->setGlobalVariable("mode", vm->createValue(1));
+   AssertFalse(vm->run());
+   AssertEquals(vm->getErrorCode(), NXSL_ERR_NO_FUNCTION);
+   AssertNotNull(vm->findGlobalVariable("mode"));
+
+   // Reset should clear error state and globals set by previous user, but keep loaded program
+   vm->reset();
+   AssertEquals(vm->getErrorCode(), 0);
+   AssertEquals(vm->getErrorText(), _T(""));
+   AssertNull(vm->getResult());
+   AssertNull(vm->findGlobalVariable("mode"));
+   AssertTrue(vm->run());
+   AssertNotNull(vm->getResult());
+   AssertEquals(vm->getResult()->getValueAsInt32(), 7);
+
+   // Stop request from previous user should not affect next one
+   vm->stop();
+   AssertTrue(vm->isStopRequested());
+   vm->reset();
+   AssertFalse(vm->isStopRequested());
+   AssertTrue(vm->run());
+   AssertEquals(vm->getResult()->getValueAsInt32(), 7);
+
+   delete vm;
+   delete p;
+
+   EndTest();
+}
+
 /**
  * Run test NXSL script
  */
@@ -159,6 +203,7 @@ int main(int argc, char *argv[])
 
    TestCompiler();
    TestStop();
+   TestReset();
    RunTestScript(_T("addr.nxsl"));
    RunTestScript(_T("arrays.nxsl"));
    RunTestScript(_T("base64.nxsl"));
@@ -178,6 +223,7 @@ int main(int argc, char *argv[])
    RunTestScript(_T("math.nxsl"));
    RunTestScript(_T("range.nxsl"));
    RunTestScript(_T("regexp.nxsl"));
+   RunTestScript(_T("slots.nxsl"));
    RunTestScript(_T("strings.nxsl"));
    RunTestScript(_T("time.nxsl"));
    RunTestScript(_T("try-catch.nxsl"));
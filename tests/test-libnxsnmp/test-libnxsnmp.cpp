@@ -338,6 +338,293 @@ static void TestPDUEncoding()
    EndTest();
 }
 
+/**
+ * Simulated SNMP agent for walk tests. Requests are passed through encoder and parser,
+ * responses are generated from static MIB.
+ */
+class WalkTestTransport : public SNMP_Transport
+{
+private:
+   ObjectArray<SNMP_ObjectId> m_mib;
+   SNMP_PDU *m_request;
+
+public:
+   int getRequests;
+   int getNextRequests;
+   int getBulkRequests;
+   uint32_t firstMaxRepetitions;
+   uint32_t lastMaxRepetitions;
+   uint32_t timeoutAbove;   // Simulate dropped responses for GETBULK requests with larger max-repetitions (0 to disable)
+   bool unresponsive;       // Simulate unreachable agent
+
+   WalkTestTransport() : m_mib(0, 64, Ownership::True)
+   {
+      m_request = nullptr;
+      getRequests = 0;
+      getNextRequests = 0;
+      getBulkRequests = 0;
+      firstMaxRepetitions = 0;
+      lastMaxRepetitions = 0;
+      timeoutAbove = 0;
+      unresponsive = false;
+      m_reliable = true;
+      for(uint32_t column = 1; column <= 2; column++)
+         for(uint32_t index = 1; index <= 50; index++)
+            m_mib.add(new SNMP_ObjectId({ 1, 3, 6, 1, 2, 1, 2, 2, 1, column, index }));
+      m_mib.add(new SNMP_ObjectId({ 1, 3, 6, 1, 2, 1, 4, 1, 0 }));
+   }
+
+   virtual ~WalkTestTransport()
+   {
+      delete m_request;
+   }
+
+   virtual int readMessage(SNMP_PDU **pdu, uint32_t timeout, struct sockaddr *sender, socklen_t *addrSize, SNMP_SecurityContext* (*contextFinder)(struct sockaddr *, socklen_t)) override
+   {
+      if (unresponsive || ((timeoutAbove > 0) && (m_request->getCommand() == SNMP_GET_BULK_REQUEST) && (m_request->getMaxRepetitions() > timeoutAbove)))
+         return 0;   // Timeout
+
+      SNMP_PDU *response = new SNMP_PDU(SNMP_RESPONSE, m_request->getRequestId(), m_request->getVersion());
+      const SNMP_ObjectId& start = m_request->getVariable(0)->getName();
+      int i = 0;
+      for(; i < m_mib.size(); i++)
+      {
+         int cr = m_mib.get(i)->compare(start);
+         if ((cr == OID_FOLLOWING) || (cr == OID_LONGER))
+            break;
+      }
+      int count = (m_request->getCommand() == SNMP_GET_BULK_REQUEST) ? static_cast<int>(m_request->getMaxRepetitions()) : 1;
+      for(int n = 0; n < count; n++, i++)
+      {
+         SNMP_Variable *v;
+         if (i < m_mib.size())
+         {
+            v = new SNMP_Variable(*m_mib.get(i));
+            v->setValueFromUInt32(ASN_INTEGER, i);
+         }
+         else
+         {
+            v = new SNMP_Variable(*m_mib.get(m_mib.size() - 1), ASN_END_OF_MIBVIEW);
+         }
+         response->bindVariable(v);
+      }
+      *pdu = response;
+      return 1;
+   }
+
+   virtual int sendMessage(SNMP_PDU *pdu, uint32_t timeout) override
+   {
+      SNMP_PDUBuffer buffer;
+      size_t size = pdu->encode(&buffer, m_securityContext);
+      delete m_request;
+      m_request = new SNMP_PDU();
+      if ((size == 0) || !m_request->parse(buffer, size, m_securityContext, false))
+         return -1;
+      switch(m_request->getCommand())
+      {
+         case SNMP_GET_REQUEST:
+            getRequests++;
+            break;
+         case SNMP_GET_NEXT_REQUEST:
+            getNextRequests++;
+            break;
+         case SNMP_GET_BULK_REQUEST:
+            if (getBulkRequests++ == 0)
+               firstMaxRepetitions = m_request->getMaxRepetitions();
+            lastMaxRepetitions = m_request->getMaxRepetitions();
+            break;
+         default:
+            break;
+      }
+      return static_cast<int>(size);
+   }
+
+   virtual InetAddress getPeerIpAddress() override { return InetAddress::LOOPBACK; }
+   virtual uint16_t getPort() override { return 161; }
+   virtual bool isProxyTransport() override { return false; }
+};
+
+/**
+ * Test SNMP walk using GETNEXT and GETBULK requests
+ */
+static void TestWalk()
+{
+   StartTest(_T("SnmpWalk (GETNEXT/GETBULK)"));
+
+   SNMP_PDU pdu(SNMP_GET_BULK_REQUEST, SnmpNewRequestId(), SNMP_VERSION_2C);
+   pdu.setBulkParameters(0, 20);
+   pdu.bindVariable(new SNMP_Variable({ 1, 3, 6, 1, 2, 1, 2, 2, 1, 1 }));
+   SNMP_SecurityContext securityContext("public");
+   SNMP_PDUBuffer encodedPDU;
+   size_t size = pdu.encode(&encodedPDU, &securityContext);
+   AssertTrue(size > 0);
+   SNMP_PDU pdu2;
+   AssertTrue(pdu2.parse(encodedPDU, size, &securityContext, false));
+   AssertEquals(pdu2.getCommand(), SNMP_GET_BULK_REQUEST);
+   AssertEquals(pdu2.getNonRepeaters(), static_cast<uint32_t>(0));
+   AssertEquals(pdu2.getMaxRepetitions(), static_cast<uint32_t>(20));
+
+   WalkTestTransport transport;
+   transport.setSecurityContext(new SNMP_SecurityContext("public"));
+   int count = 0;
+   uint32_t rc = SnmpWalk(&transport, { 1, 3, 6, 1, 2, 1, 2, 2, 1, 1 }, [&count] (SNMP_Variable *v) -> uint32_t { count++; return SNMP_ERR_SUCCESS; });
+   AssertEquals(rc, static_cast<uint32_t>(SNMP_ERR_SUCCESS));
+   AssertEquals(count, 50);
+   AssertEquals(transport.getNextRequests, 51);
+   AssertEquals(transport.getBulkRequests, 0);
+
+   transport.enableBulkWalk(40);
+   count = 0;
+   rc = SnmpWalk(&transport, { 1, 3, 6, 1, 2, 1, 2, 2, 1, 1 }, [&count] (SNMP_Variable *v) -> uint32_t { count++; return SNMP_ERR_SUCCESS; });
+   AssertEquals(rc, static_cast<uint32_t>(SNMP_ERR_SUCCESS));
+   AssertEquals(count, 50);
+   AssertEquals(transport.getBulkRequests, 3);   // 10 + 20 + 40 repetitions
+   AssertEquals(transport.lastMaxRepetitions, static_cast<uint32_t>(40));
+
+   // Walk past end of MIB view
+   count = 0;
+   rc = SnmpWalk(&transport, { 1, 3, 6, 1, 2, 1 }, [&count] (SNMP_Variable *v) -> uint32_t { count++; return SNMP_ERR_SUCCESS; });
+   AssertEquals(rc, static_cast<uint32_t>(SNMP_ERR_SUCCESS));
+   AssertEquals(count, 101);
+
+   // Responses with more than 15 varbinds are dropped on the path - walk should adapt and complete
+   transport.timeoutAbove = 15;
+   count = 0;
+   rc = SnmpWalk(&transport, { 1, 3, 6, 1, 2, 1, 2, 2, 1, 1 }, [&count] (SNMP_Variable *v) -> uint32_t { count++; return SNMP_ERR_SUCCESS; });
+   AssertEquals(rc, static_cast<uint32_t>(SNMP_ERR_SUCCESS));
+   AssertEquals(count, 50);
+   transport.timeoutAbove = 0;
+
+   // Adaptive max-repetitions is not kept in transport, next walk starts with initial value
+   transport.getBulkRequests = 0;
+   count = 0;
+   rc = SnmpWalk(&transport, { 1, 3, 6, 1, 2, 1, 2, 2, 1, 2 }, [&count] (SNMP_Variable *v) -> uint32_t { count++; return SNMP_ERR_SUCCESS; });
+   AssertEquals(rc, static_cast<uint32_t>(SNMP_ERR_SUCCESS));
+   AssertEquals(count, 50);
+   AssertEquals(transport.firstMaxRepetitions, static_cast<uint32_t>(SNMP_BULK_WALK_INITIAL_REPETITIONS));
+   AssertEquals(transport.getBulkWalkMaxRepetitions(), static_cast<uint32_t>(40));
+
+   // Unreachable agent - walk should fail on first timeout without retrying with smaller max-repetitions
+   transport.unresponsive = true;
+   transport.getBulkRequests = 0;
+   count = 0;
+   rc = SnmpWalk(&transport, { 1, 3, 6, 1, 2, 1, 2, 2, 1, 1 }, [&count] (SNMP_Variable *v) -> uint32_t { count++; return SNMP_ERR_SUCCESS; });
+   AssertEquals(rc, static_cast<uint32_t>(SNMP_ERR_TIMEOUT));
+   AssertEquals(count, 0);
+   AssertEquals(transport.getBulkRequests, 1);
+   transport.unresponsive = false;
+
+   // SNMPv1 transport should always use GETNEXT
+   transport.setSnmpVersion(SNMP_VERSION_1);
+   int bulkRequests = transport.getBulkRequests;
+   count = 0;
+   rc = SnmpWalk(&transport, { 1, 3, 6, 1, 2, 1, 2, 2, 1, 2 }, [&count] (SNMP_Variable *v) -> uint32_t { count++; return SNMP_ERR_SUCCESS; });
+   AssertEquals(rc, static_cast<uint32_t>(SNMP_ERR_SUCCESS));
+   AssertEquals(count, 50);
+   AssertEquals(transport.getBulkRequests, bulkRequests);
+
+   EndTest();
+}
+
+/**
+ * Simulated SNMP agent on loopback UDP socket for asynchronous engine test.
+ * Responds to requests for sysDescription and ignores all other requests.
+ */
+static void AsyncTestResponder(SOCKET s, volatile bool *shutdown)
+{
+   BYTE buffer[2048];
+   while(!*shutdown)
+   {
+      if (!SocketCanRead(s, 50))
+         continue;
+
+      SockAddrBuffer sender;
+      socklen_t addrLen = sizeof(sender);
+      int bytes = recvfrom(s, reinterpret_cast<char*>(buffer), sizeof(buffer), 0, &sender.sa, &addrLen);
+      if (bytes <= 0)
+         continue;
+
+      SNMP_PDU request;
+      if (!request.parse(buffer, bytes, nullptr, false) || (request.getNumVariables() == 0) || !request.getVariable(0)->getName().equals(s_oidSysDescription))
+         continue;
+
+      SNMP_PDU response(SNMP_RESPONSE, request.getRequestId(), request.getVersion());
+      SNMP_Variable *v = new SNMP_Variable(s_oidSysDescription);
+      v->setValueFromString(ASN_OCTET_STRING, _T("Async Test Agent"));
+      response.bindVariable(v);
+
+      SNMP_SecurityContext securityContext(request.getCommunity());
+      SNMP_PDUBuffer encodedPDU;
+      size_t size = response.encode(&encodedPDU, &securityContext);
+      sendto(s, reinterpret_cast<char*>(encodedPDU.buffer()), static_cast<int>(size), 0, &sender.sa, addrLen);
+   }
+}
+
+/**
+ * Test asynchronous SNMP engine
+ */
+static void TestAsyncEngine()
+{
+   StartTest(_T("SNMP_AsyncEngine"));
+
+   SOCKET s = CreateSocket(AF_INET, SOCK_DGRAM, 0);
+   AssertTrue(s != INVALID_SOCKET);
+   SockAddrBuffer addr;
+   InetAddress::LOOPBACK.fillSockAddr(&addr, 0);
+   AssertTrue(bind(s, &addr.sa, SA_LEN(&addr.sa)) == 0);
+   socklen_t addrLen = sizeof(addr);
+   AssertTrue(getsockname(s, &addr.sa, &addrLen) == 0);
+   uint16_t port = ntohs(addr.sa4.sin_port);
+
+   volatile bool shutdown = false;
+   THREAD responder = ThreadCreateEx(AsyncTestResponder, s, &shutdown);
+
+   SNMP_AsyncEngine engine(2);
+   AssertTrue(engine.start());
+
+   SNMP_SecurityContext securityContext("public");
+   VolatileCounter successCount = 0, timeoutCount = 0;
+   for(int i = 0; i < 20; i++)
+   {
+      SNMP_PDU request(SNMP_GET_REQUEST, 0, SNMP_VERSION_2C);
+      request.bindVariable(new SNMP_Variable((i % 4 == 3) ? s_oidSysLocation : s_oidSysDescription));
+      uint32_t rc = engine.sendRequest(&request, InetAddress::LOOPBACK, port, &securityContext, 100, 2,
+         [&successCount, &timeoutCount] (uint32_t rcc, SNMP_PDU *response) -> void
+         {
+            if ((rcc == SNMP_ERR_SUCCESS) && (response != nullptr) && (response->getNumVariables() == 1))
+            {
+               TCHAR buffer[64];
+               if (!_tcscmp(response->getVariable(0)->getValueAsString(buffer, 64), _T("Async Test Agent")))
+                  InterlockedIncrement(&successCount);
+            }
+            else if ((rcc == SNMP_ERR_TIMEOUT) && (response == nullptr))
+            {
+               InterlockedIncrement(&timeoutCount);
+            }
+            delete response;
+         });
+      AssertEquals(rc, static_cast<uint32_t>(SNMP_ERR_SUCCESS));
+   }
+
+   // Request is removed from pending list before its callback is called, so wait for all callbacks instead
+   for(int i = 0; (i < 500) && (successCount + timeoutCount < 20); i++)
+      ThreadSleepMs(10);
+   AssertEquals(static_cast<int>(successCount + timeoutCount), 20);
+   AssertEquals(engine.getPendingRequestCount(), 0);
+   AssertEquals(static_cast<int>(successCount), 15);
+   AssertEquals(static_cast<int>(timeoutCount), 5);
+
+   SNMP_PDU v3request(SNMP_GET_REQUEST, 0, SNMP_VERSION_3);
+   AssertEquals(engine.sendRequest(&v3request, InetAddress::LOOPBACK, port, &securityContext, 100, 1, [] (uint32_t, SNMP_PDU*) -> void {}), static_cast<uint32_t>(SNMP_ERR_PARAM));
+
+   engine.stop();
+   shutdown = true;
+   ThreadJoin(responder);
+   closesocket(s);
+
+   EndTest();
+}
+
 /**
  * Find byte sequence in buffer
  */
@@ -464,6 +751,8 @@ int main(int argc, char *argv[])
    TestVariableClass();
    TestPDUEncoding();
    TestV1TrapEncoding();
+   TestWalk();
+   TestAsyncEngine();
    TestPDUPrivacy(SNMP_ENCRYPT_DES, _T("SNMPv3 privacy (DES)"));
    TestPDUPrivacy(SNMP_ENCRYPT_AES_128, _T("SNMPv3 privacy (AES-128)"));
    return 0;